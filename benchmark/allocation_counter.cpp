@@ -0,0 +1,154 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace cura::benchmark_allocations
+{
+std::atomic<size_t> count{ 0 };
+
+namespace
+{
+void* allocate(const std::size_t size) noexcept
+{
+    count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocateAligned(const std::size_t size, const std::align_val_t alignment) noexcept
+{
+    count.fetch_add(1, std::memory_order_relaxed);
+    const auto alignment_bytes = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, alignment_bytes);
+#else
+    // The size given to aligned_alloc must be a multiple of the alignment.
+    const std::size_t aligned_size = size == 0 ? alignment_bytes : (size + alignment_bytes - 1) / alignment_bytes * alignment_bytes;
+    return std::aligned_alloc(alignment_bytes, aligned_size);
+#endif
+}
+
+void deallocateAligned(void* pointer) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+} // namespace
+} // namespace cura::benchmark_allocations
+
+// The global allocation functions are replaced for the whole benchmark executable, so they are defined in this one translation unit.
+// All of the replaceable forms are covered, so that memory is never freed by a different allocator than it was allocated by.
+
+void* operator new(std::size_t size)
+{
+    if (void* pointer = cura::benchmark_allocations::allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return cura::benchmark_allocations::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return cura::benchmark_allocations::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* pointer = cura::benchmark_allocations::allocateAligned(size, alignment))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return cura::benchmark_allocations::allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return cura::benchmark_allocations::allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    cura::benchmark_allocations::deallocateAligned(pointer);
+}
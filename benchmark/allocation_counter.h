@@ -0,0 +1,21 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_ALLOCATION_COUNTER_H
+#define CURAENGINE_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace cura::benchmark_allocations
+{
+/*!
+ * The number of times that memory was allocated on the heap, by any thread, since the start of the benchmark executable.
+ *
+ * It is counted by the replacements of the global allocation functions in allocation_counter.cpp. Benchmarks take the difference of this
+ * before and after the code they measure.
+ */
+extern std::atomic<size_t> count;
+} // namespace cura::benchmark_allocations
+
+#endif // CURAENGINE_ALLOCATION_COUNTER_H
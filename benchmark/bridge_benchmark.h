@@ -0,0 +1,143 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BRIDGE_BENCHMARK_H
+#define CURAENGINE_BRIDGE_BENCHMARK_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "Slice.h"
+#include "bridge/BridgeLayerContext.h"
+#include "bridge/bridge.h"
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "mesh.h"
+#include "settings/types/Angle.h"
+#include "sliceDataStorage.h"
+
+namespace cura
+{
+class BridgeTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr size_t PILLARS_PER_ROW = 17;
+    static constexpr coord_t PILLAR_PITCH = MM2INT(5);
+    static constexpr coord_t PILLAR_SIZE = MM2INT(2);
+    static constexpr coord_t INFILL_INSET = MM2INT(0.5);
+    static constexpr coord_t SKIN_WIDTH = MM2INT(1.2);
+    static constexpr LayerIndex LAYER_NR = 1;
+
+    std::unique_ptr<Mesh> mesh;
+    std::unique_ptr<SliceDataStorage> storage;
+    std::vector<Shape> skin_parts;
+
+    static Shape rectangle(const coord_t min_x, const coord_t min_y, const coord_t max_x, const coord_t max_y)
+    {
+        Shape result;
+        result.emplace_back();
+        result.back().emplace_back(min_x, min_y);
+        result.back().emplace_back(max_x, min_y);
+        result.back().emplace_back(max_x, max_y);
+        result.back().emplace_back(min_x, max_y);
+        return result;
+    }
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        Settings& settings = Application::getInstance().current_slice_->scene.settings;
+        settings.add("machine_width", "235");
+        settings.add("machine_depth", "235");
+        settings.add("machine_height", "235");
+        settings.add("machine_center_is_zero", "false");
+        settings.add("cutting_mesh", "false");
+        settings.add("anti_overhang_mesh", "false");
+        settings.add("infill_mesh", "false");
+        settings.add("infill_line_distance", "6");
+        settings.add("infill_pattern", "grid");
+        settings.add("bridge_settings_enabled", "true");
+        settings.add("bridge_skin_support_threshold", "50");
+        settings.add("skin_line_width", "0.4");
+
+        // A grid of pillars with infill on the layer below, and many short skin bridges between neighbouring pillars above them.
+        mesh = std::make_unique<Mesh>(settings);
+        storage = std::make_unique<SliceDataStorage>();
+        storage->meshes.push_back(std::make_shared<SliceMeshStorage>(mesh.get(), LAYER_NR.value + 1));
+        SliceMeshStorage& mesh_storage = *storage->meshes.back();
+        mesh_storage.infill_angles = { AngleDegrees(45) };
+        for (size_t row = 0; row < PILLARS_PER_ROW; ++row)
+        {
+            for (size_t column = 0; column < PILLARS_PER_ROW; ++column)
+            {
+                const coord_t x = column * PILLAR_PITCH;
+                const coord_t y = row * PILLAR_PITCH;
+                SliceLayerPart& part = mesh_storage.layers[LAYER_NR.value - 1].parts.emplace_back();
+                part.outline = SingleShape(rectangle(x, y, x + PILLAR_SIZE, y + PILLAR_SIZE));
+                part.boundaryBox = AABB(part.outline);
+                part.infill_area = rectangle(x + INFILL_INSET, y + INFILL_INSET, x + PILLAR_SIZE - INFILL_INSET, y + PILLAR_SIZE - INFILL_INSET);
+            }
+        }
+
+        skin_parts.clear();
+        for (size_t skin_idx = 0; skin_idx < static_cast<size_t>(state.range(0)); ++skin_idx)
+        {
+            const size_t row = skin_idx / (PILLARS_PER_ROW - 1) % PILLARS_PER_ROW;
+            const size_t column = skin_idx % (PILLARS_PER_ROW - 1);
+            const coord_t x = column * PILLAR_PITCH + PILLAR_SIZE / 2;
+            const coord_t y = row * PILLAR_PITCH + (PILLAR_SIZE - SKIN_WIDTH) / 2;
+            skin_parts.push_back(rectangle(x, y, x + PILLAR_PITCH, y + SKIN_WIDTH));
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        storage.reset();
+        mesh.reset();
+        Application::getInstance().current_slice_.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(BridgeTestFixture, bridgeAngle_context_per_skin_part)(benchmark::State& st)
+{
+    const SliceMeshStorage& mesh_storage = *storage->meshes.front();
+    for (auto _ : st)
+    {
+        for (const Shape& skin_part : skin_parts)
+        {
+            // A new context for every skin part, which gathers the layer below again every time.
+            BridgeLayerContext layer_context(*storage, LAYER_NR);
+            Shape supported_regions;
+            const std::optional<AngleDegrees> angle = bridgeAngle(mesh_storage, skin_part, layer_context, LAYER_NR.value, 1, nullptr, supported_regions);
+            benchmark::DoNotOptimize(angle);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(BridgeTestFixture, bridgeAngle_context_per_skin_part)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(BridgeTestFixture, bridgeAngle_shared_context)(benchmark::State& st)
+{
+    const SliceMeshStorage& mesh_storage = *storage->meshes.front();
+    for (auto _ : st)
+    {
+        // One context per layer, shared by all of its skin parts.
+        BridgeLayerContext layer_context(*storage, LAYER_NR);
+        for (const Shape& skin_part : skin_parts)
+        {
+            Shape supported_regions;
+            const std::optional<AngleDegrees> angle = bridgeAngle(mesh_storage, skin_part, layer_context, LAYER_NR.value, 1, nullptr, supported_regions);
+            benchmark::DoNotOptimize(angle);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(BridgeTestFixture, bridgeAngle_shared_context)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+#endif // CURAENGINE_BRIDGE_BENCHMARK_H
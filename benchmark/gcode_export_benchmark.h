@@ -0,0 +1,123 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_GCODE_EXPORT_BENCHMARK_H
+#define CURAENGINE_GCODE_EXPORT_BENCHMARK_H
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "Slice.h"
+#include "communication/CommandLine.h"
+#include "gcode_export/GCodeOutputStream.h"
+#include "gcode_export/gcodeExport.h"
+#include "geometry/Point3LL.h"
+#include "utils/string.h"
+
+namespace cura
+{
+class GCodeExportTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr coord_t LINE_LENGTH = MM2INT(40);
+    static constexpr coord_t LINE_SPACING = MM2INT(0.4);
+    static constexpr coord_t LAYER_HEIGHT = MM2INT(0.2);
+
+    std::vector<Point3LL> path;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        Application::getInstance().current_slice_->scene.settings.add("layer_height", "0.2");
+        Application::getInstance().communication_ = std::make_shared<CommandLine>();
+
+        // A zigzag of lines, like the infill of a layer, going up a layer every hundred lines.
+        path.clear();
+        for (size_t line_idx = 0; line_idx < static_cast<size_t>(state.range(0)); ++line_idx)
+        {
+            const coord_t x = MM2INT(50) + (line_idx % 2 == 0 ? 0 : LINE_LENGTH) + static_cast<coord_t>(line_idx % 7);
+            const coord_t y = MM2INT(50) + static_cast<coord_t>(line_idx % 100) * LINE_SPACING;
+            const coord_t z = static_cast<coord_t>(line_idx / 100 + 1) * LAYER_HEIGHT;
+            path.emplace_back(x, y, z);
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        path.clear();
+        Application::getInstance().communication_.reset();
+        Application::getInstance().current_slice_.reset();
+    }
+
+    /*!
+     * Writes the path as lines with the same numbers as a move of the GCode export, without the bookkeeping of the GCode export.
+     */
+    template<typename Stream>
+    void formatPath(Stream& stream) const
+    {
+        double e = 0.0;
+        for (const Point3LL& point : path)
+        {
+            e += 0.0133;
+            stream << "G1 F" << PrecisionedDouble{ 1, 1800.0 } << " X" << MMtoStream{ point.x_ } << " Y" << MMtoStream{ point.y_ } << " Z" << MMtoStream{ point.z_ } << " E"
+                   << PrecisionedDouble{ 5, e } << "\n";
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(GCodeExportTestFixture, writeMoves)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        GCodeExport gcode;
+        gcode.setFilamentDiameter(0, MM2INT(1.75));
+        for (size_t point_idx = 0; point_idx < path.size(); ++point_idx)
+        {
+            if (point_idx % 10 == 0)
+            {
+                gcode.writeTravel(path[point_idx], Velocity(150));
+            }
+            else
+            {
+                gcode.writeExtrusion(path[point_idx], Velocity(60), 0.04, PrintFeatureType::Infill);
+            }
+        }
+        benchmark::DoNotOptimize(gcode);
+    }
+    st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(path.size()));
+}
+
+BENCHMARK_REGISTER_F(GCodeExportTestFixture, writeMoves)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GCodeExportTestFixture, formatLines_ostringstream)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        std::ostringstream stream;
+        formatPath(stream);
+        benchmark::DoNotOptimize(stream);
+    }
+    st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(path.size()));
+}
+
+BENCHMARK_REGISTER_F(GCodeExportTestFixture, formatLines_ostringstream)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GCodeExportTestFixture, formatLines_GCodeOutputStream)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        GCodeOutputStream stream;
+        formatPath(stream);
+        benchmark::DoNotOptimize(stream);
+    }
+    st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(path.size()));
+}
+
+BENCHMARK_REGISTER_F(GCodeExportTestFixture, formatLines_GCodeOutputStream)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+#endif // CURAENGINE_GCODE_EXPORT_BENCHMARK_H
@@ -6,6 +6,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include "allocation_counter.h"
 #include "geometry/OpenLinesSet.h"
 #include "geometry/OpenPolyline.h"
 #include "geometry/LinesSet.h"
@@ -112,15 +113,54 @@ BENCHMARK_DEFINE_F(InfillTest, Infill_generate_connect)(benchmark::State& st)
         MAX_RESOLUTION,
         MAX_DEVIATION); // There are some optional parameters, but these will do for now (future improvement?).
 
+    size_t allocations = 0;
     for (auto _ : st)
     {
+        const size_t allocations_before = benchmark_allocations::count.load(std::memory_order_relaxed);
         std::vector<VariableWidthLines> result_paths;
         Shape result_polygons;
         OpenLinesSet result_lines;
         infill.generate(result_paths, result_polygons, result_lines, settings, 0, SectionType::INFILL, nullptr, nullptr);
+        allocations += benchmark_allocations::count.load(std::memory_order_relaxed) - allocations_before;
     }
+    // Each iteration generates the infill of one layer.
+    st.counters["allocations_per_layer"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
 }
 
 BENCHMARK_REGISTER_F(InfillTest, Infill_generate_connect)->ArgsProduct({ { true, false }, { 400, 800, 1200 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(InfillTest, Infill_generate_gyroid)(benchmark::State& st)
+{
+    // The gyroid pattern changes with the height, so generate a stack of layers.
+    constexpr coord_t layer_height = 200;
+    constexpr size_t layer_count = 20;
+    for (auto _ : st)
+    {
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            Infill infill(
+                EFillMethod::GYROID,
+                zig_zagify,
+                connect_polygons,
+                outline_polygons,
+                INFILL_LINE_WIDTH,
+                line_distance,
+                INFILL_OVERLAP,
+                INFILL_MULTIPLIER,
+                FILL_ANGLE,
+                Z + layer_nr * layer_height,
+                SHIFT,
+                MAX_RESOLUTION,
+                MAX_DEVIATION);
+            std::vector<VariableWidthLines> result_paths;
+            Shape result_polygons;
+            OpenLinesSet result_lines;
+            infill.generate(result_paths, result_polygons, result_lines, settings, layer_nr, SectionType::INFILL, nullptr, nullptr);
+            benchmark::DoNotOptimize(result_lines);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(InfillTest, Infill_generate_gyroid)->ArgsProduct({ { true, false }, { 400, 800, 1200 } })->Unit(benchmark::kMillisecond);
 } // namespace cura
 #endif // CURAENGINE_INFILL_BENCHMARK_H
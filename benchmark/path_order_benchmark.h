@@ -0,0 +1,94 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_PATH_ORDER_BENCHMARK_H
+#define CURAENGINE_PATH_ORDER_BENCHMARK_H
+
+#include <numbers>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "PathOrderOptimizer.h"
+#include "geometry/OpenLinesSet.h"
+#include "geometry/OpenPolyline.h"
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+
+namespace cura
+{
+class PathOrderTestFixture : public benchmark::Fixture
+{
+public:
+    OpenLinesSet lines;
+    Shape combing_boundary;
+
+    void SetUp(const ::benchmark::State& state) override
+    {
+        // Short lines scattered over the build plate, like a layer of ironing or support fragments. Only few of them connect within the
+        // snap radius of the optimizer, so nearly every step has to search for the nearest line.
+        constexpr coord_t plate_size = MM2INT(200);
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<coord_t> position(0, plate_size);
+        std::uniform_real_distribution<double> angle(0.0, std::numbers::pi);
+        std::uniform_int_distribution<coord_t> length(MM2INT(0.5), MM2INT(2.0));
+
+        lines.clear();
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            const Point2LL start(position(generator), position(generator));
+            const double line_angle = angle(generator);
+            const coord_t line_length = length(generator);
+            const Point2LL end = start + Point2LL(std::cos(line_angle) * line_length, std::sin(line_angle) * line_length);
+            lines.push_back(OpenPolyline({ start, end }));
+        }
+
+        combing_boundary.clear();
+        Polygon outline;
+        outline.emplace_back(-MM2INT(5), -MM2INT(5));
+        outline.emplace_back(plate_size + MM2INT(5), -MM2INT(5));
+        outline.emplace_back(plate_size + MM2INT(5), plate_size + MM2INT(5));
+        outline.emplace_back(-MM2INT(5), plate_size + MM2INT(5));
+        combing_boundary.push_back(outline);
+    }
+
+    void TearDown(const ::benchmark::State& state) override
+    {
+    }
+};
+
+BENCHMARK_DEFINE_F(PathOrderTestFixture, PathOrder_ScatteredLines)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        PathOrderOptimizer<const Polyline*> optimizer(Point2LL(0, 0));
+        for (const OpenPolyline& line : lines)
+        {
+            optimizer.addPolyline(&line);
+        }
+        optimizer.optimize();
+        benchmark::DoNotOptimize(optimizer.paths_);
+    }
+}
+
+BENCHMARK_REGISTER_F(PathOrderTestFixture, PathOrder_ScatteredLines)->Arg(5000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PathOrderTestFixture, PathOrder_ScatteredLinesCombing)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        constexpr bool detect_loops = true;
+        PathOrderOptimizer<const Polyline*> optimizer(Point2LL(0, 0), ZSeamConfig(), detect_loops, &combing_boundary);
+        for (const OpenPolyline& line : lines)
+        {
+            optimizer.addPolyline(&line);
+        }
+        optimizer.optimize();
+        benchmark::DoNotOptimize(optimizer.paths_);
+    }
+}
+
+BENCHMARK_REGISTER_F(PathOrderTestFixture, PathOrder_ScatteredLinesCombing)->Arg(5000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+#endif // CURAENGINE_PATH_ORDER_BENCHMARK_H
@@ -0,0 +1,151 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_SETTINGS_BENCHMARK_H
+#define CURAENGINE_SETTINGS_BENCHMARK_H
+
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "Slice.h"
+#include "settings/SettingKey.h"
+#include "settings/Settings.h"
+#include "settings/types/Ratio.h"
+#include "settings/types/Velocity.h"
+#include "utils/Coord_t.h"
+
+namespace cura
+{
+class SettingsTestFixture : public benchmark::Fixture
+{
+public:
+    std::shared_ptr<Slice> slice;
+    Settings mesh_group_settings;
+    Settings extruder_settings;
+    Settings mesh_settings;
+
+    //! The same settings as plain maps, from the mesh to the global settings, to look them up the way Settings::get did before it cached them.
+    std::array<std::unordered_map<std::string, std::string>, 4> baseline_chain;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        if (state.thread_index() != 0)
+        {
+            return; // The threads of a multi-threaded run share the fixture, and only start the loop once it is set up.
+        }
+        slice = std::make_shared<Slice>(1);
+        Application::getInstance().current_slice_ = slice;
+
+        // Mimic the usual inheritance: global -> mesh group -> extruder -> mesh, with the values at the root.
+        Settings& global_settings = slice->scene.settings;
+        global_settings.add("wall_line_width_0", "0.4");
+        global_settings.add("infill_sparse_density", "20");
+        global_settings.add("speed_print", "60");
+        global_settings.add("support_enable", "false");
+        global_settings.add("wall_line_count", "3");
+        mesh_group_settings.setParent(&global_settings);
+        extruder_settings.setParent(&mesh_group_settings);
+        mesh_settings.setParent(&extruder_settings);
+
+        baseline_chain[3] = { { "wall_line_width_0", "0.4" }, { "infill_sparse_density", "20" }, { "speed_print", "60" }, { "support_enable", "false" }, { "wall_line_count", "3" } };
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        if (state.thread_index() != 0)
+        {
+            return;
+        }
+        Application::getInstance().current_slice_.reset();
+        slice.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(SettingsTestFixture, get_typed_inherited)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        benchmark::DoNotOptimize(mesh_settings.get<coord_t>("wall_line_width_0"));
+        benchmark::DoNotOptimize(mesh_settings.get<Ratio>("infill_sparse_density"));
+        benchmark::DoNotOptimize(mesh_settings.get<Velocity>("speed_print"));
+        benchmark::DoNotOptimize(mesh_settings.get<bool>("support_enable"));
+        benchmark::DoNotOptimize(mesh_settings.get<size_t>("wall_line_count"));
+    }
+    st.SetItemsProcessed(st.iterations() * 5);
+}
+
+BENCHMARK_REGISTER_F(SettingsTestFixture, get_typed_inherited)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+/*!
+ * \brief The same lookups as get_typed_inherited, with keys that were interned once, as the lookups in loops do.
+ */
+BENCHMARK_DEFINE_F(SettingsTestFixture, get_typed_inherited_interned)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        benchmark::DoNotOptimize(mesh_settings.get<coord_t>("wall_line_width_0"_setting));
+        benchmark::DoNotOptimize(mesh_settings.get<Ratio>("infill_sparse_density"_setting));
+        benchmark::DoNotOptimize(mesh_settings.get<Velocity>("speed_print"_setting));
+        benchmark::DoNotOptimize(mesh_settings.get<bool>("support_enable"_setting));
+        benchmark::DoNotOptimize(mesh_settings.get<size_t>("wall_line_count"_setting));
+    }
+    st.SetItemsProcessed(st.iterations() * 5);
+}
+
+BENCHMARK_REGISTER_F(SettingsTestFixture, get_typed_inherited_interned)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+/*!
+ * \brief The baseline for get_typed_inherited: the lookups as Settings::get did them before the resolved values were cached.
+ *
+ * Each lookup walks the containers up to the one with the value, checking the limiting to extruders at each of them, and parses the
+ * string again.
+ */
+BENCHMARK_DEFINE_F(SettingsTestFixture, get_typed_inherited_baseline)(benchmark::State& st)
+{
+    const std::unordered_map<std::string, ExtruderTrain*>& limit_to_extruder = slice->scene.limit_to_extruder;
+    const auto get_string = [this, &limit_to_extruder](const std::string& key) -> const std::string&
+    {
+        for (const std::unordered_map<std::string, std::string>& container : baseline_chain)
+        {
+            if (const auto value = container.find(key); value != container.end())
+            {
+                return value->second;
+            }
+            benchmark::DoNotOptimize(limit_to_extruder.find(key));
+        }
+        std::abort();
+    };
+    for (auto _ : st)
+    {
+        benchmark::DoNotOptimize(MM2INT(std::atof(get_string("wall_line_width_0").c_str())));
+        benchmark::DoNotOptimize(Ratio(std::atof(get_string("infill_sparse_density").c_str()) / 100.0));
+        benchmark::DoNotOptimize(Velocity(std::atof(get_string("speed_print").c_str())));
+        benchmark::DoNotOptimize(get_string("support_enable") == "true" || std::atoi(get_string("support_enable").c_str()) != 0);
+        benchmark::DoNotOptimize(std::stoul(get_string("wall_line_count")));
+    }
+    st.SetItemsProcessed(st.iterations() * 5);
+}
+
+BENCHMARK_REGISTER_F(SettingsTestFixture, get_typed_inherited_baseline)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+BENCHMARK_DEFINE_F(SettingsTestFixture, get_typed_after_change)(benchmark::State& st)
+{
+    // Worst case: a setting changes in between every lookup, so nothing can be reused.
+    for (auto _ : st)
+    {
+        Settings::invalidateResolvedValues();
+        benchmark::DoNotOptimize(mesh_settings.get<coord_t>("wall_line_width_0"));
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK_REGISTER_F(SettingsTestFixture, get_typed_after_change);
+
+} // namespace cura
+#endif // CURAENGINE_SETTINGS_BENCHMARK_H
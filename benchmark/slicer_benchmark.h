@@ -0,0 +1,130 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_SLICER_BENCHMARK_H
+#define CURAENGINE_SLICER_BENCHMARK_H
+
+#include <cmath>
+#include <numbers>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "mesh.h"
+#include "slicer.h"
+
+namespace cura
+{
+class SlicerTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr coord_t LAYER_HEIGHT = MM2INT(0.05);
+    static constexpr coord_t CYLINDER_HEIGHT = MM2INT(100);
+    static constexpr coord_t CYLINDER_RADIUS = MM2INT(50);
+
+    Mesh mesh;
+    std::vector<SlicerLayer> layers;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().startThreadPool();
+
+        // A closed tessellated cylinder with (about) the requested number of faces on its side.
+        const size_t segments = 512;
+        const size_t rings = std::max(size_t(1), static_cast<size_t>(state.range(0)) / (2 * segments));
+        const auto vertex = [&](const size_t ring, const size_t segment)
+        {
+            const double angle = 2.0 * std::numbers::pi * static_cast<double>(segment % segments) / static_cast<double>(segments);
+            const coord_t z = CYLINDER_HEIGHT * static_cast<coord_t>(ring) / static_cast<coord_t>(rings);
+            return Point3LL(std::llrint(CYLINDER_RADIUS * std::cos(angle)), std::llrint(CYLINDER_RADIUS * std::sin(angle)), z);
+        };
+
+        mesh.clear();
+        for (size_t ring = 0; ring < rings; ++ring)
+        {
+            for (size_t segment = 0; segment < segments; ++segment)
+            {
+                mesh.addFace(vertex(ring, segment), vertex(ring, segment + 1), vertex(ring + 1, segment + 1));
+                mesh.addFace(vertex(ring, segment), vertex(ring + 1, segment + 1), vertex(ring + 1, segment));
+            }
+        }
+        const Point3LL bottom_center(0, 0, 0);
+        const Point3LL top_center(0, 0, CYLINDER_HEIGHT);
+        for (size_t segment = 0; segment < segments; ++segment)
+        {
+            mesh.addFace(bottom_center, vertex(0, segment + 1), vertex(0, segment));
+            mesh.addFace(top_center, vertex(rings, segment), vertex(rings, segment + 1));
+        }
+        mesh.finish();
+
+        layers.clear();
+        layers.resize(CYLINDER_HEIGHT / LAYER_HEIGHT);
+        for (size_t layer_nr = 0; layer_nr < layers.size(); ++layer_nr)
+        {
+            layers[layer_nr].z_ = LAYER_HEIGHT / 2 + LAYER_HEIGHT * static_cast<coord_t>(layer_nr);
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+
+    void clearSegments()
+    {
+        for (SlicerLayer& layer : layers)
+        {
+            layer.segments_.clear();
+            layer.face_idx_to_segment_idx_.clear();
+        }
+    }
+
+    void buildSegments()
+    {
+        Slicer::sliceSegments(mesh, SlicingTolerance::MIDDLE, false, layers);
+    }
+
+    /*!
+     * Builds the segments the way the slicer used to: every layer tests all faces of the mesh.
+     */
+    void buildSegmentsFullScan()
+    {
+        Slicer::sliceSegments(mesh, SlicingTolerance::MIDDLE, true, layers);
+    }
+};
+
+BENCHMARK_DEFINE_F(SlicerTestFixture, build_segments)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        st.PauseTiming();
+        clearSegments();
+        st.ResumeTiming();
+
+        buildSegments();
+        benchmark::DoNotOptimize(layers);
+    }
+    st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(mesh.faces_.size()));
+    st.SetComplexityN(static_cast<int64_t>(mesh.faces_.size()));
+}
+
+BENCHMARK_REGISTER_F(SlicerTestFixture, build_segments)->RangeMultiplier(4)->Range(1 << 14, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+
+BENCHMARK_DEFINE_F(SlicerTestFixture, build_segments_full_scan)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        st.PauseTiming();
+        clearSegments();
+        st.ResumeTiming();
+
+        buildSegmentsFullScan();
+        benchmark::DoNotOptimize(layers);
+    }
+    st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(mesh.faces_.size()));
+    st.SetComplexityN(static_cast<int64_t>(mesh.faces_.size()));
+}
+
+BENCHMARK_REGISTER_F(SlicerTestFixture, build_segments_full_scan)->RangeMultiplier(4)->Range(1 << 14, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+
+} // namespace cura
+#endif // CURAENGINE_SLICER_BENCHMARK_H
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_THREAD_POOL_BENCHMARK_H
+#define CURAENGINE_THREAD_POOL_BENCHMARK_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "utils/ThreadPool.h"
+
+namespace cura
+{
+
+/*!
+ * Scaling of the thread pool from 1 thread to all cores, with short tasks like those of the per-layer steps.
+ * The number of threads is the argument of the benchmarks, the main thread included.
+ */
+class ThreadPoolTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr size_t ITEM_COUNT = 4096;
+    static constexpr size_t OUTER_COUNT = 64; //!< For nested loops, the number of items of the outer loop
+    static constexpr size_t WORK_PER_ITEM = 200; //!< Roughly a microsecond of arithmetic per item
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().startThreadPool(static_cast<int>(state.range(0)));
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+
+    static double work(const size_t item)
+    {
+        double value = static_cast<double>(item);
+        for (size_t i = 0; i < WORK_PER_ITEM; ++i)
+        {
+            value = std::sqrt(value + static_cast<double>(i));
+        }
+        return value;
+    }
+};
+
+BENCHMARK_DEFINE_F(ThreadPoolTestFixture, parallel_for)(benchmark::State& st)
+{
+    std::vector<double> results(ITEM_COUNT);
+    for (auto _ : st)
+    {
+        parallel_for(
+            size_t(0),
+            ITEM_COUNT,
+            [&](const size_t item)
+            {
+                results[item] = work(item);
+            });
+        benchmark::DoNotOptimize(results.data());
+    }
+    st.SetItemsProcessed(st.iterations() * ITEM_COUNT);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTestFixture, parallel_for)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+BENCHMARK_DEFINE_F(ThreadPoolTestFixture, nested_parallel_for)(benchmark::State& st)
+{
+    constexpr size_t inner_count = ITEM_COUNT / OUTER_COUNT;
+    std::vector<double> results(ITEM_COUNT);
+    for (auto _ : st)
+    {
+        parallel_for(
+            size_t(0),
+            OUTER_COUNT,
+            [&](const size_t outer)
+            {
+                parallel_for(
+                    size_t(0),
+                    inner_count,
+                    [&](const size_t inner)
+                    {
+                        results[outer * inner_count + inner] = work(outer * inner_count + inner);
+                    });
+            });
+        benchmark::DoNotOptimize(results.data());
+    }
+    st.SetItemsProcessed(st.iterations() * ITEM_COUNT);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTestFixture, nested_parallel_for)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+BENCHMARK_DEFINE_F(ThreadPoolTestFixture, ordered_consumer)(benchmark::State& st)
+{
+    double total = 0.0;
+    for (auto _ : st)
+    {
+        run_multiple_producers_ordered_consumer(
+            0,
+            static_cast<ptrdiff_t>(OUTER_COUNT),
+            [](const ptrdiff_t layer)
+            {
+                constexpr size_t items_per_layer = ITEM_COUNT / OUTER_COUNT;
+                std::atomic<size_t> layer_sum = 0;
+                parallel_for(
+                    size_t(0),
+                    items_per_layer,
+                    [&](const size_t item)
+                    {
+                        layer_sum += static_cast<size_t>(work(static_cast<size_t>(layer) * items_per_layer + item));
+                    });
+                return std::optional<double>(static_cast<double>(layer_sum));
+            },
+            [&total](const std::optional<double> layer_sum)
+            {
+                total += *layer_sum;
+            });
+        benchmark::DoNotOptimize(total);
+    }
+    st.SetItemsProcessed(st.iterations() * ITEM_COUNT);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTestFixture, ordered_consumer)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+} // namespace cura
+#endif // CURAENGINE_THREAD_POOL_BENCHMARK_H
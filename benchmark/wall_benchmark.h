@@ -13,8 +13,12 @@
 #include <range/v3/view/join.hpp>
 #include <spdlog/spdlog.h>
 
+#include "BeadingStrategy/BeadingStrategyFactory.h"
+#include "BeadingStrategy/MemoizedBeadingStrategy.h"
 #include "InsetOrderOptimizer.h"
 #include "WallsComputation.h"
+#include "arachne/SkeletalTrapezoidation.h"
+#include "geometry/MendedShape.h"
 #include "geometry/Polygon.h"
 #include "settings/Settings.h"
 #include "sliceDataStorage.h"
@@ -239,5 +243,83 @@ BENCHMARK_DEFINE_F(HolesWallTestFixture, InsetOrderOptimizer_getInsetOrder)(benc
 
 BENCHMARK_REGISTER_F(HolesWallTestFixture, InsetOrderOptimizer_getInsetOrder)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(HolesWallTestFixture, SkeletalTrapezoidation_new_graph)(benchmark::State& st)
+{
+    const MendedShape outline(&settings, SectionType::WALL, &layer.parts.back().outline);
+    const auto beading_strategy = BeadingStrategyFactory::makeStrategy(MM2INT(0.4), MM2INT(0.4), MM2INT(1), AngleRadians(AngleDegrees(10)), false, 0, 0, 0.5_r, 0.5_r, 2 * st.range(0));
+    for (auto _ : st)
+    {
+        // A new graph has to allocate all of its edges and nodes.
+        SkeletalTrapezoidation wall_maker(outline, *beading_strategy, beading_strategy->getTransitioningAngle(), MM2INT(0.8), MM2INT(1), MM2INT(0.2), MM2INT(1), 100, SectionType::WALL);
+        std::vector<VariableWidthLines> toolpaths;
+        wall_maker.generateToolpaths(toolpaths);
+        benchmark::DoNotOptimize(toolpaths);
+    }
+}
+
+BENCHMARK_REGISTER_F(HolesWallTestFixture, SkeletalTrapezoidation_new_graph)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HolesWallTestFixture, SkeletalTrapezoidation_reused_graph)(benchmark::State& st)
+{
+    const MendedShape outline(&settings, SectionType::WALL, &layer.parts.back().outline);
+    const auto beading_strategy = BeadingStrategyFactory::makeStrategy(MM2INT(0.4), MM2INT(0.4), MM2INT(1), AngleRadians(AngleDegrees(10)), false, 0, 0, 0.5_r, 0.5_r, 2 * st.range(0));
+    SkeletalTrapezoidationGraph reused_graph;
+    for (auto _ : st)
+    {
+        // Like WallToolPaths does for every layer of a thread, build the graph in the memory of the previous one.
+        SkeletalTrapezoidation wall_maker(
+            outline,
+            *beading_strategy,
+            beading_strategy->getTransitioningAngle(),
+            MM2INT(0.8),
+            MM2INT(1),
+            MM2INT(0.2),
+            MM2INT(1),
+            100,
+            SectionType::WALL,
+            std::move(reused_graph));
+        std::vector<VariableWidthLines> toolpaths;
+        wall_maker.generateToolpaths(toolpaths);
+        benchmark::DoNotOptimize(toolpaths);
+        reused_graph = std::move(wall_maker.graph_);
+    }
+}
+
+BENCHMARK_REGISTER_F(HolesWallTestFixture, SkeletalTrapezoidation_reused_graph)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HolesWallTestFixture, SkeletalTrapezoidation_new_strategy)(benchmark::State& st)
+{
+    const MendedShape outline(&settings, SectionType::WALL, &layer.parts.back().outline);
+    for (auto _ : st)
+    {
+        // A strategy from the factory doesn't memoize anything.
+        const auto beading_strategy = BeadingStrategyFactory::makeStrategy(MM2INT(0.4), MM2INT(0.4), MM2INT(1), AngleRadians(AngleDegrees(10)), false, 0, 0, 0.5_r, 0.5_r, 2 * st.range(0));
+        SkeletalTrapezoidation wall_maker(outline, *beading_strategy, beading_strategy->getTransitioningAngle(), MM2INT(0.8), MM2INT(1), MM2INT(0.2), MM2INT(1), 100, SectionType::WALL);
+        std::vector<VariableWidthLines> toolpaths;
+        wall_maker.generateToolpaths(toolpaths);
+        benchmark::DoNotOptimize(toolpaths);
+    }
+}
+
+BENCHMARK_REGISTER_F(HolesWallTestFixture, SkeletalTrapezoidation_new_strategy)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HolesWallTestFixture, SkeletalTrapezoidation_reused_strategy)(benchmark::State& st)
+{
+    const MendedShape outline(&settings, SectionType::WALL, &layer.parts.back().outline);
+    const MemoizedBeadingStrategy beading_strategy(
+        BeadingStrategyFactory::makeStrategy(MM2INT(0.4), MM2INT(0.4), MM2INT(1), AngleRadians(AngleDegrees(10)), false, 0, 0, 0.5_r, 0.5_r, 2 * st.range(0)));
+    for (auto _ : st)
+    {
+        // Like WallToolPaths does for the layers of a thread, keep the strategy so that its memoized beadings are used again.
+        SkeletalTrapezoidation wall_maker(outline, beading_strategy, beading_strategy.getTransitioningAngle(), MM2INT(0.8), MM2INT(1), MM2INT(0.2), MM2INT(1), 100, SectionType::WALL);
+        std::vector<VariableWidthLines> toolpaths;
+        wall_maker.generateToolpaths(toolpaths);
+        benchmark::DoNotOptimize(toolpaths);
+    }
+    st.counters["hit_rate"] = beading_strategy.getStatistics().hitRate();
+}
+
+BENCHMARK_REGISTER_F(HolesWallTestFixture, SkeletalTrapezoidation_reused_strategy)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
+
 } // namespace cura
 #endif // CURAENGINE_WALL_BENCHMARK_H
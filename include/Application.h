@@ -130,6 +130,11 @@ protected:
      */
     void slice();
 
+    /*!
+     * \brief Keep slicing the command lines that are read from stdin.
+     */
+    void serve();
+
 private:
     /*
      * \brief The number of arguments that the application was called with.
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef MEMOIZED_BEADING_STRATEGY_H
+#define MEMOIZED_BEADING_STRATEGY_H
+
+#include <vector>
+
+#include "BeadingStrategy.h"
+
+namespace cura
+{
+
+/*!
+ * This is a meta-strategy that remembers the most recent results of the strategy below it.
+ *
+ * The skeletal trapezoidation asks for the beading and the optimal bead count of the same thicknesses over and over,
+ * especially when the same strategy is used for many layers of a prismatic part. Each of those calls goes through the
+ * whole chain of meta-strategies, which all build the beading again.
+ *
+ * The results are stored by their exact thickness and bead count, so they are identical to those of the parent
+ * strategy. The thickness is an integer amount of microns, so it is already quantized finely enough to get many hits.
+ * The memory is bounded by storing the results in a fixed number of slots: a new result replaces whichever result
+ * was stored in its slot before.
+ *
+ * \warning The remembered results are not guarded against concurrent use, so an instance of this strategy must only
+ * be used by one thread at a time. Keep one per thread to share it between layers.
+ */
+class MemoizedBeadingStrategy : public BeadingStrategy
+{
+public:
+    /*!
+     * How often the remembered results could be used.
+     */
+    struct Statistics
+    {
+        size_t compute_hits = 0;
+        size_t compute_misses = 0;
+        size_t bead_count_hits = 0;
+        size_t bead_count_misses = 0;
+
+        /*!
+         * The fraction of all calls that could be answered from memory, or 0 if there were no calls yet.
+         */
+        double hitRate() const;
+    };
+
+    /*!
+     * \param parent The strategy to remember the results of.
+     * \param slot_count The maximum number of beadings (and of bead counts) to remember. Rounded up to a power of two.
+     */
+    MemoizedBeadingStrategy(BeadingStrategyPtr parent, size_t slot_count = 4096);
+
+    ~MemoizedBeadingStrategy() override = default;
+
+    Beading compute(coord_t thickness, coord_t bead_count) const override;
+    coord_t getOptimalThickness(coord_t bead_count) const override;
+    coord_t getTransitionThickness(coord_t lower_bead_count) const override;
+    coord_t getOptimalBeadCount(coord_t thickness) const override;
+    coord_t getTransitioningLength(coord_t lower_bead_count) const override;
+    double getTransitionAnchorPos(coord_t lower_bead_count) const override;
+    std::vector<coord_t> getNonlinearThicknesses(coord_t lower_bead_count) const override;
+    std::string toString() const override;
+
+    const Statistics& getStatistics() const;
+
+private:
+    struct BeadingSlot
+    {
+        bool is_used = false;
+        coord_t thickness = 0;
+        coord_t bead_count = 0;
+        Beading beading{};
+    };
+
+    struct BeadCountSlot
+    {
+        bool is_used = false;
+        coord_t thickness = 0;
+        coord_t bead_count = 0;
+    };
+
+    const BeadingStrategyPtr parent_;
+    const unsigned slot_shift_; //!< How far to shift a 64-bit hash to the right to get a slot index
+
+    mutable std::vector<BeadingSlot> beading_slots_;
+    mutable std::vector<BeadCountSlot> bead_count_slots_;
+    mutable Statistics statistics_;
+
+    size_t getSlotIndex(coord_t thickness, coord_t bead_count) const;
+};
+
+} // namespace cura
+#endif // MEMOIZED_BEADING_STRATEGY_H
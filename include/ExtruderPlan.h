@@ -27,6 +27,8 @@ namespace cura
 class LayerPlanBuffer;
 class LayerPlan;
 class GCodeExport;
+class Settings;
+class TimeEstimateCalculator;
 /*!
  * An extruder plan contains all planned paths (GCodePath) pertaining to a single extruder train.
  *
@@ -42,6 +44,10 @@ class ExtruderPlan
     FRIEND_TEST(ExtruderPlanPathsParameterizedTest, BackPressureCompensationFull);
     FRIEND_TEST(ExtruderPlanPathsParameterizedTest, BackPressureCompensationHalf);
     FRIEND_TEST(ExtruderPlanTest, BackPressureCompensationEmptyPlan);
+    friend class ExtruderPlanMinimalLayerTimeTest;
+    FRIEND_TEST(ExtruderPlanMinimalLayerTimeTest, NoSlowDownWhenAccelerationMakesLayerLongEnough);
+    FRIEND_TEST(ExtruderPlanMinimalLayerTimeTest, SlowsDownToMinimumLayerTime);
+    FRIEND_TEST(ExtruderPlanMinimalLayerTimeTest, WaitsWhenMinimumSpeedIsNotSlowEnough);
     friend class DISABLED_FffGcodeWriterTest_SurfaceGetsExtraInfillLinesUnderIt_Test;
     FRIEND_TEST(OverhangSpeedTest, SpeedFactorAppliedWhenMasksSet);
     FRIEND_TEST(OverhangSpeedTest, SpeedFactorSplitAtOverhangBoundary);
@@ -181,12 +187,14 @@ private:
 
     TimeMaterialEstimates estimates_{}; //!< Accumulated time and material estimates for all planned paths within this extruder plan.
     double slowest_path_speed_{ 0.0 };
+    std::optional<size_t> precomputed_paths_start_{}; //!< The index of the first path of which the estimates were computed by precomputeNaiveTimeEstimates, if that was called
 
     double extra_time_{ 0.0 }; //!< Extra waiting time at the and of this extruder plan, so that the filament can cool
 
     double fan_speed{ 0.0 }; //!< The fan speed to be used during this extruder plan
 
     double temperature_factor_{ 0.0 }; //!< Temperature reduction factor for small layers
+    Point2LL starting_position_{}; //!< The position the head is in before this plan, as passed to computeNaiveTimeEstimates
 
     /*!
      * Set the fan speed to be used while printing this extruder plan
@@ -203,6 +211,32 @@ private:
      */
     bool forceMinimalLayerTime(double maximum_cool_min_layer_time, double time_other_extr_plans);
 
+    /*!
+     * Force the minimal layer time to hold like \ref forceMinimalLayerTime, but
+     * with the layer time estimated with the accelerations and the jerk of the
+     * printer.
+     *
+     * All extrusion paths are slowed down by the same factor, which is searched
+     * for by estimating the time again with
+     * \ref TimeEstimateCalculator::calculate(const Ratio&). Paths are not
+     * slowed down below the minimum speed. If that limits some of them, the
+     * layer takes a little less time than estimated.
+     *
+     * \param maximum_cool_min_layer_time Maximum minimum layer time for all extruders in this layer
+     * \param time_other_extr_plans Time spend on other extruders in this layer
+     * \param calculator The moves of this plan, as planned by \ref planTimeEstimate
+     */
+    bool forceMinimalLayerTimeWithAcceleration(double maximum_cool_min_layer_time, double time_other_extr_plans, TimeEstimateCalculator& calculator);
+
+    /*!
+     * Plan all paths of this plan in a time estimate calculator, starting from
+     * where the head was before this plan.
+     *
+     * \param settings The settings of the extruder, with the movement limits of the printer
+     * \return The calculator with the moves of this plan
+     */
+    TimeEstimateCalculator planTimeEstimate(const Settings& settings) const;
+
     /*!
      * @return The time needed for (un)retract the path
      */
@@ -217,10 +251,36 @@ private:
      * Compute naive time estimates (without accounting for slow down at corners etc.) and naive material estimates.
      * and store them in each ExtruderPlan and each GCodePath.
      *
+     * Paths of which the estimates were already precomputed are not estimated again, only summed.
+     *
      * \param starting_position The position the head was in before starting this layer
      * \return the total estimates of this layer
      */
     TimeMaterialEstimates computeNaiveTimeEstimates(Point2LL starting_position);
+
+    /*!
+     * Compute the naive estimates of the paths that don't depend on where the print head starts, i.e. all paths after the first path
+     * with points, or all paths if the starting position is already known.
+     *
+     * The results are the same as those of \ref computeNaiveTimeEstimates, which should still be called afterwards to estimate the
+     * remaining paths and sum everything up.
+     *
+     * \param starting_position The position the head is in before starting this extruder plan, if it is known already
+     */
+    void precomputeNaiveTimeEstimates(const std::optional<Point2LL>& starting_position);
+
+    /*!
+     * Compute the naive time and material estimates of a single path.
+     *
+     * \param path The path to estimate
+     * \param p0 The position the head is in before the path. Updated to the last point of the path.
+     */
+    void computeNaiveTimeEstimates(GCodePath& path, Point3LL& p0);
+
+    /*!
+     * \return The speed of the slowest extrusion path of this plan
+     */
+    double computeSlowestPathSpeed() const;
 };
 
 } // namespace cura
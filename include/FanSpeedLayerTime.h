@@ -74,6 +74,14 @@ public:
      */
     Velocity cool_min_speed;
 
+    /*!
+     * Whether to estimate the layer time with the accelerations and the jerk of
+     * the printer when holding the minimum layer time. Otherwise every path is
+     * assumed to be printed at its own speed from start to end, which
+     * underestimates layers with many short moves.
+     */
+    bool cool_min_layer_time_estimate_acceleration;
+
     /*!
      * For the initial layer fan speed we'll gradually increase the fan speed to
      * the regular fan speed across a number of layers. This is that number of
@@ -204,6 +204,17 @@ private:
      */
     ProcessLayerResult processLayer(const SliceDataStorage& storage, LayerIndex layer_nr, const size_t total_layers) const;
 
+    /*!
+     * \brief How many layers below a layer processLayer() may read the slice data of, e.g. to find the support below a bridge.
+     *
+     * The layer plan buffer refers to the layer below the newest layer as well. So once a layer has been handled by the layer plan buffer,
+     * the slice data of the layers further below than this is not needed anymore.
+     *
+     * \param[in] storage where the slice data is stored.
+     * \return The number of layers.
+     */
+    size_t getLayerLookback(const SliceDataStorage& storage) const;
+
     /*!
      * This function checks whether prime blob should happen for any extruder on the first layer.
      * Priming will always happen, but the actual priming may or may not include a prime blob.
@@ -11,7 +11,7 @@ namespace cura
 {
 
 class MeshGroup;
-class ProgressStageEstimator;
+class OutlineWindowIntersections;
 class SliceDataStorage;
 class SliceMeshStorage;
 class TimeKeeper;
@@ -72,25 +72,26 @@ private:
     /*!
      * Processes the outline information as stored in the \p storage: generates inset perimeter polygons, skin and infill
      *
+     * The layers of all meshes are processed as one graph of tasks, where each task starts as soon as the data it reads is ready.
+     * Set the environment variable CURAENGINE_TASK_GRAPH_TRACE to a file path to write the timeline of the tasks to it.
+     *
      * \param storage Input and Output parameter: fetches the outline information (see SliceLayerPart::outline) and generates the other reachable field of the \p storage
-     * \param mesh_order_idx The index of the mesh_idx in \p mesh_order to process in the vector of meshes in \p storage
      * \param mesh_order The order in which the meshes are processed (used for infill meshes)
-     * \param inset_skin_progress_estimate The progress stage estimate calculator
      */
-    void processBasicWallsSkinInfill(
-        SliceDataStorage& storage,
-        const size_t mesh_order_idx,
-        const std::vector<size_t>& mesh_order,
-        ProgressStageEstimator& inset_skin_progress_estimate);
+    void processBasicWallsSkinInfill(SliceDataStorage& storage, const std::vector<size_t>& mesh_order);
 
     /*!
-     * Process the mesh to be an infill mesh: limit all outlines to within the infill of normal meshes and subtract their volume from the infill of those meshes
+     * Process a layer of the mesh to be an infill mesh: limit all outlines to within the infill of normal meshes and subtract their volume from the infill of those meshes
+     *
+     * Reads the infill of the same layer of the meshes with a lower order, so their skin and infill must have been generated already.
      *
      * \param storage Input and Output parameter: fetches the outline information (see SliceLayerPart::outline) and generates the other reachable field of the \p storage
      * \param mesh_order_idx The index of the mesh_idx in \p mesh_order to process in the vector of meshes in \p storage
      * \param mesh_order The order in which the meshes are processed
+     * \param layer_idx The layer to process
+     * \return Whether the layer has any parts (or polylines, in surface mode) left
      */
-    void processInfillMesh(SliceDataStorage& storage, const size_t mesh_order_idx, const std::vector<size_t>& mesh_order);
+    bool processInfillMeshLayer(SliceDataStorage& storage, const size_t mesh_order_idx, const std::vector<size_t>& mesh_order, const LayerIndex layer_idx);
 
     /*!
      * Process features which are derived from the basic walls, skin, and infill:
@@ -145,8 +146,15 @@ private:
      * \param mesh Input and Output parameter: fetches the outline information (see SliceLayerPart::outline) and generates the other reachable field of the \p storage
      * \param layer_nr The layer for which to generate the skin areas.
      * \param process_infill Generate infill areas
-     */
-    void processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill);
+     * \param top_windows The shared outline intersections over the top skin layers, if precomputed
+     * \param bottom_windows The shared outline intersections over the bottom skin layers, if precomputed
+     */
+    void processSkinsAndInfill(
+        SliceMeshStorage& mesh,
+        const LayerIndex layer_nr,
+        bool process_infill,
+        const OutlineWindowIntersections* top_windows = nullptr,
+        const OutlineWindowIntersections* bottom_windows = nullptr);
 
     /*!
      * Generate the polygons where the draft screen should be.
@@ -4,6 +4,8 @@
 #ifndef FFF_PROCESSOR_H
 #define FFF_PROCESSOR_H
 
+#include <memory>
+
 #include "FffGcodeWriter.h"
 #include "FffPolygonGenerator.h"
 #include "utils/NoCopy.h"
@@ -35,7 +37,7 @@ public:
     /*!
      * The gcode writer, which generates paths in layer plans in a buffer, which converts these paths into gcode commands.
      */
-    FffGcodeWriter gcode_writer;
+    std::unique_ptr<FffGcodeWriter> gcode_writer = std::make_unique<FffGcodeWriter>();
 
     /*!
      * The polygon generator, which slices the models and generates all polygons to be printed and areas to be filled.
@@ -51,6 +53,15 @@ public:
      * Add the end gcode and set all temperatures to zero.
      */
     void finalize();
+
+    /*!
+     * Replace the gcode writer by a fresh one.
+     *
+     * The gcode writer keeps the state of the gcode it has written, such as the
+     * position of the nozzle and the material used so far. When more than one
+     * slice is made in the same run, it has to start over for each of them.
+     */
+    void resetGcodeWriter();
 };
 
 } // namespace cura
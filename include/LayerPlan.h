@@ -9,16 +9,19 @@
 #include "InsetOrderOptimizer.h"
 #include "PathOrderOptimizer.h"
 #include "SpaceFillType.h"
+#include "bridge/BridgeLayerContext.h"
 #include "gcode_export/gcodeExport.h"
 #include "geometry/LinesSet.h"
 #include "geometry/MendedShape.h"
 #include "geometry/Polygon.h"
+#include "geometry/SegmentIndexedShape.h"
 #include "pathPlanning/GCodePath.h"
 #include "pathPlanning/NozzleTempInsert.h"
 #include "pathPlanning/TimeMaterialEstimates.h"
 #include "raft.h"
 #include "settings/PathConfigStorage.h"
 #include "settings/types/LayerIndex.h"
+#include "utils/ChunkedList.h"
 #include "utils/ExtrusionJunction.h"
 
 #ifdef BUILD_TESTS
@@ -158,12 +161,17 @@ private:
     coord_t comb_move_inside_distance_; //!< Whenever using the minimum boundary for combing it tries to move the coordinates inside by this distance after calculating the combing.
     Shape bridge_wall_mask_; //!< The regions of a layer part that are not supported, used for bridging
     AABB bridge_wall_mask_bb_; //!< Cached bounding box for the above value.
+    SegmentIndexedShape indexed_bridge_wall_mask_; //!< Indexed copy of the bridge wall mask, for the queries made for every wall segment
     std::vector<OverhangMask> overhang_masks_; //!< The regions of a layer part where the walls overhang, calculated for multiple overhang angles. The latter is the most
                                                //!< overhanging. For a visual explanation of the result, see doc/gradual_overhang_speed.svg
+    std::vector<SegmentIndexedShape> indexed_overhang_masks_; //!< Indexed copies of the supported regions of the overhang masks, in the same order
     Shape seam_overhang_mask_; //!< The regions of a layer part where the walls overhang, specifically as defined for the seam
 
     Shape roofing_mask_; //!< The regions of a layer part where the walls are exposed to the air above
+    SegmentIndexedShape indexed_roofing_mask_; //!< Indexed copy of the roofing mask
     Shape flooring_mask_; //!< The regions of a layer part where the walls are exposed to the air below
+    SegmentIndexedShape indexed_flooring_mask_; //!< Indexed copy of the flooring mask
+    BridgeLayerContext bridge_layer_context_; //!< The layers below this layer that the bridging skin rests on, shared by all skin parts of this layer
 
     bool currently_overhanging_{ false }; //!< Indicates whether the last extrusion move was overhanging
     coord_t current_overhang_length_{ 0 }; //!< When doing consecutive overhanging moves, this is the current accumulated overhanging length
@@ -348,6 +356,12 @@ public:
      */
     void setBridgeWallMask(const Shape& polys);
 
+    /*!
+     * Get the layers below this layer that the bridging skin rests on, to
+     * share them between all skin parts of this layer.
+     */
+    BridgeLayerContext& getBridgeLayerContext();
+
     /*!
      * Set overhang_masks.
      *
@@ -912,6 +926,26 @@ public:
      */
     void applyGradualFlow();
 
+    /*!
+     * Compute the time estimates of all paths that don't depend on where the previous layer ends.
+     *
+     * This can be done while the layer is produced, in parallel with the other layers, so that \ref processFanSpeedAndMinimalLayerTime
+     * only has to estimate the first moves of the layer in the serial part of the g-code export.
+     */
+    void precomputeNaiveTimeEstimates();
+
+    /*!
+     * Format the X and Y parameters of the extrusion moves of this layer, which is the part of the g-code text that doesn't depend on the
+     * previous layers.
+     *
+     * This can be done while the layer is produced, in parallel with the other layers, so that \ref writeGCode only has to write what
+     * depends on the state of the g-code export, like the F, Z and E parameters, retractions and temperatures. No points of the extrusion
+     * paths may be changed afterwards.
+     *
+     * \param gcode The g-code export that will write the layer, for the nozzle offsets
+     */
+    void formatExtrusionCoordinates(const GCodeExport& gcode);
+
     /*!
      * Gets the mesh being printed first on this layer
      */
@@ -1039,6 +1073,7 @@ private:
      * \param extrusion_mm3_per_mm The desired flow rate
      * \param feature The current feature being printed
      * \param update_extrusion_offset whether to update the extrusion offset to match the current flow rate
+     * \param formatted_xy The X and Y parameters of this move as formatted by \ref formatExtrusionCoordinates, or empty to format them now
      */
     void writeExtrusionRelativeZ(
         GCodeExport& gcode,
@@ -1047,7 +1082,8 @@ private:
         const coord_t path_z_offset,
         double extrusion_mm3_per_mm,
         PrintFeatureType feature,
-        bool update_extrusion_offset = false);
+        bool update_extrusion_offset = false,
+        const std::string_view formatted_xy = {});
 
     /*!
      * \brief Alias for a function definition that adds an extrusion segment
@@ -1297,7 +1333,7 @@ private:
      * @return Extrusion path to be started from the given start point, going further inwards. It may be empty if not possible or if the start point is
      *         already inwards the contour enough.
      */
-    static OpenPolyline makeInwardsMove(const std::list<STHalfEdge>& trapezoidal_edges, const Point2LL& start_point, const coord_t move_inwards_length);
+    static OpenPolyline makeInwardsMove(const ChunkedList<STHalfEdge>& trapezoidal_edges, const Point2LL& start_point, const coord_t move_inwards_length);
 };
 
 } // namespace cura
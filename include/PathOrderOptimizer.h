@@ -4,9 +4,13 @@
 #ifndef PATHORDEROPTIMIZER_H
 #define PATHORDEROPTIMIZER_H
 
+#include <limits>
 #include <numbers>
+#include <optional>
 #include <unordered_set>
+#include <vector>
 
+#include <range/v3/algorithm/count_if.hpp>
 #include <range/v3/algorithm/max_element.hpp>
 #include <range/v3/algorithm/partition_copy.hpp>
 #include <range/v3/iterator/insert_iterators.hpp>
@@ -22,6 +26,7 @@
 #include "path_ordering.h"
 #include "settings/EnumSettings.h" //To get the seam settings.
 #include "settings/ZSeamConfig.h" //To read the seam configuration.
+#include "utils/RingSearchGrid.h"
 #include "utils/linearAlg2D.h" //To find the angle of corners to hide seams.
 #include "utils/math.h"
 #include "utils/polygonUtils.h"
@@ -245,8 +250,7 @@ public:
         {
             for (auto& path : paths_)
             {
-                if (path.seam_config_.type_ == EZSeamType::RANDOM || path.seam_config_.type_ == EZSeamType::USER_SPECIFIED
-                    || path.seam_config_.type_ == EZSeamType::SHARPEST_CORNER)
+                if (isStartPrecomputed(path))
                 {
                     if (! path.is_closed_ || path.converted_->empty())
                     {
@@ -290,6 +294,13 @@ protected:
      */
     constexpr static coord_t _coincident_point_distance = 10;
 
+    /*!
+     * With more paths than this, travels that hit the combing boundary are
+     * penalized with a static factor instead of computing the actual combing
+     * path, since that would become too expensive.
+     */
+    constexpr static size_t _max_paths_for_combing_paths = 100;
+
     /*!
      * Bucket grid to store the locations of the combing boundary.
      *
@@ -353,19 +364,34 @@ protected:
      */
     const std::shared_ptr<TextureDataProvider> texture_data_provider_;
 
-    std::vector<OrderablePath> getOptimizedOrder(SparsePointGridInclusive<size_t> line_bucket_grid, size_t snap_radius)
+    std::vector<OrderablePath> getOptimizedOrder(const SparsePointGridInclusive<size_t>& line_bucket_grid, size_t snap_radius)
     {
         std::vector<OrderablePath> optimized_order; // To store our result in.
+        optimized_order.reserve(paths_.size());
 
         Point2LL current_position = start_point_;
 
-        std::unordered_map<OrderablePath*, bool> picked(paths_.size()); // Fixed size boolean flag for whether each path is already in the optimized vector.
+        std::vector<bool> picked(paths_.size(), false); // Fixed size boolean flag for whether each path is already in the optimized vector.
 
-        auto notPicked = [&picked](OrderablePath* c)
+        auto notPicked = [this, &picked](OrderablePath* c)
         {
-            return ! picked[c];
+            return ! picked[c - paths_.data()];
         };
 
+        // When nothing is within snap_radius, search outward from the current position rather than through all paths.
+        // That only finds the same path as trying them all if the combing distance is never shorter than the direct distance, which doesn't
+        // hold for the actual combing paths due to rounding.
+        const bool search_nearest = combing_boundary_ == nullptr || paths_.size() > _max_paths_for_combing_paths;
+        size_t unpicked_non_empty = ranges::count_if(
+            paths_,
+            [](const OrderablePath& path)
+            {
+                return ! path.converted_->empty();
+            });
+        std::optional<RingSearchGrid<size_t>> nearest_grid;
+        size_t nearest_grid_paths = 0; // How many unpicked paths were in the grid when it was built.
+        std::vector<size_t> evaluated_in_step(paths_.size(), std::numeric_limits<size_t>::max());
+
         while (optimized_order.size() < paths_.size())
         {
             // Use bucket grid to find paths within snap_radius
@@ -382,22 +408,35 @@ protected:
                 available_candidates.push_back(candidate);
             }
 
-            if (available_candidates.empty()) // We need to broaden our search through all candidates
+            OrderablePath* best_path = nullptr;
+            if (! available_candidates.empty())
+            {
+                best_path = findBestPath(current_position, available_candidates);
+            }
+            else if (search_nearest && ! prefer_longest_path_ && unpicked_non_empty > 0)
+            {
+                if (! nearest_grid || unpicked_non_empty < nearest_grid_paths / 2) // Rebuild once most of the grid is picked, to keep the rings dense.
+                {
+                    nearest_grid.emplace(getUnpickedStartLocations(picked));
+                    nearest_grid_paths = unpicked_non_empty;
+                }
+                best_path = findClosestUnpickedPath(current_position, *nearest_grid, picked, evaluated_in_step, optimized_order.size());
+            }
+            else // We need to broaden our search through all candidates
             {
                 for (auto path : paths_ | ranges::views::addressof | ranges::views::filter(notPicked))
                 {
                     available_candidates.push_back(path);
                 }
+                best_path = findBestPath(current_position, available_candidates);
             }
 
-            auto best_candidate = findBestPath(current_position, available_candidates);
-
-            auto best_path = best_candidate;
             optimized_order.push_back(*best_path);
-            picked[best_path] = true;
+            picked[best_path - paths_.data()] = true;
 
             if (! best_path->converted_->empty()) // If all paths were empty, the best path is still empty. We don't upate the current position then.
             {
+                --unpicked_non_empty;
                 if (best_path->is_closed_)
                 {
                     current_position = (*best_path->converted_)[best_path->start_vertex_]; // We end where we started.
@@ -413,6 +452,103 @@ protected:
         return optimized_order;
     }
 
+    /*!
+     * Get the locations where each unpicked, non-empty path may start.
+     *
+     * The travel distance to a path is never shorter than the distance to the
+     * nearest of these locations. For polylines these are the endpoints, for
+     * polygons with a precomputed seam it is that seam, and otherwise it could
+     * be any vertex.
+     * \param picked For each path, whether it is already in the optimized order.
+     * \return Pairs of locations and the index of their path.
+     */
+    std::vector<std::pair<Point2LL, size_t>> getUnpickedStartLocations(const std::vector<bool>& picked) const
+    {
+        std::vector<std::pair<Point2LL, size_t>> locations;
+        for (const auto& [path_idx, path] : paths_ | ranges::views::enumerate)
+        {
+            if (picked[path_idx] || path.converted_->empty())
+            {
+                continue;
+            }
+            if (! path.is_closed_)
+            {
+                locations.emplace_back(path.converted_->front(), path_idx);
+                locations.emplace_back(path.converted_->back(), path_idx);
+            }
+            else if (isStartPrecomputed(path))
+            {
+                locations.emplace_back((*path.converted_)[path.start_vertex_], path_idx);
+            }
+            else
+            {
+                for (const Point2LL& point : *path.converted_)
+                {
+                    locations.emplace_back(point, path_idx);
+                }
+            }
+        }
+        return locations;
+    }
+
+    /*!
+     * Find the closest unpicked path, searching outward from the start
+     * position.
+     *
+     * This gives the same result as \ref findClosestPath on all unpicked paths
+     * in their original order, including which path wins a tie, as long as
+     * combing distances are never shorter than direct distances. Only paths
+     * with a start location that could be closer than the best path so far are
+     * evaluated.
+     * \param start_position The position to travel from.
+     * \param grid The possible start locations of the paths, see
+     * \ref getUnpickedStartLocations . It may also contain picked paths.
+     * \param picked For each path, whether it is already in the optimized order.
+     * \param evaluated_in_step For each path, the last step in which it was
+     * evaluated, so that paths with multiple start locations are only
+     * evaluated once per step.
+     * \param step The number of the current step.
+     * \return The closest path.
+     */
+    OrderablePath* findClosestUnpickedPath(
+        const Point2LL& start_position,
+        const RingSearchGrid<size_t>& grid,
+        const std::vector<bool>& picked,
+        std::vector<size_t>& evaluated_in_step,
+        const size_t step)
+    {
+        coord_t best_distance2 = std::numeric_limits<coord_t>::max();
+        size_t best_idx = paths_.size();
+
+        grid.visitNearest(
+            start_position,
+            [&](const Point2LL& location, const size_t path_idx)
+            {
+                if (picked[path_idx] || evaluated_in_step[path_idx] == step)
+                {
+                    return best_distance2;
+                }
+                const coord_t location_distance2 = getDirectDistance(start_position, location);
+                if (location_distance2 > best_distance2 || (location_distance2 == best_distance2 && path_idx > best_idx))
+                {
+                    return best_distance2; // Can't beat the best path from this location, but maybe from another start location of the same path.
+                }
+                evaluated_in_step[path_idx] = step;
+
+                // On a tie, the path that comes first in the original order wins.
+                const coord_t distance_threshold2 = (path_idx < best_idx && best_distance2 < std::numeric_limits<coord_t>::max()) ? best_distance2 + 1 : best_distance2;
+                const coord_t distance2 = planStartLocation(paths_[path_idx], start_position, distance_threshold2);
+                if (distance2 < distance_threshold2)
+                {
+                    best_distance2 = distance2;
+                    best_idx = path_idx;
+                }
+                return best_distance2;
+            });
+
+        return &paths_[best_idx];
+    }
+
     std::vector<OrderablePath> getOptimizerOrderWithConstraints(const std::unordered_multimap<Path, Path>& order_requirements)
     {
         std::vector<OrderablePath> optimized_order; // To store our result in.
@@ -659,23 +795,7 @@ protected:
                 continue;
             }
 
-            const bool precompute_start = path->seam_config_.type_ == EZSeamType::RANDOM || path->seam_config_.type_ == EZSeamType::USER_SPECIFIED
-                                       || path->seam_config_.type_ == EZSeamType::SHARPEST_CORNER;
-            if (! path->is_closed_ || ! precompute_start) // Find the start location unless we've already precomputed it.
-            {
-                path->start_vertex_ = findStartLocation(*path, start_position);
-                if (! path->is_closed_) // Open polylines start at vertex 0 or vertex N-1. Indicate that they should be reversed if they start at N-1.
-                {
-                    path->backwards_ = path->start_vertex_ > 0;
-                }
-            }
-            const Point2LL candidate_position = (*path->converted_)[path->start_vertex_];
-            coord_t distance2 = getDirectDistance(start_position, candidate_position);
-            if (distance2 < best_distance2
-                && combing_boundary_) // If direct distance is longer than best combing distance, the combing distance can never be better, so only compute combing if necessary.
-            {
-                distance2 = getCombingDistance(start_position, candidate_position);
-            }
+            const coord_t distance2 = planStartLocation(*path, start_position, best_distance2);
             if (distance2 < best_distance2) // Closer than the best candidate so far.
             {
                 best_candidate = path;
@@ -686,6 +806,48 @@ protected:
         return best_candidate;
     }
 
+    /*!
+     * Decide where to start printing a path when travelling from a certain
+     * position, and compute the distance to travel there.
+     *
+     * This sets the start vertex of the path, unless it was precomputed.
+     * \param path The path to plan the start of. It must have vertices.
+     * \param start_position The position to travel from.
+     * \param distance_threshold2 The combing distance is only computed if the
+     * direct distance is shorter than this, since the combing distance is never
+     * shorter. Otherwise the direct distance is returned.
+     * \return The squared distance to travel to the start of the path.
+     */
+    coord_t planStartLocation(OrderablePath& path, const Point2LL& start_position, const coord_t distance_threshold2)
+    {
+        if (! path.is_closed_ || ! isStartPrecomputed(path)) // Find the start location unless we've already precomputed it.
+        {
+            path.start_vertex_ = findStartLocation(path, start_position);
+            if (! path.is_closed_) // Open polylines start at vertex 0 or vertex N-1. Indicate that they should be reversed if they start at N-1.
+            {
+                path.backwards_ = path.start_vertex_ > 0;
+            }
+        }
+        const Point2LL candidate_position = (*path.converted_)[path.start_vertex_];
+        coord_t distance2 = getDirectDistance(start_position, candidate_position);
+        if (distance2 < distance_threshold2
+            && combing_boundary_) // If direct distance is longer than best combing distance, the combing distance can never be better, so only compute combing if necessary.
+        {
+            distance2 = getCombingDistance(start_position, candidate_position);
+        }
+        return distance2;
+    }
+
+    /*!
+     * Whether the seam of a path is fixed, regardless of where the nozzle comes
+     * from. Those seams are computed once in advance.
+     */
+    static bool isStartPrecomputed(const OrderablePath& path)
+    {
+        return path.seam_config_.type_ == EZSeamType::RANDOM || path.seam_config_.type_ == EZSeamType::USER_SPECIFIED
+            || path.seam_config_.type_ == EZSeamType::SHARPEST_CORNER;
+    }
+
     /**
      * @brief Analyze the positions in a path and determine the next optimal position based on a proximity criterion.
      *
@@ -879,7 +1041,7 @@ protected:
         {
             return getDirectDistance(a, b); // No collision with any line. Just compute the direct distance then.
         }
-        if (paths_.size() > 100)
+        if (paths_.size() > _max_paths_for_combing_paths)
         {
             /* If we have many paths to optimize the order for, this combing
             calculation can become very expensive. Instead, penalize travels
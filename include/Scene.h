@@ -4,12 +4,16 @@
 #ifndef SCENE_H
 #define SCENE_H
 
+#include <memory>
+#include <vector>
+
 #include "ExtruderTrain.h" //To store the extruders in the scene.
 #include "MeshGroup.h" //To store the mesh groups in the scene.
 #include "settings/Settings.h" //To store the global settings.
 
 namespace cura
 {
+class SliceDataStorage;
 
 /*
  * Represents a scene that should be sliced.
@@ -47,6 +51,13 @@ public:
      */
     std::vector<MeshGroup>::iterator current_mesh_group;
 
+    /*
+     * \brief Whether to keep the sliced data of each mesh group after its
+     * g-code is written, so that the g-code can be written again with
+     * \ref rewriteMeshGroupGCode without slicing again.
+     */
+    bool keep_slice_data = false;
+
     /*
      * \brief Create an empty scene.
      *
@@ -56,6 +67,8 @@ public:
      */
     Scene(const size_t num_mesh_groups);
 
+    ~Scene();
+
     /*
      * \brief Gets a string that contains all settings.
      *
@@ -71,7 +84,25 @@ public:
      */
     void processMeshGroup(MeshGroup& mesh_group);
 
+    /*
+     * \brief Write the g-code of a mesh group again, from the slice data that
+     * was kept when it was processed.
+     *
+     * The slice data only depends on the settings that are used to slice, so
+     * this may only be used if no other settings changed since then than the
+     * ones that are only used to write g-code.
+     * \param mesh_group The mesh group to write the g-code for. If no slice data
+     * was kept for it, no g-code is written, just like when it was processed.
+     */
+    void rewriteMeshGroupGCode(MeshGroup& mesh_group);
+
 private:
+    /*
+     * \brief The sliced data of each mesh group, if \ref keep_slice_data is
+     * set. Mesh groups without any printed model have no slice data.
+     */
+    std::vector<std::unique_ptr<SliceDataStorage>> kept_slice_data_;
+
     /*
      * \brief You are not allowed to copy the scene.
      */
@@ -36,6 +36,15 @@ public:
      */
     void compute();
 
+    /*
+     * \brief Write the g-code of the scene again, without slicing it again.
+     *
+     * This requires the scene to have been computed before with
+     * \ref Scene::keep_slice_data set, and only settings that are used to
+     * write g-code may have changed since.
+     */
+    void rewriteGCode();
+
     /*
      * \brief Empty out the slice instance, restoring it as if it were a new
      * instance.
@@ -15,6 +15,7 @@
 #include "settings/EnumSettings.h" //To store whether X/Y or Z distance gets priority.
 #include "settings/types/LayerIndex.h" //Part of the RadiusLayerPair.
 #include "utils/PairHash.h"
+#include "utils/ShardedCache.h"
 #include "utils/Simplify.h"
 
 namespace cura
@@ -128,6 +129,14 @@ public:
      */
     const Shape& getWallRestriction(coord_t radius, LayerIndex layer_idx, bool min_xy_dist);
 
+    /*!
+     * \brief Log how often the caches were hit, missed and had to wait for another thread.
+     *
+     * Useful to see whether precalculate computed everything that is requested later on, and whether the caches are a bottleneck when
+     * generating the support trees with many threads.
+     */
+    void logCacheStatistics() const;
+
     /*!
      * \brief Round \p radius upwards to either a multiple of radius_sample_resolution_ or a exponentially increasing value
      *
@@ -155,6 +164,11 @@ private:
      */
     using RadiusLayerPair = std::pair<coord_t, LayerIndex>;
 
+    /*!
+     * \brief Cache of areas per radius and layer, that can be read from many threads at once.
+     */
+    using RadiusLayerCache = ShardedCache<RadiusLayerPair, Shape>;
+
     /*!
      * \brief Round \p radius upwards to either a multiple of radius_sample_resolution_ or a exponentially increasing value
      *
@@ -331,14 +345,6 @@ private:
         calculateWallRestrictions(std::deque<RadiusLayerPair>{ RadiusLayerPair(key) });
     }
 
-    /*!
-     * \brief Checks a cache for a given RadiusLayerPair and returns it if it is found
-     * \param key RadiusLayerPair of the requested areas. The radius will be calculated up to the provided layer.
-     * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
-     */
-    template<typename KEY>
-    const std::optional<std::reference_wrapper<const Shape>> getArea(const std::unordered_map<KEY, Shape>& cache, const KEY key) const;
-
     bool checkSettingsEquality(const Settings& me, const Settings& other) const;
 
     /*!
@@ -348,7 +354,7 @@ private:
      *
      * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
      */
-    LayerIndex getMaxCalculatedLayer(coord_t radius, const std::unordered_map<RadiusLayerPair, Shape>& map) const;
+    LayerIndex getMaxCalculatedLayer(coord_t radius, const RadiusLayerCache& map) const;
 
     static Shape calculateMachineBorderCollision(const Shape&& machine_border);
 
@@ -470,54 +476,35 @@ private:
      * generally considered OK as the functions are still logically const
      * (ie there is no difference in behaviour for the user between
      * calculating the values each time vs caching the results).
+     *
+     * They are read from all threads generating the trees, so they are sharded
+     * to keep the threads from queueing up behind a single lock per cache.
      */
-    mutable std::unordered_map<RadiusLayerPair, Shape> collision_cache_;
-    std::unique_ptr<std::mutex> critical_collision_cache_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> collision_cache_holefree_;
-    std::unique_ptr<std::mutex> critical_collision_cache_holefree_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<LayerIndex, Shape> accumulated_placeables_cache_radius_0_;
-    std::unique_ptr<std::mutex> critical_accumulated_placeables_cache_radius_0_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_collision_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_collision_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_slow_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_slow_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_to_model_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_to_model_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_to_model_slow_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_to_model_slow_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> placeable_areas_cache_;
-    std::unique_ptr<std::mutex> critical_placeable_areas_cache_ = std::make_unique<std::mutex>();
+    mutable RadiusLayerCache collision_cache_;
+    mutable RadiusLayerCache collision_cache_holefree_;
+    mutable ShardedCache<LayerIndex, Shape> accumulated_placeables_cache_radius_0_;
+    mutable RadiusLayerCache avoidance_cache_collision_;
+    mutable RadiusLayerCache avoidance_cache_;
+    mutable RadiusLayerCache avoidance_cache_slow_;
+    mutable RadiusLayerCache avoidance_cache_to_model_;
+    mutable RadiusLayerCache avoidance_cache_to_model_slow_;
+    mutable RadiusLayerCache placeable_areas_cache_;
 
     /*!
      * \brief Caches to avoid holes smaller than the radius until which the radius is always increased, as they are free of holes. Also called safe avoidances, as they are safe
      * regarding not running into holes.
      */
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_hole_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_holefree_ = std::make_unique<std::mutex>();
-
-    mutable std::unordered_map<RadiusLayerPair, Shape> avoidance_cache_hole_to_model_;
-    std::unique_ptr<std::mutex> critical_avoidance_cache_holefree_to_model_ = std::make_unique<std::mutex>();
+    mutable RadiusLayerCache avoidance_cache_hole_;
+    mutable RadiusLayerCache avoidance_cache_hole_to_model_;
 
     /*!
      * \brief Caches to represent walls not allowed to be passed over.
      */
-    mutable std::unordered_map<RadiusLayerPair, Shape> wall_restrictions_cache_;
-    std::unique_ptr<std::mutex> critical_wall_restrictions_cache_ = std::make_unique<std::mutex>();
+    mutable RadiusLayerCache wall_restrictions_cache_;
 
     // A different cache for min_xy_dist as the maximal safe distance an influence area can be increased(guaranteed overlap of two walls in consecutive layer) is much smaller when
     // min_xy_dist is used. This causes the area of the wall restriction to be thinner and as such just using the min_xy_dist wall restriction would be slower.
-    mutable std::unordered_map<RadiusLayerPair, Shape> wall_restrictions_cache_min_;
-    std::unique_ptr<std::mutex> critical_wall_restrictions_cache_min_ = std::make_unique<std::mutex>();
+    mutable RadiusLayerCache wall_restrictions_cache_min_;
 
     std::unique_ptr<std::mutex> critical_progress_ = std::make_unique<std::mutex>();
 
@@ -4,9 +4,9 @@
 #ifndef SKELETAL_TRAPEZOIDATION_H
 #define SKELETAL_TRAPEZOIDATION_H
 
-#include <memory> // smart pointers
-#include <unordered_map>
+#include <list>
 #include <utility> // pair
+#include <vector>
 
 #include <boost/polygon/voronoi.hpp>
 
@@ -17,6 +17,7 @@
 #include "geometry/MendedShape.h"
 #include "geometry/Polygon.h"
 #include "settings/types/Ratio.h"
+#include "utils/ChunkedList.h"
 #include "utils/ExtrusionJunction.h"
 #include "utils/ExtrusionLine.h"
 #include "utils/PolygonsSegmentIndex.h"
@@ -58,7 +59,7 @@ class SkeletalTrapezoidation
     using TransitionEnd = SkeletalTrapezoidationEdge::TransitionEnd;
 
     template<typename T>
-    using ptr_vector_t = std::vector<std::shared_ptr<T>>;
+    using storage_t = ChunkedList<T>;
 
     AngleRadians transitioning_angle_; //!< How pointy a region should be before we apply the method. Equals 180* - limit_bisector_angle
     coord_t discretization_step_size_; //!< approximate size of segments when parabolic VD edges get discretized (and vertex-vertex edges)
@@ -109,6 +110,9 @@ public:
      * \param beading_propagation_transition_dist When there are different
      * beadings propagated from below and from above, use this transitioning
      * distance.
+     * \param graph A graph to build the skeletal graph in, whose contents are
+     * discarded. Passing in the graph of a previous trapezoidation reuses its
+     * memory.
      */
     SkeletalTrapezoidation(
         const MendedShape& polys,
@@ -119,7 +123,8 @@ public:
         coord_t allowed_filter_deviation,
         coord_t beading_propagation_transition_dist,
         int layer_idx,
-        SectionType section_type);
+        SectionType section_type,
+        graph_t graph = graph_t());
 
     /*!
      * Generate the paths that the printer must extrude, to print the outlines
@@ -149,9 +154,32 @@ protected:
     /*!
      * mapping each voronoi VD edge to the corresponding halfedge HE edge
      * In case the result segment is discretized, we map the VD edge to the *last* HE edge
+     *
+     * Rather than hashing the VD edges, the color of a VD edge is set to its index in this vector plus one; uncolored VD edges have not been transferred yet.
+     */
+    std::vector<edge_t*> vd_edge_to_he_edge_;
+    std::vector<node_t*> vd_node_to_he_node_; //!< Same as \ref vd_edge_to_he_edge_, for the VD nodes
+
+    /*!
+     * The storage of the transitions, transition ends, beadings and junctions which the edges and nodes of the graph
+     * refer to. It is kept together for all edges and nodes rather than allocating it for every one of them separately.
+     */
+    storage_t<std::list<TransitionMiddle>> edge_transitions_;
+    storage_t<std::list<TransitionEnd>> edge_transition_ends_; //!< We only map the half edge in the upward direction. mapped items are not sorted
+    storage_t<BeadingPropagation> node_beadings_;
+    storage_t<LineJunctions> edge_junctions_; //!< junctions ordered high R to low R
+
+    /*!
+     * Get the half edge that a VD edge was transferred to, i.e. the last one if it was discretized.
+     * \return The half edge, or nullptr if the VD edge wasn't transferred yet.
+     */
+    edge_t* getTransferredEdge(const vd_t::edge_type& vd_edge) const;
+
+    /*!
+     * Get the node that a VD node was transferred to.
+     * \return The node, or nullptr if the VD node wasn't transferred yet.
      */
-    std::unordered_map<vd_t::edge_type*, edge_t*> vd_edge_to_he_edge_;
-    std::unordered_map<vd_t::vertex_type*, node_t*> vd_node_to_he_node_;
+    node_t* getTransferredNode(const vd_t::vertex_type& vd_node) const;
 
     /*!
      * Compute the skeletal trapezoidation decomposition of the input shape.
@@ -351,7 +379,7 @@ protected:
      * returned via the output parameter.
      * \param[out] edge_transitions A list of transitions that were generated.
      */
-    void generateTransitionMids(ptr_vector_t<std::list<TransitionMiddle>>& edge_transitions);
+    void generateTransitionMids(storage_t<std::list<TransitionMiddle>>& edge_transitions);
 
     /*!
      * Removes some transition middle points.
@@ -405,12 +433,12 @@ protected:
      * Generate the endpoints of all transitions for all edges in the graph.
      * \param[out] edge_transition_ends The resulting transition endpoints.
      */
-    void generateAllTransitionEnds(ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends);
+    void generateAllTransitionEnds(storage_t<std::list<TransitionEnd>>& edge_transition_ends);
 
     /*!
      * Also set the rest values at nodes in between the transition ends
      */
-    void applyTransitions(ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends);
+    void applyTransitions(storage_t<std::list<TransitionEnd>>& edge_transition_ends);
 
     /*!
      * Create extra edges along all edges, where it needs to transition from one
@@ -433,7 +461,7 @@ protected:
      * \param[out] edge_transition_ends A list of endpoints to add the new
      * endpoints to.
      */
-    void generateTransitionEnds(edge_t& edge, coord_t mid_R, coord_t transition_lower_bead_count, ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends);
+    void generateTransitionEnds(edge_t& edge, coord_t mid_R, coord_t transition_lower_bead_count, storage_t<std::list<TransitionEnd>>& edge_transition_ends);
 
     /*!
      * Compute a single endpoint of a transition.
@@ -463,7 +491,7 @@ protected:
         Ratio start_rest,
         Ratio end_rest,
         coord_t transition_lower_bead_count,
-        ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends);
+        storage_t<std::list<TransitionEnd>>& edge_transition_ends);
 
     /*!
      * Determines whether an edge is going downwards or upwards in the graph.
@@ -533,7 +561,7 @@ protected:
      * \param upward_quad_mids all upward halfedges of the inner skeletal edges (not directly connected to the outline) sorted on their highest [distance_to_boundary]. Higher dist
      * first.
      */
-    void propagateBeadingsUpward(std::vector<edge_t*>& upward_quad_mids, ptr_vector_t<BeadingPropagation>& node_beadings);
+    void propagateBeadingsUpward(std::vector<edge_t*>& upward_quad_mids, storage_t<BeadingPropagation>& node_beadings);
 
     /*!
      * propagate beading info from higher R nodes to lower R nodes
@@ -547,12 +575,12 @@ protected:
      * \param upward_quad_mids all upward halfedges of the inner skeletal edges (not directly connected to the outline) sorted on their highest [distance_to_boundary]. Higher dist
      * first.
      */
-    void propagateBeadingsDownward(std::vector<edge_t*>& upward_quad_mids, ptr_vector_t<BeadingPropagation>& node_beadings);
+    void propagateBeadingsDownward(std::vector<edge_t*>& upward_quad_mids, storage_t<BeadingPropagation>& node_beadings);
 
     /*!
-     * Subroutine of \ref propagateBeadingsDownward(std::vector<edge_t*>&, ptr_vector_t<BeadingPropagation>&)
+     * Subroutine of \ref propagateBeadingsDownward(std::vector<edge_t*>&, storage_t<BeadingPropagation>&)
      */
-    void propagateBeadingsDownward(edge_t* edge_to_peak, ptr_vector_t<BeadingPropagation>& node_beadings);
+    void propagateBeadingsDownward(edge_t* edge_to_peak, storage_t<BeadingPropagation>& node_beadings);
 
     /*!
      * Find a beading in between two other beadings.
@@ -595,7 +623,7 @@ protected:
      * \param node_beadings A list of all beadings for nodes.
      * \return The beading of that node.
      */
-    std::shared_ptr<BeadingPropagation> getOrCreateBeading(node_t* node, ptr_vector_t<BeadingPropagation>& node_beadings);
+    BeadingPropagation* getOrCreateBeading(node_t* node, storage_t<BeadingPropagation>& node_beadings);
 
     /*!
      * In case we cannot find the beading of a node, get a beading from the
@@ -606,13 +634,13 @@ protected:
      * \return A beading for the node, or ``nullptr`` if there is no node nearby
      * with a beading.
      */
-    std::shared_ptr<BeadingPropagation> getNearestBeading(node_t* node, coord_t max_dist);
+    BeadingPropagation* getNearestBeading(node_t* node, coord_t max_dist);
 
     /*!
      * generate junctions for each bone
      * \param edge_to_junctions junctions ordered high R to low R
      */
-    void generateJunctions(ptr_vector_t<BeadingPropagation>& node_beadings, ptr_vector_t<LineJunctions>& edge_junctions);
+    void generateJunctions(storage_t<BeadingPropagation>& node_beadings, storage_t<LineJunctions>& edge_junctions);
 
     /*!
      * Add a new toolpath segment, defined between two extrusion-juntions.
@@ -629,7 +657,7 @@ protected:
     /*!
      * connect junctions in each quad
      */
-    void connectJunctions(ptr_vector_t<LineJunctions>& edge_junctions);
+    void connectJunctions(storage_t<LineJunctions>& edge_junctions);
 
     /*!
      * Genrate small segments for local maxima where the beading would only result in a single bead
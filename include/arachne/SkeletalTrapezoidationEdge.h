@@ -6,7 +6,6 @@
 
 #include <cassert>
 #include <list>
-#include <memory> // smart pointers
 #include <vector>
 
 #include "utils/ExtrusionJunction.h"
@@ -91,49 +90,50 @@ public:
 
     bool hasTransitions(bool ignore_empty = false) const
     {
-        return transitions_.use_count() > 0 && (ignore_empty || ! transitions_.lock()->empty());
+        return transitions_ && (ignore_empty || ! transitions_->empty());
     }
-    void setTransitions(std::shared_ptr<std::list<TransitionMiddle>>& storage)
+    void setTransitions(std::list<TransitionMiddle>& storage)
     {
-        transitions_ = storage;
+        transitions_ = &storage;
     }
-    std::shared_ptr<std::list<TransitionMiddle>> getTransitions()
+    std::list<TransitionMiddle>* getTransitions()
     {
-        return transitions_.lock();
+        return transitions_;
     }
 
     bool hasTransitionEnds(bool ignore_empty = false) const
     {
-        return transition_ends_.use_count() > 0 && (ignore_empty || ! transition_ends_.lock()->empty());
+        return transition_ends_ && (ignore_empty || ! transition_ends_->empty());
     }
-    void setTransitionEnds(std::shared_ptr<std::list<TransitionEnd>>& storage)
+    void setTransitionEnds(std::list<TransitionEnd>& storage)
     {
-        transition_ends_ = storage;
+        transition_ends_ = &storage;
     }
-    std::shared_ptr<std::list<TransitionEnd>> getTransitionEnds()
+    std::list<TransitionEnd>* getTransitionEnds()
     {
-        return transition_ends_.lock();
+        return transition_ends_;
     }
 
     bool hasExtrusionJunctions(bool ignore_empty = false) const
     {
-        return extrusion_junctions_.use_count() > 0 && (ignore_empty || ! extrusion_junctions_.lock()->empty());
+        return extrusion_junctions_ && (ignore_empty || ! extrusion_junctions_->empty());
     }
-    void setExtrusionJunctions(std::shared_ptr<LineJunctions>& storage)
+    void setExtrusionJunctions(LineJunctions& storage)
     {
-        extrusion_junctions_ = storage;
+        extrusion_junctions_ = &storage;
     }
-    std::shared_ptr<LineJunctions> getExtrusionJunctions() const
+    LineJunctions* getExtrusionJunctions() const
     {
-        return const_cast<SkeletalTrapezoidationEdge*>(this)->extrusion_junctions_.lock();
+        return extrusion_junctions_;
     }
 
     Central is_central; //! whether the edge is significant; whether the source segments have a sharp angle; -1 is unknown
 
 private:
-    std::weak_ptr<std::list<TransitionMiddle>> transitions_;
-    std::weak_ptr<std::list<TransitionEnd>> transition_ends_;
-    std::weak_ptr<LineJunctions> extrusion_junctions_;
+    // The storage of these lists is owned by the SkeletalTrapezoidation, which keeps them together for all edges.
+    std::list<TransitionMiddle>* transitions_{ nullptr };
+    std::list<TransitionEnd>* transition_ends_{ nullptr };
+    LineJunctions* extrusion_junctions_{ nullptr };
 };
 
 
@@ -4,11 +4,10 @@
 #ifndef SKELETAL_TRAPEZOIDATION_GRAPH_H
 #define SKELETAL_TRAPEZOIDATION_GRAPH_H
 
-#include <list>
-
 #include "arachne/STHalfEdge.h"
 #include "arachne/STHalfEdgeNode.h"
 #include "geometry/Point2LL.h"
+#include "utils/ChunkedList.h"
 #include "utils/Coord_t.h"
 
 namespace cura
@@ -20,8 +19,19 @@ class SkeletalTrapezoidationGraph
     using node_t = STHalfEdgeNode;
 
 public:
-    std::list<edge_t> edges_;
-    std::list<node_t> nodes_;
+    ChunkedList<edge_t> edges_;
+    ChunkedList<node_t> nodes_;
+
+    /*!
+     * Remove all edges and nodes, but keep the memory they used so that the graph of the next layer can be built in it.
+     */
+    void clear();
+
+    /*!
+     * Remove all edges and nodes, and keep at most about \p max_retained_bytes of the memory they used. If they used
+     * more, the memory kept for the edges and for the nodes is reduced by the same factor.
+     */
+    void clear(const size_t max_retained_bytes);
 
     /*!
      * If an edge is too small, collapse it and its twin and fix the surrounding edges to ensure a consistent graph.
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef BRIDGE_BRIDGELAYERCONTEXT_H
+#define BRIDGE_BRIDGELAYERCONTEXT_H
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "geometry/Shape.h"
+#include "settings/types/LayerIndex.h"
+#include "utils/AABB.h"
+
+namespace cura
+{
+
+class SliceDataStorage;
+
+/*!
+ * The data of the layers below a layer that bridges rest on, shared by all the skin parts of all meshes in that layer.
+ *
+ * The layers below are only gathered when a skin part first asks for them, and then kept for the next skin parts, so
+ * that they are not computed again for every skin part that may be a bridge.
+ *
+ * \warning This is not thread safe. A context belongs to a single layer, which is planned by a single thread.
+ */
+class BridgeLayerContext
+{
+public:
+    static constexpr unsigned max_bridge_layer = 3; //!< The highest bridge layer number, i.e. the furthest that a layer looks down
+
+    /*!
+     * A part of a layer below on which a bridge could rest.
+     */
+    struct SolidPart
+    {
+        Shape outline; //!< The area of the part that a bridge can rest on
+        AABB bounding_box; //!< The bounding box of the complete layer part, to quickly skip the parts that are far away from a skin part
+    };
+
+    /*!
+     * The data of one of the layers below.
+     */
+    struct LayerBelow
+    {
+        std::vector<SolidPart> solid_parts; //!< The parts of all printed meshes, in the order of the meshes and their parts
+        Shape infill; //!< The union of the infill areas of all these parts
+        AABB infill_bounding_box; //!< The bounding box of the infill
+    };
+
+    /*!
+     * Create a context for a layer, without computing anything yet.
+     * \param storage The slice data storage where to find the layers below.
+     * \param layer_nr The layer which is being bridged.
+     */
+    BridgeLayerContext(const SliceDataStorage& storage, const LayerIndex layer_nr);
+
+    /*!
+     * Get the data of one of the layers below, computing it on the first call.
+     * \param bridge_layer The bridge layer number (1, 2 or 3), i.e. how many layers below the bridged layer to look.
+     */
+    const LayerBelow& getLayerBelow(const unsigned bridge_layer);
+
+private:
+    const SliceDataStorage& storage_; //!< The slice data storage where to find the layers below
+    const LayerIndex layer_nr_; //!< The layer which is being bridged
+    std::array<std::optional<LayerBelow>, max_bridge_layer> layers_below_; //!< The layers below which were computed already, by bridge layer number minus one
+
+    /*!
+     * Gather the data of one of the layers below.
+     * \param bridge_layer The bridge layer number (1, 2 or 3).
+     */
+    LayerBelow computeLayerBelow(const unsigned bridge_layer) const;
+};
+
+} // namespace cura
+
+#endif
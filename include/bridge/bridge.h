@@ -15,10 +15,11 @@ namespace cura
 
 class AABB;
 class Shape;
+class SegmentIndexedShape;
 class SliceMeshStorage;
-class SliceDataStorage;
 class SupportLayer;
 class AngleDegrees;
+class BridgeLayerContext;
 class LayerPlan;
 template<class PathType>
 class PathAdapter;
@@ -32,8 +33,8 @@ struct ExtrusionLine;
  * If the area should not be bridged, an angle of -1 is returned.
  * \param mesh The mesh being processed.
  * \param skin_outline The shape to fill with lines.
- * \param storage The slice data storage where to find objects that the bridge
- * could rest on in previous layers.
+ * \param layer_context The layers below which the bridge could rest on,
+ * shared by all skin parts of the layer.
  * \param layer_nr The layer currently being printed.
  * \param bridge_layer The bridge layer number (1, 2 or 3).
  * \param support_layer Support that the bridge could rest on.
@@ -43,7 +44,7 @@ struct ExtrusionLine;
 std::optional<AngleDegrees> bridgeAngle(
     const SliceMeshStorage& mesh,
     const Shape& skin_outline,
-    const SliceDataStorage& storage,
+    BridgeLayerContext& layer_context,
     const unsigned layer_nr,
     const unsigned bridge_layer,
     const SupportLayer* support_layer,
@@ -80,7 +81,7 @@ std::tuple<Shape, AngleDegrees> makeBridgeOverInfillPrintable(
  */
 std::vector<std::tuple<Ratio, Ratio>> wallSegmentUsesBridging(
     const AABB& bridge_mask_bb,
-    const Shape& bridge_mask,
+    const SegmentIndexedShape& bridge_mask,
     const PathAdapter<ExtrusionLine>& wall,
     const size_t segment_index,
     const Ratio& segment_start_ratio,
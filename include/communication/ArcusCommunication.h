@@ -34,6 +34,8 @@ class ArcusCommunication : public Communication
     FRIEND_TEST(ArcusCommunicationTest, FlushGCodeTest);
     FRIEND_TEST(ArcusCommunicationTest, HasSlice);
     FRIEND_TEST(ArcusCommunicationTest, SendLayerComplete);
+    FRIEND_TEST(ArcusCommunicationTest, StreamCompletedLayers);
+    FRIEND_TEST(ArcusCommunicationTest, MovesAfterLastLayerComplete);
     FRIEND_TEST(ArcusCommunicationTest, SendProgress);
     friend class ArcusCommunicationPrivateTest;
 #endif
@@ -59,6 +61,19 @@ public:
     /* \brief Sends a piece of GCode that is ready to be exported */
     void sendGCodePart(const std::string& gcode_part) override;
 
+    /*
+     * \brief GCode can't be replaced, as the front-end has received it in
+     * separate messages already.
+     */
+    bool overwriteGCodePart(const size_t offset, const std::string& gcode_part) override;
+
+    /*
+     * \brief The front-end reads the totals of the print from the header, and
+     * the header can't be replaced once it was sent. So the GCode is only sent
+     * once the slice is complete.
+     */
+    bool supportsGCodeStreaming() const override;
+
     /*
      * \brief Test if there are any more slices in the queue.
      */
@@ -91,8 +106,10 @@ public:
      * visualisation of the layer.
      *
      * This will be called after all the polygons and lines of this layer are
-     * sent via sendLineTo. This will flush all
-     * visualised data for one layer in one go.
+     * sent via sendLineTo. The visualised data of the layer is sent in one go
+     * as soon as data for the next layer comes in, so that the front-end
+     * receives the layers while the rest is still being sliced, and only the
+     * layers that are being written need to be kept in memory.
      * \param layer_nr The layer that was completed.
      * \param z The z-coordinate of the top side of the layer.
      * \param thickness The thickness of the layer.
@@ -116,7 +133,9 @@ public:
      * \brief Send the sliced layer data to the front-end after the optimisation
      * is done and the actual order in which to print has been set.
      *
-     * This layer data will be shown in the layer view of the front end.
+     * This layer data will be shown in the layer view of the front end. Most
+     * layers have already been sent when they were completed, so this sends
+     * the layers that remain, in order.
      */
     void sendOptimizedLayerData() override;
 
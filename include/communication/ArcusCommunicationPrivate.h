@@ -5,6 +5,8 @@
 #define ARCUSCOMMUNICATIONPRIVATE_H
 #ifdef ARCUS
 
+#include <deque> //To track the layers that are still on their way to the front-end.
+#include <memory>
 #include <sstream> //For ostringstream.
 
 #include "ArcusCommunication.h" //We're adding a subclass to this.
@@ -30,6 +32,24 @@ public:
      */
     std::shared_ptr<proto::LayerOptimized> getOptimizedLayerById(LayerIndex::value_type layer_nr);
 
+    /*
+     * Send the optimised layer data of a layer that is complete to the front-end, and stop storing it.
+     * \param layer_nr The layer number to send the optimised layer data of.
+     */
+    void sendOptimizedLayer(LayerIndex::value_type layer_nr);
+
+    /*
+     * Send the optimised layer data of a layer to the front-end.
+     *
+     * Arcus keeps a message until it is written to the front-end. If the
+     * front-end reads slower than the layers are sliced, this waits until
+     * fewer than max_layers_in_flight layers are waiting to be written, so
+     * that the queued layers don't grow without limit.
+     * \param layer The layer to send. The caller must not keep it, or it will
+     * never be seen as written.
+     */
+    void sendLayer(std::shared_ptr<proto::LayerOptimized> layer);
+
     /*
      * Reads the global settings from a Protobuf message.
      *
@@ -74,6 +94,9 @@ public:
 
     const size_t millisecUntilNextTry; // How long we wait until we try to connect again.
 
+    size_t max_layers_in_flight; //!< How many layers may be waiting to be written to the front-end before we wait for them.
+    std::deque<std::weak_ptr<proto::LayerOptimized>> layers_in_flight; //!< The layers that were sent. They expire once Arcus has written them.
+
 private:
     static void loadTextureData(const std::string& texture_str, Mesh& mesh);
 };
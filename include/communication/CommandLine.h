@@ -4,6 +4,8 @@
 #ifndef COMMANDLINE_H
 #define COMMANDLINE_H
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -11,12 +13,16 @@
 #include <rapidjson/document.h> //Loading JSON documents to get settings from them.
 #include <string> //To store the command line arguments.
 #include <unordered_map>
+#include <utility>
 #include <vector> //To store the command line arguments.
 
 #include "Communication.h" //The class we're implementing.
 
 namespace cura
 {
+class Matrix4x3D;
+class Mesh;
+class MeshGroup;
 class Settings;
 
 using setting_map = std::unordered_map<std::string, std::string>;
@@ -41,6 +47,19 @@ public:
     /* \brief Sends a piece of GCode that is ready to be exported */
     void sendGCodePart(const std::string& gcode_part) override;
 
+    /*
+     * \brief Replaces a piece of GCode that was written before.
+     *
+     * This is only possible when writing to a file, not to standard output.
+     */
+    bool overwriteGCodePart(const size_t offset, const std::string& gcode_part) override;
+
+    /*
+     * \brief Streaming is supported. When writing to standard output, the
+     * totals of the print are appended at the end.
+     */
+    bool supportsGCodeStreaming() const override;
+
     /*
      * \brief Test if there are any more slices to be made.
      */
@@ -126,12 +145,76 @@ public:
     void sliceNext() override;
 
 protected:
+    /*
+     * \brief Identifies a model file by its contents and the transformation it
+     * was loaded with, to recognise it when it is loaded again.
+     */
+    struct MeshFileKey
+    {
+        size_t content_hash;
+        std::uintmax_t file_size;
+        std::array<double, 12> transformation;
+
+        bool operator==(const MeshFileKey& other) const = default;
+    };
+
     /*
      * \brief The command line arguments that the application was called with.
      */
     std::vector<std::string> arguments_;
 
+    std::shared_ptr<std::ofstream> output_file_;
+    std::ostream* output_stream_;
+    std::streampos gcode_start_{ -1 }; //!< Position in the output file at which the GCode of the current slice starts.
+
+    /*
+     * \brief Whether to keep the models that are loaded, to copy them instead
+     * of loading them again when a next slice loads the same file.
+     *
+     * Only the models of the last slice are kept.
+     */
+    bool cache_meshes_ = false;
+
+    /*
+     * \brief The model files loaded for the current slice, in order, if
+     * \ref cache_meshes_ is set. The key is missing for models that can't be
+     * cached, such as models with textures.
+     */
+    std::vector<std::pair<std::string, std::optional<MeshFileKey>>> loaded_meshes_;
+
+    /*
+     * \brief Set up a new slice from the command line arguments, loading all
+     * the settings and models, without slicing it yet.
+     *
+     * The new slice becomes the current slice of the application. Afterwards
+     * the arguments are cleared.
+     */
+    void loadSlice();
+
+    /*
+     * \brief Slice the current slice of the application.
+     * \param rewrite_gcode Only write the g-code of the current slice again,
+     * from the slice data it kept the last time it was sliced.
+     */
+    void computeSlice(bool rewrite_gcode = false);
+
 private:
+    struct MeshFileKeyHash
+    {
+        size_t operator()(const MeshFileKey& key) const;
+    };
+
+    /*
+     * \brief A parsed definition file, with the state of the file when it was
+     * read, to detect when it changes.
+     */
+    struct CachedDefinition
+    {
+        std::filesystem::file_time_type last_write_time;
+        std::uintmax_t file_size;
+        std::shared_ptr<const rapidjson::Document> document;
+    };
+
     std::vector<std::filesystem::path> search_directories_;
 
     /*
@@ -139,8 +222,46 @@ private:
      */
     unsigned int last_shown_progress_;
 
-    std::shared_ptr<std::ofstream> output_file_;
-    std::ostream* output_stream_;
+    /*
+     * \brief The definition files that were parsed before, by their path.
+     *
+     * Definitions often inherit from the same files, and a next slice usually
+     * loads the same ones again, so they only need to be parsed once.
+     */
+    std::unordered_map<std::string, CachedDefinition> definition_cache_;
+
+    /*
+     * \brief The models that were loaded for the last slice, if
+     * \ref cache_meshes_ is set, as they were before they were placed in their
+     * mesh group.
+     */
+    std::unordered_map<MeshFileKey, std::shared_ptr<const Mesh>, MeshFileKeyHash> mesh_cache_;
+
+    /*
+     * \brief Get a parsed definition file, from the cache if it didn't change
+     * since it was parsed.
+     * \param json_filename The location of the JSON file.
+     * \return The parsed document, or nullptr if the file could not be read
+     * or parsed. The reason is logged.
+     */
+    std::shared_ptr<const rapidjson::Document> getDefinitionDocument(const std::filesystem::path& json_filename);
+
+    /*
+     * \brief Load a model file into a mesh group, or copy it from
+     * \ref mesh_cache_ if the same file was loaded before with the same
+     * transformation.
+     *
+     * See loadMeshIntoMeshGroup for the parameters.
+     */
+    bool loadMesh(MeshGroup* mesh_group, const std::filesystem::path& filename, const Matrix4x3D& transformation, Settings& object_parent_settings);
+
+    /*
+     * \brief Identify a model file, for \ref mesh_cache_.
+     * \return The key of the file, or nothing if the file can't be read or
+     * would be loaded with other files next to it, like UV coordinates and
+     * textures.
+     */
+    static std::optional<MeshFileKey> getMeshFileKey(const std::filesystem::path& filename, const Matrix4x3D& transformation);
 
     /*
      * \brief Load a JSON file and store the settings inside it.
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef COMMANDLINESERVER_H
+#define COMMANDLINESERVER_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef BUILD_TESTS
+#include <gtest/gtest_prod.h> //To allow tests to use protected members.
+#endif
+
+#include "CommandLine.h" //The class we're extending.
+
+namespace cura
+{
+class Slice;
+
+/*
+ * \brief Keeps running to make one slice after another, each of them started
+ * by a line on the standard input.
+ *
+ * Each line contains the same arguments as the "slice" command, separated by
+ * spaces. Arguments that contain spaces can be put in double quotes, in which
+ * backslashes escape quotes, backslashes and newlines ("\n"). Empty lines are
+ * skipped. The line "quit" or the end of the input stop the server. After each
+ * slice the line "done" is written to the standard error, once the g-code
+ * output has been flushed.
+ *
+ * Since the process keeps running, the thread pool stays warm, definition
+ * files are only parsed again when they change, and models are only loaded
+ * again when the contents of their file or their transformation change. If
+ * a slice only changes settings that are used to write g-code, like the start
+ * and end g-code, the slice data of the previous slice is reused to only write
+ * the g-code again. To be able to do that, the slice data of the last slice is
+ * kept in memory between slices.
+ */
+class CommandLineServer : public CommandLine
+{
+#ifdef BUILD_TESTS
+    FRIEND_TEST(GCodeRewriteTest, SameGCodeAsNewSlice);
+    FRIEND_TEST(GCodeRewriteTest, SlicingSettingsNeedNewSlice);
+#endif
+public:
+    CommandLineServer();
+
+    /*
+     * \brief Wait for the next line on the standard input, and test if it
+     * requests another slice.
+     */
+    bool hasSlice() const override;
+
+    /*
+     * \brief Slice the scene described by the last line that was read from the
+     * standard input.
+     */
+    void sliceNext() override;
+
+    /*
+     * \brief Split a line of the input into separate arguments.
+     * \param line The line to split.
+     * \return The arguments on the line, without quotes and escape characters.
+     */
+    static std::vector<std::string> splitArguments(const std::string& line);
+
+private:
+    /*
+     * \brief The arguments of the next slice, once they are read by
+     * \ref hasSlice.
+     */
+    mutable std::optional<std::vector<std::string>> next_arguments_;
+
+    /*
+     * \brief Whether the input requested to stop, or ended.
+     */
+    mutable bool stopped_ = false;
+
+    /*
+     * \brief The last slice, kept with its slice data to be able to write its
+     * g-code again.
+     */
+    std::shared_ptr<Slice> previous_slice_;
+
+    /*
+     * \brief The model files that were loaded for \ref previous_slice_.
+     */
+    std::vector<std::pair<std::string, std::optional<MeshFileKey>>> previous_loaded_meshes_;
+
+    /*
+     * \brief Check whether \p next_slice would produce the same slice data as
+     * \p previous_slice, apart from its models, and if so copy the settings
+     * that did change into \p previous_slice.
+     *
+     * This is the case when only settings that are used to write g-code
+     * differ, in any of the settings containers of the scenes.
+     * \param previous_slice The slice that was made before.
+     * \param next_slice The slice that is requested now.
+     * \return Whether the previous slice can be used to write the g-code of
+     * the next slice. If not, the previous slice is left unchanged.
+     */
+    static bool takeGCodeSettings(Slice& previous_slice, const Slice& next_slice);
+};
+
+} // namespace cura
+
+#endif // COMMANDLINESERVER_H
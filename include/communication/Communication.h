@@ -109,6 +109,25 @@ public:
     /* \brief Sends a piece of GCode that is ready to be exported */
     virtual void sendGCodePart(const std::string& gcode_part) = 0;
 
+    /*
+     * \brief Replaces a piece of GCode that was sent before by a piece of the
+     * same size.
+     * \param offset The amount of GCode (in bytes) that was sent for this
+     * slice before the piece to replace.
+     * \param gcode_part The GCode to put in its place.
+     * \return Whether the GCode could be replaced. If not, nothing changed.
+     */
+    virtual bool overwriteGCodePart(const size_t offset, const std::string& gcode_part) = 0;
+
+    /*
+     * \brief Whether the GCode may be sent out in pieces while slicing.
+     *
+     * The header is sent first, with placeholders for the totals of the print.
+     * If the header can't be replaced afterwards, the real totals are appended
+     * at the end, which only helps if the receiver reads them from there.
+     */
+    virtual bool supportsGCodeStreaming() const = 0;
+
     /*
      * \brief Send the uuid of the generated slice so that it may be processed by
      * the front-end.
@@ -4,8 +4,9 @@
 #ifndef GCODEEXPORT_FIXEDGCODEPART_H
 #define GCODEEXPORT_FIXEDGCODEPART_H
 
-#include <sstream>
+#include <string_view>
 
+#include "gcode_export/GCodeOutputStream.h"
 #include "gcode_export/GCodePart.h"
 
 namespace cura
@@ -21,10 +22,16 @@ public:
     std::string str() const override;
 
     /*! \brief Gets the actual stream in which the GCode parts can be stored */
-    std::ostringstream& stream();
+    GCodeOutputStream& stream();
+
+    /*! \brief Gets the GCode stored so far, without copying it */
+    std::string_view view() const;
+
+    /*! \brief Gets the size of the GCode stored so far, without copying it */
+    size_t size() const;
 
 private:
-    std::ostringstream stream_;
+    GCodeOutputStream stream_;
 };
 
 } // namespace cura
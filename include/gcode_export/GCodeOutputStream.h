@@ -0,0 +1,72 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GCODEEXPORT_GCODEOUTPUTSTREAM_H
+#define GCODEEXPORT_GCODEOUTPUTSTREAM_H
+
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace cura
+{
+
+/*!
+ * \brief Stream buffer that writes the GCode into a single growable block of memory.
+ *
+ * Contrary to a std::stringbuf, writing a whole number or piece of text is a plain copy into the free space of the block, and the
+ * GCode written so far can be looked at without copying it.
+ */
+class GCodeOutputBuffer : public std::streambuf
+{
+public:
+    explicit GCodeOutputBuffer() = default;
+
+    /*! \brief Gets the GCode written so far, without copying it. It is invalidated by the next write. */
+    std::string_view view() const;
+
+protected:
+    int_type overflow(int_type character) override;
+
+    std::streamsize xsputn(const char* characters, std::streamsize count) override;
+
+private:
+    static constexpr size_t initial_capacity_ = 4096;
+
+    std::unique_ptr<char[]> data_;
+    size_t capacity_{ 0 };
+
+    /*!
+     * \brief Makes the block of memory larger, so that at least the given amount of characters can be written after what was already written
+     * \param count The amount of characters that need to fit in the free space
+     */
+    void grow(const size_t count);
+
+    /*!
+     * \brief Moves the write position forward, past characters that were copied into the free space
+     * \param count The amount of characters that were copied
+     */
+    void advance(size_t count);
+};
+
+/*! \brief Output stream that writes the GCode into a GCodeOutputBuffer */
+class GCodeOutputStream : public std::ostream
+{
+public:
+    explicit GCodeOutputStream();
+
+    /*! \brief Gets the GCode written so far, without copying it. It is invalidated by the next write. */
+    std::string_view view() const;
+
+    /*! \brief Gets a copy of the GCode written so far */
+    std::string str() const;
+
+private:
+    GCodeOutputBuffer buffer_;
+};
+
+} // namespace cura
+
+#endif
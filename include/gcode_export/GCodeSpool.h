@@ -0,0 +1,59 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GCODEEXPORT_GCODESPOOL_H
+#define GCODEEXPORT_GCODESPOOL_H
+
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "utils/NoCopy.h"
+
+namespace cura
+{
+
+/*!
+ * \brief Temporary file in which finished pieces of GCode can be parked until they are exported.
+ *
+ * The GCode can only be sent out once the header has been written, which requires the totals of the whole print.
+ * Parking the finished layers on disk keeps them from piling up in memory in the meantime.
+ */
+class GCodeSpool : public NoCopy
+{
+public:
+    /*! \brief Opens a new, anonymous temporary file. Check isOpen() to see whether that succeeded. */
+    explicit GCodeSpool();
+
+    ~GCodeSpool();
+
+    /*! \brief Whether the temporary file could be opened, so that GCode can be stored in it */
+    bool isOpen() const;
+
+    /*!
+     * \brief Stores a piece of GCode at the end of the spool
+     * \param gcode The GCode to be stored
+     * \return The offset at which it was stored, or nothing if it could not be written
+     */
+    std::optional<size_t> append(const std::string_view gcode);
+
+    /*!
+     * \brief Reads back a piece of GCode. This is safe to call from multiple threads at once.
+     * \param offset The offset at which the GCode was stored
+     * \param length The size of the GCode that was stored
+     *
+     * Exits the engine if the GCode can't be read back, as the output would be incomplete.
+     */
+    std::string read(const size_t offset, const size_t length) const;
+
+private:
+    std::FILE* file_;
+    size_t size_{ 0 };
+    mutable std::mutex mutex_; //!< Reading requires seeking, so only one thread can use the file at a time.
+};
+
+} // namespace cura
+
+#endif
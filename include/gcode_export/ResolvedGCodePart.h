@@ -40,6 +40,9 @@ public:
     /*! \brief Gets the full resolved piece of GCode to be exported */
     std::string str() const override;
 
+    /*! \brief Gets the unresolved piece of GCode containing formulae */
+    const std::string& getRawString() const;
+
 private:
     const std::shared_ptr<GcodeTemplateResolver> template_resolver_;
     const std::string raw_string_;
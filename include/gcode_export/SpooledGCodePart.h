@@ -0,0 +1,39 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GCODEEXPORT_SPOOLEDGCODEPART_H
+#define GCODEEXPORT_SPOOLEDGCODEPART_H
+
+#include <memory>
+
+#include "gcode_export/GCodePart.h"
+
+namespace cura
+{
+
+class GCodeSpool;
+
+/*! \brief Contains pieces of fixed GCode that have been moved out of memory, into a GCode spool */
+class SpooledGCodePart : public GCodePart
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param spool The spool in which the GCode has been stored
+     * \param offset The offset at which the GCode has been stored
+     * \param length The size of the stored GCode
+     */
+    explicit SpooledGCodePart(const std::shared_ptr<const GCodeSpool>& spool, const size_t offset, const size_t length);
+
+    /*! \brief Gets the full piece of GCode to be exported, read back from the spool */
+    std::string str() const override;
+
+private:
+    const std::shared_ptr<const GCodeSpool> spool_;
+    const size_t offset_;
+    const size_t length_;
+};
+
+} // namespace cura
+
+#endif
@@ -12,6 +12,7 @@
 #include <optional>
 #include <sstream> // for stream.str()
 #include <stdio.h>
+#include <string_view>
 
 #include "PrintInformation.h"
 #include "TravelAntiOozing.h"
@@ -33,6 +34,7 @@ namespace cura
 class RetractionConfig;
 class SliceDataStorage;
 class GCodePart;
+class GCodeSpool;
 class GcodeTemplateResolver;
 struct WipeScriptConfig;
 
@@ -55,6 +57,12 @@ class GCodeExport : public NoCopy
     FRIEND_TEST(GCodeExportTest, CommentLayer);
     FRIEND_TEST(GCodeExportTest, CommentLayerNegative);
     FRIEND_TEST(GCodeExportTest, CommentLayerCount);
+    FRIEND_TEST(GCodeExportTest, SpoolFinishedGCodeParts);
+    FRIEND_TEST(GCodeExportTest, WriteExtrusionWithFormattedXY);
+    FRIEND_TEST(GCodeExportTest, StreamFinishedGCodeParts);
+    FRIEND_TEST(GCodeExportTest, NoStreamingWithoutSupport);
+    FRIEND_TEST(GCodeExportTest, StreamedHeaderIsOverwritten);
+    FRIEND_TEST(GCodeExportTest, StreamedHeaderFallsBackToTrailingMetadata);
     FRIEND_TEST(GriffinHeaderTest, HeaderGriffinFormat);
     FRIEND_TEST(GCodeExportTest, HeaderUltiGCode);
     FRIEND_TEST(GCodeExportTest, HeaderRepRap);
@@ -196,7 +204,31 @@ private:
     bool machine_heated_build_volume_; //!< does the machine have the ability to control/stabilize build-volume-temperature
     bool ppr_enable_; //!< if the print process reporting is enabled
 
+    /*!
+     * \brief Amount of finished fixed GCode (in bytes) that is kept in memory by default before it is moved to the spool.
+     *
+     * A typical print of a few hours has 10 to 50 MB of GCode, which is cheap to keep in memory and is then exported without any disk access.
+     * Only prints that are long enough for the GCode to make a difference to the memory usage of the slice are spooled.
+     */
+    static constexpr size_t default_gcode_spool_threshold = 64 * 1024 * 1024;
+
+    /*!
+     * \brief Extra space (in bytes) reserved in the streamed header per extruder, and once more for the whole header.
+     *
+     * The header is sent with the totals that are known when streaming starts, and overwritten with the final totals at the end. The final
+     * totals take more digits, and add a material GUID line for each extruder, which take less than this.
+     */
+    static constexpr size_t streamed_header_slack = 128;
+
     std::vector<std::shared_ptr<GCodePart>> gcode_parts_; //!< List of GCode pieces that will be exported at the end
+    bool stream_gcode_; //!< Whether finished GCode pieces are sent out while slicing, rather than all at the end. Set with CURAENGINE_STREAM_GCODE=1.
+    size_t streamed_parts_count_; //!< Number of leading GCode pieces that have been sent out while slicing
+    std::optional<size_t> streamed_header_size_; //!< Size of the header region at the start of the GCode, once it has been sent out while slicing
+    std::shared_ptr<GCodeSpool> gcode_spool_; //!< Temporary file in which finished fixed GCode pieces are parked when they take too much memory
+    size_t gcode_spool_threshold_; //!< Amount of finished fixed GCode (in bytes) that may be kept in memory before it is moved to the spool
+    size_t spooled_parts_count_; //!< Number of leading GCode pieces that have been moved to the spool (or don't need to be)
+    size_t examined_parts_count_; //!< Number of leading GCode pieces of which the size has been added to unspooled_gcode_size_
+    size_t unspooled_gcode_size_; //!< Size of the finished fixed GCode pieces that are still kept in memory
     std::shared_ptr<GcodeTemplateResolver> template_resolver_; //!< Object used to resolved the formulae of the dynamic GCode pieces
 
 protected:
@@ -382,8 +414,35 @@ public:
      * \param speed movement speed
      * \param feature the feature that's currently printing
      * \param update_extrusion_offset whether to update the extrusion offset to match the current flow rate
+     * \param formatted_xy The X and Y parameters of this move as formatted by \ref formatExtrusionXY, or empty to format them now
+     */
+    void writeExtrusion(
+        const Point3LL& p,
+        const Velocity& speed,
+        double extrusion_mm3_per_mm,
+        PrintFeatureType feature,
+        bool update_extrusion_offset = false,
+        const std::string_view formatted_xy = {});
+
+    /*!
+     * Format the X and Y parameters of extrusion moves to \p points, the same way as \ref writeExtrusion writes them.
+     *
+     * This doesn't depend on the state of the export, so it can be done for all layers in parallel, before they are written one by one.
+     * Only the parameters that do depend on it, like F, Z and E, are left to \ref writeExtrusion.
+     *
+     * \param points The points that will be extruded to
+     * \param extruder_nr The extruder that will print them, for its nozzle offset
+     * \return The X and Y parameters of the moves to all points, one after the other. See \ref popFormattedXY.
+     */
+    std::string formatExtrusionXY(const std::vector<Point3LL>& points, const size_t extruder_nr) const;
+
+    /*!
+     * Take the X and Y parameters of the move to the next point off the front of the result of \ref formatExtrusionXY.
+     *
+     * \param[in,out] formatted_xy The formatted parameters of the remaining points
+     * \return The parameters of the move to the next point, or empty if \p formatted_xy is empty
      */
-    void writeExtrusion(const Point3LL& p, const Velocity& speed, double extrusion_mm3_per_mm, PrintFeatureType feature, bool update_extrusion_offset = false);
+    static std::string_view popFormattedXY(std::string_view& formatted_xy);
 
     /*!
      * Initialize the extruder trains.
@@ -417,6 +476,28 @@ public:
     /*! \brief Creates a new instance of fixed GCode part and sets it as the current container for fixed GCode parts. */
     void prepareNewFixedGCodePart();
 
+    /*!
+     * \brief Moves the finished fixed GCode parts to a temporary file, once they take more memory than allowed.
+     *
+     * The GCode can only be sent out at the end, after the header, so for long prints this keeps the memory usage bounded. The exported GCode is the same.
+     */
+    void spoolFinishedGCodeParts();
+
+    /*!
+     * \brief Sends the rest of the GCode after it was streamed, and then puts the final \p header in place of the one that was streamed.
+     *
+     * When the communication can't overwrite GCode that it has sent, or the final header doesn't fit in the reserved region, the header
+     * is written as a trailing metadata block after the GCode instead.
+     * \param header The final header, with the totals of the whole print
+     */
+    void finishStreamedGCode(const std::string& header);
+
+    /*!
+     * \brief Creates comment lines of exactly \p length bytes, to fill up the region reserved for the header.
+     * \return The comment lines, or nothing if \p length is too short to hold a line
+     */
+    std::optional<std::string> makeHeaderPadding(const size_t length) const;
+
     /*!
      * \brief Write a piece of resolvable GCode
      * \param raw_text The unresolved piece of GCode to be written
@@ -477,6 +558,7 @@ private:
      * \param extrusion_mm3_per_mm flow
      * \param feature the print feature that's currently printing
      * \param update_extrusion_offset whether to update the extrusion offset to match the current flow rate
+     * \param formatted_xy The X and Y parameters of this move as formatted by \ref formatExtrusionXY, or empty to format them now
      */
     void writeExtrusion(
         const coord_t x,
@@ -485,7 +567,8 @@ private:
         const Velocity& speed,
         const double extrusion_mm3_per_mm,
         const PrintFeatureType& feature,
-        const bool update_extrusion_offset = false);
+        const bool update_extrusion_offset = false,
+        const std::string_view formatted_xy = {});
 
     /*!
      * Write the F, X, Y, Z and E value (if they are not different from the last)
@@ -496,6 +579,8 @@ private:
      * This function updates the \ref GCodeExport::total_bounding_box
      * It estimates the time in \ref GCodeExport::estimateCalculator for the correct feature
      * It updates \ref GCodeExport::currentPosition, \ref GCodeExport::current_e_value and \ref GCodeExport::currentSpeed
+     *
+     * \param formatted_xy The X and Y parameters as formatted by \ref formatExtrusionXY, or empty to format them now
      */
     void writeFXYZE(
         const Velocity& speed,
@@ -504,7 +589,8 @@ private:
         const coord_t z,
         const double e,
         const PrintFeatureType& feature,
-        const std::optional<RetractionAmounts>& retraction_amounts = std::nullopt);
+        const std::optional<RetractionAmounts>& retraction_amounts = std::nullopt,
+        const std::string_view formatted_xy = {});
 
     /*!
      * The writeTravel and/or writeExtrusion when flavor == BFB
@@ -738,6 +824,17 @@ public:
      */
     void finalize(const std::string& end_code, PrintInformation& print_info);
 
+    /*!
+     * \brief When streaming the GCode, sends out the GCode pieces that are finished, so that they don't need to wait for the end of the slice.
+     *
+     * The first call sends a header with the totals that are known so far, padded to leave room for the final totals, which are put in its
+     * place by \ref finalize. Pieces of start or end GCode that refer to the totals of the print can only be resolved at the end, so the
+     * streaming stops at the first of those.
+     *
+     * \param print_info The information about the print so far, of which the initial extruder must be known
+     */
+    void sendFinishedGCodeParts(const PrintInformation& print_info);
+
     /*!
      * Finish the extruder gcode: write extrude rend gcode.
      *
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GEOMETRY_SEGMENT_INDEXED_SHAPE_H
+#define GEOMETRY_SEGMENT_INDEXED_SHAPE_H
+
+#include <vector>
+
+#include "geometry/Point2LL.h"
+#include "utils/AABB.h"
+
+namespace cura
+{
+
+class Shape;
+
+/*!
+ * @brief Read-only copy of the segments of a shape, indexed in a uniform grid, to answer queries about points and line segments without
+ *        iterating over all the segments of the shape.
+ *
+ * The queries of a Shape are linear in the number of its segments. For masks that are queried for every extruded segment of a layer, like
+ * the overhang and roofing masks, build one of these once instead. A query then only looks at the segments in the grid cells near the
+ * query point or segment, and gives the same answer as the corresponding Shape function.
+ */
+class SegmentIndexedShape
+{
+public:
+    /*! \brief Constructor of an empty index, for which all queries are negative */
+    SegmentIndexedShape() = default;
+
+    /*!
+     * \brief Builds the index for the given shape. The shape is not referenced afterwards.
+     */
+    explicit SegmentIndexedShape(const Shape& shape);
+
+    /*! \brief Whether the indexed shape has no segments at all */
+    [[nodiscard]] bool empty() const;
+
+    /*! \brief The bounding box of the indexed shape */
+    [[nodiscard]] const AABB& getBoundingBox() const;
+
+    /*!
+     * \brief Check if a point is inside the shape. Same as Shape::inside, only faster.
+     * \param p The point for which to check if it is inside the shape
+     * \param border_result What to return when the point is exactly on the border
+     * \return Whether the point \p p is inside the shape (or \p border_result when it is on the border)
+     */
+    [[nodiscard]] bool inside(const Point2LL& p, bool border_result = false) const;
+
+    /*!
+     * \brief Calculates the intersections between the given segment and all the segments of the shape. Same as
+     *        Shape::intersectionsWithSegment, only faster, and in the same order.
+     *
+     * Shape::intersectionsWithSegment computes in float, and can report a hit with a segment that is almost collinear with the query, but
+     * doesn't touch it. Such segments are only tested here if they are near the query, so these false hits can be missing.
+     * \param start The start position of the segment
+     * \param end The end position of the segment
+     * \return The parameters along the segment where it intersects the shape
+     */
+    [[nodiscard]] std::vector<float> intersectionsWithSegment(const Point2LL& start, const Point2LL& end) const;
+
+    /*!
+     * \brief Check whether a line segment collides with the outline of the shape. Same as
+     *        PolygonUtils::polygonCollidesWithLineSegment, only faster.
+     * \param start The start position of the segment
+     * \param end The end position of the segment
+     * \return Whether the segment touches or crosses any of the segments of the shape
+     */
+    [[nodiscard]] bool collidesWithLineSegment(const Point2LL& start, const Point2LL& end) const;
+
+private:
+    struct Segment
+    {
+        Point2LL start;
+        Point2LL end;
+        bool bounds_area; //!< Whether the polygon of this segment has enough points to enclose an area, otherwise it doesn't count for \ref inside
+        coord_t min_column; //!< The first column of cells that the segment is registered in
+        coord_t min_row; //!< The first row of cells that the segment is registered in
+    };
+
+    /*!
+     * \brief Visit the indices of all segments registered in a range of cells, each only once, in no particular order
+     *
+     * The range is clamped to the grid. Visiting stops as soon as \p function returns true.
+     * \return Whether \p function returned true for any segment
+     */
+    template<typename Function>
+    bool anySegmentInCells(coord_t min_column, coord_t max_column, coord_t min_row, coord_t max_row, const Function& function) const;
+
+    [[nodiscard]] coord_t toGridCoord(coord_t offset) const;
+
+    std::vector<Segment> segments_; //!< All segments of the shape, in the order of the shape
+    AABB bounding_box_;
+    coord_t cell_size_{ 1 };
+    coord_t columns_{ 0 };
+    coord_t rows_{ 0 };
+    std::vector<size_t> cell_starts_; //!< For each cell the index of its first entry in \ref cell_segments_, with an extra entry at the end
+    std::vector<size_t> cell_segments_; //!< The segment indices per cell, each segment is registered in all cells its bounding box overlaps
+};
+
+} // namespace cura
+
+#endif // GEOMETRY_SEGMENT_INDEXED_SHAPE_H
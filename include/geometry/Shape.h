@@ -80,6 +80,28 @@ public:
 
     [[nodiscard]] Shape intersection(const Shape& other) const;
 
+    /*!
+     * \brief Union many shapes at once, instead of accumulating them one by one with unionPolygons().
+     *
+     * Up to a handful of shapes are unioned in a single Clipper pass. More shapes are reduced as a balanced tree: each level
+     * unions batches of shapes in parallel on the thread pool, so the depth is logarithmic in the number of shapes and each
+     * Clipper pass only processes the edges of its own batch.
+     *
+     * The shapes are expected to be oriented like the results of Clipper operations, i.e. holes wound opposite to their outlines.
+     *
+     * \param shapes The shapes to union, which are consumed.
+     * \param fill_type The fill type of every Clipper pass.
+     */
+    [[nodiscard]] static Shape unionShapes(std::vector<Shape>&& shapes, ClipperLib::PolyFillType fill_type = ClipperLib::pftNonZero);
+
+    /*!
+     * \brief Intersect many shapes at once, as a balanced tree of pairwise intersections which runs in parallel on the thread pool.
+     *
+     * \param shapes The shapes to intersect, which are consumed.
+     * \return The area covered by all of the shapes, or an empty shape if there are none.
+     */
+    [[nodiscard]] static Shape intersectionShapes(std::vector<Shape>&& shapes);
+
     /*!
      *  @brief Overridden definition of LinesSet<Polygon>::offset()
      *  @note The behavior of this method is exactly the same, but it just exists because it allows
@@ -5,6 +5,8 @@
 #define INFILL_H
 
 #include <numbers>
+#include <span>
+#include <vector>
 
 #include <range/v3/range/concepts.hpp>
 
@@ -29,6 +31,7 @@ class SliceMeshStorage;
 class Infill
 {
     friend class InfillTest;
+    friend class InfillCrossingsOnLineTest;
 
     EFillMethod pattern_{}; //!< the space filling pattern of the infill to generate
     bool zig_zaggify_{}; //!< Whether to connect the end pieces of the support lines via the wall
@@ -381,6 +384,66 @@ private:
         void appendTo(OpenPolyline& result_polyline, const bool include_start = true);
     };
 
+    /*!
+     * The infill line segments that are joined by connectLines, with an index of which of them cross each segment of the outline.
+     *
+     * The line segments are allocated in blocks, not one by one, and are all freed at once when this goes out of scope. The index is a single
+     * list of crossings, grouped per segment of the outline once all of them are known, rather than a list for every segment of the outline.
+     */
+    class CrossingsOnLine
+    {
+    public:
+        /*!
+         * Create a new infill line segment, which lives as long as this object.
+         *
+         * The parameters are those of the constructor of InfillLineSegment.
+         */
+        InfillLineSegment* createSegment(const Point2LL start, const size_t start_segment, const size_t start_polygon, const Point2LL end, const size_t end_segment, const size_t end_polygon);
+
+        /*!
+         * Register that an infill line segment crosses a segment of the outline.
+         * \param polygon_idx The polygon of the outline that is crossed.
+         * \param vertex_idx The vertex at the end of the segment of the polygon that is crossed.
+         * \param segment The infill line segment that crosses it.
+         */
+        void addCrossing(const size_t polygon_idx, const size_t vertex_idx, InfillLineSegment* segment);
+
+        /*!
+         * Group the crossings per segment of the outline, once all of them are added. The crossings of each segment remain in the order in
+         * which they were added.
+         * \param outline The outline of which the segments were crossed.
+         */
+        void groupBySegment(const Shape& outline);
+
+        /*!
+         * Get the crossings of all segments of the outline, grouped per segment, in the order of the outline.
+         */
+        std::span<InfillLineSegment* const> getAllCrossings() const;
+
+        /*!
+         * Get the crossings of one segment of the outline. They may be reordered.
+         * \param polygon_idx The polygon of the outline.
+         * \param vertex_idx The vertex at the end of the segment of the polygon.
+         */
+        std::span<InfillLineSegment*> getCrossings(const size_t polygon_idx, const size_t vertex_idx);
+
+    private:
+        struct Crossing
+        {
+            size_t polygon_idx_;
+            size_t vertex_idx_;
+            InfillLineSegment* segment_;
+        };
+
+        static constexpr size_t first_block_size_ = 256; //!< The number of line segments in the first block, each next block is twice as large
+
+        std::vector<std::vector<InfillLineSegment>> blocks_; //!< The line segments. A block is never filled beyond its capacity, so it never moves its line segments.
+        std::vector<Crossing> crossings_; //!< The crossings in the order in which they were added
+        std::vector<size_t> polygon_starts_; //!< For each polygon of the outline, the index of its first segment in \ref segment_starts_
+        std::vector<size_t> segment_starts_; //!< For each segment of the outline, the index of its first crossing in \ref grouped_crossings_, with an extra entry at the end
+        std::vector<InfillLineSegment*> grouped_crossings_; //!< The crossings, grouped per segment of the outline
+    };
+
     /*!
      * Generate the infill pattern without the infill_multiplier functionality
      */
@@ -463,25 +526,25 @@ private:
      * Generate a rectangular grid of infill lines
      * \param[out] result (output) The resulting lines
      */
-    void generateGridInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateGridInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a shifting triangular grid of infill lines, which combine with consecutive layers into a cubic pattern
      * \param[out] result (output) The resulting lines
      */
-    void generateCubicInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateCubicInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a double shifting square grid of infill lines, which combine with consecutive layers into a tetrahedral pattern
      * \param[out] result (output) The resulting lines
      */
-    void generateTetrahedralInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateTetrahedralInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a double shifting square grid of infill lines, which combine with consecutive layers into a quarter cubic pattern
      * \param[out] result (output) The resulting lines
      */
-    void generateQuarterCubicInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateQuarterCubicInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a single shifting square grid of infill lines.
@@ -496,19 +559,19 @@ private:
         double pattern_z_shift,
         int angle_shift,
         OpenLinesSet& result,
-        std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+        CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a triangular grid of infill lines
      * \param[out] result (output) The resulting lines
      */
-    void generateTriangleInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateTriangleInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a triangular grid of infill lines
      * \param[out] result (output) The resulting lines
      */
-    void generateTrihexagonInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void generateTrihexagonInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Generate a 3d pattern of subdivided cubes on their points
@@ -561,7 +624,7 @@ private:
         int line_distance,
         const double& infill_rotation,
         coord_t extra_shift,
-        std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+        CrossingsOnLine& crossings_on_line);
 
     /*!
      * Function for creating linear based infill types (Lines, ZigZag).
@@ -586,7 +649,7 @@ private:
         ZigzagConnectorProcessor& zigzag_connector_processor,
         const bool connected_zigzags,
         coord_t extra_shift,
-        std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+        CrossingsOnLine& crossings_on_line);
 
     /*!
      *
@@ -640,7 +703,7 @@ private:
         OpenLinesSet& result,
         const coord_t line_distance,
         const double& infill_rotation,
-        std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+        CrossingsOnLine& crossings_on_line);
 
     /*!
      * determine how far the infill pattern should be shifted based on the values of infill_origin and \p infill_rotation
@@ -680,9 +743,12 @@ private:
      * In most cases it will end up with only one long line that is more or less
      * optimal. The lines are connected on their ends by extruding along the
      * border of the infill area, similar to the zigzag pattern.
+     * \param outline The outline of the infill area, which the lines cross.
      * \param[in/out] result_lines The lines to connect together.
+     * \param crossings_on_line The infill lines and the segments of the outline
+     * they cross. New line segments to connect them are created in it too.
      */
-    void connectLines(const Shape& outline, OpenLinesSet& result_lines, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line);
+    void connectLines(const Shape& outline, OpenLinesSet& result_lines, CrossingsOnLine& crossings_on_line);
 
     /*!
      * Check whether the generated lines for a single island should be included for printing, based on their total length. Tiny lines don't contribute to printing a proper infill
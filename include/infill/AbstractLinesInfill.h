@@ -49,16 +49,17 @@ protected:
     AbstractLinesInfill() = default;
 
     /*!
-     * Method to be implemented by child classes to generate the raw parallel lines to be included in the infill. The generated lines should be completely filling the bounding box
-     * of the given outline, and are allowed to go outside the model.
+     * Method to be implemented by child classes to generate the raw parallel lines to be included in the infill. The generated lines should be completely filling the given
+     * outline, and are allowed to go outside the model. They don't need to fill its entire bounding box.
      * @param line_distance The distance between lines to generate.
-     * @param bounding_box The bounding box in which to print the pattern.
+     * @param outline The outline in which to print the pattern.
+     * @param bounding_box The bounding box of the outline.
      * @param z The Z coordinate of this layer. Different Z coordinates cause the pattern to vary, producing a 3D pattern.
      * @param line_width The line width at which the infill will be printed.
      * @return A set containing the raw parallel lines to be included. Each line of the set should be a complete line on a column, even if goes out of the model
      *         one or multiple times.
      */
-    virtual OpenLinesSet generateParallelLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z, const coord_t line_width) const = 0;
+    virtual OpenLinesSet generateParallelLines(const coord_t line_distance, const Shape& outline, const AABB& bounding_box, const coord_t z, const coord_t line_width) const = 0;
 
 private:
     /*! Helper structure that contain data about the split lines to be joined */
@@ -4,6 +4,8 @@
 #ifndef INFILL_GYROIDINFILL_H
 #define INFILL_GYROIDINFILL_H
 
+#include <array>
+
 #include "infill/AbstractLinesInfill.h"
 
 namespace cura
@@ -11,6 +13,8 @@ namespace cura
 
 class GyroidInfill : public AbstractLinesInfill
 {
+    friend class GyroidInfillTest;
+
 public:
     GyroidInfill() = default;
 
@@ -28,15 +32,42 @@ protected:
      * across different heights, producing a 3D pattern.
      * \param line_distance Distance between adjacent curves. This determines the density of the pattern (when printed
      * at a fixed line width).
+     * \param outline The outline in which to print the pattern. The lines only span the part of the bounding box in
+     * which they can cross the outline.
      * \param bounding_box The bounding box in which to print the pattern.
      * \param z The Z coordinate of this layer. Different Z coordinates cause the pattern to vary, producing a 3D
      * pattern.
      * \param line_width Unused in this context.
      * \return The list of raw gyroid lines.
      */
-    OpenLinesSet generateParallelLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z, const coord_t line_width) const override;
+    OpenLinesSet generateParallelLines(const coord_t line_distance, const Shape& outline, const AABB& bounding_box, const coord_t z, const coord_t line_width) const override;
+
+private:
+    static constexpr size_t max_num_steps = 16; //!< The maximum number of points per pitch along a line
+
+    /*!
+     * The shape of the gyroid lines of one layer, within one pitch along their direction.
+     */
+    struct LineCoordinates
+    {
+        bool vertical; //!< Whether the lines run along the Y axis, otherwise they run along the X axis
+        size_t num_coords; //!< The number of points per pitch along a line
+        std::array<coord_t, max_num_steps> odd_line_coords; //!< The offsets across the direction of the odd lines, for every step along a pitch
+        std::array<coord_t, max_num_steps> even_line_coords; //!< The offsets across the direction of the even lines, for every step along a pitch
+    };
+
+    /*!
+     * Compute the shape of the gyroid lines at a certain height.
+     *
+     * The trigonometry of all steps is evaluated in separate passes over fixed size arrays, so that the compiler can
+     * vectorize them.
+     * \param pitch The length after which the pattern repeats itself.
+     * \param step The distance between the points along a line.
+     * \param z The Z coordinate of the layer.
+     */
+    static LineCoordinates computeLineCoordinates(const coord_t pitch, const coord_t step, const coord_t z);
 };
 
 } // namespace cura
 
-#endif
\ No newline at end of file
+#endif
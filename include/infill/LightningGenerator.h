@@ -96,13 +96,22 @@ protected:
      * Normally, overhangs are only generated for the outside of the model and
      * only when support is generated. For this pattern, we also need to
      * generate overhang areas for the inside of the model.
+     * \param infill_outlines For each layer, the infill area within the walls
+     * of the infill.
      */
-    void generateInitialInternalOverhangs(const coord_t infill_wall_thickness, const std::vector<Shape>& areas_per_layer);
+    void generateInitialInternalOverhangs(const std::vector<Shape>& infill_outlines);
 
     /*!
      * Calculate the tree structure of all layers.
+     *
+     * The trees of a layer grow from the trees of the layer above, so the
+     * layers are processed from top to bottom. What doesn't depend on the
+     * trees is prepared for a batch of layers at once in parallel, and the
+     * trees of a layer are propagated to the layer below in parallel.
+     * \param infill_outlines For each layer, the infill area within the walls
+     * of the infill.
      */
-    void generateTrees(const coord_t infill_wall_thickness, const std::vector<Shape>& areas_per_layer);
+    void generateTrees(const std::vector<Shape>& infill_outlines);
 
     /*!
      * How far each piece of infill can support skin in the layer above.
@@ -5,7 +5,6 @@
 #define LIGHTNING_LAYER_H
 
 #include <list>
-#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -16,14 +15,15 @@
 
 namespace cura
 {
-using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
-using SparseLightningTreeNodeGrid = SparsePointGridInclusive<std::weak_ptr<LightningTreeNode>>;
+class LightningDistanceField;
+
+using SparseLightningTreeNodeGrid = SparsePointGridInclusive<LightningTreeNodeIdx>;
 
 struct GroundingLocation
 {
-    LightningTreeNodeSPtr tree_node; //!< not null if the gounding location is on a tree
+    LightningTreeNodeIdx tree_node; //!< not NO_INDEX if the gounding location is on a tree
     std::optional<ClosestPointPolygon> boundary_location; //!< in case the gounding location is on the boundary
-    Point2LL p() const;
+    Point2LL p(const LightningTreeNodePool& nodes) const;
 };
 
 /*!
@@ -34,10 +34,16 @@ struct GroundingLocation
 class LightningLayer
 {
 public:
-    std::vector<LightningTreeNodeSPtr> tree_roots;
+    LightningTreeNodePool nodes; //!< The nodes of all trees of this layer
+    std::vector<LightningTreeNodeIdx> tree_roots;
 
+    /*!
+     * Add trees until the whole distance field is supported.
+     * \param distance_field The locations on this layer that need to be
+     * supported, for the overhang on this layer.
+     */
     void generateNewTrees(
-        const Shape& current_overhang,
+        LightningDistanceField& distance_field,
         const Shape& current_outlines,
         const LocToLineGrid& outline_locator,
         const coord_t supporting_radius,
@@ -53,17 +59,17 @@ public:
         const coord_t supporting_radius,
         const coord_t wall_supporting_radius,
         const SparseLightningTreeNodeGrid& tree_node_locator,
-        const LightningTreeNodeSPtr& exclude_tree = nullptr);
+        const LightningTreeNodeIdx exclude_tree = NO_INDEX);
 
     /*!
      * \param[out] new_child The new child node introduced
      * \param[out] new_root The new root node if one had been made
      * \return Whether a new root was added
      */
-    bool attach(const Point2LL& unsupported_location, const GroundingLocation& ground, LightningTreeNodeSPtr& new_child, LightningTreeNodeSPtr& new_root);
+    bool attach(const Point2LL& unsupported_location, const GroundingLocation& ground, LightningTreeNodeIdx& new_child, LightningTreeNodeIdx& new_root);
 
     void reconnectRoots(
-        std::vector<LightningTreeNodeSPtr>& to_be_reconnected_tree_roots,
+        std::vector<LightningTreeNodeIdx>& to_be_reconnected_tree_roots,
         const Shape& current_outlines,
         const LocToLineGrid& outline_locator,
         const coord_t supporting_radius,
@@ -5,7 +5,6 @@
 #define LIGHTNING_TREE_NODE_H
 
 #include <functional>
-#include <memory>
 #include <optional>
 #include <vector>
 
@@ -19,6 +18,11 @@ namespace cura
 
 constexpr coord_t locator_cell_size = 4000;
 
+/*!
+ * The index of a node in a \ref LightningTreeNodePool. \ref NO_INDEX refers to no node at all.
+ */
+using LightningTreeNodeIdx = size_t;
+
 // NOTE: As written, this struct will only be valid for a single layer, will have to be updated for the next.
 // NOTE: Reasons for implementing this with some separate closures:
 //       - keep clear deliniation during development
@@ -30,27 +34,20 @@ constexpr coord_t locator_cell_size = 4000;
  *
  * In essence these vertices are just a position linked to other positions in
  * 2D. The nodes have a hierarchical structure of parents and children, forming
- * a tree. The class also has some helper functions specific to Lightning Infill
- * e.g. to straighten the paths around this node.
+ * a tree. The nodes are stored in a \ref LightningTreeNodePool, and refer to
+ * their parent and children by their index in there. The pool has the
+ * operations on the trees, e.g. to straighten the paths around a node.
  */
-class LightningTreeNode : public std::enable_shared_from_this<LightningTreeNode>
+class LightningTreeNode
 {
-    using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
-
 public:
-    // Workaround for private/protected constructors and 'make_shared': https://stackoverflow.com/a/27832765
-    template<typename... Arg>
-    LightningTreeNodeSPtr static create(Arg&&... arg)
-    {
-        struct EnableMakeShared : public LightningTreeNode
-        {
-            EnableMakeShared(Arg&&... arg)
-                : LightningTreeNode(std::forward<Arg>(arg)...)
-            {
-            }
-        };
-        return std::make_shared<EnableMakeShared>(std::forward<Arg>(arg)...);
-    }
+    /*!
+     * Construct a new node, either for insertion in a tree or as root.
+     * \param p The physical location in the 2D layer that this node represents.
+     * Connecting other nodes to this node indicates that a line segment should
+     * be drawn between those two physical positions.
+     */
+    LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location = std::nullopt);
 
     /*!
      * Get the position on this layer that this node represents, a vertex of the
@@ -65,28 +62,110 @@ public:
      */
     void setLocation(const Point2LL& p);
 
+    /*!
+     * Returns whether this node is the root of a lightning tree. It is the root
+     * if it has no parents.
+     * \return ``true`` if this node is the root (no parents) or ``false`` if it
+     * is a child node of some other node.
+     */
+    bool isRoot() const
+    {
+        return is_root_;
+    }
+
+    /*! If this was ever a direct child of the root, it'll have a previous grounding location.
+     *
+     * This needs to be known when roots are reconnected, so that the last (higher) layer is supported by the next one.
+     */
+    const std::optional<Point2LL>& getLastGroundingLocation() const;
+
+private:
+    friend class LightningTreeNodePool;
+
+    bool is_root_;
+    Point2LL p_;
+    LightningTreeNodeIdx parent_; //!< The parent of this node, or NO_INDEX if it has none (anymore)
+    std::vector<LightningTreeNodeIdx> children_;
+
+    std::optional<Point2LL> last_grounding_location_; //<! The last known grounding location, see 'getLastGroundingLocation()'.
+};
+
+/*!
+ * The nodes of the Lightning Trees of one layer.
+ *
+ * The nodes refer to each other by their index in the pool, rather than with
+ * shared and weak pointers. Nodes that are cut from a tree, when it is pruned,
+ * straightened or realigned, stay in the pool until it is compacted with
+ * \ref compact. The generator compacts the trees of each layer right after they
+ * are propagated to it, so a pool holds only the nodes of its own trees.
+ */
+class LightningTreeNodePool
+{
+public:
+    /*!
+     * Construct a new node that is not part of any tree yet, i.e. a root.
+     * \param p The location of the new node.
+     * \param last_grounding_location The last grounding location of the new
+     * node, see \ref LightningTreeNode::getLastGroundingLocation.
+     * \return The index of the new node.
+     */
+    LightningTreeNodeIdx create(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location = std::nullopt);
+
+    /*!
+     * Get a node of the pool.
+     * \param node_idx The index of the node.
+     */
+    const LightningTreeNode& operator[](const LightningTreeNodeIdx node_idx) const;
+
+    /*!
+     * Get the number of nodes in the pool, including the ones that are no
+     * longer part of a tree.
+     */
+    size_t size() const;
+
+    /*!
+     * Move all nodes of another pool to the end of this one.
+     * \param other The pool of which to take the nodes.
+     * \return The offset of the indices of the nodes of \p other in this pool.
+     */
+    LightningTreeNodeIdx append(LightningTreeNodePool&& other);
+
+    /*!
+     * Remove all nodes that are no longer part of any of the given trees.
+     *
+     * The nodes that are kept get new indices, in depth-first order of the
+     * trees, so the order of the children of each node stays the same.
+     * \param roots The roots of the trees to keep. They are replaced with
+     * their new indices.
+     */
+    void compact(std::vector<LightningTreeNodeIdx>& roots);
+
     /*!
      * Construct a new ``LightningTreeNode`` instance and add it as a child of
-     * this node.
+     * a node.
+     * \param parent The node to add the child to.
      * \param p The location of the new node.
-     * \return A shared pointer to the new node.
+     * \return The index of the new node.
      */
-    LightningTreeNodeSPtr addChild(const Point2LL& p);
+    LightningTreeNodeIdx addChild(const LightningTreeNodeIdx parent, const Point2LL& p);
 
     /*!
-     * Add an existing ``LightningTreeNode`` as a child of this node.
+     * Add an existing ``LightningTreeNode`` as a child of a node.
+     * \param parent The node to add the child to.
      * \param new_child The node that must be added as a child.
      * \return Always returns \p new_child.
      */
-    LightningTreeNodeSPtr addChild(LightningTreeNodeSPtr& new_child);
+    LightningTreeNodeIdx addChild(const LightningTreeNodeIdx parent, const LightningTreeNodeIdx new_child);
 
     /*!
-     * Propagate this node's sub-tree to the next layer.
+     * Propagate a node's sub-tree to the next layer.
      *
-     * Creates a copy of this tree, realign it to the new layer boundaries
-     * \p next_outlines and reduce (i.e. prune and straighten) it. A copy of
-     * this node and all of its descendant nodes will be added to the
+     * Creates a copy of the tree in \p next_nodes, realign it to the new layer
+     * boundaries \p next_outlines and reduce (i.e. prune and straighten) it. A
+     * copy of this node and all of its descendant nodes will be added to the
      * \p next_trees vector.
+     * \param node The root of the tree to propagate.
+     * \param next_nodes The pool to create the nodes for the next layer in.
      * \param next_trees A collection of tree nodes to use for the next layer.
      * \param next_outlines The shape of the layer below, to make sure that the
      * tree stays within the bounds of the infill area.
@@ -99,7 +178,9 @@ public:
      * from which straightening may remove a colinear point.
      */
     void propagateToNextLayer(
-        std::vector<LightningTreeNodeSPtr>& next_trees,
+        const LightningTreeNodeIdx node,
+        LightningTreeNodePool& next_nodes,
+        std::vector<LightningTreeNodeIdx>& next_trees,
         const Shape& next_outlines,
         const LocToLineGrid& outline_locator,
         const coord_t prune_distance,
@@ -107,108 +188,113 @@ public:
         const coord_t max_remove_colinear_dist) const;
 
     /*!
-     * Executes a given function for every line segment in this node's sub-tree.
+     * Executes a given function for every line segment in a node's sub-tree.
      *
      * The function takes two `Point` arguments. These arguments will be filled
      * in with the higher-order node (closer to the root) first, and the
      * downtree node (closer to the leaves) as the second argument. The segment
-     * from this node's parent to this node itself is not included.
+     * from the node's parent to the node itself is not included.
      * The order in which the segments are visited is depth-first.
+     * \param node The node of which to visit the sub-tree.
      * \param visitor A function to execute for every branch in the node's sub-
      * tree.
      */
-    void visitBranches(const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const;
+    void visitBranches(const LightningTreeNodeIdx node, const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const;
 
     /*!
-     * Execute a given function for every node in this node's sub-tree.
+     * Execute a given function for every node in a node's sub-tree.
      *
-     * The visitor function takes a node as input. This node is not const, so
-     * this can be used to change the tree.
-     * Nodes are visited in depth-first order. This node itself is visited as
+     * Nodes are visited in depth-first order. The node itself is visited as
      * well (pre-order).
-     * \param visitor A function to execute for every node in this node's sub-
+     * \param node The node of which to visit the sub-tree.
+     * \param visitor A function to execute for every node in the node's sub-
      * tree.
      */
-    void visitNodes(const std::function<void(LightningTreeNodeSPtr)>& visitor);
+    void visitNodes(const LightningTreeNodeIdx node, const std::function<void(LightningTreeNodeIdx)>& visitor) const;
 
     /*!
-     * Get a weighted distance from an unsupported point to this node (given the current supporting radius).
+     * Get a weighted distance from an unsupported point to a node (given the current supporting radius).
      *
      * When attaching a unsupported location to a node, not all nodes have the same priority.
      * (Eucludian) closer nodes are prioritised, but that's not the whole story.
      * For instance, we give some nodes a 'valence boost' depending on the nr. of branches.
+     * \param node The node to compute the distance to.
      * \param unsupported_location The (unsuppported) location of which the weighted distance needs to be calculated.
      * \param supporting_radius The maximum distance which can be bridged without (infill) supporting it.
      * \return The weighted distance.
      */
-    coord_t getWeightedDistance(const Point2LL& unsupported_location, const coord_t& supporting_radius) const;
+    coord_t getWeightedDistance(const LightningTreeNodeIdx node, const Point2LL& unsupported_location, const coord_t& supporting_radius) const;
 
     /*!
-     * Returns whether this node is the root of a lightning tree. It is the root
-     * if it has no parents.
-     * \return ``true`` if this node is the root (no parents) or ``false`` if it
-     * is a child node of some other node.
-     */
-    bool isRoot() const
-    {
-        return is_root_;
-    }
-
-    /*!
-     * Reverse the parent-child relationship all the way to the root, from this node onward.
-     * This has the effect of 're-rooting' the tree at the current node if no immediate parent is given as argument.
-     * That is, the current node will become the root, it's (former) parent if any, will become one of it's children.
+     * Reverse the parent-child relationship all the way to the root, from a node onward.
+     * This has the effect of 're-rooting' the tree at the node if no immediate parent is given as argument.
+     * That is, the node will become the root, it's (former) parent if any, will become one of it's children.
      * This is then recursively bubbled up until it reaches the (former) root, which then will become a leaf.
+     * \param node The node to become the root.
      * \param new_parent The (new) parent-node of the root, useful for recursing or immediately attaching the node to another tree.
      */
-    void reroot(LightningTreeNodeSPtr new_parent = nullptr);
+    void reroot(const LightningTreeNodeIdx node, const LightningTreeNodeIdx new_parent = NO_INDEX);
 
     /*!
      * Retrieves the closest node to the specified location.
+     * \param node The root of the sub-tree to search in.
      * \param loc The specified location.
-     * \result The branch that starts at the position closest to the location within this tree.
+     * \result The branch that starts at the position closest to the location within the sub-tree.
      */
-    LightningTreeNodeSPtr closestNode(const Point2LL& loc);
+    LightningTreeNodeIdx closestNode(const LightningTreeNodeIdx node, const Point2LL& loc) const;
 
     /*!
-     * Returns whether the given tree node is a descendant of this node.
+     * Returns whether the given tree node is a descendant of a node.
      *
-     * If this node itself is given, it is also considered to be a descendant.
+     * If the node itself is given, it is also considered to be a descendant.
+     * \param node The root of the sub-tree to search in.
      * \param to_be_checked A node to find out whether it is a descendant of
-     * this node.
-     * \return ``true`` if the given node is a descendant or this node itself,
+     * \p node.
+     * \return ``true`` if the given node is a descendant or the node itself,
      * or ``false`` if it is not in the sub-tree.
      */
-    bool hasOffspring(const LightningTreeNodeSPtr& to_be_checked) const;
-
-protected:
-    LightningTreeNode() = delete; // Don't allow empty contruction
+    bool hasOffspring(const LightningTreeNodeIdx node, const LightningTreeNodeIdx to_be_checked) const;
 
     /*!
-     * Construct a new node, either for insertion in a tree or as root.
-     * \param p The physical location in the 2D layer that this node represents.
-     * Connecting other nodes to this node indicates that a line segment should
-     * be drawn between those two physical positions.
+     * Convert a tree into polylines
+     *
+     * At each junction one line is chosen at random to continue
+     *
+     * The lines start at a leaf and end in a junction
+     *
+     * \param node The root of the tree.
+     * \param output all branches in this tree connected into polylines
      */
-    LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location = std::nullopt);
+    void convertToPolylines(const LightningTreeNodeIdx node, OpenLinesSet& output, const coord_t line_width) const;
+
+private:
+    struct RectilinearJunction
+    {
+        coord_t total_recti_dist; //!< rectilinear distance along the tree from the last junction above to the junction below
+        Point2LL junction_loc; //!< junction location below
+    };
 
     /*!
-     * Copy this node and its entire sub-tree.
-     * \return The equivalent of this node in the copy (the root of the new sub-
+     * Copy a node and its entire sub-tree into another pool.
+     * \return The equivalent of the node in the copy (the root of the new sub-
      * tree).
      */
-    LightningTreeNodeSPtr deepCopy() const;
+    LightningTreeNodeIdx deepCopy(const LightningTreeNodeIdx node, LightningTreeNodePool& target) const;
+
+    /*!
+     * Move a node and its entire sub-tree to the end of a list of nodes, for
+     * \ref compact.
+     * \param node The node to move.
+     * \param parent The index of the parent of the node in \p target.
+     * \param target The list of nodes to move the sub-tree into.
+     * \return The index of the node in \p target.
+     */
+    LightningTreeNodeIdx moveTree(const LightningTreeNodeIdx node, const LightningTreeNodeIdx parent, std::vector<LightningTreeNode>& target);
 
     /*! Reconnect trees from the layer above to the new outlines of the lower layer.
      * \return Wether or not the root is kept (false is no, true is yes).
      */
-    bool realign(const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeSPtr>& rerooted_parts);
-
-    struct RectilinearJunction
-    {
-        coord_t total_recti_dist; //!< rectilinear distance along the tree from the last junction above to the junction below
-        Point2LL junction_loc; //!< junction location below
-    };
+    bool realign(const LightningTreeNodeIdx node, const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeIdx>& rerooted_parts);
 
     /*!
      * Smoothen the tree to make it a bit more printable, while still supporting
@@ -216,7 +302,7 @@ protected:
      * \param magnitude The maximum allowed distance to move the node.
      * \param max_remove_colinear_dist Maximum distance of the (compound) line-segment from which a co-linear point may be removed.
      */
-    void straighten(const coord_t magnitude, const coord_t max_remove_colinear_dist);
+    void straighten(const LightningTreeNodeIdx node, const coord_t magnitude, const coord_t max_remove_colinear_dist);
 
     /*! Recursive part of \ref straighten(.)
      * \param junction_above The last seen junction with multiple children above
@@ -224,32 +310,18 @@ protected:
      * \param max_remove_colinear_dist2 Maximum distance _squared_ of the (compound) line-segment from which a co-linear point may be removed.
      * \return the total distance along the tree from the last junction above to the first next junction below and the location of the next junction below
      */
-    RectilinearJunction straighten(const coord_t magnitude, const Point2LL& junction_above, const coord_t accumulated_dist, const coord_t max_remove_colinear_dist2);
+    RectilinearJunction straighten(
+        const LightningTreeNodeIdx node,
+        const coord_t magnitude,
+        const Point2LL& junction_above,
+        const coord_t accumulated_dist,
+        const coord_t max_remove_colinear_dist2);
 
     /*! Prune the tree from the extremeties (leaf-nodes) until the pruning distance is reached.
      * \return The distance that has been pruned. If less than \p distance, then the whole tree was puned away.
      */
-    coord_t prune(const coord_t& distance);
+    coord_t prune(const LightningTreeNodeIdx node, const coord_t& distance);
 
-public:
-    /*!
-     * Convert the tree into polylines
-     *
-     * At each junction one line is chosen at random to continue
-     *
-     * The lines start at a leaf and end in a junction
-     *
-     * \param output all branches in this tree connected into polylines
-     */
-    void convertToPolylines(OpenLinesSet& output, const coord_t line_width) const;
-
-    /*! If this was ever a direct child of the root, it'll have a previous grounding location.
-     *
-     * This needs to be known when roots are reconnected, so that the last (higher) layer is supported by the next one.
-     */
-    const std::optional<Point2LL>& getLastGroundingLocation() const;
-
-protected:
     /*!
      * Convert the tree into polylines
      *
@@ -260,16 +332,11 @@ protected:
      * \param long_line a reference to a polyline in \p output which to continue building on in the recursion
      * \param output all branches in this tree connected into polylines
      */
-    void convertToPolylines(size_t long_line_idx, OpenLinesSet& output) const;
+    void convertToPolylines(const LightningTreeNodeIdx node, size_t long_line_idx, OpenLinesSet& output) const;
 
-    void removeJunctionOverlap(OpenLinesSet& polylines, const coord_t line_width) const;
+    static void removeJunctionOverlap(OpenLinesSet& polylines, const coord_t line_width);
 
-    bool is_root_;
-    Point2LL p_;
-    std::weak_ptr<LightningTreeNode> parent_;
-    std::vector<LightningTreeNodeSPtr> children_;
-
-    std::optional<Point2LL> last_grounding_location_; //<! The last known grounding location, see 'getLastGroundingLocation()'.
+    std::vector<LightningTreeNode> nodes_;
 };
 
 } // namespace cura
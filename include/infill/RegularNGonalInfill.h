@@ -29,12 +29,13 @@ protected:
     /*!
      * Generate the parallel vertical lines that will all together form a hexagonal or octagonal pattern
      * @param line_distance The distance between lines to generate.
+     * @param outline The outline in which to print the pattern. Unused in this context, the lines fill its bounding box.
      * @param bounding_box The bounding box in which to print the pattern.
      * @param z The Z coordinate of this layer. Different Z coordinates cause the pattern to vary, producing a 3D pattern.
      * @param line_width The line width at which the infill will be printed.
      * @return The raw parallel lines to be included.
      */
-    OpenLinesSet generateParallelLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z, const coord_t line_width) const override;
+    OpenLinesSet generateParallelLines(const coord_t line_distance, const Shape& outline, const AABB& bounding_box, const coord_t z, const coord_t line_width) const override;
 
 private:
     struct SegmentsPattern
@@ -5,6 +5,7 @@
 #define MESH_H
 
 #include <algorithm>
+#include <atomic>
 #include <optional>
 
 #include "TextureDataMapping.h"
@@ -159,6 +160,19 @@ public:
         const std::optional<Point2F>& uv0 = std::nullopt,
         const std::optional<Point2F>& uv1 = std::nullopt,
         const std::optional<Point2F>& uv2 = std::nullopt); //!< add a face to the mesh without settings it's connected_faces.
+
+    /*!
+     * Add many faces at once.
+     *
+     * This gives exactly the same vertices and faces as calling addFace() for
+     * each face in order, but the vertices are welded in parallel. This is
+     * meant for loading a whole mesh in one go: if the mesh already contains
+     * vertices, the faces are simply added one by one.
+     * \param corners The 3D coordinates of the vertices, three per face.
+     * \param uv_coordinates The optional UV coordinates of the vertices, three
+     * per face. May be left empty if there are no UV coordinates at all.
+     */
+    void addFaces(const std::vector<Point3LL>& corners, const std::vector<std::optional<Point2F>>& uv_coordinates = {});
     void clear(); //!< clears all data
     void finish(); //!< complete the model : set the connected_face_index fields of the faces.
 
@@ -198,8 +212,18 @@ public:
     bool isModelMesh() const;
 
 private:
+    /*!
+     * Problems found in the topology of the mesh, which may be reported from several threads at once.
+     */
+    struct TopologyIssues
+    {
+        std::atomic<bool> disconnected_faces{ false };
+        std::atomic<bool> overlapping_faces{ false };
+    };
+
     mutable bool has_disconnected_faces{ false }; //!< Whether it has been logged that this mesh contains disconnected faces
     mutable bool has_overlapping_faces{ false }; //!< Whether it has been logged that this mesh contains overlapping faces
+    bool vertex_hash_map_outdated_{ false }; //!< Whether vertices were added (by addFaces) without registering them in the vertex_hash_map
     int findIndexOfVertex(const Point3LL& v); //!< find index of vertex close to the given point, or create a new vertex and return its index.
 
     /*!
@@ -211,9 +235,10 @@ private:
      * \param idx1 the second vertex index
      * \param notFaceIdx the index of a face which shouldn't be returned
      * \param notFaceVertexIdx should be the third vertex of face \p notFaceIdx.
+     * \param issues Gets marked when the mesh turns out to be disconnected or overlapping there.
      * \return the face index of a face sharing the edge from \p idx0 to \p idx1
      */
-    int getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVertexIdx) const;
+    int getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVertexIdx, TopologyIssues& issues) const;
 };
 
 } // namespace cura
@@ -5,6 +5,7 @@
 #define PATH_PLANNING_G_CODE_PATH_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "GCodePathConfig.h"
@@ -49,6 +50,7 @@ struct GCodePath
     bool done{ false }; //!< Path is finished, no more moves should be added, and a new path should be started instead of any appending done to this one.
     double fan_speed{ GCodePathConfig::FAN_SPEED_DEFAULT }; //!< fan speed override for this path, value should be within range 0-100 (inclusive) and ignored otherwise
     TimeMaterialEstimates estimates{}; //!< Naive time and material estimates
+    std::string formatted_xy{}; //!< The X and Y parameters of the extrusion moves to the points, formatted ahead of writing the g-code. Empty if they weren't.
     bool travel_to_z{ true }; //! Indicates whether we should add a travel move to the Z height of the first point before processing the path
 
     /*!
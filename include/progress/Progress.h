@@ -58,6 +58,7 @@ private:
     static std::array<double, N_PROGRESS_STAGES> accumulated_times; //!< Time past before each stage
     static double total_timing; //!< An estimate of the total time
     static std::optional<LayerIndex> first_skipped_layer; //!< The index of the layer for which we skipped time reporting
+    static bool peak_memory_per_stage; //!< Whether the peak memory was reset at the start of the current stage, or is the peak since the start of the process
     /*!
      * Give an estimate between 0 and 1 of how far the process is.
      *
@@ -81,6 +82,8 @@ public:
     /*!
      * Message the progress stage over the command socket.
      *
+     * Logs the time that the previous stage took and the peak memory use during it.
+     *
      * \param stage The current stage
      * \param timeKeeper The stapwatch keeping track of the timings for each stage (optional)
      */
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef SETTINGS_SETTING_KEY_H
+#define SETTINGS_SETTING_KEY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cura
+{
+
+/*!
+ * \brief The name of a setting, interned to a number that identifies it.
+ *
+ * Every distinct name gets the next free id the first time it is interned, and
+ * keeps it for the rest of the run. The settings containers store their
+ * resolved values by this id, so a lookup with a key that was interned before
+ * doesn't have to hash the name again.
+ *
+ * Keys that are looked up in loops should be interned once, with the
+ * \ref operator""_setting literal.
+ */
+class SettingKey
+{
+public:
+    /*!
+     * \brief Intern a setting name.
+     *
+     * Names that were interned before are found without locking.
+     * \param name The name of the setting.
+     */
+    explicit SettingKey(std::string_view name);
+
+    /*!
+     * \brief The id of this setting, counting up from 0 in the order in which
+     * the names were first interned.
+     */
+    size_t id() const
+    {
+        return id_;
+    }
+
+    /*!
+     * \brief The name of this setting.
+     */
+    const std::string& name() const
+    {
+        return *name_;
+    }
+
+private:
+    size_t id_;
+    const std::string* name_; //!< Owned by the registry of interned names, which keeps them for the rest of the run.
+};
+
+/*!
+ * \brief A string literal as a template argument, so that
+ * \ref operator""_setting can intern each name once.
+ */
+template<size_t N>
+struct SettingName
+{
+    char name[N];
+
+    consteval SettingName(const char (&literal)[N])
+    {
+        std::copy_n(literal, N, name);
+    }
+};
+
+/*!
+ * \brief Intern a setting name at its first use.
+ *
+ * Use as <tt>settings.get<coord_t>("layer_height"_setting)</tt>. Only the
+ * first use interns the name. Every later use reads a static.
+ */
+template<SettingName Name>
+const SettingKey& operator""_setting()
+{
+    static const SettingKey key(std::string_view(Name.name, sizeof(Name.name) - 1));
+    return key;
+}
+
+} // namespace cura
+
+#endif // SETTINGS_SETTING_KEY_H
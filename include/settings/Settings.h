@@ -13,11 +13,20 @@
 // Maximum number of infill layers that can be combined into a single infill extrusion area.
 #define MAX_INFILL_COMBINE 8
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "settings/SettingKey.h"
+
 namespace cura
 {
 
@@ -38,6 +47,18 @@ public:
      */
     Settings();
 
+    Settings(const Settings& other) = default;
+    Settings(Settings&& other) = default;
+
+    /*!
+     * \brief Replace all settings in this container.
+     *
+     * Like any other change, this makes the resolved values of all containers
+     * outdated, as this container may be the parent of others.
+     */
+    Settings& operator=(const Settings& other);
+    Settings& operator=(Settings&& other);
+
     /*!
      * \brief Adds a new setting.
      * \param key The name by which the setting is identified.
@@ -71,7 +92,21 @@ public:
      * \return The setting's value, cast to the desired type.
      */
     template<typename A>
-    A get(const std::string& key) const;
+    A get(const SettingKey& key) const;
+
+    /*!
+     * \brief Get the value of a setting, by the name of its key.
+     *
+     * The same as the other overload, after interning the name. Prefer that one
+     * with a \ref operator""_setting literal in loops.
+     * \param key The name of the setting to get.
+     * \return The setting's value, cast to the desired type.
+     */
+    template<typename A>
+    A get(const std::string& key) const
+    {
+        return get<A>(SettingKey(key));
+    }
 
     /*!
      * \brief Get a string containing all settings in this container.
@@ -107,7 +142,145 @@ public:
 
     std::vector<std::string> getKeys() const;
 
+    /*!
+     * \brief Get the keys of all settings that are stored in this container
+     * with a different value than in \p other, or that are stored in only one
+     * of them.
+     *
+     * Only the values stored in the containers themselves are compared, not
+     * the ones they would inherit from their parents.
+     * \param other The settings container to compare with.
+     * \return The keys of the settings that differ, in no particular order.
+     */
+    std::vector<std::string> getDifferingKeys(const Settings& other) const;
+
+    /*!
+     * \brief Drop all values that were resolved and parsed before, in all
+     * settings containers.
+     *
+     * This is done automatically when a setting is added or removed, or a
+     * parent changes. It only needs to be called when something else that
+     * influences the resolved values changes, such as the limiting of settings
+     * to extruders.
+     */
+    static void invalidateResolvedValues();
+
+    /*!
+     * \brief Start counting the lookups that got a parsed value from the cache
+     * of resolved values, instead of parsing the string again.
+     *
+     * Counting is off until this is called, and then costs only a check of a
+     * flag per lookup. Each thread counts on its own, so that the threads don't
+     * contend on the counter.
+     */
+    static void startCountingSavedParses();
+
+    /*!
+     * \brief Stop counting the lookups that saved a parse.
+     * \return How many lookups saved a parse since the counting started, on
+     * all threads together.
+     */
+    static size_t stopCountingSavedParses();
+
 private:
+    /*!
+     * \brief A setting value as it was resolved through the inheritance chain,
+     * and parsed in all the forms that are cached.
+     *
+     * It is not changed once it is published in a cache, so that it can be
+     * read without locking.
+     */
+    struct ResolvedValue
+    {
+        uint64_t generation; //!< The generation of the settings in which the value was resolved.
+        std::string as_string;
+        double as_double;
+        int as_int;
+        std::optional<size_t> as_size_t; //!< Not set if std::stoul can't parse the value, so that getting it throws like before.
+        bool as_bool;
+    };
+
+    /*!
+     * \brief Memoizes the resolved values of a settings container, by the id
+     * of their key.
+     *
+     * The values are read concurrently from many threads without locking.
+     * Whenever any settings container changes, all cached values become
+     * outdated, since the change could be in one of the parents. Outdated
+     * values are replaced when they are looked up again. The values they
+     * replace are kept until this container changes or is destroyed, since
+     * other threads may still be reading them. Copies of a settings container
+     * start with an empty cache.
+     */
+    class ResolvedValueCache
+    {
+    public:
+        ResolvedValueCache() = default;
+        ResolvedValueCache(const ResolvedValueCache&)
+        {
+        }
+        ResolvedValueCache& operator=(const ResolvedValueCache&)
+        {
+            clear();
+            return *this;
+        }
+        ~ResolvedValueCache();
+
+        /*!
+         * \brief Find the value of a key, if it was resolved in the given
+         * \p generation.
+         */
+        const ResolvedValue* find(const size_t id, const uint64_t generation) const;
+
+        /*!
+         * \brief Publish a resolved value.
+         *
+         * If another thread published a value of the same generation first,
+         * that one is kept.
+         * \return The value that is in the cache now, or nullptr if the id is
+         * too high to be cached. The \p value is only taken if it is
+         * returned.
+         */
+        const ResolvedValue* store(const size_t id, std::unique_ptr<ResolvedValue>& value);
+
+        /*!
+         * \brief Drop all values. Must not be called while other threads read
+         * from this cache.
+         */
+        void clear();
+
+        //! Incremented each time any settings container changes, making the cached values of all containers outdated.
+        static std::atomic<uint64_t> generation_;
+
+    private:
+        static constexpr size_t chunk_size = 64;
+        static constexpr size_t max_chunks = 256; //!< Keys with a higher id than fit in this many chunks are resolved again on every lookup.
+        using Chunk = std::array<std::atomic<const ResolvedValue*>, chunk_size>;
+
+        std::array<std::atomic<Chunk*>, max_chunks> chunks_{}; //!< Allocated once a value of a key in it is stored.
+        std::mutex retired_mutex_;
+        std::vector<std::unique_ptr<const ResolvedValue>> retired_; //!< The outdated values that were replaced since the last clear().
+    };
+
+    /*!
+     * \brief Get a value from the cache of resolved values, or resolve and
+     * parse it and store it in there.
+     * \param key The key of the setting to get.
+     * \param is_parse Whether getting the value from the cache saves parsing
+     * it, to count it.
+     * \param read Function to get the requested form from the value.
+     * \return The setting's value, in the requested form.
+     */
+    template<typename F>
+    auto getResolved(const SettingKey& key, const bool is_parse, F&& read) const;
+
+    /*!
+     * \brief Resolve the value of a setting through the inheritance chain.
+     * \param key The key of the setting to get.
+     * \return The setting's value.
+     */
+    std::string resolve(const SettingKey& key) const;
+
     /*!
      * Optionally, a parent setting container to ask for the value of a setting
      * if this container has no value for it.
@@ -119,6 +292,11 @@ private:
      */
     std::unordered_map<std::string, std::string> settings;
 
+    /*!
+     * \brief The values that were resolved for this container before.
+     */
+    mutable ResolvedValueCache resolved_values_;
+
     /*!
      * \brief Get the value of a setting, but without looking at the limiting to
      * extruder.
@@ -128,7 +306,7 @@ private:
      * \param key The key of the setting to get.
      * \return The setting's value.
      */
-    std::string getWithoutLimiting(const std::string& key) const;
+    std::string getWithoutLimiting(const SettingKey& key) const;
 };
 
 } // namespace cura
@@ -4,19 +4,145 @@
 #ifndef SKIN_H
 #define SKIN_H
 
+#include <atomic>
 #include <optional>
+#include <utility>
+#include <vector>
 
+#include "geometry/Shape.h"
 #include "settings/types/LayerIndex.h"
 #include "utils/Coord_t.h"
 
 namespace cura
 {
 
-class Shape;
 class SkinPart;
 class SliceLayerPart;
 class SliceMeshStorage;
 
+/*!
+ * Intersections of the outlines of a mesh over windows of consecutive layers.
+ *
+ * The top and bottom skin computations intersect the outlines of the
+ * top_layers/bottom_layers layers above or below each layer. Done per layer,
+ * every outline gets intersected that many times. Instead, the layers are
+ * split into blocks of the window size, and for each layer the intersection
+ * from the start of its block up to it (prefix) and from it up to the end of
+ * its block (suffix) is stored. Any window of that size then covers the end
+ * of one block and the start of the next, and is the intersection of a
+ * suffix and a prefix.
+ *
+ * The outlines of all parts of a layer are used, so the callers have to limit
+ * the result to the part they are interested in.
+ *
+ * Intersecting in a different order than the skin computation would, Clipper
+ * may round the vertices it creates where edges cross differently. So an
+ * intersection is only handed out if all its vertices are vertices of the
+ * outlines themselves. Otherwise the callers compute it the way they always
+ * did. A chain of prefixes or suffixes is not continued once it has such a
+ * created vertex, since no window using it would be handed out anyway.
+ *
+ * The polygons of a shared intersection may come in a different order, or
+ * start at a different vertex, than when the skin computation intersects the
+ * outlines itself. The skin areas cover the same area with the same vertices,
+ * but their polygons may be ordered differently.
+ *
+ * Each layer stores a prefix and a suffix, which are rarely larger than the
+ * outline of the layer. A block is released once the skin of all layers that
+ * read it is computed. On top of that, at most max_stored_points vertices are
+ * stored at once; the windows of blocks that don't fit are computed by the
+ * callers layer by layer.
+ */
+class OutlineWindowIntersections
+{
+public:
+    /*!
+     * Prepare the storage of the intersections. Nothing is computed yet: call
+     * computeBlock() for all blocks, once the walls of their layers are done.
+     * \param mesh The mesh from whose layer part outlines to compute the
+     * intersections.
+     * \param window_size The number of layers in a window, at least one.
+     * \param max_stored_points The most vertices to store at once, over all
+     * blocks.
+     */
+    OutlineWindowIntersections(const SliceMeshStorage& mesh, size_t window_size, size_t max_stored_points = default_max_stored_points);
+
+    //! 64 MiB of vertices.
+    static constexpr size_t default_max_stored_points = size_t(1) << 22;
+
+    /*!
+     * The number of blocks, of window size layers each (except the last).
+     */
+    size_t getBlockCount() const;
+
+    /*!
+     * The block that a layer falls in.
+     */
+    size_t getBlockIndex(const LayerIndex layer_nr) const;
+
+    /*!
+     * Compute the prefix and suffix intersections of a block.
+     *
+     * The blocks are independent, so they can be computed in parallel.
+     * \param block_idx The block to compute.
+     */
+    void computeBlock(const size_t block_idx);
+
+    /*!
+     * Free the intersections of a block, once no layer needs them anymore.
+     * \param block_idx The block to release.
+     */
+    void releaseBlock(const size_t block_idx);
+
+    /*!
+     * Get the intersection of the outlines of a range of layers.
+     *
+     * The range should be at most the window size, and either be a full window
+     * or lie within a single block and start or end at its boundary, like the
+     * shortened windows at the bottom of the mesh.
+     * \param first_layer_nr The first layer of the range.
+     * \param last_layer_nr The last layer of the range, inclusive. Layers
+     * above the mesh are empty, and so is the intersection.
+     * \return The intersection, or nothing if the range isn't one the blocks
+     * are made for or if the intersection has vertices created by Clipper.
+     */
+    std::optional<Shape> getIntersection(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr) const;
+
+    /*!
+     * How many calls to getIntersection() there were, and how many of them
+     * returned an intersection. Only counted while debug logging is enabled.
+     */
+    std::pair<size_t, size_t> getLookupAndHitCount() const;
+
+private:
+    /*!
+     * An intersection of the outlines of consecutive layers.
+     */
+    struct Intersection
+    {
+        Shape shape; //!< The intersection, or empty if it isn't exact.
+        bool exact = false; //!< Whether all vertices of the intersection are vertices of the outlines.
+    };
+
+    /*!
+     * Intersect two intersections, keeping track of whether the result is exact.
+     */
+    static Intersection intersect(const Intersection& a, const Intersection& b);
+
+    Shape getLayerOutline(const LayerIndex layer_nr) const;
+
+    const SliceMeshStorage& mesh_;
+    LayerIndex window_size_;
+    std::vector<Intersection> prefix_intersections_; //!< Per layer, the intersection of the outlines from the start of its block up to and including the layer.
+    std::vector<Intersection> suffix_intersections_; //!< Per layer, the intersection of the outlines from the layer up to and including the end of its block.
+    std::vector<size_t> block_points_; //!< Per block, the number of vertices it stores.
+    size_t max_stored_points_;
+    std::atomic<size_t> stored_points_{ 0 }; //!< Over all blocks that were computed and not released yet.
+    bool count_lookups_; //!< Whether to count the lookups, to log the hit rate.
+    mutable std::atomic<size_t> lookup_count_{ 0 };
+    mutable std::atomic<size_t> hit_count_{ 0 };
+};
+
 /*!
  * Class containing all skin and infill area computation functions
  */
@@ -32,8 +158,17 @@ public:
      * stored and where the skin insets and fill areas (output) are stored.
      * \param process_infill Whether to process infill, i.e. whether there's a
      * positive infill density or there are infill meshes modifying this mesh.
+     * \param top_windows Precomputed intersections of the outlines over the
+     * top_layers layers above each layer, or nullptr to compute them here.
+     * \param bottom_windows Precomputed intersections of the outlines over the
+     * bottom_layers layers below each layer, or nullptr to compute them here.
      */
-    SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill);
+    SkinInfillAreaComputation(
+        const LayerIndex& layer_nr,
+        SliceMeshStorage& mesh,
+        bool process_infill,
+        const OutlineWindowIntersections* top_windows = nullptr,
+        const OutlineWindowIntersections* bottom_windows = nullptr);
 
     /*!
      * Generate the skin areas and its insets.
@@ -181,6 +316,8 @@ protected:
     coord_t bottom_skin_preshrink_; //!< The bottom skin removal width, to remove thin strips of skin along nearly-vertical walls.
     coord_t top_skin_expand_distance_; //!< The distance by which the top skins should be larger than the original top skins.
     coord_t bottom_skin_expand_distance_; //!< The distance by which the bottom skins should be larger than the original bottom skins.
+    const OutlineWindowIntersections* top_windows_; //!< The shared outline intersections over the layers above, if precomputed.
+    const OutlineWindowIntersections* bottom_windows_; //!< The shared outline intersections over the layers below, if precomputed.
 
 private:
     static coord_t getSkinLineWidth(const SliceMeshStorage& mesh, const LayerIndex& layer_nr); //!< Compute the skin line width, which might be different for the first layer.
@@ -197,6 +334,20 @@ private:
      * \param layer2_nr The layer index from which to gather the outlines.
      */
     Shape getOutlineOnLayer(const SliceLayerPart& part_here, const LayerIndex layer2_nr);
+
+    /*!
+     * Helper function to get the intersection of the outlines of a range of
+     * layers which might intersect with \p part_here, from the precomputed
+     * \p windows.
+     * \param part_here The part for which to check.
+     * \param windows The precomputed intersections.
+     * \param first_layer_nr The first layer of the range.
+     * \param last_layer_nr The last layer of the range, inclusive.
+     * \return The intersection, or nothing if it has to be computed layer by
+     * layer to get the same result.
+     */
+    std::optional<Shape>
+        getOutlineIntersection(const SliceLayerPart& part_here, const OutlineWindowIntersections& windows, const LayerIndex first_layer_nr, const LayerIndex last_layer_nr);
 };
 
 } // namespace cura
@@ -202,6 +202,11 @@ public:
      */
     void getOutlines(Shape& result, bool external_polys_only = false) const;
 
+    /*!
+     * Free all geometry of this layer. Only the height and thickness of the layer are kept.
+     */
+    void releaseGeometry();
+
     ~SliceLayer();
 };
 
@@ -477,6 +482,15 @@ public:
 
     void initializePrimeTower();
 
+    /*!
+     * \brief Free the geometry of a layer of all meshes and of the support, once nothing refers to it anymore.
+     *
+     * The layer itself stays, so that the layer numbers and the heights of the layers don't change.
+     *
+     * \param layer_nr The layer to free. Raft layers (negative layer numbers) have no geometry of their own.
+     */
+    void releaseLayer(const LayerIndex layer_nr);
+
 private:
     /*!
      * Construct the retraction_wipe_config_per_extruder
@@ -498,8 +498,31 @@ public:
         const SlicingTolerance slicing_tolerance,
         const coord_t initial_layer_thickness);
 
+#ifdef BUILD_TESTS
+    /*!
+     * \brief Create the segments of a mesh in the given layers, without
+     * connecting them into polygons.
+     *
+     * Only meant to test and benchmark how the segments are created.
+     * \param mesh The mesh to slice.
+     * \param slicing_tolerance The way the slicing tolerance should be applied.
+     * \param full_scan Whether to find the faces that span each layer by
+     * testing every face against every layer, the way the slicer used to, to
+     * compare with. Otherwise the faces are swept over the layers once, like
+     * the slicer does.
+     * \param[in, out] layers The layers, with their z set. The segments are
+     * created here.
+     */
+    [[maybe_unused]] static void sliceSegments(const Mesh& mesh, const SlicingTolerance slicing_tolerance, const bool full_scan, std::vector<SlicerLayer>& layers);
+#endif
 
 private:
+    /*!
+     * The faces spanning each layer: for each layer the offset of its first
+     * face in the second vector, followed by the indices of the faces.
+     */
+    using FacesPerLayer = std::pair<std::vector<size_t>, std::vector<uint32_t>>;
+
     /*!
      * \brief Linear interpolation between coordinates of a line.
      *
@@ -594,6 +617,26 @@ private:
      */
     static void
         buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers);
+
+    /*! Creates the segments of the given faces and write them into the layers.
+     * \param[in] mesh The mesh which is analyzed.
+     * \param[in] faces_per_layer The faces spanning each layer, in increasing index order.
+     * \param[in] slicing_tolderance Slicing tolerance in order to figure out what happens when vertices are exactly on the slicing boundary.
+     * \param[in, out] layers The segments are created here.
+     */
+    static void buildSegments(const Mesh& mesh, const FacesPerLayer& faces_per_layer, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers);
+
+    /*!
+     * Sweeps the faces of a mesh once over the layer heights to find which faces span which layer.
+     *
+     * Instead of testing every face against every layer, each face is only
+     * registered in the layers between its minimum and maximum Z.
+     * \param[in] zbboxes The z part of the bounding boxes of the faces of the mesh.
+     * \param[in] layers The layers, with their z set.
+     * \return The faces spanning each layer. The faces of each layer are
+     * listed in increasing index order.
+     */
+    static FacesPerLayer buildFacesPerLayer(const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const std::vector<SlicerLayer>& layers);
 };
 
 } // namespace cura
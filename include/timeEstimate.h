@@ -4,8 +4,8 @@
 #ifndef TIME_ESTIMATE_H
 #define TIME_ESTIMATE_H
 
+#include <array>
 #include <stdint.h>
-#include <unordered_map>
 #include <vector>
 
 #include "PrintFeature.h"
@@ -56,31 +56,58 @@ public:
         }
     };
 
-    class Block
+private:
+    /*!
+     * The planned moves, with every property in an array of its own.
+     *
+     * The passes over the moves only load the properties they use, and the
+     * passes that handle every move on its own can be vectorized.
+     */
+    struct Moves
     {
-    public:
-        bool recalculate_flag;
+        std::array<std::vector<double>, NUM_AXIS> delta; //!< The movement along every axis
+        std::vector<double> feedrate; //!< The requested feedrate
+        std::vector<double> default_acceleration; //!< The acceleration that was set when the move was planned
+        std::vector<double> max_xy_jerk; //!< The max xy jerk that was set when the move was planned
+        std::vector<PrintFeatureType> feature; //!< The feature which the move prints
 
-        double accelerate_until;
-        double decelerate_after;
-        Velocity initial_feedrate;
-        Velocity final_feedrate;
+        // Only depend on the movement, computed once the moves are prepared.
+        std::vector<double> distance; //!< The length of the move
+        std::vector<double> acceleration; //!< The acceleration of the move, limited by the max acceleration of every axis
+
+        size_t size() const
+        {
+            return feature.size();
+        }
 
-        Velocity entry_speed;
-        Velocity max_entry_speed;
-        bool nominal_length_flag;
+        void clear();
+    };
 
-        Velocity nominal_feedrate;
-        double maxTravel;
-        double distance;
-        Acceleration acceleration;
-        Position delta;
-        Position absDelta;
+    /*!
+     * The speeds at which the planned moves are printed, with every property in
+     * an array of its own.
+     */
+    struct SpeedProfile
+    {
+        std::vector<double> nominal_feedrate; //!< The feedrate when cruising, limited by the max feedrate of every axis
+        std::vector<double> max_entry_speed; //!< The highest speed at the start of the move that the jerk allows
+        std::vector<double> entry_speed; //!< The speed at the start of the move
+        std::vector<uint8_t> nominal_length_flag; //!< Whether the move is long enough to reach the nominal feedrate from any entry speed
+        std::vector<uint8_t> recalculate_flag; //!< Whether the entry speed changed since the trapezoid was computed
+        std::vector<double> accelerate_until; //!< The distance at which the move stops accelerating
+        std::vector<double> decelerate_after; //!< The distance at which the move starts decelerating
+        std::vector<double> initial_feedrate; //!< The feedrate at the start of the move
+        std::vector<double> final_feedrate; //!< The feedrate at the end of the move
+
+        size_t size() const
+        {
+            return nominal_feedrate.size();
+        }
 
-        PrintFeatureType feature;
+        void resize(const size_t size);
+        void clear();
     };
 
-private:
     Velocity max_feedrate[NUM_AXIS] = { 600.0, 600.0, 40.0, 25.0 }; // mm/s
     Velocity minimumfeedrate = 0.01;
     Acceleration acceleration = 3000.0;
@@ -95,7 +122,9 @@ private:
 
     Position currentPosition;
 
-    std::vector<Block> blocks;
+    Moves moves;
+    size_t prepared_moves = 0; //!< The number of moves at the start of \ref moves of which the distance, acceleration and speed profile are computed
+    SpeedProfile profile; //!< The speed profile of the prepared moves
 
 public:
     /*!
@@ -113,23 +142,55 @@ public:
 
     std::vector<Duration> calculate();
 
+    /*!
+     * \brief Estimate the time of the planned moves as if all extrusion moves
+     * were planned at a different feedrate.
+     *
+     * Only the speeds are planned again, so this is much cheaper than planning
+     * all moves again. The estimates of \ref calculate are not affected.
+     * \param speed_factor The factor to multiply the feedrate of every
+     * extrusion move with. Travel moves keep their feedrate.
+     * \return The time estimates per feature, like \ref calculate.
+     */
+    std::vector<Duration> calculate(const Ratio& speed_factor);
+
 private:
-    void reversePass();
-    void forwardPass();
+    /*!
+     * \brief Compute the distance and acceleration and the speed profile of the
+     * moves that were planned after the last preparation.
+     */
+    void prepareMoves();
+
+    /*!
+     * \brief Plan the speeds of a range of moves, limited by the max feedrates
+     * and the jerk at the junctions between them.
+     * \param first The first move to plan, of which the speed profile starts
+     * at the end of \p speed_profile.
+     * \param speed_factor The factor to multiply the feedrate of every
+     * extrusion move with.
+     * \param[in,out] last_feedrate The feedrate per axis of the move before
+     * \p first, updated to the one of the last move.
+     * \param[in,out] last_nominal_feedrate The nominal feedrate of the move
+     * before \p first, updated to the one of the last move.
+     * \param speed_profile The speed profile to add the moves to.
+     */
+    void planSpeeds(const size_t first, const Ratio& speed_factor, Position& last_feedrate, Velocity& last_nominal_feedrate, SpeedProfile& speed_profile) const;
+
+    /*!
+     * \brief Compute how long all moves take with the given speed profile.
+     */
+    std::vector<Duration> sumDurations(SpeedProfile& speed_profile) const;
+
+    void reversePass(SpeedProfile& speed_profile) const;
+    void forwardPass(SpeedProfile& speed_profile) const;
 
     // Recalculates the trapezoid speed profiles for all blocks in the plan according to the
     // entry_factor for each junction. Must be called by planner_recalculate() after
     // updating the blocks.
-    void recalculateTrapezoids();
+    void recalculateTrapezoids(SpeedProfile& speed_profile) const;
 
     // Calculates trapezoid parameters so that the entry- and exit-speed is compensated by the provided factors.
-    void calculateTrapezoidForBlock(Block* block, const Ratio entry_factor, const Ratio exit_factor);
-
-    // The kernel called by accelerationPlanner::calculate() when scanning the plan from last to first entry.
-    void plannerReversePassKernel(Block* previous, Block* current, Block* next);
-
-    // The kernel called by accelerationPlanner::calculate() when scanning the plan from first to last entry.
-    void plannerForwardPassKernel(Block* previous, Block* current, Block* next);
+    void calculateTrapezoidForBlock(SpeedProfile& speed_profile, const size_t block_idx, const Ratio entry_factor, const Ratio exit_factor) const;
 };
 
 } // namespace cura
@@ -0,0 +1,366 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_CHUNKED_LIST_H
+#define UTILS_CHUNKED_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * \brief Doubly linked list whose elements are stored next to each other in large chunks of memory.
+ *
+ * It behaves like a std::list: elements never move, so pointers and references to them stay valid until they are
+ * erased, and iterating visits them in the order in which they were linked into the list. But rather than allocating
+ * every element separately, the elements are placed in chunks of \p ChunkSize elements. Erased elements leave a hole
+ * that is reused by the next element that is added.
+ *
+ * Clearing the list keeps the chunks, so that a list which is cleared and filled again, e.g. for every layer, stops
+ * allocating memory once it has reached its largest size.
+ *
+ * \tparam T The type of the elements.
+ * \tparam ChunkSize The number of elements that fit in a single chunk.
+ */
+template<typename T, size_t ChunkSize = 256>
+class ChunkedList
+{
+    struct Links
+    {
+        Links* prev_;
+        Links* next_;
+    };
+
+    struct Slot
+    {
+        Links links_; //!< Must be the first member, so that the slot can be found back from its links
+        alignas(T) std::byte storage_[sizeof(T)];
+
+        T* value()
+        {
+            return std::launder(reinterpret_cast<T*>(storage_));
+        }
+    };
+
+    template<bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() = default;
+
+        explicit Iterator(Links* links)
+            : links_(links)
+        {
+        }
+
+        operator Iterator<true>() const
+            requires(! IsConst)
+        {
+            return Iterator<true>(links_);
+        }
+
+        reference operator*() const
+        {
+            return *reinterpret_cast<Slot*>(links_)->value();
+        }
+
+        pointer operator->() const
+        {
+            return reinterpret_cast<Slot*>(links_)->value();
+        }
+
+        Iterator& operator++()
+        {
+            links_ = links_->next_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator result = *this;
+            links_ = links_->next_;
+            return result;
+        }
+
+        Iterator& operator--()
+        {
+            links_ = links_->prev_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator result = *this;
+            links_ = links_->prev_;
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const = default;
+
+    private:
+        Links* links_{ nullptr };
+
+        friend class ChunkedList;
+    };
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    ChunkedList()
+    {
+        sentinel_.prev_ = &sentinel_;
+        sentinel_.next_ = &sentinel_;
+    }
+
+    ChunkedList(const ChunkedList&) = delete;
+    ChunkedList& operator=(const ChunkedList&) = delete;
+
+    ChunkedList(ChunkedList&& other) noexcept
+        : ChunkedList()
+    {
+        takeOver(other);
+    }
+
+    ChunkedList& operator=(ChunkedList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            chunks_.clear();
+            takeOver(other);
+        }
+        return *this;
+    }
+
+    ~ChunkedList()
+    {
+        clear();
+    }
+
+    iterator begin()
+    {
+        return iterator(sentinel_.next_);
+    }
+
+    iterator end()
+    {
+        return iterator(&sentinel_);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(sentinel_.next_);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(const_cast<Links*>(&sentinel_));
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /*!
+     * \brief The number of elements that fit in the chunks that are allocated now
+     */
+    size_t capacity() const
+    {
+        return chunks_.size() * ChunkSize;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    T& front()
+    {
+        assert(! empty());
+        return *begin();
+    }
+
+    T& back()
+    {
+        assert(! empty());
+        return *std::prev(end());
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        return emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        return emplace(end(), std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Construct a new element in front of \p position
+     * \return The new element
+     */
+    template<typename... Args>
+    T& emplace(const const_iterator position, Args&&... args)
+    {
+        Slot* slot = allocateSlot();
+        T* value;
+        try
+        {
+            value = ::new (slot->storage_) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            slot->links_.next_ = free_slots_;
+            free_slots_ = &slot->links_;
+            throw;
+        }
+
+        Links* next = position.links_;
+        slot->links_.next_ = next;
+        slot->links_.prev_ = next->prev_;
+        next->prev_->next_ = &slot->links_;
+        next->prev_ = &slot->links_;
+        ++size_;
+        return *value;
+    }
+
+    /*!
+     * \brief Destroy an element
+     * \return An iterator to the element after the erased one
+     */
+    iterator erase(const const_iterator position)
+    {
+        assert(position != end());
+        Links* links = position.links_;
+        Links* next = links->next_;
+        links->prev_->next_ = next;
+        next->prev_ = links->prev_;
+
+        Slot* slot = reinterpret_cast<Slot*>(links);
+        slot->value()->~T();
+        slot->links_.next_ = free_slots_;
+        free_slots_ = &slot->links_;
+        --size_;
+        return iterator(next);
+    }
+
+    /*!
+     * \brief Get the iterator of an element in this list, without searching for it
+     */
+    iterator iterator_to(T& value)
+    {
+        return iterator(&slotOf(value)->links_);
+    }
+
+    const_iterator iterator_to(const T& value) const
+    {
+        return const_iterator(&slotOf(const_cast<T&>(value))->links_);
+    }
+
+    /*!
+     * \brief Destroy all the elements, but keep the memory to store new elements in
+     */
+    void clear()
+    {
+        for (Links* links = sentinel_.next_; links != &sentinel_; links = links->next_)
+        {
+            reinterpret_cast<Slot*>(links)->value()->~T();
+        }
+        sentinel_.prev_ = &sentinel_;
+        sentinel_.next_ = &sentinel_;
+        size_ = 0;
+        free_slots_ = nullptr;
+        used_slots_ = 0;
+    }
+
+    /*!
+     * \brief Destroy all the elements, and keep only the memory to store up to \p max_capacity new elements in
+     *
+     * The capacity is rounded down to whole chunks.
+     */
+    void clear(const size_t max_capacity)
+    {
+        clear();
+        if (chunks_.size() > max_capacity / ChunkSize)
+        {
+            chunks_.resize(max_capacity / ChunkSize);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    size_t used_slots_{ 0 }; //!< The number of slots in the chunks that have ever been handed out since the last clear
+    Links* free_slots_{ nullptr }; //!< Singly linked list of the slots of erased elements
+    Links sentinel_; //!< The list is circular, this is both before the first and after the last element
+    size_t size_{ 0 };
+
+    static Slot* slotOf(T& value)
+    {
+        return reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(std::addressof(value)) - offsetof(Slot, storage_));
+    }
+
+    Slot* allocateSlot()
+    {
+        if (free_slots_)
+        {
+            Slot* slot = reinterpret_cast<Slot*>(free_slots_);
+            free_slots_ = free_slots_->next_;
+            return slot;
+        }
+        const size_t chunk_idx = used_slots_ / ChunkSize;
+        if (chunk_idx == chunks_.size())
+        {
+            chunks_.push_back(std::make_unique_for_overwrite<Slot[]>(ChunkSize));
+        }
+        return &chunks_[chunk_idx][used_slots_++ % ChunkSize];
+    }
+
+    /*!
+     * Take over the elements and memory of another list, which must be empty and leaves the other list empty.
+     */
+    void takeOver(ChunkedList& other)
+    {
+        assert(empty() && chunks_.empty());
+        chunks_ = std::move(other.chunks_);
+        used_slots_ = std::exchange(other.used_slots_, 0);
+        free_slots_ = std::exchange(other.free_slots_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        if (size_ > 0)
+        {
+            sentinel_.next_ = other.sentinel_.next_;
+            sentinel_.prev_ = other.sentinel_.prev_;
+            sentinel_.next_->prev_ = &sentinel_;
+            sentinel_.prev_->next_ = &sentinel_;
+        }
+        other.sentinel_.prev_ = &other.sentinel_;
+        other.sentinel_.next_ = &other.sentinel_;
+        other.chunks_.clear();
+    }
+};
+
+} // namespace cura
+
+#endif // UTILS_CHUNKED_LIST_H
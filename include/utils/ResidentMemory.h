@@ -0,0 +1,38 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_RESIDENT_MEMORY_H
+#define UTILS_RESIDENT_MEMORY_H
+
+#include <cstddef>
+
+namespace cura
+{
+
+/*!
+ * \brief How much physical memory (resident set size) the process uses right now.
+ *
+ * \return The size in bytes, or 0 if it can't be determined on this platform.
+ */
+size_t getCurrentResidentMemory();
+
+/*!
+ * \brief The most physical memory (resident set size) that the process used since it started, or since the last successful
+ * resetPeakResidentMemory().
+ *
+ * \return The size in bytes, or 0 if it can't be determined on this platform.
+ */
+size_t getPeakResidentMemory();
+
+/*!
+ * \brief Start measuring the peak resident memory anew from the current use, so that the peak of a single stage can be measured.
+ *
+ * Only supported on Linux.
+ *
+ * \return Whether the peak was reset. If not, getPeakResidentMemory() keeps returning the peak since the process started.
+ */
+bool resetPeakResidentMemory();
+
+} // namespace cura
+
+#endif // UTILS_RESIDENT_MEMORY_H
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_RING_SEARCH_GRID_H
+#define UTILS_RING_SEARCH_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "geometry/Point2LL.h"
+
+namespace cura
+{
+
+/*! \brief Dense grid to visit the elements nearest to a point first, without knowing beforehand how far to search.
+ *
+ * The grid covers the bounding box of the elements it was built with, with cells of about one element each. A search starts at the cell of
+ * the query point and works outward one ring of cells at a time, until the rings can't contain anything closer than what the caller is
+ * still interested in. This makes finding the nearest element cost about as much as the number of cells between the query and that element,
+ * rather than the number of elements.
+ *
+ * The grid is immutable. To "remove" elements, the visitor can simply ignore them, and the grid can be rebuilt from the remaining elements
+ * when too many of them are ignored.
+ *
+ * \tparam ElemT The element type to store, next to its location.
+ */
+template<class ElemT>
+class RingSearchGrid
+{
+public:
+    using Elem = ElemT;
+
+    /*! \brief Builds the grid.
+     *
+     * \param elements The elements with their locations.
+     */
+    explicit RingSearchGrid(const std::vector<std::pair<Point2LL, Elem>>& elements)
+    {
+        if (elements.empty())
+        {
+            return;
+        }
+        min_ = elements.front().first;
+        Point2LL max = min_;
+        for (const auto& [location, elem] : elements)
+        {
+            min_.X = std::min(min_.X, location.X);
+            min_.Y = std::min(min_.Y, location.Y);
+            max.X = std::max(max.X, location.X);
+            max.Y = std::max(max.Y, location.Y);
+        }
+        const coord_t width = max.X - min_.X;
+        const coord_t height = max.Y - min_.Y;
+        const auto count = static_cast<coord_t>(elements.size());
+        // About one element per cell. The second term keeps the number of cells in check when the elements are (nearly) on a line.
+        cell_size_ = std::max({ static_cast<coord_t>(std::sqrt(static_cast<double>(width) * static_cast<double>(height) / static_cast<double>(count))),
+                                std::max(width, height) / count,
+                                coord_t(1) });
+        columns_ = width / cell_size_ + 1;
+        rows_ = height / cell_size_ + 1;
+
+        // Counting sort of the elements into their cells.
+        cell_starts_.assign(columns_ * rows_ + 1, 0);
+        for (const auto& [location, elem] : elements)
+        {
+            ++cell_starts_[toCellIndex(location) + 1];
+        }
+        for (size_t cell = 1; cell < cell_starts_.size(); ++cell)
+        {
+            cell_starts_[cell] += cell_starts_[cell - 1];
+        }
+        std::vector<size_t> insert_positions(cell_starts_.begin(), cell_starts_.end() - 1);
+        elements_.resize(elements.size());
+        for (const auto& element : elements)
+        {
+            elements_[insert_positions[toCellIndex(element.first)]++] = element;
+        }
+    }
+
+    /*! \brief The number of elements the grid was built with. */
+    size_t size() const
+    {
+        return elements_.size();
+    }
+
+    /*! \brief Visit the elements around a point, nearest rings of cells first.
+     *
+     * Elements are visited per ring of cells around \p query_pt. Within a ring they are visited in no particular order, so the visitor must
+     * keep track of the best element itself.
+     *
+     * \param query_pt The point to search around. It doesn't need to be inside the grid.
+     * \param visit Function called with the location and value of each element. It returns the squared distance up to which the search must
+     * continue, typically the squared distance to the best element found so far.
+     */
+    template<typename Visitor>
+    void visitNearest(const Point2LL& query_pt, Visitor&& visit) const
+    {
+        if (elements_.empty())
+        {
+            return;
+        }
+        const coord_t query_column = toGridCoord(query_pt.X - min_.X);
+        const coord_t query_row = toGridCoord(query_pt.Y - min_.Y);
+        // Beyond this ring, no cells of the grid are left.
+        const coord_t last_ring = std::max({ query_column, columns_ - 1 - query_column, query_row, rows_ - 1 - query_row });
+        coord_t search_distance2 = std::numeric_limits<coord_t>::max();
+
+        // Skip the rings that don't overlap with the grid at all.
+        const coord_t first_ring = std::max({ coord_t(0), -query_column, query_column - (columns_ - 1), -query_row, query_row - (rows_ - 1) });
+        for (coord_t ring = first_ring; ring <= last_ring; ++ring)
+        {
+            // Between the query point and the cells of this ring are at least this many whole cells.
+            const coord_t ring_distance = (ring - 1) * cell_size_;
+            if (ring_distance > 0 && ring_distance * ring_distance > search_distance2)
+            {
+                return;
+            }
+            const coord_t min_row = std::max(query_row - ring, coord_t(0));
+            const coord_t max_row = std::min(query_row + ring, rows_ - 1);
+            for (coord_t row = min_row; row <= max_row; ++row)
+            {
+                const bool is_edge_row = row == query_row - ring || row == query_row + ring;
+                // On the top and bottom row of the ring, visit the whole row. Otherwise only the left and right cell.
+                const coord_t column_step = is_edge_row ? 1 : std::max(2 * ring, coord_t(1));
+                for (coord_t column = query_column - ring; column <= query_column + ring; column += column_step)
+                {
+                    if (column < 0 || column >= columns_)
+                    {
+                        continue;
+                    }
+                    const size_t cell = row * columns_ + column;
+                    for (size_t element_idx = cell_starts_[cell]; element_idx < cell_starts_[cell + 1]; ++element_idx)
+                    {
+                        search_distance2 = visit(elements_[element_idx].first, elements_[element_idx].second);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    coord_t toGridCoord(const coord_t offset) const
+    {
+        // Round towards negative infinity, since the query point may lie outside of the grid.
+        return offset >= 0 ? offset / cell_size_ : -((-offset + cell_size_ - 1) / cell_size_);
+    }
+
+    size_t toCellIndex(const Point2LL& location) const
+    {
+        return toGridCoord(location.Y - min_.Y) * columns_ + toGridCoord(location.X - min_.X);
+    }
+
+    Point2LL min_; //!< Lower corner of the grid.
+    coord_t cell_size_ = 1;
+    coord_t columns_ = 0;
+    coord_t rows_ = 0;
+    std::vector<size_t> cell_starts_; //!< For each cell, the index of its first element in \ref elements_. Has an extra entry at the end.
+    std::vector<std::pair<Point2LL, Elem>> elements_; //!< The elements, ordered by cell.
+};
+
+} // namespace cura
+
+#endif // UTILS_RING_SEARCH_GRID_H
@@ -0,0 +1,185 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_SHARDED_CACHE_H
+#define UTILS_SHARDED_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+namespace cura
+{
+
+/*!
+ * \brief Insert-only map that can be read and filled from many threads at once.
+ *
+ * The entries are spread over a fixed number of shards, each with its own reader/writer lock. Lookups only take a shared lock on a single
+ * shard, so threads reading different (or even the same) keys don't serialise on a single mutex the way a map behind one std::mutex would.
+ *
+ * Entries are never erased or overwritten once inserted, and unordered_map keeps references to its values valid when it rehashes. References
+ * handed out by \ref find thus stay valid for the lifetime of the cache.
+ *
+ * If asked to, each shard also counts hits, misses and how often a lock could not be taken right away, to be able to see how well the cache
+ * performs. That costs an atomic increment on a counter shared between threads per access, so by default it is only done when the debug log
+ * that reports the statistics is enabled.
+ */
+template<typename KEY, typename VALUE>
+class ShardedCache
+{
+public:
+    /*!
+     * \brief Access statistics, summed over all shards.
+     */
+    struct Statistics
+    {
+        size_t hits = 0; //!< Lookups that found their key.
+        size_t misses = 0; //!< Lookups that didn't find their key.
+        size_t contended = 0; //!< Number of times a lock of a shard was held by another thread and had to be waited for.
+        size_t size = 0; //!< Number of entries in the cache, which is always known.
+    };
+
+    /*!
+     * \param collect_statistics Whether to count the hits, misses and contended locks. If not, those statistics stay 0.
+     */
+    explicit ShardedCache(const bool collect_statistics = spdlog::should_log(spdlog::level::debug))
+        : shards_(std::make_unique<std::array<Shard, SHARD_COUNT>>())
+        , collect_statistics_(collect_statistics)
+    {
+    }
+
+    /*!
+     * \brief Look up an entry.
+     * \param key The key to look for.
+     * \return A reference to the cached value, or an empty optional if the key isn't in the cache (yet).
+     */
+    std::optional<std::reference_wrapper<const VALUE>> find(const KEY& key) const
+    {
+        Shard& shard = getShard(key);
+        std::shared_lock lock(shard.mutex, std::defer_lock);
+        lockCounted(lock, shard);
+        const auto it = shard.values.find(key);
+        if (it == shard.values.end())
+        {
+            if (collect_statistics_)
+            {
+                shard.misses.fetch_add(1, std::memory_order_relaxed);
+            }
+            return std::nullopt;
+        }
+        if (collect_statistics_)
+        {
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+        }
+        return std::cref(it->second);
+    }
+
+    /*!
+     * \brief Check whether a key is present, without counting it as a lookup.
+     */
+    bool contains(const KEY& key) const
+    {
+        const Shard& shard = getShard(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.values.contains(key);
+    }
+
+    /*!
+     * \brief Insert a single entry. If the key is already present the existing value is kept.
+     */
+    void insert(const KEY& key, VALUE value)
+    {
+        Shard& shard = getShard(key);
+        std::unique_lock lock(shard.mutex, std::defer_lock);
+        lockCounted(lock, shard);
+        shard.values.emplace(key, std::move(value));
+    }
+
+    /*!
+     * \brief Insert a range of (key, value) pairs. Keys that are already present keep their existing value.
+     */
+    template<typename ITERATOR>
+    void insert(ITERATOR begin, const ITERATOR end)
+    {
+        for (; begin != end; ++begin)
+        {
+            insert(begin->first, begin->second);
+        }
+    }
+
+    /*!
+     * \brief Get the access statistics gathered so far.
+     */
+    Statistics getStatistics() const
+    {
+        Statistics result;
+        for (const Shard& shard : *shards_)
+        {
+            result.hits += shard.hits.load(std::memory_order_relaxed);
+            result.misses += shard.misses.load(std::memory_order_relaxed);
+            result.contended += shard.contended.load(std::memory_order_relaxed);
+            std::shared_lock lock(shard.mutex);
+            result.size += shard.values.size();
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 64;
+
+    /*!
+     * \brief One part of the cache, aligned to its own cache line so the locks and counters of different shards don't share one.
+     */
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<KEY, VALUE> values;
+        mutable std::atomic<size_t> hits{ 0 };
+        mutable std::atomic<size_t> misses{ 0 };
+        mutable std::atomic<size_t> contended{ 0 };
+    };
+
+    /*!
+     * \brief Take a lock of a shard, counting whether it had to wait if the statistics are collected.
+     */
+    template<typename LOCK>
+    void lockCounted(LOCK& lock, Shard& shard) const
+    {
+        if (collect_statistics_)
+        {
+            if (lock.try_lock())
+            {
+                return;
+            }
+            shard.contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        lock.lock();
+    }
+
+    Shard& getShard(const KEY& key) const
+    {
+        // The standard hashes of integers are the identity, so mix the bits before picking a shard to spread consecutive layers.
+        const uint64_t mixed = static_cast<uint64_t>(std::hash<KEY>()(key)) * 0x9E3779B97F4A7C15ULL;
+        return (*shards_)[mixed >> 58];
+    }
+
+    /*!
+     * \brief The shards are kept behind a pointer, so that the cache can be moved even though the locks can't.
+     */
+    std::unique_ptr<std::array<Shard, SHARD_COUNT>> shards_;
+
+    bool collect_statistics_;
+};
+
+} // namespace cura
+
+#endif // UTILS_SHARDED_CACHE_H
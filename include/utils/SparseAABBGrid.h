@@ -0,0 +1,146 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_SPARSE_AABB_GRID_H
+#define UTILS_SPARSE_AABB_GRID_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "SparseGrid.h"
+#include "utils/AABB.h"
+
+namespace cura
+{
+
+/*! \brief Sparse grid of axis-aligned bounding boxes, to find the boxes that may hit a given box without checking all of them.
+ *
+ * Every element is stored in each cell that its box overlaps, so boxes should not be much larger than the cells. Elements
+ * can be inserted and erased while the grid is in use, as long as they are erased with the same box as they were inserted.
+ *
+ * \tparam ElemT The element type to store. Must be cheap to copy and comparable, e.g. a pointer to the actual data.
+ */
+template<class ElemT>
+class SparseAABBGrid : public SparseGrid<ElemT>
+{
+public:
+    using Elem = ElemT;
+
+    /*! \brief Constructs a sparse grid with the specified cell size.
+     *
+     * \param[in] cell_size The size to use for a cell (square) in the grid.
+     *    Typical values would be around the size of the boxes to insert.
+     * \param[in] elem_reserve Number of elements to reserve space for.
+     * \param[in] max_load_factor Maximum average load factor before rehashing.
+     */
+    SparseAABBGrid(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 1.0);
+
+    /*! \brief Inserts \p elem in all cells overlapping \p aabb. Nothing is inserted for an empty box, as it can't hit anything.
+     */
+    void insert(const Elem& elem, const AABB& aabb);
+
+    /*! \brief Removes \p elem, which was inserted with \p aabb, from the grid.
+     */
+    void erase(const Elem& elem, const AABB& aabb);
+
+    /*! \brief Returns all elements in the cells overlapping \p aabb, each only once and sorted.
+     *
+     * This includes all elements of which the box hits \p aabb, but may include elements of which the box doesn't.
+     */
+    std::vector<Elem> getNearby(const AABB& aabb) const;
+
+protected:
+    using GridPoint = typename SparseGrid<ElemT>::GridPoint;
+
+    /*! \brief Process the cells overlapping \p aabb, if it is not empty.
+     */
+    void processCells(const AABB& aabb, const std::function<void(const GridPoint&)>& process_cell_func) const;
+};
+
+
+#define SGI_TEMPLATE template<class ElemT>
+#define SGI_THIS SparseAABBGrid<ElemT>
+
+SGI_TEMPLATE
+SGI_THIS::SparseAABBGrid(coord_t cell_size, size_t elem_reserve, double max_load_factor)
+    : SparseGrid<ElemT>(cell_size, elem_reserve, max_load_factor)
+{
+}
+
+SGI_TEMPLATE
+void SGI_THIS::processCells(const AABB& aabb, const std::function<void(const GridPoint&)>& process_cell_func) const
+{
+    if (aabb.min_.X > aabb.max_.X || aabb.min_.Y > aabb.max_.Y)
+    {
+        return;
+    }
+    const GridPoint min_cell = SparseGrid<ElemT>::toGridPoint(aabb.min_);
+    const GridPoint max_cell = SparseGrid<ElemT>::toGridPoint(aabb.max_);
+    for (coord_t grid_y = min_cell.Y; grid_y <= max_cell.Y; ++grid_y)
+    {
+        for (coord_t grid_x = min_cell.X; grid_x <= max_cell.X; ++grid_x)
+        {
+            process_cell_func(GridPoint(grid_x, grid_y));
+        }
+    }
+}
+
+SGI_TEMPLATE
+void SGI_THIS::insert(const Elem& elem, const AABB& aabb)
+{
+    processCells(
+        aabb,
+        [&elem, this](const GridPoint& grid_pt)
+        {
+            SparseGrid<ElemT>::grid_.emplace(grid_pt, elem);
+        });
+}
+
+SGI_TEMPLATE
+void SGI_THIS::erase(const Elem& elem, const AABB& aabb)
+{
+    processCells(
+        aabb,
+        [&elem, this](const GridPoint& grid_pt)
+        {
+            auto [first, last] = SparseGrid<ElemT>::grid_.equal_range(grid_pt);
+            for (auto iter = first; iter != last; ++iter)
+            {
+                if (iter->second == elem)
+                {
+                    SparseGrid<ElemT>::grid_.erase(iter);
+                    return;
+                }
+            }
+        });
+}
+
+SGI_TEMPLATE
+std::vector<typename SGI_THIS::Elem> SGI_THIS::getNearby(const AABB& aabb) const
+{
+    std::vector<Elem> ret;
+    processCells(
+        aabb,
+        [&ret, this](const GridPoint& grid_pt)
+        {
+            SparseGrid<ElemT>::processFromCell(
+                grid_pt,
+                [&ret](const Elem& elem)
+                {
+                    ret.push_back(elem);
+                    return true;
+                });
+        });
+    // Boxes spanning several cells are found once per cell.
+    std::sort(ret.begin(), ret.end(), std::less<Elem>());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    return ret;
+}
+
+#undef SGI_TEMPLATE
+#undef SGI_THIS
+
+} // namespace cura
+
+#endif // UTILS_SPARSE_AABB_GRID_H
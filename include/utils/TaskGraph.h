@@ -0,0 +1,126 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_TASK_GRAPH_H
+#define UTILS_TASK_GRAPH_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/ThreadPool.h"
+
+namespace cura
+{
+
+/*!
+ * \brief Runs tasks on the thread pool as soon as the tasks that they depend on are done.
+ *
+ * Unlike a sequence of `parallel_for()` loops, there is no barrier between the steps of a computation: e.g. the skin of a
+ * layer can be computed as soon as the walls of the layers around it are done, while the walls of other layers are
+ * still being computed.
+ *
+ * The graph is built first, with addTask() and addDependency(), and then run once. When tracing, the names and the start
+ * and end times of the tasks are recorded, so that the overlap between them can be inspected with writeTrace().
+ */
+class TaskGraph
+{
+public:
+    using task_id_t = size_t;
+
+    /*!
+     * \param trace Whether to record the names and times of the tasks, for writeTrace().
+     */
+    explicit TaskGraph(const bool trace = false)
+        : trace_(trace)
+    {
+    }
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /*!
+     * \brief Add a task, which runs once all tasks that it depends on are done.
+     *
+     * \param name What the task does, for the trace. Use traceName() to only build it when tracing.
+     * \param work The work to do. It may use `parallel_for()`, but must not wait for other tasks of the graph.
+     * \return The id of the task, to add dependencies with.
+     */
+    task_id_t addTask(std::string name, std::function<void()> work);
+
+    /*!
+     * \brief Make sure that \p after only starts once \p before is done.
+     *
+     * The dependencies must not form a cycle.
+     */
+    void addDependency(task_id_t before, task_id_t after);
+
+    /*!
+     * \brief Format the name of a task, or get an empty name if the graph isn't traced.
+     */
+    template<typename... Args>
+    std::string traceName(fmt::format_string<Args...> format, Args&&... args) const
+    {
+        if (! trace_)
+        {
+            return {};
+        }
+        return fmt::format(format, std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Run all tasks on the thread pool, the calling thread included, and wait until all of them are done.
+     */
+    void run(ThreadPool& thread_pool);
+
+    /*!
+     * \brief Write the timeline of the last run in the Trace Event Format, which can be viewed in e.g. chrome://tracing or Perfetto.
+     *
+     * Every task is a slice on the row of the thread that ran it, so idle threads show up as gaps. The graph must have
+     * been made for tracing.
+     */
+    void writeTrace(const std::filesystem::path& path) const;
+
+    size_t size() const
+    {
+        return tasks_.size();
+    }
+
+private:
+    struct Task
+    {
+        std::string name_;
+        std::function<void()> work_;
+        std::vector<task_id_t> successors_;
+        size_t predecessor_count_{ 0 };
+
+        // Recorded while running, when tracing
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::steady_clock::time_point end_;
+        std::thread::id thread_;
+    };
+
+    bool trace_;
+    std::vector<Task> tasks_;
+
+    // State of a run
+    ThreadPool* thread_pool_{ nullptr };
+    std::vector<ThreadPool::Task> pool_tasks_; //!< Per task, what is pushed to the thread pool once it is ready to run
+    std::unique_ptr<std::atomic<size_t>[]> pending_predecessors_;
+    std::atomic<size_t> remaining_tasks_{ 0 };
+    std::chrono::steady_clock::time_point run_start_;
+
+    void runTask(task_id_t task_id);
+};
+
+} // namespace cura
+
+#endif // UTILS_TASK_GRAPH_H
@@ -4,32 +4,158 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
-#include <functional> // std::function<>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
+#include <span>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../Application.h" // accessing singleton's Application::thread_pool
 #include "../utils/math.h" // round_up_divide
+#include "WorkStealingDeque.h"
 
 namespace cura
 {
 
 /*!
- * \brief Very minimal and low level thread pool.
+ * \brief Very minimal and low level work-stealing thread pool.
  *
  * Consider using `parallel_for()` instead, interfacing directly with this class should be reserved to concurrency primitives.
- * ThreadPool can be described as a synchronized FIFO queue shared by a fleet of `std::thread`s.
- * Tasks have the responsibility of unlocking the queue's lock passed as an argument while they do asynchronous work.
+ *
+ * Every worker thread owns a lock-free deque of tasks. Tasks pushed by a worker go to the bottom of its own deque, and
+ * the worker runs them itself from the bottom, while idle workers steal from the top of the deques of the others. The
+ * first other thread that pushes tasks (normally the main thread) gets a deque of its own as well, tasks of any further
+ * threads are shared through a locked queue.
+ *
+ * Tasks are not owned by the pool: the code that pushes a task has to keep it alive and wait until it has been run,
+ * normally with work_until_done(). A thread that waits runs pending tasks in the meantime, so tasks may push and wait
+ * for tasks of their own (e.g. a nested `parallel_for()`) without deadlocking, as long as they don't block otherwise.
+ * Tasks that do block, e.g. to wait for each other, have to be pushed with push_long_running().
  */
 class ThreadPool
 {
 public:
-    using lock_t = std::unique_lock<std::mutex>;
-    using task_t = std::function<void(lock_t&)>;
+    /*!
+     * \brief A closure to run on the thread pool, without allocating memory for small closures.
+     *
+     * Closures of up to \ref inline_size bytes are stored inside of the task, larger ones on the heap.
+     * A task must not be moved anymore once it has been pushed to the pool.
+     */
+    class Task
+    {
+    public:
+        static constexpr size_t inline_size = 6 * sizeof(void*);
+
+        template<typename F>
+            requires(! std::is_same_v<std::decay_t<F>, Task>)
+        explicit Task(F&& func)
+        {
+            using closure_t = std::decay_t<F>;
+            if constexpr (sizeof(closure_t) <= inline_size && alignof(closure_t) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<closure_t>)
+            {
+                ::new (storage_) closure_t(std::forward<F>(func));
+                operations_ = &inline_operations<closure_t>;
+            }
+            else
+            {
+                ::new (storage_) closure_t*(new closure_t(std::forward<F>(func)));
+                operations_ = &heap_operations<closure_t>;
+            }
+        }
+
+        Task(Task&& other) noexcept
+            : operations_(std::exchange(other.operations_, nullptr))
+        {
+            if (operations_)
+            {
+                operations_->move(other.storage_, storage_);
+            }
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task& operator=(Task&&) = delete;
+
+        ~Task()
+        {
+            if (operations_)
+            {
+                operations_->destroy(storage_);
+            }
+        }
+
+        void operator()()
+        {
+            operations_->invoke(storage_);
+        }
+
+    private:
+        struct Operations
+        {
+            void (*invoke)(void* storage);
+            void (*move)(void* from, void* to); //!< Moves the closure to uninitialized storage and destroys the original
+            void (*destroy)(void* storage);
+        };
+
+        template<typename C>
+        static void invokeInline(void* storage)
+        {
+            (*std::launder(static_cast<C*>(storage)))();
+        }
+
+        template<typename C>
+        static void moveInline(void* from, void* to)
+        {
+            C* closure = std::launder(static_cast<C*>(from));
+            ::new (to) C(std::move(*closure));
+            closure->~C();
+        }
+
+        template<typename C>
+        static void destroyInline(void* storage)
+        {
+            std::launder(static_cast<C*>(storage))->~C();
+        }
+
+        template<typename C>
+        static void invokeOnHeap(void* storage)
+        {
+            (**std::launder(static_cast<C**>(storage)))();
+        }
+
+        template<typename C>
+        static void moveOnHeap(void* from, void* to)
+        {
+            ::new (to) C*(*std::launder(static_cast<C**>(from)));
+        }
+
+        template<typename C>
+        static void destroyOnHeap(void* storage)
+        {
+            delete *std::launder(static_cast<C**>(storage));
+        }
+
+        template<typename C>
+        static constexpr Operations inline_operations{ &invokeInline<C>, &moveInline<C>, &destroyInline<C> };
+
+        template<typename C>
+        static constexpr Operations heap_operations{ &invokeOnHeap<C>, &moveOnHeap<C>, &destroyOnHeap<C> };
+
+        const Operations* operations_;
+        alignas(std::max_align_t) std::byte storage_[inline_size];
+    };
+
+    using task_t = Task;
 
     //! Spawns a thread pool with `nthreads` threads
     ThreadPool(size_t nthreads);
@@ -42,56 +168,73 @@ public:
     //! Returns the number of threads
     size_t thread_count() const
     {
-        return threads.size();
+        return threads_.size();
     }
 
-    //! Gets a lock on the queue, stopping the queuing or execution of new tasks while held
-    lock_t get_lock()
-    {
-        return lock_t(mutex);
-    }
+    /*!
+     * \brief Pushes tasks that don't block, so that they can run on any thread.
+     *
+     * The tasks must stay alive until they have been run, see work_until_done().
+     */
+    void push(std::span<Task> tasks);
 
     /*!
-     * \brief Pushes a new task while the queue is locked.
-     * \param func Closure that unlocks the local worker's lock passed as an argument while
-     * doing asynchronous work.
+     * \brief Pushes tasks that may block to wait for each other, or for other threads.
+     *
+     * These tasks are only started by idle workers, never by threads that run pending tasks while they are waiting in
+     * work_until_done(), since such a thread could then wait on itself.
      */
-    template<typename F>
-    void push(const lock_t& lock [[maybe_unused]], F&& func)
-    {
-        assert(lock);
-        tasks.push_back(std::forward<F>(func));
-        condition.notify_one();
-    }
+    void push_long_running(std::span<Task> tasks);
+
     /*!
-     * \brief Executes pending tasks while the predicates returns true
-     * This method doesn't wait unless predicate does (like implementation of ThreadPool::worker())
+     * \brief Runs pending tasks on the calling thread until \p remaining becomes zero, sleeping when there are none.
+     *
+     * \param remaining Counts the tasks to wait for. The task that decrements it to zero has to call notify_done() after.
      */
-    template<typename P>
-    void work_while(lock_t& lock, P predicate)
-    {
-        assert(lock);
-        while (predicate() && ! tasks.empty()) // Order is important: predicate() might wait on an empty queue
-        {
-            assert(! tasks.empty());
-            task_t task = std::move(tasks.front());
-            tasks.pop_front();
+    void work_until_done(const std::atomic<size_t>& remaining);
 
-            task(lock);
-            assert(lock);
-        }
-    }
+    /*!
+     * \brief Wakes up the threads that are waiting in work_until_done(), to check whether their tasks are done.
+     */
+    void notify_done();
 
 private:
-    void worker();
+    //! A queue of tasks that is shared between threads by locking it
+    struct LockedQueue
+    {
+        std::mutex mutex;
+        std::deque<Task*> tasks;
+        std::atomic<size_t> size{ 0 }; //!< To avoid locking an empty queue
+
+        void push(std::span<Task> new_tasks);
+        Task* pop();
+    };
+
+    const uint64_t pool_id_; //!< Unique per constructed pool, to recognize the threads that own a deque of this pool
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> deques_; //!< One per worker thread, plus one for the first other thread that pushes tasks
+    std::atomic<bool> external_deque_claimed_{ false };
+    LockedQueue shared_tasks_; //!< Tasks pushed by other threads than the owners of a deque
+    LockedQueue long_running_tasks_;
+
+    std::atomic<uint64_t> new_tasks_epoch_{ 0 }; //!< Incremented when tasks are pushed, idle workers sleep on it
+    std::atomic<size_t> sleeping_workers_{ 0 };
+    std::atomic<uint64_t> done_epoch_{ 0 }; //!< Incremented by notify_done(), waiting threads sleep on it
+    std::atomic<size_t> sleeping_waiters_{ 0 };
+    std::atomic<bool> stop_{ false };
+
+    void worker(size_t deque_idx);
 
     void join();
 
-    std::mutex mutex;
-    std::condition_variable condition;
-    std::deque<task_t> tasks;
-    std::vector<std::thread> threads;
-    bool wait_for_new_tasks;
+    //! Gets the index of the deque of the calling thread, if it has one
+    std::optional<size_t> ownDequeIndex();
+
+    //! Finds a pending task for the calling thread, or nullptr if there is none
+    Task* findTask(std::optional<size_t> own_deque_idx, bool include_long_running);
+
+    //! Wakes up idle workers after tasks have been pushed
+    void notifyNewTasks(size_t task_count);
 };
 
 
@@ -122,8 +265,6 @@ inline Signed distance(const Int& first, const Int& last)
 template<typename T, typename F>
 void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1, const size_t chunks_per_worker = 8)
 {
-    using lock_t = ThreadPool::lock_t;
-
     // Computes the number of items (early out if needed)
     const auto dist = distance(first, last);
     if (dist <= 0)
@@ -155,16 +296,25 @@ void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1,
     assert(chunks * chunk_size >= nitems && (chunks - 1) * chunk_size < nitems);
     assert(chunks <= chunks_per_worker * nworkers && chunks <= blocks);
 
+    if (chunks == 1 || thread_pool->thread_count() == 0)
+    { // Not worth scheduling, also keeps small nested loops on the thread that runs their parent task
+        for (T i = first; i < last; ++i)
+        {
+            loop_body(i);
+        }
+        return;
+    }
+
     // Packs state variables such that they can be referenced by the task closure through a single reference
     struct
     {
         std::decay_t<F> loop_body; // User's closure data
-        size_t chunks_remaining;
-        std::condition_variable work_done = {};
+        std::atomic<size_t> chunks_remaining;
     } shared_state = { std::forward<F>(loop_body), chunks };
 
-    // Schedules a task per chunk on the thread pool
-    lock_t lock = thread_pool->get_lock();
+    // Makes a task per chunk
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(chunks);
     T chunk_last;
     for (T chunk_first = first; chunk_first < last; chunk_first = chunk_last)
     {
@@ -177,34 +327,26 @@ void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1,
             chunk_last = last;
         }
 
-        thread_pool->push(
-            lock,
-            [&shared_state, chunk_first, chunk_last](lock_t& th_lock)
+        tasks.emplace_back(
+            [thread_pool, &shared_state, chunk_first, chunk_last]()
             {
-                th_lock.unlock(); // Enter unsynchronized region
                 for (T i = chunk_first; i < chunk_last; ++i)
                 {
                     shared_state.loop_body(i);
                 }
-                th_lock.lock();
-                if (--shared_state.chunks_remaining == 0)
+                // Neither shared_state nor this closure may be touched after the decrement: the waiting thread may see zero and return,
+                // destroying both. So the pool to notify is copied to the stack first.
+                ThreadPool* const pool = thread_pool;
+                if (shared_state.chunks_remaining.fetch_sub(1) == 1)
                 {
-                    shared_state.work_done.notify_one();
+                    pool->notify_done();
                 }
             });
     }
 
-    // Do work while parallel_for's tasks are running
-    thread_pool->work_while(
-        lock,
-        [&]
-        {
-            return shared_state.chunks_remaining > 0;
-        });
-    while (shared_state.chunks_remaining > 0) // Wait until all the task are completed
-    {
-        shared_state.work_done.wait(lock);
-    }
+    // Schedules the tasks, then runs them (or other pending tasks) until all chunks are done
+    thread_pool->push(tasks);
+    thread_pool->work_until_done(shared_state.chunks_remaining);
 }
 
 /*!
@@ -254,7 +396,7 @@ template<typename Producer, typename Consumer>
 class MultipleProducersOrderedConsumer
 {
     using item_t = std::invoke_result_t<Producer, ptrdiff_t>;
-    using lock_t = ThreadPool::lock_t;
+    using lock_t = std::unique_lock<std::mutex>;
 
 public:
     /*!
@@ -282,21 +424,24 @@ public:
             return;
         }
         workers_count_ = thread_pool.thread_count() + 1;
-        // Start thread_pool.thread_count() workers on the thread pool
-        auto lock = thread_pool.get_lock();
+        // Start thread_pool.thread_count() workers on the thread pool. They wait for free slots and for each other, so they must not be run inline by a waiting thread.
+        std::vector<ThreadPool::Task> tasks;
+        tasks.reserve(workers_count_ - 1);
         for (size_t i = 1; i < workers_count_; i++)
         {
-            thread_pool.push(
-                lock,
-                [this](lock_t& th_lock)
+            tasks.emplace_back(
+                [this]()
                 {
+                    lock_t th_lock(mutex_);
                     worker(th_lock);
                 });
         }
+        thread_pool.push_long_running(tasks);
         // Run a worker on the main thread
+        lock_t lock(mutex_);
         worker(lock);
         // Wait for completion of all workers
-        if (workers_count_ > 0)
+        while (workers_count_ > 0)
         {
             work_done_cond_.wait(lock);
         }
@@ -330,7 +475,7 @@ protected:
         item_t* slot = &queue_[(produced_idx + max_pending_) % max_pending_];
         assert(produced_idx < last_idx_);
 
-        // Unlocks global mutex while producing an item
+        // Unlocks mutex while producing an item
         lock.unlock();
         item_t item = producer_(produced_idx);
         lock.lock();
@@ -348,7 +493,7 @@ protected:
         assert(read_idx_ < write_idx_);
         for (item_t* slot = &queue_[(read_idx_ + max_pending_) % max_pending_]; *slot; slot = &queue_[(read_idx_ + max_pending_) % max_pending_])
         {
-            // Unlocks global mutex while consuming an item
+            // Unlocks mutex while consuming an item
             lock.unlock();
             consumer_(std::move(*slot));
             *slot = {};
@@ -388,6 +533,8 @@ protected:
         }
     }
 
+    std::mutex mutex_; // Guards all state below, except while producing or consuming an item
+
     // Tracks worker completion
     size_t workers_count_;
     std::condition_variable work_done_cond_;
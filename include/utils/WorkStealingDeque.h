@@ -0,0 +1,176 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_WORK_STEALING_DEQUE_H
+#define UTILS_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * \brief Lock-free deque of pointers, of which one thread owns the bottom and any thread can steal from the top.
+ *
+ * This is the deque of Chase and Lev, with the memory orderings of Lê et al., "Correct and Efficient Work-Stealing for
+ * Weak Memory Models" (2013). The owner pushes and pops at the bottom like a stack, so it keeps working on the most
+ * recent (and cache-warm) items, while other threads steal the oldest items from the top.
+ *
+ * The storage grows when it is full. Older storage is kept until the deque is destroyed, since a thief may still be
+ * reading from it.
+ *
+ * \warning Only the owning thread may call push() and pop().
+ *
+ * \tparam T The type of the items, which are pointers. A nullptr means that no item could be taken.
+ */
+template<typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_pointer_v<T>, "Items must be pointers, so that they can be stored atomically.");
+
+    struct Array
+    {
+        const int64_t capacity_; //!< Always a power of two
+        const std::unique_ptr<std::atomic<T>[]> items_;
+
+        explicit Array(const int64_t capacity)
+            : capacity_(capacity)
+            , items_(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)))
+        {
+        }
+
+        T get(const int64_t idx) const
+        {
+            return items_[idx & (capacity_ - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(const int64_t idx, const T item)
+        {
+            items_[idx & (capacity_ - 1)].store(item, std::memory_order_relaxed);
+        }
+    };
+
+public:
+    /*!
+     * \param capacity The initial number of items that fit in the deque. Rounded up to a power of two.
+     */
+    explicit WorkStealingDeque(const size_t capacity = 256)
+    {
+        int64_t rounded_capacity = 1;
+        while (rounded_capacity < static_cast<int64_t>(capacity))
+        {
+            rounded_capacity *= 2;
+        }
+        arrays_.push_back(std::make_unique<Array>(rounded_capacity));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /*!
+     * \brief Add an item at the bottom. Only for the owner.
+     */
+    void push(const T item)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Array* array = array_.load(std::memory_order_relaxed);
+        if (bottom - top > array->capacity_ - 1)
+        {
+            array = grow(array, top, bottom);
+        }
+        array->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release); // Publishes the item to the thieves
+    }
+
+    /*!
+     * \brief Take the most recently pushed item. Only for the owner.
+     * \return The item, or nullptr if the deque is empty.
+     */
+    T pop()
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* array = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        T item = nullptr;
+        if (top <= bottom)
+        {
+            item = array->get(bottom);
+            if (top == bottom)
+            { // This is the last item, race the thieves for it
+                if (! top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /*!
+     * \brief Take the oldest item. Safe to call from any thread.
+     * \return The item, or nullptr if the deque is empty or another thread took the item first.
+     */
+    T steal()
+    {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+        const Array* array = array_.load(std::memory_order_acquire);
+        T item = array->get(top);
+        if (! top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /*!
+     * \brief Whether there seem to be no items. Only a hint when other threads are using the deque.
+     */
+    bool empty() const
+    {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top_{ 0 }; //!< Index of the oldest item, advanced by thieves (and by the owner for the last item)
+    alignas(64) std::atomic<int64_t> bottom_{ 0 }; //!< Index after the newest item, only written by the owner
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_; //!< All storage that was ever used, only accessed by the owner
+
+    Array* grow(const Array* array, const int64_t top, const int64_t bottom)
+    {
+        auto bigger = std::make_unique<Array>(array->capacity_ * 2);
+        for (int64_t idx = top; idx < bottom; idx++)
+        {
+            bigger->put(idx, array->get(idx));
+        }
+        arrays_.push_back(std::move(bigger));
+        Array* result = arrays_.back().get();
+        array_.store(result, std::memory_order_release);
+        return result;
+    }
+};
+
+} // namespace cura
+
+#endif // UTILS_WORK_STEALING_DEQUE_H
@@ -5,14 +5,14 @@
 #define UTILS_STRING_H
 
 #include <cmath>
-#include <cstdio> // snprintf
 #include <ctype.h>
+#include <iterator>
 #include <sstream> // ostringstream
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/ostream_iterator.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
-#include <spdlog/spdlog.h>
+#include <fmt/format.h>
 
 namespace cura
 {
@@ -61,68 +61,50 @@ static inline int stringcasecompare(const char* a, const char* b)
  * However, half the integer type should suffice, because we made the basic coord_t twice as big as necessary
  * so as to support multiplication within the same integer type.
  *
+ * The number is formatted with integer arithmetic from the back to the front of a small buffer, writing only the
+ * significant decimals, so that the stream only has to copy the result.
+ *
  * \param coord The micron unit to convert
  * \param ss The output stream to write the string to
  */
 static inline void writeInt2mm(const int32_t coord, std::ostream& ss)
 {
-    constexpr size_t buffer_size = 24;
+    constexpr size_t buffer_size = 16; // "-2147483.648" is the longest possible result
     char buffer[buffer_size];
-    int char_count
-        = snprintf(buffer, buffer_size, "%d", coord); // we haven't found any way for the windows compiler to accept formatting of a coord_t, so it has to be int32_t instead
-#ifdef DEBUG
-    if (char_count + 1 >= int(buffer_size)) // + 1 for the null character
-    {
-        spdlog::error("Cannot write {} to buffer of size {}", coord, buffer_size);
-    }
-    if (char_count < 0)
-    {
-        spdlog::error("Encoding error while writing {}", coord);
-    }
-#endif // DEBUG
-    int end_pos = char_count; // the first character not to write any more
-    int trailing_zeros = 1;
-    while (trailing_zeros < 4 && buffer[char_count - trailing_zeros] == '0')
+    char* const end = buffer + buffer_size;
+    char* start = end;
+
+    const uint32_t magnitude = coord < 0 ? 0u - static_cast<uint32_t>(coord) : static_cast<uint32_t>(coord);
+    uint32_t integer_part = magnitude / 1000;
+    uint32_t decimals = magnitude % 1000;
+    if (decimals != 0)
     {
-        trailing_zeros++;
-    }
-    trailing_zeros--;
-    end_pos = char_count - trailing_zeros;
-    if (trailing_zeros == 3)
-    { // no need to write the decimal dot
-        buffer[char_count - trailing_zeros] = '\0';
-        ss << buffer;
-        return;
+        int decimal_count = 3;
+        while (decimals % 10 == 0)
+        { // strip the trailing zeros
+            decimals /= 10;
+            decimal_count--;
+        }
+        for (; decimal_count > 0; decimal_count--)
+        {
+            *--start = static_cast<char>('0' + decimals % 10);
+            decimals /= 10;
+        }
+        *--start = '.';
     }
-    if (char_count <= 3)
+    if (integer_part != 0 || coord >= 0 || magnitude < 100) // negative numbers down to -0.1 have always been written without their leading zero, like "-.5"
     {
-        int start = 0; // where to start writing from the buffer
-        if (coord < 0)
+        do
         {
-            ss << '-';
-            start = 1;
-        }
-        ss << "0.";
-        for (int nulls = char_count - start; nulls < 3; nulls++)
-        { // fill up to 3 decimals with zeros
-            ss << '0';
-        }
-        buffer[char_count - trailing_zeros] = '\0';
-        ss << (static_cast<char*>(buffer) + start);
+            *--start = static_cast<char>('0' + integer_part % 10);
+            integer_part /= 10;
+        } while (integer_part != 0);
     }
-    else
+    if (coord < 0)
     {
-        char prev = '.';
-        int pos;
-        for (pos = char_count - 3; pos <= end_pos; pos++)
-        { // shift all characters and insert the decimal dot
-            char next_prev = buffer[pos];
-            buffer[pos] = prev;
-            prev = next_prev;
-        }
-        buffer[pos] = '\0';
-        ss << buffer;
+        *--start = '-';
     }
+    ss.write(start, end - start);
 }
 
 /*!
@@ -144,7 +126,7 @@ struct MMtoStream
  *
  * writes with \p precision digits after the decimal dot, but removes trailing zeros
  *
- * \warning only works with precision up to 9 and input up to 10^14
+ * \warning only works with precision up to 9
  *
  * \param precision The number of (non-zero) digits after the decimal dot
  * \param coord double to output
@@ -152,42 +134,21 @@ struct MMtoStream
  */
 static inline void writeDoubleToStream(const uint8_t precision, const double coord, std::ostream& ss)
 {
-    char format[5] = "%.xF"; // write a float with [x] digits after the dot
-    format[2] = '0' + static_cast<char>(precision); // set [x]
-    constexpr size_t buffer_size = 400;
-    char buffer[buffer_size];
-    int char_count = snprintf(buffer, buffer_size, format, coord);
-#ifdef DEBUG
-    if (char_count + 1 >= int(buffer_size)) // + 1 for the null character
+    fmt::memory_buffer buffer; // Large enough for all finite doubles, without allocating
+    fmt::format_to(std::back_inserter(buffer), "{:.{}F}", coord, precision);
+    size_t char_count = buffer.size();
+    if (char_count > precision && buffer[char_count - precision - 1] == '.')
     {
-        spdlog::error("Cannot write {} to buffer of size {}", coord, buffer_size);
-    }
-    if (char_count < 0)
-    {
-        spdlog::error("Encoding error while writing {}", coord);
-    }
-#endif // DEBUG
-    if (char_count <= 0)
-    {
-        return;
-    }
-    if (buffer[char_count - precision - 1] == '.')
-    {
-        int non_nul_pos = char_count - 1;
-        while (buffer[non_nul_pos] == '0')
-        {
-            non_nul_pos--;
-        }
-        if (buffer[non_nul_pos] == '.')
+        while (buffer[char_count - 1] == '0')
         {
-            buffer[non_nul_pos] = '\0';
+            char_count--;
         }
-        else
+        if (buffer[char_count - 1] == '.')
         {
-            buffer[non_nul_pos + 1] = '\0';
+            char_count--;
         }
     }
-    ss << buffer;
+    ss.write(buffer.data(), static_cast<std::streamsize>(char_count));
 }
 
 /*!
@@ -21,6 +21,7 @@
 #include "Slice.h"
 #include "communication/ArcusCommunication.h" //To connect via Arcus to the front-end.
 #include "communication/CommandLine.h" //To use the command line to slice stuff.
+#include "communication/CommandLineServer.h" //To keep slicing command lines from stdin.
 #include "communication/EmscriptenCommunication.h" // To use Emscripten to slice stuff.
 #include "progress/Progress.h"
 #include "utils/ThreadPool.h"
@@ -143,6 +144,11 @@ void Application::printHelp() const
     fmt::print("  --next\n\tGenerate gcode for the previously supplied mesh group and append that to \n\tthe gcode of further models for one-at-a-time printing.\n");
     fmt::print("  -o <output_file>\n\tSpecify a file to which to write the generated gcode.\n");
     fmt::print("\n");
+    fmt::print("CuraEngine serve [-v] [-m<thread_count>]\n");
+    fmt::print("  Keep running and slice every line read from stdin, which holds the same arguments as the slice command.\n\tArguments with spaces can be put in "
+               "double quotes. Stop with the line \"quit\". After each slice \"done\" is written to stderr.\n\tDefinition files and models are only loaded again "
+               "when they change, and the previous slice is reused when only its start or end g-code changes.\n");
+    fmt::print("\n");
     fmt::print("The settings are appended to the last supplied object:\n");
     fmt::print("CuraEngine slice [general settings] \n\t-g [current group settings] \n\t-e0 [extruder train 0 settings] \n\t-l obj_inheriting_from_last_extruder_train.stl [object "
                "settings] \n\t--next [next group settings]\n\t... etc.\n");
@@ -225,6 +231,30 @@ void Application::slice()
 #endif
 }
 
+void Application::serve()
+{
+    for (size_t argument_index = 2; argument_index < argc_; argument_index++)
+    {
+        const std::string argument(argv_[argument_index]);
+        if (argument == "-v")
+        {
+            spdlog::set_level(spdlog::level::debug);
+        }
+        else if (argument.starts_with("-m"))
+        {
+            startThreadPool(std::stoi(argument.substr(2)));
+        }
+        else
+        {
+            spdlog::error("Unknown option: {}", argument);
+            printCall();
+            printHelp();
+            exit(1);
+        }
+    }
+    communication_ = std::make_shared<CommandLineServer>();
+}
+
 void Application::run(const size_t argc, char** argv)
 {
     argc_ = argc;
@@ -251,6 +281,12 @@ void Application::run(const size_t argc, char** argv)
         {
             slice();
         }
+#ifndef __EMSCRIPTEN__
+        else if (stringcasecompare(argv[1], "serve") == 0)
+        {
+            serve();
+        }
+#endif
         else if (stringcasecompare(argv[1], "help") == 0)
         {
             printHelp();
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "BeadingStrategy/MemoizedBeadingStrategy.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace cura
+{
+
+double MemoizedBeadingStrategy::Statistics::hitRate() const
+{
+    const size_t hits = compute_hits + bead_count_hits;
+    const size_t calls = hits + compute_misses + bead_count_misses;
+    return calls == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(calls);
+}
+
+MemoizedBeadingStrategy::MemoizedBeadingStrategy(BeadingStrategyPtr parent, const size_t slot_count)
+    : BeadingStrategy(*parent)
+    , parent_(std::move(parent))
+    , slot_shift_(64 - std::countr_zero(std::bit_ceil(std::max(slot_count, size_t(2)))))
+    , beading_slots_(std::bit_ceil(std::max(slot_count, size_t(2))))
+    , bead_count_slots_(beading_slots_.size())
+{
+    name_ = "MemoizedBeadingStrategy";
+}
+
+size_t MemoizedBeadingStrategy::getSlotIndex(const coord_t thickness, const coord_t bead_count) const
+{
+    // Fibonacci hashing: the multiplication spreads the bits of nearby thicknesses over the high bits of the hash.
+    const uint64_t key = static_cast<uint64_t>(thickness) ^ (static_cast<uint64_t>(bead_count) << 48);
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> slot_shift_);
+}
+
+BeadingStrategy::Beading MemoizedBeadingStrategy::compute(coord_t thickness, coord_t bead_count) const
+{
+    BeadingSlot& slot = beading_slots_[getSlotIndex(thickness, bead_count)];
+    if (slot.is_used && slot.thickness == thickness && slot.bead_count == bead_count)
+    {
+        statistics_.compute_hits++;
+        return slot.beading;
+    }
+    statistics_.compute_misses++;
+    slot.beading = parent_->compute(thickness, bead_count);
+    slot.thickness = thickness;
+    slot.bead_count = bead_count;
+    slot.is_used = true;
+    return slot.beading;
+}
+
+coord_t MemoizedBeadingStrategy::getOptimalThickness(coord_t bead_count) const
+{
+    return parent_->getOptimalThickness(bead_count);
+}
+
+coord_t MemoizedBeadingStrategy::getTransitionThickness(coord_t lower_bead_count) const
+{
+    return parent_->getTransitionThickness(lower_bead_count);
+}
+
+coord_t MemoizedBeadingStrategy::getOptimalBeadCount(coord_t thickness) const
+{
+    BeadCountSlot& slot = bead_count_slots_[getSlotIndex(thickness, -1)];
+    if (slot.is_used && slot.thickness == thickness)
+    {
+        statistics_.bead_count_hits++;
+        return slot.bead_count;
+    }
+    statistics_.bead_count_misses++;
+    slot.bead_count = parent_->getOptimalBeadCount(thickness);
+    slot.thickness = thickness;
+    slot.is_used = true;
+    return slot.bead_count;
+}
+
+coord_t MemoizedBeadingStrategy::getTransitioningLength(coord_t lower_bead_count) const
+{
+    return parent_->getTransitioningLength(lower_bead_count);
+}
+
+double MemoizedBeadingStrategy::getTransitionAnchorPos(coord_t lower_bead_count) const
+{
+    return parent_->getTransitionAnchorPos(lower_bead_count);
+}
+
+std::vector<coord_t> MemoizedBeadingStrategy::getNonlinearThicknesses(coord_t lower_bead_count) const
+{
+    return parent_->getNonlinearThicknesses(lower_bead_count);
+}
+
+std::string MemoizedBeadingStrategy::toString() const
+{
+    return std::string("MemoizedBeadingStrategy+") + parent_->toString();
+}
+
+const MemoizedBeadingStrategy::Statistics& MemoizedBeadingStrategy::getStatistics() const
+{
+    return statistics_;
+}
+
+} // namespace cura
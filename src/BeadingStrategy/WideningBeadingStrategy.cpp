@@ -29,6 +29,7 @@ WideningBeadingStrategy::Beading WideningBeadingStrategy::compute(coord_t thickn
         {
             ret.bead_widths.emplace_back(std::max(thickness, min_output_width_));
             ret.toolpath_locations.emplace_back(thickness / 2);
+            ret.left_over = 0;
         }
         else
         {
@@ -4,6 +4,7 @@
 #include "FffGcodeWriter.h"
 
 #include <algorithm>
+#include <charconv> // from_chars
 #include <cura-formulae-engine/eval.h>
 #include <limits> // numeric_limits
 #include <list>
@@ -26,6 +27,7 @@
 #include "PrimeTower/PrimeTower.h"
 #include "Slice.h"
 #include "WallToolPaths.h"
+#include "bridge/BridgeLayerContext.h"
 #include "bridge/bridge.h"
 #include "communication/Communication.h" //To send layer view data.
 #include "geometry/LinesSet.h"
@@ -34,6 +36,7 @@
 #include "infill.h"
 #include "progress/Progress.h"
 #include "raft.h"
+#include "utils/ResidentMemory.h"
 #include "utils/Simplify.h" //Removing micro-segments created by offsetting.
 #include "utils/ThreadPool.h"
 #include "utils/linearAlg2D.h"
@@ -123,23 +126,23 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
     const auto extruder_settings = Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_;
     // in case the prime blob is enabled the brim already starts from the closest start position which is blob location
     // also in case of one at a time printing the first move of every object shouldn't be start position of machine
-    if (! extruder_settings.get<bool>("prime_blob_enable") and ! (extruder_settings.get<std::string>("print_sequence") == "one_at_a_time"))
+    if (! extruder_settings.get<bool>("prime_blob_enable"_setting) and ! (extruder_settings.get<std::string>("print_sequence"_setting) == "one_at_a_time"))
     {
         // Setting first travel move of the first extruder to the machine start position
-        Point3LL p(extruder_settings.get<coord_t>("machine_extruder_start_pos_x"), extruder_settings.get<coord_t>("machine_extruder_start_pos_y"), gcode.getPositionZ());
-        gcode.writeTravel(p, extruder_settings.get<Velocity>("speed_travel"));
+        Point3LL p(extruder_settings.get<coord_t>("machine_extruder_start_pos_x"_setting), extruder_settings.get<coord_t>("machine_extruder_start_pos_y"_setting), gcode.getPositionZ());
+        gcode.writeTravel(p, extruder_settings.get<Velocity>("speed_travel"_setting));
     }
 
     calculateExtruderOrderPerLayer(storage);
     calculatePrimeLayerPerExtruder(storage);
 
-    if (scene.current_mesh_group->settings.get<bool>("magic_spiralize"))
+    if (scene.current_mesh_group->settings.get<bool>("magic_spiralize"_setting))
     {
         findLayerSeamsForSpiralize(storage, total_layers);
     }
 
     int process_layer_starting_layer_nr = 0;
-    const bool has_raft = scene.current_mesh_group->settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::RAFT;
+    const bool has_raft = scene.current_mesh_group->settings.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::RAFT;
     if (has_raft)
     {
         processRaft(storage);
@@ -155,6 +158,27 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
         }
     }
 
+    // Once the process uses more memory than the budget of CURAENGINE_MEMORY_BUDGET_MB (in MiB), the slice data of the layers that are done
+    // is freed. Kept slice data is written again later, so it is never freed.
+    std::optional<size_t> memory_budget;
+    if (const auto memory_budget_mib = spdlog::details::os::getenv("CURAENGINE_MEMORY_BUDGET_MB"); ! memory_budget_mib.empty() && ! scene.keep_slice_data)
+    {
+        constexpr size_t bytes_per_mib = 1024 * 1024;
+        size_t budget_mib = 0;
+        const char* const last = memory_budget_mib.data() + memory_budget_mib.size();
+        if (const auto [end, error] = std::from_chars(memory_budget_mib.data(), last, budget_mib);
+            error == std::errc() && end == last && budget_mib <= std::numeric_limits<size_t>::max() / bytes_per_mib)
+        {
+            memory_budget = budget_mib * bytes_per_mib;
+        }
+        else
+        {
+            spdlog::error("Ignoring CURAENGINE_MEMORY_BUDGET_MB={}, as it is not a number of MiB.", memory_budget_mib);
+        }
+    }
+    const LayerIndex layer_lookback = memory_budget ? LayerIndex(getLayerLookback(storage)) : LayerIndex(0);
+    LayerIndex next_layer_to_release = 0;
+
     run_multiple_producers_ordered_consumer(
         process_layer_starting_layer_nr,
         total_layers,
@@ -162,15 +186,32 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
         {
             return std::make_optional(processLayer(storage, layer_nr, total_layers));
         },
-        [this, total_layers](std::optional<ProcessLayerResult> result_opt)
+        [this, total_layers, &storage, &memory_budget, layer_lookback, &next_layer_to_release](std::optional<ProcessLayerResult> result_opt)
         {
             const ProcessLayerResult& result = result_opt.value();
-            Progress::messageProgressLayer(result.layer_plan->getLayerNr(), total_layers, result.total_elapsed_time, result.stages_times);
+            const LayerIndex layer_nr = result.layer_plan->getLayerNr();
+            Progress::messageProgressLayer(layer_nr, total_layers, result.total_elapsed_time, result.stages_times);
             layer_plan_buffer.handle(*result.layer_plan, gcode);
             print_info_.updateWithLayer(result.layer_plan);
+            gcode.sendFinishedGCodeParts(print_info_);
+
+            // The layers are consumed in order, so all layers that are still being processed are above this one. Neither they nor the layer
+            // plan buffer refer to the layers further below than the lookback.
+            if (memory_budget && getCurrentResidentMemory() >= *memory_budget)
+            {
+                for (; next_layer_to_release <= layer_nr - layer_lookback; ++next_layer_to_release)
+                {
+                    storage.releaseLayer(next_layer_to_release);
+                }
+            }
         });
 
     layer_plan_buffer.flush();
+    gcode.sendFinishedGCodeParts(print_info_);
+    if (next_layer_to_release > 0)
+    {
+        spdlog::info("Freed the slice data of {} layers while writing them, to stay within the memory budget", next_layer_to_release);
+    }
 
     Progress::messageProgressStage(Progress::Stage::FINISH, &time_keeper);
 
@@ -182,6 +223,40 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
     gcode.writeRetraction(storage.retraction_wipe_config_per_extruder[gcode.getExtruderNr()].retraction_config, force); // retract after finishing each meshgroup
 }
 
+size_t FffGcodeWriter::getLayerLookback(const SliceDataStorage& storage) const
+{
+    // The layer plan buffer combs the travel to the next layer through the layer below, spiralize and skin support read the layer below, and
+    // bridges rest on up to the third layer below.
+    size_t lookback = BridgeLayerContext::max_bridge_layer;
+
+    // How many layers the support top distance spans depends on the thickness of the layer, so take the thinnest one.
+    coord_t min_layer_thickness = std::numeric_limits<coord_t>::max();
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        for (const SliceLayer& layer : mesh->layers)
+        {
+            if (layer.thickness > 0)
+            {
+                min_layer_thickness = std::min(min_layer_thickness, layer.thickness);
+            }
+        }
+    }
+
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        // The flooring is found by looking down to the lowest flooring layer.
+        lookback = std::max(lookback, std::min(mesh->settings.get<size_t>("flooring_layer_count"_setting), mesh->settings.get<size_t>("bottom_layers"_setting)));
+
+        // Bridges look for support roofs below the support top distance, for each bridge layer.
+        if (min_layer_thickness != std::numeric_limits<coord_t>::max())
+        {
+            const size_t z_distance_top_layers = static_cast<size_t>(mesh->settings.get<coord_t>("support_top_distance"_setting) / min_layer_thickness) + 1;
+            lookback = std::max(lookback, z_distance_top_layers + BridgeLayerContext::max_bridge_layer - 1);
+        }
+    }
+    return lookback;
+}
+
 unsigned int FffGcodeWriter::findSpiralizedLayerSeamVertexIndex(const SliceDataStorage& storage, const SliceMeshStorage& mesh, const int layer_nr, const int last_layer_nr)
 {
     const SliceLayer& layer = mesh.layers[layer_nr];
@@ -193,7 +268,7 @@ unsigned int FffGcodeWriter::findSpiralizedLayerSeamVertexIndex(const SliceDataS
         // in the first layer that has a part with insets. This allows the user to alter the seam start location which
         // could be useful if the spiralization has a problem with a particular seam path.
         Point2LL seam_pos(0, 0);
-        if (mesh.settings.get<EZSeamType>("z_seam_type") == EZSeamType::USER_SPECIFIED)
+        if (mesh.settings.get<EZSeamType>("z_seam_type"_setting) == EZSeamType::USER_SPECIFIED)
         {
             seam_pos = mesh.getZSeamHint();
         }
@@ -219,7 +294,7 @@ unsigned int FffGcodeWriter::findSpiralizedLayerSeamVertexIndex(const SliceDataS
         // now we check that the vertex following the seam vertex is to the left of the seam vertex in the last layer
         // and if it isn't, we move forward
 
-        if (vSize(last_wall_seam_vertex - wall[seam_vertex_idx]) >= mesh.settings.get<coord_t>("meshfix_maximum_resolution"))
+        if (vSize(last_wall_seam_vertex - wall[seam_vertex_idx]) >= mesh.settings.get<coord_t>("meshfix_maximum_resolution"_setting))
         {
             // get the inward normal of the last layer seam vertex
             Point2LL last_wall_seam_vertex_inward_normal = PolygonUtils::getVertexInwardNormal(last_wall, storage.spiralize_seam_vertex_indices[last_layer_nr]);
@@ -294,16 +369,19 @@ void FffGcodeWriter::setConfigFanSpeedLayerTime()
     {
         fan_speed_layer_time_settings_per_extruder.emplace_back();
         FanSpeedLayerTimeSettings& fan_speed_layer_time_settings = fan_speed_layer_time_settings_per_extruder.back();
-        fan_speed_layer_time_settings.cool_min_layer_time = train.settings_.get<Duration>("cool_min_layer_time");
-        fan_speed_layer_time_settings.cool_min_layer_time_overhang = train.settings_.get<Duration>("cool_min_layer_time_overhang");
-        fan_speed_layer_time_settings.cool_min_layer_time_overhang_min_segment_length = train.settings_.get<coord_t>("cool_min_layer_time_overhang_min_segment_length");
-        fan_speed_layer_time_settings.cool_min_layer_time_fan_speed_max = train.settings_.get<Duration>("cool_min_layer_time_fan_speed_max");
-        fan_speed_layer_time_settings.cool_fan_speed_0 = train.settings_.get<Ratio>("cool_fan_speed_0") * 100.0;
-        fan_speed_layer_time_settings.cool_fan_speed_min = train.settings_.get<Ratio>("cool_fan_speed_min") * 100.0;
-        fan_speed_layer_time_settings.cool_fan_speed_max = train.settings_.get<Ratio>("cool_fan_speed_max") * 100.0;
-        fan_speed_layer_time_settings.cool_min_speed = train.settings_.get<Velocity>("cool_min_speed");
-        fan_speed_layer_time_settings.cool_fan_full_layer = train.settings_.get<LayerIndex>("cool_fan_full_layer");
-        if (! train.settings_.get<bool>("cool_fan_enabled"))
+        fan_speed_layer_time_settings.cool_min_layer_time = train.settings_.get<Duration>("cool_min_layer_time"_setting);
+        fan_speed_layer_time_settings.cool_min_layer_time_overhang = train.settings_.get<Duration>("cool_min_layer_time_overhang"_setting);
+        fan_speed_layer_time_settings.cool_min_layer_time_overhang_min_segment_length = train.settings_.get<coord_t>("cool_min_layer_time_overhang_min_segment_length"_setting);
+        fan_speed_layer_time_settings.cool_min_layer_time_fan_speed_max = train.settings_.get<Duration>("cool_min_layer_time_fan_speed_max"_setting);
+        fan_speed_layer_time_settings.cool_fan_speed_0 = train.settings_.get<Ratio>("cool_fan_speed_0"_setting) * 100.0;
+        fan_speed_layer_time_settings.cool_fan_speed_min = train.settings_.get<Ratio>("cool_fan_speed_min"_setting) * 100.0;
+        fan_speed_layer_time_settings.cool_fan_speed_max = train.settings_.get<Ratio>("cool_fan_speed_max"_setting) * 100.0;
+        fan_speed_layer_time_settings.cool_min_speed = train.settings_.get<Velocity>("cool_min_speed"_setting);
+        fan_speed_layer_time_settings.cool_fan_full_layer = train.settings_.get<LayerIndex>("cool_fan_full_layer"_setting);
+        // Front-ends that don't know this setting keep the naive layer time estimate.
+        fan_speed_layer_time_settings.cool_min_layer_time_estimate_acceleration
+            = train.settings_.has("cool_min_layer_time_estimate_acceleration") && train.settings_.get<bool>("cool_min_layer_time_estimate_acceleration"_setting);
+        if (! train.settings_.get<bool>("cool_fan_enabled"_setting))
         {
             fan_speed_layer_time_settings.cool_fan_speed_0 = 0;
             fan_speed_layer_time_settings.cool_fan_speed_min = 0;
@@ -315,26 +393,26 @@ void FffGcodeWriter::setConfigFanSpeedLayerTime()
 static void retractionAndWipeConfigFromSettings(const Settings& settings, RetractionAndWipeConfig* config)
 {
     RetractionConfig& retraction_config = config->retraction_config;
-    retraction_config.distance = (settings.get<bool>("retraction_enable")) ? settings.get<double>("retraction_amount") : 0; // Retraction distance in mm.
-    retraction_config.retract_during_travel = settings.get<Ratio>("retraction_during_travel_ratio");
-    retraction_config.keep_retracting_during_travel = settings.get<bool>("keep_retracting_during_travel");
-    retraction_config.prime_during_travel = settings.get<Ratio>("prime_during_travel_ratio");
-    retraction_config.prime_volume = settings.get<double>("retraction_extra_prime_amount"); // Extra prime volume in mm^3.
-    retraction_config.speed = settings.get<Velocity>("retraction_retract_speed");
-    retraction_config.primeSpeed = settings.get<Velocity>("retraction_prime_speed");
-    retraction_config.zHop = settings.get<coord_t>("retraction_hop");
-    retraction_config.retraction_min_travel_distance = settings.get<coord_t>("retraction_min_travel");
-    retraction_config.retraction_extrusion_window = settings.get<double>("retraction_extrusion_window"); // Window to count retractions in in mm of extruded filament.
-    retraction_config.retraction_count_max = settings.get<size_t>("retraction_count_max");
-
-    config->retraction_hop_after_extruder_switch = settings.get<bool>("retraction_hop_after_extruder_switch");
-    config->switch_extruder_extra_prime_amount = settings.get<double>("switch_extruder_extra_prime_amount");
+    retraction_config.distance = (settings.get<bool>("retraction_enable"_setting)) ? settings.get<double>("retraction_amount"_setting) : 0; // Retraction distance in mm.
+    retraction_config.retract_during_travel = settings.get<Ratio>("retraction_during_travel_ratio"_setting);
+    retraction_config.keep_retracting_during_travel = settings.get<bool>("keep_retracting_during_travel"_setting);
+    retraction_config.prime_during_travel = settings.get<Ratio>("prime_during_travel_ratio"_setting);
+    retraction_config.prime_volume = settings.get<double>("retraction_extra_prime_amount"_setting); // Extra prime volume in mm^3.
+    retraction_config.speed = settings.get<Velocity>("retraction_retract_speed"_setting);
+    retraction_config.primeSpeed = settings.get<Velocity>("retraction_prime_speed"_setting);
+    retraction_config.zHop = settings.get<coord_t>("retraction_hop"_setting);
+    retraction_config.retraction_min_travel_distance = settings.get<coord_t>("retraction_min_travel"_setting);
+    retraction_config.retraction_extrusion_window = settings.get<double>("retraction_extrusion_window"_setting); // Window to count retractions in in mm of extruded filament.
+    retraction_config.retraction_count_max = settings.get<size_t>("retraction_count_max"_setting);
+
+    config->retraction_hop_after_extruder_switch = settings.get<bool>("retraction_hop_after_extruder_switch"_setting);
+    config->switch_extruder_extra_prime_amount = settings.get<double>("switch_extruder_extra_prime_amount"_setting);
     RetractionConfig& switch_retraction_config = config->extruder_switch_retraction_config;
-    switch_retraction_config.distance = settings.get<double>("switch_extruder_retraction_amount"); // Retraction distance in mm.
+    switch_retraction_config.distance = settings.get<double>("switch_extruder_retraction_amount"_setting); // Retraction distance in mm.
     switch_retraction_config.prime_volume = 0.0;
-    switch_retraction_config.speed = settings.get<Velocity>("switch_extruder_retraction_speed");
-    switch_retraction_config.primeSpeed = settings.get<Velocity>("switch_extruder_prime_speed");
-    switch_retraction_config.zHop = settings.get<coord_t>("retraction_hop_after_extruder_switch_height");
+    switch_retraction_config.speed = settings.get<Velocity>("switch_extruder_retraction_speed"_setting);
+    switch_retraction_config.primeSpeed = settings.get<Velocity>("switch_extruder_prime_speed"_setting);
+    switch_retraction_config.zHop = settings.get<coord_t>("retraction_hop_after_extruder_switch_height"_setting);
     switch_retraction_config.retraction_min_travel_distance = 0; // No limitation on travel distance for an extruder switch retract.
     switch_retraction_config.retraction_extrusion_window
         = 99999.9; // So that extruder switch retractions won't affect the retraction buffer (extruded_volume_at_previous_n_retractions).
@@ -342,27 +420,27 @@ static void retractionAndWipeConfigFromSettings(const Settings& settings, Retrac
 
     WipeScriptConfig& wipe_config = config->wipe_config;
 
-    wipe_config.retraction_enable = settings.get<bool>("wipe_retraction_enable");
-    wipe_config.retraction_config.distance = settings.get<double>("wipe_retraction_amount");
-    wipe_config.retraction_config.speed = settings.get<Velocity>("wipe_retraction_retract_speed");
-    wipe_config.retraction_config.primeSpeed = settings.get<Velocity>("wipe_retraction_prime_speed");
-    wipe_config.retraction_config.prime_volume = settings.get<double>("wipe_retraction_extra_prime_amount");
+    wipe_config.retraction_enable = settings.get<bool>("wipe_retraction_enable"_setting);
+    wipe_config.retraction_config.distance = settings.get<double>("wipe_retraction_amount"_setting);
+    wipe_config.retraction_config.speed = settings.get<Velocity>("wipe_retraction_retract_speed"_setting);
+    wipe_config.retraction_config.primeSpeed = settings.get<Velocity>("wipe_retraction_prime_speed"_setting);
+    wipe_config.retraction_config.prime_volume = settings.get<double>("wipe_retraction_extra_prime_amount"_setting);
     wipe_config.retraction_config.retraction_min_travel_distance = 0;
     wipe_config.retraction_config.retraction_extrusion_window = std::numeric_limits<double>::max();
     wipe_config.retraction_config.retraction_count_max = std::numeric_limits<size_t>::max();
 
-    wipe_config.pause = settings.get<Duration>("wipe_pause");
+    wipe_config.pause = settings.get<Duration>("wipe_pause"_setting);
 
-    wipe_config.hop_enable = settings.get<bool>("wipe_hop_enable");
-    wipe_config.hop_amount = settings.get<coord_t>("wipe_hop_amount");
-    wipe_config.hop_speed = settings.get<Velocity>("wipe_hop_speed");
+    wipe_config.hop_enable = settings.get<bool>("wipe_hop_enable"_setting);
+    wipe_config.hop_amount = settings.get<coord_t>("wipe_hop_amount"_setting);
+    wipe_config.hop_speed = settings.get<Velocity>("wipe_hop_speed"_setting);
 
-    wipe_config.brush_pos_x = settings.get<coord_t>("wipe_brush_pos_x");
-    wipe_config.repeat_count = settings.get<size_t>("wipe_repeat_count");
-    wipe_config.move_distance = settings.get<coord_t>("wipe_move_distance");
-    wipe_config.move_speed = settings.get<Velocity>("speed_travel");
-    wipe_config.max_extrusion_mm3 = settings.get<double>("max_extrusion_before_wipe");
-    wipe_config.clean_between_layers = settings.get<bool>("clean_between_layers");
+    wipe_config.brush_pos_x = settings.get<coord_t>("wipe_brush_pos_x"_setting);
+    wipe_config.repeat_count = settings.get<size_t>("wipe_repeat_count"_setting);
+    wipe_config.move_distance = settings.get<coord_t>("wipe_move_distance"_setting);
+    wipe_config.move_speed = settings.get<Velocity>("speed_travel"_setting);
+    wipe_config.max_extrusion_mm3 = settings.get<double>("max_extrusion_before_wipe"_setting);
+    wipe_config.clean_between_layers = settings.get<bool>("clean_between_layers"_setting);
 }
 
 void FffGcodeWriter::setConfigRetractionAndWipe(SliceDataStorage& storage)
@@ -383,20 +461,20 @@ size_t FffGcodeWriter::getStartExtruder(const SliceDataStorage& storage) const
 {
     const auto& mesh_group = Application::getInstance().current_slice_->scene.current_mesh_group;
     const Settings& mesh_group_settings = mesh_group->settings;
-    const EPlatformAdhesion adhesion_type = mesh_group_settings.get<EPlatformAdhesion>("adhesion_type");
-    const int skirt_brim_extruder_nr = mesh_group_settings.get<int>("skirt_brim_extruder_nr");
+    const EPlatformAdhesion adhesion_type = mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting);
+    const int skirt_brim_extruder_nr = mesh_group_settings.get<int>("skirt_brim_extruder_nr"_setting);
     const ExtruderTrain* skirt_brim_extruder = (skirt_brim_extruder_nr < 0) ? nullptr : &mesh_group_settings.get<ExtruderTrain&>("skirt_brim_extruder_nr");
 
     size_t start_extruder_nr;
     if (adhesion_type == EPlatformAdhesion::SKIRT && skirt_brim_extruder
-        && (skirt_brim_extruder->settings_.get<int>("skirt_line_count") > 0 || skirt_brim_extruder->settings_.get<coord_t>("skirt_brim_minimal_length") > 0))
+        && (skirt_brim_extruder->settings_.get<int>("skirt_line_count"_setting) > 0 || skirt_brim_extruder->settings_.get<coord_t>("skirt_brim_minimal_length"_setting) > 0))
     {
         start_extruder_nr = skirt_brim_extruder->extruder_nr_;
     }
 
     else if (
-        (adhesion_type == EPlatformAdhesion::BRIM || mesh_group_settings.get<bool>("prime_tower_brim_enable")) && skirt_brim_extruder
-        && (skirt_brim_extruder->settings_.get<int>("brim_line_count") > 0 || skirt_brim_extruder->settings_.get<coord_t>("skirt_brim_minimal_length") > 0))
+        (adhesion_type == EPlatformAdhesion::BRIM || mesh_group_settings.get<bool>("prime_tower_brim_enable"_setting)) && skirt_brim_extruder
+        && (skirt_brim_extruder->settings_.get<int>("brim_line_count"_setting) > 0 || skirt_brim_extruder->settings_.get<coord_t>("skirt_brim_minimal_length"_setting) > 0))
     {
         start_extruder_nr = skirt_brim_extruder->extruder_nr_;
     }
@@ -406,7 +484,7 @@ size_t FffGcodeWriter::getStartExtruder(const SliceDataStorage& storage) const
     }
     else // No adhesion.
     {
-        if ((mesh_group_settings.get<bool>("support_enable") || mesh_group->has_painted_support) && mesh_group_settings.get<bool>("support_brim_enable"))
+        if ((mesh_group_settings.get<bool>("support_enable"_setting) || mesh_group->has_painted_support) && mesh_group_settings.get<bool>("support_brim_enable"_setting))
         {
             start_extruder_nr = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").extruder_nr_;
         }
@@ -431,11 +509,11 @@ void FffGcodeWriter::setInfillAndSkinAngles(SliceMeshStorage& mesh)
 {
     if (mesh.infill_angles.size() == 0)
     {
-        mesh.infill_angles = mesh.settings.get<std::vector<AngleDegrees>>("infill_angles");
+        mesh.infill_angles = mesh.settings.get<std::vector<AngleDegrees>>("infill_angles"_setting);
         if (mesh.infill_angles.size() == 0)
         {
             // user has not specified any infill angles so use defaults
-            const EFillMethod infill_pattern = mesh.settings.get<EFillMethod>("infill_pattern");
+            const EFillMethod infill_pattern = mesh.settings.get<EFillMethod>("infill_pattern"_setting);
             if (infill_pattern == EFillMethod::CROSS || infill_pattern == EFillMethod::CROSS_3D)
             {
                 mesh.infill_angles.push_back(22); // put most infill lines in between 45 and 0 degrees
@@ -454,7 +532,7 @@ void FffGcodeWriter::setInfillAndSkinAngles(SliceMeshStorage& mesh)
 
     if (mesh.roofing_angles.size() == 0)
     {
-        mesh.roofing_angles = mesh.settings.get<std::vector<AngleDegrees>>("roofing_angles");
+        mesh.roofing_angles = mesh.settings.get<std::vector<AngleDegrees>>("roofing_angles"_setting);
         if (mesh.roofing_angles.size() == 0)
         {
             // user has not specified any infill angles so use defaults
@@ -465,7 +543,7 @@ void FffGcodeWriter::setInfillAndSkinAngles(SliceMeshStorage& mesh)
 
     if (mesh.flooring_angles.size() == 0)
     {
-        mesh.flooring_angles = mesh.settings.get<std::vector<AngleDegrees>>("flooring_angles");
+        mesh.flooring_angles = mesh.settings.get<std::vector<AngleDegrees>>("flooring_angles"_setting);
         if (mesh.flooring_angles.size() == 0)
         {
             // user has not specified any infill angles so use defaults
@@ -476,7 +554,7 @@ void FffGcodeWriter::setInfillAndSkinAngles(SliceMeshStorage& mesh)
 
     if (mesh.skin_angles.size() == 0)
     {
-        mesh.skin_angles = mesh.settings.get<std::vector<AngleDegrees>>("skin_angles");
+        mesh.skin_angles = mesh.settings.get<std::vector<AngleDegrees>>("skin_angles"_setting);
         if (mesh.skin_angles.size() == 0)
         {
             // user has not specified any infill angles so use defaults
@@ -490,14 +568,14 @@ void FffGcodeWriter::setSupportAngles(SliceDataStorage& storage)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const ExtruderTrain& support_infill_extruder = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr");
-    storage.support.support_infill_angles = support_infill_extruder.settings_.get<std::vector<AngleDegrees>>("support_infill_angles");
+    storage.support.support_infill_angles = support_infill_extruder.settings_.get<std::vector<AngleDegrees>>("support_infill_angles"_setting);
     if (storage.support.support_infill_angles.empty())
     {
         storage.support.support_infill_angles.push_back(0);
     }
 
     const ExtruderTrain& support_extruder_nr_layer_0 = mesh_group_settings.get<ExtruderTrain&>("support_extruder_nr_layer_0");
-    storage.support.support_infill_angles_layer_0 = support_extruder_nr_layer_0.settings_.get<std::vector<AngleDegrees>>("support_infill_angles");
+    storage.support.support_infill_angles_layer_0 = support_extruder_nr_layer_0.settings_.get<std::vector<AngleDegrees>>("support_infill_angles"_setting);
     if (storage.support.support_infill_angles_layer_0.empty())
     {
         storage.support.support_infill_angles_layer_0.push_back(0);
@@ -522,7 +600,7 @@ void FffGcodeWriter::setSupportAngles(SliceDataStorage& storage)
                 for (const auto& mesh : storage.meshes)
                 {
                     if (mesh->settings.get<coord_t>(interface_height_setting)
-                        >= 2 * Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("layer_height"))
+                        >= 2 * Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("layer_height"_setting))
                     {
                         // Some roofs are quite thick.
                         // Alternate between the two kinds of diagonal: / and \ .
@@ -541,11 +619,11 @@ void FffGcodeWriter::setSupportAngles(SliceDataStorage& storage)
 
     const ExtruderTrain& roof_extruder = mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr");
     storage.support.support_roof_angles
-        = getInterfaceAngles(roof_extruder, "support_roof_angles", roof_extruder.settings_.get<EFillMethod>("support_roof_pattern"), "support_roof_height");
+        = getInterfaceAngles(roof_extruder, "support_roof_angles", roof_extruder.settings_.get<EFillMethod>("support_roof_pattern"_setting), "support_roof_height");
 
     const ExtruderTrain& bottom_extruder = mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr");
     storage.support.support_bottom_angles
-        = getInterfaceAngles(bottom_extruder, "support_bottom_angles", bottom_extruder.settings_.get<EFillMethod>("support_bottom_pattern"), "support_bottom_height");
+        = getInterfaceAngles(bottom_extruder, "support_bottom_angles", bottom_extruder.settings_.get<EFillMethod>("support_bottom_pattern"_setting), "support_bottom_height");
 }
 
 void FffGcodeWriter::processNextMeshGroupCode(const SliceDataStorage& storage)
@@ -554,9 +632,9 @@ void FffGcodeWriter::processNextMeshGroupCode(const SliceDataStorage& storage)
     gcode.setZ(max_object_height + MM2INT(5));
 
     Application::getInstance().communication_->sendCurrentPosition(gcode.getPositionXY());
-    gcode.writeTravel(gcode.getPositionXY(), Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_z_hop"));
+    gcode.writeTravel(gcode.getPositionXY(), Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_z_hop"_setting));
     Point2LL start_pos(storage.model_min.x_, storage.model_min.y_);
-    gcode.writeTravel(start_pos, Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_travel"));
+    gcode.writeTravel(start_pos, Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_travel"_setting));
 
     gcode.processInitialLayerTemperature(storage, gcode.getExtruderNr());
 }
@@ -571,9 +649,9 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
     coord_t z = 0;
     const LayerIndex initial_raft_layer_nr = -LayerIndex(Raft::getTotalExtraLayers());
     const Settings& interface_settings = mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings_;
-    const size_t num_interface_layers = interface_settings.get<size_t>("raft_interface_layers");
+    const size_t num_interface_layers = interface_settings.get<size_t>("raft_interface_layers"_setting);
     const Settings& surface_settings = mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings_;
-    const size_t num_surface_layers = surface_settings.get<size_t>("raft_surface_layers");
+    const size_t num_surface_layers = surface_settings.get<size_t>("raft_surface_layers"_setting);
 
     // some infill config for all lines infill generation below
     constexpr int infill_multiplier = 1; // rafts use single lines
@@ -589,21 +667,21 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
     { // raft base layer
         const Settings& base_settings = mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings_;
         LayerIndex layer_nr = initial_raft_layer_nr;
-        const coord_t layer_height = base_settings.get<coord_t>("raft_base_thickness");
+        const coord_t layer_height = base_settings.get<coord_t>("raft_base_thickness"_setting);
         z += layer_height;
-        const coord_t comb_offset = std::max(base_settings.get<coord_t>("raft_base_line_spacing"), base_settings.get<coord_t>("raft_base_line_width"));
+        const coord_t comb_offset = std::max(base_settings.get<coord_t>("raft_base_line_spacing"_setting), base_settings.get<coord_t>("raft_base_line_width"_setting));
 
         std::vector<FanSpeedLayerTimeSettings> fan_speed_layer_time_settings_per_extruder_raft_base
             = fan_speed_layer_time_settings_per_extruder; // copy so that we change only the local copy
         for (FanSpeedLayerTimeSettings& fan_speed_layer_time_settings : fan_speed_layer_time_settings_per_extruder_raft_base)
         {
-            double regular_fan_speed = base_settings.get<Ratio>("raft_base_fan_speed") * 100.0;
+            double regular_fan_speed = base_settings.get<Ratio>("raft_base_fan_speed"_setting) * 100.0;
             fan_speed_layer_time_settings.cool_fan_speed_min = regular_fan_speed;
             fan_speed_layer_time_settings.cool_fan_speed_0 = regular_fan_speed; // ignore initial layer fan speed stuff
         }
 
-        const coord_t line_width = base_settings.get<coord_t>("raft_base_line_width");
-        const coord_t avoid_distance = base_settings.get<coord_t>("travel_avoid_distance");
+        const coord_t line_width = base_settings.get<coord_t>("raft_base_line_width"_setting);
+        const coord_t avoid_distance = base_settings.get<coord_t>("travel_avoid_distance"_setting);
         LayerPlan& gcode_layer
             = *new LayerPlan(storage, layer_nr, z, layer_height, base_extruder_nr, fan_speed_layer_time_settings_per_extruder_raft_base, comb_offset, line_width, avoid_distance);
         gcode_layer.setIsInside(true);
@@ -615,11 +693,11 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
         constexpr bool zig_zaggify_infill = false;
         constexpr bool connect_polygons = true; // causes less jerks, so better adhesion
 
-        const size_t wall_line_count = base_settings.get<size_t>("raft_base_wall_count");
+        const size_t wall_line_count = base_settings.get<size_t>("raft_base_wall_count"_setting);
         const coord_t small_area_width = 0; // A raft never has a small region due to the large horizontal expansion.
-        const coord_t line_spacing = base_settings.get<coord_t>("raft_base_line_spacing");
-        const coord_t infill_overlap = base_settings.get<coord_t>("raft_base_infill_overlap_mm");
-        const coord_t line_spacing_prime_tower = base_settings.get<coord_t>("prime_tower_raft_base_line_spacing");
+        const coord_t line_spacing = base_settings.get<coord_t>("raft_base_line_spacing"_setting);
+        const coord_t infill_overlap = base_settings.get<coord_t>("raft_base_infill_overlap_mm"_setting);
+        const coord_t line_spacing_prime_tower = base_settings.get<coord_t>("prime_tower_raft_base_line_spacing"_setting);
         const Point2LL& infill_origin = Point2LL();
         constexpr bool skip_stitching = false;
         constexpr bool connected_zigzags = false;
@@ -627,8 +705,8 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
         constexpr bool skip_some_zags = false;
         constexpr int zag_skip_count = 0;
         constexpr coord_t pocket_size = 0;
-        const coord_t max_resolution = base_settings.get<coord_t>("meshfix_maximum_resolution");
-        const coord_t max_deviation = base_settings.get<coord_t>("meshfix_maximum_deviation");
+        const coord_t max_resolution = base_settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+        const coord_t max_deviation = base_settings.get<coord_t>("meshfix_maximum_deviation"_setting);
 
         struct ParameterizedRaftPath
         {
@@ -750,15 +828,15 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
         layer_plan_buffer.handle(gcode_layer, gcode);
     }
 
-    const coord_t interface_layer_height = interface_settings.get<coord_t>("raft_interface_thickness");
-    const coord_t interface_line_spacing = interface_settings.get<coord_t>("raft_interface_line_spacing");
-    const Ratio interface_fan_speed = interface_settings.get<Ratio>("raft_interface_fan_speed");
-    const coord_t interface_line_width = interface_settings.get<coord_t>("raft_interface_line_width");
-    const coord_t interface_infill_overlap = interface_settings.get<coord_t>("raft_interface_infill_overlap_mm");
-    const coord_t interface_avoid_distance = interface_settings.get<coord_t>("travel_avoid_distance");
-    const coord_t interface_max_resolution = interface_settings.get<coord_t>("meshfix_maximum_resolution");
-    const coord_t interface_max_deviation = interface_settings.get<coord_t>("meshfix_maximum_deviation");
-    const coord_t raft_interface_z_offset = interface_settings.get<coord_t>("raft_interface_z_offset");
+    const coord_t interface_layer_height = interface_settings.get<coord_t>("raft_interface_thickness"_setting);
+    const coord_t interface_line_spacing = interface_settings.get<coord_t>("raft_interface_line_spacing"_setting);
+    const Ratio interface_fan_speed = interface_settings.get<Ratio>("raft_interface_fan_speed"_setting);
+    const coord_t interface_line_width = interface_settings.get<coord_t>("raft_interface_line_width"_setting);
+    const coord_t interface_infill_overlap = interface_settings.get<coord_t>("raft_interface_infill_overlap_mm"_setting);
+    const coord_t interface_avoid_distance = interface_settings.get<coord_t>("travel_avoid_distance"_setting);
+    const coord_t interface_max_resolution = interface_settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const coord_t interface_max_deviation = interface_settings.get<coord_t>("meshfix_maximum_deviation"_setting);
+    const coord_t raft_interface_z_offset = interface_settings.get<coord_t>("raft_interface_z_offset"_setting);
 
     z += raft_interface_z_offset;
 
@@ -805,7 +883,7 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
         constexpr bool zig_zaggify_infill = true;
         constexpr bool connect_polygons = true; // why not?
 
-        const size_t wall_line_count = interface_settings.get<size_t>("raft_interface_wall_count");
+        const size_t wall_line_count = interface_settings.get<size_t>("raft_interface_wall_count"_setting);
         const coord_t small_area_width = 0; // A raft never has a small region due to the large horizontal expansion.
         const Point2LL infill_origin = Point2LL();
         constexpr bool skip_stitching = false;
@@ -911,16 +989,16 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
         last_planned_position = gcode_layer.getLastPlannedPositionOrStartingPosition();
     }
 
-    const coord_t surface_layer_height = surface_settings.get<coord_t>("raft_surface_thickness");
-    const coord_t surface_line_spacing = surface_settings.get<coord_t>("raft_surface_line_spacing");
-    const coord_t surface_max_resolution = surface_settings.get<coord_t>("meshfix_maximum_resolution");
-    const coord_t surface_max_deviation = surface_settings.get<coord_t>("meshfix_maximum_deviation");
-    const coord_t surface_line_width = surface_settings.get<coord_t>("raft_surface_line_width");
-    const coord_t surface_infill_overlap = surface_settings.get<coord_t>("raft_surface_infill_overlap_mm");
-    const coord_t surface_avoid_distance = surface_settings.get<coord_t>("travel_avoid_distance");
-    const Ratio surface_fan_speed = surface_settings.get<Ratio>("raft_surface_fan_speed");
-    const bool surface_monotonic = surface_settings.get<bool>("raft_surface_monotonic");
-    const coord_t raft_surface_z_offset = interface_settings.get<coord_t>("raft_surface_z_offset");
+    const coord_t surface_layer_height = surface_settings.get<coord_t>("raft_surface_thickness"_setting);
+    const coord_t surface_line_spacing = surface_settings.get<coord_t>("raft_surface_line_spacing"_setting);
+    const coord_t surface_max_resolution = surface_settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const coord_t surface_max_deviation = surface_settings.get<coord_t>("meshfix_maximum_deviation"_setting);
+    const coord_t surface_line_width = surface_settings.get<coord_t>("raft_surface_line_width"_setting);
+    const coord_t surface_infill_overlap = surface_settings.get<coord_t>("raft_surface_infill_overlap_mm"_setting);
+    const coord_t surface_avoid_distance = surface_settings.get<coord_t>("travel_avoid_distance"_setting);
+    const Ratio surface_fan_speed = surface_settings.get<Ratio>("raft_surface_fan_speed"_setting);
+    const bool surface_monotonic = surface_settings.get<bool>("raft_surface_monotonic"_setting);
+    const coord_t raft_surface_z_offset = interface_settings.get<coord_t>("raft_surface_z_offset"_setting);
 
     z += raft_surface_z_offset;
 
@@ -968,7 +1046,7 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
             = (num_surface_layers - raft_surface_layer) % 2 ? 45 : 135; // Alternate between -45 and +45 degrees, ending up 90 degrees rotated from the default skin angle.
         constexpr bool zig_zaggify_infill = true;
 
-        const size_t wall_line_count = surface_settings.get<size_t>("raft_surface_wall_count");
+        const size_t wall_line_count = surface_settings.get<size_t>("raft_surface_wall_count"_setting);
         const coord_t small_area_width = 0; // A raft never has a small region due to the large horizontal expansion.
         const Point2LL& infill_origin = Point2LL();
         const GCodePathConfig& config = gcode_layer.configs_storage_.raft_surface_config;
@@ -1133,13 +1211,13 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
     spdlog::stopwatch timer_total;
 
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    coord_t layer_thickness = mesh_group_settings.get<coord_t>("layer_height");
+    coord_t layer_thickness = mesh_group_settings.get<coord_t>("layer_height"_setting);
     coord_t z;
     bool include_helper_parts = true;
     if (layer_nr < 0)
     {
 #ifdef DEBUG
-        assert(mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::RAFT && "negative layer_number means post-raft, pre-model layer!");
+        assert(mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::RAFT && "negative layer_number means post-raft, pre-model layer!");
 #endif // DEBUG
         const int filler_layer_count = Raft::getFillerLayerCount();
         layer_thickness = Raft::getFillerLayerHeight();
@@ -1152,7 +1230,7 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
         for (const std::shared_ptr<SliceMeshStorage>& mesh_ptr : storage.meshes)
         {
             const auto& mesh = *mesh_ptr;
-            if (layer_nr >= static_cast<int>(mesh.layers.size()) || mesh.settings.get<bool>("support_mesh") || ! mesh.isModelMesh())
+            if (layer_nr >= static_cast<int>(mesh.layers.size()) || mesh.settings.get<bool>("support_mesh"_setting) || ! mesh.isModelMesh())
             {
                 continue;
             }
@@ -1161,7 +1239,7 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
             break;
         }
 
-        if (layer_nr < 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::RAFT)
+        if (layer_nr < 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::RAFT)
         {
             include_helper_parts = false;
         }
@@ -1178,12 +1256,12 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
         {
             const ExtruderTrain& extruder = scene.extruders[extruder_nr];
 
-            if (extruder.settings_.get<bool>("travel_avoid_other_parts"))
+            if (extruder.settings_.get<bool>("travel_avoid_other_parts"_setting))
             {
-                avoid_distance = std::max(avoid_distance, extruder.settings_.get<coord_t>("travel_avoid_distance"));
+                avoid_distance = std::max(avoid_distance, extruder.settings_.get<coord_t>("travel_avoid_distance"_setting));
             }
 
-            comb_offset_from_outlines = std::max(comb_offset_from_outlines, extruder.settings_.get<coord_t>("retraction_combing_avoid_distance"));
+            comb_offset_from_outlines = std::max(comb_offset_from_outlines, extruder.settings_.get<coord_t>("retraction_combing_avoid_distance"_setting));
         }
     }
 
@@ -1191,11 +1269,11 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
     for (const std::shared_ptr<SliceMeshStorage>& mesh_ptr : storage.meshes)
     {
         const auto& mesh = *mesh_ptr;
-        coord_t mesh_inner_wall_width = mesh.settings.get<coord_t>((mesh.settings.get<size_t>("wall_line_count") > 1) ? "wall_line_width_x" : "wall_line_width_0");
+        coord_t mesh_inner_wall_width = mesh.settings.get<coord_t>((mesh.settings.get<size_t>("wall_line_count"_setting) > 1) ? "wall_line_width_x" : "wall_line_width_0");
         if (layer_nr == 0)
         {
-            const ExtruderTrain& train = mesh.settings.get<ExtruderTrain&>((mesh.settings.get<size_t>("wall_line_count") > 1) ? "wall_0_extruder_nr" : "wall_x_extruder_nr");
-            mesh_inner_wall_width *= train.settings_.get<Ratio>("initial_layer_line_width_factor");
+            const ExtruderTrain& train = mesh.settings.get<ExtruderTrain&>((mesh.settings.get<size_t>("wall_line_count"_setting) > 1) ? "wall_0_extruder_nr" : "wall_x_extruder_nr");
+            mesh_inner_wall_width *= train.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
         }
         max_inner_wall_width = std::max(max_inner_wall_width, mesh_inner_wall_width);
     }
@@ -1204,7 +1282,7 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
 
     const std::vector<ExtruderUse> extruder_order = extruder_order_per_layer.get(layer_nr);
 
-    const coord_t first_outer_wall_line_width = scene.extruders[first_extruder].settings_.get<coord_t>("wall_line_width_0");
+    const coord_t first_outer_wall_line_width = scene.extruders[first_extruder].settings_.get<coord_t>("wall_line_width_0"_setting);
     LayerPlan& gcode_layer = *new LayerPlan(
         storage,
         layer_nr,
@@ -1264,7 +1342,7 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
             {
                 const std::shared_ptr<SliceMeshStorage>& mesh = storage.meshes[mesh_idx];
                 const MeshPathConfigs& mesh_config = gcode_layer.configs_storage_.mesh_configs[mesh_idx];
-                if (mesh->settings.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE
+                if (mesh->settings.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) == ESurfaceMode::SURFACE
                     && extruder_nr
                            == mesh->settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_ // mesh surface mode should always only be printed with the outer wall extruder!
                 )
@@ -1288,6 +1366,13 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
     gcode_layer.applyBackPressureCompensation();
     time_keeper.registerTime("Back pressure comp.");
 
+    // Done here rather than when the layer is written, since the layers are processed in parallel but written one by one.
+    gcode_layer.precomputeNaiveTimeEstimates();
+    time_keeper.registerTime("Time estimates");
+
+    gcode_layer.formatExtrusionCoordinates(gcode);
+    time_keeper.registerTime("Format g-code");
+
     return { &gcode_layer, timer_total.elapsed().count(), time_keeper.getRegisteredTimes() };
 }
 
@@ -1311,8 +1396,8 @@ bool FffGcodeWriter::getExtruderNeedPrimeBlobDuringFirstLayer(const SliceDataSto
 void FffGcodeWriter::processSkirtBrim(const SliceDataStorage& storage, LayerPlan& gcode_layer, const unsigned int extruder_nr, const LayerIndex layer_nr) const
 {
     const ExtruderTrain& train = Application::getInstance().current_slice_->scene.extruders[extruder_nr];
-    const int skirt_height = train.settings_.get<int>("skirt_height");
-    const bool is_skirt = train.settings_.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::SKIRT;
+    const int skirt_height = train.settings_.get<int>("skirt_height"_setting);
+    const bool is_skirt = train.settings_.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::SKIRT;
     // only create a multilayer SkirtBrim for a skirt for the height of skirt_height
     if (layer_nr != 0 && (layer_nr >= skirt_height || ! is_skirt))
     {
@@ -1332,10 +1417,10 @@ void FffGcodeWriter::processSkirtBrim(const SliceDataStorage& storage, LayerPlan
 
     // Start brim close to the prime location
     Point2LL start_close_to;
-    if (train.settings_.get<bool>("prime_blob_enable"))
+    if (train.settings_.get<bool>("prime_blob_enable"_setting))
     {
-        const auto prime_pos_is_abs = train.settings_.get<bool>("extruder_prime_pos_abs");
-        const auto prime_pos = Point2LL(train.settings_.get<coord_t>("extruder_prime_pos_x"), train.settings_.get<coord_t>("extruder_prime_pos_y"));
+        const auto prime_pos_is_abs = train.settings_.get<bool>("extruder_prime_pos_abs"_setting);
+        const auto prime_pos = Point2LL(train.settings_.get<coord_t>("extruder_prime_pos_x"_setting), train.settings_.get<coord_t>("extruder_prime_pos_y"_setting));
         start_close_to = prime_pos_is_abs ? prime_pos : gcode_layer.getLastPlannedPositionOrStartingPosition() + prime_pos;
     }
     else
@@ -1365,7 +1450,7 @@ void FffGcodeWriter::processSkirtBrim(const SliceDataStorage& storage, LayerPlan
     MixedLinesSet all_brim_lines;
     all_brim_lines.reserve(total_line_count);
 
-    const coord_t line_w = train.settings_.get<coord_t>("skirt_brim_line_width") * train.settings_.get<Ratio>("initial_layer_line_width_factor");
+    const coord_t line_w = train.settings_.get<coord_t>("skirt_brim_line_width"_setting) * train.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
     const coord_t searching_radius = line_w * 2;
     using GridT = SparsePointGridInclusive<BrimLineReference>;
     GridT grid(searching_radius);
@@ -1392,7 +1477,7 @@ void FffGcodeWriter::processSkirtBrim(const SliceDataStorage& storage, LayerPlan
         }
     }
 
-    const auto smart_brim_ordering = train.settings_.get<bool>("brim_smart_ordering") && train.settings_.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM;
+    const auto smart_brim_ordering = train.settings_.get<bool>("brim_smart_ordering"_setting) && train.settings_.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::BRIM;
     std::unordered_multimap<const Polyline*, const Polyline*> order_requirements;
     for (const std::pair<SquareGrid::GridPoint, SparsePointGridInclusiveImpl::SparsePointGridInclusiveElem<BrimLineReference>>& p : grid)
     {
@@ -1497,7 +1582,7 @@ void FffGcodeWriter::processOozeShield(const SliceDataStorage& storage, LayerPla
 {
     LayerIndex layer_nr = std::max(LayerIndex{ 0 }, gcode_layer.getLayerNr());
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    if (layer_nr == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM)
+    if (layer_nr == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::BRIM)
     {
         return; // ooze shield already generated by brim
     }
@@ -1515,20 +1600,20 @@ void FffGcodeWriter::processDraftShield(const SliceDataStorage& storage, LayerPl
     {
         return;
     }
-    if (! mesh_group_settings.get<bool>("draft_shield_enabled"))
+    if (! mesh_group_settings.get<bool>("draft_shield_enabled"_setting))
     {
         return;
     }
-    if (layer_nr == 0 && Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM)
+    if (layer_nr == 0 && Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<EPlatformAdhesion>("adhesion_type"_setting) == EPlatformAdhesion::BRIM)
     {
         return; // draft shield already generated by brim
     }
 
-    if (mesh_group_settings.get<DraftShieldHeightLimitation>("draft_shield_height_limitation") == DraftShieldHeightLimitation::LIMITED)
+    if (mesh_group_settings.get<DraftShieldHeightLimitation>("draft_shield_height_limitation"_setting) == DraftShieldHeightLimitation::LIMITED)
     {
-        const coord_t draft_shield_height = mesh_group_settings.get<coord_t>("draft_shield_height");
-        const coord_t layer_height_0 = mesh_group_settings.get<coord_t>("layer_height_0");
-        const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height");
+        const coord_t draft_shield_height = mesh_group_settings.get<coord_t>("draft_shield_height"_setting);
+        const coord_t layer_height_0 = mesh_group_settings.get<coord_t>("layer_height_0"_setting);
+        const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height"_setting);
         const LayerIndex max_screen_layer = (draft_shield_height - layer_height_0) / layer_height + 1;
         if (layer_nr > max_screen_layer)
         {
@@ -1697,7 +1782,7 @@ std::vector<size_t> FffGcodeWriter::calculateMeshOrder(const SliceDataStorage& s
         }
     }
     const ExtruderTrain& train = Application::getInstance().current_slice_->scene.extruders[extruder_nr];
-    const Point2LL layer_start_position(train.settings_.get<coord_t>("layer_start_x"), train.settings_.get<coord_t>("layer_start_y"));
+    const Point2LL layer_start_position(train.settings_.get<coord_t>("layer_start_x"_setting), train.settings_.get<coord_t>("layer_start_y"_setting));
     std::list<size_t> mesh_indices_order = mesh_idx_order_optimizer.optimize(layer_start_position);
 
     std::vector<size_t> ret;
@@ -1718,7 +1803,7 @@ void FffGcodeWriter::addMeshLayerToGCode_meshSurfaceMode(const SliceMeshStorage&
         return;
     }
 
-    if (! mesh.isPrinted() || mesh.settings.get<bool>("support_mesh"))
+    if (! mesh.isPrinted() || mesh.settings.get<bool>("support_mesh"_setting))
     {
         return;
     }
@@ -1738,11 +1823,11 @@ void FffGcodeWriter::addMeshLayerToGCode_meshSurfaceMode(const SliceMeshStorage&
     polygons = Simplify(mesh.settings).polygon(polygons);
 
     ZSeamConfig z_seam_config(
-        mesh.settings.get<EZSeamType>("z_seam_type"),
+        mesh.settings.get<EZSeamType>("z_seam_type"_setting),
         mesh.getZSeamHint(),
-        mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"),
-        mesh.settings.get<coord_t>("wall_line_width_0") * 2);
-    const bool spiralize = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("magic_spiralize");
+        mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"_setting),
+        mesh.settings.get<coord_t>("wall_line_width_0"_setting) * 2);
+    const bool spiralize = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("magic_spiralize"_setting);
     constexpr Ratio flow_ratio = 1.0;
     constexpr auto always_retract = ForceRetract::AUTOMATIC;
     constexpr bool reverse_order = false;
@@ -1755,7 +1840,7 @@ void FffGcodeWriter::addMeshLayerToGCode_meshSurfaceMode(const SliceMeshStorage&
         mesh_config.inset0_config,
         mesh.settings,
         z_seam_config,
-        mesh.settings.get<coord_t>("wall_0_wipe_dist"),
+        mesh.settings.get<coord_t>("wall_0_wipe_dist"_setting),
         spiralize,
         flow_ratio,
         always_retract,
@@ -1788,7 +1873,7 @@ void FffGcodeWriter::addMeshLayerToGCode(
         return;
     }
 
-    if (! mesh.isPrinted() || mesh.settings.get<bool>("support_mesh"))
+    if (! mesh.isPrinted() || mesh.settings.get<bool>("support_mesh"_setting))
     {
         return;
     }
@@ -1806,10 +1891,10 @@ void FffGcodeWriter::addMeshLayerToGCode(
     if (mesh.isPrinted()) //"normal" meshes with walls, skin, infill, etc. get the traditional part ordering based on the z-seam settings.
     {
         z_seam_config = ZSeamConfig(
-            mesh.settings.get<EZSeamType>("z_seam_type"),
+            mesh.settings.get<EZSeamType>("z_seam_type"_setting),
             mesh.getZSeamHint(),
-            mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"),
-            mesh.settings.get<coord_t>("wall_line_width_0") * 2);
+            mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"_setting),
+            mesh.settings.get<coord_t>("wall_line_width_0"_setting) * 2);
     }
     PathOrderOptimizer<SliceLayerPart*> part_order_optimizer(gcode_layer.getLastPlannedPositionOrStartingPosition(), z_seam_config);
     for (SliceLayerPart& part : layer.parts)
@@ -1828,12 +1913,12 @@ void FffGcodeWriter::addMeshLayerToGCode(
         addMeshPartToGCode(storage, mesh, extruder_nr, mesh_config, *path.vertices_, gcode_layer);
     }
 
-    const std::string extruder_identifier = (mesh.settings.get<size_t>("roofing_layer_count") > 0) ? "roofing_extruder_nr" : "top_bottom_extruder_nr";
+    const std::string extruder_identifier = (mesh.settings.get<size_t>("roofing_layer_count"_setting) > 0) ? "roofing_extruder_nr" : "top_bottom_extruder_nr";
     if (extruder_nr == mesh.settings.get<ExtruderTrain&>(extruder_identifier).extruder_nr_)
     {
         processIroning(storage, mesh, layer, mesh_config.ironing_config, gcode_layer);
     }
-    if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL && extruder_nr == mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_)
+    if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) != ESurfaceMode::NORMAL && extruder_nr == mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_)
     {
         addMeshOpenPolyLinesToGCode(mesh, mesh_config, gcode_layer);
     }
@@ -1849,11 +1934,11 @@ void FffGcodeWriter::addMeshPartToGCode(
     LayerPlan& gcode_layer) const
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    const bool infill_before_walls = mesh.settings.get<bool>("infill_before_walls");
+    const bool infill_before_walls = mesh.settings.get<bool>("infill_before_walls"_setting);
     bool added_something = false;
 
     const bool end_infill_close_to_seam
-        = infill_before_walls && mesh.settings.get<InfillStartEndPreference>("infill_start_end_preference") == InfillStartEndPreference::END_CLOSE_TO_SEAM;
+        = infill_before_walls && mesh.settings.get<InfillStartEndPreference>("infill_start_end_preference"_setting) == InfillStartEndPreference::END_CLOSE_TO_SEAM;
 
     // Pre-process the insets without actually adding them, so that we know where they are going to start printing
     InsetsPreprocessResult insets_preprocess_result = preProcessInsets(storage, gcode_layer, mesh, extruder_nr, mesh_config, part, end_infill_close_to_seam);
@@ -1881,12 +1966,12 @@ void FffGcodeWriter::addMeshPartToGCode(
     added_something = added_something | processSkin(storage, gcode_layer, mesh, extruder_nr, mesh_config, part);
 
     // After a layer part, make sure the nozzle is inside the comb boundary, so we do not retract on the perimeter.
-    if (added_something && (! mesh_group_settings.get<bool>("magic_spiralize") || gcode_layer.getLayerNr() < LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"))))
+    if (added_something && (! mesh_group_settings.get<bool>("magic_spiralize"_setting) || gcode_layer.getLayerNr() < LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"_setting))))
     {
-        coord_t innermost_wall_line_width = mesh.settings.get<coord_t>((mesh.settings.get<size_t>("wall_line_count") > 1) ? "wall_line_width_x" : "wall_line_width_0");
+        coord_t innermost_wall_line_width = mesh.settings.get<coord_t>((mesh.settings.get<size_t>("wall_line_count"_setting) > 1) ? "wall_line_width_x" : "wall_line_width_0");
         if (gcode_layer.getLayerNr() == 0)
         {
-            innermost_wall_line_width *= mesh.settings.get<Ratio>("initial_layer_line_width_factor");
+            innermost_wall_line_width *= mesh.settings.get<Ratio>("initial_layer_line_width_factor"_setting);
         }
         gcode_layer.moveInsideCombBoundary(innermost_wall_line_width, part);
     }
@@ -1908,8 +1993,8 @@ bool FffGcodeWriter::processInfill(
         return false;
     }
 
-    const coord_t infill_start_move_inwards_length = mesh.settings.get<coord_t>("infill_start_move_inwards_length");
-    const coord_t infill_end_move_inwards_length = mesh.settings.get<coord_t>("infill_end_move_inwards_length");
+    const coord_t infill_start_move_inwards_length = mesh.settings.get<coord_t>("infill_start_move_inwards_length"_setting);
+    const coord_t infill_end_move_inwards_length = mesh.settings.get<coord_t>("infill_end_move_inwards_length"_setting);
 
     const bool added_something
         = processMultiLayerInfill(gcode_layer, mesh, extruder_nr, mesh_config, part, infill_start_move_inwards_length, infill_end_move_inwards_length, near_end_location)
@@ -1932,33 +2017,33 @@ bool FffGcodeWriter::processMultiLayerInfill(
     {
         return false;
     }
-    const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
+    const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance"_setting);
     if (infill_line_distance <= 0)
     {
         return false;
     }
-    coord_t max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution");
-    coord_t max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation");
+    coord_t max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+    coord_t max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation"_setting);
     AngleDegrees infill_angle = 45; // Original default. This will get updated to an element from mesh->infill_angles.
     if (! mesh.infill_angles.empty())
     {
         const size_t combined_infill_layers
-            = std::max(uint64_t(1), round_divide(mesh.settings.get<coord_t>("infill_sparse_thickness"), std::max(mesh.settings.get<coord_t>("layer_height"), coord_t(1))));
+            = std::max(uint64_t(1), round_divide(mesh.settings.get<coord_t>("infill_sparse_thickness"_setting), std::max(mesh.settings.get<coord_t>("layer_height"_setting), coord_t(1))));
         infill_angle = mesh.infill_angles.at((gcode_layer.getLayerNr() / combined_infill_layers) % mesh.infill_angles.size());
     }
     const Point3LL mesh_middle = mesh.bounding_box.getMiddle();
-    const Point2LL infill_origin(mesh_middle.x_ + mesh.settings.get<coord_t>("infill_offset_x"), mesh_middle.y_ + mesh.settings.get<coord_t>("infill_offset_y"));
+    const Point2LL infill_origin(mesh_middle.x_ + mesh.settings.get<coord_t>("infill_offset_x"_setting), mesh_middle.y_ + mesh.settings.get<coord_t>("infill_offset_y"_setting));
 
     // Print the thicker infill lines first. (double or more layer thickness, infill combined with previous layers)
     bool added_something = false;
     for (unsigned int combine_idx = 1; combine_idx < part.infill_area_per_combine_per_density[0].size(); combine_idx++)
     {
         const coord_t infill_line_width = mesh_config.infill_config[combine_idx].getLineWidth();
-        const EFillMethod infill_pattern = mesh.settings.get<EFillMethod>("infill_pattern");
-        const bool zig_zaggify_infill = mesh.settings.get<bool>("zig_zaggify_infill") || infill_pattern == EFillMethod::ZIG_ZAG;
-        const bool connect_polygons = mesh.settings.get<bool>("connect_infill_polygons");
-        const size_t infill_multiplier = mesh.settings.get<size_t>("infill_multiplier");
-        const coord_t minimum_infill_line_length = mesh.settings.get<coord_t>("minimum_infill_line_length");
+        const EFillMethod infill_pattern = mesh.settings.get<EFillMethod>("infill_pattern"_setting);
+        const bool zig_zaggify_infill = mesh.settings.get<bool>("zig_zaggify_infill"_setting) || infill_pattern == EFillMethod::ZIG_ZAG;
+        const bool connect_polygons = mesh.settings.get<bool>("connect_infill_polygons"_setting);
+        const size_t infill_multiplier = mesh.settings.get<size_t>("infill_multiplier"_setting);
+        const coord_t minimum_infill_line_length = mesh.settings.get<coord_t>("minimum_infill_line_length"_setting);
         Shape infill_polygons;
         OpenLinesSet infill_lines;
         std::vector<VariableWidthLines> infill_paths = part.infill_wall_toolpaths;
@@ -1975,7 +2060,7 @@ bool FffGcodeWriter::processMultiLayerInfill(
 
             constexpr size_t wall_line_count = 0; // wall toolpaths are when gradual infill areas are determined
             const coord_t small_area_width = 0;
-            const coord_t infill_overlap = mesh.settings.get<coord_t>("infill_overlap_mm");
+            const coord_t infill_overlap = mesh.settings.get<coord_t>("infill_overlap_mm"_setting);
             constexpr bool skip_stitching = false;
             constexpr bool connected_zigzags = false;
             constexpr bool use_endpieces = true;
@@ -2011,7 +2096,7 @@ bool FffGcodeWriter::processMultiLayerInfill(
                 use_endpieces,
                 skip_some_zags,
                 zag_skip_count,
-                mesh.settings.get<coord_t>("cross_infill_pocket_size"));
+                mesh.settings.get<coord_t>("cross_infill_pocket_size"_setting));
             infill_comp.generate(
                 infill_paths,
                 infill_polygons,
@@ -2048,7 +2133,7 @@ bool FffGcodeWriter::processMultiLayerInfill(
             {
                 std::optional<Point2LL> near_start_location;
                 bool reverse_print_direction = false;
-                if (mesh.settings.get<InfillStartEndPreference>("infill_start_end_preference") == InfillStartEndPreference::START_RANDOM)
+                if (mesh.settings.get<InfillStartEndPreference>("infill_start_end_preference"_setting) == InfillStartEndPreference::START_RANDOM)
                 {
                     srand(gcode_layer.getLayerNr());
                     near_start_location = infill_lines[rand() % infill_lines.size()][0];
@@ -2061,7 +2146,7 @@ bool FffGcodeWriter::processMultiLayerInfill(
                 // The InfillStartEndPreference::START_CLOSEST case leaves the near_start_location empty, so that current location will be used
 
                 constexpr coord_t wipe_dist = 0;
-                const bool enable_travel_optimization = mesh.settings.get<bool>("infill_enable_travel_optimization");
+                const bool enable_travel_optimization = mesh.settings.get<bool>("infill_enable_travel_optimization"_setting);
                 constexpr Ratio flow_ratio = 1.0_r;
                 constexpr double fan_speed = GCodePathConfig::FAN_SPEED_DEFAULT;
                 const std::unordered_multimap<const Polyline*, const Polyline*> order_requirements = PathOrderOptimizer<const Polyline*>::no_order_requirements_;
@@ -2121,7 +2206,7 @@ bool FffGcodeWriter::processSingleLayerInfill(
     {
         return false;
     }
-    const auto infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
+    const auto infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance"_setting);
     if (infill_line_distance == 0 || part.infill_area_per_combine_per_density[0].empty())
     {
         return false;
@@ -2135,28 +2220,28 @@ bool FffGcodeWriter::processSingleLayerInfill(
     OpenLinesSet skin_support_lines;
     Shape skin_support_polygons;
 
-    const auto pattern = mesh.settings.get<EFillMethod>("infill_pattern");
-    const bool zig_zaggify_infill = mesh.settings.get<bool>("zig_zaggify_infill") || pattern == EFillMethod::ZIG_ZAG;
-    const bool connect_polygons = mesh.settings.get<bool>("connect_infill_polygons");
-    const auto infill_overlap = mesh.settings.get<coord_t>("infill_overlap_mm");
-    const auto infill_multiplier = mesh.settings.get<size_t>("infill_multiplier");
-    const auto wall_line_count = mesh.settings.get<size_t>("infill_wall_line_count");
+    const auto pattern = mesh.settings.get<EFillMethod>("infill_pattern"_setting);
+    const bool zig_zaggify_infill = mesh.settings.get<bool>("zig_zaggify_infill"_setting) || pattern == EFillMethod::ZIG_ZAG;
+    const bool connect_polygons = mesh.settings.get<bool>("connect_infill_polygons"_setting);
+    const auto infill_overlap = mesh.settings.get<coord_t>("infill_overlap_mm"_setting);
+    const auto infill_multiplier = mesh.settings.get<size_t>("infill_multiplier"_setting);
+    const auto wall_line_count = mesh.settings.get<size_t>("infill_wall_line_count"_setting);
     const size_t last_idx = part.infill_area_per_combine_per_density.size() - 1;
-    const auto max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution");
-    const auto max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation");
-    const coord_t overlap = mesh.settings.get<coord_t>("infill_overlap_mm");
-    const auto skin_support_density = mesh.settings.get<Ratio>("skin_support_density");
-    const coord_t minimum_infill_line_length = mesh.settings.get<coord_t>("minimum_infill_line_length");
+    const auto max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const auto max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation"_setting);
+    const coord_t overlap = mesh.settings.get<coord_t>("infill_overlap_mm"_setting);
+    const auto skin_support_density = mesh.settings.get<Ratio>("skin_support_density"_setting);
+    const coord_t minimum_infill_line_length = mesh.settings.get<coord_t>("minimum_infill_line_length"_setting);
     const coord_t skin_support_line_distance = skin_support_density > 0.0 ? (infill_line_width / skin_support_density) : 0;
     AngleDegrees infill_angle = 45; // Original default. This will get updated to an element from mesh->infill_angles.
     if (! mesh.infill_angles.empty())
     {
         const size_t combined_infill_layers
-            = std::max(uint64_t(1), round_divide(mesh.settings.get<coord_t>("infill_sparse_thickness"), std::max(mesh.settings.get<coord_t>("layer_height"), coord_t(1))));
+            = std::max(uint64_t(1), round_divide(mesh.settings.get<coord_t>("infill_sparse_thickness"_setting), std::max(mesh.settings.get<coord_t>("layer_height"_setting), coord_t(1))));
         infill_angle = mesh.infill_angles.at((static_cast<size_t>(gcode_layer.getLayerNr()) / combined_infill_layers) % mesh.infill_angles.size());
     }
     const Point3LL mesh_middle = mesh.bounding_box.getMiddle();
-    const Point2LL infill_origin(mesh_middle.x_ + mesh.settings.get<coord_t>("infill_offset_x"), mesh_middle.y_ + mesh.settings.get<coord_t>("infill_offset_y"));
+    const Point2LL infill_origin(mesh_middle.x_ + mesh.settings.get<coord_t>("infill_offset_x"_setting), mesh_middle.y_ + mesh.settings.get<coord_t>("infill_offset_y"_setting));
 
     auto get_cut_offset = [](const bool zig_zaggify, const coord_t line_width, const size_t line_count)
     {
@@ -2182,7 +2267,7 @@ bool FffGcodeWriter::processSingleLayerInfill(
 
     if (! infill_below_skin.empty())
     {
-        const auto infill_wall_line_count = static_cast<coord_t>(mesh.settings.get<size_t>("infill_wall_line_count"));
+        const auto infill_wall_line_count = static_cast<coord_t>(mesh.settings.get<size_t>("infill_wall_line_count"_setting));
         const coord_t infill_wall_offset = -infill_wall_line_count * infill_line_width;
         const Shape infill_contour = part.infill_area.offset(infill_overlap + infill_wall_offset);
         const LayerPlan* completed_layer_below = layer_plan_buffer.getCompletedLayerPlan(gcode_layer.getLayerNr() - 1);
@@ -2191,7 +2276,7 @@ bool FffGcodeWriter::processSingleLayerInfill(
         infill_not_below_skin = infill_not_below_skin.difference(infill_below_skin);
     }
 
-    const auto pocket_size = mesh.settings.get<coord_t>("cross_infill_pocket_size");
+    const auto pocket_size = mesh.settings.get<coord_t>("cross_infill_pocket_size"_setting);
     constexpr bool skip_stitching = false;
     constexpr bool connected_zigzags = false;
     const bool use_endpieces = part.infill_area_per_combine_per_density.size() == 1; // Only use endpieces when not using gradual infill, since they will then overlap.
@@ -2389,7 +2474,7 @@ bool FffGcodeWriter::processSingleLayerInfill(
 
     wall_tool_paths.emplace_back(part.infill_wall_toolpaths); // The extra infill walls were generated separately. Add these too.
 
-    const auto skin_support_interlace_lines = mesh.settings.get<bool>("skin_support_interlace_lines");
+    const auto skin_support_interlace_lines = mesh.settings.get<bool>("skin_support_interlace_lines"_setting);
 
     InfillOrderOptimizer optimizer;
     optimizer.addPart(InfillOrderOptimizer::InfillPartArea::Infill, infill_lines);
@@ -2482,7 +2567,7 @@ void FffGcodeWriter::partitionInfillBySkinAbove(
     const SliceLayerPart& part,
     coord_t infill_line_width)
 {
-    const bool skin_support = mesh.settings.get<bool>("skin_support");
+    const bool skin_support = mesh.settings.get<bool>("skin_support"_setting);
 
     if (! skin_support)
     {
@@ -2557,7 +2642,7 @@ void FffGcodeWriter::processSpiralizedWall(
             last_seam_vertex_idx = storage.spiralize_seam_vertex_indices[layer_nr - 1];
         }
     }
-    const bool is_bottom_layer = (layer_nr == mesh.settings.get<LayerIndex>("initial_bottom_layers"));
+    const bool is_bottom_layer = (layer_nr == mesh.settings.get<LayerIndex>("initial_bottom_layers"_setting));
     const bool is_top_layer = ((size_t)layer_nr == (storage.spiralize_wall_outlines.size() - 1) || storage.spiralize_wall_outlines[layer_nr + 1] == nullptr);
     const int seam_vertex_idx = storage.spiralize_seam_vertex_indices[layer_nr]; // use pre-computed seam vertex index for current layer
     // output a wall slice that is interpolated between the last and current walls
@@ -2580,15 +2665,15 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
     {
         return {};
     }
-    if (mesh.settings.get<size_t>("wall_line_count") <= 0)
+    if (mesh.settings.get<size_t>("wall_line_count"_setting) <= 0)
     {
         return {};
     }
 
     InsetsPreprocessResult result;
-    if (Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("magic_spiralize"))
+    if (Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("magic_spiralize"_setting))
     {
-        const auto initial_bottom_layers = LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"));
+        const auto initial_bottom_layers = LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"_setting));
         const auto layer_nr = gcode_layer.getLayerNr();
         if ((layer_nr < initial_bottom_layers && part.wall_toolpaths.empty()) // The bottom layers in spiralize mode are generated using the variable width paths
             || (layer_nr >= initial_bottom_layers && part.spiral_wall.empty())) // The rest of the layers in spiralize mode are using the spiral wall
@@ -2631,9 +2716,9 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
 
         const auto& mesh_group = Application::getInstance().current_slice_->scene.current_mesh_group;
         const Settings& mesh_group_settings = mesh_group->settings;
-        if (mesh_group_settings.get<bool>("support_enable") || mesh_group->has_painted_support)
+        if (mesh_group_settings.get<bool>("support_enable"_setting) || mesh_group->has_painted_support)
         {
-            const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance");
+            const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance"_setting);
             const size_t z_distance_top_layers = (z_distance_top / layer_height) + 1;
             const int support_layer_nr = gcode_layer.getLayerNr() - z_distance_top_layers;
 
@@ -2669,7 +2754,7 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
 
         outlines_below = outlines_below.offset(-half_outer_wall_width).offset(half_outer_wall_width);
 
-        if (mesh.settings.get<bool>("bridge_settings_enabled"))
+        if (mesh.settings.get<bool>("bridge_settings_enabled"_setting))
         {
             // max_air_gap is the max allowed width of the unsupported region below the wall line
             // if the unsupported region is wider than max_air_gap, the wall line will be printed using bridge settings
@@ -2690,7 +2775,7 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
             Shape bridge_mask = compressed_air.offset(max_air_gap + compensate_outline_distance);
             gcode_layer.setBridgeWallMask(bridge_mask);
 
-            const coord_t skin_overlap = mesh.settings.get<coord_t>("skin_overlap_mm");
+            const coord_t skin_overlap = mesh.settings.get<coord_t>("skin_overlap_mm"_setting);
 
             // Override flooring/skin areas to register bridging areas to be treated as normal skin
             for (SkinPart& skin_part : part.skin_parts)
@@ -2733,9 +2818,9 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
 
         // Build supported regions for all the overhang speeds. For a visual explanation of the result, see doc/gradual_overhang_speed.svg
         std::vector<LayerPlan::OverhangMask> overhang_masks;
-        const auto overhang_speed_factors = mesh.settings.get<std::vector<Ratio>>("wall_overhang_speed_factors");
+        const auto overhang_speed_factors = mesh.settings.get<std::vector<Ratio>>("wall_overhang_speed_factors"_setting);
         const size_t overhang_angles_count = overhang_speed_factors.size();
-        const auto wall_overhang_angle = mesh.settings.get<AngleDegrees>("wall_overhang_angle");
+        const auto wall_overhang_angle = mesh.settings.get<AngleDegrees>("wall_overhang_angle"_setting);
         if (overhang_angles_count > 0 && wall_overhang_angle < 90.0)
         {
             struct SpeedRegion
@@ -2785,7 +2870,7 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
 
         // the seam overhang mask is set to the area of the current part's outline minus the region that is considered to be supported,
         // which will then be empty if everything is considered supported i.r.t. the angle
-        const AngleDegrees seam_overhang_angle = mesh.settings.get<AngleDegrees>("seam_overhang_angle");
+        const AngleDegrees seam_overhang_angle = mesh.settings.get<AngleDegrees>("seam_overhang_angle"_setting);
         if (seam_overhang_angle < 90.0)
         {
             const auto seam_overhang_mask
@@ -2797,11 +2882,11 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
             gcode_layer.setSeamOverhangMask(Shape());
         }
 
-        const auto wall_line_width_0 = mesh.settings.get<coord_t>("wall_line_width_0");
+        const auto wall_line_width_0 = mesh.settings.get<coord_t>("wall_line_width_0"_setting);
 
         const auto roofing_mask_fn = [&]() -> Shape
         {
-            const size_t roofing_layer_count = std::min(mesh.settings.get<size_t>("roofing_layer_count"), mesh.settings.get<size_t>("top_layers"));
+            const size_t roofing_layer_count = std::min(mesh.settings.get<size_t>("roofing_layer_count"_setting), mesh.settings.get<size_t>("top_layers"_setting));
 
             auto roofing_mask = storage.getMachineBorder(mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_);
 
@@ -2824,7 +2909,7 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
 
         const auto flooring_mask_fn = [&]() -> Shape
         {
-            const size_t flooring_layer_count = std::min(mesh.settings.get<size_t>("flooring_layer_count"), mesh.settings.get<size_t>("bottom_layers"));
+            const size_t flooring_layer_count = std::min(mesh.settings.get<size_t>("flooring_layer_count"_setting), mesh.settings.get<size_t>("bottom_layers"_setting));
 
             auto flooring_mask = storage.getMachineBorder(mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_);
 
@@ -2864,10 +2949,10 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
         // Main case: Optimize the insets with the InsetOrderOptimizer.
         const coord_t wall_x_wipe_dist = 0;
         const ZSeamConfig z_seam_config(
-            mesh.settings.get<EZSeamType>("z_seam_type"),
+            mesh.settings.get<EZSeamType>("z_seam_type"_setting),
             mesh.getZSeamHint(),
-            mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"),
-            mesh.settings.get<coord_t>("wall_line_width_0") * 2);
+            mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"_setting),
+            mesh.settings.get<coord_t>("wall_line_width_0"_setting) * 2);
         const Shape disallowed_areas_for_seams;
         constexpr bool scarf_seam = true;
         constexpr bool smooth_speed = true;
@@ -2885,7 +2970,7 @@ FffGcodeWriter::InsetsPreprocessResult FffGcodeWriter::preProcessInsets(
             mesh_config.insetX_flooring_config,
             mesh_config.bridge_inset0_config,
             mesh_config.bridge_insetX_config,
-            mesh.settings.get<coord_t>("wall_0_wipe_dist"),
+            mesh.settings.get<coord_t>("wall_0_wipe_dist"_setting),
             wall_x_wipe_dist,
             mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_,
             mesh.settings.get<ExtruderTrain&>("wall_x_extruder_nr").extruder_nr_,
@@ -2917,7 +3002,7 @@ bool FffGcodeWriter::endProcessInsets(
     if (preprocess_result.spiralize)
     {
         bool added_something = false;
-        const auto initial_bottom_layers = LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"));
+        const auto initial_bottom_layers = LayerIndex(mesh.settings.get<size_t>("initial_bottom_layers"_setting));
 
         if (gcode_layer.getLayerNr() == initial_bottom_layers && extruder_nr == mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_)
         { // on the last normal layer first make the outer wall normally and then start a second outer wall from the same hight, but gradually moving upward
@@ -2957,7 +3042,7 @@ bool FffGcodeWriter::endProcessInsets(
     }
     else if (preprocess_result.walls_optimizer != nullptr)
     {
-        auto travel_retract_before_outer_wall = mesh.settings.get<RetractBeforeOuterWall>("travel_retract_before_outer_wall");
+        auto travel_retract_before_outer_wall = mesh.settings.get<RetractBeforeOuterWall>("travel_retract_before_outer_wall"_setting);
         if (travel_retract_before_outer_wall == RetractBeforeOuterWall::NOT_RETRACTED_FROM_INFILL && ! infill_added)
         {
             travel_retract_before_outer_wall = RetractBeforeOuterWall::AUTOMATIC;
@@ -3017,8 +3102,8 @@ bool FffGcodeWriter::processSkin(
     const size_t roofing_extruder_nr = mesh.settings.get<ExtruderTrain&>("roofing_extruder_nr").extruder_nr_;
     const size_t flooring_extruder_nr = mesh.settings.get<ExtruderTrain&>("flooring_extruder_nr").extruder_nr_;
     const size_t wall_0_extruder_nr = mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_;
-    const size_t roofing_layer_count = std::min(mesh.settings.get<size_t>("roofing_layer_count"), mesh.settings.get<size_t>("top_layers"));
-    const size_t flooring_layer_count = std::min(mesh.settings.get<size_t>("flooring_layer_count"), mesh.settings.get<size_t>("bottom_layers"));
+    const size_t roofing_layer_count = std::min(mesh.settings.get<size_t>("roofing_layer_count"_setting), mesh.settings.get<size_t>("top_layers"_setting));
+    const size_t flooring_layer_count = std::min(mesh.settings.get<size_t>("flooring_layer_count"_setting), mesh.settings.get<size_t>("bottom_layers"_setting));
     if (extruder_nr != top_bottom_extruder_nr && extruder_nr != wall_0_extruder_nr && (extruder_nr != roofing_extruder_nr || roofing_layer_count == 0)
         && (extruder_nr != flooring_extruder_nr || flooring_layer_count == 0))
     {
@@ -3148,7 +3233,7 @@ void FffGcodeWriter::processTopBottom(
 
     const size_t layer_nr = gcode_layer.getLayerNr();
 
-    EFillMethod pattern = (layer_nr == 0) ? mesh.settings.get<EFillMethod>("top_bottom_pattern_0") : mesh.settings.get<EFillMethod>("top_bottom_pattern");
+    EFillMethod pattern = (layer_nr == 0) ? mesh.settings.get<EFillMethod>("top_bottom_pattern_0"_setting) : mesh.settings.get<EFillMethod>("top_bottom_pattern"_setting);
 
     AngleDegrees skin_angle = 45;
     if (mesh.skin_angles.size() > 0)
@@ -3160,10 +3245,10 @@ void FffGcodeWriter::processTopBottom(
     const GCodePathConfig* skin_config = &mesh_config.skin_config;
     Ratio skin_density = 1.0;
     const coord_t skin_overlap = 0; // Skin overlap offset is applied in skin.cpp more overlap might be beneficial for curved bridges, but makes it worse in general.
-    const bool bridge_settings_enabled = mesh.settings.get<bool>("bridge_settings_enabled");
-    const bool bridge_enable_more_layers = bridge_settings_enabled && mesh.settings.get<bool>("bridge_enable_more_layers");
-    const Ratio support_threshold = bridge_settings_enabled ? mesh.settings.get<Ratio>("bridge_skin_support_threshold") : 0.0_r;
-    const size_t bottom_layers = mesh.settings.get<size_t>("bottom_layers");
+    const bool bridge_settings_enabled = mesh.settings.get<bool>("bridge_settings_enabled"_setting);
+    const bool bridge_enable_more_layers = bridge_settings_enabled && mesh.settings.get<bool>("bridge_enable_more_layers"_setting);
+    const Ratio support_threshold = bridge_settings_enabled ? mesh.settings.get<Ratio>("bridge_skin_support_threshold"_setting) : 0.0_r;
+    const size_t bottom_layers = mesh.settings.get<size_t>("bottom_layers"_setting);
     std::optional<coord_t> forced_small_area_width;
 
     // if support is enabled, consider the support outlines so we don't generate bridges over support
@@ -3171,10 +3256,10 @@ void FffGcodeWriter::processTopBottom(
     int support_layer_nr = -1;
     const SupportLayer* support_layer = nullptr;
 
-    if (mesh_group_settings.get<bool>("support_enable") || mesh_group->has_painted_support)
+    if (mesh_group_settings.get<bool>("support_enable"_setting) || mesh_group->has_painted_support)
     {
         const coord_t layer_height = mesh_config.inset0_config.getLayerThickness();
-        const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance");
+        const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance"_setting);
         const size_t z_distance_top_layers = (z_distance_top / layer_height) + 1;
         support_layer_nr = layer_nr - z_distance_top_layers;
     }
@@ -3190,7 +3275,7 @@ void FffGcodeWriter::processTopBottom(
 
         Shape supported_skin_part_regions;
 
-        const std::optional<AngleDegrees> bridge_angle = bridgeAngle(mesh, skin_fill, storage, layer_nr, bridge_layer, support_layer, supported_skin_part_regions);
+        const std::optional<AngleDegrees> bridge_angle = bridgeAngle(mesh, skin_fill, gcode_layer.getBridgeLayerContext(), layer_nr, bridge_layer, support_layer, supported_skin_part_regions);
 
         if (bridge_angle.has_value() || (support_threshold > 0 && (supported_skin_part_regions.area() / (skin_fill.area() + 1) < support_threshold)))
         {
@@ -3238,22 +3323,22 @@ void FffGcodeWriter::processTopBottom(
     bool is_bridge_skin = false;
     if (layer_nr > 0)
     {
-        is_bridge_skin = handle_bridge_skin(1, &mesh_config.bridge_skin_config, mesh.settings.get<Ratio>("bridge_skin_density"));
+        is_bridge_skin = handle_bridge_skin(1, &mesh_config.bridge_skin_config, mesh.settings.get<Ratio>("bridge_skin_density"_setting));
     }
     if (bridge_enable_more_layers && ! is_bridge_skin && layer_nr > 1 && bottom_layers > 1)
     {
-        is_bridge_skin = handle_bridge_skin(2, &mesh_config.bridge_skin_config2, mesh.settings.get<Ratio>("bridge_skin_density_2"));
+        is_bridge_skin = handle_bridge_skin(2, &mesh_config.bridge_skin_config2, mesh.settings.get<Ratio>("bridge_skin_density_2"_setting));
 
         if (! is_bridge_skin && layer_nr > 2 && bottom_layers > 2)
         {
-            is_bridge_skin = handle_bridge_skin(3, &mesh_config.bridge_skin_config3, mesh.settings.get<Ratio>("bridge_skin_density_3"));
+            is_bridge_skin = handle_bridge_skin(3, &mesh_config.bridge_skin_config3, mesh.settings.get<Ratio>("bridge_skin_density_3"_setting));
         }
     }
 
     double fan_speed = GCodePathConfig::FAN_SPEED_DEFAULT;
 
-    if (layer_nr > 0 && skin_config == &mesh_config.skin_config && support_layer_nr >= 0 && mesh.settings.get<bool>("support_fan_enable")
-        && mesh.settings.get<bool>("cool_fan_enabled"))
+    if (layer_nr > 0 && skin_config == &mesh_config.skin_config && support_layer_nr >= 0 && mesh.settings.get<bool>("support_fan_enable"_setting)
+        && mesh.settings.get<bool>("cool_fan_enabled"_setting))
     {
         // skin isn't a bridge but is it above support and we need to modify the fan speed?
 
@@ -3290,16 +3375,16 @@ void FffGcodeWriter::processTopBottom(
 
         if (supported)
         {
-            fan_speed = mesh.settings.get<Ratio>("support_supported_skin_fan_speed") * 100.0;
+            fan_speed = mesh.settings.get<Ratio>("support_supported_skin_fan_speed"_setting) * 100.0;
         }
     }
 
     LinesOrderingMethod ordering;
     if (is_bridge_skin)
     {
-        ordering = mesh.settings.get<bool>("bridge_interlace_lines") ? LinesOrderingMethod::Interlaced : LinesOrderingMethod::Basic;
+        ordering = mesh.settings.get<bool>("bridge_interlace_lines"_setting) ? LinesOrderingMethod::Interlaced : LinesOrderingMethod::Basic;
     }
-    else if (mesh.settings.get<bool>("skin_monotonic"))
+    else if (mesh.settings.get<bool>("skin_monotonic"_setting))
     {
         ordering = LinesOrderingMethod::Monotonic;
     }
@@ -3350,11 +3435,11 @@ void FffGcodeWriter::processSkinPrintFeature(
 
     constexpr int infill_multiplier = 1;
     constexpr int extra_infill_shift = 0;
-    const size_t wall_line_count = mesh.settings.get<size_t>("skin_outline_count");
+    const size_t wall_line_count = mesh.settings.get<size_t>("skin_outline_count"_setting);
     const bool zig_zaggify_infill = pattern == EFillMethod::ZIG_ZAG;
-    const bool connect_polygons = mesh.settings.get<bool>("connect_skin_polygons");
-    coord_t max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution");
-    coord_t max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation");
+    const bool connect_polygons = mesh.settings.get<bool>("connect_skin_polygons"_setting);
+    coord_t max_resolution = mesh.settings.get<coord_t>("meshfix_maximum_resolution"_setting);
+    coord_t max_deviation = mesh.settings.get<coord_t>("meshfix_maximum_deviation"_setting);
     const Point2LL infill_origin;
     const bool skip_line_stitching = ordering == LinesOrderingMethod::Monotonic || ordering == LinesOrderingMethod::Interlaced;
     constexpr bool fill_gaps = true;
@@ -3363,10 +3448,10 @@ void FffGcodeWriter::processSkinPrintFeature(
     constexpr bool skip_some_zags = false;
     constexpr int zag_skip_count = 0;
     constexpr coord_t pocket_size = 0;
-    const bool small_areas_on_surface = mesh.settings.get<bool>("small_skin_on_surface");
+    const bool small_areas_on_surface = mesh.settings.get<bool>("small_skin_on_surface"_setting);
     const coord_t line_width = config.getLineWidth();
     const coord_t small_area_width
-        = forced_small_area_width.value_or((small_areas_on_surface || ! is_roofing_flooring) ? mesh.settings.get<coord_t>("small_skin_width") : line_width / 4);
+        = forced_small_area_width.value_or((small_areas_on_surface || ! is_roofing_flooring) ? mesh.settings.get<coord_t>("small_skin_width"_setting) : line_width / 4);
     const auto& current_layer = mesh.layers[gcode_layer.getLayerNr()];
     const auto& exposed_to_air = current_layer.top_surface.areas.unionPolygons(current_layer.bottom_surface);
 
@@ -3416,9 +3501,9 @@ void FffGcodeWriter::processSkinPrintFeature(
             // Add skin-walls a.k.a. skin-perimeters, skin-insets.
             constexpr coord_t wipe_dist = 0;
             const ZSeamConfig z_seam_config(
-                mesh.settings.get<EZSeamType>("z_seam_type"),
+                mesh.settings.get<EZSeamType>("z_seam_type"_setting),
                 mesh.getZSeamHint(),
-                mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"),
+                mesh.settings.get<EZSeamCornerPrefType>("z_seam_corner"_setting),
                 config.getLineWidth() * 2);
             InsetOrderOptimizer wall_orderer(
                 storage,
@@ -3469,7 +3554,7 @@ void FffGcodeWriter::processSkinPrintFeature(
                     monotonic_direction,
                     max_adjacent_distance,
                     exclude_distance,
-                    mesh.settings.get<coord_t>("infill_wipe_dist"),
+                    mesh.settings.get<coord_t>("infill_wipe_dist"_setting),
                     flow,
                     fan_speed,
                     interlaced);
@@ -3496,7 +3581,7 @@ void FffGcodeWriter::processSkinPrintFeature(
         {
             std::optional<Point2LL> near_start_location;
             const EFillMethod actual_pattern
-                = (gcode_layer.getLayerNr() == 0) ? mesh.settings.get<EFillMethod>("top_bottom_pattern_0") : mesh.settings.get<EFillMethod>("top_bottom_pattern");
+                = (gcode_layer.getLayerNr() == 0) ? mesh.settings.get<EFillMethod>("top_bottom_pattern_0"_setting) : mesh.settings.get<EFillMethod>("top_bottom_pattern"_setting);
             if (actual_pattern == EFillMethod::LINES || actual_pattern == EFillMethod::ZIG_ZAG)
             { // update near_start_location to a location which tries to avoid seams in skin
                 near_start_location = getSeamAvoidingLocation(area, skin_angle, gcode_layer.getLastPlannedPositionOrStartingPosition());
@@ -3513,7 +3598,7 @@ void FffGcodeWriter::processSkinPrintFeature(
                     config,
                     SpaceFillType::Lines,
                     enable_travel_optimization,
-                    mesh.settings.get<coord_t>("infill_wipe_dist"),
+                    mesh.settings.get<coord_t>("infill_wipe_dist"_setting),
                     flow,
                     near_start_location,
                     fan_speed);
@@ -3536,8 +3621,8 @@ bool FffGcodeWriter::processIroning(
     LayerPlan& gcode_layer) const
 {
     bool added_something = false;
-    const bool ironing_enabled = mesh.settings.get<bool>("ironing_enabled");
-    const bool ironing_only_highest_layer = mesh.settings.get<bool>("ironing_only_highest_layer");
+    const bool ironing_enabled = mesh.settings.get<bool>("ironing_enabled"_setting);
+    const bool ironing_only_highest_layer = mesh.settings.get<bool>("ironing_only_highest_layer"_setting);
     if (ironing_enabled && (! ironing_only_highest_layer || mesh.layer_nr_max_filled_layer == gcode_layer.getLayerNr()))
     {
         // Since we are ironing after all the parts are completed, it believes that it is outside.
@@ -3613,15 +3698,15 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
 
     gcode_layer.addLinesByOptimizer(support_layer.base, gcode_layer.configs_storage_.support_infill_config[0], SpaceFillType::PolyLines);
 
-    coord_t default_support_line_distance = infill_extruder.settings_.get<coord_t>("support_line_distance");
+    coord_t default_support_line_distance = infill_extruder.settings_.get<coord_t>("support_line_distance"_setting);
 
     // To improve adhesion for the "support initial layer" the first layer might have different properties
     if (gcode_layer.getLayerNr() == 0)
     {
-        default_support_line_distance = infill_extruder.settings_.get<coord_t>("support_initial_layer_line_distance");
+        default_support_line_distance = infill_extruder.settings_.get<coord_t>("support_initial_layer_line_distance"_setting);
     }
 
-    const coord_t default_support_infill_overlap = infill_extruder.settings_.get<coord_t>("infill_overlap_mm");
+    const coord_t default_support_infill_overlap = infill_extruder.settings_.get<coord_t>("infill_overlap_mm"_setting);
 
     // Helper to get the support infill angle
     const auto get_support_infill_angle = [](const SupportStorage& support_storage, const int layer_nr)
@@ -3637,20 +3722,20 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
     };
     const AngleDegrees support_infill_angle = get_support_infill_angle(storage.support, gcode_layer.getLayerNr());
 
-    const auto infill_multiplier = mesh_group_settings.get<size_t>("support_infill_multiplier");
+    const auto infill_multiplier = mesh_group_settings.get<size_t>("support_infill_multiplier"_setting);
     size_t infill_density_multiplier = 1;
     if (gcode_layer.getLayerNr() <= 0)
     {
-        infill_density_multiplier = infill_extruder.settings_.get<size_t>("support_infill_density_multiplier_initial_layer");
+        infill_density_multiplier = infill_extruder.settings_.get<size_t>("support_infill_density_multiplier_initial_layer"_setting);
     }
 
-    const size_t wall_thickness = infill_extruder.settings_.get<size_t>("support_wall_thickness");
-    const coord_t max_resolution = infill_extruder.settings_.get<coord_t>("meshfix_maximum_resolution");
-    const coord_t max_deviation = infill_extruder.settings_.get<coord_t>("meshfix_maximum_deviation");
-    coord_t default_support_line_width = infill_extruder.settings_.get<coord_t>("support_line_width");
-    if (gcode_layer.getLayerNr() == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") != EPlatformAdhesion::RAFT)
+    const size_t wall_thickness = infill_extruder.settings_.get<size_t>("support_wall_thickness"_setting);
+    const coord_t max_resolution = infill_extruder.settings_.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const coord_t max_deviation = infill_extruder.settings_.get<coord_t>("meshfix_maximum_deviation"_setting);
+    coord_t default_support_line_width = infill_extruder.settings_.get<coord_t>("support_line_width"_setting);
+    if (gcode_layer.getLayerNr() == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting) != EPlatformAdhesion::RAFT)
     {
-        default_support_line_width *= infill_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
+        default_support_line_width *= infill_extruder.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
     }
 
     // Helper to get the support pattern
@@ -3662,11 +3747,11 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
         }
         return pattern;
     };
-    const EFillMethod support_pattern = get_support_pattern(infill_extruder.settings_.get<EFillMethod>("support_pattern"), gcode_layer.getLayerNr());
+    const EFillMethod support_pattern = get_support_pattern(infill_extruder.settings_.get<EFillMethod>("support_pattern"_setting), gcode_layer.getLayerNr());
 
-    const auto zig_zaggify_infill = infill_extruder.settings_.get<bool>("zig_zaggify_support");
-    const auto skip_some_zags = infill_extruder.settings_.get<bool>("support_skip_some_zags");
-    const auto zag_skip_count = infill_extruder.settings_.get<size_t>("support_zag_skip_count");
+    const auto zig_zaggify_infill = infill_extruder.settings_.get<bool>("zig_zaggify_support"_setting);
+    const auto skip_some_zags = infill_extruder.settings_.get<bool>("support_skip_some_zags"_setting);
+    const auto zag_skip_count = infill_extruder.settings_.get<size_t>("support_zag_skip_count"_setting);
 
     // create a list of outlines and use PathOrderOptimizer to optimize the travel move
     PathOrderOptimizer<const SupportInfillPart*> island_order_optimizer_initial(gcode_layer.getLastPlannedPositionOrStartingPosition());
@@ -3678,8 +3763,8 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
     island_order_optimizer_initial.optimize();
     island_order_optimizer.optimize();
 
-    const auto support_connect_zigzags = infill_extruder.settings_.get<bool>("support_connect_zigzags");
-    const auto support_structure = infill_extruder.settings_.get<ESupportStructure>("support_structure");
+    const auto support_connect_zigzags = infill_extruder.settings_.get<bool>("support_connect_zigzags"_setting);
+    const auto support_structure = infill_extruder.settings_.get<ESupportStructure>("support_structure"_setting);
     const Point2LL infill_origin;
 
     constexpr bool use_endpieces = true;
@@ -3707,7 +3792,7 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
             ZSeamConfig z_seam_config
                 = ZSeamConfig(EZSeamType::SHORTEST, gcode_layer.getLastPlannedPositionOrStartingPosition(), EZSeamCornerPrefType::Z_SEAM_CORNER_PREF_INNER, false);
             Shape disallowed_area_for_seams{};
-            if (infill_extruder.settings_.get<bool>("support_z_seam_away_from_model") && (layer_nr >= 0))
+            if (infill_extruder.settings_.get<bool>("support_z_seam_away_from_model"_setting) && (layer_nr >= 0))
             {
                 for (std::shared_ptr<SliceMeshStorage> mesh_ptr : storage.meshes)
                 {
@@ -3719,7 +3804,7 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
                 }
                 if (! disallowed_area_for_seams.empty())
                 {
-                    coord_t min_distance = infill_extruder.settings_.get<coord_t>("support_z_seam_min_distance");
+                    coord_t min_distance = infill_extruder.settings_.get<coord_t>("support_z_seam_min_distance"_setting);
                     disallowed_area_for_seams = disallowed_area_for_seams.offset(min_distance, ClipperLib::jtRound);
                 }
             }
@@ -3830,12 +3915,12 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
                     lightning_layer);
             }
 
-            if (need_travel_to_end_of_last_spiral && infill_extruder.settings_.get<bool>("magic_spiralize"))
+            if (need_travel_to_end_of_last_spiral && infill_extruder.settings_.get<bool>("magic_spiralize"_setting))
             {
                 if ((! wall_toolpaths.empty() || ! support_polygons.empty() || ! support_lines.empty()))
                 {
                     int layer_nr = gcode_layer.getLayerNr();
-                    if (layer_nr > (int)infill_extruder.settings_.get<size_t>("initial_bottom_layers"))
+                    if (layer_nr > (int)infill_extruder.settings_.get<size_t>("initial_bottom_layers"_setting))
                     {
                         // bit of subtlety here... support is being used on a spiralized model and to ensure the travel move from the end of the last spiral
                         // to the start of the support does not go through the model we have to tell the slicer what the current location of the nozzle is
@@ -3853,7 +3938,7 @@ bool FffGcodeWriter::processSupportInfill(const SliceDataStorage& storage, Layer
 
             gcode_layer.setIsInside(false); // going to print stuff outside print object, i.e. support
 
-            const bool alternate_inset_direction = infill_extruder.settings_.get<bool>("material_alternate_walls");
+            const bool alternate_inset_direction = infill_extruder.settings_.get<bool>("material_alternate_walls"_setting);
             const bool alternate_layer_print_direction = alternate_inset_direction && gcode_layer.getLayerNr() % 2 == 1;
 
             if (! support_polygons.empty())
@@ -3957,7 +4042,7 @@ bool FffGcodeWriter::addSupportRoofsToGCode(const SliceDataStorage& storage, con
     const size_t roof_extruder_nr = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<ExtruderTrain&>("support_roof_extruder_nr").extruder_nr_;
     const ExtruderTrain& roof_extruder = Application::getInstance().current_slice_->scene.extruders[roof_extruder_nr];
 
-    const EFillMethod pattern = roof_extruder.settings_.get<EFillMethod>("support_roof_pattern");
+    const EFillMethod pattern = roof_extruder.settings_.get<EFillMethod>("support_roof_pattern"_setting);
     AngleDegrees fill_angle = 0;
     if (! storage.support.support_roof_angles.empty())
     {
@@ -3971,8 +4056,8 @@ bool FffGcodeWriter::addSupportRoofsToGCode(const SliceDataStorage& storage, con
     constexpr coord_t support_roof_overlap = 0; // the roofs should never be expanded outwards
     constexpr size_t infill_multiplier = 1;
     constexpr coord_t extra_infill_shift = 0;
-    const auto wall_line_count = roof_extruder.settings_.get<size_t>("support_roof_wall_count");
-    const coord_t small_area_width = roof_extruder.settings_.get<coord_t>("min_even_wall_line_width") * 2; // Maximum width of a region that can still be filled with one wall.
+    const auto wall_line_count = roof_extruder.settings_.get<size_t>("support_roof_wall_count"_setting);
+    const coord_t small_area_width = roof_extruder.settings_.get<coord_t>("min_even_wall_line_width"_setting) * 2; // Maximum width of a region that can still be filled with one wall.
     const Point2LL infill_origin;
     constexpr bool skip_stitching = false;
     constexpr bool fill_gaps = true;
@@ -3981,14 +4066,14 @@ bool FffGcodeWriter::addSupportRoofsToGCode(const SliceDataStorage& storage, con
     constexpr bool skip_some_zags = false;
     constexpr size_t zag_skip_count = 0;
     constexpr coord_t pocket_size = 0;
-    const coord_t max_resolution = roof_extruder.settings_.get<coord_t>("meshfix_maximum_resolution");
-    const coord_t max_deviation = roof_extruder.settings_.get<coord_t>("meshfix_maximum_deviation");
+    const coord_t max_resolution = roof_extruder.settings_.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const coord_t max_deviation = roof_extruder.settings_.get<coord_t>("meshfix_maximum_deviation"_setting);
 
-    coord_t support_roof_line_distance = roof_extruder.settings_.get<coord_t>("support_roof_line_distance");
-    const coord_t support_roof_line_width = roof_extruder.settings_.get<coord_t>("support_roof_line_width");
+    coord_t support_roof_line_distance = roof_extruder.settings_.get<coord_t>("support_roof_line_distance"_setting);
+    const coord_t support_roof_line_width = roof_extruder.settings_.get<coord_t>("support_roof_line_width"_setting);
     if (gcode_layer.getLayerNr() == 0 && support_roof_line_distance < 2 * support_roof_line_width)
     { // if roof is dense
-        support_roof_line_distance *= roof_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
+        support_roof_line_distance *= roof_extruder.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
     }
 
     Shape infill_outline = support_roof_outlines;
@@ -4087,7 +4172,7 @@ bool FffGcodeWriter::addSupportBottomsToGCode(const SliceDataStorage& storage, L
     const size_t bottom_extruder_nr = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<ExtruderTrain&>("support_bottom_extruder_nr").extruder_nr_;
     const ExtruderTrain& bottom_extruder = Application::getInstance().current_slice_->scene.extruders[bottom_extruder_nr];
 
-    const EFillMethod pattern = bottom_extruder.settings_.get<EFillMethod>("support_bottom_pattern");
+    const EFillMethod pattern = bottom_extruder.settings_.get<EFillMethod>("support_bottom_pattern"_setting);
     AngleDegrees fill_angle = 0;
     if (! storage.support.support_bottom_angles.empty())
     {
@@ -4101,8 +4186,8 @@ bool FffGcodeWriter::addSupportBottomsToGCode(const SliceDataStorage& storage, L
     constexpr coord_t support_bottom_overlap = 0; // the bottoms should never be expanded outwards
     constexpr size_t infill_multiplier = 1;
     constexpr coord_t extra_infill_shift = 0;
-    const auto wall_line_count = bottom_extruder.settings_.get<size_t>("support_bottom_wall_count");
-    const coord_t small_area_width = bottom_extruder.settings_.get<coord_t>("min_even_wall_line_width") * 2; // Maximum width of a region that can still be filled with one wall.
+    const auto wall_line_count = bottom_extruder.settings_.get<size_t>("support_bottom_wall_count"_setting);
+    const coord_t small_area_width = bottom_extruder.settings_.get<coord_t>("min_even_wall_line_width"_setting) * 2; // Maximum width of a region that can still be filled with one wall.
 
     const Point2LL infill_origin;
     constexpr bool skip_stitching = false;
@@ -4112,8 +4197,8 @@ bool FffGcodeWriter::addSupportBottomsToGCode(const SliceDataStorage& storage, L
     constexpr bool skip_some_zags = false;
     constexpr int zag_skip_count = 0;
     constexpr coord_t pocket_size = 0;
-    const coord_t max_resolution = bottom_extruder.settings_.get<coord_t>("meshfix_maximum_resolution");
-    const coord_t max_deviation = bottom_extruder.settings_.get<coord_t>("meshfix_maximum_deviation");
+    const coord_t max_resolution = bottom_extruder.settings_.get<coord_t>("meshfix_maximum_resolution"_setting);
+    const coord_t max_deviation = bottom_extruder.settings_.get<coord_t>("meshfix_maximum_deviation"_setting);
 
     const coord_t support_bottom_line_distance = bottom_extruder.settings_.get<coord_t>(
         "support_bottom_line_distance"); // note: no need to apply initial line width factor; support bottoms cannot exist on the first layer
@@ -4203,10 +4288,10 @@ void FffGcodeWriter::setExtruder_addPrime(const SliceDataStorage& storage, Layer
 
             // We always prime an extruder, but whether it will be a prime blob/poop depends on if prime blob is enabled.
             // This is decided in GCodeExport::writePrimeTrain().
-            if (train.settings_.get<bool>("prime_blob_enable")) // Don't travel to the prime-blob position if not enabled though.
+            if (train.settings_.get<bool>("prime_blob_enable"_setting)) // Don't travel to the prime-blob position if not enabled though.
             {
-                bool prime_pos_is_abs = train.settings_.get<bool>("extruder_prime_pos_abs");
-                Point2LL prime_pos = Point2LL(train.settings_.get<coord_t>("extruder_prime_pos_x"), train.settings_.get<coord_t>("extruder_prime_pos_y"));
+                bool prime_pos_is_abs = train.settings_.get<bool>("extruder_prime_pos_abs"_setting);
+                Point2LL prime_pos = Point2LL(train.settings_.get<coord_t>("extruder_prime_pos_x"_setting), train.settings_.get<coord_t>("extruder_prime_pos_y"_setting));
                 gcode_layer.addTravel(prime_pos_is_abs ? prime_pos : gcode_layer.getLastPlannedPositionOrStartingPosition() + prime_pos);
                 gcode_layer.planPrime();
             }
@@ -4247,48 +4332,48 @@ void FffGcodeWriter::finalize()
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
 
     // In one-at-a-time mode, raise the nozzle to avoid collision with already printed objects during final travel
-    if (mesh_group_settings.get<std::string>("print_sequence") == "one_at_a_time")
+    if (mesh_group_settings.get<std::string>("print_sequence"_setting) == "one_at_a_time")
     {
         gcode.setZ(max_object_height + MM2INT(5));
         Application::getInstance().communication_->sendCurrentPosition(gcode.getPosition());
-        gcode.writeTravel(gcode.getPositionXY(), Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_z_hop"));
+        gcode.writeTravel(gcode.getPositionXY(), Application::getInstance().current_slice_->scene.extruders[gcode.getExtruderNr()].settings_.get<Velocity>("speed_z_hop"_setting));
     }
     // Write the current extruder's end G-code
     const Scene& scene = Application::getInstance().current_slice_->scene;
     const Settings& extruder_settings = scene.extruders[gcode.getExtruderNr()].settings_;
-    const auto extruder_end_code = extruder_settings.get<std::string>("machine_extruder_end_code");
+    const auto extruder_end_code = extruder_settings.get<std::string>("machine_extruder_end_code"_setting);
 
     if (! extruder_end_code.empty())
     {
         gcode.finalizeExtruder(extruder_end_code);
     }
 
-    if (mesh_group_settings.get<bool>("machine_heated_bed"))
+    if (mesh_group_settings.get<bool>("machine_heated_bed"_setting))
     {
         gcode.writeBedTemperatureCommand(0); // Cool down the bed (M140).
         // Nozzles are cooled down automatically after the last time they are used (which might be earlier than the end of the print).
     }
-    if (mesh_group_settings.get<bool>("machine_heated_build_volume") && mesh_group_settings.get<Temperature>("build_volume_temperature") != 0)
+    if (mesh_group_settings.get<bool>("machine_heated_build_volume"_setting) && mesh_group_settings.get<Temperature>("build_volume_temperature"_setting) != 0)
     {
         gcode.writeBuildVolumeTemperatureCommand(0); // Cool down the build volume.
     }
 
     Application::getInstance().communication_->sendSliceUUID(slice_uuid);
-    if (mesh_group_settings.get<bool>("acceleration_enabled"))
+    if (mesh_group_settings.get<bool>("acceleration_enabled"_setting))
     {
-        gcode.writePrintAcceleration(mesh_group_settings.get<Acceleration>("machine_acceleration"));
-        gcode.writeTravelAcceleration(mesh_group_settings.get<Acceleration>("machine_acceleration"));
+        gcode.writePrintAcceleration(mesh_group_settings.get<Acceleration>("machine_acceleration"_setting));
+        gcode.writeTravelAcceleration(mesh_group_settings.get<Acceleration>("machine_acceleration"_setting));
     }
-    if (mesh_group_settings.get<bool>("jerk_enabled"))
+    if (mesh_group_settings.get<bool>("jerk_enabled"_setting))
     {
-        gcode.writeJerk(mesh_group_settings.get<Velocity>("machine_max_jerk_xy"));
+        gcode.writeJerk(mesh_group_settings.get<Velocity>("machine_max_jerk_xy"_setting));
     }
 
     // Replace the setting tokens in start and end g-code.
     // Use values from the first used extruder by default so we get the expected temperatures
-    const auto machine_end_gcode = mesh_group_settings.get<std::string>("machine_end_gcode");
+    const auto machine_end_gcode = mesh_group_settings.get<std::string>("machine_end_gcode"_setting);
 
-    if (! machine_end_gcode.empty() && mesh_group_settings.get<bool>("relative_extrusion"))
+    if (! machine_end_gcode.empty() && mesh_group_settings.get<bool>("relative_extrusion"_setting))
     {
         gcode.writeExtrusionMode(false); // ensure absolute extrusion mode is set before the end gcode
     }
@@ -3,10 +3,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <fstream> // ifstream.good()
 #include <map> // multimap (ordered map allowing duplicate keys)
 #include <numeric>
+#include <optional>
+#include <string_view>
 
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
 // Code smell: Order of the includes is important here, probably due to some forward declarations which might be masking some undefined behaviours
@@ -41,13 +45,11 @@
 #include "infill/SubDivCube.h"
 #include "infill/UniformDensityProvider.h"
 #include "progress/Progress.h"
-#include "progress/ProgressEstimator.h"
-#include "progress/ProgressEstimatorLinear.h"
-#include "progress/ProgressStageEstimator.h"
 #include "settings/AdaptiveLayerHeights.h"
 #include "settings/types/Angle.h"
 #include "settings/types/LayerIndex.h"
 #include "utils/algorithm.h"
+#include "utils/TaskGraph.h"
 #include "utils/ThreadPool.h"
 #include "utils/gettime.h"
 #include "utils/math.h"
@@ -364,13 +366,6 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     }
 
     // handle meshes
-    std::vector<double> mesh_timings;
-    for (unsigned int mesh_idx = 0; mesh_idx < storage.meshes.size(); mesh_idx++)
-    {
-        mesh_timings.push_back(1.0); // TODO: have a more accurate estimate of the relative time it takes per mesh, based on the height and number of polygons
-    }
-    ProgressStageEstimator inset_skin_progress_estimate(mesh_timings);
-
     Progress::messageProgressStage(Progress::Stage::INSET_SKIN, &time_keeper);
     std::vector<size_t> mesh_order;
     { // compute mesh order
@@ -384,11 +379,7 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
             mesh_order.push_back(order_and_mesh_idx.second);
         }
     }
-    for (size_t mesh_order_idx = 0; mesh_order_idx < mesh_order.size(); ++mesh_order_idx)
-    {
-        processBasicWallsSkinInfill(storage, mesh_order_idx, mesh_order, inset_skin_progress_estimate);
-        Progress::messageProgress(Progress::Stage::INSET_SKIN, mesh_order_idx + 1, storage.meshes.size());
-    }
+    processBasicWallsSkinInfill(storage, mesh_order);
 
     const auto& mesh_group = Application::getInstance().current_slice_->scene.current_mesh_group;
     const Settings& mesh_group_settings = mesh_group->settings;
@@ -457,223 +448,411 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     }
 }
 
-void FffPolygonGenerator::processBasicWallsSkinInfill(
-    SliceDataStorage& storage,
-    const size_t mesh_order_idx,
-    const std::vector<size_t>& mesh_order,
-    ProgressStageEstimator& inset_skin_progress_estimate)
+void FffPolygonGenerator::processBasicWallsSkinInfill(SliceDataStorage& storage, const std::vector<size_t>& mesh_order)
 {
-    size_t mesh_idx = mesh_order[mesh_order_idx];
-    SliceMeshStorage& mesh = *storage.meshes[mesh_idx];
-    size_t mesh_layer_count = mesh.layers.size();
-    if (mesh.settings.get<bool>("infill_mesh"))
-    {
-        processInfillMesh(storage, mesh_order_idx, mesh_order);
-    }
+    const Scene& scene = Application::getInstance().current_slice_->scene;
+    const Settings& mesh_group_settings = scene.current_mesh_group->settings;
+    const bool magic_spiralize = mesh_group_settings.get<bool>("magic_spiralize");
 
     // TODO: make progress more accurate!!
     // note: estimated time for     insets : skins = 22.953 : 48.858
-    std::vector<double> walls_vs_skin_timing({ 22.953, 48.858 });
-    ProgressStageEstimator* mesh_inset_skin_progress_estimator = new ProgressStageEstimator(walls_vs_skin_timing);
-
-    inset_skin_progress_estimate.nextStage(mesh_inset_skin_progress_estimator); // the stage of this function call
-
-    ProgressEstimatorLinear* inset_estimator = new ProgressEstimatorLinear(mesh_layer_count);
-    mesh_inset_skin_progress_estimator->nextStage(inset_estimator);
+    constexpr size_t walls_progress_weight = 23;
+    constexpr size_t skin_progress_weight = 49;
+    size_t total_progress_weight = 0;
+    for (const size_t mesh_idx : mesh_order)
+    {
+        total_progress_weight += storage.meshes[mesh_idx]->layers.size() * (walls_progress_weight + skin_progress_weight);
+    }
 
     struct
     {
-        ProgressStageEstimator& progress_estimator;
+        size_t total_weight;
         std::mutex mutex{};
-        std::atomic<size_t> processed_layer_count = 0;
+        std::atomic<size_t> processed_weight = 0;
 
-        void operator++(int)
+        void add(const size_t weight)
         {
+            const size_t processed_weight_ = processed_weight.fetch_add(weight, std::memory_order_relaxed) + weight;
             std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
             if (lock)
             { // progress estimation is done only in one thread so that no two threads message progress at the same time
-                size_t processed_layer_count_ = processed_layer_count.fetch_add(1, std::memory_order_relaxed);
-                double progress = progress_estimator.progress(processed_layer_count_);
-                Progress::messageProgress(Progress::Stage::INSET_SKIN, progress * 100, 100);
+                Progress::messageProgress(Progress::Stage::INSET_SKIN, static_cast<int>(processed_weight_), static_cast<int>(total_weight));
             }
-            else
+        }
+    } guarded_progress = { total_progress_weight };
+
+    /*
+     * All meshes are processed in one graph of per-layer tasks, so that a layer doesn't wait for all other layers to be done, nor a mesh for
+     * all other meshes. The dependencies are those of the data that the tasks read:
+     * - the walls of a layer only read the outline of that layer, but for infill meshes that outline is only known after it was limited to
+     *   the infill of the meshes with a lower order;
+     * - an infill mesh layer reads the infill of the same layer of the meshes with a lower order, which is only known after their skin;
+     * - the skin of a layer reads the outlines of the top and bottom skin layers around it, either directly or through the shared window
+     *   intersections, which are computed per block of layers once the walls of that block are done.
+     */
+    struct MeshTasks
+    {
+        std::vector<TaskGraph::task_id_t> walls; //!< Per layer
+        std::vector<TaskGraph::task_id_t> skins; //!< Per layer
+        std::optional<TaskGraph::task_id_t> all_walls; //!< Done when the walls of all layers are done, if any skin needs it
+        std::vector<uint8_t> filled_layers; //!< Per layer of an infill mesh, whether it is left with any parts
+        std::optional<OutlineWindowIntersections> top_windows;
+        std::optional<OutlineWindowIntersections> bottom_windows;
+    };
+    // Beyond this many layers, a skin layer depends on all walls of the mesh rather than on the walls of each layer that it reads.
+    constexpr size_t max_layer_dependencies = 32;
+
+    const std::string trace_path = spdlog::details::os::getenv("CURAENGINE_TASK_GRAPH_TRACE");
+    TaskGraph graph(! trace_path.empty());
+    std::deque<MeshTasks> mesh_tasks; // Not a vector: the tasks keep pointers to the windows
+    for (size_t mesh_order_idx = 0; mesh_order_idx < mesh_order.size(); ++mesh_order_idx)
+    {
+        const size_t mesh_idx = mesh_order[mesh_order_idx];
+        SliceMeshStorage& mesh = *storage.meshes[mesh_idx];
+        const size_t mesh_layer_count = mesh.layers.size();
+        MeshTasks& tasks = mesh_tasks.emplace_back();
+
+        // infill mesh
+        std::vector<TaskGraph::task_id_t> infill_mesh_tasks;
+        std::optional<TaskGraph::task_id_t> max_filled_layer_task;
+        if (mesh.settings.get<bool>("infill_mesh"))
+        {
+            tasks.filled_layers.resize(mesh_layer_count, false);
+            max_filled_layer_task = graph.addTask(
+                graph.traceName("max filled layer mesh {}", mesh_idx),
+                [&mesh, &tasks]()
+                {
+                    mesh.layer_nr_max_filled_layer = -1;
+                    for (size_t layer_nr = 0; layer_nr < tasks.filled_layers.size(); ++layer_nr)
+                    {
+                        if (tasks.filled_layers[layer_nr])
+                        {
+                            mesh.layer_nr_max_filled_layer = LayerIndex(layer_nr); // last set by the highest non-empty layer
+                        }
+                    }
+                });
+            for (size_t layer_nr = 0; layer_nr < mesh_layer_count; ++layer_nr)
             {
-                processed_layer_count.fetch_add(1, std::memory_order_release);
+                const TaskGraph::task_id_t task = graph.addTask(
+                    graph.traceName("infill mesh {} layer {}", mesh_idx, layer_nr),
+                    [this, &storage, &mesh_order, &tasks, mesh_order_idx, layer_nr]()
+                    {
+                        tasks.filled_layers[layer_nr] = processInfillMeshLayer(storage, mesh_order_idx, mesh_order, layer_nr);
+                    });
+                for (size_t other_mesh_order_idx = 0; other_mesh_order_idx < mesh_order_idx; ++other_mesh_order_idx)
+                {
+                    const MeshTasks& other_tasks = mesh_tasks[other_mesh_order_idx];
+                    if (layer_nr < other_tasks.skins.size())
+                    {
+                        graph.addDependency(other_tasks.skins[layer_nr], task);
+                    }
+                }
+                graph.addDependency(task, *max_filled_layer_task);
+                infill_mesh_tasks.push_back(task);
             }
         }
-        void reset()
+
+        // walls
+        for (size_t layer_nr = 0; layer_nr < mesh_layer_count; ++layer_nr)
         {
-            processed_layer_count.store(0, std::memory_order_relaxed);
+            const TaskGraph::task_id_t task = graph.addTask(
+                graph.traceName("walls mesh {} layer {}", mesh_idx, layer_nr),
+                [this, &mesh, &guarded_progress, layer_nr]()
+                {
+                    spdlog::debug("Processing insets for layer {} of {}", layer_nr, mesh.layers.size());
+                    processWalls(mesh, layer_nr);
+                    guarded_progress.add(walls_progress_weight);
+                });
+            if (! infill_mesh_tasks.empty())
+            {
+                graph.addDependency(infill_mesh_tasks[layer_nr], task);
+            }
+            tasks.walls.push_back(task);
         }
-    } guarded_progress = { inset_skin_progress_estimate };
 
-    // walls
-    cura::parallel_for<size_t>(
-        0,
-        mesh_layer_count,
-        [&](size_t layer_number)
+        bool process_infill = mesh.settings.get<coord_t>("infill_line_distance") > 0;
+        if (! process_infill)
+        { // do process infill anyway if it's modified by modifier meshes
+            for (size_t other_mesh_order_idx = mesh_order_idx + 1; other_mesh_order_idx < mesh_order.size(); ++other_mesh_order_idx)
+            {
+                const size_t other_mesh_idx = mesh_order[other_mesh_order_idx];
+                SliceMeshStorage& other_mesh = *storage.meshes[other_mesh_idx];
+                if (other_mesh.settings.get<bool>("infill_mesh"))
+                {
+                    AABB3D aabb = scene.current_mesh_group->meshes[mesh_idx].getAABB();
+                    AABB3D other_aabb = scene.current_mesh_group->meshes[other_mesh_idx].getAABB();
+                    if (aabb.hit(other_aabb))
+                    {
+                        process_infill = true;
+                    }
+                }
+            }
+        }
+
+        // skin & infill
+        size_t mesh_max_initial_bottom_layer_count = 0;
+        if (magic_spiralize)
         {
-            spdlog::debug("Processing insets for layer {} of {}", layer_number, mesh.layers.size());
-            processWalls(mesh, layer_number);
-            guarded_progress++;
-        });
+            mesh_max_initial_bottom_layer_count = std::max(mesh_max_initial_bottom_layer_count, mesh.settings.get<size_t>("initial_bottom_layers"));
+        }
 
-    ProgressEstimatorLinear* skin_estimator = new ProgressEstimatorLinear(mesh_layer_count);
-    mesh_inset_skin_progress_estimator->nextStage(skin_estimator);
+        // Every layer intersects the outlines of the top/bottom skin layers around it. Compute those intersections once for all layers.
+        const size_t top_layers = mesh.settings.get<size_t>("top_layers");
+        const size_t bottom_layers = mesh.settings.get<size_t>("bottom_layers");
+        if (! magic_spiralize && ! mesh.settings.get<bool>("skin_no_small_gaps_heuristic")
+            && mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::SURFACE)
+        {
+            constexpr size_t min_shared_window_size = 2; // A window of a single layer is just its outline, nothing to share.
+            if (top_layers >= min_shared_window_size)
+            {
+                tasks.top_windows.emplace(mesh, top_layers);
+            }
+            if (bottom_layers >= min_shared_window_size)
+            {
+                tasks.bottom_windows.emplace(mesh, bottom_layers);
+            }
+        }
+        struct WindowTasks
+        {
+            std::vector<TaskGraph::task_id_t> compute; //!< Per block
+            std::vector<TaskGraph::task_id_t> release; //!< Per block, once the skins that read it are done
+        };
+        const auto add_window_block_tasks = [&](OutlineWindowIntersections& windows, const std::string_view name)
+        {
+            WindowTasks block_tasks;
+            for (size_t block_idx = 0; block_idx < windows.getBlockCount(); ++block_idx)
+            {
+                block_tasks.compute.push_back(graph.addTask(
+                    graph.traceName("{} windows mesh {} block {}", name, mesh_idx, block_idx),
+                    [&windows, block_idx]()
+                    {
+                        windows.computeBlock(block_idx);
+                    }));
+                block_tasks.release.push_back(graph.addTask(
+                    graph.traceName("release {} windows mesh {} block {}", name, mesh_idx, block_idx),
+                    [&windows, block_idx]()
+                    {
+                        windows.releaseBlock(block_idx);
+                    }));
+                graph.addDependency(block_tasks.compute.back(), block_tasks.release.back());
+            }
+            for (size_t layer_nr = 0; layer_nr < mesh_layer_count; ++layer_nr)
+            {
+                graph.addDependency(tasks.walls[layer_nr], block_tasks.compute[windows.getBlockIndex(layer_nr)]);
+            }
+            return block_tasks;
+        };
+        const WindowTasks top_window_tasks = tasks.top_windows ? add_window_block_tasks(*tasks.top_windows, "top") : WindowTasks();
+        const WindowTasks bottom_window_tasks = tasks.bottom_windows ? add_window_block_tasks(*tasks.bottom_windows, "bottom") : WindowTasks();
+
+        // The skin reads the outlines of up to this many layers above and below, e.g. for the top and bottom most surfaces.
+        const size_t layers_above = std::max(top_layers, size_t(1));
+        const size_t layers_below = std::max(bottom_layers, size_t(1));
+        const auto add_walls_dependencies = [&](const TaskGraph::task_id_t skin_task, const size_t first_layer_nr, const size_t last_layer_nr)
+        {
+            if (last_layer_nr - first_layer_nr + 1 > max_layer_dependencies)
+            {
+                if (! tasks.all_walls)
+                {
+                    tasks.all_walls = graph.addTask(graph.traceName("walls mesh {}", mesh_idx), []() {});
+                    for (const TaskGraph::task_id_t walls_task : tasks.walls)
+                    {
+                        graph.addDependency(walls_task, *tasks.all_walls);
+                    }
+                }
+                graph.addDependency(*tasks.all_walls, skin_task);
+                return;
+            }
+            for (size_t layer_nr = first_layer_nr; layer_nr <= last_layer_nr; ++layer_nr)
+            {
+                graph.addDependency(tasks.walls[layer_nr], skin_task);
+            }
+        };
 
-    bool process_infill = mesh.settings.get<coord_t>("infill_line_distance") > 0;
-    if (! process_infill)
-    { // do process infill anyway if it's modified by modifier meshes
-        const Scene& scene = Application::getInstance().current_slice_->scene;
-        for (size_t other_mesh_order_idx = mesh_order_idx + 1; other_mesh_order_idx < mesh_order.size(); ++other_mesh_order_idx)
+        for (size_t layer_nr = 0; layer_nr < mesh_layer_count; ++layer_nr)
         {
-            const size_t other_mesh_idx = mesh_order[other_mesh_order_idx];
-            SliceMeshStorage& other_mesh = *storage.meshes[other_mesh_idx];
-            if (other_mesh.settings.get<bool>("infill_mesh"))
+            const TaskGraph::task_id_t task = graph.addTask(
+                graph.traceName("skin mesh {} layer {}", mesh_idx, layer_nr),
+                [this, &mesh, &tasks, &guarded_progress, layer_nr, process_infill, magic_spiralize, mesh_max_initial_bottom_layer_count]()
+                {
+                    spdlog::debug("Processing skins and infill layer {} of {}", layer_nr, mesh.layers.size());
+                    if (! magic_spiralize || layer_nr < mesh_max_initial_bottom_layer_count) // Only generate up/downskin and infill for the first X layers when spiralize is choosen.
+                    {
+                        processSkinsAndInfill(
+                            mesh,
+                            layer_nr,
+                            process_infill,
+                            tasks.top_windows.has_value() ? &tasks.top_windows.value() : nullptr,
+                            tasks.bottom_windows.has_value() ? &tasks.bottom_windows.value() : nullptr);
+                    }
+                    guarded_progress.add(skin_progress_weight);
+                });
+            graph.addDependency(tasks.walls[layer_nr], task);
+            if (max_filled_layer_task)
             {
-                AABB3D aabb = scene.current_mesh_group->meshes[mesh_idx].getAABB();
-                AABB3D other_aabb = scene.current_mesh_group->meshes[other_mesh_idx].getAABB();
-                if (aabb.hit(other_aabb))
+                graph.addDependency(*max_filled_layer_task, task);
+            }
+
+            const size_t first_layer_above = layer_nr + 1;
+            const size_t last_layer_above = std::min(layer_nr + layers_above, mesh_layer_count - 1);
+            if (first_layer_above <= last_layer_above)
+            {
+                if (tasks.top_windows)
                 {
-                    process_infill = true;
+                    for (size_t block_idx = tasks.top_windows->getBlockIndex(first_layer_above); block_idx <= tasks.top_windows->getBlockIndex(last_layer_above); ++block_idx)
+                    {
+                        graph.addDependency(top_window_tasks.compute[block_idx], task);
+                        graph.addDependency(task, top_window_tasks.release[block_idx]);
+                    }
+                }
+                else
+                {
+                    add_walls_dependencies(task, first_layer_above, last_layer_above);
+                }
+            }
+            if (layer_nr > 0)
+            {
+                const size_t first_layer_below = layer_nr - std::min(layers_below, layer_nr);
+                const size_t last_layer_below = layer_nr - 1;
+                if (tasks.bottom_windows)
+                {
+                    for (size_t block_idx = tasks.bottom_windows->getBlockIndex(first_layer_below); block_idx <= tasks.bottom_windows->getBlockIndex(last_layer_below); ++block_idx)
+                    {
+                        graph.addDependency(bottom_window_tasks.compute[block_idx], task);
+                        graph.addDependency(task, bottom_window_tasks.release[block_idx]);
+                    }
+                }
+                else
+                {
+                    add_walls_dependencies(task, first_layer_below, last_layer_below);
                 }
             }
+            tasks.skins.push_back(task);
         }
     }
 
-    // skin & infill
-    const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    bool magic_spiralize = mesh_group_settings.get<bool>("magic_spiralize");
-    size_t mesh_max_initial_bottom_layer_count = 0;
-    if (magic_spiralize)
-    {
-        mesh_max_initial_bottom_layer_count = std::max(mesh_max_initial_bottom_layer_count, mesh.settings.get<size_t>("initial_bottom_layers"));
-    }
+    graph.run(*Application::getInstance().thread_pool_);
 
-    guarded_progress.reset();
-    cura::parallel_for<size_t>(
-        0,
-        mesh_layer_count,
-        [&](size_t layer_number)
+    for (size_t mesh_order_idx = 0; mesh_order_idx < mesh_tasks.size(); ++mesh_order_idx)
+    {
+        for (const auto& [windows, name] : { std::make_pair(&mesh_tasks[mesh_order_idx].top_windows, "top"), std::make_pair(&mesh_tasks[mesh_order_idx].bottom_windows, "bottom") })
         {
-            spdlog::debug("Processing skins and infill layer {} of {}", layer_number, mesh.layers.size());
-            if (! magic_spiralize || layer_number < mesh_max_initial_bottom_layer_count) // Only generate up/downskin and infill for the first X layers when spiralize is choosen.
+            if (windows->has_value())
             {
-                processSkinsAndInfill(mesh, layer_number, process_infill);
+                const auto [lookup_count, hit_count] = (*windows)->getLookupAndHitCount();
+                spdlog::debug("Shared {} skin windows of mesh {}: {} of {} lookups", name, mesh_order[mesh_order_idx], hit_count, lookup_count);
             }
-            guarded_progress++;
-        });
+        }
+    }
+
+    if (! trace_path.empty())
+    {
+        graph.writeTrace(trace_path);
+    }
 }
 
-void FffPolygonGenerator::processInfillMesh(SliceDataStorage& storage, const size_t mesh_order_idx, const std::vector<size_t>& mesh_order)
+bool FffPolygonGenerator::processInfillMeshLayer(SliceDataStorage& storage, const size_t mesh_order_idx, const std::vector<size_t>& mesh_order, const LayerIndex layer_idx)
 {
     size_t mesh_idx = mesh_order[mesh_order_idx];
     SliceMeshStorage& mesh = *storage.meshes[mesh_idx];
     coord_t surface_line_width = mesh.settings.get<coord_t>("wall_line_width_0");
 
-    mesh.layer_nr_max_filled_layer = -1;
-    for (LayerIndex layer_idx = 0; layer_idx < LayerIndex(mesh.layers.size()); layer_idx++)
-    {
-        SliceLayer& layer = mesh.layers[layer_idx];
+    SliceLayer& layer = mesh.layers[layer_idx];
 
-        if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+    if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+    {
+        // break up polygons into polylines
+        // they have to be polylines, because they might break up further when doing the cutting
+        for (SliceLayerPart& part : layer.parts)
         {
-            // break up polygons into polylines
-            // they have to be polylines, because they might break up further when doing the cutting
-            for (SliceLayerPart& part : layer.parts)
+            for (const Polygon& poly : part.outline)
             {
-                for (const Polygon& poly : part.outline)
-                {
-                    layer.open_polylines.push_back(poly.toPseudoOpenPolyline());
-                }
+                layer.open_polylines.push_back(poly.toPseudoOpenPolyline());
             }
-            layer.parts.clear();
         }
+        layer.parts.clear();
+    }
 
-        std::vector<SingleShape> new_parts;
-        OpenLinesSet new_polylines;
+    std::vector<SingleShape> new_parts;
+    OpenLinesSet new_polylines;
 
-        for (const size_t other_mesh_idx : mesh_order)
-        { // limit the infill mesh's outline to within the infill of all meshes with lower order
-            if (other_mesh_idx == mesh_idx)
-            {
-                break; // all previous meshes have been processed
-            }
-            SliceMeshStorage& other_mesh = *storage.meshes[other_mesh_idx];
-            if (layer_idx >= LayerIndex(other_mesh.layers.size()))
-            { // there can be no interaction between the infill mesh and this other non-infill mesh
-                continue;
-            }
+    for (const size_t other_mesh_idx : mesh_order)
+    { // limit the infill mesh's outline to within the infill of all meshes with lower order
+        if (other_mesh_idx == mesh_idx)
+        {
+            break; // all previous meshes have been processed
+        }
+        SliceMeshStorage& other_mesh = *storage.meshes[other_mesh_idx];
+        if (layer_idx >= LayerIndex(other_mesh.layers.size()))
+        { // there can be no interaction between the infill mesh and this other non-infill mesh
+            continue;
+        }
 
-            SliceLayer& other_layer = other_mesh.layers[layer_idx];
+        SliceLayer& other_layer = other_mesh.layers[layer_idx];
 
-            for (SliceLayerPart& other_part : other_layer.parts)
+        for (SliceLayerPart& other_part : other_layer.parts)
+        {
+            if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::SURFACE)
             {
-                if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::SURFACE)
-                {
-                    for (SliceLayerPart& part : layer.parts)
-                    { // limit the outline of each part of this infill mesh to the infill of parts of the other mesh with lower infill mesh order
-                        if (! part.boundaryBox.hit(other_part.boundaryBox))
-                        { // early out
-                            continue;
-                        }
-                        Shape new_outline = part.outline.intersection(other_part.getOwnInfillArea());
-                        if (new_outline.size() == 1)
-                        { // we don't have to call splitIntoParts, because a single polygon can only be a single part
-                            SingleShape outline_part_here;
-                            outline_part_here.push_back(new_outline[0]);
-                            new_parts.push_back(outline_part_here);
-                        }
-                        else if (new_outline.size() > 1)
-                        { // we don't know whether it's a multitude of parts because of newly introduced holes, or because the polygon has been split up
-                            std::vector<SingleShape> new_parts_here = new_outline.splitIntoParts();
-                            for (SingleShape& new_part_here : new_parts_here)
-                            {
-                                new_parts.push_back(new_part_here);
-                            }
-                        }
-                        // change the infill area of the non-infill mesh which is to be filled with e.g. lines
-                        other_part.infill_area_own = other_part.getOwnInfillArea().difference(part.outline);
-                        // note: don't change the part.infill_area, because we change the structure of that area, while the basic area in which infill is printed remains the same
-                        //       the infill area remains the same for combing
+                for (SliceLayerPart& part : layer.parts)
+                { // limit the outline of each part of this infill mesh to the infill of parts of the other mesh with lower infill mesh order
+                    if (! part.boundaryBox.hit(other_part.boundaryBox))
+                    { // early out
+                        continue;
                     }
-                }
-                if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
-                {
-                    const Shape& own_infill_area = other_part.getOwnInfillArea();
-                    OpenLinesSet cut_lines = own_infill_area.intersection(layer.open_polylines);
-                    new_polylines.push_back(cut_lines);
-                    // NOTE: closed polygons will be represented as polylines, which will be closed automatically in the PathOrderOptimizer
-                    if (! own_infill_area.empty())
-                    {
-                        other_part.infill_area_own = own_infill_area.difference(layer.open_polylines.offset(surface_line_width / 2));
+                    Shape new_outline = part.outline.intersection(other_part.getOwnInfillArea());
+                    if (new_outline.size() == 1)
+                    { // we don't have to call splitIntoParts, because a single polygon can only be a single part
+                        SingleShape outline_part_here;
+                        outline_part_here.push_back(new_outline[0]);
+                        new_parts.push_back(outline_part_here);
+                    }
+                    else if (new_outline.size() > 1)
+                    { // we don't know whether it's a multitude of parts because of newly introduced holes, or because the polygon has been split up
+                        std::vector<SingleShape> new_parts_here = new_outline.splitIntoParts();
+                        for (SingleShape& new_part_here : new_parts_here)
+                        {
+                            new_parts.push_back(new_part_here);
+                        }
                     }
+                    // change the infill area of the non-infill mesh which is to be filled with e.g. lines
+                    other_part.infill_area_own = other_part.getOwnInfillArea().difference(part.outline);
+                    // note: don't change the part.infill_area, because we change the structure of that area, while the basic area in which infill is printed remains the same
+                    //       the infill area remains the same for combing
                 }
             }
-        }
-
-        layer.parts.clear();
-        for (SingleShape& part : new_parts)
-        {
-            if (part.empty())
+            if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
             {
-                continue;
+                const Shape& own_infill_area = other_part.getOwnInfillArea();
+                OpenLinesSet cut_lines = own_infill_area.intersection(layer.open_polylines);
+                new_polylines.push_back(cut_lines);
+                // NOTE: closed polygons will be represented as polylines, which will be closed automatically in the PathOrderOptimizer
+                if (! own_infill_area.empty())
+                {
+                    other_part.infill_area_own = own_infill_area.difference(layer.open_polylines.offset(surface_line_width / 2));
+                }
             }
-            layer.parts.emplace_back();
-            layer.parts.back().outline = part;
-            layer.parts.back().boundaryBox.calculate(part);
         }
+    }
 
-        if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
+    layer.parts.clear();
+    for (SingleShape& part : new_parts)
+    {
+        if (part.empty())
         {
-            layer.open_polylines = new_polylines;
+            continue;
         }
+        layer.parts.emplace_back();
+        layer.parts.back().outline = part;
+        layer.parts.back().boundaryBox.calculate(part);
+    }
 
-        if (layer.parts.size() > 0 || (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL && layer.open_polylines.size() > 0))
-        {
-            mesh.layer_nr_max_filled_layer = layer_idx; // last set by the highest non-empty layer
-        }
+    if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
+    {
+        layer.open_polylines = new_polylines;
     }
+
+    return layer.parts.size() > 0 || (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL && layer.open_polylines.size() > 0);
 }
 
 void FffPolygonGenerator::processDerivedWallsSkinInfill(SliceMeshStorage& mesh)
@@ -843,14 +1022,19 @@ void FffPolygonGenerator::removeEmptyFirstLayers(SliceDataStorage& storage, size
  * processSkinsAndInfill read (depend on) mesh.layers[*].parts[*].{insets,boundingBox}.
  *                       write mesh.layers[n].parts[*].{skin_parts,infill_area}.
  */
-void FffPolygonGenerator::processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill)
+void FffPolygonGenerator::processSkinsAndInfill(
+    SliceMeshStorage& mesh,
+    const LayerIndex layer_nr,
+    bool process_infill,
+    const OutlineWindowIntersections* top_windows,
+    const OutlineWindowIntersections* bottom_windows)
 {
     if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
     {
         return;
     }
 
-    SkinInfillAreaComputation skin_infill_area_computation(layer_nr, mesh, process_infill);
+    SkinInfillAreaComputation skin_infill_area_computation(layer_nr, mesh, process_infill, top_windows, bottom_windows);
     skin_infill_area_computation.generateSkinsAndInfill();
 
     if (((mesh.settings.get<bool>("ironing_enabled") && (! mesh.settings.get<bool>("ironing_only_highest_layer"))) || mesh.layer_nr_max_filled_layer == layer_nr)
@@ -1028,13 +1212,19 @@ void FffPolygonGenerator::processDraftShield(SliceDataStorage& storage)
 
     const LayerIndex layer_skip{ 500 / layer_height + 1 };
 
-    Shape& draft_shield = storage.draft_protection_shield;
-    for (LayerIndex layer_nr = 0; layer_nr < storage.print_layer_count && layer_nr < draft_shield_layers; layer_nr += layer_skip)
-    {
-        constexpr bool around_support = true;
-        constexpr bool around_prime_tower = false;
-        draft_shield = draft_shield.unionPolygons(storage.getLayerOutlines(layer_nr, around_support, around_prime_tower));
-    }
+    // The outlines of the layers are unioned at once, rather than one by one into an ever growing shield.
+    const size_t last_layer = std::min(static_cast<size_t>(storage.print_layer_count), draft_shield_layers);
+    std::vector<Shape> layer_outlines(round_up_divide(last_layer, static_cast<size_t>(layer_skip)));
+    cura::parallel_for<size_t>(
+        0,
+        layer_outlines.size(),
+        [&](const size_t outline_idx)
+        {
+            constexpr bool around_support = true;
+            constexpr bool around_prime_tower = false;
+            layer_outlines[outline_idx] = storage.getLayerOutlines(LayerIndex(outline_idx) * layer_skip, around_support, around_prime_tower);
+        });
+    Shape draft_shield = Shape::unionShapes(std::move(layer_outlines));
 
     draft_shield.makeConvex();
     const coord_t draft_shield_dist = mesh_group_settings.get<coord_t>("draft_shield_dist");
@@ -10,7 +10,12 @@ FffProcessor FffProcessor::instance; // definition must be in cpp
 
 void FffProcessor::finalize()
 {
-    gcode_writer.finalize();
+    gcode_writer->finalize();
+}
+
+void FffProcessor::resetGcodeWriter()
+{
+    gcode_writer = std::make_unique<FffGcodeWriter>();
 }
 
 } // namespace cura
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <numbers>
 #include <numeric>
 #include <optional>
 
@@ -37,6 +38,7 @@
 #include "range/v3/view/chunk_by.hpp"
 #include "settings/types/Ratio.h"
 #include "sliceDataStorage.h"
+#include "timeEstimate.h"
 #include "utils/Simplify.h"
 #include "utils/linearAlg2D.h"
 #include "utils/math.h"
@@ -122,13 +124,14 @@ LayerPlan::LayerPlan(
     comb_boundary_minimum_(computeCombBoundary(CombBoundary::MINIMUM))
     , comb_boundary_preferred_(computeCombBoundary(CombBoundary::PREFERRED))
     , comb_move_inside_distance_(comb_move_inside_distance)
+    , bridge_layer_context_(storage, layer_nr)
     , fan_speed_layer_time_settings_per_extruder_(fan_speed_layer_time_settings_per_extruder)
 {
     size_t current_extruder = start_extruder;
     was_inside_ = true; // not used, because the first travel move is bogus
     is_inside_ = false; // assumes the next move will not be to inside a layer part (overwritten just before going into a layer part)
     const auto& local_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    if (local_settings.get<CombingMode>("retraction_combing") != CombingMode::OFF && local_settings.get<coord_t>("retraction_combing_avoid_distance") > 0)
+    if (local_settings.get<CombingMode>("retraction_combing"_setting) != CombingMode::OFF && local_settings.get<coord_t>("retraction_combing_avoid_distance"_setting) > 0)
     {
         comb_ = new Comb(storage, layer_nr, comb_boundary_minimum_, comb_boundary_preferred_, comb_boundary_offset, travel_avoid_distance, comb_move_inside_distance);
     }
@@ -138,7 +141,7 @@ LayerPlan::LayerPlan(
     }
     for (const ExtruderTrain& extruder : Application::getInstance().current_slice_->scene.extruders)
     {
-        layer_start_pos_per_extruder_.emplace_back(extruder.settings_.get<coord_t>("layer_start_x"), extruder.settings_.get<coord_t>("layer_start_y"), 0);
+        layer_start_pos_per_extruder_.emplace_back(extruder.settings_.get<coord_t>("layer_start_x"_setting), extruder.settings_.get<coord_t>("layer_start_y"_setting), 0);
     }
     extruder_plans_.reserve(Application::getInstance().current_slice_->scene.extruders.size());
     const auto is_raft_layer = layer_type_ == Raft::LayerType::RaftBase || layer_type_ == Raft::LayerType::RaftInterface || layer_type_ == Raft::LayerType::RaftSurface;
@@ -171,7 +174,7 @@ ExtruderTrain* LayerPlan::getLastPlannedExtruderTrain()
 Shape LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
 {
     Shape comb_boundary;
-    const CombingMode mesh_combing_mode = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<CombingMode>("retraction_combing");
+    const CombingMode mesh_combing_mode = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<CombingMode>("retraction_combing"_setting);
     if (mesh_combing_mode != CombingMode::OFF && (layer_nr_ >= 0 || mesh_combing_mode != CombingMode::NO_SKIN))
     {
         switch (layer_type_)
@@ -208,10 +211,10 @@ Shape LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
                 switch (boundary_type)
                 {
                 case CombBoundary::MINIMUM:
-                    offset = -(mesh.settings.get<coord_t>("machine_nozzle_size") / 2 + mesh.settings.get<coord_t>("wall_line_width_0") / 2 + extra_offset);
+                    offset = -(mesh.settings.get<coord_t>("machine_nozzle_size"_setting) / 2 + mesh.settings.get<coord_t>("wall_line_width_0"_setting) / 2 + extra_offset);
                     break;
                 case CombBoundary::PREFERRED:
-                    offset = -(mesh.settings.get<coord_t>("retraction_combing_avoid_distance") + mesh.settings.get<coord_t>("wall_line_width_0") / 2 + extra_offset);
+                    offset = -(mesh.settings.get<coord_t>("retraction_combing_avoid_distance"_setting) + mesh.settings.get<coord_t>("wall_line_width_0"_setting) / 2 + extra_offset);
                     break;
                 default:
                     offset = 0;
@@ -219,7 +222,7 @@ Shape LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
                     break;
                 }
 
-                const CombingMode combing_mode = mesh.settings.get<CombingMode>("retraction_combing");
+                const CombingMode combing_mode = mesh.settings.get<CombingMode>("retraction_combing"_setting);
                 for (const SliceLayerPart& part : layer.parts)
                 {
                     Shape part_combing_boundary;
@@ -269,15 +272,15 @@ bool LayerPlan::setExtruder(const size_t extruder_nr)
     setIsInside(false);
     { // handle end position of the prev extruder
         ExtruderTrain* extruder = getLastPlannedExtruderTrain();
-        const bool end_pos_absolute = extruder->settings_.get<bool>("machine_extruder_end_pos_abs");
-        Point2LL end_pos(extruder->settings_.get<coord_t>("machine_extruder_end_pos_x"), extruder->settings_.get<coord_t>("machine_extruder_end_pos_y"));
+        const bool end_pos_absolute = extruder->settings_.get<bool>("machine_extruder_end_pos_abs"_setting);
+        Point2LL end_pos(extruder->settings_.get<coord_t>("machine_extruder_end_pos_x"_setting), extruder->settings_.get<coord_t>("machine_extruder_end_pos_y"_setting));
         if (! end_pos_absolute)
         {
             end_pos += getLastPlannedPositionOrStartingPosition();
         }
         else
         {
-            const Point2LL extruder_offset(extruder->settings_.get<coord_t>("machine_nozzle_offset_x"), extruder->settings_.get<coord_t>("machine_nozzle_offset_y"));
+            const Point2LL extruder_offset(extruder->settings_.get<coord_t>("machine_nozzle_offset_x"_setting), extruder->settings_.get<coord_t>("machine_nozzle_offset_y"_setting));
             end_pos += extruder_offset; // absolute end pos is given as a head position
         }
         if (end_pos_absolute || last_planned_position_)
@@ -305,15 +308,15 @@ bool LayerPlan::setExtruder(const size_t extruder_nr)
 
     { // handle starting pos of the new extruder
         ExtruderTrain* extruder = getLastPlannedExtruderTrain();
-        const bool start_pos_absolute = extruder->settings_.get<bool>("machine_extruder_start_pos_abs");
-        Point3LL start_pos(extruder->settings_.get<coord_t>("machine_extruder_start_pos_x"), extruder->settings_.get<coord_t>("machine_extruder_start_pos_y"), 0);
+        const bool start_pos_absolute = extruder->settings_.get<bool>("machine_extruder_start_pos_abs"_setting);
+        Point3LL start_pos(extruder->settings_.get<coord_t>("machine_extruder_start_pos_x"_setting), extruder->settings_.get<coord_t>("machine_extruder_start_pos_y"_setting), 0);
         if (! start_pos_absolute)
         {
             start_pos += getLastPlannedPositionOrStartingPosition();
         }
         else
         {
-            Point3LL extruder_offset(extruder->settings_.get<coord_t>("machine_nozzle_offset_x"), extruder->settings_.get<coord_t>("machine_nozzle_offset_y"), 0);
+            Point3LL extruder_offset(extruder->settings_.get<coord_t>("machine_nozzle_offset_x"_setting), extruder->settings_.get<coord_t>("machine_nozzle_offset_y"_setting), 0);
             start_pos += extruder_offset; // absolute start pos is given as a head position
         }
         if (start_pos_absolute || last_planned_position_)
@@ -383,16 +386,16 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
 
     const bool is_first_travel_of_extruder_after_switch
         = extruder_plans_.back().paths_.size() == 1 && (extruder_plans_.size() > 1 || last_extruder_previous_layer_ != getExtruder());
-    bool bypass_combing = is_first_travel_of_extruder_after_switch && mesh_or_extruder_settings.get<bool>("retraction_hop_after_extruder_switch");
+    bool bypass_combing = is_first_travel_of_extruder_after_switch && mesh_or_extruder_settings.get<bool>("retraction_hop_after_extruder_switch"_setting);
 
     const bool is_first_travel_of_layer = ! static_cast<bool>(last_planned_position_);
-    const bool retraction_enable = mesh_or_extruder_settings.get<bool>("retraction_enable");
+    const bool retraction_enable = mesh_or_extruder_settings.get<bool>("retraction_enable"_setting);
     if (is_first_travel_of_layer)
     {
         bypass_combing = true; // first travel move is bogus; it is added after this and the previous layer have been planned in LayerPlanBuffer::addConnectingTravelMove
         first_travel_destination_ = p;
         first_travel_destination_is_inside_ = is_inside_;
-        if (layer_nr_ == 0 && retraction_enable && mesh_or_extruder_settings.get<bool>("retraction_hop_enabled"))
+        if (layer_nr_ == 0 && retraction_enable && mesh_or_extruder_settings.get<bool>("retraction_hop_enabled"_setting))
         {
             path->retract = true;
             path->perform_z_hop = true;
@@ -407,7 +410,7 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
         path->retract = true;
         if (comb_ == nullptr)
         {
-            path->perform_z_hop = mesh_or_extruder_settings.get<bool>("retraction_hop_enabled");
+            path->perform_z_hop = mesh_or_extruder_settings.get<bool>("retraction_hop_enabled"_setting);
         }
     }
 
@@ -417,12 +420,12 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
 
         // Divide by 2 to get the radius
         // Multiply by 2 because if two lines start and end points places very close then will be applied combing with retractions. (Ex: for brim)
-        const coord_t max_distance_ignored = mesh_or_extruder_settings.get<coord_t>("machine_nozzle_tip_outer_diameter") / 2 * 2;
+        const coord_t max_distance_ignored = mesh_or_extruder_settings.get<coord_t>("machine_nozzle_tip_outer_diameter"_setting) / 2 * 2;
 
         bool unretract_before_last_travel_move = false; // Decided when calculating the combing
         bool do_retracted_combing_move = false; // Decided when calculating the combing
-        const bool perform_z_hops = mesh_or_extruder_settings.get<bool>("retraction_hop_enabled");
-        const bool perform_z_hops_only_when_collides = mesh_or_extruder_settings.get<bool>("retraction_hop_only_when_collides");
+        const bool perform_z_hops = mesh_or_extruder_settings.get<bool>("retraction_hop_enabled"_setting);
+        const bool perform_z_hops_only_when_collides = mesh_or_extruder_settings.get<bool>("retraction_hop_only_when_collides"_setting);
         combed = comb_->calc(
             perform_z_hops,
             perform_z_hops_only_when_collides,
@@ -457,7 +460,7 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
                 }
             }
 
-            const coord_t maximum_travel_resolution = mesh_or_extruder_settings.get<coord_t>("meshfix_maximum_travel_resolution");
+            const coord_t maximum_travel_resolution = mesh_or_extruder_settings.get<coord_t>("meshfix_maximum_travel_resolution"_setting);
             coord_t distance = 0;
             Point2LL last_point((last_planned_position_) ? last_planned_position_.value().toPoint2LL() : Point2LL(0, 0));
             for (CombPath& combPath : combPaths)
@@ -476,7 +479,7 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
                     }
                 }
                 distance += vSize(last_point - p);
-                const coord_t retract_threshold = mesh_or_extruder_settings.get<coord_t>("retraction_combing_max_distance");
+                const coord_t retract_threshold = mesh_or_extruder_settings.get<coord_t>("retraction_combing_max_distance"_setting);
                 path->retract = retract || (retract_threshold > 0 && distance > retract_threshold && retraction_enable);
                 // don't perform a z-hop
             }
@@ -510,15 +513,15 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const ForceRetract force_retr
         { // then move inside the printed part, so that we don't ooze on the outer wall while retraction, but on the inside of the print.
             assert(extruder != nullptr);
             coord_t innermost_wall_line_width
-                = mesh_or_extruder_settings.get<coord_t>((mesh_or_extruder_settings.get<size_t>("wall_line_count") > 1) ? "wall_line_width_x" : "wall_line_width_0");
+                = mesh_or_extruder_settings.get<coord_t>((mesh_or_extruder_settings.get<size_t>("wall_line_count"_setting) > 1) ? "wall_line_width_x" : "wall_line_width_0");
             if (layer_nr_ == 0)
             {
-                innermost_wall_line_width *= mesh_or_extruder_settings.get<Ratio>("initial_layer_line_width_factor");
+                innermost_wall_line_width *= mesh_or_extruder_settings.get<Ratio>("initial_layer_line_width_factor"_setting);
             }
             moveInsideCombBoundary(innermost_wall_line_width, std::nullopt, path);
         }
         path->retract = retraction_enable;
-        path->perform_z_hop = retraction_enable && mesh_or_extruder_settings.get<bool>("retraction_hop_enabled");
+        path->perform_z_hop = retraction_enable && mesh_or_extruder_settings.get<bool>("retraction_hop_enabled"_setting);
     }
 
     // must start new travel path as retraction can be enabled or not depending on path length, etc.
@@ -637,9 +640,9 @@ void LayerPlan::addExtrusionMoveWithGradualOverhang(
     const Point3LL start = last_planned_position_.value();
     const Point2LL start_flat = start.toPoint2LL();
     size_t actual_speed_region_index = overhang_masks_.size() - 1; // Default to last region, which is infinity and beyond
-    for (const auto& [index, overhang_region] : overhang_masks_ | ranges::views::drop_last(1) | ranges::views::enumerate)
+    for (const auto& [index, supported_region] : indexed_overhang_masks_ | ranges::views::drop_last(1) | ranges::views::enumerate)
     {
-        if (overhang_region.supported_region.inside(start_flat, true))
+        if (supported_region.inside(start_flat, true))
         {
             actual_speed_region_index = index;
             break;
@@ -652,9 +655,9 @@ void LayerPlan::addExtrusionMoveWithGradualOverhang(
     const Point3LL vector = end - start;
     std::vector<std::vector<float>> speed_regions_intersections;
     speed_regions_intersections.reserve(overhang_masks_.size() - 1);
-    for (const OverhangMask& overhang_region : overhang_masks_ | ranges::views::drop_last(1))
+    for (const SegmentIndexedShape& supported_region : indexed_overhang_masks_ | ranges::views::drop_last(1))
     {
-        std::vector<float> intersections = overhang_region.supported_region.intersectionsWithSegment(start_flat, end_flat);
+        std::vector<float> intersections = supported_region.intersectionsWithSegment(start_flat, end_flat);
         ranges::stable_sort(intersections);
         speed_regions_intersections.push_back(intersections);
     }
@@ -1098,8 +1101,8 @@ void LayerPlan::addWallLine(
     constexpr double acceleration_factor = 0.75; // must be < 1, the larger the value, the slower the acceleration
     constexpr bool spiralize = false;
 
-    const coord_t min_bridge_line_len = std::max(EPSILON, settings.get<coord_t>("bridge_wall_min_length"));
-    const Ratio bridge_wall_coast = settings.get<Ratio>("bridge_wall_coast");
+    const coord_t min_bridge_line_len = std::max(EPSILON, settings.get<coord_t>("bridge_wall_min_length"_setting));
+    const Ratio bridge_wall_coast = settings.get<Ratio>("bridge_wall_coast"_setting);
 
     Point3LL cur_point = p0;
 
@@ -1204,7 +1207,7 @@ void LayerPlan::addWallLine(
         }
     };
 
-    const auto use_skin_config = [&default_config, &p0, &p1](const Shape& mask, const GCodePathConfig& config) -> bool
+    const auto use_skin_config = [&default_config, &p0, &p1](const SegmentIndexedShape& mask, const GCodePathConfig& config) -> bool
     {
         if (config == default_config)
         {
@@ -1212,10 +1215,10 @@ void LayerPlan::addWallLine(
             // what part of the line segment will be printed with what config.
             return false;
         }
-        return PolygonUtils::polygonCollidesWithLineSegment(mask, p0.toPoint2LL(), p1.toPoint2LL()) || mask.inside(p1.toPoint2LL(), true);
+        return mask.collidesWithLineSegment(p0.toPoint2LL(), p1.toPoint2LL()) || mask.inside(p1.toPoint2LL(), true);
     };
 
-    if (use_skin_config(roofing_mask_, roofing_config))
+    if (use_skin_config(indexed_roofing_mask_, roofing_config))
     {
         addSkinExtrusion(p0, p1, roofing_mask_, roofing_config, default_config, flow, width_factor, spiralize, travel_to_z);
     }
@@ -1235,7 +1238,7 @@ void LayerPlan::addWallLine(
     }
     else if (std::vector<std::tuple<Ratio, Ratio>> bridging_subsegments = wallSegmentUsesBridging(
                  bridge_wall_mask_bb_,
-                 bridge_wall_mask_,
+                 indexed_bridge_wall_mask_,
                  wall,
                  segment_index,
                  segment_start_ratio,
@@ -1262,7 +1265,7 @@ void LayerPlan::addWallLine(
 
         addNonBridgeLine(p1);
     }
-    else if (use_skin_config(flooring_mask_, flooring_config))
+    else if (use_skin_config(indexed_flooring_mask_, flooring_config))
     {
         addSkinExtrusion(p0, p1, flooring_mask_, flooring_config, default_config, flow, width_factor, spiralize, travel_to_z);
     }
@@ -1586,14 +1589,14 @@ std::vector<LayerPlan::PathCoasting>
     std::vector<PathCoasting> path_coastings;
     path_coastings.resize(paths.size());
 
-    if (extruder_settings.get<bool>("coasting_enable"))
+    if (extruder_settings.get<bool>("coasting_enable"_setting))
     {
         // Chunk paths by travel paths, and find out which paths are a 'continuation' w.r.t. coasting (and which need to be 'coasted away' entirely).
         // Note that this doesn't perform the coasting itself, it just calculates the coasting values which will be applied by the 'writePathWithCoasting' func.
         // All of this is necessary since we split up paths because of scarf and acceleration-adjustments (start/end), so we need to have adjacency info.
 
-        const double coasting_volume = extruder_settings.get<double>("coasting_volume");
-        const double coasting_min_volume = extruder_settings.get<double>("coasting_min_volume");
+        const double coasting_volume = extruder_settings.get<double>("coasting_volume"_setting);
+        const double coasting_min_volume = extruder_settings.get<double>("coasting_min_volume"_setting);
 
         for (const auto& reversed_chunk : paths | ranges::views::enumerate | ranges::views::reverse
                                               | ranges::views::chunk_by(
@@ -1719,7 +1722,7 @@ coord_t LayerPlan::computeDistanceToBridgeStart(const ExtrusionLine& wall, const
             const ExtrusionJunction& p0 = wall[point_index(base_index)];
             const ExtrusionJunction& p1 = wall[point_index(base_index + direction)];
 
-            if (bridge_wall_mask_bb_.hit(AABB({ p0.p_, p1.p_ })) && PolygonUtils::polygonCollidesWithLineSegment(bridge_wall_mask_, p0.p_, p1.p_))
+            if (bridge_wall_mask_bb_.hit(AABB({ p0.p_, p1.p_ })) && indexed_bridge_wall_mask_.collidesWithLineSegment(p0.p_, p1.p_))
             {
                 constexpr bool restitch = false; // only a single line doesn't need stitching
                 OpenLinesSet intersections_with_bridge_mask = bridge_wall_mask_.intersection(OpenLinesSet(OpenPolyline({ p0.p_, p1.p_ })), restitch);
@@ -1768,7 +1771,7 @@ coord_t LayerPlan::computeDistanceToBridgeStart(const ExtrusionLine& wall, const
                 // None of the intersection segments was long enough to be considered relevant, so just ignore the segment
                 distance_to_bridge_start += vSize(p1.p_ - p0.p_);
             }
-            else if (! bridge_wall_mask_.inside(p0.p_, true))
+            else if (! indexed_bridge_wall_mask_.inside(p0.p_, true))
             {
                 // none of the line is over air
                 distance_to_bridge_start += vSize(p1.p_ - p0.p_);
@@ -1805,35 +1808,35 @@ std::tuple<size_t, Point2LL> LayerPlan::addWallWithScarfSeam(
 
     const bool actual_scarf_seam = scarf_seam && is_closed && layer_nr_ > 0;
 
-    const coord_t min_bridge_line_len = settings.get<coord_t>("bridge_wall_min_length");
+    const coord_t min_bridge_line_len = settings.get<coord_t>("bridge_wall_min_length"_setting);
 
     const coord_t nominal_line_width = default_config.getLineWidth();
 
     const coord_t wall_length = wall.length();
-    const coord_t small_feature_max_length = settings.get<coord_t>("small_feature_max_length");
+    const coord_t small_feature_max_length = settings.get<coord_t>("small_feature_max_length"_setting);
     const bool is_small_feature = (small_feature_max_length > 0) && (layer_nr_ == 0 || is_candidate_small_feature) && wall_length < small_feature_max_length;
     const Velocity min_speed = fan_speed_layer_time_settings_per_extruder_[getLastPlannedExtruderTrain()->extruder_nr_].cool_min_speed;
     Ratio small_feature_speed_factor = settings.get<Ratio>((layer_nr_ == 0) ? "small_feature_speed_factor_0" : "small_feature_speed_factor");
     small_feature_speed_factor = std::max(static_cast<double>(small_feature_speed_factor), static_cast<double>(min_speed / default_config.getSpeed()));
-    const coord_t max_area_deviation = std::max(settings.get<int>("meshfix_maximum_extrusion_area_deviation"), 1); // Square micrometres!
-    const auto max_resolution = std::max(settings.get<coord_t>("meshfix_maximum_resolution"), coord_t(1));
+    const coord_t max_area_deviation = std::max(settings.get<int>("meshfix_maximum_extrusion_area_deviation"_setting), 1); // Square micrometres!
+    const auto max_resolution = std::max(settings.get<coord_t>("meshfix_maximum_resolution"_setting), coord_t(1));
     const int direction = is_reversed ? -1 : 1;
     const size_t max_index = is_closed ? wall.size() + 1 : wall.size();
 
-    const coord_t scarf_seam_length = std::min(wall_length, actual_scarf_seam ? settings.get<coord_t>("scarf_joint_seam_length") : 0);
-    const auto scarf_seam_start_ratio = actual_scarf_seam ? settings.get<Ratio>("scarf_joint_seam_start_height_ratio") : 1.0_r;
-    const auto scarf_split_distance = settings.get<coord_t>("scarf_split_distance");
+    const coord_t scarf_seam_length = std::min(wall_length, actual_scarf_seam ? settings.get<coord_t>("scarf_joint_seam_length"_setting) : 0);
+    const auto scarf_seam_start_ratio = actual_scarf_seam ? settings.get<Ratio>("scarf_joint_seam_start_height_ratio"_setting) : 1.0_r;
+    const auto scarf_split_distance = settings.get<coord_t>("scarf_split_distance"_setting);
     const coord_t scarf_max_z_offset = static_cast<coord_t>(-(1.0 - scarf_seam_start_ratio) * static_cast<double>(layer_thickness_));
 
     const Velocity top_speed = default_config.getSpeed();
-    const coord_t speed_split_distance = settings.get<coord_t>("wall_0_speed_split_distance"); // mm
-    const Ratio start_speed_ratio = smooth_speed ? settings.get<Ratio>("wall_0_start_speed_ratio") : 1.0_r;
-    const int acceleration = settings.get<int>("wall_0_acceleration"); // mm/s²
+    const coord_t speed_split_distance = settings.get<coord_t>("wall_0_speed_split_distance"_setting); // mm
+    const Ratio start_speed_ratio = smooth_speed ? settings.get<Ratio>("wall_0_start_speed_ratio"_setting) : 1.0_r;
+    const int acceleration = settings.get<int>("wall_0_acceleration"_setting); // mm/s²
     const Velocity start_speed = top_speed * start_speed_ratio; // mm/s
     const coord_t accelerate_length = (smooth_speed && start_speed_ratio < 1.0) ? MM2INT((square(top_speed) - square(start_speed)) / (2.0 * acceleration)) : 0; // µm
 
-    const Ratio end_speed_ratio = smooth_speed ? settings.get<Ratio>("wall_0_end_speed_ratio") : 1.0_r;
-    const int deceleration = settings.get<int>("wall_0_deceleration"); // mm/s²
+    const Ratio end_speed_ratio = smooth_speed ? settings.get<Ratio>("wall_0_end_speed_ratio"_setting) : 1.0_r;
+    const int deceleration = settings.get<int>("wall_0_deceleration"_setting); // mm/s²
     const Velocity end_speed = top_speed * end_speed_ratio; // mm/s
     const coord_t decelerate_length = (smooth_speed && end_speed_ratio < 1.0) ? MM2INT((square(top_speed) - square(end_speed)) / (2.0 * deceleration)) : 0; // µm
 
@@ -1905,7 +1908,7 @@ void LayerPlan::addWall(
     }
 
     double non_bridge_line_volume = max_non_bridge_line_volume; // assume extruder is fully pressurised before first non-bridge line is output
-    const coord_t min_bridge_line_len = settings.get<coord_t>("bridge_wall_min_length");
+    const coord_t min_bridge_line_len = settings.get<coord_t>("bridge_wall_min_length"_setting);
     const PathAdapter path_adapter(wall);
 
     const std::tuple<size_t, Point2LL> add_wall_result = addWallWithScarfSeam<ExtrusionLine>(
@@ -2006,7 +2009,7 @@ void LayerPlan::addWalls(
     }
 }
 
-OpenPolyline LayerPlan::makeInwardsMove(const std::list<STHalfEdge>& trapezoidal_edges, const Point2LL& start_point, const coord_t move_inwards_length)
+OpenPolyline LayerPlan::makeInwardsMove(const ChunkedList<STHalfEdge>& trapezoidal_edges, const Point2LL& start_point, const coord_t move_inwards_length)
 {
     // Find the trapezoidal that the start point belongs to
     const STHalfEdge* trapezoidal_start = nullptr;
@@ -2212,7 +2215,7 @@ void LayerPlan::addLinesByOptimizer(
             // determine how much the skin/infill lines overlap the combing boundary
             for (const std::shared_ptr<SliceMeshStorage>& mesh : storage_.meshes)
             {
-                const coord_t overlap = std::max(mesh->settings.get<coord_t>("skin_overlap_mm"), mesh->settings.get<coord_t>("infill_overlap_mm"));
+                const coord_t overlap = std::max(mesh->settings.get<coord_t>("skin_overlap_mm"_setting), mesh->settings.get<coord_t>("infill_overlap_mm"_setting));
                 if (overlap > dist)
                 {
                     dist = overlap;
@@ -2282,7 +2285,7 @@ void LayerPlan::addLinesByOptimizer(
             // determine how much the skin/infill lines overlap the combing boundary
             for (const std::shared_ptr<SliceMeshStorage>& mesh : storage_.meshes)
             {
-                const coord_t overlap = std::max(mesh->settings.get<coord_t>("skin_overlap_mm"), mesh->settings.get<coord_t>("infill_overlap_mm"));
+                const coord_t overlap = std::max(mesh->settings.get<coord_t>("skin_overlap_mm"_setting), mesh->settings.get<coord_t>("infill_overlap_mm"_setting));
                 if (overlap > dist)
                 {
                     dist = overlap;
@@ -2549,7 +2552,7 @@ LayerPlan::TravelDurations LayerPlan::computeTravelDurations(const GCodeExport&
 
     if (z_hop_height > 0)
     {
-        const Velocity z_hop_speed = extruder.settings_.get<Velocity>("speed_z_hop");
+        const Velocity z_hop_speed = extruder.settings_.get<Velocity>("speed_z_hop"_setting);
         travel_durations.z_hop = (z_hop_height / z_hop_speed) / 1000.0;
     }
 
@@ -2846,7 +2849,8 @@ void LayerPlan::writeExtrusionRelativeZ(
     const coord_t path_z_offset,
     double extrusion_mm3_per_mm,
     PrintFeatureType feature,
-    bool update_extrusion_offset)
+    bool update_extrusion_offset,
+    const std::string_view formatted_xy)
 {
     Ratio thickness_factor;
     const coord_t z_offset_start = gcode.getPositionZ() - z_;
@@ -2862,7 +2866,7 @@ void LayerPlan::writeExtrusionRelativeZ(
         thickness_factor = 1.0;
     }
 
-    gcode.writeExtrusion(position + Point3LL(0, 0, z_ + path_z_offset), speed, extrusion_mm3_per_mm * thickness_factor, feature, update_extrusion_offset);
+    gcode.writeExtrusion(position + Point3LL(0, 0, z_ + path_z_offset), speed, extrusion_mm3_per_mm * thickness_factor, feature, update_extrusion_offset, formatted_xy);
 }
 
 void LayerPlan::addLinesMonotonic(
@@ -2937,7 +2941,7 @@ void LayerPlan::spiralizeWallSlice(
     const bool is_top_layer,
     const bool is_bottom_layer)
 {
-    const bool smooth_contours = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("smooth_spiralized_contours");
+    const bool smooth_contours = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("smooth_spiralized_contours"_setting);
     constexpr bool spiralize = true; // In addExtrusionMove calls, enable spiralize and use nominal line width.
     constexpr Ratio width_factor = 1.0_r;
 
@@ -3093,6 +3097,12 @@ void LayerPlan::spiralizeWallSlice(
 
 bool ExtruderPlan::forceMinimalLayerTime(double minTime, double time_other_extr_plans)
 {
+    if (fan_speed_layer_time_settings_.cool_min_layer_time_estimate_acceleration)
+    {
+        TimeEstimateCalculator calculator = planTimeEstimate(Application::getInstance().current_slice_->scene.extruders[extruder_nr_].settings_);
+        return forceMinimalLayerTimeWithAcceleration(minTime, time_other_extr_plans, calculator);
+    }
+
     const double minimalSpeed = fan_speed_layer_time_settings_.cool_min_speed;
     const double travelTime = estimates_.getTravelTime();
     const double extrudeTime = estimates_.extrude_time;
@@ -3174,6 +3184,127 @@ bool ExtruderPlan::forceMinimalLayerTime(double minTime, double time_other_extr_
     return false;
 }
 
+bool ExtruderPlan::forceMinimalLayerTimeWithAcceleration(double minTime, double time_other_extr_plans, TimeEstimateCalculator& calculator)
+{
+    const double minimalSpeed = fan_speed_layer_time_settings_.cool_min_speed;
+    constexpr double epsilon = 0.01;
+
+    const auto layer_time = [&calculator, time_other_extr_plans](const double speed_factor)
+    {
+        const std::vector<Duration> durations = calculator.calculate(Ratio(speed_factor));
+        return std::accumulate(durations.begin(), durations.end(), time_other_extr_plans);
+    };
+
+    double fastest_path_speed = 0.0;
+    for (const GCodePath& path : paths_)
+    {
+        if (! path.isTravelPath())
+        {
+            fastest_path_speed = std::max<double>(fastest_path_speed, path.config.getSpeed() * path.speed_factor);
+        }
+    }
+    if (fastest_path_speed <= minimalSpeed || layer_time(1.0) >= minTime - epsilon)
+    {
+        return false;
+    }
+
+    // With a lower factor, every extrusion path would be printed at the minimum speed.
+    const double min_speed_factor = minimalSpeed / fastest_path_speed;
+    double speed_factor = min_speed_factor;
+    const double time_at_minimum_speed = layer_time(min_speed_factor);
+    if (time_at_minimum_speed < minTime - epsilon)
+    {
+        // Even at cool min speed extrusion is not taken enough time. So wait for the rest of it.
+        extra_time_ = minTime - time_at_minimum_speed;
+    }
+    else
+    {
+        // The layer time only gets shorter with a higher speed factor, so bisect for the factor at which it is just long enough.
+        double fast_factor = 1.0;
+        while (fast_factor - speed_factor > 0.001)
+        {
+            const double middle_factor = (speed_factor + fast_factor) / 2;
+            if (layer_time(middle_factor) >= minTime)
+            {
+                speed_factor = middle_factor;
+            }
+            else
+            {
+                fast_factor = middle_factor;
+            }
+        }
+    }
+
+    // Lower the temperature as the slowest path approaches the minimum speed, like forceMinimalLayerTime does.
+    const double slowest_speed = std::max(minimalSpeed, slowest_path_speed_ * speed_factor);
+    if (slowest_path_speed_ > minimalSpeed)
+    {
+        temperature_factor_ = (slowest_path_speed_ - slowest_speed) / (slowest_path_speed_ - minimalSpeed);
+    }
+
+    // Update stored naive time estimates
+    estimates_.extrude_time = 0.0;
+    for (GCodePath& path : paths_)
+    {
+        if (path.isTravelPath())
+        {
+            continue;
+        }
+        const Ratio slow_down_factor = std::min(1.0, std::max(speed_factor, minimalSpeed / (path.config.getSpeed() * path.speed_factor)));
+        path.speed_factor *= slow_down_factor;
+        path.estimates.extrude_time /= slow_down_factor;
+        estimates_.extrude_time += path.estimates.extrude_time;
+    }
+    return true;
+}
+
+TimeEstimateCalculator ExtruderPlan::planTimeEstimate(const Settings& settings) const
+{
+    TimeEstimateCalculator calculator;
+    calculator.setFirmwareDefaults(settings);
+    const bool acceleration_enabled = settings.get<bool>("acceleration_enabled"_setting);
+    const bool jerk_enabled = settings.get<bool>("jerk_enabled"_setting);
+    const double filament_area = std::numbers::pi * square(settings.get<double>("material_diameter"_setting) / 2.0);
+
+    Point3LL p0(starting_position_);
+    double e = 0.0;
+    calculator.setPosition(TimeEstimateCalculator::Position(INT2MM(p0.x_), INT2MM(p0.y_), INT2MM(p0.z_), e));
+    for (const GCodePath& path : paths_)
+    {
+        if (acceleration_enabled)
+        {
+            calculator.setAcceleration(path.config.getAcceleration());
+        }
+        if (jerk_enabled)
+        {
+            calculator.setMaxXyJerk(path.config.getJerk());
+        }
+        PrintFeatureType feature = path.config.type;
+        double e_per_mm = 0.0;
+        if (path.isTravelPath())
+        {
+            feature = path.retract ? PrintFeatureType::MoveRetracted : PrintFeatureType::MoveUnretracted;
+            if (path.retract && retraction_config_.distance > 0)
+            {
+                calculator.addTime(retraction_config_.distance / retraction_config_.speed + retraction_config_.distance / retraction_config_.primeSpeed);
+            }
+        }
+        else
+        {
+            // The same material as the naive estimate, in mm of filament.
+            e_per_mm = INT2MM(layer_thickness_) * INT2MM(path.config.getLineWidth()) / filament_area;
+        }
+        const Velocity speed = path.config.getSpeed() * path.speed_factor;
+        for (const Point3LL& p1 : path.points)
+        {
+            e += (p0 - p1).vSizeMM() * e_per_mm;
+            calculator.plan(TimeEstimateCalculator::Position(INT2MM(p1.x_), INT2MM(p1.y_), INT2MM(p1.z_), e), speed, feature);
+            p0 = p1;
+        }
+    }
+    return calculator;
+}
+
 double ExtruderPlan::getRetractTime(const GCodePath& path)
 {
     return retraction_config_.distance / (path.retract ? retraction_config_.speed : retraction_config_.primeSpeed);
@@ -3185,12 +3316,9 @@ std::pair<double, double> ExtruderPlan::getPointToPointTime(const Point3LL& p0,
     return { length, length / (path.config.getSpeed() * path.speed_factor) };
 }
 
-TimeMaterialEstimates ExtruderPlan::computeNaiveTimeEstimates(Point2LL starting_position)
+double ExtruderPlan::computeSlowestPathSpeed() const
 {
-    Point3LL p0 = starting_position;
-
-    const double min_path_speed = fan_speed_layer_time_settings_.cool_min_speed;
-    slowest_path_speed_ = std::accumulate(
+    return std::accumulate(
         paths_.begin(),
         paths_.end(),
         std::numeric_limits<double>::max(),
@@ -3198,63 +3326,108 @@ TimeMaterialEstimates ExtruderPlan::computeNaiveTimeEstimates(Point2LL starting_
         {
             return path.isTravelPath() ? value : std::min(value, path.config.getSpeed().value * path.speed_factor);
         });
+}
 
-    bool was_retracted = false; // wrong assumption; won't matter that much. (TODO)
-    for (GCodePath& path : paths_)
-    {
-        bool is_extrusion_path = false;
-        double* path_time_estimate;
-        double& material_estimate = path.estimates.material;
+void ExtruderPlan::computeNaiveTimeEstimates(GCodePath& path, Point3LL& p0)
+{
+    const double min_path_speed = fan_speed_layer_time_settings_.cool_min_speed;
+    constexpr bool was_retracted = false; // wrong assumption; won't matter that much. (TODO)
 
-        path.estimates.extrude_time_at_minimum_speed = 0.0;
-        path.estimates.extrude_time_at_slowest_path_speed = 0.0;
+    bool is_extrusion_path = false;
+    double* path_time_estimate;
+    double& material_estimate = path.estimates.material;
 
-        if (! path.isTravelPath())
+    path.estimates.extrude_time_at_minimum_speed = 0.0;
+    path.estimates.extrude_time_at_slowest_path_speed = 0.0;
+
+    if (! path.isTravelPath())
+    {
+        is_extrusion_path = true;
+        path_time_estimate = &path.estimates.extrude_time;
+    }
+    else
+    {
+        if (path.retract)
         {
-            is_extrusion_path = true;
-            path_time_estimate = &path.estimates.extrude_time;
+            path_time_estimate = &path.estimates.retracted_travel_time;
         }
         else
         {
+            path_time_estimate = &path.estimates.unretracted_travel_time;
+        }
+        if (path.retract != was_retracted)
+        { // handle retraction times
+            double retract_unretract_time;
             if (path.retract)
             {
-                path_time_estimate = &path.estimates.retracted_travel_time;
+                retract_unretract_time = retraction_config_.distance / retraction_config_.speed;
             }
             else
             {
-                path_time_estimate = &path.estimates.unretracted_travel_time;
-            }
-            if (path.retract != was_retracted)
-            { // handle retraction times
-                double retract_unretract_time;
-                if (path.retract)
-                {
-                    retract_unretract_time = retraction_config_.distance / retraction_config_.speed;
-                }
-                else
-                {
-                    retract_unretract_time = retraction_config_.distance / retraction_config_.primeSpeed;
-                }
-                path.estimates.retracted_travel_time += 0.5 * retract_unretract_time;
-                path.estimates.unretracted_travel_time += 0.5 * retract_unretract_time;
+                retract_unretract_time = retraction_config_.distance / retraction_config_.primeSpeed;
             }
+            path.estimates.retracted_travel_time += 0.5 * retract_unretract_time;
+            path.estimates.unretracted_travel_time += 0.5 * retract_unretract_time;
         }
-        for (Point3LL& p1 : path.points)
+    }
+    for (Point3LL& p1 : path.points)
+    {
+        double length = (p0 - p1).vSizeMM();
+        if (is_extrusion_path)
         {
-            double length = (p0 - p1).vSizeMM();
-            if (is_extrusion_path)
+            if (length > 0)
             {
-                if (length > 0)
-                {
-                    path.estimates.extrude_time_at_minimum_speed += length / min_path_speed;
-                    path.estimates.extrude_time_at_slowest_path_speed += length / slowest_path_speed_;
-                }
-                material_estimate += length * INT2MM(layer_thickness_) * INT2MM(path.config.getLineWidth());
+                path.estimates.extrude_time_at_minimum_speed += length / min_path_speed;
+                path.estimates.extrude_time_at_slowest_path_speed += length / slowest_path_speed_;
             }
-            double thisTime = length / (path.config.getSpeed() * path.speed_factor);
-            *path_time_estimate += thisTime;
-            p0 = p1;
+            material_estimate += length * INT2MM(layer_thickness_) * INT2MM(path.config.getLineWidth());
+        }
+        double thisTime = length / (path.config.getSpeed() * path.speed_factor);
+        *path_time_estimate += thisTime;
+        p0 = p1;
+    }
+}
+
+void ExtruderPlan::precomputeNaiveTimeEstimates(const std::optional<Point2LL>& starting_position)
+{
+    slowest_path_speed_ = computeSlowestPathSpeed();
+    std::optional<Point3LL> p0;
+    if (starting_position)
+    {
+        p0 = Point3LL(*starting_position);
+    }
+    size_t path_idx = 0;
+    for (; path_idx < paths_.size() && ! p0; path_idx++)
+    {
+        // The time to get to the first point depends on where the previous layer ended, so leave these paths to computeNaiveTimeEstimates.
+        if (! paths_[path_idx].points.empty())
+        {
+            p0 = paths_[path_idx].points.back();
         }
+    }
+    precomputed_paths_start_ = path_idx;
+    for (; path_idx < paths_.size(); path_idx++)
+    {
+        computeNaiveTimeEstimates(paths_[path_idx], *p0);
+    }
+}
+
+TimeMaterialEstimates ExtruderPlan::computeNaiveTimeEstimates(Point2LL starting_position)
+{
+    if (! precomputed_paths_start_)
+    {
+        slowest_path_speed_ = computeSlowestPathSpeed();
+    }
+    const size_t paths_end = precomputed_paths_start_.value_or(paths_.size());
+    starting_position_ = starting_position;
+
+    Point3LL p0 = starting_position;
+    for (size_t path_idx = 0; path_idx < paths_end; path_idx++)
+    {
+        computeNaiveTimeEstimates(paths_[path_idx], p0);
+    }
+    for (const GCodePath& path : paths_)
+    {
         estimates_ += path.estimates;
     }
     return estimates_;
@@ -3312,6 +3485,42 @@ void ExtruderPlan::processFanSpeedForFirstLayers()
     }
 }
 
+void LayerPlan::formatExtrusionCoordinates(const GCodeExport& gcode)
+{
+    if (gcode.getFlavor() == EGCodeFlavor::BFB)
+    {
+        return; // Writes the moves differently.
+    }
+    for (ExtruderPlan& extruder_plan : extruder_plans_)
+    {
+        if (Application::getInstance().current_slice_->scene.extruders[extruder_plan.extruder_nr_].settings_.get<bool>("coasting_enable"_setting))
+        {
+            continue; // Coasting writes its own, shortened moves.
+        }
+        for (GCodePath& path : extruder_plan.paths_)
+        {
+            if (! path.isTravelPath() && ! path.spiralize)
+            {
+                path.formatted_xy = gcode.formatExtrusionXY(path.points, extruder_plan.extruder_nr_);
+            }
+        }
+    }
+}
+
+void LayerPlan::precomputeNaiveTimeEstimates()
+{
+    std::optional<Point2LL> starting_position; // Where the previous layer ends is not known yet.
+    for (ExtruderPlan& extruder_plan : extruder_plans_)
+    {
+        extruder_plan.precomputeNaiveTimeEstimates(starting_position);
+        // Same as the starting position that processFanSpeedAndMinimalLayerTime passes to the next extruder plan.
+        if (! extruder_plan.paths_.empty() && ! extruder_plan.paths_.back().points.empty())
+        {
+            starting_position = extruder_plan.paths_.back().points.back().toPoint2LL();
+        }
+    }
+}
+
 void LayerPlan::processFanSpeedAndMinimalLayerTime(Point2LL starting_position)
 {
     // the minimum layer time behaviour is only applied to the last extruder.
@@ -3379,22 +3588,22 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
     // flow-rate compensation
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     gcode.setFlowRateExtrusionSettings(
-        mesh_group_settings.get<double>("flow_rate_max_extrusion_offset"),
-        mesh_group_settings.get<Ratio>("flow_rate_extrusion_offset_factor")); // Offset is in mm.
+        mesh_group_settings.get<double>("flow_rate_max_extrusion_offset"_setting),
+        mesh_group_settings.get<Ratio>("flow_rate_extrusion_offset_factor"_setting)); // Offset is in mm.
 
     static LayerIndex layer_1{ 1 - static_cast<LayerIndex>(Raft::getTotalExtraLayers()) };
-    if (layer_nr_ == layer_1 && mesh_group_settings.get<bool>("machine_heated_bed"))
+    if (layer_nr_ == layer_1 && mesh_group_settings.get<bool>("machine_heated_bed"_setting))
     {
         constexpr bool wait = false;
-        gcode.writeBedTemperatureCommand(mesh_group_settings.get<Temperature>("material_bed_temperature"), wait);
+        gcode.writeBedTemperatureCommand(mesh_group_settings.get<Temperature>("material_bed_temperature"_setting), wait);
     }
-    if (mesh_group_settings.get<size_t>("build_volume_fan_nr") != 0)
+    if (mesh_group_settings.get<size_t>("build_volume_fan_nr"_setting) != 0)
     {
         // The machine has a build volume fan.
-        if (layer_nr_ == mesh_group_settings.get<size_t>("build_fan_full_layer"))
+        if (layer_nr_ == mesh_group_settings.get<size_t>("build_fan_full_layer"_setting))
         {
-            const auto fan_speed = mesh_group_settings.get<Ratio>("build_volume_fan_speed") * 100.0;
-            gcode.writeSpecificFanCommand(fan_speed, mesh_group_settings.get<size_t>("build_volume_fan_nr"));
+            const auto fan_speed = mesh_group_settings.get<Ratio>("build_volume_fan_speed"_setting) * 100.0;
+            gcode.writeSpecificFanCommand(fan_speed, mesh_group_settings.get<size_t>("build_volume_fan_nr"_setting));
         }
     }
 
@@ -3404,10 +3613,10 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
     std::optional<GCodePathConfig> last_extrusion_config = std::nullopt; // used to check whether we need to insert a TYPE comment in the gcode.
 
     size_t extruder_nr = gcode.getExtruderNr();
-    const bool acceleration_enabled = mesh_group_settings.get<bool>("acceleration_enabled");
-    const bool acceleration_travel_enabled = mesh_group_settings.get<bool>("acceleration_travel_enabled");
-    const bool jerk_enabled = mesh_group_settings.get<bool>("jerk_enabled");
-    const bool jerk_travel_enabled = mesh_group_settings.get<bool>("jerk_travel_enabled");
+    const bool acceleration_enabled = mesh_group_settings.get<bool>("acceleration_enabled"_setting);
+    const bool acceleration_travel_enabled = mesh_group_settings.get<bool>("acceleration_travel_enabled"_setting);
+    const bool jerk_enabled = mesh_group_settings.get<bool>("jerk_enabled"_setting);
+    const bool jerk_travel_enabled = mesh_group_settings.get<bool>("jerk_travel_enabled"_setting);
     std::shared_ptr<const SliceMeshStorage> current_mesh;
 
     for (size_t extruder_plan_idx = 0; extruder_plan_idx < extruder_plans_.size(); extruder_plan_idx++)
@@ -3418,7 +3627,7 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
         {
             if (mesh)
             {
-                if (extruder_nr == mesh->settings.get<size_t>("extruder_nr")) [[likely]]
+                if (extruder_nr == mesh->settings.get<size_t>("extruder_nr"_setting)) [[likely]]
                 {
                     return &mesh->retraction_wipe_config;
                 }
@@ -3486,10 +3695,10 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                 gcode.insertWipeScript(wipe_config);
                 gcode.ResetLastEValueAfterWipe(extruder_nr);
             }
-            else if (layer_nr_ != 0 && Application::getInstance().current_slice_->scene.extruders[extruder_nr].settings_.get<bool>("retract_at_layer_change"))
+            else if (layer_nr_ != 0 && Application::getInstance().current_slice_->scene.extruders[extruder_nr].settings_.get<bool>("retract_at_layer_change"_setting))
             {
                 // only do the retract if the paths are not spiralized
-                if (! mesh_group_settings.get<bool>("magic_spiralize"))
+                if (! mesh_group_settings.get<bool>("magic_spiralize"_setting))
                 {
                     gcode.writeRetraction(retraction_config->retraction_config);
                 }
@@ -3537,7 +3746,7 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
 
             if (path.perform_prime)
             {
-                gcode.writePrimeTrain(extruder.settings_.get<Velocity>("speed_travel"));
+                gcode.writePrimeTrain(extruder.settings_.get<Velocity>("speed_travel"_setting));
                 // Don't update cumulative path time, as ComputeNaiveTimeEstimates also doesn't.
                 gcode.writeRetraction(retraction_config->retraction_config);
             }
@@ -3715,7 +3924,7 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                     // Before the final travel, move up to the next layer height, on the current spot, with a sensible speed.
                     Point3LL current_position = gcode.getPosition();
                     current_position.z_ = final_travel_z_;
-                    gcode.writeTravel(current_position, extruder.settings_.get<Velocity>("speed_z_hop"));
+                    gcode.writeTravel(current_position, extruder.settings_.get<Velocity>("speed_z_hop"_setting));
 
                     // Prevent the final travel(s) from resetting to the 'previous' layer height.
                     path.z_offset = final_travel_z_ - z_;
@@ -3759,7 +3968,7 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
             bool spiralize = path.spiralize;
             if (! spiralize) // normal (extrusion) move (with coasting)
             {
-                bool coasting = extruder.settings_.get<bool>("coasting_enable");
+                bool coasting = extruder.settings_.get<bool>("coasting_enable"_setting);
                 if (coasting)
                 {
                     coasting = writePathWithCoasting(gcode, extruder_plan_idx, path_idx, insertTempOnTime, coasting_per_path[path_idx]);
@@ -3767,13 +3976,22 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                 if (! coasting) // not same as 'else', cause we might have changed [coasting] in the line above...
                 { // normal path to gcode algorithm
                     Point3LL prev_point = gcode.getPosition();
+                    std::string_view formatted_xy = path.formatted_xy;
                     for (const auto& pt : path.points)
                     {
                         const auto [_, time] = extruder_plan.getPointToPointTime(prev_point, pt, path);
                         insertTempOnTime(time, path_idx);
 
                         const double extrude_speed = speed * path.speed_back_pressure_factor;
-                        writeExtrusionRelativeZ(gcode, pt, extrude_speed, path.z_offset, path.getExtrusionMM3perMM(), path.config.type, update_extrusion_offset);
+                        writeExtrusionRelativeZ(
+                            gcode,
+                            pt,
+                            extrude_speed,
+                            path.z_offset,
+                            path.getExtrusionMM3perMM(),
+                            path.config.type,
+                            update_extrusion_offset,
+                            GCodeExport::popFormattedXY(formatted_xy));
                         sendLineTo(path, pt, extrude_speed);
 
                         prev_point = pt;
@@ -3840,13 +4058,13 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
             }
         } // paths for this extruder /\  .
 
-        if (extruder.settings_.get<bool>("cool_lift_head") && extruder_plan.extra_time_ > 0.0)
+        if (extruder.settings_.get<bool>("cool_lift_head"_setting) && extruder_plan.extra_time_ > 0.0)
         {
             gcode.writeComment("Small layer, adding delay");
             const RetractionAndWipeConfig& actual_retraction_config
                 = current_mesh ? current_mesh->retraction_wipe_config : storage_.retraction_wipe_config_per_extruder[gcode.getExtruderNr()];
             gcode.writeRetraction(actual_retraction_config.retraction_config);
-            if (extruder_plan_idx == extruder_plans_.size() - 1 || ! extruder.settings_.get<bool>("machine_extruder_end_pos_abs"))
+            if (extruder_plan_idx == extruder_plans_.size() - 1 || ! extruder.settings_.get<bool>("machine_extruder_end_pos_abs"_setting))
             { // only do the z-hop if it's the last extruder plan; otherwise it's already at the switching bay area
                 // or do it anyway when we switch extruder in-place
                 gcode.writeZhopStart(MM2INT(3.0));
@@ -3963,7 +4181,7 @@ bool LayerPlan::writePathWithCoasting(
         auto [_, time] = extruder_plan.getPointToPointTime(previous_position, path.points[point_idx], path);
         insertTempOnTime(time, path_idx);
 
-        const Ratio coasting_speed_modifier = extruder.settings_.get<Ratio>("coasting_speed");
+        const Ratio coasting_speed_modifier = extruder.settings_.get<Ratio>("coasting_speed"_setting);
         const Velocity speed = Velocity(coasting_speed_modifier * path.config.getSpeed());
         writeTravelRelativeZ(gcode, path.points[point_idx], speed, path.z_offset);
 
@@ -4051,7 +4269,7 @@ void LayerPlan::applyBackPressureCompensation()
     for (auto& extruder_plan : extruder_plans_)
     {
         const Ratio back_pressure_compensation
-            = Application::getInstance().current_slice_->scene.extruders[extruder_plan.extruder_nr_].settings_.get<Ratio>("speed_equalize_flow_width_factor");
+            = Application::getInstance().current_slice_->scene.extruders[extruder_plan.extruder_nr_].settings_.get<Ratio>("speed_equalize_flow_width_factor"_setting);
         if (back_pressure_compensation != 0.0)
         {
             extruder_plan.applyBackPressureCompensation(back_pressure_compensation);
@@ -4152,11 +4370,23 @@ void LayerPlan::setBridgeWallMask(const Shape& polys)
 {
     bridge_wall_mask_ = polys;
     bridge_wall_mask_bb_ = AABB(polys);
+    indexed_bridge_wall_mask_ = SegmentIndexedShape(polys);
+}
+
+BridgeLayerContext& LayerPlan::getBridgeLayerContext()
+{
+    return bridge_layer_context_;
 }
 
 void LayerPlan::setOverhangMasks(const std::vector<OverhangMask>& masks)
 {
     overhang_masks_ = masks;
+    indexed_overhang_masks_.clear();
+    indexed_overhang_masks_.reserve(masks.size());
+    for (const OverhangMask& mask : masks)
+    {
+        indexed_overhang_masks_.emplace_back(mask.supported_region);
+    }
 }
 
 void LayerPlan::setSeamOverhangMask(const Shape& polys)
@@ -4172,11 +4402,13 @@ const Shape& LayerPlan::getSeamOverhangMask() const
 void LayerPlan::setRoofingMask(const Shape& polys)
 {
     roofing_mask_ = polys;
+    indexed_roofing_mask_ = SegmentIndexedShape(polys);
 }
 
 void LayerPlan::setFlooringMask(const Shape& shape)
 {
     flooring_mask_ = shape;
+    indexed_flooring_mask_ = SegmentIndexedShape(shape);
 }
 
 template void LayerPlan::addLinesByOptimizer(
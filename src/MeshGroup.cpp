@@ -25,6 +25,7 @@
 #include "utils/MeshUtils.h"
 #include "utils/Point2F.h"
 #include "utils/Point3F.h" //To accept incoming meshes with floating point vertices.
+#include "utils/ThreadPool.h"
 #include "utils/gettime.h"
 #include "utils/section_type.h"
 #include "utils/string.h"
@@ -184,20 +185,16 @@ bool loadMeshSTL_binary(Mesh* mesh, const fs::path& filename, const Matrix4x3D&
 
     fseek(f, 0L, SEEK_END);
     long long file_size = ftell(f); // The file size is the position of the cursor after seeking to the end.
-    rewind(f); // Seek back to start.
-    size_t face_count = (file_size - 80 - sizeof(uint32_t)) / 50; // Subtract the size of the header. Every face uses exactly 50 bytes.
-
-    char buffer[80];
-    // Skip the header
-    if (fread(buffer, 80, 1, f) != 1)
+    if (file_size < 80 + static_cast<long long>(sizeof(uint32_t)))
     {
         fclose(f);
         return false;
     }
+    size_t face_count = (file_size - 80 - sizeof(uint32_t)) / 50; // Subtract the size of the header. Every face uses exactly 50 bytes.
 
     uint32_t reported_face_count;
-    // Read the face count. We'll use it as a sort of redundancy code to check for file corruption.
-    if (fread(&reported_face_count, sizeof(uint32_t), 1, f) != 1)
+    // Read the face count (after the 80 byte header). We'll use it as a sort of redundancy code to check for file corruption.
+    if (fseek(f, 80L, SEEK_SET) != 0 || fread(&reported_face_count, sizeof(uint32_t), 1, f) != 1)
     {
         fclose(f);
         return false;
@@ -210,38 +207,46 @@ bool loadMeshSTL_binary(Mesh* mesh, const fs::path& filename, const Matrix4x3D&
     // For each face read:
     // float(x,y,z) = normal, float(X,Y,Z)*3 = vertexes, uint16_t = flags
     //  Every Face is 50 Bytes: Normal(3*float), Vertices(9*float), 2 Bytes Spacer
-    mesh->faces_.reserve(face_count);
-    mesh->vertices_.reserve(face_count);
-
-    size_t vertex_index = 0;
-    for (size_t i = 0; i < face_count; i++)
-    {
-        if (fread(buffer, 50, 1, f) != 1)
+    // The faces are read in chunks of many faces at a time rather than face by face, but without holding the whole file in memory next to the corners.
+    constexpr size_t chunk_face_count = 1 << 16;
+    std::vector<char> chunk(std::min(face_count, chunk_face_count) * 50);
+    std::vector<Point3LL> corners(face_count * 3);
+    for (size_t chunk_start = 0; chunk_start < face_count; chunk_start += chunk_face_count)
+    {
+        const size_t chunk_faces = std::min(chunk_face_count, face_count - chunk_start);
+        if (fread(chunk.data(), 50, chunk_faces, f) != chunk_faces)
         {
             fclose(f);
             return false;
         }
-        float* v = reinterpret_cast<float*>(buffer) + 3;
-
-        Point3LL v0 = matrix.apply(Point3F(v[0], v[1], v[2]).toPoint3d());
-        Point3LL v1 = matrix.apply(Point3F(v[3], v[4], v[5]).toPoint3d());
-        Point3LL v2 = matrix.apply(Point3F(v[6], v[7], v[8]).toPoint3d());
+        cura::parallel_for(
+            size_t(0),
+            chunk_faces,
+            [&](const size_t i)
+            {
+                float v[9];
+                memcpy(v, chunk.data() + i * 50 + 3 * sizeof(float), sizeof(v));
 
-        // Handle UV coordinates if provided
-        if (uv_coordinates && vertex_index + 2 < uv_coordinates->size())
-        {
-            std::optional<Point2F> uv0 = (*uv_coordinates)[vertex_index];
-            std::optional<Point2F> uv1 = (*uv_coordinates)[vertex_index + 1];
-            std::optional<Point2F> uv2 = (*uv_coordinates)[vertex_index + 2];
-            vertex_index += 3;
-            mesh->addFace(v0, v1, v2, uv0, uv1, uv2);
-        }
-        else
-        {
-            mesh->addFace(v0, v1, v2);
-        }
+                const size_t face_idx = chunk_start + i;
+                corners[face_idx * 3] = matrix.apply(Point3F(v[0], v[1], v[2]).toPoint3d());
+                corners[face_idx * 3 + 1] = matrix.apply(Point3F(v[3], v[4], v[5]).toPoint3d());
+                corners[face_idx * 3 + 2] = matrix.apply(Point3F(v[6], v[7], v[8]).toPoint3d());
+            },
+            1024);
     }
     fclose(f);
+
+    // Handle UV coordinates if provided
+    std::vector<std::optional<Point2F>> corner_uv_coordinates;
+    if (uv_coordinates)
+    {
+        // Only faces for which all three corners have UV coordinates get them.
+        const size_t uv_face_count = std::min(face_count, uv_coordinates->size() >= 3 ? (uv_coordinates->size() - 3) / 3 + 1 : 0);
+        corner_uv_coordinates.assign(uv_coordinates->begin(), uv_coordinates->begin() + static_cast<ptrdiff_t>(uv_face_count * 3));
+    }
+
+    mesh->faces_.reserve(face_count);
+    mesh->addFaces(corners, corner_uv_coordinates);
     mesh->finish();
     return true;
 }
@@ -24,6 +24,8 @@ Scene::Scene(const size_t num_mesh_groups)
     }
 }
 
+Scene::~Scene() = default;
+
 const std::string Scene::getAllSettingsString() const
 {
     std::stringstream output;
@@ -68,6 +70,11 @@ void Scene::processMeshGroup(MeshGroup& mesh_group)
     fff_processor->time_keeper.restart();
 
     TimeKeeper time_keeper_total;
+    const bool count_saved_parses = spdlog::should_log(spdlog::level::debug);
+    if (count_saved_parses)
+    {
+        Settings::startCountingSavedParses();
+    }
 
     bool empty = true;
     for (Mesh& mesh : mesh_group.meshes)
@@ -81,22 +88,55 @@ void Scene::processMeshGroup(MeshGroup& mesh_group)
     if (empty)
     {
         Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
+        Settings::stopCountingSavedParses();
         spdlog::info("Total time elapsed {:03.3f}s", time_keeper_total.restart());
         return;
     }
 
-    SliceDataStorage storage;
-    if (! fff_processor->polygon_generator.generateAreas(storage, &mesh_group, fff_processor->time_keeper))
+    auto storage = std::make_unique<SliceDataStorage>();
+    if (! fff_processor->polygon_generator.generateAreas(*storage, &mesh_group, fff_processor->time_keeper))
     {
+        Settings::stopCountingSavedParses();
         return;
     }
 
     Progress::messageProgressStage(Progress::Stage::EXPORT, &fff_processor->time_keeper);
-    fff_processor->gcode_writer.writeGCode(storage, fff_processor->time_keeper);
+    fff_processor->gcode_writer->writeGCode(*storage, fff_processor->time_keeper);
 
     Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
     Application::getInstance().communication_->sendOptimizedLayerData();
+    if (count_saved_parses)
+    {
+        spdlog::debug("Settings lookups that skipped parsing: {}", Settings::stopCountingSavedParses());
+    }
     spdlog::info("Total time elapsed {:03.3f}s\n", time_keeper_total.restart());
+
+    if (keep_slice_data)
+    {
+        const size_t mesh_group_index = &mesh_group - mesh_groups.data();
+        kept_slice_data_.resize(mesh_groups.size());
+        kept_slice_data_[mesh_group_index] = std::move(storage);
+    }
+}
+
+void Scene::rewriteMeshGroupGCode(MeshGroup& mesh_group)
+{
+    FffProcessor* fff_processor = FffProcessor::getInstance();
+    fff_processor->time_keeper.restart();
+
+    const size_t mesh_group_index = &mesh_group - mesh_groups.data();
+    if (mesh_group_index >= kept_slice_data_.size() || ! kept_slice_data_[mesh_group_index])
+    {
+        Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
+        return;
+    }
+
+    Progress::messageProgressStage(Progress::Stage::EXPORT, &fff_processor->time_keeper);
+    fff_processor->gcode_writer->writeGCode(*kept_slice_data_[mesh_group_index], fff_processor->time_keeper);
+
+    Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
+    Application::getInstance().communication_->sendOptimizedLayerData();
+    spdlog::info("Rewrote g-code without slicing in {:03.3f}s\n", fff_processor->time_keeper.restart());
 }
 
 } // namespace cura
@@ -337,12 +337,14 @@ SkirtBrim::Outline SkirtBrim::getFirstLayerOutline(const int extruder_nr /* = -1
         }
         skirt_height = std::min(skirt_height, static_cast<int>(storage_.print_layer_count));
 
+        std::vector<Shape> layer_outlines;
         for (int i_layer = layer_nr; i_layer < skirt_height; ++i_layer)
         {
             constexpr bool include_support = true;
             constexpr bool include_prime_tower = true;
-            first_layer_outline.gapped = first_layer_outline.gapped.unionPolygons(storage_.getLayerOutlines(i_layer, include_support, include_prime_tower, true));
+            layer_outlines.push_back(storage_.getLayerOutlines(i_layer, include_support, include_prime_tower, true));
         }
+        first_layer_outline.gapped = Shape::unionShapes(std::move(layer_outlines));
 
         Shape shields;
         if (has_ooze_shield_)
@@ -388,7 +390,7 @@ SkirtBrim::Outline SkirtBrim::getFirstLayerOutline(const int extruder_nr /* = -1
                 //  |+-+|     |+--+|
                 //  +---+     +----+
                 const coord_t primary_extruder_skirt_brim_line_width = reference_extruder_config.line_width_;
-                Shape model_brim_covered_area;
+                std::vector<Shape> brim_fringes;
 
                 // always leave a gap of an even number of brim lines, so that it fits if it's generating brim from both sides
                 const coord_t offset = primary_extruder_skirt_brim_line_width * (primary_line_count + primary_line_count % 2);
@@ -411,9 +413,9 @@ SkirtBrim::Outline SkirtBrim::getFirstLayerOutline(const int extruder_nr /* = -1
                         inset = polygon.offset(-offset, ClipperLib::jtRound);
                     }
 
-                    outset = outset.difference(inset);
-                    model_brim_covered_area = model_brim_covered_area.unionPolygons(outset);
+                    brim_fringes.push_back(outset.difference(inset));
                 }
+                const Shape model_brim_covered_area = Shape::unionShapes(std::move(brim_fringes));
 
                 AABB model_brim_covered_area_boundary_box(model_brim_covered_area);
                 support_layer.excludeAreasFromSupportInfillAreas(model_brim_covered_area, model_brim_covered_area_boundary_box);
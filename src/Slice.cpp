@@ -42,6 +42,21 @@ void Slice::compute()
     FffProcessor::getInstance()->finalize();
 }
 
+void Slice::rewriteGCode()
+{
+    for (std::vector<MeshGroup>::iterator mesh_group = scene.mesh_groups.begin(); mesh_group != scene.mesh_groups.end(); mesh_group++)
+    {
+        scene.current_mesh_group = mesh_group;
+        for (ExtruderTrain& extruder : scene.extruders)
+        {
+            extruder.settings_.setParent(&scene.current_mesh_group->settings);
+        }
+        scene.rewriteMeshGroupGCode(*mesh_group);
+    }
+
+    FffProcessor::getInstance()->finalize();
+}
+
 void Slice::reset()
 {
     scene.extruders.clear();
@@ -3,6 +3,8 @@
 
 #include "TreeModelVolumes.h"
 
+#include <string_view>
+
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -345,10 +347,7 @@ const Shape& TreeModelVolumes::getCollision(coord_t radius, LayerIndex layer_idx
     }
     RadiusLayerPair key{ radius, layer_idx };
 
-    {
-        std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_avoidance_cache_);
-        result = getArea(collision_cache_, key);
-    }
+    result = collision_cache_.find(key);
     if (result)
     {
         return result.value().get();
@@ -375,10 +374,7 @@ const Shape& TreeModelVolumes::getCollisionHolefree(coord_t radius, LayerIndex l
     }
     RadiusLayerPair key{ radius, layer_idx };
 
-    {
-        std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_collision_cache_holefree_);
-        result = getArea(collision_cache_holefree_, key);
-    }
+    result = collision_cache_holefree_.find(key);
     if (result)
     {
         return result.value().get();
@@ -393,13 +389,10 @@ const Shape& TreeModelVolumes::getCollisionHolefree(coord_t radius, LayerIndex l
 
 const Shape& TreeModelVolumes::getAccumulatedPlaceable0(LayerIndex layer_idx)
 {
+    const std::optional<std::reference_wrapper<const Shape>> result = accumulated_placeables_cache_radius_0_.find(layer_idx);
+    if (result)
     {
-        std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_accumulated_placeables_cache_radius_0_);
-        auto iterator = accumulated_placeables_cache_radius_0_.find(layer_idx);
-        if (iterator != accumulated_placeables_cache_radius_0_.end())
-        {
-            return iterator->second;
-        }
+        return result.value().get();
     }
     calculateAccumulatedPlaceable0(layer_idx);
     return getAccumulatedPlaceable0(layer_idx);
@@ -426,21 +419,17 @@ const Shape& TreeModelVolumes::getAvoidance(coord_t radius, LayerIndex layer_idx
 
     const RadiusLayerPair key{ radius, layer_idx };
 
-    std::unordered_map<RadiusLayerPair, Shape>* cache_ptr = nullptr;
-    std::mutex* mutex_ptr = nullptr;
+    RadiusLayerCache* cache_ptr = nullptr;
     switch (type)
     {
     case AvoidanceType::FAST:
         cache_ptr = to_model ? &avoidance_cache_to_model_ : &avoidance_cache_;
-        mutex_ptr = to_model ? critical_avoidance_cache_to_model_.get() : critical_avoidance_cache_.get();
         break;
     case AvoidanceType::SLOW:
         cache_ptr = to_model ? &avoidance_cache_to_model_slow_ : &avoidance_cache_slow_;
-        mutex_ptr = to_model ? critical_avoidance_cache_to_model_slow_.get() : critical_avoidance_cache_slow_.get();
         break;
     case AvoidanceType::FAST_SAFE:
         cache_ptr = to_model ? &avoidance_cache_hole_to_model_ : &avoidance_cache_hole_;
-        mutex_ptr = to_model ? critical_avoidance_cache_holefree_to_model_.get() : critical_avoidance_cache_holefree_.get();
         break;
     case AvoidanceType::COLLISION:
         if (layer_idx <= max_layer_idx_without_blocker_)
@@ -450,7 +439,6 @@ const Shape& TreeModelVolumes::getAvoidance(coord_t radius, LayerIndex layer_idx
         else
         {
             cache_ptr = &avoidance_cache_collision_;
-            mutex_ptr = critical_avoidance_cache_collision_.get();
         }
         break;
     default:
@@ -458,10 +446,7 @@ const Shape& TreeModelVolumes::getAvoidance(coord_t radius, LayerIndex layer_idx
         break;
     }
 
-    {
-        std::lock_guard<std::mutex> critical_section(*mutex_ptr);
-        result = getArea(*cache_ptr, key);
-    }
+    result = cache_ptr->find(key);
     if (result)
     {
         return result.value().get();
@@ -497,10 +482,7 @@ const Shape& TreeModelVolumes::getPlaceableAreas(coord_t radius, LayerIndex laye
     radius = ceilRadius(radius);
     RadiusLayerPair key{ radius, layer_idx };
 
-    {
-        std::lock_guard<std::mutex> critical_section(*critical_placeable_areas_cache_);
-        result = getArea(placeable_areas_cache_, key);
-    }
+    result = placeable_areas_cache_.find(key);
     if (result)
     {
         return result.value().get();
@@ -536,11 +518,8 @@ const Shape& TreeModelVolumes::getWallRestriction(coord_t radius, LayerIndex lay
     radius = ceilRadius(radius);
     const RadiusLayerPair key{ radius, layer_idx };
 
-    std::unordered_map<RadiusLayerPair, Shape>* cache_ptr = min_xy_dist ? &wall_restrictions_cache_min_ : &wall_restrictions_cache_;
-    {
-        std::lock_guard<std::mutex> critical_section(min_xy_dist ? *critical_wall_restrictions_cache_min_ : *critical_wall_restrictions_cache_);
-        result = getArea(*cache_ptr, key);
-    }
+    const RadiusLayerCache& cache = min_xy_dist ? wall_restrictions_cache_min_ : wall_restrictions_cache_;
+    result = cache.find(key);
     if (result)
     {
         return result.value().get();
@@ -554,6 +533,28 @@ const Shape& TreeModelVolumes::getWallRestriction(coord_t radius, LayerIndex lay
     return getWallRestriction(orig_radius, layer_idx, min_xy_dist); // Retrieve failed and correct result was calculated. Now it has to be retrieved.
 }
 
+void TreeModelVolumes::logCacheStatistics() const
+{
+    const auto log_cache = [](const std::string_view name, const auto& cache)
+    {
+        const auto statistics = cache.getStatistics();
+        spdlog::debug("Tree support {} cache: {} entries, {} hits, {} misses, {} contended locks", name, statistics.size, statistics.hits, statistics.misses, statistics.contended);
+    };
+    log_cache("collision", collision_cache_);
+    log_cache("collision holefree", collision_cache_holefree_);
+    log_cache("accumulated placeables", accumulated_placeables_cache_radius_0_);
+    log_cache("avoidance collision", avoidance_cache_collision_);
+    log_cache("avoidance", avoidance_cache_);
+    log_cache("avoidance slow", avoidance_cache_slow_);
+    log_cache("avoidance to model", avoidance_cache_to_model_);
+    log_cache("avoidance to model slow", avoidance_cache_to_model_slow_);
+    log_cache("placeable areas", placeable_areas_cache_);
+    log_cache("avoidance holefree", avoidance_cache_hole_);
+    log_cache("avoidance holefree to model", avoidance_cache_hole_to_model_);
+    log_cache("wall restrictions", wall_restrictions_cache_);
+    log_cache("wall restrictions min", wall_restrictions_cache_min_);
+}
+
 coord_t TreeModelVolumes::ceilRadius(coord_t radius, bool min_xy_dist) const
 {
     return ceilRadius(radius + (min_xy_dist ? 0 : current_min_xy_dist_delta_));
@@ -593,18 +594,18 @@ Shape TreeModelVolumes::extractOutlineFromMesh(const SliceMeshStorage& mesh, Lay
     return Simplify(maximum_resolution, maximum_deviation, maximum_area_deviation).polygon(total);
 }
 
-LayerIndex TreeModelVolumes::getMaxCalculatedLayer(coord_t radius, const std::unordered_map<RadiusLayerPair, Shape>& map) const
+LayerIndex TreeModelVolumes::getMaxCalculatedLayer(coord_t radius, const RadiusLayerCache& map) const
 {
     LayerIndex max_layer = -1;
 
     // the placeable on model areas do not exist on layer 0, as there can not be model below it. As such it may be possible that layer 1 is available, but layer 0 does not exist.
     const RadiusLayerPair key_layer_1(radius, 1);
-    if (getArea(map, key_layer_1))
+    if (map.contains(key_layer_1))
     {
         max_layer = 1;
     }
 
-    while (map.count(RadiusLayerPair(radius, max_layer + 1)))
+    while (map.contains(RadiusLayerPair(radius, max_layer + 1)))
     {
         max_layer++;
     }
@@ -621,8 +622,9 @@ void TreeModelVolumes::calculateCollision(const std::deque<RadiusLayerPair>& key
         {
             const coord_t radius = keys[i].first;
             RadiusLayerPair key(radius, 0);
-            std::unordered_map<RadiusLayerPair, Shape> data_outer;
-            std::unordered_map<RadiusLayerPair, Shape> data_placeable_outer;
+            // The areas of every outline, unioned per layer once all outlines are done.
+            std::unordered_map<RadiusLayerPair, std::vector<Shape>> data_outer;
+            std::unordered_map<RadiusLayerPair, std::vector<Shape>> data_placeable_outer;
             for (const auto outline_idx : ranges::views::iota(0UL, layer_outlines_.size()))
             {
                 std::unordered_map<RadiusLayerPair, Shape> data;
@@ -640,11 +642,7 @@ void TreeModelVolumes::calculateCollision(const std::deque<RadiusLayerPair>& key
                 // be added at request time. Avoiding this would require saving each collision for each outline_idx separately,
                 //   and later for each avoidance... But avoidance calculation has to be for the whole scene and can NOT be done for each outline_idx separately and combined later.
                 // So avoiding this inaccuracy seems infeasible as it would require 2x the avoidance calculations => 0.5x the performance.
-                coord_t min_layer_bottom;
-                {
-                    std::lock_guard<std::mutex> critical_section(*critical_collision_cache_);
-                    min_layer_bottom = getMaxCalculatedLayer(radius, collision_cache_) - z_distance_bottom_layers;
-                }
+                coord_t min_layer_bottom = getMaxCalculatedLayer(radius, collision_cache_) - z_distance_bottom_layers;
 
                 if (min_layer_bottom < 0)
                 {
@@ -730,17 +728,15 @@ void TreeModelVolumes::calculateCollision(const std::deque<RadiusLayerPair>& key
                     data.erase(RadiusLayerPair(radius, layer_idx)); // all these dont have the correct z_distance_top_layers as they can still have areas above them
                 }
 
-                for (auto pair : data)
+                for (auto& [layer_key, area] : data)
                 {
-                    pair.second = simplifier_.polygon(pair.second);
-                    data_outer[pair.first] = data_outer[pair.first].unionPolygons(pair.second);
+                    data_outer[layer_key].push_back(simplifier_.polygon(area));
                 }
                 if (radius == 0)
                 {
-                    for (auto pair : data_placeable)
+                    for (auto& [layer_key, area] : data_placeable)
                     {
-                        pair.second = simplifier_.polygon(pair.second);
-                        data_placeable_outer[pair.first] = data_placeable_outer[pair.first].unionPolygons(pair.second);
+                        data_placeable_outer[layer_key].push_back(simplifier_.polygon(area));
                     }
                 }
             }
@@ -755,15 +751,15 @@ void TreeModelVolumes::calculateCollision(const std::deque<RadiusLayerPair>& key
                 }
             }
 
+            for (auto& [layer_key, areas] : data_outer)
             {
-                std::lock_guard<std::mutex> critical_section(*critical_collision_cache_);
-                collision_cache_.insert(data_outer.begin(), data_outer.end());
+                collision_cache_.insert(layer_key, Shape::unionShapes(std::move(areas)));
             }
             if (radius == 0)
             {
+                for (auto& [layer_key, areas] : data_placeable_outer)
                 {
-                    std::lock_guard<std::mutex> critical_section(*critical_placeable_areas_cache_);
-                    placeable_areas_cache_.insert(data_placeable_outer.begin(), data_placeable_outer.end());
+                    placeable_areas_cache_.insert(layer_key, Shape::unionShapes(std::move(areas)));
                 }
             }
         });
@@ -794,10 +790,7 @@ void TreeModelVolumes::calculateCollisionHolefree(const std::deque<RadiusLayerPa
                 data[RadiusLayerPair(radius, layer_idx)] = col;
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_collision_cache_holefree_);
-                collision_cache_holefree_.insert(data.begin(), data.end());
-            }
+            collision_cache_holefree_.insert(data.begin(), data.end());
         });
 }
 
@@ -809,19 +802,15 @@ void TreeModelVolumes::calculateAccumulatedPlaceable0(const LayerIndex max_layer
     {
         // the placeable on model areas do not exist on layer 0, as there can not be model below it. As such it may be possible that layer 1 is available, but layer 0 does not
         // exist.
-        std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_accumulated_placeables_cache_radius_0_);
-        accumulated_placeables_cache_radius_0_[max_layer] = Shape();
+        accumulated_placeables_cache_radius_0_.insert(max_layer, Shape());
         return;
     }
 
+    while (accumulated_placeables_cache_radius_0_.contains(start_layer + 1))
     {
-        std::lock_guard<std::mutex> critical_section(*critical_accumulated_placeables_cache_radius_0_);
-        while (accumulated_placeables_cache_radius_0_.contains(start_layer + 1))
-        {
-            ++start_layer;
-        }
-        start_layer = std::max(LayerIndex{ start_layer + 1 }, LayerIndex{ 1 });
+        ++start_layer;
     }
+    start_layer = std::max(LayerIndex{ start_layer + 1 }, LayerIndex{ 1 });
     if (start_layer > max_layer)
     {
         spdlog::warn("Requested calculation for value already calculated ?");
@@ -837,7 +826,6 @@ void TreeModelVolumes::calculateAccumulatedPlaceable0(const LayerIndex max_layer
     for (LayerIndex layer = start_layer; layer <= max_layer; layer++)
     {
         accumulated_placeable_0 = accumulated_placeable_0.unionPolygons(getPlaceableAreas(0, layer).offset(FUDGE_LENGTH)).difference(anti_overhang_[layer]);
-        std::lock_guard<std::mutex> critical_section(*critical_accumulated_placeables_cache_radius_0_);
         accumulated_placeable_0 = simplifier_.polygon(accumulated_placeable_0);
         data[layer] = std::pair(layer, accumulated_placeable_0);
     }
@@ -848,10 +836,7 @@ void TreeModelVolumes::calculateAccumulatedPlaceable0(const LayerIndex max_layer
         {
             data[layer_idx].second = data[layer_idx].second.offset(-(current_min_xy_dist_ + current_min_xy_dist_delta_));
         });
-    {
-        std::lock_guard<std::mutex> critical_section(*critical_accumulated_placeables_cache_radius_0_);
-        accumulated_placeables_cache_radius_0_.insert(data.begin(), data.end());
-    }
+    accumulated_placeables_cache_radius_0_.insert(data.begin(), data.end());
 }
 
 
@@ -865,11 +850,7 @@ void TreeModelVolumes::calculateCollisionAvoidance(const std::deque<RadiusLayerP
             const coord_t radius = keys[key_idx].first;
             const LayerIndex max_required_layer = keys[key_idx].second;
             const coord_t max_step_move = std::max(1.9 * radius, current_min_xy_dist_ * 1.9);
-            LayerIndex start_layer = 0;
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_avoidance_cache_collision_);
-                start_layer = 1 + std::max(getMaxCalculatedLayer(radius, avoidance_cache_collision_), max_layer_idx_without_blocker_);
-            }
+            const LayerIndex start_layer = 1 + std::max(getMaxCalculatedLayer(radius, avoidance_cache_collision_), max_layer_idx_without_blocker_);
 
             if (start_layer > max_required_layer)
             {
@@ -898,10 +879,7 @@ void TreeModelVolumes::calculateCollisionAvoidance(const std::deque<RadiusLayerP
                 data[layer] = std::pair<RadiusLayerPair, Shape>(key, latest_avoidance);
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_avoidance_cache_collision_);
-                avoidance_cache_collision_.insert(data.begin(), data.end());
-            }
+            avoidance_cache_collision_.insert(data.begin(), data.end());
         });
 }
 
@@ -956,11 +934,7 @@ void TreeModelVolumes::calculateAvoidance(const std::deque<RadiusLayerPair>& key
             const coord_t max_step_move = std::max(1.9 * radius, current_min_xy_dist_ * 1.9);
             RadiusLayerPair key(radius, 0);
             Shape latest_avoidance;
-            LayerIndex start_layer;
-            {
-                std::lock_guard<std::mutex> critical_section(*(slow ? critical_avoidance_cache_slow_ : holefree ? critical_avoidance_cache_holefree_ : critical_avoidance_cache_));
-                start_layer = 1 + getMaxCalculatedLayer(radius, slow ? avoidance_cache_slow_ : holefree ? avoidance_cache_hole_ : avoidance_cache_);
-            }
+            LayerIndex start_layer = 1 + getMaxCalculatedLayer(radius, slow ? avoidance_cache_slow_ : holefree ? avoidance_cache_hole_ : avoidance_cache_);
             if (start_layer > max_required_layer)
             {
                 spdlog::debug("Requested calculation for value already calculated ?");
@@ -1006,10 +980,7 @@ void TreeModelVolumes::calculateAvoidance(const std::deque<RadiusLayerPair>& key
                 }
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(*(slow ? critical_avoidance_cache_slow_ : holefree ? critical_avoidance_cache_holefree_ : critical_avoidance_cache_));
-                (slow ? avoidance_cache_slow_ : holefree ? avoidance_cache_hole_ : avoidance_cache_).insert(data.begin(), data.end());
-            }
+            (slow ? avoidance_cache_slow_ : holefree ? avoidance_cache_hole_ : avoidance_cache_).insert(data.begin(), data.end());
         });
 }
 
@@ -1027,11 +998,7 @@ void TreeModelVolumes::calculatePlaceables(const std::deque<RadiusLayerPair>& ke
             std::vector<std::pair<RadiusLayerPair, Shape>> data(max_required_layer + 1, std::pair<RadiusLayerPair, Shape>(RadiusLayerPair(radius, -1), Shape()));
             RadiusLayerPair key(radius, 0);
 
-            LayerIndex start_layer;
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_placeable_areas_cache_);
-                start_layer = 1 + getMaxCalculatedLayer(radius, placeable_areas_cache_);
-            }
+            LayerIndex start_layer = 1 + getMaxCalculatedLayer(radius, placeable_areas_cache_);
             if (start_layer > max_required_layer)
             {
                 spdlog::debug("Requested calculation for value already calculated ?");
@@ -1063,10 +1030,7 @@ void TreeModelVolumes::calculatePlaceables(const std::deque<RadiusLayerPair>& ke
                 }
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_placeable_areas_cache_);
-                placeable_areas_cache_.insert(data.begin(), data.end());
-            }
+            placeable_areas_cache_.insert(data.begin(), data.end());
         });
 }
 
@@ -1101,15 +1065,7 @@ void TreeModelVolumes::calculateAvoidanceToModel(const std::deque<RadiusLayerPai
             std::vector<std::pair<RadiusLayerPair, Shape>> data(max_required_layer + 1, std::pair<RadiusLayerPair, Shape>(RadiusLayerPair(radius, -1), Shape()));
             RadiusLayerPair key(radius, 0);
 
-            LayerIndex start_layer;
-
-            {
-                std::lock_guard<std::mutex> critical_section(
-                    *(slow       ? critical_avoidance_cache_to_model_slow_
-                      : holefree ? critical_avoidance_cache_holefree_to_model_
-                                 : critical_avoidance_cache_to_model_));
-                start_layer = 1 + getMaxCalculatedLayer(radius, slow ? avoidance_cache_to_model_slow_ : holefree ? avoidance_cache_hole_to_model_ : avoidance_cache_to_model_);
-            }
+            LayerIndex start_layer = 1 + getMaxCalculatedLayer(radius, slow ? avoidance_cache_to_model_slow_ : holefree ? avoidance_cache_hole_to_model_ : avoidance_cache_to_model_);
             start_layer = std::max(start_layer, LayerIndex(1));
             if (start_layer > max_required_layer)
             {
@@ -1155,13 +1111,7 @@ void TreeModelVolumes::calculateAvoidanceToModel(const std::deque<RadiusLayerPai
                 }
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(
-                    *(slow       ? critical_avoidance_cache_to_model_slow_
-                      : holefree ? critical_avoidance_cache_holefree_to_model_
-                                 : critical_avoidance_cache_to_model_));
-                (slow ? avoidance_cache_to_model_slow_ : holefree ? avoidance_cache_hole_to_model_ : avoidance_cache_to_model_).insert(data.begin(), data.end());
-            }
+            (slow ? avoidance_cache_to_model_slow_ : holefree ? avoidance_cache_hole_to_model_ : avoidance_cache_to_model_).insert(data.begin(), data.end());
         });
 }
 
@@ -1216,10 +1166,7 @@ void TreeModelVolumes::calculateWallRestrictions(const std::deque<RadiusLayerPai
             std::unordered_map<RadiusLayerPair, Shape> data;
             std::unordered_map<RadiusLayerPair, Shape> data_min;
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_wall_restrictions_cache_);
-                min_layer_bottom = getMaxCalculatedLayer(radius, wall_restrictions_cache_);
-            }
+            min_layer_bottom = getMaxCalculatedLayer(radius, wall_restrictions_cache_);
 
             if (min_layer_bottom < 1)
             {
@@ -1239,15 +1186,9 @@ void TreeModelVolumes::calculateWallRestrictions(const std::deque<RadiusLayerPai
                 }
             }
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_wall_restrictions_cache_);
-                wall_restrictions_cache_.insert(data.begin(), data.end());
-            }
+            wall_restrictions_cache_.insert(data.begin(), data.end());
 
-            {
-                std::lock_guard<std::mutex> critical_section(*critical_wall_restrictions_cache_min_);
-                wall_restrictions_cache_min_.insert(data_min.begin(), data_min.end());
-            }
+            wall_restrictions_cache_min_.insert(data_min.begin(), data_min.end());
         });
 }
 
@@ -1281,20 +1222,6 @@ coord_t TreeModelVolumes::ceilRadius(coord_t radius) const
     return exponential_result;
 }
 
-template<typename KEY>
-const std::optional<std::reference_wrapper<const Shape>> TreeModelVolumes::getArea(const std::unordered_map<KEY, Shape>& cache, const KEY key) const
-{
-    const auto it = cache.find(key);
-    if (it != cache.end())
-    {
-        return std::optional<std::reference_wrapper<const Shape>>{ it->second };
-    }
-    else
-    {
-        return std::optional<std::reference_wrapper<const Shape>>();
-    }
-}
-
 Shape TreeModelVolumes::calculateMachineBorderCollision(const Shape&& machine_border)
 {
     Shape machine_volume_border = machine_border.offset(MM2INT(1000.0)); // Put a border of 1 meter around the print volume so that we don't collide.
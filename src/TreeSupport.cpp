@@ -3,6 +3,7 @@
 
 #include "TreeSupport.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <optional>
@@ -30,6 +31,7 @@
 #include "support.h" //For precomputeCrossInfillTree
 #include "utils/OBJ.h"
 #include "utils/Simplify.h"
+#include "utils/SparseAABBGrid.h"
 #include "utils/ThreadPool.h"
 #include "utils/algorithm.h"
 #include "utils/math.h" //For round_up_divide and PI.
@@ -205,6 +207,7 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
             dur_path,
             dur_place,
             dur_draw);
+        volumes_.logCacheStatistics();
 
 
         for (auto& layer : move_bounds)
@@ -283,12 +286,46 @@ void TreeSupport::mergeHelper(
     {
         return config.getRadius(distance_to_top, buildplate_radius_increases);
     };
+
+    // Broad phase: only the reduced elements in the grid cells around an influence area are checked against it. The grid holds pointers
+    // to the entries of reduced_aabb, which stay valid until they are erased, and is kept up to date as elements are merged or added.
+    using ReducedEntry = const std::pair<const TreeSupportElement, AABB>*;
+    coord_t total_aabb_size = 0;
+    size_t aabb_count = 0;
+    for (const auto* aabbs : { &reduced_aabb, &input_aabb })
+    {
+        for (const AABB& aabb : *aabbs | ranges::views::values)
+        {
+            if (aabb.min_.X <= aabb.max_.X && aabb.min_.Y <= aabb.max_.Y)
+            {
+                total_aabb_size += std::max(aabb.max_.X - aabb.min_.X, aabb.max_.Y - aabb.min_.Y);
+                aabb_count++;
+            }
+        }
+    }
+    const coord_t cell_size = std::max(coord_t(1), total_aabb_size / coord_t(std::max(size_t(1), aabb_count)));
+    SparseAABBGrid<ReducedEntry> reduced_grid(cell_size, reduced_aabb.size() + input_aabb.size());
+    for (const auto& reduced_entry : reduced_aabb)
+    {
+        reduced_grid.insert(&reduced_entry, reduced_entry.second);
+    }
+
     for (auto& influence : input_aabb)
     {
         bool merged = false;
         AABB influence_aabb = influence.second;
-        for (const auto& reduced_check : reduced_aabb)
+        std::vector<ReducedEntry> nearby_reduced = reduced_grid.getNearby(influence_aabb);
+        // Check them in the order of reduced_aabb, so that the same merges happen as when checking all of reduced_aabb.
+        std::sort(
+            nearby_reduced.begin(),
+            nearby_reduced.end(),
+            [](const ReducedEntry& a, const ReducedEntry& b)
+            {
+                return a->first < b->first;
+            });
+        for (const ReducedEntry reduced_entry : nearby_reduced)
         {
+            const auto& reduced_check = *reduced_entry;
             // As every area has to be checked for overlaps with other areas, some fast heuristic is needed to abort early if clearly possible
             // This is so performance critical that using a map lookup instead of the direct access of the cached AABBs can have a surprisingly large performance impact
             AABB aabb = reduced_check.second;
@@ -485,8 +522,12 @@ void TreeSupport::mergeHelper(
                     // negative area.).
                     //     And if this area disappears because of rounding errors, the only downside is that it can not merge again on this layer.
 
+                    reduced_grid.erase(reduced_entry, reduced_check.second);
                     reduced_aabb.erase(reduced_check.first); // This invalidates reduced_check.
-                    reduced_aabb.emplace(key, AABB(merge));
+                    if (const auto [merged_entry, inserted] = reduced_aabb.emplace(key, AABB(merge)); inserted)
+                    {
+                        reduced_grid.insert(&*merged_entry, merged_entry->second);
+                    }
 
                     merged = true;
                     break;
@@ -496,7 +537,13 @@ void TreeSupport::mergeHelper(
 
         if (! merged)
         {
-            reduced_aabb[influence.first] = influence_aabb;
+            const auto [reduced_entry, inserted] = reduced_aabb.try_emplace(influence.first, influence_aabb);
+            if (! inserted)
+            {
+                reduced_grid.erase(&*reduced_entry, reduced_entry->second);
+                reduced_entry->second = influence_aabb;
+            }
+            reduced_grid.insert(&*reduced_entry, influence_aabb);
         }
     }
 }
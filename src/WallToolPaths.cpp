@@ -4,6 +4,9 @@
 #include "WallToolPaths.h"
 
 #include <algorithm> //For std::partition_copy and std::min_element.
+#include <memory>
+#include <optional>
+#include <tuple>
 #include <unordered_set>
 
 #include <range/v3/range/conversion.hpp>
@@ -12,6 +15,7 @@
 #include <scripta/logger.h>
 
 #include "BeadingStrategy/BeadingStrategyFactory.h"
+#include "BeadingStrategy/MemoizedBeadingStrategy.h"
 #include "ExtruderTrain.h"
 #include "arachne/SkeletalTrapezoidation.h"
 #include "utils/ExtrusionLineStitcher.h"
@@ -210,20 +214,45 @@ void WallToolPaths::generateArachne()
     const Ratio wall_add_middle_threshold = std::max(1.0, std::min(99.0, 100.0 * min_odd_wall_line_width_ / wall_line_width_x_)) / 100.0;
 
     const size_t max_bead_count = (inset_count_ < std::numeric_limits<size_t>::max() / 2) ? 2 * inset_count_ : std::numeric_limits<size_t>::max();
-    const auto beading_strat = BeadingStrategyFactory::makeStrategy(
+    // The layers that a thread handles after each other mostly use the same strategy. Keep it for as long as they do, and
+    // memoize its results, so that the beadings of the previous layers can be used again.
+    const auto strategy_parameters = std::make_tuple(
         bead_width_0_,
         bead_width_x_,
         wall_transition_length_,
-        wall_transition_angle_,
+        static_cast<double>(wall_transition_angle_),
         print_thin_walls_,
         min_bead_width_,
         min_feature_size_,
-        wall_split_middle_threshold,
-        wall_add_middle_threshold,
+        static_cast<double>(wall_split_middle_threshold),
+        static_cast<double>(wall_add_middle_threshold),
         max_bead_count,
         wall_0_inset_,
         wall_x_inset_,
         wall_distribution_count_);
+    thread_local std::optional<std::remove_const_t<decltype(strategy_parameters)>> reused_strategy_parameters;
+    thread_local BeadingStrategyPtr reused_strategy;
+    if (reused_strategy_parameters != strategy_parameters)
+    {
+        reused_strategy = std::make_unique<MemoizedBeadingStrategy>(BeadingStrategyFactory::makeStrategy(
+            bead_width_0_,
+            bead_width_x_,
+            wall_transition_length_,
+            wall_transition_angle_,
+            print_thin_walls_,
+            min_bead_width_,
+            min_feature_size_,
+            wall_split_middle_threshold,
+            wall_add_middle_threshold,
+            max_bead_count,
+            wall_0_inset_,
+            wall_x_inset_,
+            wall_distribution_count_));
+        reused_strategy_parameters = strategy_parameters;
+    }
+    const BeadingStrategyPtr& beading_strat = reused_strategy;
+    // Every thread keeps the memory of its last skeletal graph, so that the graph of the next layer doesn't have to allocate it again.
+    thread_local SkeletalTrapezoidationGraph reused_graph;
     SkeletalTrapezoidation wall_maker(
         prepared_outline,
         *beading_strat,
@@ -233,8 +262,13 @@ void WallToolPaths::generateArachne()
         wall_transition_filter_deviation_,
         wall_transition_length_,
         layer_idx_,
-        section_type_);
+        section_type_,
+        std::move(reused_graph));
     wall_maker.generateToolpaths(toolpaths_);
+    reused_graph = std::move(wall_maker.graph_);
+    // The memory kept per thread is not part of any slice, so don't let a single large layer keep it for the rest of the process.
+    constexpr size_t max_retained_graph_bytes = 16 * 1024 * 1024;
+    reused_graph.clear(max_retained_graph_bytes);
     scripta::log(
         "toolpaths_0",
         toolpaths_,
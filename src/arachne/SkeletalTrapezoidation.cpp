@@ -30,20 +30,26 @@
 namespace cura
 {
 
+SkeletalTrapezoidation::edge_t* SkeletalTrapezoidation::getTransferredEdge(const vd_t::edge_type& vd_edge) const
+{
+    return vd_edge.color() == 0 ? nullptr : vd_edge_to_he_edge_[vd_edge.color() - 1];
+}
+
+SkeletalTrapezoidation::node_t* SkeletalTrapezoidation::getTransferredNode(const vd_t::vertex_type& vd_node) const
+{
+    return vd_node.color() == 0 ? nullptr : vd_node_to_he_node_[vd_node.color() - 1];
+}
+
 SkeletalTrapezoidation::node_t& SkeletalTrapezoidation::makeNode(vd_t::vertex_type& vd_node, Point2LL p)
 {
-    auto he_node_it = vd_node_to_he_node_.find(&vd_node);
-    if (he_node_it == vd_node_to_he_node_.end())
+    node_t* he_node = getTransferredNode(vd_node);
+    if (! he_node)
     {
-        graph_.nodes_.emplace_front(SkeletalTrapezoidationJoint(), p);
-        node_t& node = graph_.nodes_.front();
-        vd_node_to_he_node_.emplace(&vd_node, &node);
-        return node;
-    }
-    else
-    {
-        return *he_node_it->second;
+        he_node = &graph_.nodes_.emplace_front(SkeletalTrapezoidationJoint(), p);
+        vd_node_to_he_node_.push_back(he_node);
+        vd_node.color(vd_node_to_he_node_.size());
     }
+    return *he_node;
 }
 
 void SkeletalTrapezoidation::transferEdge(
@@ -56,14 +62,11 @@ void SkeletalTrapezoidation::transferEdge(
     const std::vector<Point2LL>& points,
     const std::vector<Segment>& segments)
 {
-    auto he_edge_it = vd_edge_to_he_edge_.find(vd_edge.twin());
-    if (he_edge_it != vd_edge_to_he_edge_.end())
+    edge_t* source_twin = getTransferredEdge(*vd_edge.twin());
+    if (source_twin)
     { // Twin segment(s) have already been made
-        edge_t* source_twin = he_edge_it->second;
-        assert(source_twin);
-        auto end_node_it = vd_node_to_he_node_.find(vd_edge.vertex1());
-        assert(end_node_it != vd_node_to_he_node_.end());
-        node_t* end_node = end_node_it->second;
+        node_t* end_node = getTransferredNode(*vd_edge.vertex1());
+        assert(end_node);
         for (edge_t* twin = source_twin;; twin = twin->prev_->twin_->prev_)
         {
             if (! twin)
@@ -72,8 +75,7 @@ void SkeletalTrapezoidation::transferEdge(
                 continue; // Prevent reading unallocated memory.
             }
             assert(twin);
-            graph_.edges_.emplace_front(SkeletalTrapezoidationEdge());
-            edge_t* edge = &graph_.edges_.front();
+            edge_t* edge = &graph_.edges_.emplace_front(SkeletalTrapezoidationEdge());
             edge->from_ = twin->to_;
             edge->to_ = twin->from_;
             edge->twin_ = twin;
@@ -129,16 +131,14 @@ void SkeletalTrapezoidation::transferEdge(
             node_t* v1;
             if (p1_idx < discretized.size() - 1)
             {
-                graph_.nodes_.emplace_front(SkeletalTrapezoidationJoint(), p1);
-                v1 = &graph_.nodes_.front();
+                v1 = &graph_.nodes_.emplace_front(SkeletalTrapezoidationJoint(), p1);
             }
             else
             {
                 v1 = &makeNode(*vd_edge.vertex1(), to);
             }
 
-            graph_.edges_.emplace_front(SkeletalTrapezoidationEdge());
-            edge_t* edge = &graph_.edges_.front();
+            edge_t* edge = &graph_.edges_.emplace_front(SkeletalTrapezoidationEdge());
             edge->from_ = v0;
             edge->to_ = v1;
             edge->from_->incident_edge_ = edge;
@@ -159,7 +159,11 @@ void SkeletalTrapezoidation::transferEdge(
             }
         }
         assert(prev_edge);
-        vd_edge_to_he_edge_.emplace(&vd_edge, prev_edge);
+        if (vd_edge.color() == 0)
+        {
+            vd_edge_to_he_edge_.push_back(prev_edge);
+            vd_edge.color(vd_edge_to_he_edge_.size());
+        }
     }
 }
 
@@ -382,7 +386,8 @@ SkeletalTrapezoidation::SkeletalTrapezoidation(
     coord_t allowed_filter_deviation,
     coord_t beading_propagation_transition_dist,
     int layer_idx,
-    SectionType section_type)
+    SectionType section_type,
+    graph_t graph)
     : transitioning_angle_(transitioning_angle)
     , discretization_step_size_(discretization_step_size)
     , transition_filter_dist_(transition_filter_dist)
@@ -391,7 +396,9 @@ SkeletalTrapezoidation::SkeletalTrapezoidation(
     , layer_idx_(layer_idx)
     , section_type_(section_type)
     , beading_strategy_(beading_strategy)
+    , graph_(std::move(graph))
 {
+    graph_.clear();
     scripta::log("skeletal_trapezoidation_0", polys, section_type, layer_idx);
     constructFromPolygons(polys.getShape());
 }
@@ -458,7 +465,7 @@ void SkeletalTrapezoidation::constructFromPolygons(const Shape& polys)
             end_source_point,
             points,
             segments);
-        node_t* starting_node = vd_node_to_he_node_[starting_vonoroi_edge->vertex0()];
+        node_t* starting_node = getTransferredNode(*starting_vonoroi_edge->vertex0());
         starting_node->data_.distance_to_boundary_ = 0;
 
         graph_.makeRib(prev_edge, start_source_point, end_source_point);
@@ -507,8 +514,7 @@ void SkeletalTrapezoidation::separatePointyQuadEndNodes()
         }
         else
         { // Needs to be duplicated
-            graph_.nodes_.emplace_back(*quad_start->from_);
-            node_t* new_node = &graph_.nodes_.back();
+            node_t* new_node = &graph_.nodes_.emplace_back(*quad_start->from_);
             new_node->incident_edge_ = quad_start;
             quad_start->from_ = new_node;
             quad_start->twin_->to_ = new_node;
@@ -896,8 +902,7 @@ void SkeletalTrapezoidation::generateTransitioningRibs()
 {
     // Store the upward edges to the transitions.
     // We only store the halfedge for which the distance_to_boundary is higher at the end than at the beginning.
-    ptr_vector_t<std::list<TransitionMiddle>> edge_transitions;
-    generateTransitionMids(edge_transitions);
+    generateTransitionMids(edge_transitions_);
 
     for (edge_t& edge : graph_.edges_)
     { // Check if there is a transition in between nodes with different bead counts
@@ -909,15 +914,13 @@ void SkeletalTrapezoidation::generateTransitioningRibs()
 
     filterTransitionMids();
 
-    ptr_vector_t<std::list<TransitionEnd>> edge_transition_ends; // We only map the half edge in the upward direction. mapped items are not sorted
-    generateAllTransitionEnds(edge_transition_ends);
+    generateAllTransitionEnds(edge_transition_ends_);
 
-    applyTransitions(edge_transition_ends);
-    // Note that the shared pointer lists will be out of scope and thus destroyed here, since the remaining refs are weak_ptr.
+    applyTransitions(edge_transition_ends_);
 }
 
 
-void SkeletalTrapezoidation::generateTransitionMids(ptr_vector_t<std::list<TransitionMiddle>>& edge_transitions)
+void SkeletalTrapezoidation::generateTransitionMids(storage_t<std::list<TransitionMiddle>>& edge_transitions)
 {
     for (edge_t& edge : graph_.edges_)
     {
@@ -985,8 +988,7 @@ void SkeletalTrapezoidation::generateTransitionMids(ptr_vector_t<std::list<Trans
             assert((! edge.data_.hasTransitions(ignore_empty)) || mid_pos >= transitions->back().pos_);
             if (! edge.data_.hasTransitions(ignore_empty))
             {
-                edge_transitions.emplace_back(std::make_shared<std::list<TransitionMiddle>>());
-                edge.data_.setTransitions(edge_transitions.back()); // initialization
+                edge.data_.setTransitions(edge_transitions.emplace_back()); // initialization
                 transitions = edge.data_.getTransitions();
             }
             transitions->emplace_back(mid_pos, transition_lower_bead_count, mid_R);
@@ -1192,7 +1194,7 @@ bool SkeletalTrapezoidation::filterEndOfCentralTransition(edge_t* edge_to_start,
     return should_dissolve;
 }
 
-void SkeletalTrapezoidation::generateAllTransitionEnds(ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends)
+void SkeletalTrapezoidation::generateAllTransitionEnds(storage_t<std::list<TransitionEnd>>& edge_transition_ends)
 {
     for (edge_t& edge : graph_.edges_)
     {
@@ -1212,7 +1214,7 @@ void SkeletalTrapezoidation::generateAllTransitionEnds(ptr_vector_t<std::list<Tr
     }
 }
 
-void SkeletalTrapezoidation::generateTransitionEnds(edge_t& edge, coord_t mid_pos, coord_t lower_bead_count, ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends)
+void SkeletalTrapezoidation::generateTransitionEnds(edge_t& edge, coord_t mid_pos, coord_t lower_bead_count, storage_t<std::list<TransitionEnd>>& edge_transition_ends)
 {
     const Point2LL a = edge.from_->p_;
     const Point2LL b = edge.to_->p_;
@@ -1257,7 +1259,7 @@ bool SkeletalTrapezoidation::generateTransitionEnd(
     Ratio start_rest,
     Ratio end_rest,
     coord_t lower_bead_count,
-    ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends)
+    storage_t<std::list<TransitionEnd>>& edge_transition_ends)
 {
     Point2LL a = edge.from_->p_;
     Point2LL b = edge.to_->p_;
@@ -1343,8 +1345,7 @@ bool SkeletalTrapezoidation::generateTransitionEnd(
         if (! upward_edge->data_.hasTransitionEnds())
         {
             // This edge doesn't have a data structure yet for the transition ends. Make one.
-            edge_transition_ends.emplace_back(std::make_shared<std::list<TransitionEnd>>());
-            upward_edge->data_.setTransitionEnds(edge_transition_ends.back());
+            upward_edge->data_.setTransitionEnds(edge_transition_ends.emplace_back());
         }
         auto transitions = upward_edge->data_.getTransitionEnds();
 
@@ -1417,7 +1418,7 @@ bool SkeletalTrapezoidation::isGoingDown(edge_t* outgoing, coord_t traveled_dist
     return has_recursed && is_only_going_down;
 }
 
-void SkeletalTrapezoidation::applyTransitions(ptr_vector_t<std::list<TransitionEnd>>& edge_transition_ends)
+void SkeletalTrapezoidation::applyTransitions(storage_t<std::list<TransitionEnd>>& edge_transition_ends)
 {
     for (edge_t& edge : graph_.edges_)
     {
@@ -1427,8 +1428,7 @@ void SkeletalTrapezoidation::applyTransitions(ptr_vector_t<std::list<TransitionE
             auto& twin_transition_ends = *edge.twin_->data_.getTransitionEnds();
             if (! edge.data_.hasTransitionEnds())
             {
-                edge_transition_ends.emplace_back(std::make_shared<std::list<TransitionEnd>>());
-                edge.data_.setTransitionEnds(edge_transition_ends.back());
+                edge.data_.setTransitionEnds(edge_transition_ends.emplace_back());
             }
             auto& transition_ends = *edge.data_.getTransitionEnds();
             for (TransitionEnd& end : twin_transition_ends)
@@ -1618,7 +1618,6 @@ void SkeletalTrapezoidation::generateSegments()
             return a->to_->data_.distance_to_boundary_ > b->to_->data_.distance_to_boundary_;
         });
 
-    ptr_vector_t<BeadingPropagation> node_beadings;
     { // Store beading
         for (node_t& node : graph_.nodes_)
         {
@@ -1628,10 +1627,9 @@ void SkeletalTrapezoidation::generateSegments()
             }
             if (node.data_.transition_ratio_ == 0)
             {
-                node_beadings.emplace_back(new BeadingPropagation(beading_strategy_.compute(node.data_.distance_to_boundary_ * 2, node.data_.bead_count_)));
-                node.data_.setBeading(node_beadings.back());
-                assert(node_beadings.back()->beading_.total_thickness == node.data_.distance_to_boundary_ * 2);
-                if (node_beadings.back()->beading_.total_thickness != node.data_.distance_to_boundary_ * 2)
+                node.data_.setBeading(node_beadings_.emplace_back(beading_strategy_.compute(node.data_.distance_to_boundary_ * 2, node.data_.bead_count_)));
+                assert(node_beadings_.back().beading_.total_thickness == node.data_.distance_to_boundary_ * 2);
+                if (node_beadings_.back().beading_.total_thickness != node.data_.distance_to_boundary_ * 2)
                 {
                     spdlog::warn("If transitioning to an endpoint (ratio 0), the node should be exactly in the middle.");
                 }
@@ -1641,8 +1639,7 @@ void SkeletalTrapezoidation::generateSegments()
                 Beading low_count_beading = beading_strategy_.compute(node.data_.distance_to_boundary_ * 2, node.data_.bead_count_);
                 Beading high_count_beading = beading_strategy_.compute(node.data_.distance_to_boundary_ * 2, node.data_.bead_count_ + 1);
                 Beading merged = interpolate(low_count_beading, 1.0 - node.data_.transition_ratio_, high_count_beading);
-                node_beadings.emplace_back(new BeadingPropagation(merged));
-                node.data_.setBeading(node_beadings.back());
+                node.data_.setBeading(node_beadings_.emplace_back(merged));
                 assert(merged.total_thickness == node.data_.distance_to_boundary_ * 2);
                 if (merged.total_thickness != node.data_.distance_to_boundary_ * 2)
                 {
@@ -1652,14 +1649,13 @@ void SkeletalTrapezoidation::generateSegments()
         }
     }
 
-    propagateBeadingsUpward(upward_quad_mids, node_beadings);
+    propagateBeadingsUpward(upward_quad_mids, node_beadings_);
 
-    propagateBeadingsDownward(upward_quad_mids, node_beadings);
+    propagateBeadingsDownward(upward_quad_mids, node_beadings_);
 
-    ptr_vector_t<LineJunctions> edge_junctions; // junctions ordered high R to low R
-    generateJunctions(node_beadings, edge_junctions);
+    generateJunctions(node_beadings_, edge_junctions_);
 
-    connectJunctions(edge_junctions);
+    connectJunctions(edge_junctions_);
 
     generateLocalMaximaSingleBeads();
 }
@@ -1688,7 +1684,7 @@ SkeletalTrapezoidation::edge_t* SkeletalTrapezoidation::getQuadMaxRedgeTo(edge_t
     return ret;
 }
 
-void SkeletalTrapezoidation::propagateBeadingsUpward(std::vector<edge_t*>& upward_quad_mids, ptr_vector_t<BeadingPropagation>& node_beadings)
+void SkeletalTrapezoidation::propagateBeadingsUpward(std::vector<edge_t*>& upward_quad_mids, storage_t<BeadingPropagation>& node_beadings)
 {
     for (auto upward_quad_mids_it = upward_quad_mids.rbegin(); upward_quad_mids_it != upward_quad_mids.rend(); ++upward_quad_mids_it)
     {
@@ -1714,13 +1710,12 @@ void SkeletalTrapezoidation::propagateBeadingsUpward(std::vector<edge_t*>& upwar
         BeadingPropagation upper_beading = lower_beading;
         upper_beading.dist_to_bottom_source_ += length;
         upper_beading.is_upward_propagated_only_ = true;
-        node_beadings.emplace_back(new BeadingPropagation(upper_beading));
-        upward_edge->to_->data_.setBeading(node_beadings.back());
+        upward_edge->to_->data_.setBeading(node_beadings.emplace_back(upper_beading));
         assert(upper_beading.beading_.total_thickness <= upward_edge->to_->data_.distance_to_boundary_ * 2);
     }
 }
 
-void SkeletalTrapezoidation::propagateBeadingsDownward(std::vector<edge_t*>& upward_quad_mids, ptr_vector_t<BeadingPropagation>& node_beadings)
+void SkeletalTrapezoidation::propagateBeadingsDownward(std::vector<edge_t*>& upward_quad_mids, storage_t<BeadingPropagation>& node_beadings)
 {
     for (edge_t* upward_quad_mid : upward_quad_mids)
     {
@@ -1741,7 +1736,7 @@ void SkeletalTrapezoidation::propagateBeadingsDownward(std::vector<edge_t*>& upw
     }
 }
 
-void SkeletalTrapezoidation::propagateBeadingsDownward(edge_t* edge_to_peak, ptr_vector_t<BeadingPropagation>& node_beadings)
+void SkeletalTrapezoidation::propagateBeadingsDownward(edge_t* edge_to_peak, storage_t<BeadingPropagation>& node_beadings)
 {
     coord_t length = vSize(edge_to_peak->to_->p_ - edge_to_peak->from_->p_);
     BeadingPropagation& top_beading = *getOrCreateBeading(edge_to_peak->to_, node_beadings);
@@ -1756,8 +1751,7 @@ void SkeletalTrapezoidation::propagateBeadingsDownward(edge_t* edge_to_peak, ptr
     { // Set new beading if there is no beading associated with the node yet
         BeadingPropagation propagated_beading = top_beading;
         propagated_beading.dist_from_top_source_ += length;
-        node_beadings.emplace_back(new BeadingPropagation(propagated_beading));
-        edge_to_peak->from_->data_.setBeading(node_beadings.back());
+        edge_to_peak->from_->data_.setBeading(node_beadings.emplace_back(propagated_beading));
         assert(propagated_beading.beading_.total_thickness >= edge_to_peak->from_->data_.distance_to_boundary_ * 2);
         if (propagated_beading.beading_.total_thickness < edge_to_peak->from_->data_.distance_to_boundary_ * 2)
         {
@@ -1855,7 +1849,7 @@ SkeletalTrapezoidation::Beading SkeletalTrapezoidation::interpolate(const Beadin
     return ret;
 }
 
-void SkeletalTrapezoidation::generateJunctions(ptr_vector_t<BeadingPropagation>& node_beadings, ptr_vector_t<LineJunctions>& edge_junctions)
+void SkeletalTrapezoidation::generateJunctions(storage_t<BeadingPropagation>& node_beadings, storage_t<LineJunctions>& edge_junctions)
 {
     for (edge_t& edge_ : graph_.edges_)
     {
@@ -1874,9 +1868,8 @@ void SkeletalTrapezoidation::generateJunctions(ptr_vector_t<BeadingPropagation>&
         }
 
         Beading* beading = &getOrCreateBeading(edge->to_, node_beadings)->beading_;
-        edge_junctions.emplace_back(std::make_shared<LineJunctions>());
-        edge_.data_.setExtrusionJunctions(edge_junctions.back()); // initialization
-        LineJunctions& ret = *edge_junctions.back();
+        LineJunctions& ret = edge_junctions.emplace_back();
+        edge_.data_.setExtrusionJunctions(ret); // initialization
 
         assert(beading->total_thickness >= edge->to_->data_.distance_to_boundary_ * 2);
         if (beading->total_thickness < edge->to_->data_.distance_to_boundary_ * 2)
@@ -1926,7 +1919,7 @@ void SkeletalTrapezoidation::generateJunctions(ptr_vector_t<BeadingPropagation>&
     }
 }
 
-std::shared_ptr<SkeletalTrapezoidationJoint::BeadingPropagation> SkeletalTrapezoidation::getOrCreateBeading(node_t* node, ptr_vector_t<BeadingPropagation>& node_beadings)
+SkeletalTrapezoidationJoint::BeadingPropagation* SkeletalTrapezoidation::getOrCreateBeading(node_t* node, storage_t<BeadingPropagation>& node_beadings)
 {
     if (! node->data_.hasBeading())
     {
@@ -1961,14 +1954,13 @@ std::shared_ptr<SkeletalTrapezoidationJoint::BeadingPropagation> SkeletalTrapezo
             node->data_.bead_count_ = beading_strategy_.getOptimalBeadCount(dist * 2);
         }
         assert(node->data_.bead_count_ != -1);
-        node_beadings.emplace_back(new BeadingPropagation(beading_strategy_.compute(node->data_.distance_to_boundary_ * 2, node->data_.bead_count_)));
-        node->data_.setBeading(node_beadings.back());
+        node->data_.setBeading(node_beadings.emplace_back(beading_strategy_.compute(node->data_.distance_to_boundary_ * 2, node->data_.bead_count_)));
     }
     assert(node->data_.hasBeading());
     return node->data_.getBeading();
 }
 
-std::shared_ptr<SkeletalTrapezoidationJoint::BeadingPropagation> SkeletalTrapezoidation::getNearestBeading(node_t* node, coord_t max_dist)
+SkeletalTrapezoidationJoint::BeadingPropagation* SkeletalTrapezoidation::getNearestBeading(node_t* node, coord_t max_dist)
 {
     struct DistEdge
     {
@@ -2061,7 +2053,7 @@ void SkeletalTrapezoidation::addToolpathSegment(const ExtrusionJunction& from, c
     }
 };
 
-void SkeletalTrapezoidation::connectJunctions(ptr_vector_t<LineJunctions>& edge_junctions)
+void SkeletalTrapezoidation::connectJunctions(storage_t<LineJunctions>& edge_junctions)
 {
     std::unordered_set<edge_t*> unprocessed_quad_starts(graph_.edges_.size() * 5 / 2);
     for (edge_t& edge : graph_.edges_)
@@ -2096,15 +2088,13 @@ void SkeletalTrapezoidation::connectJunctions(ptr_vector_t<LineJunctions>& edge_
 
             if (! edge_to_peak->data_.hasExtrusionJunctions())
             {
-                edge_junctions.emplace_back(std::make_shared<LineJunctions>());
-                edge_to_peak->data_.setExtrusionJunctions(edge_junctions.back());
+                edge_to_peak->data_.setExtrusionJunctions(edge_junctions.emplace_back());
             }
             // The junctions on the edge(s) from the start of the quad to the node with highest R
             LineJunctions from_junctions = *edge_to_peak->data_.getExtrusionJunctions();
             if (! edge_from_peak->twin_->data_.hasExtrusionJunctions())
             {
-                edge_junctions.emplace_back(std::make_shared<LineJunctions>());
-                edge_from_peak->twin_->data_.setExtrusionJunctions(edge_junctions.back());
+                edge_from_peak->twin_->data_.setExtrusionJunctions(edge_junctions.emplace_back());
             }
             // The junctions on the edge(s) from the end of the quad to the node with highest R
             LineJunctions to_junctions = *edge_from_peak->twin_->data_.getExtrusionJunctions();
@@ -3,8 +3,6 @@
 
 #include "arachne/SkeletalTrapezoidationGraph.h"
 
-#include <unordered_map>
-
 #include <spdlog/spdlog.h>
 
 #include "arachne/STHalfEdge.h"
@@ -15,22 +13,28 @@
 namespace cura
 {
 
-void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
+void SkeletalTrapezoidationGraph::clear()
 {
-    std::unordered_map<edge_t*, std::list<edge_t>::iterator> edge_locator;
-    std::unordered_map<node_t*, std::list<node_t>::iterator> node_locator;
-
-    for (auto edge_it = edges_.begin(); edge_it != edges_.end(); ++edge_it)
-    {
-        edge_locator.emplace(&*edge_it, edge_it);
-    }
+    edges_.clear();
+    nodes_.clear();
+}
 
-    for (auto node_it = nodes_.begin(); node_it != nodes_.end(); ++node_it)
+void SkeletalTrapezoidationGraph::clear(const size_t max_retained_bytes)
+{
+    const size_t retained_bytes = edges_.capacity() * sizeof(edge_t) + nodes_.capacity() * sizeof(node_t);
+    if (retained_bytes <= max_retained_bytes)
     {
-        node_locator.emplace(&*node_it, node_it);
+        clear();
+        return;
     }
+    const double keep_factor = static_cast<double>(max_retained_bytes) / static_cast<double>(retained_bytes);
+    edges_.clear(static_cast<size_t>(static_cast<double>(edges_.capacity()) * keep_factor));
+    nodes_.clear(static_cast<size_t>(static_cast<double>(nodes_.capacity()) * keep_factor));
+}
 
-    auto safelyRemoveEdge = [this, &edge_locator](edge_t* to_be_removed, std::list<edge_t>::iterator& current_edge_it, bool& edge_it_is_updated)
+void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
+{
+    auto safelyRemoveEdge = [this](edge_t* to_be_removed, ChunkedList<edge_t>::iterator& current_edge_it, bool& edge_it_is_updated)
     {
         if (current_edge_it != edges_.end() && to_be_removed == &*current_edge_it)
         {
@@ -39,7 +43,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
         }
         else
         {
-            edges_.erase(edge_locator[to_be_removed]);
+            edges_.erase(edges_.iterator_to(*to_be_removed));
         }
     };
 
@@ -99,7 +103,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
                 }
             }
 
-            nodes_.erase(node_locator[quad_mid->to_]);
+            nodes_.erase(nodes_.iterator_to(*quad_mid->to_));
 
             quad_mid->prev_->next_ = quad_mid->next_;
             quad_mid->next_->prev_ = quad_mid->prev_;
@@ -129,7 +133,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
                     quad_end->from_->incident_edge_ = quad_end->prev_->twin_;
                 }
             }
-            nodes_.erase(node_locator[quad_start->from_]);
+            nodes_.erase(nodes_.iterator_to(*quad_start->from_));
 
             quad_start->twin_->twin_ = quad_end->twin_;
             quad_end->twin_->twin_ = quad_start->twin_;
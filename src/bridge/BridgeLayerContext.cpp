@@ -0,0 +1,70 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "bridge/BridgeLayerContext.h"
+
+#include <cassert>
+
+#include "sliceDataStorage.h"
+
+namespace cura
+{
+
+BridgeLayerContext::BridgeLayerContext(const SliceDataStorage& storage, const LayerIndex layer_nr)
+    : storage_(storage)
+    , layer_nr_(layer_nr)
+{
+}
+
+const BridgeLayerContext::LayerBelow& BridgeLayerContext::getLayerBelow(const unsigned bridge_layer)
+{
+    assert(bridge_layer >= 1 && bridge_layer <= layers_below_.size());
+    std::optional<LayerBelow>& layer_below = layers_below_[bridge_layer - 1];
+    if (! layer_below.has_value())
+    {
+        layer_below = computeLayerBelow(bridge_layer);
+    }
+    return *layer_below;
+}
+
+BridgeLayerContext::LayerBelow BridgeLayerContext::computeLayerBelow(const unsigned bridge_layer) const
+{
+    LayerBelow result;
+    const LayerIndex layer_below_nr = layer_nr_ - bridge_layer;
+    if (layer_below_nr < 0)
+    {
+        return result;
+    }
+
+    // include parts from all meshes
+    for (const std::shared_ptr<SliceMeshStorage>& mesh_ptr : storage_.meshes)
+    {
+        const auto& mesh = *mesh_ptr;
+        if (! mesh.isPrinted())
+        {
+            continue;
+        }
+        const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
+        const bool part_has_sparse_infill = infill_line_distance == 0;
+
+        for (const SliceLayerPart& part : mesh.layers[layer_below_nr.value].parts)
+        {
+            const Shape& part_infill = part.getOwnInfillArea();
+            result.infill.push_back(part_infill);
+
+            Shape solid_below(part.outline);
+            if (bridge_layer == 1 && part_has_sparse_infill)
+            {
+                solid_below = solid_below.difference(part_infill);
+            }
+            result.solid_parts.push_back(SolidPart{ std::move(solid_below), part.boundaryBox });
+        }
+    }
+
+    // A single union of all parts is much cheaper than adding them one by one.
+    result.infill = result.infill.unionPolygons();
+    result.infill_bounding_box = AABB(result.infill);
+    return result;
+}
+
+} // namespace cura
@@ -8,11 +8,13 @@
 
 #include "LayerPlan.h"
 #include "PathAdapter.h"
+#include "bridge/BridgeLayerContext.h"
 #include "bridge/ExpansionRange.h"
 #include "bridge/SegmentOverlapping.h"
 #include "bridge/TransformedShape.h"
 #include "geometry/PointMatrix.h"
 #include "geometry/Polygon.h"
+#include "geometry/SegmentIndexedShape.h"
 #include "settings/EnumSettings.h"
 #include "settings/types/Ratio.h"
 #include "sliceDataStorage.h"
@@ -303,7 +305,7 @@ AngleDegrees bridgeOverInfillAngle(const SliceMeshStorage& mesh, const unsigned
 std::optional<AngleDegrees> bridgeAngle(
     const SliceMeshStorage& mesh,
     const Shape& skin_outline,
-    const SliceDataStorage& storage,
+    BridgeLayerContext& layer_context,
     const unsigned layer_nr,
     const unsigned bridge_layer,
     const SupportLayer* support_layer,
@@ -320,40 +322,18 @@ std::optional<AngleDegrees> bridgeAngle(
 
     const coord_t line_width = settings.get<coord_t>("skin_line_width");
 
+    // The outlines and infill of the layer below are shared by all skin parts of this layer, of all meshes.
+    const BridgeLayerContext::LayerBelow& layer_below = layer_context.getLayerBelow(bridge_layer);
+
     // To detect if we have a bridge, first calculate the intersection of the current layer with the previous layer.
     //  This gives us the islands that the layer rests on.
     Shape islands;
-
-    Shape prev_layer_outline; // we also want the complete outline of the previous layer
-    Shape prev_layer_infill;
-
-    // include parts from all meshes
-    for (const std::shared_ptr<SliceMeshStorage>& mesh_ptr : storage.meshes)
+    for (const BridgeLayerContext::SolidPart& solid_part : layer_below.solid_parts)
     {
-        const auto& mesh = *mesh_ptr;
-        if (mesh.isPrinted())
-        {
-            const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
-            const bool part_has_sparse_infill = infill_line_distance == 0;
-
-            for (const SliceLayerPart& prev_layer_part : mesh.layers[layer_nr - bridge_layer].parts)
-            {
-                Shape prev_layer_part_infill = prev_layer_part.getOwnInfillArea();
-                prev_layer_infill = prev_layer_infill.unionPolygons(prev_layer_part_infill);
-
-                Shape solid_below(prev_layer_part.outline);
-                if (bridge_layer == 1 && part_has_sparse_infill)
-                {
-                    solid_below = solid_below.difference(prev_layer_part_infill);
-                }
-                prev_layer_outline.push_back(solid_below); // not intersected with skin
-
-                if (! boundary_box.hit(prev_layer_part.boundaryBox))
-                    continue;
+        if (! boundary_box.hit(solid_part.bounding_box))
+            continue;
 
-                islands.push_back(skin_outline.intersection(solid_below));
-            }
-        }
+        islands.push_back(skin_outline.intersection(solid_part.outline));
     }
     supported_regions = islands;
 
@@ -370,8 +350,6 @@ std::optional<AngleDegrees> bridgeAngle(
             AABB support_roof_bb(support_layer->support_roof);
             if (boundary_box.hit(support_roof_bb))
             {
-                prev_layer_outline.push_back(support_layer->support_roof); // not intersected with skin
-
                 Shape supported_skin(skin_outline.intersection(support_layer->support_roof));
                 if (! supported_skin.empty())
                 {
@@ -386,8 +364,6 @@ std::optional<AngleDegrees> bridgeAngle(
                 AABB support_part_bb(support_part.outline_);
                 if (boundary_box.hit(support_part_bb))
                 {
-                    prev_layer_outline.push_back(support_part.outline_); // not intersected with skin
-
                     Shape supported_skin(skin_outline.intersection(support_part.outline_));
                     if (! supported_skin.empty())
                     {
@@ -406,8 +382,8 @@ std::optional<AngleDegrees> bridgeAngle(
         return std::nullopt;
     }
 
-    prev_layer_infill = skin_outline.intersection(prev_layer_infill);
-    const Ratio infill_ratio = prev_layer_infill.area() / (skin_outline.area() + 1);
+    const Shape skin_over_infill = boundary_box.hit(layer_below.infill_bounding_box) ? skin_outline.intersection(layer_below.infill) : Shape();
+    const Ratio infill_ratio = skin_over_infill.area() / (skin_outline.area() + 1);
     if (infill_ratio > 0.5) // In practice, the ratio should always be close to 0 or 1, so 0.5 should be good enough
     {
         // We are doing bridging over infill, so use the infill angle instead of trying to calculate a proper angle
@@ -758,7 +734,7 @@ std::tuple<Shape, AngleDegrees> makeBridgeOverInfillPrintable(
  * @return True if the tip is properly anchored, false if it is fully hanging
  */
 bool isWallTipAnchored(
-    const Shape& bridge_mask,
+    const SegmentIndexedShape& bridge_mask,
     const PathAdapter<ExtrusionLine>& wall,
     const size_t tip_index,
     const Point2LL& tip,
@@ -836,7 +812,7 @@ bool isWallTipAnchored(
 
 std::vector<std::tuple<Ratio, Ratio>> wallSegmentUsesBridging(
     const AABB& bridge_mask_bb,
-    const Shape& bridge_mask,
+    const SegmentIndexedShape& bridge_mask,
     const PathAdapter<ExtrusionLine>& wall,
     const size_t segment_index,
     const Ratio& segment_start_ratio,
@@ -17,6 +17,7 @@
 #include <sentry.h>
 #endif
 
+#include <algorithm> //To sort the remaining layers.
 #include <thread> //To sleep while waiting for the connection.
 #include <unordered_map> //To map settings to their extruder numbers for limit_to_extruder.
 
@@ -57,6 +58,8 @@ class ArcusCommunication::PathCompiler
     ArcusCommunication::Private& _cs_private_data;
     //! Keeps track of the current layer number being processed. If layer number is set to a different value, the current data is flushed to CommandSocket.
     LayerIndex _layer_nr;
+    //! Whether the current layer has been completed. It is then sent to the front-end as soon as the next layer starts.
+    bool _layer_complete;
     size_t extruder;
     PointType data_point_type;
 
@@ -79,6 +82,7 @@ public:
     PathCompiler(ArcusCommunication::Private& cs_private_data)
         : _cs_private_data(cs_private_data)
         , _layer_nr(0)
+        , _layer_complete(false)
         , extruder(0)
         , data_point_type(cura::proto::PathSegment::Point3D)
         , line_types()
@@ -110,10 +114,42 @@ public:
         if (_layer_nr != new_layer_nr)
         {
             flushPathSegments();
+            if (_layer_complete)
+            {
+                // Moves that are made after completing a layer (e.g. to the next mesh group) still belong to it, so only send it now.
+                _cs_private_data.sendOptimizedLayer(_layer_nr);
+                _layer_complete = false;
+            }
             _layer_nr = new_layer_nr;
         }
     }
 
+    /*!
+     * \brief Mark a layer as complete, so that it gets sent to the front-end
+     * as soon as data for another layer comes in.
+     *
+     * Only the current layer can be completed. Other layers are also completed
+     * while their layer plan is made (e.g. raft layers), but those still
+     * have to get their data.
+     * \param layer_nr The layer that is complete.
+     */
+    void setLayerComplete(const LayerIndex& layer_nr)
+    {
+        if (layer_nr == _layer_nr)
+        {
+            _layer_complete = true;
+        }
+    }
+
+    /*!
+     * \brief Forget that the current layer is complete, because all buffered
+     * layers have been sent already.
+     */
+    void resetLayerComplete()
+    {
+        _layer_complete = false;
+    }
+
     /*!
      * \brief Returns the current layer which data is written to.
      */
@@ -324,6 +360,16 @@ void ArcusCommunication::sendGCodePart(const std::string& gcode_part)
     private_data->socket->sendMessage(message);
 }
 
+bool ArcusCommunication::overwriteGCodePart(const size_t, const std::string&)
+{
+    return false;
+}
+
+bool ArcusCommunication::supportsGCodeStreaming() const
+{
+    return false;
+}
+
 bool ArcusCommunication::hasSlice() const
 {
     return private_data->socket->getState() != Arcus::SocketState::Closed && private_data->socket->getState() != Arcus::SocketState::Error
@@ -354,6 +400,7 @@ void ArcusCommunication::sendLayerComplete(const LayerIndex::value_type& layer_n
     std::shared_ptr<proto::LayerOptimized> layer = private_data->getOptimizedLayerById(layer_nr);
     layer->set_height(z);
     layer->set_thickness(thickness);
+    path_compiler->setLayerComplete(layer_nr);
 }
 
 void ArcusCommunication::sendLineTo(const PrintFeatureType& type, const Point3LL& to, const coord_t& line_width, const coord_t& line_thickness, const Velocity& velocity)
@@ -364,25 +411,34 @@ void ArcusCommunication::sendLineTo(const PrintFeatureType& type, const Point3LL
 void ArcusCommunication::sendOptimizedLayerData()
 {
     path_compiler->flushPathSegments(); // Make sure the last path segment has been flushed from the compiler.
+    path_compiler->resetLayerComplete(); // The last layer is sent below, with all other layers that weren't sent yet.
 
     SliceDataStruct<proto::LayerOptimized>& data = private_data->optimized_layers;
     data.sliced_objects++;
     data.current_layer_offset = data.current_layer_count;
-    if (data.sliced_objects < private_data->object_count) // Nothing to send.
+
+    // Most layers have been sent as soon as they were complete. Send the rest in the order of their layer numbers.
+    // Only keep each layer until it is sent, so that it's freed once Arcus has written it.
+    std::vector<std::shared_ptr<proto::LayerOptimized>> remaining_layers;
+    remaining_layers.reserve(data.slice_data.size());
+    for (auto& entry : data.slice_data)
     {
-        return;
+        remaining_layers.push_back(std::move(entry.second));
+    }
+    data.slice_data.clear();
+    std::ranges::sort(remaining_layers, {}, &proto::LayerOptimized::id);
+    spdlog::info("Sending {} remaining layers.", remaining_layers.size());
+    for (std::shared_ptr<proto::LayerOptimized>& layer : remaining_layers)
+    {
+        private_data->sendLayer(std::move(layer));
     }
-    spdlog::info("Sending {} layers.", data.current_layer_count);
 
-    for (const auto& entry : data.slice_data) // Note: This is in no particular order!
+    if (data.sliced_objects >= private_data->object_count)
     {
-        spdlog::debug("Sending layer data for layer {} of {}.", entry.first, data.slice_data.size());
-        private_data->socket->sendMessage(entry.second); // Send the actual layers.
+        data.sliced_objects = 0;
+        data.current_layer_count = 0;
+        data.current_layer_offset = 0;
     }
-    data.sliced_objects = 0;
-    data.current_layer_count = 0;
-    data.current_layer_offset = 0;
-    data.slice_data.clear();
 }
 
 void ArcusCommunication::sendPrintInformation(const std::vector<cura::Duration>& time_estimates, const PrintInformation& print_information) const
@@ -530,6 +586,7 @@ void ArcusCommunication::sliceNext()
         ExtruderTrain& extruder = slice->scene.extruders[setting_extruder.extruder()];
         slice->scene.limit_to_extruder.emplace(setting_extruder.name(), &extruder);
     }
+    Settings::invalidateResolvedValues(); // Limiting settings to extruders changes their resolved values.
 
     // Load all mesh groups, meshes and their settings.
     private_data->object_count = 0;
@@ -5,12 +5,18 @@
 
 #include "communication/ArcusCommunicationPrivate.h"
 
+#include <algorithm> //To forget the layers that were written.
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <thread> //To wait for the front-end to read layers.
 #include <png.h>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/memorystream.h>
 
+#include <Arcus/Socket.h>
+
 #include <spdlog/spdlog.h>
 
 #include "Application.h"
@@ -20,6 +26,7 @@
 #include "utils/Matrix4x3D.h" //To convert vertices to integer-points.
 #include "utils/MeshUtils.h"
 #include "utils/Point3F.h" //To accept vertices (which are provided in floating point).
+#include "utils/ThreadPool.h" //To convert the vertices in parallel.
 
 namespace cura
 {
@@ -30,6 +37,7 @@ ArcusCommunication::Private::Private()
     , last_sent_progress(-1)
     , slice_count(0)
     , millisecUntilNextTry(100)
+    , max_layers_in_flight(16)
 {
 }
 
@@ -52,6 +60,42 @@ std::shared_ptr<proto::LayerOptimized> ArcusCommunication::Private::getOptimized
     }
 }
 
+void ArcusCommunication::Private::sendOptimizedLayer(LayerIndex::value_type layer_nr)
+{
+    layer_nr += optimized_layers.current_layer_offset;
+    const auto find_result = optimized_layers.slice_data.find(layer_nr);
+    if (find_result == optimized_layers.slice_data.end()) // Already sent.
+    {
+        return;
+    }
+    std::shared_ptr<proto::LayerOptimized> layer = std::move(find_result->second);
+    optimized_layers.slice_data.erase(find_result);
+    sendLayer(std::move(layer));
+}
+
+void ArcusCommunication::Private::sendLayer(std::shared_ptr<proto::LayerOptimized> layer)
+{
+    const auto forget_written_layers = [this]()
+    {
+        std::erase_if(
+            layers_in_flight,
+            [](const std::weak_ptr<proto::LayerOptimized>& layer_in_flight)
+            {
+                return layer_in_flight.expired();
+            });
+    };
+    forget_written_layers();
+    while (layers_in_flight.size() >= max_layers_in_flight && socket->getState() != Arcus::SocketState::Closed && socket->getState() != Arcus::SocketState::Error)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // Give the front-end time to read. A closed socket won't read any more, so then don't wait.
+        forget_written_layers();
+    }
+
+    spdlog::debug("Sending layer data for layer {}.", layer->id());
+    layers_in_flight.emplace_back(layer);
+    socket->sendMessage(std::move(layer));
+}
+
 void ArcusCommunication::Private::readGlobalSettingsMessage(const proto::SettingList& global_settings_message)
 {
     auto slice = Application::getInstance().current_slice_;
@@ -130,28 +174,29 @@ void ArcusCommunication::Private::readMeshGroupMessage(const proto::ObjectList&
         ExtruderTrain& extruder = mesh.settings_.get<ExtruderTrain&>("extruder_nr"); // Set the parent setting to the correct extruder.
         mesh.settings_.setParent(&extruder.settings_);
 
-        for (size_t face = 0; face < face_count; face++)
-        {
-            const std::string data = object.vertices().substr(face * bytes_per_face, bytes_per_face);
-            const Point3F* float_vertices = reinterpret_cast<const Point3F*>(data.data());
-            const std::string uv_coordinates_str = object.uv_coordinates().empty() ? "" : object.uv_coordinates().substr(face * bytes_per_uv, bytes_per_uv);
-            const Point2F* uv_coordinates_data = uv_coordinates_str.empty() ? nullptr : reinterpret_cast<const Point2F*>(uv_coordinates_str.data());
-
-            Point3LL verts[3];
-            verts[0] = matrix.apply(float_vertices[0].toPoint3d());
-            verts[1] = matrix.apply(float_vertices[1].toPoint3d());
-            verts[2] = matrix.apply(float_vertices[2].toPoint3d());
-
-            std::optional<Point2F> uv_coordinates[3];
-            if (uv_coordinates_data)
+        const std::string& vertices_data = object.vertices();
+        const std::string& uv_coordinates_data = object.uv_coordinates();
+        const bool has_uv_coordinates = uv_coordinates_data.size() >= face_count * bytes_per_uv;
+        std::vector<Point3LL> corners(face_count * 3);
+        std::vector<std::optional<Point2F>> uv_coordinates(has_uv_coordinates ? face_count * 3 : 0);
+        cura::parallel_for(
+            size_t(0),
+            face_count * 3,
+            [&](const size_t corner)
             {
-                uv_coordinates[0] = uv_coordinates_data[0];
-                uv_coordinates[1] = uv_coordinates_data[1];
-                uv_coordinates[2] = uv_coordinates_data[2];
-            }
-
-            mesh.addFace(verts[0], verts[1], verts[2], uv_coordinates[0], uv_coordinates[1], uv_coordinates[2]);
-        }
+                Point3F float_vertex;
+                memcpy(&float_vertex, vertices_data.data() + corner * sizeof(Point3F), sizeof(Point3F));
+                corners[corner] = matrix.apply(float_vertex.toPoint3d());
+
+                if (has_uv_coordinates)
+                {
+                    Point2F uv;
+                    memcpy(&uv, uv_coordinates_data.data() + corner * sizeof(Point2F), sizeof(Point2F));
+                    uv_coordinates[corner] = uv;
+                }
+            },
+            1024);
+        mesh.addFaces(corners, uv_coordinates);
 
         loadTextureData(object.texture(), mesh);
 
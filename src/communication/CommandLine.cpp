@@ -3,9 +3,11 @@
 
 #include "communication/CommandLine.h"
 
+#include <cctype> //For tolower.
 #include <cerrno> // error number when trying to read file
 #include <cstring> //For strtok and strcopy.
 #include <filesystem>
+#include <functional> //For hashing model files.
 #include <fstream> //To check if files exist.
 #include <numeric> //For std::accumulate.
 #include <optional>
@@ -15,6 +17,7 @@
 #include <rapidjson/writer.h>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -54,6 +57,24 @@ void CommandLine::sendGCodePart(const std::string& gcode_part)
     *output_stream_ << gcode_part;
 }
 
+bool CommandLine::overwriteGCodePart(const size_t offset, const std::string& gcode_part)
+{
+    if (! output_file_ || output_stream_ != output_file_.get() || gcode_start_ == std::streampos(-1))
+    {
+        return false;
+    }
+    const std::streampos end = output_file_->tellp();
+    output_file_->seekp(gcode_start_ + static_cast<std::streamoff>(offset));
+    output_file_->write(gcode_part.data(), static_cast<std::streamsize>(gcode_part.size()));
+    output_file_->seekp(end);
+    return output_file_->good();
+}
+
+bool CommandLine::supportsGCodeStreaming() const
+{
+    return true;
+}
+
 void CommandLine::sendCurrentPosition(const Point3LL&)
 {
 }
@@ -102,8 +123,15 @@ void CommandLine::sendProgress(double progress) const
 }
 
 void CommandLine::sliceNext()
+{
+    loadSlice();
+    computeSlice();
+}
+
+void CommandLine::loadSlice()
 {
     FffProcessor::getInstance()->time_keeper.restart();
+    loaded_meshes_.clear();
 
     // Count the number of mesh groups to slice for.
     size_t num_mesh_groups = 1;
@@ -272,7 +300,7 @@ void CommandLine::sliceNext()
 
                     const auto transformation = last_settings->get<Matrix4x3D>("mesh_rotation_matrix"); // The transformation applied to the model when loaded.
 
-                    if (! loadMeshIntoMeshGroup(&slice->scene.mesh_groups[mesh_group_index], argument, transformation, last_extruder->settings_))
+                    if (! loadMesh(&slice->scene.mesh_groups[mesh_group_index], argument, transformation, last_extruder->settings_))
                     {
                         spdlog::error("Failed to load model: {} (error number {})", argument, errno);
                         exit(1);
@@ -294,7 +322,7 @@ void CommandLine::sliceNext()
                     argument = arguments_[argument_index];
 
                     output_file_ = std::make_shared<std::ofstream>();
-                    output_file_->open(argument);
+                    output_file_->open(argument, std::ios::binary); // The header is overwritten at a byte offset when streaming.
                     if (output_file_->is_open())
                     {
                         output_stream_ = output_file_.get();
@@ -434,7 +462,7 @@ void CommandLine::sliceNext()
                         const auto transformation = slice->scene.mesh_groups[mesh_group_index].settings.get<Matrix4x3D>("mesh_rotation_matrix");
                         const auto extruder_nr = slice->scene.mesh_groups[mesh_group_index].settings.get<size_t>("extruder_nr");
 
-                        if (! loadMeshIntoMeshGroup(
+                        if (! loadMesh(
                                 &slice->scene.mesh_groups[mesh_group_index],
                                 settings_folder / model_name,
                                 transformation,
@@ -452,6 +480,7 @@ void CommandLine::sliceNext()
                             slice->scene.limit_to_extruder[key] = &slice->scene.extruders[extruder_nr];
                         }
                     }
+                    Settings::invalidateResolvedValues(); // Limiting settings to extruders changes their resolved values.
 
                     break;
                 }
@@ -476,15 +505,40 @@ void CommandLine::sliceNext()
 
     arguments_.clear(); // We've processed all arguments now.
 
+    // Only keep the models that this slice uses.
+    std::erase_if(
+        mesh_cache_,
+        [this](const auto& cached_mesh)
+        {
+            return ranges::none_of(
+                loaded_meshes_,
+                [&cached_mesh](const auto& loaded_mesh)
+                {
+                    return loaded_mesh.second == cached_mesh.first;
+                });
+        });
+}
+
+void CommandLine::computeSlice(const bool rewrite_gcode)
+{
+    std::shared_ptr<Slice> slice = Application::getInstance().current_slice_;
+    gcode_start_ = output_file_ && output_stream_ == output_file_.get() ? output_file_->tellp() : std::streampos(-1);
 #ifndef DEBUG
     try
     {
 #endif // DEBUG
-        slice->scene.mesh_groups[mesh_group_index].finalize();
-        spdlog::info("Loaded from disk in {:3}s\n", FffProcessor::getInstance()->time_keeper.restart());
+        if (rewrite_gcode)
+        {
+            slice->rewriteGCode();
+        }
+        else
+        {
+            slice->scene.mesh_groups.back().finalize();
+            spdlog::info("Loaded from disk in {:3}s\n", FffProcessor::getInstance()->time_keeper.restart());
 
-        // Start slicing.
-        slice->compute();
+            // Start slicing.
+            slice->compute();
+        }
 #ifndef DEBUG
     }
     catch (...)
@@ -500,26 +554,127 @@ void CommandLine::sliceNext()
 
 int CommandLine::loadJSON(const std::filesystem::path& json_filename, Settings& settings, bool force_read_parent, bool force_read_nondefault)
 {
+    const std::shared_ptr<const rapidjson::Document> json_document = getDefinitionDocument(json_filename);
+    if (! json_document)
+    {
+        return std::filesystem::exists(json_filename) ? 2 : 1;
+    }
+
+    const std::filesystem::path json_directory = std::filesystem::path(json_filename).parent_path();
+    if (ranges::find(search_directories_, json_directory) == search_directories_.end())
+    {
+        search_directories_.push_back(json_directory);
+    }
+    return loadJSON(*json_document, search_directories_, settings, force_read_parent, force_read_nondefault);
+}
+
+std::shared_ptr<const rapidjson::Document> CommandLine::getDefinitionDocument(const std::filesystem::path& json_filename)
+{
+    std::error_code error;
+    const fs::file_time_type last_write_time = fs::last_write_time(json_filename, error);
+    const std::uintmax_t file_size = error ? 0 : fs::file_size(json_filename, error);
+    const std::string cache_key = json_filename.generic_string();
+    if (! error)
+    {
+        const auto cached = definition_cache_.find(cache_key);
+        if (cached != definition_cache_.end() && cached->second.last_write_time == last_write_time && cached->second.file_size == file_size)
+        {
+            return cached->second.document;
+        }
+    }
+
     std::ifstream file(json_filename, std::ios::binary);
     if (! file)
     {
         spdlog::error("Couldn't open JSON file: {}", json_filename.generic_string());
-        return 1;
+        return nullptr;
     }
 
     std::vector<char> read_buffer(std::istreambuf_iterator<char>(file), {});
     rapidjson::MemoryStream memory_stream(read_buffer.data(), read_buffer.size());
 
-    rapidjson::Document json_document;
-    json_document.ParseStream(memory_stream);
-    if (json_document.HasParseError())
+    auto json_document = std::make_shared<rapidjson::Document>();
+    json_document->ParseStream(memory_stream);
+    if (json_document->HasParseError())
     {
-        spdlog::error("Error parsing JSON (offset {}): {}", json_document.GetErrorOffset(), GetParseError_En(json_document.GetParseError()));
-        return 2;
+        spdlog::error("Error parsing JSON (offset {}): {}", json_document->GetErrorOffset(), GetParseError_En(json_document->GetParseError()));
+        return nullptr;
     }
 
-    search_directories_.push_back(std::filesystem::path(json_filename).parent_path());
-    return loadJSON(json_document, search_directories_, settings, force_read_parent, force_read_nondefault);
+    if (! error)
+    {
+        definition_cache_[cache_key] = CachedDefinition{ last_write_time, file_size, json_document };
+    }
+    return json_document;
+}
+
+bool CommandLine::loadMesh(MeshGroup* mesh_group, const std::filesystem::path& filename, const Matrix4x3D& transformation, Settings& object_parent_settings)
+{
+    if (! cache_meshes_)
+    {
+        return loadMeshIntoMeshGroup(mesh_group, filename, transformation, object_parent_settings);
+    }
+
+    const std::optional<MeshFileKey> key = getMeshFileKey(filename, transformation);
+    if (key)
+    {
+        const auto cached = mesh_cache_.find(*key);
+        if (cached != mesh_cache_.end())
+        {
+            Mesh mesh = *cached->second;
+            mesh.settings_ = object_parent_settings;
+            mesh.mesh_name_ = filename.stem().string();
+            mesh_group->meshes.push_back(std::move(mesh));
+            loaded_meshes_.emplace_back(filename.generic_string(), key);
+            spdlog::info("Reusing '{}', which was loaded before", filename.string());
+            return true;
+        }
+    }
+
+    if (! loadMeshIntoMeshGroup(mesh_group, filename, transformation, object_parent_settings))
+    {
+        return false;
+    }
+    if (key)
+    {
+        mesh_cache_.emplace(*key, std::make_shared<const Mesh>(mesh_group->meshes.back()));
+    }
+    loaded_meshes_.emplace_back(filename.generic_string(), key);
+    return true;
+}
+
+std::optional<CommandLine::MeshFileKey> CommandLine::getMeshFileKey(const std::filesystem::path& filename, const Matrix4x3D& transformation)
+{
+    // Only STL files are loaded on their own. Next to those, loadMeshIntoMeshGroup looks for UV coordinates (and then a texture) by file name.
+    std::string extension = filename.extension().string();
+    ranges::transform(extension, extension.begin(), static_cast<int (*)(int)>(std::tolower));
+    if (extension != ".stl" || fs::exists(fs::path(filename.stem().string() + ".uv")))
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (! file)
+    {
+        return std::nullopt;
+    }
+    const std::string contents(std::istreambuf_iterator<char>(file), {});
+
+    MeshFileKey key{ std::hash<std::string_view>()(contents), contents.size(), {} };
+    for (size_t row = 0; row < 4; ++row)
+    {
+        for (size_t column = 0; column < 3; ++column)
+        {
+            key.transformation[row * 3 + column] = transformation.m[row][column];
+        }
+    }
+    return key;
+}
+
+size_t CommandLine::MeshFileKeyHash::operator()(const MeshFileKey& key) const
+{
+    // The contents of the file are the most distinctive, the transformation is usually the same.
+    return key.content_hash ^ (std::hash<std::uintmax_t>()(key.file_size) << 1);
 }
 
 int CommandLine::loadJSON(
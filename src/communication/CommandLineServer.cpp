@@ -0,0 +1,232 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "communication/CommandLineServer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio> //To report finished slices on stderr.
+#include <functional>
+#include <iostream> //To read the requests from stdin.
+#include <string_view>
+
+#include <range/v3/algorithm/all_of.hpp>
+#include <spdlog/spdlog.h>
+
+#include "Application.h"
+#include "ExtruderTrain.h"
+#include "FffProcessor.h" //To start every slice with a fresh g-code writer.
+#include "Slice.h"
+
+namespace cura
+{
+
+/*
+ * The settings that are only used to write g-code, not to slice. If a slice
+ * only changes these, the slice data of the previous slice can be reused.
+ */
+constexpr std::array<std::string_view, 5> gcode_only_settings{ "machine_start_gcode",
+                                                                "machine_end_gcode",
+                                                                "machine_extruder_prestart_code",
+                                                                "machine_extruder_start_code",
+                                                                "machine_extruder_end_code" };
+
+CommandLineServer::CommandLineServer()
+    : CommandLine(std::vector<std::string>{})
+{
+    cache_meshes_ = true;
+}
+
+bool CommandLineServer::hasSlice() const
+{
+    if (next_arguments_)
+    {
+        return true;
+    }
+    std::string line;
+    while (! stopped_)
+    {
+        if (! std::getline(std::cin, line) || line == "quit")
+        {
+            stopped_ = true;
+            break;
+        }
+        std::vector<std::string> arguments = splitArguments(line);
+        if (! arguments.empty())
+        {
+            // The arguments are parsed the same as the command line, which starts with the executable and the command.
+            arguments.insert(arguments.begin(), { "CuraEngine", "slice" });
+            next_arguments_ = std::move(arguments);
+            return true;
+        }
+    }
+    return false;
+}
+
+void CommandLineServer::sliceNext()
+{
+    if (! hasSlice())
+    {
+        return;
+    }
+    arguments_ = std::move(*next_arguments_);
+    next_arguments_.reset();
+
+    // Start from the state of a new command line, except for the caches.
+    output_file_.reset();
+    output_stream_ = &std::cout;
+    FffProcessor::getInstance()->resetGcodeWriter();
+
+    loadSlice();
+    std::shared_ptr<Slice> slice = Application::getInstance().current_slice_;
+
+    const bool same_models = loaded_meshes_ == previous_loaded_meshes_
+                          && ranges::all_of(
+                                 loaded_meshes_,
+                                 [](const auto& loaded_mesh)
+                                 {
+                                     return loaded_mesh.second.has_value();
+                                 });
+    const bool rewrite_gcode = previous_slice_ && same_models && takeGCodeSettings(*previous_slice_, *slice);
+    if (rewrite_gcode)
+    {
+        spdlog::info("Only settings for the g-code changed, writing the g-code of the previous slice again");
+        slice = previous_slice_;
+        Application::getInstance().current_slice_ = slice;
+    }
+    else
+    {
+        previous_slice_.reset(); // Free the slice data before making new slice data.
+        slice->scene.keep_slice_data = true;
+    }
+
+    computeSlice(rewrite_gcode);
+    output_stream_->flush();
+    output_file_.reset();
+
+    previous_slice_ = slice;
+    previous_loaded_meshes_ = loaded_meshes_;
+    std::fputs("done\n", stderr);
+    std::fflush(stderr);
+}
+
+std::vector<std::string> CommandLineServer::splitArguments(const std::string& line)
+{
+    std::vector<std::string> arguments;
+    std::string argument;
+    bool in_argument = false;
+    bool in_quotes = false;
+    for (size_t i = 0; i < line.size(); ++i)
+    {
+        const char character = line[i];
+        if (in_quotes && character == '\\' && i + 1 < line.size())
+        {
+            const char escaped = line[++i];
+            argument += escaped == 'n' ? '\n' : escaped;
+        }
+        else if (character == '"')
+        {
+            in_quotes = ! in_quotes;
+            in_argument = true;
+        }
+        else if (! in_quotes && (character == ' ' || character == '\t' || character == '\r'))
+        {
+            if (in_argument)
+            {
+                arguments.push_back(std::move(argument));
+                argument.clear();
+                in_argument = false;
+            }
+        }
+        else
+        {
+            argument += character;
+            in_argument = true;
+        }
+    }
+    if (in_argument)
+    {
+        arguments.push_back(std::move(argument));
+    }
+    return arguments;
+}
+
+bool CommandLineServer::takeGCodeSettings(Slice& previous_slice, const Slice& next_slice)
+{
+    Scene& previous = previous_slice.scene;
+    const Scene& next = next_slice.scene;
+    if (previous.extruders.size() != next.extruders.size() || previous.mesh_groups.size() != next.mesh_groups.size())
+    {
+        return false;
+    }
+
+    // Pair up all settings containers of both scenes.
+    std::vector<std::pair<Settings*, const Settings*>> containers{ { &previous.settings, &next.settings } };
+    for (size_t extruder_nr = 0; extruder_nr < previous.extruders.size(); ++extruder_nr)
+    {
+        containers.emplace_back(&previous.extruders[extruder_nr].settings_, &next.extruders[extruder_nr].settings_);
+    }
+    for (size_t mesh_group_idx = 0; mesh_group_idx < previous.mesh_groups.size(); ++mesh_group_idx)
+    {
+        MeshGroup& previous_mesh_group = previous.mesh_groups[mesh_group_idx];
+        const MeshGroup& next_mesh_group = next.mesh_groups[mesh_group_idx];
+        if (previous_mesh_group.meshes.size() != next_mesh_group.meshes.size())
+        {
+            return false;
+        }
+        containers.emplace_back(&previous_mesh_group.settings, &next_mesh_group.settings);
+        for (size_t mesh_idx = 0; mesh_idx < previous_mesh_group.meshes.size(); ++mesh_idx)
+        {
+            containers.emplace_back(&previous_mesh_group.meshes[mesh_idx].settings_, &next_mesh_group.meshes[mesh_idx].settings_);
+        }
+    }
+
+    // The settings must be limited to the same extruders.
+    if (previous.limit_to_extruder.size() != next.limit_to_extruder.size())
+    {
+        return false;
+    }
+    for (const auto& [key, extruder] : next.limit_to_extruder)
+    {
+        const auto previous_extruder = previous.limit_to_extruder.find(key);
+        if (previous_extruder == previous.limit_to_extruder.end() || previous_extruder->second->extruder_nr_ != extruder->extruder_nr_)
+        {
+            return false;
+        }
+    }
+
+    std::vector<std::vector<std::string>> differing_keys;
+    for (const auto& [previous_settings, next_settings] : containers)
+    {
+        differing_keys.push_back(previous_settings->getDifferingKeys(*next_settings));
+        const bool gcode_only = ranges::all_of(
+            differing_keys.back(),
+            [](const std::string& key)
+            {
+                return std::find(gcode_only_settings.begin(), gcode_only_settings.end(), key) != gcode_only_settings.end();
+            });
+        if (! gcode_only)
+        {
+            return false;
+        }
+    }
+
+    for (size_t container_idx = 0; container_idx < containers.size(); ++container_idx)
+    {
+        const auto& [previous_settings, next_settings] = containers[container_idx];
+        for (const std::string& key : differing_keys[container_idx])
+        {
+            if (next_settings->has(key))
+            {
+                previous_settings->add(key, next_settings->get<std::string>(key));
+            }
+            else
+            {
+                previous_settings->remove(key);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace cura
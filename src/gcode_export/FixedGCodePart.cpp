@@ -17,9 +17,19 @@ std::string FixedGCodePart::str() const
     return stream_.str();
 }
 
-std::ostringstream& FixedGCodePart::stream()
+GCodeOutputStream& FixedGCodePart::stream()
 {
     return stream_;
 }
 
+std::string_view FixedGCodePart::view() const
+{
+    return stream_.view();
+}
+
+size_t FixedGCodePart::size() const
+{
+    return stream_.view().size();
+}
+
 } // namespace cura
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "gcode_export/GCodeOutputStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+namespace cura
+{
+
+std::string_view GCodeOutputBuffer::view() const
+{
+    return std::string_view(pbase(), static_cast<size_t>(pptr() - pbase()));
+}
+
+GCodeOutputBuffer::int_type GCodeOutputBuffer::overflow(const int_type character)
+{
+    if (traits_type::eq_int_type(character, traits_type::eof()))
+    {
+        return traits_type::not_eof(character);
+    }
+    grow(1);
+    *pptr() = traits_type::to_char_type(character);
+    pbump(1);
+    return character;
+}
+
+std::streamsize GCodeOutputBuffer::xsputn(const char* characters, const std::streamsize count)
+{
+    if (count <= 0)
+    {
+        return 0;
+    }
+    if (count > epptr() - pptr())
+    {
+        grow(static_cast<size_t>(count));
+    }
+    std::memcpy(pptr(), characters, static_cast<size_t>(count));
+    advance(static_cast<size_t>(count));
+    return count;
+}
+
+void GCodeOutputBuffer::grow(const size_t count)
+{
+    const size_t size = view().size();
+    const size_t capacity = std::max({ initial_capacity_, capacity_ * 2, size + count });
+    auto data = std::make_unique_for_overwrite<char[]>(capacity);
+    if (size > 0)
+    {
+        std::memcpy(data.get(), data_.get(), size);
+    }
+    data_ = std::move(data);
+    capacity_ = capacity;
+
+    setp(data_.get(), data_.get() + capacity_);
+    advance(size);
+}
+
+void GCodeOutputBuffer::advance(size_t count)
+{
+    while (count > 0) // pbump only takes an int
+    {
+        const int step = static_cast<int>(std::min(count, static_cast<size_t>(std::numeric_limits<int>::max())));
+        pbump(step);
+        count -= static_cast<size_t>(step);
+    }
+}
+
+GCodeOutputStream::GCodeOutputStream()
+    : std::ostream(nullptr)
+{
+    rdbuf(&buffer_);
+}
+
+std::string_view GCodeOutputStream::view() const
+{
+    return buffer_.view();
+}
+
+std::string GCodeOutputStream::str() const
+{
+    return std::string(buffer_.view());
+}
+
+} // namespace cura
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "gcode_export/GCodeSpool.h"
+
+#include <cstdlib>
+
+#include <spdlog/spdlog.h>
+
+
+namespace cura
+{
+
+namespace
+{
+
+/*! \brief Seeks to an absolute \p offset, which may be past the 2 GiB that a long can hold on some platforms */
+int seekTo(std::FILE* file, const size_t offset)
+{
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+} // namespace
+
+GCodeSpool::GCodeSpool()
+    : file_(std::tmpfile())
+{
+    if (! file_)
+    {
+        spdlog::warn("Unable to create a temporary file for the GCode, keeping it in memory instead.");
+    }
+}
+
+GCodeSpool::~GCodeSpool()
+{
+    if (file_)
+    {
+        std::fclose(file_); // Temporary files are removed when closed.
+    }
+}
+
+bool GCodeSpool::isOpen() const
+{
+    return file_ != nullptr;
+}
+
+std::optional<size_t> GCodeSpool::append(const std::string_view gcode)
+{
+    std::lock_guard lock(mutex_);
+    if (! file_ || std::fseek(file_, 0, SEEK_END) != 0 || std::fwrite(gcode.data(), 1, gcode.size(), file_) != gcode.size())
+    {
+        return std::nullopt;
+    }
+    const size_t offset = size_;
+    size_ += gcode.size();
+    return offset;
+}
+
+std::string GCodeSpool::read(const size_t offset, const size_t length) const
+{
+    std::string gcode(length, '\0');
+    std::lock_guard lock(mutex_);
+    if (seekTo(file_, offset) != 0 || std::fread(gcode.data(), 1, length, file_) != length)
+    {
+        // The GCode of these layers is lost. Writing out the rest would give a print that silently misses them.
+        spdlog::error("Unable to read back GCode from the temporary file.");
+        std::exit(1);
+    }
+    return gcode;
+}
+
+} // namespace cura
@@ -28,4 +28,9 @@ std::string ResolvedGCodePart::str() const
     return template_resolver_->resolveGCodeTemplate(raw_string_, context_extruder_nr_, extra_settings_);
 }
 
+const std::string& ResolvedGCodePart::getRawString() const
+{
+    return raw_string_;
+}
+
 } // namespace cura
@@ -0,0 +1,24 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "gcode_export/SpooledGCodePart.h"
+
+#include "gcode_export/GCodeSpool.h"
+
+
+namespace cura
+{
+
+SpooledGCodePart::SpooledGCodePart(const std::shared_ptr<const GCodeSpool>& spool, const size_t offset, const size_t length)
+    : spool_(spool)
+    , offset_(offset)
+    , length_(length)
+{
+}
+
+std::string SpooledGCodePart::str() const
+{
+    return spool_->read(offset_, length_);
+}
+
+} // namespace cura
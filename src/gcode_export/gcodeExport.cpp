@@ -3,11 +3,14 @@
 
 #include "gcode_export/gcodeExport.h"
 
+#include <array>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cmath>
 #include <cura-formulae-engine/parser/parser.h>
 #include <iomanip>
+#include <limits>
 #include <numbers>
 #include <regex>
 
@@ -23,8 +26,10 @@
 #include "WipeScriptConfig.h"
 #include "communication/Communication.h" //To send layer view data.
 #include "gcode_export/FixedGCodePart.h"
+#include "gcode_export/GCodeSpool.h"
 #include "gcode_export/GcodeTemplateResolver.h"
 #include "gcode_export/ResolvedGCodePart.h"
+#include "gcode_export/SpooledGCodePart.h"
 #include "settings/types/LayerIndex.h"
 #include "sliceDataStorage.h"
 #include "utils/Date.h"
@@ -37,6 +42,38 @@ namespace cfe = CuraFormulaeEngine;
 namespace cura
 {
 
+namespace
+{
+
+/*!
+ * \brief The variables of start and end GCode of which the value is only known at the end of the print, as set in GCodeExport::finalize.
+ *
+ * The bounding box variables are matched by their prefix.
+ */
+constexpr std::array<std::string_view, 7> print_totals_variables
+    = { "print_time", "filament_amount", "filament_weight", "filament_cost", "initial_layer_bb_", "total_bb_", "is_extruder_used" };
+
+/*!
+ * \brief Whether a piece of unresolved GCode may refer to the totals of the print. Text that only looks like one of the variables counts as well.
+ */
+bool refersToPrintTotals(const std::string_view raw_text)
+{
+    for (const std::string_view variable : print_totals_variables)
+    {
+        for (size_t position = raw_text.find(variable); position != std::string_view::npos; position = raw_text.find(variable, position + 1))
+        {
+            const char previous = position == 0 ? ' ' : raw_text[position - 1];
+            if (! std::isalnum(static_cast<unsigned char>(previous)) && previous != '_')
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 std::string transliterate(const std::string& text)
 {
     // For now, just replace all non-ascii characters with '?'.
@@ -80,6 +117,13 @@ GCodeExport::GCodeExport()
 
     total_bounding_box_ = AABB3D();
 
+    stream_gcode_ = spdlog::details::os::getenv("CURAENGINE_STREAM_GCODE") == "1";
+    streamed_parts_count_ = 0;
+    gcode_spool_threshold_ = default_gcode_spool_threshold;
+    spooled_parts_count_ = 0;
+    examined_parts_count_ = 0;
+    unspooled_gcode_size_ = 0;
+
     prepareNewFixedGCodePart();
 }
 
@@ -355,6 +399,7 @@ void GCodeExport::setLayerNr(const LayerIndex& layer_nr)
 {
     layer_nr_ = layer_nr;
     prepareNewFixedGCodePart(); // Now is a good time to switch to a new buffer
+    spoolFinishedGCodeParts();
 }
 
 bool GCodeExport::getExtruderIsUsed(const int extruder_nr) const
@@ -939,14 +984,38 @@ void GCodeExport::writeTravel(const Point3LL& p, const Velocity& speed, const st
     writeTravel(p.x_, p.y_, p.z_ + is_z_hopped_, speed, retract_distance);
 }
 
-void GCodeExport::writeExtrusion(const Point3LL& p, const Velocity& speed, double extrusion_mm3_per_mm, PrintFeatureType feature, bool update_extrusion_offset)
+void GCodeExport::writeExtrusion(
+    const Point3LL& p,
+    const Velocity& speed,
+    double extrusion_mm3_per_mm,
+    PrintFeatureType feature,
+    bool update_extrusion_offset,
+    const std::string_view formatted_xy)
 {
     if (flavor_ == EGCodeFlavor::BFB)
     {
         writeMoveBFB(p.x_, p.y_, p.z_, speed, extrusion_mm3_per_mm, feature);
         return;
     }
-    writeExtrusion(p.x_, p.y_, p.z_, speed, extrusion_mm3_per_mm, feature, update_extrusion_offset);
+    writeExtrusion(p.x_, p.y_, p.z_, speed, extrusion_mm3_per_mm, feature, update_extrusion_offset, formatted_xy);
+}
+
+std::string GCodeExport::formatExtrusionXY(const std::vector<Point3LL>& points, const size_t extruder_nr) const
+{
+    std::ostringstream formatted_xy;
+    for (const Point3LL& point : points)
+    {
+        const Point2LL gcode_pos = getGcodePos(point.x_, point.y_, extruder_nr);
+        formatted_xy << " X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y };
+    }
+    return formatted_xy.str();
+}
+
+std::string_view GCodeExport::popFormattedXY(std::string_view& formatted_xy)
+{
+    const std::string_view point_xy = formatted_xy.substr(0, formatted_xy.find(" X", 1));
+    formatted_xy.remove_prefix(point_xy.size());
+    return point_xy;
 }
 
 void GCodeExport::writeMoveBFB(const int x, const int y, const int z, const Velocity& speed, double extrusion_mm3_per_mm, PrintFeatureType feature)
@@ -1048,7 +1117,8 @@ void GCodeExport::writeExtrusion(
     const Velocity& speed,
     const double extrusion_mm3_per_mm,
     const PrintFeatureType& feature,
-    const bool update_extrusion_offset)
+    const bool update_extrusion_offset,
+    const std::string_view formatted_xy)
 {
     if (current_position_.x_ == x && current_position_.y_ == y && current_position_.z_ == z)
     {
@@ -1116,7 +1186,7 @@ void GCodeExport::writeExtrusion(
     const double new_e_value = current_e_value_ + extrusion_per_mm * diff_length;
 
     *output_stream_ << "G1";
-    writeFXYZE(speed, x, y, z, new_e_value, feature);
+    writeFXYZE(speed, x, y, z, new_e_value, feature, std::nullopt, formatted_xy);
 }
 
 void GCodeExport::writeFXYZE(
@@ -1126,7 +1196,8 @@ void GCodeExport::writeFXYZE(
     const coord_t z,
     const double e,
     const PrintFeatureType& feature,
-    const std::optional<RetractionAmounts>& retraction_amounts)
+    const std::optional<RetractionAmounts>& retraction_amounts,
+    const std::string_view formatted_xy)
 {
     bool any_written = false;
 
@@ -1145,7 +1216,14 @@ void GCodeExport::writeFXYZE(
     if (x != current_position_.x_ || y != current_position_.y_)
     {
         any_written = true;
-        *output_stream_ << " X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y };
+        if (formatted_xy.empty())
+        {
+            *output_stream_ << " X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y };
+        }
+        else
+        {
+            *output_stream_ << formatted_xy;
+        }
     }
 
     if (z != current_position_.z_)
@@ -1426,7 +1504,7 @@ void GCodeExport::sendFinalGCode()
     std::shared_ptr<Communication> communication = Application::getInstance().communication_;
 
     run_multiple_producers_ordered_consumer(
-        0,
+        streamed_parts_count_,
         gcode_parts_.size(),
         [this](int gcode_part_index)
         {
@@ -2024,14 +2102,22 @@ void GCodeExport::finalize(const std::string& end_code, PrintInformation& print_
         is_extruder_used[extruder_nr] = is_this_extruder_used;
     }
     extra_global_settings.emplace("is_extruder_used", is_extruder_used);
+    // Any variable added here has to be in print_totals_variables too, so that GCode referring to it isn't streamed.
 
     template_resolver_->prepareForResolving(print_info.initial_extruder_nr.value_or(0), extra_global_settings);
 
     std::shared_ptr<Communication> communication = Application::getInstance().communication_;
 
-    communication->sendGCodePart(getFileHeader(is_extruder_used_bool, filaments_volumes, materials_ids));
+    if (streamed_header_size_.has_value())
+    {
+        finishStreamedGCode(getFileHeader(is_extruder_used_bool, filaments_volumes, materials_ids));
+    }
+    else
+    {
+        communication->sendGCodePart(getFileHeader(is_extruder_used_bool, filaments_volumes, materials_ids));
 
-    sendFinalGCode();
+        sendFinalGCode();
+    }
 
     communication->sendPrintInformation(total_print_times_, print_info);
 }
@@ -2055,6 +2141,147 @@ void GCodeExport::prepareNewFixedGCodePart()
     output_stream_ = &fixed_gcode_part->stream();
 }
 
+void GCodeExport::spoolFinishedGCodeParts()
+{
+    const size_t finished_parts_count = gcode_parts_.size() - 1; // The last part is still being written to.
+    for (; examined_parts_count_ < finished_parts_count; ++examined_parts_count_)
+    {
+        if (const auto fixed_gcode_part = std::dynamic_pointer_cast<FixedGCodePart>(gcode_parts_[examined_parts_count_]))
+        {
+            unspooled_gcode_size_ += fixed_gcode_part->size();
+        }
+    }
+    if (unspooled_gcode_size_ <= gcode_spool_threshold_)
+    {
+        return;
+    }
+
+    if (! gcode_spool_)
+    {
+        gcode_spool_ = std::make_shared<GCodeSpool>();
+    }
+    if (! gcode_spool_->isOpen())
+    {
+        return;
+    }
+
+    for (; spooled_parts_count_ < finished_parts_count; ++spooled_parts_count_)
+    {
+        std::shared_ptr<GCodePart>& gcode_part = gcode_parts_[spooled_parts_count_];
+        const auto fixed_gcode_part = std::dynamic_pointer_cast<FixedGCodePart>(gcode_part);
+        if (! fixed_gcode_part || fixed_gcode_part->size() == 0)
+        {
+            continue; // Resolved parts can only be generated at the very end, and empty parts don't take memory.
+        }
+        const std::string_view gcode = fixed_gcode_part->view();
+        const std::optional<size_t> offset = gcode_spool_->append(gcode);
+        if (! offset.has_value())
+        {
+            spdlog::warn("Unable to write GCode to the temporary file, keeping it in memory instead.");
+            gcode_spool_threshold_ = std::numeric_limits<size_t>::max(); // Don't try again.
+            break;
+        }
+        gcode_part = std::make_shared<SpooledGCodePart>(gcode_spool_, *offset, gcode.size());
+        unspooled_gcode_size_ -= gcode.size();
+    }
+}
+
+void GCodeExport::sendFinishedGCodeParts(const PrintInformation& print_info)
+{
+    if (! stream_gcode_ || ! print_info.initial_extruder_nr.has_value())
+    {
+        return;
+    }
+    std::shared_ptr<Communication> communication = Application::getInstance().communication_;
+
+    if (! streamed_header_size_.has_value())
+    {
+        if (! communication->supportsGCodeStreaming())
+        {
+            stream_gcode_ = false; // Everything is sent at the end instead.
+            return;
+        }
+
+        // Only GCode that doesn't refer to the totals of the print is resolved now, which gives the same result as resolving it at the end.
+        template_resolver_->prepareForResolving(*print_info.initial_extruder_nr);
+
+        // Assume that all extruders are used, so that the final header has no more extruder lines than this one.
+        const size_t extruder_count = Application::getInstance().current_slice_->scene.extruders.size();
+        const AABB3D total_bounding_box = total_bounding_box_; // The header fills in a default bounding box when nothing has been printed yet.
+        const std::string header = getFileHeader(std::vector<bool>(extruder_count, true), std::vector<double>(extruder_count, 0.0));
+        total_bounding_box_ = total_bounding_box;
+
+        const std::string header_region = header + makeHeaderPadding(streamed_header_slack * (extruder_count + 1)).value();
+        communication->sendGCodePart(header_region);
+        streamed_header_size_ = header_region.size();
+    }
+
+    const size_t finished_parts_count = gcode_parts_.size() - 1; // The last part is still being written to.
+    for (; streamed_parts_count_ < finished_parts_count; ++streamed_parts_count_)
+    {
+        std::shared_ptr<GCodePart>& gcode_part = gcode_parts_[streamed_parts_count_];
+        if (const auto resolved_gcode_part = std::dynamic_pointer_cast<ResolvedGCodePart>(gcode_part);
+            resolved_gcode_part && refersToPrintTotals(resolved_gcode_part->getRawString()))
+        {
+            break; // This part has to wait for the end of the print, and everything after it too.
+        }
+        if (const auto fixed_gcode_part = std::dynamic_pointer_cast<FixedGCodePart>(gcode_part); fixed_gcode_part && streamed_parts_count_ < examined_parts_count_)
+        {
+            unspooled_gcode_size_ -= fixed_gcode_part->size();
+        }
+        const std::string gcode = gcode_part->str();
+        if (! gcode.empty())
+        {
+            communication->sendGCodePart(gcode);
+        }
+        gcode_part.reset();
+    }
+    examined_parts_count_ = std::max(examined_parts_count_, streamed_parts_count_);
+    spooled_parts_count_ = std::max(spooled_parts_count_, streamed_parts_count_);
+}
+
+void GCodeExport::finishStreamedGCode(const std::string& header)
+{
+    std::shared_ptr<Communication> communication = Application::getInstance().communication_;
+
+    sendFinalGCode();
+
+    if (header.size() <= *streamed_header_size_)
+    {
+        const std::optional<std::string> padding = header.size() == *streamed_header_size_ ? std::string() : makeHeaderPadding(*streamed_header_size_ - header.size());
+        if (padding.has_value() && communication->overwriteGCodePart(0, header + *padding))
+        {
+            return;
+        }
+    }
+    spdlog::info("Unable to update the header of the streamed GCode, writing the totals of the print at the end instead.");
+    communication->sendGCodePart(";The header at the start was written before the end of the print, these are the actual values:" + new_line_ + header);
+}
+
+std::optional<std::string> GCodeExport::makeHeaderPadding(const size_t length) const
+{
+    constexpr size_t max_line_length = 80; // Keep the lines short enough for any firmware to skip them as a comment.
+    const size_t min_line_length = 1 + new_line_.size();
+    if (length < min_line_length)
+    {
+        return std::nullopt;
+    }
+
+    std::string padding;
+    size_t remaining = length;
+    while (remaining > 0)
+    {
+        size_t line_length = std::min(remaining, max_line_length);
+        if (remaining - line_length > 0 && remaining - line_length < min_line_length)
+        {
+            line_length = remaining - min_line_length; // Leave enough for a last line.
+        }
+        padding += ';' + std::string(line_length - min_line_length, ' ') + new_line_;
+        remaining -= line_length;
+    }
+    return padding;
+}
+
 void GCodeExport::writeResolvableGCode(
     const std::string& raw_text,
     const ResolvingExtruderContext& extruder_nr,
@@ -0,0 +1,281 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "geometry/SegmentIndexedShape.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "geometry/PointMatrix.h"
+#include "geometry/Shape.h"
+#include "utils/linearAlg2D.h"
+
+namespace cura
+{
+
+// Queries about line segments also look at the segments of the shape just outside of their bounding box, since the collision and
+// intersection computations round their intermediate results.
+constexpr coord_t query_margin = 10;
+
+SegmentIndexedShape::SegmentIndexedShape(const Shape& shape)
+{
+    for (const Polygon& polygon : shape)
+    {
+        const bool bounds_area = polygon.size() >= 3;
+        for (auto iterator = polygon.beginSegments(); iterator != polygon.endSegments(); ++iterator)
+        {
+            segments_.push_back(Segment{ (*iterator).start, (*iterator).end, bounds_area, 0, 0 });
+            bounding_box_.include((*iterator).start);
+        }
+    }
+    if (segments_.empty())
+    {
+        return;
+    }
+
+    // Aim for about one segment per cell. Long segments are registered in many cells though, so grow the cells until that stays reasonable.
+    const coord_t width = bounding_box_.max_.X - bounding_box_.min_.X;
+    const coord_t height = bounding_box_.max_.Y - bounding_box_.min_.Y;
+    const auto segments_count = static_cast<coord_t>(segments_.size());
+    cell_size_ = std::max({ static_cast<coord_t>(std::sqrt(static_cast<double>(width) * static_cast<double>(height) / static_cast<double>(segments_count))),
+                            std::max(width, height) / segments_count,
+                            coord_t(1) });
+    const auto count_registrations = [this]()
+    {
+        size_t registrations = 0;
+        for (const Segment& segment : segments_)
+        {
+            const coord_t segment_columns = toGridCoord(std::max(segment.start.X, segment.end.X) - bounding_box_.min_.X)
+                                          - toGridCoord(std::min(segment.start.X, segment.end.X) - bounding_box_.min_.X) + 1;
+            const coord_t segment_rows = toGridCoord(std::max(segment.start.Y, segment.end.Y) - bounding_box_.min_.Y)
+                                       - toGridCoord(std::min(segment.start.Y, segment.end.Y) - bounding_box_.min_.Y) + 1;
+            registrations += segment_columns * segment_rows;
+        }
+        return registrations;
+    };
+    while (count_registrations() > 8 * segments_.size())
+    {
+        cell_size_ *= 2;
+    }
+    columns_ = width / cell_size_ + 1;
+    rows_ = height / cell_size_ + 1;
+
+    for (Segment& segment : segments_)
+    {
+        segment.min_column = toGridCoord(std::min(segment.start.X, segment.end.X) - bounding_box_.min_.X);
+        segment.min_row = toGridCoord(std::min(segment.start.Y, segment.end.Y) - bounding_box_.min_.Y);
+    }
+
+    // Counting sort of the segments into the cells of their bounding boxes.
+    const auto for_each_cell = [this](const Segment& segment, const auto& function)
+    {
+        const coord_t max_column = toGridCoord(std::max(segment.start.X, segment.end.X) - bounding_box_.min_.X);
+        const coord_t max_row = toGridCoord(std::max(segment.start.Y, segment.end.Y) - bounding_box_.min_.Y);
+        for (coord_t row = segment.min_row; row <= max_row; ++row)
+        {
+            for (coord_t column = segment.min_column; column <= max_column; ++column)
+            {
+                function(row * columns_ + column);
+            }
+        }
+    };
+    cell_starts_.assign(columns_ * rows_ + 1, 0);
+    for (const Segment& segment : segments_)
+    {
+        for_each_cell(
+            segment,
+            [this](const size_t cell)
+            {
+                ++cell_starts_[cell + 1];
+            });
+    }
+    for (size_t cell = 1; cell < cell_starts_.size(); ++cell)
+    {
+        cell_starts_[cell] += cell_starts_[cell - 1];
+    }
+    cell_segments_.resize(cell_starts_.back());
+    std::vector<size_t> insert_positions(cell_starts_.begin(), cell_starts_.end() - 1);
+    for (size_t segment_idx = 0; segment_idx < segments_.size(); ++segment_idx)
+    {
+        for_each_cell(
+            segments_[segment_idx],
+            [this, &insert_positions, segment_idx](const size_t cell)
+            {
+                cell_segments_[insert_positions[cell]++] = segment_idx;
+            });
+    }
+}
+
+template<typename Function>
+bool SegmentIndexedShape::anySegmentInCells(coord_t min_column, coord_t max_column, coord_t min_row, coord_t max_row, const Function& function) const
+{
+    min_column = std::max(min_column, coord_t(0));
+    max_column = std::min(max_column, columns_ - 1);
+    min_row = std::max(min_row, coord_t(0));
+    max_row = std::min(max_row, rows_ - 1);
+    for (coord_t row = min_row; row <= max_row; ++row)
+    {
+        for (coord_t column = min_column; column <= max_column; ++column)
+        {
+            const size_t cell = row * columns_ + column;
+            for (size_t entry = cell_starts_[cell]; entry < cell_starts_[cell + 1]; ++entry)
+            {
+                // Segments are registered in all cells of their bounding box. Only visit a segment in the first of those within the range.
+                const size_t segment_idx = cell_segments_[entry];
+                const Segment& segment = segments_[segment_idx];
+                if (column == std::max(min_column, segment.min_column) && row == std::max(min_row, segment.min_row) && function(segment_idx))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool SegmentIndexedShape::empty() const
+{
+    return segments_.empty();
+}
+
+const AABB& SegmentIndexedShape::getBoundingBox() const
+{
+    return bounding_box_;
+}
+
+bool SegmentIndexedShape::inside(const Point2LL& p, bool border_result) const
+{
+    if (segments_.empty() || ! bounding_box_.contains(p))
+    {
+        // Any segment that the horizontal line through p crosses lies on both sides of it, so the number of crossings on either side is even.
+        return false;
+    }
+
+    // This evaluates the same rules per segment as ClipperLib::PointInPolygon, which Shape::inside uses. That casts a ray from p towards
+    // positive X and counts the segments that cross it. The segments that cross the ray can only be in the row of cells of p, from the cell
+    // of p onwards. If there are fewer cells towards negative X, count the crossings on that side instead: all segments crossing the line
+    // through p that are not registered in the cells on that side lie completely at the positive side, and the total number of crossings is
+    // even.
+    const coord_t column = toGridCoord(p.X - bounding_box_.min_.X);
+    const coord_t row = toGridCoord(p.Y - bounding_box_.min_.Y);
+    const bool count_positive_side = columns_ - column <= column + 1;
+
+    // The segments are visited in no particular order. That doesn't matter: the parity of the crossings doesn't depend on it, and any segment
+    // that p lies on gives the border result.
+    bool positive_crossings_odd = false;
+    bool all_crossings_odd = false;
+    const bool on_border = anySegmentInCells(
+        count_positive_side ? column : 0,
+        count_positive_side ? columns_ - 1 : column,
+        row,
+        row,
+        [&](const size_t segment_idx)
+        {
+            const Segment& segment = segments_[segment_idx];
+            if (! segment.bounds_area)
+            {
+                return false;
+            }
+            const Point2LL& ip = segment.start;
+            const Point2LL& ip_next = segment.end;
+            if (ip_next.Y == p.Y)
+            {
+                if ((ip_next.X == p.X) || (ip.Y == p.Y && ((ip_next.X > p.X) == (ip.X < p.X))))
+                {
+                    return true;
+                }
+            }
+            if ((ip.Y < p.Y) != (ip_next.Y < p.Y))
+            {
+                all_crossings_odd = ! all_crossings_odd;
+                if (ip.X >= p.X && ip_next.X > p.X)
+                {
+                    positive_crossings_odd = ! positive_crossings_odd;
+                }
+                else if (ip.X >= p.X || ip_next.X > p.X)
+                {
+                    const double d = static_cast<double>(ip.X - p.X) * static_cast<double>(ip_next.Y - p.Y) - static_cast<double>(ip_next.X - p.X) * static_cast<double>(ip.Y - p.Y);
+                    if (d == 0.0)
+                    {
+                        return true;
+                    }
+                    if ((d > 0) == (ip_next.Y > ip.Y))
+                    {
+                        positive_crossings_odd = ! positive_crossings_odd;
+                    }
+                }
+            }
+            return false;
+        });
+    if (on_border)
+    {
+        return border_result;
+    }
+    return count_positive_side ? positive_crossings_odd : positive_crossings_odd != all_crossings_odd;
+}
+
+std::vector<float> SegmentIndexedShape::intersectionsWithSegment(const Point2LL& start, const Point2LL& end) const
+{
+    std::vector<float> result;
+    if (segments_.empty())
+    {
+        return result;
+    }
+
+    // Collect the hits with the index of their segment, to put them in the order of the shape. There are only few hits, unlike candidates.
+    std::vector<std::pair<size_t, float>> hits;
+    anySegmentInCells(
+        toGridCoord(std::min(start.X, end.X) - query_margin - bounding_box_.min_.X),
+        toGridCoord(std::max(start.X, end.X) + query_margin - bounding_box_.min_.X),
+        toGridCoord(std::min(start.Y, end.Y) - query_margin - bounding_box_.min_.Y),
+        toGridCoord(std::max(start.Y, end.Y) + query_margin - bounding_box_.min_.Y),
+        [&](const size_t segment_idx)
+        {
+            float t, u;
+            if (LinearAlg2D::segmentSegmentIntersection(start, end, segments_[segment_idx].start, segments_[segment_idx].end, t, u))
+            {
+                hits.emplace_back(segment_idx, t);
+            }
+            return false;
+        });
+    std::sort(hits.begin(), hits.end());
+    result.reserve(hits.size());
+    for (const auto& [segment_idx, t] : hits)
+    {
+        result.push_back(t);
+    }
+    return result;
+}
+
+bool SegmentIndexedShape::collidesWithLineSegment(const Point2LL& start, const Point2LL& end) const
+{
+    if (segments_.empty() || end == start)
+    {
+        return false; // Zero-length line segments never collide.
+    }
+
+    const PointMatrix transformation_matrix = PointMatrix(end - start);
+    const Point2LL transformed_start = transformation_matrix.apply(start);
+    const Point2LL transformed_end = transformation_matrix.apply(end);
+    return anySegmentInCells(
+        toGridCoord(std::min(start.X, end.X) - query_margin - bounding_box_.min_.X),
+        toGridCoord(std::max(start.X, end.X) + query_margin - bounding_box_.min_.X),
+        toGridCoord(std::min(start.Y, end.Y) - query_margin - bounding_box_.min_.Y),
+        toGridCoord(std::max(start.Y, end.Y) + query_margin - bounding_box_.min_.Y),
+        [&](const size_t segment_idx)
+        {
+            return LinearAlg2D::lineSegmentsCollide(
+                transformed_start,
+                transformed_end,
+                transformation_matrix.apply(segments_[segment_idx].start),
+                transformation_matrix.apply(segments_[segment_idx].end));
+        });
+}
+
+coord_t SegmentIndexedShape::toGridCoord(const coord_t offset) const
+{
+    // Round towards negative infinity, for queries outside of the grid.
+    return offset >= 0 ? offset / cell_size_ : -((-offset + cell_size_ - 1) / cell_size_);
+}
+
+} // namespace cura
@@ -4,9 +4,11 @@
 #include "geometry/Shape.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <mapbox/geometry/wagyu/wagyu.hpp>
 #include <numeric>
+#include <span>
 #include <unordered_set>
 
 #ifdef BUILD_TESTS
@@ -25,6 +27,7 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/sliding.hpp>
 
+#include "Application.h"
 #include "geometry/MixedLinesSet.h"
 #include "geometry/OpenLinesSet.h"
 #include "geometry/PartsView.h"
@@ -32,11 +35,58 @@
 #include "geometry/SingleShape.h"
 #include "settings/types/Ratio.h"
 #include "utils/OpenPolylineStitcher.h"
+#include "utils/ThreadPool.h"
 #include "utils/linearAlg2D.h"
+#include "utils/math.h"
 
 namespace cura
 {
 
+namespace
+{
+
+//! The number of shapes that Shape::unionShapes() unions in one Clipper pass, which is also the branching factor of its reduction tree
+constexpr size_t shapes_per_union_pass = 8;
+
+/*!
+ * Reduce \p shapes to a single shape, level by level. Each level replaces every batch of \p batch_size consecutive shapes by
+ * the result of \p reduce_batch. The batches of a level are independent, so they are reduced in parallel.
+ */
+template<typename ReduceBatch>
+Shape reduceShapes(std::vector<Shape>& shapes, const size_t batch_size, const ReduceBatch& reduce_batch)
+{
+    assert(! shapes.empty() && batch_size > 1);
+    do
+    {
+        const size_t batch_count = round_up_divide(shapes.size(), batch_size);
+        const auto reduce = [&](const size_t batch_idx)
+        {
+            const size_t first = batch_idx * batch_size;
+            const size_t count = std::min(batch_size, shapes.size() - first);
+            shapes[first] = reduce_batch(std::span<Shape>(shapes).subspan(first, count));
+        };
+        if (batch_count > 1 && Application::getInstance().thread_pool_ != nullptr)
+        {
+            parallel_for(size_t(0), batch_count, reduce);
+        }
+        else
+        {
+            for (size_t batch_idx = 0; batch_idx < batch_count; batch_idx++)
+            {
+                reduce(batch_idx);
+            }
+        }
+        for (size_t batch_idx = 1; batch_idx < batch_count; batch_idx++)
+        {
+            shapes[batch_idx] = std::move(shapes[batch_idx * batch_size]);
+        }
+        shapes.resize(batch_count);
+    } while (shapes.size() > 1);
+    return std::move(shapes.front());
+}
+
+} // namespace
+
 Shape::Shape(ClipperLib::Paths&& paths, bool explicitely_closed)
 {
     emplace_back(std::move(paths), explicitely_closed);
@@ -209,6 +259,61 @@ Shape Shape::intersection(const Shape& other) const
     return Shape{ std::move(ret) };
 }
 
+Shape Shape::unionShapes(std::vector<Shape>&& shapes, ClipperLib::PolyFillType fill_type)
+{
+    std::erase_if(
+        shapes,
+        [](const Shape& shape)
+        {
+            return shape.empty();
+        });
+    if (shapes.empty())
+    {
+        return {};
+    }
+    return reduceShapes(
+        shapes,
+        shapes_per_union_pass,
+        [fill_type](std::span<Shape> batch)
+        {
+            ClipperLib::Paths ret;
+            ClipperLib::Clipper clipper(clipper_init);
+            for (const Shape& shape : batch)
+            {
+                shape.addPaths(clipper, ClipperLib::ptSubject);
+            }
+            clipper.Execute(ClipperLib::ctUnion, ret, fill_type, fill_type);
+            return Shape{ std::move(ret) };
+        });
+}
+
+Shape Shape::intersectionShapes(std::vector<Shape>&& shapes)
+{
+    if (shapes.empty()
+        || std::ranges::any_of(
+            shapes,
+            [](const Shape& shape)
+            {
+                return shape.empty();
+            }))
+    {
+        return {};
+    }
+    // Clipper only intersects a subject with a clip, so the tree is binary.
+    constexpr size_t shapes_per_intersection = 2;
+    return reduceShapes(
+        shapes,
+        shapes_per_intersection,
+        [](std::span<Shape> batch) -> Shape
+        {
+            if (batch.size() == 1)
+            {
+                return std::move(batch.front());
+            }
+            return batch[0].intersection(batch[1]);
+        });
+}
+
 Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const
 {
     if (empty())
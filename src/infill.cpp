@@ -6,6 +6,7 @@
 #include <algorithm> //For std::sort.
 #include <functional>
 #include <numbers>
+#include <span>
 #include <unordered_set>
 
 #include <range/v3/numeric/accumulate.hpp>
@@ -301,8 +302,8 @@ void Infill::generateForIsland(
     if (line_distance_ == 0)
         return;
 
-    // Stores the infill lines (a vector) for each line of a polygon (a vector) for each polygon in a Polygons object that we create a zig-zaggified infill pattern for.
-    std::vector<std::vector<std::vector<InfillLineSegment*>>> crossings_on_line;
+    // Stores the infill lines that cross each line of each polygon of the outline that we create a zig-zaggified infill pattern for.
+    CrossingsOnLine crossings_on_line;
 
     switch (pattern_)
     {
@@ -521,13 +522,13 @@ void Infill::generateConcentricInfill(const Shape& outline, std::vector<Variable
     }
 }
 
-void Infill::generateGridInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateGridInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     generateLineInfill(outline, result, line_distance_, fill_angle_, 0, crossings_on_line);
     generateLineInfill(outline, result, line_distance_, fill_angle_ + 90, 0, crossings_on_line);
 }
 
-void Infill::generateCubicInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateCubicInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     const coord_t shift = one_over_sqrt_2 * z_;
     generateLineInfill(outline, result, line_distance_, fill_angle_, shift, crossings_on_line);
@@ -535,13 +536,13 @@ void Infill::generateCubicInfill(const Shape& outline, OpenLinesSet& result, std
     generateLineInfill(outline, result, line_distance_, fill_angle_ + 240, shift, crossings_on_line);
 }
 
-void Infill::generateTetrahedralInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateTetrahedralInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     generateHalfTetrahedralInfill(outline, 0.0, 0, result, crossings_on_line);
     generateHalfTetrahedralInfill(outline, 0.0, 90, result, crossings_on_line);
 }
 
-void Infill::generateQuarterCubicInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateQuarterCubicInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     generateHalfTetrahedralInfill(outline, 0.0, 0, result, crossings_on_line);
     generateHalfTetrahedralInfill(outline, 0.5, 90, result, crossings_on_line);
@@ -552,7 +553,7 @@ void Infill::generateHalfTetrahedralInfill(
     double pattern_z_shift,
     int angle_shift,
     OpenLinesSet& result,
-    std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+    CrossingsOnLine& crossings_on_line)
 {
     const coord_t period = line_distance_ * 2;
     coord_t shift = coord_t(one_over_sqrt_2 * (z_ + pattern_z_shift * period * 2)) % period;
@@ -563,14 +564,14 @@ void Infill::generateHalfTetrahedralInfill(
     generateLineInfill(outline, result, period, fill_angle_ + angle_shift, -shift, crossings_on_line);
 }
 
-void Infill::generateTriangleInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateTriangleInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     generateLineInfill(outline, result, line_distance_, fill_angle_, 0, crossings_on_line);
     generateLineInfill(outline, result, line_distance_, fill_angle_ + 60, 0, crossings_on_line);
     generateLineInfill(outline, result, line_distance_, fill_angle_ + 120, 0, crossings_on_line);
 }
 
-void Infill::generateTrihexagonInfill(const Shape& outline, OpenLinesSet& result, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::generateTrihexagonInfill(const Shape& outline, OpenLinesSet& result, CrossingsOnLine& crossings_on_line)
 {
     generateLineInfill(outline, result, line_distance_, fill_angle_, 0, crossings_on_line);
     generateLineInfill(outline, result, line_distance_, fill_angle_ + 60, 0, crossings_on_line);
@@ -658,7 +659,7 @@ void Infill::generateLineInfill(
     int line_distance,
     const double& infill_rotation,
     coord_t shift,
-    std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+    CrossingsOnLine& crossings_on_line)
 {
     shift += getShiftOffsetFromInfillOriginAndRotation(infill_rotation);
     PointMatrix rotation_matrix(infill_rotation);
@@ -673,7 +674,7 @@ void Infill::generateZigZagInfill(
     OpenLinesSet& result,
     const coord_t line_distance,
     const double& infill_rotation,
-    std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+    CrossingsOnLine& crossings_on_line)
 {
     const coord_t shift = getShiftOffsetFromInfillOriginAndRotation(infill_rotation);
 
@@ -713,7 +714,7 @@ void Infill::generateLinearBasedInfill(
     ZigzagConnectorProcessor& zigzag_connector_processor,
     const bool connected_zigzags,
     coord_t extra_shift,
-    std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+    CrossingsOnLine& crossings_on_line)
 {
     if (line_distance == 0 || outline.empty()) // No infill to generate (0% density) or no area to generate it in.
     {
@@ -764,18 +765,10 @@ void Infill::generateLinearBasedInfill(
     const int min_scanline_index = computeScanSegmentIdx(boundary.min_.X - shift, line_distance) + 1;
     const int max_scanline_index = computeScanSegmentIdx(boundary.max_.X - shift, line_distance) + 1;
     crossings_per_scanline.resize(max_scanline_index - min_scanline_index);
-    if (connect_lines_)
-    {
-        crossings_on_line.resize(transformed_outline.size()); // One for each polygon.
-    }
 
     for (size_t poly_idx = 0; poly_idx < transformed_outline.size(); poly_idx++)
     {
         const Polygon& poly = transformed_outline[poly_idx];
-        if (connect_lines_)
-        {
-            crossings_on_line[poly_idx].resize(poly.size()); // One for each line in this polygon.
-        }
         Point2LL p0 = poly.back();
         zigzag_connector_processor.registerVertex(p0); // always adds the first point to ZigzagConnectorProcessorEndPieces::first_zigzag_connector when using a zigzag infill type
 
@@ -847,11 +840,11 @@ void Infill::generateLinearBasedInfill(
                 {
                     continue;
                 }
-                InfillLineSegment* new_segment
-                    = new InfillLineSegment(unrotated_first, first.vertex_index_, first.polygon_index_, unrotated_second, second.vertex_index_, second.polygon_index_);
+                InfillLineSegment* new_segment = crossings_on_line
+                                                     .createSegment(unrotated_first, first.vertex_index_, first.polygon_index_, unrotated_second, second.vertex_index_, second.polygon_index_);
                 // Put the same line segment in the data structure twice: Once for each of the polygon line segment that it crosses.
-                crossings_on_line[first.polygon_index_][first.vertex_index_].push_back(new_segment);
-                crossings_on_line[second.polygon_index_][second.vertex_index_].push_back(new_segment);
+                crossings_on_line.addCrossing(first.polygon_index_, first.vertex_index_, new_segment);
+                crossings_on_line.addCrossing(second.polygon_index_, second.vertex_index_, new_segment);
             }
         }
     }
@@ -921,20 +914,16 @@ void Infill::resolveIntersection(const coord_t at_distance, const Point2LL& inte
     }
 }
 
-void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std::vector<std::vector<std::vector<InfillLineSegment*>>>& crossings_on_line)
+void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, CrossingsOnLine& crossings_on_line)
 {
+    crossings_on_line.groupBySegment(outline);
+
     UnionFind<InfillLineSegment*> connected_lines; // Keeps track of which lines are connected to which.
-    for (const std::vector<std::vector<InfillLineSegment*>>& crossings_on_polygon : crossings_on_line)
+    for (InfillLineSegment* infill_line : crossings_on_line.getAllCrossings())
     {
-        for (const std::vector<InfillLineSegment*>& crossings_on_polygon_segment : crossings_on_polygon)
+        if (connected_lines.find(infill_line) == (size_t)-1)
         {
-            for (InfillLineSegment* infill_line : crossings_on_polygon_segment)
-            {
-                if (connected_lines.find(infill_line) == (size_t)-1)
-                {
-                    connected_lines.add(infill_line); // Put every line in there as a separate set.
-                }
-            }
+            connected_lines.add(infill_line); // Put every line in there as a separate set.
         }
     }
 
@@ -946,15 +935,12 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
         {
             continue;
         }
-        assert(crossings_on_line.size() > polygon_index && "crossings dimension should be bigger then polygon index");
-        std::vector<std::vector<InfillLineSegment*>>& crossings_on_polygon = crossings_on_line[polygon_index];
         InfillLineSegment* previous_crossing = nullptr; // The crossing that we should connect to. If nullptr, we have been skipping until we find the next crossing.
         InfillLineSegment* previous_segment = nullptr; // The last segment we were connecting while drawing a line along the border.
         Point2LL vertex_before = inner_contour_polygon.back();
         for (size_t vertex_index = 0; vertex_index < inner_contour_polygon.size(); vertex_index++)
         {
-            assert(crossings_on_polygon.size() > vertex_index && "crossings on line for the current polygon should be bigger then vertex index");
-            std::vector<InfillLineSegment*>& crossings_on_polygon_segment = crossings_on_polygon[vertex_index];
+            const std::span<InfillLineSegment*> crossings_on_polygon_segment = crossings_on_line.getCrossings(polygon_index, vertex_index);
             Point2LL vertex_after = inner_contour_polygon[vertex_index];
 
             // Sort crossings on every line by how far they are from their initial point.
@@ -1020,7 +1006,7 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
                         }
 
                         // A connecting line between them.
-                        new_segment = new InfillLineSegment(previous_point, vertex_index, polygon_index, next_point, vertex_index, polygon_index);
+                        new_segment = crossings_on_line.createSegment(previous_point, vertex_index, polygon_index, next_point, vertex_index, polygon_index);
                         new_segment->altered_start_ = previous_point;
                         new_segment->altered_end_ = next_point;
                         new_segment->previous_ = previous_segment;
@@ -1050,8 +1036,13 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
                 }
                 else
                 {
-                    new_segment
-                        = new InfillLineSegment(previous_side, vertex_index, polygon_index, vertex_after, (vertex_index + 1) % inner_contour_[polygon_index].size(), polygon_index);
+                    new_segment = crossings_on_line.createSegment(
+                        previous_side,
+                        vertex_index,
+                        polygon_index,
+                        vertex_after,
+                        (vertex_index + 1) % inner_contour_[polygon_index].size(),
+                        polygon_index);
                     (choose_side ? previous_segment->previous_ : previous_segment->next_) = new_segment;
                     new_segment->previous_ = previous_segment;
                     previous_segment = new_segment;
@@ -1059,7 +1050,6 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
             }
 
             vertex_before = vertex_after;
-            crossings_on_polygon_segment.clear();
         }
     }
 
@@ -1087,7 +1077,6 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
 
         // Now go along the linked list of infill lines and output the infill lines to the actual result.
         OpenPolyline& result_line = result_lines.newLine();
-        InfillLineSegment* old_line = current_infill_line;
         if (current_infill_line->previous_)
         {
             current_infill_line->swapDirection();
@@ -1095,10 +1084,8 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
         current_infill_line->appendTo(result_line);
         previous_vertex = current_infill_line->end_;
         current_infill_line = current_infill_line->next_;
-        delete old_line;
         while (current_infill_line)
         {
-            old_line = current_infill_line; // We'll delete this after we've traversed to the next line.
             if (previous_vertex != current_infill_line->start_)
             {
                 current_infill_line->swapDirection();
@@ -1108,7 +1095,6 @@ void Infill::connectLines(const Shape& outline, OpenLinesSet& result_lines, std:
             current_infill_line->appendTo(result_line, polyline_break);
             current_infill_line = current_infill_line->next_;
             previous_vertex = next_vertex;
-            delete old_line;
         }
 
         completed_groups.insert(group);
@@ -1138,6 +1124,68 @@ bool Infill::includeLines(const std::vector<VariableWidthLines>& toolpaths, cons
     return total_length >= minimum_line_length;
 }
 
+Infill::InfillLineSegment* Infill::CrossingsOnLine::createSegment(
+    const Point2LL start,
+    const size_t start_segment,
+    const size_t start_polygon,
+    const Point2LL end,
+    const size_t end_segment,
+    const size_t end_polygon)
+{
+    if (blocks_.empty() || blocks_.back().size() == blocks_.back().capacity())
+    {
+        const size_t block_size = blocks_.empty() ? first_block_size_ : blocks_.back().capacity() * 2;
+        blocks_.emplace_back().reserve(block_size);
+    }
+    return &blocks_.back().emplace_back(start, start_segment, start_polygon, end, end_segment, end_polygon);
+}
+
+void Infill::CrossingsOnLine::addCrossing(const size_t polygon_idx, const size_t vertex_idx, InfillLineSegment* segment)
+{
+    crossings_.push_back(Crossing{ polygon_idx, vertex_idx, segment });
+}
+
+void Infill::CrossingsOnLine::groupBySegment(const Shape& outline)
+{
+    polygon_starts_.resize(outline.size());
+    size_t segment_count = 0;
+    for (size_t polygon_idx = 0; polygon_idx < outline.size(); polygon_idx++)
+    {
+        polygon_starts_[polygon_idx] = segment_count;
+        segment_count += outline[polygon_idx].size();
+    }
+
+    // Counting sort, which keeps the crossings of each segment in the order in which they were added.
+    segment_starts_.assign(segment_count + 1, 0);
+    for (const Crossing& crossing : crossings_)
+    {
+        segment_starts_[polygon_starts_[crossing.polygon_idx_] + crossing.vertex_idx_ + 1]++;
+    }
+    for (size_t segment_idx = 0; segment_idx < segment_count; segment_idx++)
+    {
+        segment_starts_[segment_idx + 1] += segment_starts_[segment_idx];
+    }
+    grouped_crossings_.resize(crossings_.size());
+    std::vector<size_t> insert_positions(segment_starts_.begin(), segment_starts_.end() - 1);
+    for (const Crossing& crossing : crossings_)
+    {
+        grouped_crossings_[insert_positions[polygon_starts_[crossing.polygon_idx_] + crossing.vertex_idx_]++] = crossing.segment_;
+    }
+}
+
+std::span<Infill::InfillLineSegment* const> Infill::CrossingsOnLine::getAllCrossings() const
+{
+    return grouped_crossings_;
+}
+
+std::span<Infill::InfillLineSegment*> Infill::CrossingsOnLine::getCrossings(const size_t polygon_idx, const size_t vertex_idx)
+{
+    assert(polygon_idx < polygon_starts_.size() && "crossings should be grouped for all polygons of the outline");
+    const size_t segment_idx = polygon_starts_[polygon_idx] + vertex_idx;
+    assert(segment_idx + 1 < segment_starts_.size() && "crossings should be grouped for all segments of the polygon");
+    return std::span<InfillLineSegment*>(grouped_crossings_).subspan(segment_starts_[segment_idx], segment_starts_[segment_idx + 1] - segment_starts_[segment_idx]);
+}
+
 bool Infill::InfillLineSegment::operator==(const InfillLineSegment& other) const
 {
     return start_ == other.start_ && end_ == other.end_;
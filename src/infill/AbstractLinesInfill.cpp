@@ -33,7 +33,7 @@ void AbstractLinesInfill::generateInfill(
         rotated_outline.applyMatrix(rotation_matrix);
     }
 
-    const OpenLinesSet raw_lines = generateParallelLines(line_distance, AABB(rotated_outline), z, line_width);
+    const OpenLinesSet raw_lines = generateParallelLines(line_distance, rotated_outline, AABB(rotated_outline), z, line_width);
     const OpenLinesSet fit_lines = fitLines(raw_lines, zig_zaggify, rotated_outline);
     OpenPolylineStitcher::stitch(fit_lines, result_polylines, result_polygons, line_width);
 
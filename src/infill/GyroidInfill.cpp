@@ -3,103 +3,178 @@
 
 #include "infill/GyroidInfill.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numbers>
+#include <vector>
 
 #include "geometry/OpenLinesSet.h"
+#include "geometry/Polygon.h"
 #include "geometry/Shape.h"
 #include "utils/AABB.h"
 
 namespace cura
 {
 
-OpenLinesSet GyroidInfill::generateParallelLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z, const coord_t line_width) const
+OpenLinesSet GyroidInfill::generateParallelLines(const coord_t line_distance, const Shape& outline, const AABB& bounding_box, const coord_t z, const coord_t line_width) const
 {
     // generate infill based on the gyroid equation: sin_x * cos_y + sin_y * cos_z + sin_z * cos_x = 0
     // kudos to the author of the Slic3r implementation equation code, the equation code here is based on that
 
-    int pitch = line_distance * 2.41; // this produces similar density to the "line" infill pattern
-    int num_steps = 4;
-    int step = pitch / num_steps;
-    while (step > 500 && num_steps < 16)
+    coord_t pitch = line_distance * 2.41; // this produces similar density to the "line" infill pattern
+    coord_t num_steps = 4;
+    coord_t step = pitch / num_steps;
+    while (step > 500 && num_steps < static_cast<coord_t>(max_num_steps))
     {
         num_steps *= 2;
         step = pitch / num_steps;
     }
     pitch = step * num_steps; // recalculate to avoid precision errors
-    const double z_rads = 2 * std::numbers::pi * z / pitch;
-    const double cos_z = std::cos(z_rads);
-    const double sin_z = std::sin(z_rads);
-    std::vector<coord_t> odd_line_coords;
-    std::vector<coord_t> even_line_coords;
-    OpenLinesSet result;
-    if (std::abs(sin_z) <= std::abs(cos_z))
+    if (step <= 0)
     {
-        // "vertical" lines
-        const double phase_offset = ((cos_z < 0) ? std::numbers::pi : 0) + std::numbers::pi;
-        for (coord_t y = 0; y < pitch; y += step)
-        {
-            const double y_rads = 2 * std::numbers::pi * y / pitch;
-            const double a = cos_z;
-            const double b = std::sin(y_rads + phase_offset);
-            const double odd_c = sin_z * std::cos(y_rads + phase_offset);
-            const double even_c = sin_z * std::cos(y_rads + phase_offset + std::numbers::pi);
-            const double h = std::sqrt(a * a + b * b);
-            const double odd_x_rads = ((h != 0) ? std::asin(odd_c / h) + std::asin(b / h) : 0) - std::numbers::pi / 2;
-            const double even_x_rads = ((h != 0) ? std::asin(even_c / h) + std::asin(b / h) : 0) - std::numbers::pi / 2;
-            odd_line_coords.push_back(odd_x_rads / std::numbers::pi * pitch);
-            even_line_coords.push_back(even_x_rads / std::numbers::pi * pitch);
-        }
-        const unsigned num_coords = odd_line_coords.size();
-        unsigned num_columns = 0;
-        for (coord_t x = (std::floor(bounding_box.min_.X / pitch) - 2.25) * pitch; x <= bounding_box.max_.X + pitch / 2; x += pitch / 2)
+        return {};
+    }
+    // The shape of the lines is the same for every line and every pitch along it, so it is computed once for this layer.
+    const LineCoordinates coordinates = computeLineCoordinates(pitch, step, z);
+
+    // The "vertical" lines run along the Y axis and lie next to each other along the X axis, the "horizontal" lines the other way around. Below, "along" is the direction of the
+    // lines and "across" the direction in which they lie next to each other.
+    const bool vertical = coordinates.vertical;
+    const auto across = [vertical](const Point2LL& point)
+    {
+        return vertical ? point.X : point.Y;
+    };
+    const auto along = [vertical](const Point2LL& point)
+    {
+        return vertical ? point.Y : point.X;
+    };
+    const coord_t line_spacing = pitch / 2;
+    const coord_t across_offset = vertical ? pitch : 0;
+    const coord_t first_across = vertical ? (std::floor(bounding_box.min_.X / pitch) - 2.25) * pitch : (std::floor(bounding_box.min_.Y / pitch) - 1) * pitch;
+    const coord_t last_across = across(bounding_box.max_) + pitch / 2;
+    const coord_t first_along = (std::floor(along(bounding_box.min_) / pitch) - 1) * pitch;
+    const coord_t last_along = along(bounding_box.max_) + pitch;
+    if (first_across > last_across || first_along > last_along)
+    {
+        return {};
+    }
+    const coord_t num_lines = (last_across - first_across) / line_spacing + 1;
+    const coord_t num_pitches = (last_along - first_along) / pitch + 1;
+
+    const auto floor_div = [](const coord_t numerator, const coord_t denominator)
+    {
+        return numerator / denominator - (numerator % denominator < 0 ? 1 : 0);
+    };
+
+    // Find the range along each line in which it can be inside the outline. A line only deviates from its position across by a limited amount, so only the outline within that
+    // band can be crossed by it. Any part of the line beyond the outline segments in that band is outside of the outline.
+    coord_t min_offset = std::numeric_limits<coord_t>::max();
+    coord_t max_offset = std::numeric_limits<coord_t>::lowest();
+    for (size_t i = 0; i < coordinates.num_coords; ++i)
+    {
+        min_offset = std::min({ min_offset, coordinates.odd_line_coords[i] / 2, coordinates.even_line_coords[i] / 2 });
+        max_offset = std::max({ max_offset, coordinates.odd_line_coords[i] / 2, coordinates.even_line_coords[i] / 2 });
+    }
+    std::vector<coord_t> span_min(num_lines, std::numeric_limits<coord_t>::max());
+    std::vector<coord_t> span_max(num_lines, std::numeric_limits<coord_t>::lowest());
+    for (const Polygon& polygon : outline)
+    {
+        for (auto iterator = polygon.beginSegments(); iterator != polygon.endSegments(); ++iterator)
         {
-            OpenPolyline line;
-            for (coord_t y = (std::floor(bounding_box.min_.Y / pitch) - 1) * pitch; y <= bounding_box.max_.Y + pitch; y += pitch)
+            const Point2LL& start = (*iterator).start;
+            const Point2LL& end = (*iterator).end;
+            const coord_t segment_min_across = std::min(across(start), across(end));
+            const coord_t segment_max_across = std::max(across(start), across(end));
+            const coord_t first_line = std::max(-floor_div(first_across + across_offset + max_offset - segment_min_across, line_spacing), coord_t(0));
+            const coord_t last_line = std::min(floor_div(segment_max_across - first_across - across_offset - min_offset, line_spacing), num_lines - 1);
+            for (coord_t line_idx = first_line; line_idx <= last_line; ++line_idx)
             {
-                for (unsigned i = 0; i < num_coords; ++i)
-                {
-                    line.push_back(Point2LL(x + ((num_columns & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2 + pitch, y + (coord_t)(i * step)));
-                }
+                span_min[line_idx] = std::min({ span_min[line_idx], along(start), along(end) });
+                span_max[line_idx] = std::max({ span_max[line_idx], along(start), along(end) });
             }
-            result.push_back(line);
-            ++num_columns;
         }
     }
-    else
+
+    OpenLinesSet result;
+    for (coord_t line_idx = 0; line_idx < num_lines; ++line_idx)
     {
-        // "horizontal" lines
-        const double phase_offset = (sin_z < 0) ? std::numbers::pi : 0;
-        for (coord_t x = 0; x < pitch; x += step)
+        if (span_min[line_idx] > span_max[line_idx])
         {
-            const double x_rads = 2 * std::numbers::pi * x / pitch;
-            const double a = sin_z;
-            const double b = std::cos(x_rads + phase_offset);
-            const double odd_c = cos_z * std::sin(x_rads + phase_offset + std::numbers::pi);
-            const double even_c = cos_z * std::sin(x_rads + phase_offset);
-            const double h = std::sqrt(a * a + b * b);
-            const double odd_y_rads = ((h != 0) ? std::asin(odd_c / h) + std::asin(b / h) : 0) + std::numbers::pi / 2;
-            const double even_y_rads = ((h != 0) ? std::asin(even_c / h) + std::asin(b / h) : 0) + std::numbers::pi / 2;
-            odd_line_coords.push_back(odd_y_rads / std::numbers::pi * pitch);
-            even_line_coords.push_back(even_y_rads / std::numbers::pi * pitch);
+            continue; // This line doesn't get near the outline.
         }
-        const unsigned num_coords = odd_line_coords.size();
-        unsigned num_rows = 0;
-        for (coord_t y = (std::floor(bounding_box.min_.Y / pitch) - 1) * pitch; y <= bounding_box.max_.Y + pitch / 2; y += pitch / 2)
+        // Start at a pitch of which the first point lies before the span, and end with one of which the first point lies beyond it, so that the line ends outside of the outline.
+        const coord_t first_pitch = std::max(floor_div(span_min[line_idx] - 1 - first_along, pitch), coord_t(0));
+        const coord_t last_pitch = std::min(floor_div(span_max[line_idx] - first_along, pitch) + 1, num_pitches - 1);
+        const coord_t line_across = first_across + line_idx * line_spacing + across_offset;
+        const std::array<coord_t, max_num_steps>& line_coords = (line_idx & 1) ? coordinates.odd_line_coords : coordinates.even_line_coords;
+
+        OpenPolyline line;
+        line.reserve((last_pitch - first_pitch + 1) * coordinates.num_coords);
+        for (coord_t pitch_idx = first_pitch; pitch_idx <= last_pitch; ++pitch_idx)
         {
-            OpenPolyline line;
-            for (coord_t x = (std::floor(bounding_box.min_.X / pitch) - 1) * pitch; x <= bounding_box.max_.X + pitch; x += pitch)
+            const coord_t pitch_along = first_along + pitch_idx * pitch;
+            for (size_t i = 0; i < coordinates.num_coords; ++i)
             {
-                for (unsigned i = 0; i < num_coords; ++i)
-                {
-                    line.push_back(Point2LL(x + (coord_t)(i * step), y + ((num_rows & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2));
-                }
+                const coord_t point_across = line_across + line_coords[i] / 2;
+                const coord_t point_along = pitch_along + static_cast<coord_t>(i) * step;
+                line.push_back(vertical ? Point2LL(point_across, point_along) : Point2LL(point_along, point_across));
             }
-            result.push_back(line);
-            ++num_rows;
         }
+        result.push_back(std::move(line));
     }
 
     return result;
 }
 
+GyroidInfill::LineCoordinates GyroidInfill::computeLineCoordinates(const coord_t pitch, const coord_t step, const coord_t z)
+{
+    const double z_rads = 2 * std::numbers::pi * z / pitch;
+    const double cos_z = std::cos(z_rads);
+    const double sin_z = std::sin(z_rads);
+
+    LineCoordinates result;
+    result.vertical = std::abs(sin_z) <= std::abs(cos_z);
+    result.num_coords = std::min(static_cast<size_t>(pitch / step), max_num_steps);
+    result.odd_line_coords.fill(0);
+    result.even_line_coords.fill(0);
+
+    // For the "vertical" lines:
+    //   b = sin(y_rads + phase_offset), odd_c = sin_z * cos(y_rads + phase_offset), even_c = -odd_c
+    //   x_rads = asin(c / h) + asin(b / h) - pi / 2
+    // For the "horizontal" lines:
+    //   b = cos(x_rads + phase_offset), even_c = cos_z * sin(x_rads + phase_offset), odd_c = -even_c
+    //   y_rads = asin(c / h) + asin(b / h) + pi / 2
+    const double a = result.vertical ? cos_z : sin_z;
+    const double phase_offset = result.vertical ? ((cos_z < 0) ? std::numbers::pi : 0) + std::numbers::pi : ((sin_z < 0) ? std::numbers::pi : 0);
+    const double odd_c_factor = result.vertical ? sin_z : -cos_z;
+    const double rads_offset = result.vertical ? -std::numbers::pi / 2 : std::numbers::pi / 2;
+
+    std::array<double, max_num_steps> b{};
+    std::array<double, max_num_steps> c{};
+    for (size_t i = 0; i < max_num_steps; ++i)
+    {
+        const double step_rads = 2 * std::numbers::pi * static_cast<coord_t>(i * step) / pitch + phase_offset;
+        b[i] = result.vertical ? std::sin(step_rads) : std::cos(step_rads);
+        c[i] = odd_c_factor * (result.vertical ? std::cos(step_rads) : std::sin(step_rads));
+    }
+
+    std::array<double, max_num_steps> odd_rads{};
+    std::array<double, max_num_steps> even_rads{};
+    for (size_t i = 0; i < max_num_steps; ++i)
+    {
+        const double h = std::sqrt(a * a + b[i] * b[i]);
+        const double b_rads = (h != 0) ? std::asin(b[i] / h) : 0;
+        odd_rads[i] = ((h != 0) ? std::asin(c[i] / h) + b_rads : 0) + rads_offset;
+        even_rads[i] = ((h != 0) ? std::asin(-c[i] / h) + b_rads : 0) + rads_offset;
+    }
+
+    for (size_t i = 0; i < result.num_coords; ++i)
+    {
+        result.odd_line_coords[i] = odd_rads[i] / std::numbers::pi * pitch;
+        result.even_line_coords[i] = even_rads[i] / std::numbers::pi * pitch;
+    }
+    return result;
+}
+
 } // namespace cura
@@ -6,10 +6,12 @@
 #include "Application.h"
 #include "ExtruderTrain.h"
 #include "Slice.h"
+#include "infill/LightningDistanceField.h"
 #include "infill/LightningLayer.h"
 #include "infill/LightningTreeNode.h"
 #include "sliceDataStorage.h"
 #include "utils/SparsePointGridInclusive.h"
+#include "utils/ThreadPool.h"
 #include "utils/linearAlg2D.h"
 
 /* Possible future tasks/optimizations,etc.:
@@ -90,23 +92,22 @@ LightningGenerator::LightningGenerator(const SupportStorage& support)
     generate(layer_thickness, infill_line_width, infill_wall_thickness, line_distance, overhang_angle, prune_angle, straightening_angle, areas_per_layer);
 }
 
-void LightningGenerator::generateInitialInternalOverhangs(const coord_t infill_wall_thickness, const std::vector<Shape>& shape_per_layer)
+void LightningGenerator::generateInitialInternalOverhangs(const std::vector<Shape>& infill_outlines)
 {
-    overhang_per_layer.resize(shape_per_layer.size());
-    const coord_t infill_wall_offset = -infill_wall_thickness;
-
-    Shape infill_area_above;
-    // Iterate from top to bottom, to subtract the overhang areas above from the overhang areas on the layer below, to get only overhang in the top layer where it is overhanging.
-    for (const auto& [layer_nr, layer_shape] : shape_per_layer | ranges::views::enumerate | ranges::views::reverse)
-    {
-        Shape infill_area_here = layer_shape.offset(infill_wall_offset);
-
-        // Remove the part of the infill area that is already supported by the walls.
-        Shape overhang = infill_area_here.offset(-wall_supporting_radius).difference(infill_area_above);
+    overhang_per_layer.resize(infill_outlines.size());
+    const Shape no_infill_area_above;
+
+    // Subtract the infill area above from the infill area on each layer, to get only overhang in the top layer where it is overhanging.
+    cura::parallel_for<size_t>(
+        0,
+        infill_outlines.size(),
+        [&](const size_t layer_nr)
+        {
+            const Shape& infill_area_above = layer_nr + 1 < infill_outlines.size() ? infill_outlines[layer_nr + 1] : no_infill_area_above;
 
-        overhang_per_layer[layer_nr] = overhang;
-        infill_area_above = std::move(infill_area_here);
-    }
+            // Remove the part of the infill area that is already supported by the walls.
+            overhang_per_layer[layer_nr] = infill_outlines[layer_nr].offset(-wall_supporting_radius).difference(infill_area_above);
+        });
 }
 
 const LightningLayer& LightningGenerator::getTreesForLayer(const size_t& layer_id) const
@@ -130,55 +131,104 @@ void LightningGenerator::generate(
     prune_length = layer_thickness * std::tan(prune_angle);
     straightening_max_distance = layer_thickness * std::tan(straightening_angle);
 
-    generateInitialInternalOverhangs(wall_thickness, shape_per_layer);
-    generateTrees(wall_thickness, shape_per_layer);
+    std::vector<Shape> infill_outlines(shape_per_layer.size());
+    cura::parallel_for<size_t>(
+        0,
+        shape_per_layer.size(),
+        [&](const size_t layer_nr)
+        {
+            infill_outlines[layer_nr] = shape_per_layer[layer_nr].offset(-wall_thickness);
+        });
+
+    generateInitialInternalOverhangs(infill_outlines);
+    generateTrees(infill_outlines);
 }
 
-void LightningGenerator::generateTrees(const coord_t infill_wall_thickness, const std::vector<Shape>& shape_per_layer)
+void LightningGenerator::generateTrees(const std::vector<Shape>& infill_outlines)
 {
-    lightning_layers.resize(shape_per_layer.size());
-    const coord_t infill_wall_offset = -infill_wall_thickness;
-
-    std::vector<Shape> infill_outlines;
-    infill_outlines.insert(infill_outlines.end(), shape_per_layer.size(), Shape());
-
-    // For-each layer from top to bottom:
-    for (const auto& [layer_nr, layer_shape] : shape_per_layer | ranges::views::enumerate | ranges::views::reverse)
+    lightning_layers.resize(infill_outlines.size());
+    if (infill_outlines.empty())
     {
-        infill_outlines[layer_nr].push_back(layer_shape.offset(infill_wall_offset));
+        return;
     }
 
-    // For various operations its beneficial to quickly locate nearby features on the polygon:
-    const size_t top_layer_id = shape_per_layer.size() - 1;
-    auto outlines_locator_ptr = PolygonUtils::createLocToLineGrid(infill_outlines[top_layer_id], locator_cell_size);
+    // For various operations its beneficial to quickly locate nearby features on the polygon. These locators and the distance fields don't depend on the trees, so they are
+    // created in parallel, for a batch of layers at a time to limit the memory they take.
+    std::vector<std::unique_ptr<LocToLineGrid>> outline_locators(infill_outlines.size());
+    std::vector<std::unique_ptr<LightningDistanceField>> distance_fields(infill_outlines.size());
+    const size_t batch_size = 2 * (Application::getInstance().thread_pool_->thread_count() + 1);
+    const auto prepare_layers_up_to = [&](const size_t top_layer_id)
+    {
+        if (outline_locators[top_layer_id])
+        {
+            return; // Already prepared with the batch of a layer above.
+        }
+        const size_t batch_start = top_layer_id + 1 > batch_size ? top_layer_id + 1 - batch_size : 0;
+        cura::parallel_for<size_t>(
+            batch_start,
+            top_layer_id + 1,
+            [&](const size_t layer_id)
+            {
+                outline_locators[layer_id] = PolygonUtils::createLocToLineGrid(infill_outlines[layer_id], locator_cell_size);
+                distance_fields[layer_id] = std::make_unique<LightningDistanceField>(supporting_radius, infill_outlines[layer_id], overhang_per_layer[layer_id]);
+            });
+    };
 
     // For-each layer from top to bottom:
-    for (int layer_id = top_layer_id; layer_id >= 0; layer_id--)
+    for (int layer_id = infill_outlines.size() - 1; layer_id >= 0; layer_id--)
     {
+        prepare_layers_up_to(layer_id);
         LightningLayer& current_lightning_layer = lightning_layers[layer_id];
-        Shape& current_outlines = infill_outlines[layer_id];
-        const auto& outlines_locator = *outlines_locator_ptr;
+        const Shape& current_outlines = infill_outlines[layer_id];
+        const LocToLineGrid& outlines_locator = *outline_locators[layer_id];
 
         // register all trees propagated from the previous layer as to-be-reconnected
-        std::vector<LightningTreeNodeSPtr> to_be_reconnected_tree_roots = current_lightning_layer.tree_roots;
+        std::vector<LightningTreeNodeIdx> to_be_reconnected_tree_roots = current_lightning_layer.tree_roots;
 
-        current_lightning_layer.generateNewTrees(overhang_per_layer[layer_id], current_outlines, outlines_locator, supporting_radius, wall_supporting_radius);
+        current_lightning_layer.generateNewTrees(*distance_fields[layer_id], current_outlines, outlines_locator, supporting_radius, wall_supporting_radius);
+        distance_fields[layer_id].reset();
 
         current_lightning_layer.reconnectRoots(to_be_reconnected_tree_roots, current_outlines, outlines_locator, supporting_radius, wall_supporting_radius);
+        outline_locators[layer_id].reset();
 
         // Initialize trees for next lower layer from the current one.
         if (layer_id == 0)
         {
             return;
         }
+        prepare_layers_up_to(layer_id - 1);
         const Shape& below_outlines = infill_outlines[layer_id - 1];
-        outlines_locator_ptr = PolygonUtils::createLocToLineGrid(below_outlines, locator_cell_size);
-        const auto& below_outlines_locator = *outlines_locator_ptr;
-
-        std::vector<LightningTreeNodeSPtr>& lower_trees = lightning_layers[layer_id - 1].tree_roots;
-        for (auto& tree : current_lightning_layer.tree_roots)
+        const LocToLineGrid& below_outlines_locator = *outline_locators[layer_id - 1];
+
+        // The trees are propagated independently of each other, each into a pool of its own, which are then joined in the order of the trees.
+        const std::vector<LightningTreeNodeIdx>& trees = current_lightning_layer.tree_roots;
+        std::vector<LightningTreeNodePool> propagated_nodes(trees.size());
+        std::vector<std::vector<LightningTreeNodeIdx>> propagated_trees(trees.size());
+        cura::parallel_for<size_t>(
+            0,
+            trees.size(),
+            [&](const size_t tree_idx)
+            {
+                current_lightning_layer.nodes.propagateToNextLayer(
+                    trees[tree_idx],
+                    propagated_nodes[tree_idx],
+                    propagated_trees[tree_idx],
+                    below_outlines,
+                    below_outlines_locator,
+                    prune_length,
+                    straightening_max_distance,
+                    locator_cell_size / 2);
+                propagated_nodes[tree_idx].compact(propagated_trees[tree_idx]); // Free the nodes that were pruned away.
+            });
+
+        LightningLayer& lower_lightning_layer = lightning_layers[layer_id - 1];
+        for (size_t tree_idx = 0; tree_idx < trees.size(); ++tree_idx)
         {
-            tree->propagateToNextLayer(lower_trees, below_outlines, below_outlines_locator, prune_length, straightening_max_distance, locator_cell_size / 2);
+            const LightningTreeNodeIdx offset = lower_lightning_layer.nodes.append(std::move(propagated_nodes[tree_idx]));
+            for (const LightningTreeNodeIdx tree : propagated_trees[tree_idx])
+            {
+                lower_lightning_layer.tree_roots.push_back(tree + offset);
+            }
         }
     }
 }
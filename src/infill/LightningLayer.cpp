@@ -19,11 +19,11 @@ coord_t LightningLayer::getWeightedDistance(const Point2LL& boundary_loc, const
     return vSize(boundary_loc - unsupported_location);
 }
 
-Point2LL GroundingLocation::p() const
+Point2LL GroundingLocation::p(const LightningTreeNodePool& nodes) const
 {
-    if (tree_node != nullptr)
+    if (tree_node != NO_INDEX)
     {
-        return tree_node->getLocation();
+        return nodes[tree_node].getLocation();
     }
     else
     {
@@ -34,25 +34,23 @@ Point2LL GroundingLocation::p() const
 
 void LightningLayer::fillLocator(SparseLightningTreeNodeGrid& tree_node_locator)
 {
-    std::function<void(LightningTreeNodeSPtr)> add_node_to_locator_func = [&tree_node_locator](LightningTreeNodeSPtr node)
+    std::function<void(LightningTreeNodeIdx)> add_node_to_locator_func = [this, &tree_node_locator](LightningTreeNodeIdx node)
     {
-        tree_node_locator.insert(node->getLocation(), node);
+        tree_node_locator.insert(nodes[node].getLocation(), node);
     };
-    for (auto& tree : tree_roots)
+    for (const LightningTreeNodeIdx tree : tree_roots)
     {
-        tree->visitNodes(add_node_to_locator_func);
+        nodes.visitNodes(tree, add_node_to_locator_func);
     }
 }
 
 void LightningLayer::generateNewTrees(
-    const Shape& current_overhang,
+    LightningDistanceField& distance_field,
     const Shape& current_outlines,
     const LocToLineGrid& outlines_locator,
     const coord_t supporting_radius,
     const coord_t wall_supporting_radius)
 {
-    LightningDistanceField distance_field(supporting_radius, current_outlines, current_overhang);
-
     SparseLightningTreeNodeGrid tree_node_locator(locator_cell_size);
     fillLocator(tree_node_locator);
 
@@ -64,17 +62,17 @@ void LightningLayer::generateNewTrees(
         GroundingLocation grounding_loc
             = getBestGroundingLocation(unsupported_location, current_outlines, outlines_locator, supporting_radius, wall_supporting_radius, tree_node_locator);
 
-        LightningTreeNodeSPtr new_parent;
-        LightningTreeNodeSPtr new_child;
+        LightningTreeNodeIdx new_parent = NO_INDEX;
+        LightningTreeNodeIdx new_child = NO_INDEX;
         attach(unsupported_location, grounding_loc, new_child, new_parent);
-        tree_node_locator.insert(new_child->getLocation(), new_child);
-        if (new_parent)
+        tree_node_locator.insert(nodes[new_child].getLocation(), new_child);
+        if (new_parent != NO_INDEX)
         {
-            tree_node_locator.insert(new_parent->getLocation(), new_parent);
+            tree_node_locator.insert(nodes[new_parent].getLocation(), new_parent);
         }
 
         // update distance field
-        distance_field.update(grounding_loc.p(), unsupported_location);
+        distance_field.update(grounding_loc.p(nodes), unsupported_location);
     }
 }
 
@@ -85,7 +83,7 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
     const coord_t supporting_radius,
     const coord_t wall_supporting_radius,
     const SparseLightningTreeNodeGrid& tree_node_locator,
-    const LightningTreeNodeSPtr& exclude_tree)
+    const LightningTreeNodeIdx exclude_tree)
 {
     ClosestPointPolygon cpp = PolygonUtils::findClosest(unsupported_location, current_outlines);
     Point2LL node_location = cpp.p();
@@ -93,18 +91,17 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
 
     PolygonsPointIndex dummy;
 
-    LightningTreeNodeSPtr sub_tree{ nullptr };
+    LightningTreeNodeIdx sub_tree = NO_INDEX;
     coord_t current_dist = getWeightedDistance(node_location, unsupported_location);
     if (current_dist >= wall_supporting_radius) // Only reconnect tree roots to other trees if they are not already close to the outlines.
     {
         auto candidate_trees = tree_node_locator.getNearbyVals(unsupported_location, std::min(current_dist, within_dist));
-        for (auto& candidate_wptr : candidate_trees)
+        for (const LightningTreeNodeIdx candidate_sub_tree : candidate_trees)
         {
-            auto candidate_sub_tree = candidate_wptr.lock();
-            if ((candidate_sub_tree && candidate_sub_tree != exclude_tree) && ! (exclude_tree && exclude_tree->hasOffspring(candidate_sub_tree))
-                && ! PolygonUtils::polygonCollidesWithLineSegment(unsupported_location, candidate_sub_tree->getLocation(), outline_locator, &dummy))
+            if (candidate_sub_tree != exclude_tree && ! (exclude_tree != NO_INDEX && nodes.hasOffspring(exclude_tree, candidate_sub_tree))
+                && ! PolygonUtils::polygonCollidesWithLineSegment(unsupported_location, nodes[candidate_sub_tree].getLocation(), outline_locator, &dummy))
             {
-                const coord_t candidate_dist = candidate_sub_tree->getWeightedDistance(unsupported_location, supporting_radius);
+                const coord_t candidate_dist = nodes.getWeightedDistance(candidate_sub_tree, unsupported_location, supporting_radius);
                 if (candidate_dist < current_dist)
                 {
                     current_dist = candidate_dist;
@@ -114,9 +111,9 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
         }
     }
 
-    if (! sub_tree)
+    if (sub_tree == NO_INDEX)
     {
-        return GroundingLocation{ nullptr, cpp };
+        return GroundingLocation{ NO_INDEX, cpp };
     }
     else
     {
@@ -124,25 +121,25 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
     }
 }
 
-bool LightningLayer::attach(const Point2LL& unsupported_location, const GroundingLocation& grounding_loc, LightningTreeNodeSPtr& new_child, LightningTreeNodeSPtr& new_root)
+bool LightningLayer::attach(const Point2LL& unsupported_location, const GroundingLocation& grounding_loc, LightningTreeNodeIdx& new_child, LightningTreeNodeIdx& new_root)
 {
     // Update trees & distance fields.
     if (grounding_loc.boundary_location)
     {
-        new_root = LightningTreeNode::create(grounding_loc.p(), std::make_optional(grounding_loc.p()));
-        new_child = new_root->addChild(unsupported_location);
+        new_root = nodes.create(grounding_loc.p(nodes), std::make_optional(grounding_loc.p(nodes)));
+        new_child = nodes.addChild(new_root, unsupported_location);
         tree_roots.push_back(new_root);
         return true;
     }
     else
     {
-        new_child = grounding_loc.tree_node->addChild(unsupported_location);
+        new_child = nodes.addChild(grounding_loc.tree_node, unsupported_location);
         return false;
     }
 }
 
 void LightningLayer::reconnectRoots(
-    std::vector<LightningTreeNodeSPtr>& to_be_reconnected_tree_roots,
+    std::vector<LightningTreeNodeIdx>& to_be_reconnected_tree_roots,
     const Shape& current_outlines,
     const LocToLineGrid& outline_locator,
     const coord_t supporting_radius,
@@ -154,24 +151,24 @@ void LightningLayer::reconnectRoots(
     fillLocator(tree_node_locator);
 
     const coord_t within_max_dist = outline_locator.getCellSize() * 2;
-    for (auto root_ptr : to_be_reconnected_tree_roots)
+    for (const LightningTreeNodeIdx root : to_be_reconnected_tree_roots)
     {
-        auto old_root_it = std::find(tree_roots.begin(), tree_roots.end(), root_ptr);
+        auto old_root_it = std::find(tree_roots.begin(), tree_roots.end(), root);
 
-        if (root_ptr->getLastGroundingLocation())
+        if (nodes[root].getLastGroundingLocation())
         {
-            const Point2LL& ground_loc = root_ptr->getLastGroundingLocation().value();
-            if (ground_loc != root_ptr->getLocation())
+            const Point2LL ground_loc = nodes[root].getLastGroundingLocation().value();
+            if (ground_loc != nodes[root].getLocation())
             {
                 Point2LL new_root_pt;
-                if (PolygonUtils::lineSegmentPolygonsIntersection(root_ptr->getLocation(), ground_loc, current_outlines, outline_locator, new_root_pt, within_max_dist))
+                if (PolygonUtils::lineSegmentPolygonsIntersection(nodes[root].getLocation(), ground_loc, current_outlines, outline_locator, new_root_pt, within_max_dist))
                 {
-                    auto new_root = LightningTreeNode::create(new_root_pt, new_root_pt);
-                    root_ptr->addChild(new_root);
-                    new_root->reroot();
+                    const LightningTreeNodeIdx new_root = nodes.create(new_root_pt, new_root_pt);
+                    nodes.addChild(root, new_root);
+                    nodes.reroot(new_root);
 
-                    tree_node_locator.insert(new_root->getLocation(), new_root);
-                    *old_root_it = std::move(new_root); // replace old root with new root
+                    tree_node_locator.insert(nodes[new_root].getLocation(), new_root);
+                    *old_root_it = new_root; // replace old root with new root
                     continue;
                 }
             }
@@ -180,34 +177,34 @@ void LightningLayer::reconnectRoots(
         const coord_t tree_connecting_ignore_width
             = wall_supporting_radius - tree_connecting_ignore_offset; // Ideally, the boundary size in which the valence rule is ignored would be configurable.
         GroundingLocation ground
-            = getBestGroundingLocation(root_ptr->getLocation(), current_outlines, outline_locator, supporting_radius, tree_connecting_ignore_width, tree_node_locator, root_ptr);
+            = getBestGroundingLocation(nodes[root].getLocation(), current_outlines, outline_locator, supporting_radius, tree_connecting_ignore_width, tree_node_locator, root);
         if (ground.boundary_location)
         {
-            if (ground.boundary_location.value().p() == root_ptr->getLocation())
+            if (ground.boundary_location.value().p() == nodes[root].getLocation())
             {
                 continue; // Already on the boundary.
             }
 
-            auto new_root = LightningTreeNode::create(ground.p(), ground.p());
-            auto attach_ptr = root_ptr->closestNode(new_root->getLocation());
-            attach_ptr->reroot();
+            const LightningTreeNodeIdx new_root = nodes.create(ground.p(nodes), ground.p(nodes));
+            const LightningTreeNodeIdx attach_node = nodes.closestNode(root, nodes[new_root].getLocation());
+            nodes.reroot(attach_node);
 
-            new_root->addChild(attach_ptr);
-            tree_node_locator.insert(new_root->getLocation(), new_root);
+            nodes.addChild(new_root, attach_node);
+            tree_node_locator.insert(nodes[new_root].getLocation(), new_root);
 
-            *old_root_it = std::move(new_root); // replace old root with new root
+            *old_root_it = new_root; // replace old root with new root
         }
         else
         {
-            assert(ground.tree_node);
-            assert(ground.tree_node != root_ptr);
-            assert(! root_ptr->hasOffspring(ground.tree_node));
-            assert(! ground.tree_node->hasOffspring(root_ptr));
+            assert(ground.tree_node != NO_INDEX);
+            assert(ground.tree_node != root);
+            assert(! nodes.hasOffspring(root, ground.tree_node));
+            assert(! nodes.hasOffspring(ground.tree_node, root));
 
-            auto attach_ptr = root_ptr->closestNode(ground.tree_node->getLocation());
-            attach_ptr->reroot();
+            const LightningTreeNodeIdx attach_node = nodes.closestNode(root, nodes[ground.tree_node].getLocation());
+            nodes.reroot(attach_node);
 
-            ground.tree_node->addChild(attach_ptr);
+            nodes.addChild(ground.tree_node, attach_node);
 
             // remove old root
             *old_root_it = std::move(tree_roots.back());
@@ -225,9 +222,9 @@ OpenLinesSet LightningLayer::convertToLines(const Shape& limit_to_outline, const
         return result_lines;
     }
 
-    for (const LightningTreeNodeSPtr& tree : tree_roots)
+    for (const LightningTreeNodeIdx tree : tree_roots)
     {
-        tree->convertToPolylines(result_lines, line_width);
+        nodes.convertToPolylines(tree, result_lines, line_width);
     }
     result_lines = limit_to_outline.intersection(result_lines);
 
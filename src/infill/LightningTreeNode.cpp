@@ -8,74 +8,148 @@
 
 using namespace cura;
 
-using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
+LightningTreeNode::LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location /*= std::nullopt*/)
+    : is_root_(true)
+    , p_(p)
+    , parent_(NO_INDEX)
+    , last_grounding_location_(last_grounding_location)
+{
+}
+
+const Point2LL& LightningTreeNode::getLocation() const
+{
+    return p_;
+}
+
+void LightningTreeNode::setLocation(const Point2LL& loc)
+{
+    p_ = loc;
+}
+
+const std::optional<Point2LL>& LightningTreeNode::getLastGroundingLocation() const
+{
+    return last_grounding_location_;
+}
+
+LightningTreeNodeIdx LightningTreeNodePool::create(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location)
+{
+    nodes_.emplace_back(p, last_grounding_location);
+    return nodes_.size() - 1;
+}
+
+const LightningTreeNode& LightningTreeNodePool::operator[](const LightningTreeNodeIdx node_idx) const
+{
+    assert(node_idx < nodes_.size());
+    return nodes_[node_idx];
+}
 
-coord_t LightningTreeNode::getWeightedDistance(const Point2LL& unsupported_location, const coord_t& supporting_radius) const
+size_t LightningTreeNodePool::size() const
+{
+    return nodes_.size();
+}
+
+LightningTreeNodeIdx LightningTreeNodePool::append(LightningTreeNodePool&& other)
+{
+    const LightningTreeNodeIdx offset = nodes_.size();
+    nodes_.reserve(nodes_.size() + other.nodes_.size());
+    for (LightningTreeNode& node : other.nodes_)
+    {
+        if (node.parent_ != NO_INDEX)
+        {
+            node.parent_ += offset;
+        }
+        for (LightningTreeNodeIdx& child : node.children_)
+        {
+            child += offset;
+        }
+        nodes_.push_back(std::move(node));
+    }
+    other.nodes_.clear();
+    return offset;
+}
+
+void LightningTreeNodePool::compact(std::vector<LightningTreeNodeIdx>& roots)
+{
+    std::vector<LightningTreeNode> kept_nodes;
+    for (LightningTreeNodeIdx& root : roots)
+    {
+        root = moveTree(root, NO_INDEX, kept_nodes);
+    }
+    nodes_ = std::move(kept_nodes);
+}
+
+LightningTreeNodeIdx LightningTreeNodePool::moveTree(const LightningTreeNodeIdx node, const LightningTreeNodeIdx parent, std::vector<LightningTreeNode>& target)
+{
+    const LightningTreeNodeIdx moved = target.size();
+    target.push_back(std::move(nodes_[node]));
+    target[moved].parent_ = parent;
+    for (size_t child_idx = 0; child_idx < target[moved].children_.size(); ++child_idx)
+    {
+        const LightningTreeNodeIdx child = moveTree(target[moved].children_[child_idx], moved, target); // Not by reference, target grows.
+        target[moved].children_[child_idx] = child;
+    }
+    return moved;
+}
+
+coord_t LightningTreeNodePool::getWeightedDistance(const LightningTreeNodeIdx node, const Point2LL& unsupported_location, const coord_t& supporting_radius) const
 {
     constexpr coord_t min_valence_for_boost = 0;
     constexpr coord_t max_valence_for_boost = 4;
     constexpr coord_t valence_boost_multiplier = 4;
 
-    const size_t valence = (! is_root_) + children_.size();
+    const LightningTreeNode& here = nodes_[node];
+    const size_t valence = (! here.is_root_) + here.children_.size();
     const coord_t valence_boost = (min_valence_for_boost < valence && valence < max_valence_for_boost) ? valence_boost_multiplier * supporting_radius : 0;
-    const coord_t dist_here = vSize(getLocation() - unsupported_location);
+    const coord_t dist_here = vSize(here.getLocation() - unsupported_location);
     return dist_here - valence_boost;
 }
 
-bool LightningTreeNode::hasOffspring(const LightningTreeNodeSPtr& to_be_checked) const
+bool LightningTreeNodePool::hasOffspring(const LightningTreeNodeIdx node, const LightningTreeNodeIdx to_be_checked) const
 {
-    if (to_be_checked == shared_from_this())
+    if (to_be_checked == node)
     {
         return true;
     }
-    for (auto& child_ptr : children_)
+    for (const LightningTreeNodeIdx child : nodes_[node].children_)
     {
-        if (child_ptr->hasOffspring(to_be_checked))
+        if (hasOffspring(child, to_be_checked))
             return true;
     }
     return false;
 }
 
-const Point2LL& LightningTreeNode::getLocation() const
+LightningTreeNodeIdx LightningTreeNodePool::addChild(const LightningTreeNodeIdx parent, const Point2LL& child_loc)
 {
-    return p_;
+    assert(nodes_[parent].p_ != child_loc);
+    const LightningTreeNodeIdx child = create(child_loc);
+    return addChild(parent, child);
 }
 
-void LightningTreeNode::setLocation(const Point2LL& loc)
+LightningTreeNodeIdx LightningTreeNodePool::addChild(const LightningTreeNodeIdx parent, const LightningTreeNodeIdx new_child)
 {
-    p_ = loc;
-}
-
-LightningTreeNodeSPtr LightningTreeNode::addChild(const Point2LL& child_loc)
-{
-    assert(p_ != child_loc);
-    LightningTreeNodeSPtr child = LightningTreeNode::create(child_loc);
-    return addChild(child);
-}
-
-LightningTreeNodeSPtr LightningTreeNode::addChild(LightningTreeNodeSPtr& new_child)
-{
-    assert(new_child != shared_from_this());
+    assert(new_child != parent);
     // assert(p != new_child->p); // NOTE: No problem for now. Issue to solve later. Maybe even afetr final. Low prio.
-    children_.push_back(new_child);
-    new_child->parent_ = shared_from_this();
-    new_child->is_root_ = false;
+    nodes_[parent].children_.push_back(new_child);
+    nodes_[new_child].parent_ = parent;
+    nodes_[new_child].is_root_ = false;
     return new_child;
 }
 
-void LightningTreeNode::propagateToNextLayer(
-    std::vector<LightningTreeNodeSPtr>& next_trees,
+void LightningTreeNodePool::propagateToNextLayer(
+    const LightningTreeNodeIdx node,
+    LightningTreeNodePool& next_nodes,
+    std::vector<LightningTreeNodeIdx>& next_trees,
     const Shape& next_outlines,
     const LocToLineGrid& outline_locator,
     const coord_t prune_distance,
     const coord_t smooth_magnitude,
     const coord_t max_remove_colinear_dist) const
 {
-    auto tree_below = deepCopy();
+    const LightningTreeNodeIdx tree_below = deepCopy(node, next_nodes);
 
-    tree_below->prune(prune_distance);
-    tree_below->straighten(smooth_magnitude, max_remove_colinear_dist);
-    if (tree_below->realign(next_outlines, outline_locator, next_trees))
+    next_nodes.prune(tree_below, prune_distance);
+    next_nodes.straighten(tree_below, smooth_magnitude, max_remove_colinear_dist);
+    if (next_nodes.realign(tree_below, next_outlines, outline_locator, next_trees))
     {
         next_trees.push_back(tree_below);
     }
@@ -83,83 +157,78 @@ void LightningTreeNode::propagateToNextLayer(
 
 // NOTE: Depth-first, as currently implemented.
 //       Skips the root (because that has no root itself), but all initial nodes will have the root point anyway.
-void LightningTreeNode::visitBranches(const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const
+void LightningTreeNodePool::visitBranches(const LightningTreeNodeIdx node, const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const
 {
-    for (const auto& node : children_)
+    for (const LightningTreeNodeIdx child : nodes_[node].children_)
     {
-        assert(node->parent_.lock() == shared_from_this());
-        visitor(p_, node->p_);
-        node->visitBranches(visitor);
+        assert(nodes_[child].parent_ == node);
+        visitor(nodes_[node].p_, nodes_[child].p_);
+        visitBranches(child, visitor);
     }
 }
 
 // NOTE: Depth-first, as currently implemented.
-void LightningTreeNode::visitNodes(const std::function<void(LightningTreeNodeSPtr)>& visitor)
+void LightningTreeNodePool::visitNodes(const LightningTreeNodeIdx node, const std::function<void(LightningTreeNodeIdx)>& visitor) const
 {
-    visitor(shared_from_this());
-    for (const auto& node : children_)
+    visitor(node);
+    for (const LightningTreeNodeIdx child : nodes_[node].children_)
     {
-        assert(node->parent_.lock() == shared_from_this());
-        node->visitNodes(visitor);
+        assert(nodes_[child].parent_ == node);
+        visitNodes(child, visitor);
     }
 }
 
-LightningTreeNode::LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location /*= std::nullopt*/)
-    : is_root_(true)
-    , p_(p)
-    , last_grounding_location_(last_grounding_location)
+LightningTreeNodeIdx LightningTreeNodePool::deepCopy(const LightningTreeNodeIdx node, LightningTreeNodePool& target) const
 {
-}
-
-LightningTreeNodeSPtr LightningTreeNode::deepCopy() const
-{
-    LightningTreeNodeSPtr local_root = LightningTreeNode::create(p_);
-    local_root->is_root_ = is_root_;
-    if (is_root_)
+    const LightningTreeNode& original = nodes_[node];
+    const LightningTreeNodeIdx local_root = target.create(original.p_);
+    target.nodes_[local_root].is_root_ = original.is_root_;
+    if (original.is_root_)
     {
-        local_root->last_grounding_location_ = last_grounding_location_.value_or(p_);
+        target.nodes_[local_root].last_grounding_location_ = original.last_grounding_location_.value_or(original.p_);
     }
-    local_root->children_.reserve(children_.size());
-    for (const auto& node : children_)
+    target.nodes_[local_root].children_.reserve(original.children_.size());
+    for (const LightningTreeNodeIdx child : original.children_)
     {
-        LightningTreeNodeSPtr child = node->deepCopy();
-        child->parent_ = local_root;
-        local_root->children_.push_back(child);
+        const LightningTreeNodeIdx child_copy = deepCopy(child, target);
+        target.nodes_[child_copy].parent_ = local_root;
+        target.nodes_[local_root].children_.push_back(child_copy);
     }
     return local_root;
 }
 
-void LightningTreeNode::reroot(LightningTreeNodeSPtr new_parent /*= nullptr*/)
+void LightningTreeNodePool::reroot(const LightningTreeNodeIdx node, const LightningTreeNodeIdx new_parent /*= NO_INDEX*/)
 {
-    if (! is_root_)
+    if (! nodes_[node].is_root_)
     {
-        auto old_parent = parent_.lock();
-        old_parent->reroot(shared_from_this());
-        children_.push_back(old_parent);
+        const LightningTreeNodeIdx old_parent = nodes_[node].parent_;
+        reroot(old_parent, node);
+        nodes_[node].children_.push_back(old_parent);
     }
 
-    if (new_parent)
+    LightningTreeNode& here = nodes_[node];
+    if (new_parent != NO_INDEX)
     {
-        children_.erase(std::remove(children_.begin(), children_.end(), new_parent), children_.end());
-        is_root_ = false;
-        parent_ = new_parent;
+        here.children_.erase(std::remove(here.children_.begin(), here.children_.end(), new_parent), here.children_.end());
+        here.is_root_ = false;
+        here.parent_ = new_parent;
     }
     else
     {
-        is_root_ = true;
-        parent_.reset();
+        here.is_root_ = true;
+        here.parent_ = NO_INDEX;
     }
 }
 
-LightningTreeNodeSPtr LightningTreeNode::closestNode(const Point2LL& loc)
+LightningTreeNodeIdx LightningTreeNodePool::closestNode(const LightningTreeNodeIdx node, const Point2LL& loc) const
 {
-    LightningTreeNodeSPtr result = shared_from_this();
-    coord_t closest_dist2 = vSize2(p_ - loc);
+    LightningTreeNodeIdx result = node;
+    coord_t closest_dist2 = vSize2(nodes_[node].p_ - loc);
 
-    for (const auto& child : children_)
+    for (const LightningTreeNodeIdx child : nodes_[node].children_)
     {
-        LightningTreeNodeSPtr candidate_node = child->closestNode(loc);
-        const coord_t child_dist2 = vSize2(candidate_node->p_ - loc);
+        const LightningTreeNodeIdx candidate_node = closestNode(child, loc);
+        const coord_t child_dist2 = vSize2(nodes_[candidate_node].p_ - loc);
         if (child_dist2 < closest_dist2)
         {
             closest_dist2 = child_dist2;
@@ -170,27 +239,28 @@ LightningTreeNodeSPtr LightningTreeNode::closestNode(const Point2LL& loc)
     return result;
 }
 
-bool LightningTreeNode::realign(const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeSPtr>& rerooted_parts)
+bool LightningTreeNodePool::realign(const LightningTreeNodeIdx node, const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeIdx>& rerooted_parts)
 {
     if (outlines.empty())
     {
         return false;
     }
 
-    if (outlines.inside(p_, true))
+    const Point2LL p = nodes_[node].p_;
+    if (outlines.inside(p, true))
     {
         // Only keep children that have an unbroken connection to here, realign will put the rest in rerooted parts due to recursion:
         Point2LL coll;
         bool reground_me = false;
         const auto remove_unconnected_func{
-            [&](const LightningTreeNodeSPtr& child)
+            [&](const LightningTreeNodeIdx child)
             {
-                bool connect_branch = child->realign(outlines, outline_locator, rerooted_parts);
-                if (connect_branch && PolygonUtils::lineSegmentPolygonsIntersection(child->p_, p_, outlines, outline_locator, coll, outline_locator.getCellSize() * 2))
+                bool connect_branch = realign(child, outlines, outline_locator, rerooted_parts);
+                if (connect_branch && PolygonUtils::lineSegmentPolygonsIntersection(nodes_[child].p_, p, outlines, outline_locator, coll, outline_locator.getCellSize() * 2))
                 {
-                    child->last_grounding_location_.reset();
-                    child->parent_.reset();
-                    child->is_root_ = true;
+                    nodes_[child].last_grounding_location_.reset();
+                    nodes_[child].parent_ = NO_INDEX;
+                    nodes_[child].is_root_ = true;
                     rerooted_parts.push_back(child);
 
                     reground_me = true;
@@ -199,77 +269,85 @@ bool LightningTreeNode::realign(const Shape& outlines, const LocToLineGrid& outl
                 return ! connect_branch;
             }
         };
-        children_.erase(std::remove_if(children_.begin(), children_.end(), remove_unconnected_func), children_.end());
+        // Take the children out while they are realigned, since that doesn't touch this node.
+        std::vector<LightningTreeNodeIdx> children = std::move(nodes_[node].children_);
+        children.erase(std::remove_if(children.begin(), children.end(), remove_unconnected_func), children.end());
+        nodes_[node].children_ = std::move(children);
         if (reground_me)
         {
-            last_grounding_location_.reset();
+            nodes_[node].last_grounding_location_.reset();
         }
         return true;
     }
 
     // 'Lift' any decendants out of this tree:
-    for (auto& child : children_)
+    for (const LightningTreeNodeIdx child : nodes_[node].children_)
     {
-        if (child->realign(outlines, outline_locator, rerooted_parts))
+        if (realign(child, outlines, outline_locator, rerooted_parts))
         {
-            child->last_grounding_location_ = p_;
-            child->parent_.reset();
-            child->is_root_ = true;
+            nodes_[child].last_grounding_location_ = p;
+            nodes_[child].parent_ = NO_INDEX;
+            nodes_[child].is_root_ = true;
             rerooted_parts.push_back(child);
         }
     }
-    children_.clear();
+    nodes_[node].children_.clear();
 
     return false;
 }
 
-void LightningTreeNode::straighten(const coord_t magnitude, const coord_t max_remove_colinear_dist)
+void LightningTreeNodePool::straighten(const LightningTreeNodeIdx node, const coord_t magnitude, const coord_t max_remove_colinear_dist)
 {
-    straighten(magnitude, p_, 0, max_remove_colinear_dist * max_remove_colinear_dist);
+    straighten(node, magnitude, nodes_[node].p_, 0, max_remove_colinear_dist * max_remove_colinear_dist);
 }
 
-LightningTreeNode::RectilinearJunction
-    LightningTreeNode::straighten(const coord_t magnitude, const Point2LL& junction_above, const coord_t accumulated_dist, const coord_t max_remove_colinear_dist2)
+LightningTreeNodePool::RectilinearJunction LightningTreeNodePool::straighten(
+    const LightningTreeNodeIdx node,
+    const coord_t magnitude,
+    const Point2LL& junction_above,
+    const coord_t accumulated_dist,
+    const coord_t max_remove_colinear_dist2)
 {
     constexpr coord_t junction_magnitude_factor_numerator = 3;
     constexpr coord_t junction_magnitude_factor_denominator = 4;
 
     const coord_t junction_magnitude = magnitude * junction_magnitude_factor_numerator / junction_magnitude_factor_denominator;
-    if (children_.size() == 1)
+    if (nodes_[node].children_.size() == 1)
     {
-        auto child_p = children_.front();
-        coord_t child_dist = vSize(p_ - child_p->p_);
-        RectilinearJunction junction_below = child_p->straighten(magnitude, junction_above, accumulated_dist + child_dist, max_remove_colinear_dist2);
+        LightningTreeNodeIdx child = nodes_[node].children_.front();
+        coord_t child_dist = vSize(nodes_[node].p_ - nodes_[child].p_);
+        RectilinearJunction junction_below = straighten(child, magnitude, junction_above, accumulated_dist + child_dist, max_remove_colinear_dist2);
         coord_t total_dist_to_junction_below = junction_below.total_recti_dist;
         Point2LL a = junction_above;
         Point2LL b = junction_below.junction_loc;
+        Point2LL& p = nodes_[node].p_;
         if (a != b) // should always be true!
         {
             Point2LL ab = b - a;
             Point2LL destination = a + ab * accumulated_dist / std::max(coord_t(1), total_dist_to_junction_below);
-            if (shorterThen(destination - p_, magnitude))
+            if (shorterThen(destination - p, magnitude))
             {
-                p_ = destination;
+                p = destination;
             }
             else
             {
-                p_ = p_ + normal(destination - p_, magnitude);
+                p = p + normal(destination - p, magnitude);
             }
         }
         { // remove nodes on linear segments
             constexpr coord_t close_enough = 10;
 
-            child_p = children_.front(); // recursive call to straighten might have removed the child
-            const LightningTreeNodeSPtr& parent_node = parent_.lock();
-            if (parent_node && vSize2(child_p->p_ - parent_node->p_) < max_remove_colinear_dist2
-                && LinearAlg2D::getDist2FromLineSegment(parent_node->p_, p_, child_p->p_) < close_enough)
+            child = nodes_[node].children_.front(); // recursive call to straighten might have removed the child
+            const LightningTreeNodeIdx parent_node = nodes_[node].parent_;
+            if (parent_node != NO_INDEX && vSize2(nodes_[child].p_ - nodes_[parent_node].p_) < max_remove_colinear_dist2
+                && LinearAlg2D::getDist2FromLineSegment(nodes_[parent_node].p_, p, nodes_[child].p_) < close_enough)
             {
-                child_p->parent_ = parent_;
-                for (auto& sibling : parent_node->children_)
+                nodes_[child].parent_ = parent_node;
+                for (LightningTreeNodeIdx& sibling : nodes_[parent_node].children_)
                 { // find this node among siblings
-                    if (sibling == shared_from_this())
+                    if (sibling == node)
                     {
-                        sibling = child_p; // replace this node by child
+                        sibling = child; // replace this node by child
                         break;
                     }
                 }
@@ -280,34 +358,36 @@ LightningTreeNode::RectilinearJunction
     else
     {
         constexpr coord_t weight = 1000;
-        Point2LL junction_moving_dir = normal(junction_above - p_, weight);
+        const Point2LL p = nodes_[node].p_;
+        Point2LL junction_moving_dir = normal(junction_above - p, weight);
         bool prevent_junction_moving = false;
-        for (auto& child_p : children_)
+        for (size_t child_idx = 0; child_idx < nodes_[node].children_.size(); ++child_idx)
         {
-            const coord_t child_dist = vSize(p_ - child_p->p_);
-            RectilinearJunction below = child_p->straighten(magnitude, p_, child_dist, max_remove_colinear_dist2);
+            const LightningTreeNodeIdx child = nodes_[node].children_[child_idx];
+            const coord_t child_dist = vSize(p - nodes_[child].p_);
+            RectilinearJunction below = straighten(child, magnitude, p, child_dist, max_remove_colinear_dist2);
 
-            junction_moving_dir += normal(below.junction_loc - p_, weight);
+            junction_moving_dir += normal(below.junction_loc - p, weight);
             if (below.total_recti_dist < magnitude) // TODO: make configurable?
             {
                 prevent_junction_moving = true; // prevent flipflopping in branches due to straightening and junctoin moving clashing
             }
         }
-        if (junction_moving_dir != Point2LL(0, 0) && ! children_.empty() && ! is_root_ && ! prevent_junction_moving)
+        if (junction_moving_dir != Point2LL(0, 0) && ! nodes_[node].children_.empty() && ! nodes_[node].is_root_ && ! prevent_junction_moving)
         {
             coord_t junction_moving_dir_len = vSize(junction_moving_dir);
             if (junction_moving_dir_len > junction_magnitude)
             {
                 junction_moving_dir = junction_moving_dir * junction_magnitude / junction_moving_dir_len;
             }
-            p_ += junction_moving_dir;
+            nodes_[node].p_ += junction_moving_dir;
         }
-        return RectilinearJunction{ accumulated_dist, p_ };
+        return RectilinearJunction{ accumulated_dist, nodes_[node].p_ };
     }
 }
 
 // Prune the tree from the extremeties (leaf-nodes) until the pruning distance is reached.
-coord_t LightningTreeNode::prune(const coord_t& pruning_distance)
+coord_t LightningTreeNodePool::prune(const LightningTreeNodeIdx node, const coord_t& pruning_distance)
 {
     if (pruning_distance <= 0)
     {
@@ -315,34 +395,34 @@ coord_t LightningTreeNode::prune(const coord_t& pruning_distance)
     }
 
     coord_t max_distance_pruned = 0;
-    for (auto child_it = children_.begin(); child_it != children_.end();)
+    for (size_t child_idx = 0; child_idx < nodes_[node].children_.size();)
     {
-        auto& child = *child_it;
-        coord_t dist_pruned_child = child->prune(pruning_distance);
+        const LightningTreeNodeIdx child = nodes_[node].children_[child_idx];
+        coord_t dist_pruned_child = prune(child, pruning_distance);
         if (dist_pruned_child >= pruning_distance)
         { // pruning is finished for child; dont modify further
             max_distance_pruned = std::max(max_distance_pruned, dist_pruned_child);
-            ++child_it;
+            ++child_idx;
         }
         else
         {
-            const Point2LL a = getLocation();
-            const Point2LL b = child->getLocation();
+            const Point2LL a = nodes_[node].getLocation();
+            const Point2LL b = nodes_[child].getLocation();
             const Point2LL ba = a - b;
             const coord_t ab_len = vSize(ba);
             if (dist_pruned_child + ab_len <= pruning_distance)
             { // we're still in the process of pruning
-                assert(child->children_.empty() && "when pruning away a node all it's children must already have been pruned away");
+                assert(nodes_[child].children_.empty() && "when pruning away a node all it's children must already have been pruned away");
                 max_distance_pruned = std::max(max_distance_pruned, dist_pruned_child + ab_len);
-                child_it = children_.erase(child_it);
+                nodes_[node].children_.erase(nodes_[node].children_.begin() + child_idx);
             }
             else
             { // pruning stops in between this node and the child
                 const Point2LL n = b + normal(ba, pruning_distance - dist_pruned_child);
                 assert(std::abs(vSize(n - b) + dist_pruned_child - pruning_distance) < 10 && "total pruned distance must be equal to the pruning_distance");
                 max_distance_pruned = std::max(max_distance_pruned, pruning_distance);
-                child->setLocation(n);
-                ++child_it;
+                nodes_[child].setLocation(n);
+                ++child_idx;
             }
         }
     }
@@ -350,43 +430,38 @@ coord_t LightningTreeNode::prune(const coord_t& pruning_distance)
     return max_distance_pruned;
 }
 
-const std::optional<Point2LL>& LightningTreeNode::getLastGroundingLocation() const
-{
-    return last_grounding_location_;
-}
-
-void LightningTreeNode::convertToPolylines(OpenLinesSet& output, const coord_t line_width) const
+void LightningTreeNodePool::convertToPolylines(const LightningTreeNodeIdx node, OpenLinesSet& output, const coord_t line_width) const
 {
     OpenLinesSet result;
     result.emplace_back();
-    convertToPolylines(0, result);
+    convertToPolylines(node, 0, result);
     removeJunctionOverlap(result, line_width);
     output.push_back(result);
 }
 
-void LightningTreeNode::convertToPolylines(size_t long_line_idx, OpenLinesSet& output) const
+void LightningTreeNodePool::convertToPolylines(const LightningTreeNodeIdx node, size_t long_line_idx, OpenLinesSet& output) const
 {
-    if (children_.empty())
+    const LightningTreeNode& here = nodes_[node];
+    if (here.children_.empty())
     {
-        output[long_line_idx].push_back(p_);
+        output[long_line_idx].push_back(here.p_);
         return;
     }
-    size_t first_child_idx = rand() % children_.size();
-    children_[first_child_idx]->convertToPolylines(long_line_idx, output);
-    output[long_line_idx].push_back(p_);
+    size_t first_child_idx = rand() % here.children_.size();
+    convertToPolylines(here.children_[first_child_idx], long_line_idx, output);
+    output[long_line_idx].push_back(here.p_);
 
-    for (size_t idx_offset = 1; idx_offset < children_.size(); idx_offset++)
+    for (size_t idx_offset = 1; idx_offset < here.children_.size(); idx_offset++)
     {
-        size_t child_idx = (first_child_idx + idx_offset) % children_.size();
-        const LightningTreeNode& child = *children_[child_idx];
+        size_t child_idx = (first_child_idx + idx_offset) % here.children_.size();
         output.emplace_back();
         size_t child_line_idx = output.size() - 1;
-        child.convertToPolylines(child_line_idx, output);
-        output[child_line_idx].push_back(p_);
+        convertToPolylines(here.children_[child_idx], child_line_idx, output);
+        output[child_line_idx].push_back(here.p_);
     }
 }
 
-void LightningTreeNode::removeJunctionOverlap(OpenLinesSet& result_lines, const coord_t line_width) const
+void LightningTreeNodePool::removeJunctionOverlap(OpenLinesSet& result_lines, const coord_t line_width)
 {
     const coord_t reduction = line_width / 2; // TODO make configurable?
     for (auto poly_it = result_lines.begin(); poly_it != result_lines.end();)
@@ -16,7 +16,7 @@ RegularNGonalInfill::RegularNGonalInfill(RegularNGonType type)
 {
 }
 
-OpenLinesSet RegularNGonalInfill::generateParallelLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z, const coord_t line_width) const
+OpenLinesSet RegularNGonalInfill::generateParallelLines(const coord_t line_distance, const Shape& outline, const AABB& bounding_box, const coord_t z, const coord_t line_width) const
 {
     std::array<SegmentsPattern, 2> patterns;
     coord_t delta_y = 0;
@@ -4,10 +4,12 @@
 #include "mesh.h"
 
 #include <numbers>
+#include <numeric>
 
 #include <spdlog/spdlog.h>
 
 #include "utils/Point3D.h"
+#include "utils/ThreadPool.h"
 
 namespace cura
 {
@@ -61,26 +63,184 @@ void Mesh::addFace(
     vertices_[face.vertex_index_[2]].connected_faces_.push_back(idx);
 }
 
+void Mesh::addFaces(const std::vector<Point3LL>& corners, const std::vector<std::optional<Point2F>>& uv_coordinates)
+{
+    const size_t face_count = corners.size() / 3;
+    const auto uv = [&uv_coordinates](const size_t corner_idx) -> std::optional<Point2F>
+    {
+        return corner_idx < uv_coordinates.size() ? uv_coordinates[corner_idx] : std::nullopt;
+    };
+
+    if (! vertices_.empty())
+    {
+        // Welding has to take the existing vertices into account, so do it the slow way.
+        for (size_t face_idx = 0; face_idx < face_count; ++face_idx)
+        {
+            addFace(corners[face_idx * 3], corners[face_idx * 3 + 1], corners[face_idx * 3 + 2], uv(face_idx * 3), uv(face_idx * 3 + 1), uv(face_idx * 3 + 2));
+        }
+        return;
+    }
+
+    const size_t corner_count = face_count * 3;
+    std::vector<uint32_t> hashes(corner_count);
+    cura::parallel_for(
+        size_t(0),
+        corner_count,
+        [&](const size_t corner_idx)
+        {
+            hashes[corner_idx] = pointHash(corners[corner_idx]);
+        },
+        1024);
+
+    // Radix-partition the corners by (a mix of) their hash, so that every hash bucket ends up in exactly one partition.
+    // The counting sort is stable, so within each partition the corners remain in the order in which they were given.
+    constexpr size_t partition_bits = 8;
+    constexpr size_t partition_count = size_t(1) << partition_bits;
+    const auto partition_of = [](const uint32_t hash)
+    {
+        return static_cast<size_t>((hash * 2654435761u) >> (32 - partition_bits));
+    };
+    std::vector<size_t> partition_start(partition_count + 1, 0);
+    for (const uint32_t hash : hashes)
+    {
+        partition_start[partition_of(hash) + 1]++;
+    }
+    std::partial_sum(partition_start.begin(), partition_start.end(), partition_start.begin());
+    std::vector<uint32_t> sorted_corners(corner_count);
+    {
+        std::vector<size_t> fill_position(partition_start.begin(), partition_start.end() - 1);
+        for (uint32_t corner_idx = 0; corner_idx < corner_count; ++corner_idx)
+        {
+            sorted_corners[fill_position[partition_of(hashes[corner_idx])]++] = corner_idx;
+        }
+    }
+
+    // Within each partition, weld the corners of each hash bucket just like findIndexOfVertex would: every corner is welded to the first earlier corner in its bucket that
+    // is close enough, or else it becomes a new vertex itself. Buckets are independent of each other, so the partitions can be processed in parallel.
+    std::vector<uint32_t> welded_to(corner_count);
+    cura::parallel_for(
+        size_t(0),
+        partition_count,
+        [&](const size_t partition)
+        {
+            const auto first = sorted_corners.begin() + static_cast<ptrdiff_t>(partition_start[partition]);
+            const auto last = sorted_corners.begin() + static_cast<ptrdiff_t>(partition_start[partition + 1]);
+            std::stable_sort(
+                first,
+                last,
+                [&hashes](const uint32_t a, const uint32_t b)
+                {
+                    return hashes[a] < hashes[b];
+                });
+
+            std::vector<uint32_t> bucket_vertices;
+            for (auto bucket_first = first; bucket_first != last;)
+            {
+                const uint32_t hash = hashes[*bucket_first];
+                bucket_vertices.clear();
+                auto corner_it = bucket_first;
+                for (; corner_it != last && hashes[*corner_it] == hash; ++corner_it)
+                {
+                    const uint32_t corner_idx = *corner_it;
+                    welded_to[corner_idx] = corner_idx;
+                    for (const uint32_t vertex_corner_idx : bucket_vertices)
+                    {
+                        if ((corners[vertex_corner_idx] - corners[corner_idx]).testLength(vertex_meld_distance))
+                        {
+                            welded_to[corner_idx] = vertex_corner_idx;
+                            break;
+                        }
+                    }
+                    if (welded_to[corner_idx] == corner_idx)
+                    {
+                        bucket_vertices.push_back(corner_idx);
+                    }
+                }
+                bucket_first = corner_it;
+            }
+        });
+
+    // Number the vertices in order of first appearance, which is the order in which addFace would have created them.
+    std::vector<int> corner_vertex_idx(corner_count);
+    vertices_.reserve(corner_count / 2);
+    for (size_t corner_idx = 0; corner_idx < corner_count; ++corner_idx)
+    {
+        if (welded_to[corner_idx] == corner_idx)
+        {
+            corner_vertex_idx[corner_idx] = static_cast<int>(vertices_.size());
+            vertices_.emplace_back(corners[corner_idx]);
+            aabb_.include(corners[corner_idx]);
+        }
+        else
+        {
+            corner_vertex_idx[corner_idx] = corner_vertex_idx[welded_to[corner_idx]];
+        }
+    }
+    vertex_hash_map_outdated_ = true;
+
+    faces_.reserve(faces_.size() + face_count);
+    for (size_t face_idx = 0; face_idx < face_count; ++face_idx)
+    {
+        const int vi0 = corner_vertex_idx[face_idx * 3];
+        const int vi1 = corner_vertex_idx[face_idx * 3 + 1];
+        const int vi2 = corner_vertex_idx[face_idx * 3 + 2];
+        if (vi0 == vi1 || vi1 == vi2 || vi0 == vi2)
+        {
+            continue; // the face has two vertices which get assigned the same location. Don't add the face.
+        }
+
+        const int idx = faces_.size(); // index of face to be added
+        MeshFace& face = faces_.emplace_back();
+        face.vertex_index_[0] = vi0;
+        face.vertex_index_[1] = vi1;
+        face.vertex_index_[2] = vi2;
+        face.uv_coordinates_[0] = uv(face_idx * 3);
+        face.uv_coordinates_[1] = uv(face_idx * 3 + 1);
+        face.uv_coordinates_[2] = uv(face_idx * 3 + 2);
+        vertices_[vi0].connected_faces_.push_back(idx);
+        vertices_[vi1].connected_faces_.push_back(idx);
+        vertices_[vi2].connected_faces_.push_back(idx);
+    }
+}
+
 void Mesh::clear()
 {
     faces_.clear();
     vertices_.clear();
     vertex_hash_map_.clear();
+    vertex_hash_map_outdated_ = false;
 }
 
 void Mesh::finish()
 {
     // Finish up the mesh, clear the vertex_hash_map, as it's no longer needed from this point on and uses quite a bit of memory.
     vertex_hash_map_.clear();
+    vertex_hash_map_outdated_ = false;
 
     // For each face, store which other face is connected with it.
-    for (unsigned int i = 0; i < faces_.size(); i++)
+    TopologyIssues issues;
+    cura::parallel_for(
+        size_t(0),
+        faces_.size(),
+        [&](const size_t i)
+        {
+            MeshFace& face = faces_[i];
+            // faces are connected via the outside
+            face.connected_face_index_[0] = getFaceIdxWithPoints(face.vertex_index_[0], face.vertex_index_[1], i, face.vertex_index_[2], issues);
+            face.connected_face_index_[1] = getFaceIdxWithPoints(face.vertex_index_[1], face.vertex_index_[2], i, face.vertex_index_[0], issues);
+            face.connected_face_index_[2] = getFaceIdxWithPoints(face.vertex_index_[2], face.vertex_index_[0], i, face.vertex_index_[1], issues);
+        },
+        256);
+
+    if (issues.disconnected_faces && ! has_disconnected_faces)
+    {
+        spdlog::warn("Mesh has disconnected faces!");
+        has_disconnected_faces = true;
+    }
+    if (issues.overlapping_faces && ! has_overlapping_faces)
     {
-        MeshFace& face = faces_[i];
-        // faces are connected via the outside
-        face.connected_face_index_[0] = getFaceIdxWithPoints(face.vertex_index_[0], face.vertex_index_[1], i, face.vertex_index_[2]);
-        face.connected_face_index_[1] = getFaceIdxWithPoints(face.vertex_index_[1], face.vertex_index_[2], i, face.vertex_index_[0]);
-        face.connected_face_index_[2] = getFaceIdxWithPoints(face.vertex_index_[2], face.vertex_index_[0], i, face.vertex_index_[1]);
+        spdlog::warn("Mesh has overlapping faces!");
+        has_overlapping_faces = true;
     }
 }
 
@@ -128,6 +288,17 @@ bool Mesh::isModelMesh() const
 
 int Mesh::findIndexOfVertex(const Point3LL& v)
 {
+    if (vertex_hash_map_outdated_)
+    {
+        // Register the vertices that were added in bulk, or before finishing the mesh, in the same order as addFace would have done.
+        vertex_hash_map_.clear();
+        for (uint32_t vertex_idx = 0; vertex_idx < vertices_.size(); ++vertex_idx)
+        {
+            vertex_hash_map_[pointHash(vertices_[vertex_idx].p_)].push_back(vertex_idx);
+        }
+        vertex_hash_map_outdated_ = false;
+    }
+
     uint32_t hash = pointHash(v);
 
     for (unsigned int idx = 0; idx < vertex_hash_map_[hash].size(); idx++)
@@ -169,7 +340,7 @@ See <a href="http://stackoverflow.com/questions/14066933/direct-way-of-computing
 
 
 */
-int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVertexIdx) const
+int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVertexIdx, TopologyIssues& issues) const
 {
     std::vector<int> candidateFaces; // in case more than two faces meet at an edge, multiple candidates are generated
     for (int f : vertices_[idx0].connected_faces_) // search through all faces connected to the first vertex and find those that are also connected to the second
@@ -188,11 +359,7 @@ int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVe
     if (candidateFaces.size() == 0)
     {
         spdlog::debug("Couldn't find face connected to face {}", notFaceIdx);
-        if (! has_disconnected_faces)
-        {
-            spdlog::warn("Mesh has disconnected faces!");
-        }
-        has_disconnected_faces = true;
+        issues.disconnected_faces = true;
         return -1;
     }
     if (candidateFaces.size() == 1)
@@ -204,11 +371,7 @@ int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVe
     if (candidateFaces.size() % 2 == 0)
     {
         spdlog::debug("Edge with uneven number of faces connecting it!({})\n", candidateFaces.size() + 1);
-        if (! has_disconnected_faces)
-        {
-            spdlog::warn("Mesh has disconnected faces!");
-        }
-        has_disconnected_faces = true;
+        issues.disconnected_faces = true;
     }
 
     Point3D vn(vertices_[idx1].p_ - vertices_[idx0].p_);
@@ -247,11 +410,7 @@ int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVe
         if (angle == 0)
         {
             spdlog::debug("Overlapping faces: face {} and face {}.", notFaceIdx, candidateFace);
-            if (! has_overlapping_faces)
-            {
-                spdlog::warn("Mesh has overlapping faces!");
-            }
-            has_overlapping_faces = true;
+            issues.overlapping_faces = true;
         }
         if (angle < smallestAngle)
         {
@@ -262,11 +421,7 @@ int Mesh::getFaceIdxWithPoints(int idx0, int idx1, int notFaceIdx, int notFaceVe
     if (bestIdx < 0)
     {
         spdlog::debug("Couldn't find face connected to face {}.", notFaceIdx);
-        if (! has_disconnected_faces)
-        {
-            spdlog::warn("Mesh has disconnected faces!");
-        }
-        has_disconnected_faces = true;
+        issues.disconnected_faces = true;
     }
     return bestIdx;
 }
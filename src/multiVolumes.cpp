@@ -4,6 +4,7 @@
 #include "multiVolumes.h"
 
 #include <algorithm>
+#include <optional>
 
 #include "Application.h"
 #include "Slice.h"
@@ -12,7 +13,9 @@
 #include "settings/EnumSettings.h"
 #include "settings/types/LayerIndex.h"
 #include "slicer.h"
+#include "utils/AABB.h"
 #include "utils/OpenPolylineStitcher.h"
+#include "utils/ThreadPool.h"
 
 namespace cura
 {
@@ -20,50 +23,111 @@ namespace cura
 void carveMultipleVolumes(std::vector<Slicer*>& volumes)
 {
     // Go trough all the volumes, and remove the previous volume outlines from our own outline, so we never have overlapped areas.
-    const bool alternate_carve_order = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("alternate_carve_order");
-    std::vector<Slicer*> ranked_volumes = volumes;
+    const bool alternate_carve_order = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<bool>("alternate_carve_order"_setting);
+
+    // Read the settings of each volume once, rather than for every pair of volumes and every layer.
+    struct RankedVolume
+    {
+        Slicer* volume;
+        int infill_mesh_order;
+        bool is_carved; //!< Whether the volume takes part in the carving at all
+    };
+    std::vector<RankedVolume> ranked_volumes;
+    ranked_volumes.reserve(volumes.size());
+    for (Slicer* volume : volumes)
+    {
+        const Settings& settings = volume->mesh->settings_;
+        const bool is_carved
+            = volume->mesh->isModelMesh() && ! settings.get<bool>("support_mesh"_setting) && settings.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) != ESurfaceMode::SURFACE;
+        ranked_volumes.push_back(RankedVolume{ volume, settings.get<int>("infill_mesh_order"_setting), is_carved });
+    }
     std::stable_sort(
         ranked_volumes.begin(),
         ranked_volumes.end(),
-        [](Slicer* volume_1, Slicer* volume_2)
+        [](const RankedVolume& volume_1, const RankedVolume& volume_2)
         {
-            return volume_1->mesh->settings_.get<int>("infill_mesh_order") < volume_2->mesh->settings_.get<int>("infill_mesh_order");
+            return volume_1.infill_mesh_order < volume_2.infill_mesh_order;
         });
-    for (unsigned int volume_1_idx = 1; volume_1_idx < volumes.size(); volume_1_idx++)
+
+    // Every layer is carved independently from the others, so list the pairs of volumes to carve in their ranked order once, and then apply
+    // them to all layers in parallel.
+    struct CarvePair
     {
-        Slicer& volume_1 = *ranked_volumes[volume_1_idx];
-        if (! volume_1.mesh->isModelMesh() || volume_1.mesh->settings_.get<bool>("support_mesh")
-            || volume_1.mesh->settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+        size_t volume_1_rank;
+        size_t volume_2_rank;
+        bool same_order; //!< Whether both volumes have the same infill_mesh_order, so that the carve order may alternate
+    };
+    std::vector<CarvePair> carve_pairs;
+    for (size_t volume_1_idx = 1; volume_1_idx < ranked_volumes.size(); volume_1_idx++)
+    {
+        const RankedVolume& volume_1 = ranked_volumes[volume_1_idx];
+        if (! volume_1.is_carved)
         {
             continue;
         }
-        for (unsigned int volume_2_idx = 0; volume_2_idx < volume_1_idx; volume_2_idx++)
+        for (size_t volume_2_idx = 0; volume_2_idx < volume_1_idx; volume_2_idx++)
         {
-            Slicer& volume_2 = *ranked_volumes[volume_2_idx];
-            if (! volume_2.mesh->isModelMesh() || volume_2.mesh->settings_.get<bool>("support_mesh")
-                || volume_2.mesh->settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+            const RankedVolume& volume_2 = ranked_volumes[volume_2_idx];
+            if (! volume_2.is_carved || ! volume_1.volume->mesh->getAABB().hit(volume_2.volume->mesh->getAABB()))
             {
                 continue;
             }
-            if (! volume_1.mesh->getAABB().hit(volume_2.mesh->getAABB()))
+            carve_pairs.push_back(CarvePair{ volume_1_idx, volume_2_idx, volume_1.infill_mesh_order == volume_2.infill_mesh_order });
+        }
+    }
+    if (carve_pairs.empty())
+    {
+        return;
+    }
+
+    size_t layer_count = 0;
+    for (const RankedVolume& ranked_volume : ranked_volumes)
+    {
+        layer_count = std::max(layer_count, ranked_volume.volume->layers.size());
+    }
+    cura::parallel_for<size_t>(
+        0,
+        layer_count,
+        [&](const size_t layer_nr)
+        {
+            // The bounding boxes of the layers of the volumes, computed when first needed. Carving only shrinks a layer, so its bounding box stays
+            // valid, but it is updated anyway to skip more pairs.
+            std::vector<std::optional<AABB>> layer_boxes(ranked_volumes.size());
+            const auto get_layer_box = [&](const size_t rank) -> const AABB&
             {
-                continue;
-            }
-            for (LayerIndex layerNr = 0; layerNr < volume_1.layers.size(); layerNr++)
+                if (! layer_boxes[rank].has_value())
+                {
+                    layer_boxes[rank] = AABB(ranked_volumes[rank].volume->layers[layer_nr].polygons_);
+                }
+                return layer_boxes[rank].value();
+            };
+
+            for (const CarvePair& carve_pair : carve_pairs)
             {
-                SlicerLayer& layer1 = volume_1.layers[layerNr];
-                SlicerLayer& layer2 = volume_2.layers[layerNr];
-                if (alternate_carve_order && layerNr % 2 == 0 && volume_1.mesh->settings_.get<int>("infill_mesh_order") == volume_2.mesh->settings_.get<int>("infill_mesh_order"))
+                Slicer& volume_1 = *ranked_volumes[carve_pair.volume_1_rank].volume;
+                Slicer& volume_2 = *ranked_volumes[carve_pair.volume_2_rank].volume;
+                if (layer_nr >= volume_1.layers.size())
+                {
+                    continue;
+                }
+                if (! get_layer_box(carve_pair.volume_1_rank).hit(get_layer_box(carve_pair.volume_2_rank)))
+                {
+                    continue; // Layers that are apart from each other can't carve anything from one another.
+                }
+                SlicerLayer& layer1 = volume_1.layers[layer_nr];
+                SlicerLayer& layer2 = volume_2.layers[layer_nr];
+                if (alternate_carve_order && layer_nr % 2 == 0 && carve_pair.same_order)
                 {
                     layer2.polygons_ = layer2.polygons_.difference(layer1.polygons_);
+                    layer_boxes[carve_pair.volume_2_rank].reset();
                 }
                 else
                 {
                     layer1.polygons_ = layer1.polygons_.difference(layer2.polygons_);
+                    layer_boxes[carve_pair.volume_1_rank].reset();
                 }
             }
-        }
-    }
+        });
 }
 
 // Expand each layer a bit and then keep the extra overlapping parts that overlap with other volumes.
@@ -75,36 +139,70 @@ void generateMultipleVolumesOverlap(std::vector<Slicer*>& volumes)
         return;
     }
 
-    int offset_to_merge_other_merged_volumes = 20;
+    constexpr coord_t offset_to_merge_other_merged_volumes = 20;
+
+    // Read the settings of each volume and find the volumes it overlaps with once, rather than for every layer.
+    struct OverlappingVolume
+    {
+        Slicer* volume;
+        ClipperLib::PolyFillType fill_type;
+        coord_t overlap;
+        std::vector<Slicer*> other_volumes; //!< The volumes whose layers may overlap with this volume, in their original order
+    };
+    std::vector<OverlappingVolume> overlapping_volumes;
+    size_t layer_count = 0;
     for (Slicer* volume : volumes)
     {
-        ClipperLib::PolyFillType fill_type = volume->mesh->settings_.get<bool>("meshfix_union_all") ? ClipperLib::pftNonZero : ClipperLib::pftEvenOdd;
-
-        coord_t overlap = volume->mesh->settings_.get<coord_t>("multiple_mesh_overlap");
-        if (! volume->mesh->isModelMesh() || volume->mesh->settings_.get<bool>("support_mesh") || overlap == 0)
+        const coord_t overlap = volume->mesh->settings_.get<coord_t>("multiple_mesh_overlap"_setting);
+        if (! volume->mesh->isModelMesh() || volume->mesh->settings_.get<bool>("support_mesh"_setting) || overlap == 0)
         {
             continue;
         }
+        OverlappingVolume overlapping_volume{ volume,
+                                              volume->mesh->settings_.get<bool>("meshfix_union_all"_setting) ? ClipperLib::pftNonZero : ClipperLib::pftEvenOdd,
+                                              overlap,
+                                              {} };
         AABB3D aabb(volume->mesh->getAABB());
         aabb.expandXY(overlap); // expand to account for the case where two models and their bounding boxes are adjacent along the X or Y-direction
-        for (LayerIndex layer_nr = 0; layer_nr < volume->layers.size(); layer_nr++)
+        for (Slicer* other_volume : volumes)
         {
-            Shape all_other_volumes;
-            for (Slicer* other_volume : volumes)
+            if (! other_volume->mesh->isModelMesh() || other_volume->mesh->settings_.get<bool>("support_mesh"_setting) || ! other_volume->mesh->getAABB().hit(aabb)
+                || other_volume == volume)
             {
-                if (! other_volume->mesh->isModelMesh() || other_volume->mesh->settings_.get<bool>("support_mesh") || ! other_volume->mesh->getAABB().hit(aabb)
-                    || other_volume == volume)
+                continue;
+            }
+            overlapping_volume.other_volumes.push_back(other_volume);
+        }
+        layer_count = std::max(layer_count, volume->layers.size());
+        overlapping_volumes.push_back(std::move(overlapping_volume));
+    }
+
+    // The volumes are processed in order within a layer, since a volume sees the overlap added to the volumes before it. Layers are independent.
+    cura::parallel_for<size_t>(
+        0,
+        layer_count,
+        [&](const size_t layer_nr)
+        {
+            for (const OverlappingVolume& overlapping_volume : overlapping_volumes)
+            {
+                if (layer_nr >= overlapping_volume.volume->layers.size())
                 {
                     continue;
                 }
-                SlicerLayer& other_volume_layer = other_volume->layers[layer_nr];
-                all_other_volumes = all_other_volumes.unionPolygons(other_volume_layer.polygons_.offset(offset_to_merge_other_merged_volumes), fill_type);
-            }
+                Shape all_other_volumes;
+                for (Slicer* other_volume : overlapping_volume.other_volumes)
+                {
+                    SlicerLayer& other_volume_layer = other_volume->layers[layer_nr];
+                    all_other_volumes
+                        = all_other_volumes.unionPolygons(other_volume_layer.polygons_.offset(offset_to_merge_other_merged_volumes), overlapping_volume.fill_type);
+                }
 
-            SlicerLayer& volume_layer = volume->layers[layer_nr];
-            volume_layer.polygons_ = volume_layer.polygons_.unionPolygons(all_other_volumes.intersection(volume_layer.polygons_.offset(overlap / 2)), fill_type);
-        }
-    }
+                SlicerLayer& volume_layer = overlapping_volume.volume->layers[layer_nr];
+                volume_layer.polygons_ = volume_layer.polygons_.unionPolygons(
+                    all_other_volumes.intersection(volume_layer.polygons_.offset(overlapping_volume.overlap / 2)),
+                    overlapping_volume.fill_type);
+            }
+        });
 }
 
 void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector<Mesh>& meshes)
@@ -114,7 +212,7 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
     bool has_extruder_change_mesh = false;
     for (const Mesh& cutting_mesh : meshes)
     {
-        has_extruder_change_mesh |= cutting_mesh.settings_.get<bool>("cutting_mesh") && cutting_mesh.settings_.has("extruder_nr");
+        has_extruder_change_mesh |= cutting_mesh.settings_.get<bool>("cutting_mesh"_setting) && cutting_mesh.settings_.has("extruder_nr");
     }
 
     std::unordered_map<LayerIndex, Shape> layer_printable_mesh_unions;
@@ -148,7 +246,7 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
     for (size_t carving_mesh_idx = 0; carving_mesh_idx < volumes.size(); ++carving_mesh_idx)
     {
         Mesh& cutting_mesh = meshes[carving_mesh_idx];
-        if (! cutting_mesh.settings_.get<bool>("cutting_mesh"))
+        if (! cutting_mesh.settings_.get<bool>("cutting_mesh"_setting))
         {
             continue;
         }
@@ -162,14 +260,14 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
             OpenLinesSet& cutting_mesh_polylines = cutting_mesh_volume.layers[layer_nr].open_polylines_;
             Shape cutting_mesh_area_recomputed;
             Shape* cutting_mesh_area;
-            coord_t surface_line_width = cutting_mesh.settings_.get<coord_t>("wall_line_width_0");
+            coord_t surface_line_width = cutting_mesh.settings_.get<coord_t>("wall_line_width_0"_setting);
             { // compute cutting_mesh_area
-                if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::BOTH)
+                if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) == ESurfaceMode::BOTH)
                 {
                     cutting_mesh_area_recomputed = cutting_mesh_polygons.unionPolygons(cutting_mesh_polylines.offset(surface_line_width / 2));
                     cutting_mesh_area = &cutting_mesh_area_recomputed;
                 }
-                else if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+                else if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) == ESurfaceMode::SURFACE)
                 {
                     // break up polygons into polylines
                     // they have to be polylines, because they might break up further when doing the cutting
@@ -209,7 +307,7 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
             {
                 const Mesh& carved_mesh = meshes[carved_mesh_idx];
                 // Do not apply cutting_mesh for meshes which have settings (cutting_mesh, anti_overhang_mesh, support_mesh).
-                if (! carved_mesh.isPrinted() || carved_mesh.settings_.get<bool>("support_mesh"))
+                if (! carved_mesh.isPrinted() || carved_mesh.settings_.get<bool>("support_mesh"_setting))
                 {
                     continue;
                 }
@@ -218,7 +316,7 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
 
                 Shape intersection = cutting_mesh_polygons.intersection(carved_mesh_layer);
                 new_outlines.push_back(intersection);
-                if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL) // niet te geleuven
+                if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) != ESurfaceMode::NORMAL) // niet te geleuven
                 {
                     new_polylines.push_back(carved_mesh_layer.intersection(cutting_mesh_polylines));
                 }
@@ -226,7 +324,7 @@ void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, std::vector
                 carved_mesh_layer = carved_mesh_layer.difference(*cutting_mesh_area);
             }
             cutting_mesh_polygons = new_outlines.unionPolygons();
-            if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
+            if (cutting_mesh.settings_.get<ESurfaceMode>("magic_mesh_surface_mode"_setting) != ESurfaceMode::NORMAL)
             {
                 cutting_mesh_polylines.clear();
                 OpenPolylineStitcher::stitch(new_polylines, cutting_mesh_polylines, cutting_mesh_polygons, surface_line_width);
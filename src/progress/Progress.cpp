@@ -12,6 +12,7 @@
 
 #include "Application.h" //To get the communication channel to send progress through.
 #include "communication/Communication.h" //To send progress through the communication channel.
+#include "utils/ResidentMemory.h"
 #include "utils/gettime.h"
 
 namespace cura
@@ -19,6 +20,7 @@ namespace cura
 std::array<double, N_PROGRESS_STAGES> Progress::accumulated_times = { -1 };
 double Progress::total_timing = -1;
 std::optional<LayerIndex> Progress::first_skipped_layer{};
+bool Progress::peak_memory_per_stage = false;
 
 double Progress::calcOverallProgress(Stage stage, double stage_progress)
 {
@@ -49,7 +51,13 @@ void Progress::messageProgressStage(Progress::Stage stage, TimeKeeper* time_keep
     {
         if (static_cast<int>(stage) > 0)
         {
-            spdlog::info("Progress: {} accomplished in {:03.3f}s", names.at(static_cast<size_t>(stage) - 1), time_keeper->restart());
+            const std::string_view finished_stage = names.at(static_cast<size_t>(stage) - 1);
+            spdlog::info("Progress: {} accomplished in {:03.3f}s", finished_stage, time_keeper->restart());
+            if (const size_t peak_memory = getPeakResidentMemory(); peak_memory > 0)
+            {
+                constexpr double bytes_per_mib = 1024.0 * 1024.0;
+                spdlog::info("Peak memory {} {}: {:.1f} MiB", peak_memory_per_stage ? "during" : "up to the end of", finished_stage, peak_memory / bytes_per_mib);
+            }
         }
         else
         {
@@ -59,6 +67,7 @@ void Progress::messageProgressStage(Progress::Stage stage, TimeKeeper* time_keep
         if (static_cast<int>(stage) < static_cast<int>(Stage::FINISH))
         {
             spdlog::info("Starting {}...", names.at(static_cast<size_t>(stage)));
+            peak_memory_per_stage = resetPeakResidentMemory();
         }
     }
 }
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "settings/SettingKey.h"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace cura
+{
+
+namespace
+{
+
+/*!
+ * \brief All names that were interned, in an open addressing hash table that
+ * is only ever added to.
+ *
+ * Names are found without locking. Adding a name takes the lock. Cura has a
+ * little over a thousand settings, so the table never gets crowded in
+ * practice. If it gets half full, the remaining names are kept in a map
+ * behind the lock.
+ */
+class SettingKeyRegistry
+{
+public:
+    struct Entry
+    {
+        size_t hash;
+        size_t id;
+        std::string name;
+    };
+
+    static SettingKeyRegistry& getInstance()
+    {
+        static SettingKeyRegistry registry;
+        return registry;
+    }
+
+    const Entry& intern(const std::string_view name)
+    {
+        const size_t hash = std::hash<std::string_view>{}(name);
+        if (const Entry* entry = findInTable(hash, name))
+        {
+            return *entry;
+        }
+        if (overflowing_.load(std::memory_order_acquire))
+        {
+            std::lock_guard lock(mutex_);
+            if (const auto entry = overflow_.find(std::string(name)); entry != overflow_.end())
+            {
+                return *entry->second;
+            }
+        }
+
+        std::lock_guard lock(mutex_);
+        if (const Entry* entry = findInTable(hash, name)) // Another thread may have added it in the meantime.
+        {
+            return *entry;
+        }
+        if (const auto entry = overflow_.find(std::string(name)); entry != overflow_.end())
+        {
+            return *entry->second;
+        }
+        const Entry& entry = entries_.emplace_back(Entry{ .hash = hash, .id = entries_.size(), .name = std::string(name) });
+        if (entries_.size() <= table_size / 2)
+        {
+            size_t slot = hash % table_size;
+            while (table_[slot].load(std::memory_order_relaxed) != nullptr)
+            {
+                slot = (slot + 1) % table_size;
+            }
+            table_[slot].store(&entry, std::memory_order_release);
+        }
+        else
+        {
+            overflow_.emplace(entry.name, &entry);
+            overflowing_.store(true, std::memory_order_release);
+        }
+        return entry;
+    }
+
+private:
+    static constexpr size_t table_size = 1 << 14;
+
+    const Entry* findInTable(const size_t hash, const std::string_view name) const
+    {
+        for (size_t slot = hash % table_size;; slot = (slot + 1) % table_size)
+        {
+            const Entry* entry = table_[slot].load(std::memory_order_acquire);
+            if (entry == nullptr)
+            {
+                return nullptr;
+            }
+            if (entry->hash == hash && entry->name == name)
+            {
+                return entry;
+            }
+        }
+    }
+
+    std::array<std::atomic<const Entry*>, table_size> table_{};
+    std::mutex mutex_; //!< Held to add names.
+    std::deque<Entry> entries_; //!< All interned names by id. A deque, so that the entries don't move.
+    std::atomic<bool> overflowing_{ false }; //!< Whether any names had to go in the overflow map.
+    std::unordered_map<std::string, const Entry*> overflow_; //!< The names that were interned once the table was half full.
+};
+
+} // namespace
+
+SettingKey::SettingKey(std::string_view name)
+{
+    const SettingKeyRegistry::Entry& entry = SettingKeyRegistry::getInstance().intern(name);
+    id_ = entry.id;
+    name_ = &entry.name;
+}
+
+} // namespace cura
@@ -6,9 +6,11 @@
 #include <cctype>
 #include <cstdio>
 #include <fstream>
+#include <mutex>
 #include <numbers>
 #include <regex> // regex parsing for temp flow graph
 #include <sstream> // ostringstream
+#include <stdexcept>
 #include <string> //Parsing strings (stod, stoul).
 
 #include <range/v3/range/conversion.hpp>
@@ -41,6 +43,213 @@ Settings::Settings()
     parent = nullptr; // Needs to be properly initialised because we check against this if the parent is not set.
 }
 
+std::atomic<uint64_t> Settings::ResolvedValueCache::generation_{ 0 };
+
+namespace
+{
+
+std::atomic<bool> count_saved_parses{ false };
+
+/*!
+ * \brief The number of saved parses of each thread that counted any.
+ *
+ * The counters are never freed, so that they can be summed after their thread ended.
+ */
+struct SavedParseCounters
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<std::atomic<size_t>>> per_thread;
+
+    static SavedParseCounters& getInstance()
+    {
+        static SavedParseCounters counters;
+        return counters;
+    }
+};
+
+void countSavedParse()
+{
+    thread_local std::atomic<size_t>& counter = []() -> std::atomic<size_t>&
+    {
+        SavedParseCounters& counters = SavedParseCounters::getInstance();
+        std::lock_guard lock(counters.mutex);
+        return *counters.per_thread.emplace_back(std::make_unique<std::atomic<size_t>>(0));
+    }();
+    // Only this thread writes to its counter, so it doesn't need an atomic increment.
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+Settings::ResolvedValueCache::~ResolvedValueCache()
+{
+    clear();
+    for (std::atomic<Chunk*>& chunk : chunks_)
+    {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+const Settings::ResolvedValue* Settings::ResolvedValueCache::find(const size_t id, const uint64_t generation) const
+{
+    if (id >= chunk_size * max_chunks)
+    {
+        return nullptr;
+    }
+    const Chunk* chunk = chunks_[id / chunk_size].load(std::memory_order_acquire);
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+    const ResolvedValue* value = (*chunk)[id % chunk_size].load(std::memory_order_acquire);
+    if (value == nullptr || value->generation != generation)
+    {
+        return nullptr;
+    }
+    return value;
+}
+
+const Settings::ResolvedValue* Settings::ResolvedValueCache::store(const size_t id, std::unique_ptr<ResolvedValue>& value)
+{
+    if (id >= chunk_size * max_chunks)
+    {
+        return nullptr;
+    }
+    std::atomic<Chunk*>& chunk_slot = chunks_[id / chunk_size];
+    Chunk* chunk = chunk_slot.load(std::memory_order_acquire);
+    if (chunk == nullptr)
+    {
+        auto new_chunk = std::make_unique<Chunk>();
+        if (chunk_slot.compare_exchange_strong(chunk, new_chunk.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            chunk = new_chunk.release();
+        } // Otherwise another thread allocated it first, and chunk now points to theirs.
+    }
+
+    std::atomic<const ResolvedValue*>& slot = (*chunk)[id % chunk_size];
+    const ResolvedValue* current = slot.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (current != nullptr && current->generation >= value->generation)
+        {
+            return current; // Another thread resolved it in the meantime.
+        }
+        if (slot.compare_exchange_weak(current, value.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+    if (current != nullptr)
+    {
+        std::lock_guard lock(retired_mutex_);
+        retired_.emplace_back(current);
+    }
+    return value.release();
+}
+
+void Settings::ResolvedValueCache::clear()
+{
+    for (std::atomic<Chunk*>& chunk_slot : chunks_)
+    {
+        Chunk* chunk = chunk_slot.load(std::memory_order_relaxed);
+        if (chunk == nullptr)
+        {
+            continue;
+        }
+        for (std::atomic<const ResolvedValue*>& slot : *chunk)
+        {
+            delete slot.exchange(nullptr, std::memory_order_relaxed);
+        }
+    }
+    std::lock_guard lock(retired_mutex_);
+    retired_.clear();
+}
+
+template<typename F>
+auto Settings::getResolved(const SettingKey& key, const bool is_parse, F&& read) const
+{
+    const uint64_t generation = ResolvedValueCache::generation_.load(std::memory_order_acquire);
+    if (const ResolvedValue* cached = resolved_values_.find(key.id(), generation))
+    {
+        if (is_parse && count_saved_parses.load(std::memory_order_relaxed))
+        {
+            countSavedParse();
+        }
+        return read(*cached);
+    }
+
+    auto value = std::make_unique<ResolvedValue>();
+    value->generation = generation;
+    value->as_string = resolve(key);
+    const char* const string = value->as_string.c_str();
+    value->as_double = atof(string);
+    value->as_int = atoi(string);
+    try
+    {
+        value->as_size_t = std::stoul(string);
+    }
+    catch (const std::logic_error&) // Not a number, or out of range.
+    {
+    }
+    const std::string& as_string = value->as_string;
+    value->as_bool = as_string == "on" || as_string == "yes" || as_string == "true" || as_string == "True" || value->as_int != 0;
+
+    if (const ResolvedValue* stored = resolved_values_.store(key.id(), value))
+    {
+        return read(*stored);
+    }
+    return read(*value);
+}
+
+void Settings::invalidateResolvedValues()
+{
+    ResolvedValueCache::generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void Settings::startCountingSavedParses()
+{
+    SavedParseCounters& counters = SavedParseCounters::getInstance();
+    {
+        std::lock_guard lock(counters.mutex);
+        for (const std::unique_ptr<std::atomic<size_t>>& counter : counters.per_thread)
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+    count_saved_parses.store(true, std::memory_order_release);
+}
+
+size_t Settings::stopCountingSavedParses()
+{
+    count_saved_parses.store(false, std::memory_order_release);
+    SavedParseCounters& counters = SavedParseCounters::getInstance();
+    std::lock_guard lock(counters.mutex);
+    size_t total = 0;
+    for (const std::unique_ptr<std::atomic<size_t>>& counter : counters.per_thread)
+    {
+        total += counter->load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Settings& Settings::operator=(const Settings& other)
+{
+    parent = other.parent;
+    settings = other.settings;
+    resolved_values_.clear();
+    invalidateResolvedValues();
+    return *this;
+}
+
+Settings& Settings::operator=(Settings&& other)
+{
+    parent = other.parent;
+    settings = std::move(other.settings);
+    resolved_values_.clear();
+    invalidateResolvedValues();
+    return *this;
+}
+
 void Settings::add(const std::string& key, const std::string& value)
 {
     if (settings.find(key) != settings.end()) // Already exists.
@@ -51,6 +260,8 @@ void Settings::add(const std::string& key, const std::string& value)
     {
         settings.emplace(key, value);
     }
+    resolved_values_.clear();
+    invalidateResolvedValues();
 }
 
 void Settings::remove(const std::string& key)
@@ -59,22 +270,36 @@ void Settings::remove(const std::string& key)
     if (iterator != settings.end())
     {
         settings.erase(iterator);
+        resolved_values_.clear();
+        invalidateResolvedValues();
     }
 }
 
 template<>
-std::string Settings::get<std::string>(const std::string& key) const
+std::string Settings::get<std::string>(const SettingKey& key) const
+{
+    return getResolved(
+        key,
+        false,
+        [](const ResolvedValue& value)
+        {
+            return value.as_string;
+        });
+}
+
+std::string Settings::resolve(const SettingKey& key) const
 {
     // If this settings base has a setting value for it, look that up.
-    if (settings.find(key) != settings.end())
+    const std::string& name = key.name();
+    if (const auto value = settings.find(name); value != settings.end())
     {
-        return settings.at(key);
+        return value->second;
     }
 
     const std::unordered_map<std::string, ExtruderTrain*>& limit_to_extruder = Application::getInstance().current_slice_->scene.limit_to_extruder;
-    if (limit_to_extruder.find(key) != limit_to_extruder.end())
+    if (const auto extruder = limit_to_extruder.find(name); extruder != limit_to_extruder.end())
     {
-        return limit_to_extruder.at(key)->settings_.getWithoutLimiting(key);
+        return extruder->second->settings_.getWithoutLimiting(key);
     }
 
     if (parent)
@@ -82,42 +307,60 @@ std::string Settings::get<std::string>(const std::string& key) const
         return parent->get<std::string>(key);
     }
 
-    spdlog::error("Trying to retrieve setting with no value given: {}", key);
+    spdlog::error("Trying to retrieve setting with no value given: {}", name);
     std::exit(2);
 }
 
 template<>
-double Settings::get<double>(const std::string& key) const
+double Settings::get<double>(const SettingKey& key) const
 {
-    return atof(get<std::string>(key).c_str());
+    return getResolved(
+        key,
+        true,
+        [](const ResolvedValue& value)
+        {
+            return value.as_double;
+        });
 }
 
 template<>
-size_t Settings::get<size_t>(const std::string& key) const
+size_t Settings::get<size_t>(const SettingKey& key) const
 {
-    return std::stoul(get<std::string>(key).c_str());
+    return getResolved(
+        key,
+        true,
+        [](const ResolvedValue& value)
+        {
+            return value.as_size_t ? *value.as_size_t : std::stoul(value.as_string);
+        });
 }
 
 template<>
-int Settings::get<int>(const std::string& key) const
+int Settings::get<int>(const SettingKey& key) const
 {
-    return atoi(get<std::string>(key).c_str());
+    return getResolved(
+        key,
+        true,
+        [](const ResolvedValue& value)
+        {
+            return value.as_int;
+        });
 }
 
 template<>
-bool Settings::get<bool>(const std::string& key) const
+bool Settings::get<bool>(const SettingKey& key) const
 {
-    const std::string& value = get<std::string>(key);
-    if (value == "on" || value == "yes" || value == "true" || value == "True")
-    {
-        return true;
-    }
-    const int num = atoi(value.c_str());
-    return num != 0;
+    return getResolved(
+        key,
+        true,
+        [](const ResolvedValue& value)
+        {
+            return value.as_bool;
+        });
 }
 
 template<>
-ExtruderTrain& Settings::get<ExtruderTrain&>(const std::string& key) const
+ExtruderTrain& Settings::get<ExtruderTrain&>(const SettingKey& key) const
 {
     int extruder_nr = std::atoi(get<std::string>(key).c_str());
     if (extruder_nr < 0)
@@ -128,7 +371,7 @@ ExtruderTrain& Settings::get<ExtruderTrain&>(const std::string& key) const
 }
 
 template<>
-std::vector<ExtruderTrain*> Settings::get<std::vector<ExtruderTrain*>>(const std::string& key) const
+std::vector<ExtruderTrain*> Settings::get<std::vector<ExtruderTrain*>>(const SettingKey& key) const
 {
     int extruder_nr = std::atoi(get<std::string>(key).c_str());
     std::vector<ExtruderTrain*> ret;
@@ -147,62 +390,63 @@ std::vector<ExtruderTrain*> Settings::get<std::vector<ExtruderTrain*>>(const std
 }
 
 template<>
-LayerIndex Settings::get<LayerIndex>(const std::string& key) const
+LayerIndex Settings::get<LayerIndex>(const SettingKey& key) const
 {
     // For the user we display layer numbers starting from 1, but we start counting from 0. Still it may be negative for Raft layers.
     return std::atoi(get<std::string>(key).c_str()) - 1;
 }
 
 template<>
-coord_t Settings::get<coord_t>(const std::string& key) const
+coord_t Settings::get<coord_t>(const SettingKey& key) const
 {
-    return MM2INT(get<double>(key)); // The settings are all in millimetres, but we need to interpret them as microns.
+    const double value = get<double>(key); // MM2INT evaluates its argument several times, so look the value up only once.
+    return MM2INT(value); // The settings are all in millimetres, but we need to interpret them as microns.
 }
 
 template<>
-AngleRadians Settings::get<AngleRadians>(const std::string& key) const
+AngleRadians Settings::get<AngleRadians>(const SettingKey& key) const
 {
     return get<double>(key) * std::numbers::pi / 180; // The settings are all in degrees, but we need to interpret them as radians.
 }
 
 template<>
-AngleDegrees Settings::get<AngleDegrees>(const std::string& key) const
+AngleDegrees Settings::get<AngleDegrees>(const SettingKey& key) const
 {
     return get<double>(key);
 }
 
 template<>
-Temperature Settings::get<Temperature>(const std::string& key) const
+Temperature Settings::get<Temperature>(const SettingKey& key) const
 {
     return get<double>(key);
 }
 
 template<>
-Velocity Settings::get<Velocity>(const std::string& key) const
+Velocity Settings::get<Velocity>(const SettingKey& key) const
 {
     return get<double>(key);
 }
 
 template<>
-Acceleration Settings::get<Acceleration>(const std::string& key) const
+Acceleration Settings::get<Acceleration>(const SettingKey& key) const
 {
     return get<double>(key);
 }
 
 template<>
-Ratio Settings::get<Ratio>(const std::string& key) const
+Ratio Settings::get<Ratio>(const SettingKey& key) const
 {
     return get<double>(key) / 100.0; // The settings are all in percentages, but we need to interpret them as ratios.
 }
 
 template<>
-Duration Settings::get<Duration>(const std::string& key) const
+Duration Settings::get<Duration>(const SettingKey& key) const
 {
     return get<double>(key);
 }
 
 template<>
-DraftShieldHeightLimitation Settings::get<DraftShieldHeightLimitation>(const std::string& key) const
+DraftShieldHeightLimitation Settings::get<DraftShieldHeightLimitation>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -220,7 +464,7 @@ DraftShieldHeightLimitation Settings::get<DraftShieldHeightLimitation>(const std
 }
 
 template<>
-FlowTempGraph Settings::get<FlowTempGraph>(const std::string& key) const
+FlowTempGraph Settings::get<FlowTempGraph>(const SettingKey& key) const
 {
     std::string value_string = get<std::string>(key);
 
@@ -260,7 +504,7 @@ FlowTempGraph Settings::get<FlowTempGraph>(const std::string& key) const
         }
         catch (const std::invalid_argument& e)
         {
-            spdlog::error("Couldn't read 2D graph element [{},{}] in setting {}. Ignored.", first_substring, second_substring, key);
+            spdlog::error("Couldn't read 2D graph element [{},{}] in setting {}. Ignored.", first_substring, second_substring, key.name());
         }
     }
 
@@ -268,7 +512,7 @@ FlowTempGraph Settings::get<FlowTempGraph>(const std::string& key) const
 }
 
 template<>
-Shape Settings::get<Shape>(const std::string& key) const
+Shape Settings::get<Shape>(const SettingKey& key) const
 {
     std::string value_string = get<std::string>(key);
 
@@ -316,7 +560,7 @@ Shape Settings::get<Shape>(const std::string& key) const
                 }
                 catch (const std::invalid_argument& e)
                 {
-                    spdlog::error("Couldn't read 2D graph element [{},{}] in setting '{}'. Ignored.\n", first_substring.c_str(), second_substring.c_str(), key.c_str());
+                    spdlog::error("Couldn't read 2D graph element [{},{}] in setting '{}'. Ignored.\n", first_substring.c_str(), second_substring.c_str(), key.name().c_str());
                 }
                 if (match_iter == rend)
                 {
@@ -329,7 +573,7 @@ Shape Settings::get<Shape>(const std::string& key) const
 }
 
 template<>
-Matrix4x3D Settings::get<Matrix4x3D>(const std::string& key) const
+Matrix4x3D Settings::get<Matrix4x3D>(const SettingKey& key) const
 {
     const std::string value_string = get<std::string>(key);
 
@@ -370,7 +614,7 @@ Matrix4x3D Settings::get<Matrix4x3D>(const std::string& key) const
 }
 
 template<>
-EGCodeFlavor Settings::get<EGCodeFlavor>(const std::string& key) const
+EGCodeFlavor Settings::get<EGCodeFlavor>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -404,7 +648,7 @@ EGCodeFlavor Settings::get<EGCodeFlavor>(const std::string& key) const
 }
 
 template<>
-EFillMethod Settings::get<EFillMethod>(const std::string& key) const
+EFillMethod Settings::get<EFillMethod>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -452,7 +696,7 @@ EFillMethod Settings::get<EFillMethod>(const std::string& key) const
 }
 
 template<>
-EPlatformAdhesion Settings::get<EPlatformAdhesion>(const std::string& key) const
+EPlatformAdhesion Settings::get<EPlatformAdhesion>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -474,7 +718,7 @@ EPlatformAdhesion Settings::get<EPlatformAdhesion>(const std::string& key) const
 }
 
 template<>
-ESupportType Settings::get<ESupportType>(const std::string& key) const
+ESupportType Settings::get<ESupportType>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -494,7 +738,7 @@ ESupportType Settings::get<ESupportType>(const std::string& key) const
 }
 
 template<>
-ESupportStructure Settings::get<ESupportStructure>(const std::string& key) const
+ESupportStructure Settings::get<ESupportStructure>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -513,7 +757,7 @@ ESupportStructure Settings::get<ESupportStructure>(const std::string& key) const
 
 
 template<>
-EZSeamType Settings::get<EZSeamType>(const std::string& key) const
+EZSeamType Settings::get<EZSeamType>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -535,7 +779,7 @@ EZSeamType Settings::get<EZSeamType>(const std::string& key) const
 }
 
 template<>
-EZSeamCornerPrefType Settings::get<EZSeamCornerPrefType>(const std::string& key) const
+EZSeamCornerPrefType Settings::get<EZSeamCornerPrefType>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -556,7 +800,7 @@ EZSeamCornerPrefType Settings::get<EZSeamCornerPrefType>(const std::string& key)
 }
 
 template<>
-ESurfaceMode Settings::get<ESurfaceMode>(const std::string& key) const
+ESurfaceMode Settings::get<ESurfaceMode>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -576,7 +820,7 @@ ESurfaceMode Settings::get<ESurfaceMode>(const std::string& key) const
 }
 
 template<>
-FillPerimeterGapMode Settings::get<FillPerimeterGapMode>(const std::string& key) const
+FillPerimeterGapMode Settings::get<FillPerimeterGapMode>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -594,7 +838,7 @@ FillPerimeterGapMode Settings::get<FillPerimeterGapMode>(const std::string& key)
 }
 
 template<>
-BuildPlateShape Settings::get<BuildPlateShape>(const std::string& key) const
+BuildPlateShape Settings::get<BuildPlateShape>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -612,7 +856,7 @@ BuildPlateShape Settings::get<BuildPlateShape>(const std::string& key) const
 }
 
 template<>
-CombingMode Settings::get<CombingMode>(const std::string& key) const
+CombingMode Settings::get<CombingMode>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -636,7 +880,7 @@ CombingMode Settings::get<CombingMode>(const std::string& key) const
 }
 
 template<>
-SupportDistPriority Settings::get<SupportDistPriority>(const std::string& key) const
+SupportDistPriority Settings::get<SupportDistPriority>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -654,7 +898,7 @@ SupportDistPriority Settings::get<SupportDistPriority>(const std::string& key) c
 }
 
 template<>
-SlicingTolerance Settings::get<SlicingTolerance>(const std::string& key) const
+SlicingTolerance Settings::get<SlicingTolerance>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -674,7 +918,7 @@ SlicingTolerance Settings::get<SlicingTolerance>(const std::string& key) const
 }
 
 template<>
-InsetDirection Settings::get<InsetDirection>(const std::string& key) const
+InsetDirection Settings::get<InsetDirection>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     using namespace cura::utils;
@@ -692,7 +936,7 @@ InsetDirection Settings::get<InsetDirection>(const std::string& key) const
 }
 
 template<>
-PrimeTowerMode Settings::get<PrimeTowerMode>(const std::string& key) const
+PrimeTowerMode Settings::get<PrimeTowerMode>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     if (value == "interleaved")
@@ -704,7 +948,7 @@ PrimeTowerMode Settings::get<PrimeTowerMode>(const std::string& key) const
 }
 
 template<>
-BrimLocation Settings::get<BrimLocation>(const std::string& key) const
+BrimLocation Settings::get<BrimLocation>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     if (value == "everywhere")
@@ -722,7 +966,7 @@ BrimLocation Settings::get<BrimLocation>(const std::string& key) const
 }
 
 template<>
-CoolDuringExtruderSwitch Settings::get<CoolDuringExtruderSwitch>(const std::string& key) const
+CoolDuringExtruderSwitch Settings::get<CoolDuringExtruderSwitch>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     if (value == "all_fans")
@@ -740,7 +984,7 @@ CoolDuringExtruderSwitch Settings::get<CoolDuringExtruderSwitch>(const std::stri
 }
 
 template<>
-InfillStartEndPreference Settings::get<InfillStartEndPreference>(const std::string& key) const
+InfillStartEndPreference Settings::get<InfillStartEndPreference>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     if (value == "end_close_to_seam")
@@ -758,7 +1002,7 @@ InfillStartEndPreference Settings::get<InfillStartEndPreference>(const std::stri
 }
 
 template<>
-RetractBeforeOuterWall Settings::get<RetractBeforeOuterWall>(const std::string& key) const
+RetractBeforeOuterWall Settings::get<RetractBeforeOuterWall>(const SettingKey& key) const
 {
     const std::string& value = get<std::string>(key);
     if (value == "force_retracted")
@@ -780,7 +1024,7 @@ RetractBeforeOuterWall Settings::get<RetractBeforeOuterWall>(const std::string&
 }
 
 template<>
-std::vector<double> Settings::get<std::vector<double>>(const std::string& key) const
+std::vector<double> Settings::get<std::vector<double>>(const SettingKey& key) const
 {
     const std::string& value_string = get<std::string>(key);
 
@@ -814,7 +1058,7 @@ std::vector<double> Settings::get<std::vector<double>>(const std::string& key) c
             }
             catch (const std::invalid_argument& e)
             {
-                spdlog::error("Couldn't read floating point value ({}) in setting {}. Ignored.", value, key);
+                spdlog::error("Couldn't read floating point value ({}) in setting {}. Ignored.", value, key.name());
             }
         }
     }
@@ -822,7 +1066,7 @@ std::vector<double> Settings::get<std::vector<double>>(const std::string& key) c
 }
 
 template<>
-std::vector<Ratio> Settings::get<std::vector<Ratio>>(const std::string& key) const
+std::vector<Ratio> Settings::get<std::vector<Ratio>>(const SettingKey& key) const
 {
     auto values_double = get<std::vector<double>>(key);
 
@@ -838,7 +1082,7 @@ std::vector<Ratio> Settings::get<std::vector<Ratio>>(const std::string& key) con
 }
 
 template<>
-std::vector<int> Settings::get<std::vector<int>>(const std::string& key) const
+std::vector<int> Settings::get<std::vector<int>>(const SettingKey& key) const
 {
     std::vector<double> values_doubles = get<std::vector<double>>(key);
     std::vector<int> values_ints;
@@ -851,7 +1095,7 @@ std::vector<int> Settings::get<std::vector<int>>(const std::string& key) const
 }
 
 template<>
-std::vector<AngleDegrees> Settings::get<std::vector<AngleDegrees>>(const std::string& key) const
+std::vector<AngleDegrees> Settings::get<std::vector<AngleDegrees>>(const SettingKey& key) const
 {
     std::vector<double> values_doubles = get<std::vector<double>>(key);
     return std::vector<AngleDegrees>(values_doubles.begin(), values_doubles.end()); // Cast them to AngleDegrees.
@@ -894,13 +1138,15 @@ bool Settings::has(const std::string& key, const bool parent_lookup) const
 void Settings::setParent(const Settings* new_parent)
 {
     parent = new_parent;
+    resolved_values_.clear();
+    invalidateResolvedValues();
 }
 
-std::string Settings::getWithoutLimiting(const std::string& key) const
+std::string Settings::getWithoutLimiting(const SettingKey& key) const
 {
-    if (settings.find(key) != settings.end())
+    if (const auto value = settings.find(key.name()); value != settings.end())
     {
-        return settings.at(key);
+        return value->second;
     }
     else if (parent)
     {
@@ -908,7 +1154,7 @@ std::string Settings::getWithoutLimiting(const std::string& key) const
     }
     else
     {
-        spdlog::error("Trying to retrieve setting with no value given: {}", key);
+        spdlog::error("Trying to retrieve setting with no value given: {}", key.name());
         std::exit(2);
     }
 }
@@ -934,4 +1180,25 @@ std::vector<std::string> Settings::getKeys() const
     return ranges::views::keys(settings) | ranges::to_vector;
 }
 
+std::vector<std::string> Settings::getDifferingKeys(const Settings& other) const
+{
+    std::vector<std::string> result;
+    for (const auto& [key, value] : settings)
+    {
+        const auto other_value = other.settings.find(key);
+        if (other_value == other.settings.end() || other_value->second != value)
+        {
+            result.push_back(key);
+        }
+    }
+    for (const auto& [key, value] : other.settings)
+    {
+        if (! settings.contains(key))
+        {
+            result.push_back(key);
+        }
+    }
+    return result;
+}
+
 } // namespace cura
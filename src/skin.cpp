@@ -4,6 +4,7 @@
 #include "skin.h"
 
 #include <cmath> // std::ceil
+#include <unordered_set>
 
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/equal.hpp>
@@ -27,6 +28,172 @@
 namespace cura
 {
 
+OutlineWindowIntersections::OutlineWindowIntersections(const SliceMeshStorage& mesh, size_t window_size, size_t max_stored_points)
+    : mesh_(mesh)
+    , window_size_(window_size)
+    , prefix_intersections_(mesh.layers.size())
+    , suffix_intersections_(mesh.layers.size())
+    , block_points_(getBlockCount(), 0)
+    , max_stored_points_(max_stored_points)
+    , count_lookups_(spdlog::should_log(spdlog::level::debug))
+{
+}
+
+size_t OutlineWindowIntersections::getBlockCount() const
+{
+    return (mesh_.layers.size() + window_size_.value - 1) / window_size_.value;
+}
+
+size_t OutlineWindowIntersections::getBlockIndex(const LayerIndex layer_nr) const
+{
+    return layer_nr.value / window_size_.value;
+}
+
+void OutlineWindowIntersections::computeBlock(const size_t block_idx)
+{
+    const LayerIndex layer_count = LayerIndex(mesh_.layers.size());
+    const LayerIndex block_start = LayerIndex(block_idx) * window_size_;
+    const LayerIndex block_end = std::min(block_start + window_size_, layer_count) - 1;
+    const size_t block_size = block_end - block_start + 1;
+    std::vector<Intersection> outlines;
+    for (LayerIndex layer_nr = block_start; layer_nr <= block_end; ++layer_nr)
+    {
+        outlines.push_back(Intersection{ .shape = getLayerOutline(layer_nr), .exact = true });
+    }
+
+    std::vector<Intersection> prefixes(block_size);
+    prefixes.front() = outlines.front();
+    for (size_t idx = 1; idx < block_size; ++idx)
+    {
+        prefixes[idx] = intersect(prefixes[idx - 1], outlines[idx]);
+    }
+    std::vector<Intersection> suffixes(block_size);
+    suffixes.back() = std::move(outlines.back());
+    for (size_t idx = block_size - 1; idx > 0; --idx)
+    {
+        suffixes[idx - 1] = intersect(suffixes[idx], outlines[idx - 1]);
+    }
+
+    size_t point_count = 0;
+    for (const std::vector<Intersection>* intersections : { &prefixes, &suffixes })
+    {
+        for (const Intersection& intersection : *intersections)
+        {
+            point_count += intersection.shape.pointCount();
+        }
+    }
+    size_t stored_points = stored_points_.load(std::memory_order_relaxed);
+    do
+    {
+        if (stored_points + point_count > max_stored_points_)
+        {
+            return; // Leave the intersections of this block inexact, so the skin of its layers is computed layer by layer.
+        }
+    } while (! stored_points_.compare_exchange_weak(stored_points, stored_points + point_count, std::memory_order_relaxed));
+    block_points_[block_idx] = point_count;
+
+    std::move(prefixes.begin(), prefixes.end(), prefix_intersections_.begin() + block_start);
+    std::move(suffixes.begin(), suffixes.end(), suffix_intersections_.begin() + block_start);
+}
+
+void OutlineWindowIntersections::releaseBlock(const size_t block_idx)
+{
+    const LayerIndex block_start = LayerIndex(block_idx) * window_size_;
+    const LayerIndex block_end = std::min(block_start + window_size_, LayerIndex(mesh_.layers.size())) - 1;
+    for (LayerIndex layer_nr = block_start; layer_nr <= block_end; ++layer_nr)
+    {
+        prefix_intersections_[layer_nr] = Intersection{};
+        suffix_intersections_[layer_nr] = Intersection{};
+    }
+    stored_points_.fetch_sub(block_points_[block_idx], std::memory_order_relaxed);
+    block_points_[block_idx] = 0;
+}
+
+std::optional<Shape> OutlineWindowIntersections::getIntersection(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr) const
+{
+    if (last_layer_nr >= LayerIndex(mesh_.layers.size()) || first_layer_nr > last_layer_nr)
+    {
+        return Shape();
+    }
+    const LayerIndex first_block_start = first_layer_nr - first_layer_nr.value % window_size_.value;
+    const LayerIndex last_block_start = last_layer_nr - last_layer_nr.value % window_size_.value;
+    const Intersection* intersection = nullptr;
+    Intersection window;
+    if (first_block_start == last_block_start)
+    {
+        if (first_layer_nr == first_block_start)
+        {
+            intersection = &prefix_intersections_[last_layer_nr];
+        }
+        else if (last_layer_nr == std::min(first_block_start + window_size_, LayerIndex(mesh_.layers.size())) - 1)
+        {
+            intersection = &suffix_intersections_[first_layer_nr];
+        }
+    }
+    else if (last_block_start == first_block_start + window_size_)
+    {
+        window = intersect(suffix_intersections_[first_layer_nr], prefix_intersections_[last_layer_nr]);
+        intersection = &window;
+    }
+    const bool hit = intersection != nullptr && intersection->exact;
+    if (count_lookups_)
+    {
+        lookup_count_.fetch_add(1, std::memory_order_relaxed);
+        hit_count_.fetch_add(hit ? 1 : 0, std::memory_order_relaxed);
+    }
+    if (! hit)
+    {
+        return std::nullopt;
+    }
+    return intersection->shape;
+}
+
+std::pair<size_t, size_t> OutlineWindowIntersections::getLookupAndHitCount() const
+{
+    return { lookup_count_.load(std::memory_order_relaxed), hit_count_.load(std::memory_order_relaxed) };
+}
+
+OutlineWindowIntersections::Intersection OutlineWindowIntersections::intersect(const Intersection& a, const Intersection& b)
+{
+    if (! a.exact || ! b.exact)
+    {
+        return Intersection{};
+    }
+    Intersection result{ .shape = a.shape.intersection(b.shape), .exact = true };
+
+    // If Clipper didn't create any vertex, it didn't round any either. The result is then the same area with the same vertices, whichever
+    // order the outlines are intersected in.
+    std::unordered_set<Point2LL> vertices;
+    for (const Shape* shape : { &a.shape, &b.shape })
+    {
+        for (const Polygon& polygon : *shape)
+        {
+            vertices.insert(polygon.begin(), polygon.end());
+        }
+    }
+    for (const Polygon& polygon : result.shape)
+    {
+        for (const Point2LL& point : polygon)
+        {
+            if (! vertices.contains(point))
+            {
+                return Intersection{};
+            }
+        }
+    }
+    return result;
+}
+
+Shape OutlineWindowIntersections::getLayerOutline(const LayerIndex layer_nr) const
+{
+    Shape result;
+    for (const SliceLayerPart& part : mesh_.layers[layer_nr].parts)
+    {
+        result.push_back(part.outline);
+    }
+    return result;
+}
+
 coord_t SkinInfillAreaComputation::getSkinLineWidth(const SliceMeshStorage& mesh, const LayerIndex& layer_nr)
 {
     coord_t skin_line_width = mesh.settings.get<coord_t>("skin_line_width");
@@ -38,7 +205,12 @@ coord_t SkinInfillAreaComputation::getSkinLineWidth(const SliceMeshStorage& mesh
     return skin_line_width;
 }
 
-SkinInfillAreaComputation::SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill)
+SkinInfillAreaComputation::SkinInfillAreaComputation(
+    const LayerIndex& layer_nr,
+    SliceMeshStorage& mesh,
+    bool process_infill,
+    const OutlineWindowIntersections* top_windows,
+    const OutlineWindowIntersections* bottom_windows)
     : layer_nr_(layer_nr)
     , mesh_(mesh)
     , bottom_layer_count_(mesh.settings.get<size_t>("bottom_layers"))
@@ -51,6 +223,8 @@ SkinInfillAreaComputation::SkinInfillAreaComputation(const LayerIndex& layer_nr,
     , bottom_skin_preshrink_(mesh.settings.get<coord_t>("bottom_skin_preshrink"))
     , top_skin_expand_distance_(mesh.settings.get<coord_t>("top_skin_expand_distance"))
     , bottom_skin_expand_distance_(mesh.settings.get<coord_t>("bottom_skin_expand_distance"))
+    , top_windows_(top_windows)
+    , bottom_windows_(bottom_windows)
 {
 }
 
@@ -78,6 +252,37 @@ Shape SkinInfillAreaComputation::getOutlineOnLayer(const SliceLayerPart& part_he
     return result;
 }
 
+/*
+ * This function is executed in a parallel region based on layer_nr.
+ * When modifying make sure any changes does not introduce data races.
+ *
+ * this function only reads the shared, precomputed intersections.
+ */
+std::optional<Shape> SkinInfillAreaComputation::getOutlineIntersection(
+    const SliceLayerPart& part_here,
+    const OutlineWindowIntersections& windows,
+    const LayerIndex first_layer_nr,
+    const LayerIndex last_layer_nr)
+{
+    const std::optional<Shape> intersection = windows.getIntersection(first_layer_nr, last_layer_nr);
+    if (! intersection)
+    {
+        return std::nullopt;
+    }
+    // Only keep the polygons that can overlap with this part, like getOutlineOnLayer does with the parts. The holes lie within their outer
+    // polygon, so an outer polygon is never dropped while one of its holes is kept. The polygons that getOutlineOnLayer would keep on top of
+    // these lie outside the box of this part, so they don't change the skin that is subtracted from.
+    Shape result;
+    for (const Polygon& polygon : *intersection)
+    {
+        if (part_here.boundaryBox.hit(AABB(polygon)))
+        {
+            result.push_back(polygon);
+        }
+    }
+    return result;
+}
+
 /*
  * This function is executed in a parallel region based on layer_nr.
  * When modifying make sure any changes does not introduce data races.
@@ -190,12 +395,25 @@ void SkinInfillAreaComputation::calculateBottomSkin(const SliceLayerPart& part,
         return; // don't subtract anything form the downskin
     }
     LayerIndex bottom_check_start_layer_idx{ std::max(LayerIndex{ 0 }, LayerIndex{ layer_nr_ - bottom_layer_count_ }) };
-    Shape not_air = getOutlineOnLayer(part, bottom_check_start_layer_idx);
-    if (! no_small_gaps_heuristic_)
+    std::optional<Shape> shared_not_air;
+    if (! no_small_gaps_heuristic_ && bottom_windows_ != nullptr)
+    {
+        shared_not_air = getOutlineIntersection(part, *bottom_windows_, bottom_check_start_layer_idx, std::max(bottom_check_start_layer_idx, layer_nr_ - 1));
+    }
+    Shape not_air;
+    if (shared_not_air)
     {
-        for (int downskin_layer_nr = bottom_check_start_layer_idx + 1; downskin_layer_nr < layer_nr_; downskin_layer_nr++)
+        not_air = std::move(*shared_not_air);
+    }
+    else
+    {
+        not_air = getOutlineOnLayer(part, bottom_check_start_layer_idx);
+        if (! no_small_gaps_heuristic_)
         {
-            not_air = not_air.intersection(getOutlineOnLayer(part, downskin_layer_nr));
+            for (int downskin_layer_nr = bottom_check_start_layer_idx + 1; downskin_layer_nr < layer_nr_; downskin_layer_nr++)
+            {
+                not_air = not_air.intersection(getOutlineOnLayer(part, downskin_layer_nr));
+            }
         }
     }
     const double min_infill_area = mesh_.settings.get<double>("min_infill_area");
@@ -215,12 +433,25 @@ void SkinInfillAreaComputation::calculateTopSkin(const SliceLayerPart& part, Sha
         return;
     }
 
-    Shape not_air = getOutlineOnLayer(part, layer_nr_ + top_layer_count_);
-    if (! no_small_gaps_heuristic_)
+    std::optional<Shape> shared_not_air;
+    if (! no_small_gaps_heuristic_ && top_windows_ != nullptr)
     {
-        for (int upskin_layer_nr = layer_nr_ + 1; upskin_layer_nr < layer_nr_ + top_layer_count_; upskin_layer_nr++)
+        shared_not_air = getOutlineIntersection(part, *top_windows_, layer_nr_ + 1, layer_nr_ + top_layer_count_);
+    }
+    Shape not_air;
+    if (shared_not_air)
+    {
+        not_air = std::move(*shared_not_air);
+    }
+    else
+    {
+        not_air = getOutlineOnLayer(part, layer_nr_ + top_layer_count_);
+        if (! no_small_gaps_heuristic_)
         {
-            not_air = not_air.intersection(getOutlineOnLayer(part, upskin_layer_nr));
+            for (int upskin_layer_nr = layer_nr_ + 1; upskin_layer_nr < layer_nr_ + top_layer_count_; upskin_layer_nr++)
+            {
+                not_air = not_air.intersection(getOutlineOnLayer(part, upskin_layer_nr));
+            }
         }
     }
 
@@ -68,6 +68,16 @@ bool SliceLayerPart::hasWallAtInsetIndex(size_t inset_idx) const
     return false;
 }
 
+void SliceLayer::releaseGeometry()
+{
+    // Swap with empty containers rather than clearing them, so that the capacity is freed as well.
+    std::vector<SliceLayerPart>().swap(parts);
+    open_polylines = OpenLinesSet();
+    texture_data_provider_.reset();
+    top_surface = TopSurface();
+    bottom_surface = Shape();
+}
+
 SliceLayer::~SliceLayer()
 {
 }
@@ -759,6 +769,45 @@ void SliceDataStorage::initializePrimeTower()
     prime_tower_ = PrimeTower::createPrimeTower(*this);
 }
 
+void SliceDataStorage::releaseLayer(const LayerIndex layer_nr)
+{
+    if (layer_nr < 0)
+    {
+        return;
+    }
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
+    {
+        if (layer_nr < LayerIndex(mesh->layers.size()))
+        {
+            mesh->layers[layer_nr].releaseGeometry();
+        }
+        if (layer_nr < LayerIndex(mesh->overhang_areas.size()))
+        {
+            mesh->overhang_areas[layer_nr] = Shape();
+        }
+        if (layer_nr < LayerIndex(mesh->full_overhang_areas.size()))
+        {
+            mesh->full_overhang_areas[layer_nr] = Shape();
+        }
+        if (layer_nr < LayerIndex(mesh->overhang_points.size()))
+        {
+            std::vector<Shape>().swap(mesh->overhang_points[layer_nr]);
+        }
+    }
+    if (layer_nr < LayerIndex(support.supportLayers.size()))
+    {
+        support.supportLayers[layer_nr] = SupportLayer();
+    }
+    if (layer_nr < LayerIndex(ooze_shield.size()))
+    {
+        ooze_shield[layer_nr] = Shape();
+    }
+    if (layer_nr < LayerIndex(spiralize_wall_outlines.size()))
+    {
+        spiralize_wall_outlines[layer_nr] = nullptr; // Pointed into the parts of the layer.
+    }
+}
+
 void SupportLayer::excludeAreasFromSupportInfillAreas(const Shape& exclude_polygons, const AABB& exclude_polygons_boundary_box)
 {
     // record the indexes that need to be removed and do that after
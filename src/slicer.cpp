@@ -6,6 +6,7 @@
 #include <algorithm> // remove_if
 #include <cstdio>
 #include <numbers>
+#include <numeric> // iota
 
 #include <scripta/logger.h>
 #include <spdlog/spdlog.h>
@@ -842,23 +843,146 @@ Slicer::Slicer(
     spdlog::info("Make polygons took {:03.3f} seconds", slice_timer.restart());
 }
 
+#ifdef BUILD_TESTS
+[[maybe_unused]] void Slicer::sliceSegments(const Mesh& mesh, const SlicingTolerance slicing_tolerance, const bool full_scan, std::vector<SlicerLayer>& layers)
+{
+    const std::vector<std::pair<int32_t, int32_t>> zbbox = buildZHeightsForFaces(mesh);
+    if (! full_scan)
+    {
+        buildSegments(mesh, zbbox, slicing_tolerance, layers);
+        return;
+    }
+
+    std::vector<std::vector<uint32_t>> faces_of_layers(layers.size());
+    cura::parallel_for(
+        size_t(0),
+        layers.size(),
+        [&](const size_t layer_idx)
+        {
+            const coord_t z = layers[layer_idx].z_;
+            for (uint32_t face_idx = 0; face_idx < zbbox.size(); ++face_idx)
+            {
+                if (z >= zbbox[face_idx].first && z <= zbbox[face_idx].second)
+                {
+                    faces_of_layers[layer_idx].push_back(face_idx);
+                }
+            }
+        });
+
+    FacesPerLayer faces_per_layer;
+    faces_per_layer.first.push_back(0);
+    for (const std::vector<uint32_t>& faces_of_layer : faces_of_layers)
+    {
+        faces_per_layer.second.insert(faces_per_layer.second.end(), faces_of_layer.begin(), faces_of_layer.end());
+        faces_per_layer.first.push_back(faces_per_layer.second.size());
+    }
+    buildSegments(mesh, faces_per_layer, slicing_tolerance, layers);
+}
+#endif
+
+Slicer::FacesPerLayer Slicer::buildFacesPerLayer(const std::vector<std::pair<int32_t, int32_t>>& zbbox, const std::vector<SlicerLayer>& layers)
+{
+    // Layer heights are normally increasing, but sort them anyway so that the binary searches below are always valid.
+    std::vector<size_t> layer_order(layers.size());
+    std::iota(layer_order.begin(), layer_order.end(), 0);
+    std::stable_sort(
+        layer_order.begin(),
+        layer_order.end(),
+        [&layers](const size_t a, const size_t b)
+        {
+            return layers[a].z_ < layers[b].z_;
+        });
+    std::vector<coord_t> sorted_z(layers.size());
+    for (size_t position = 0; position < layer_order.size(); ++position)
+    {
+        sorted_z[position] = layers[layer_order[position]].z_;
+    }
+
+    // Every face spans a contiguous range of (sorted) layers: the ones with min_z <= z <= max_z.
+    const auto layer_span = [&sorted_z](const std::pair<int32_t, int32_t>& face_zbbox)
+    {
+        const auto first = std::lower_bound(sorted_z.begin(), sorted_z.end(), static_cast<coord_t>(face_zbbox.first));
+        const auto last = std::upper_bound(first, sorted_z.end(), static_cast<coord_t>(face_zbbox.second));
+        return std::make_pair(static_cast<size_t>(first - sorted_z.begin()), static_cast<size_t>(last - sorted_z.begin()));
+    };
+
+    // First sweep: count the faces per layer, by marking where each face enters and leaves the active set.
+    std::vector<int64_t> active_delta(layers.size() + 1, 0);
+    for (const std::pair<int32_t, int32_t>& face_zbbox : zbbox)
+    {
+        const auto [first, last] = layer_span(face_zbbox);
+        if (first < last)
+        {
+            active_delta[first]++;
+            active_delta[last]--;
+        }
+    }
+
+    std::vector<size_t> sorted_offsets(layers.size() + 1, 0);
+    int64_t active_count = 0;
+    for (size_t position = 0; position < layers.size(); ++position)
+    {
+        active_count += active_delta[position];
+        sorted_offsets[position + 1] = sorted_offsets[position] + static_cast<size_t>(active_count);
+    }
+
+    // Second sweep: fill in the face indices. Faces are visited in index order, so every layer lists its faces in the same order as a full scan would.
+    std::vector<uint32_t> sorted_faces(sorted_offsets.back());
+    std::vector<size_t> fill_position(sorted_offsets.begin(), sorted_offsets.end() - 1);
+    for (uint32_t face_idx = 0; face_idx < zbbox.size(); ++face_idx)
+    {
+        const auto [first, last] = layer_span(zbbox[face_idx]);
+        for (size_t position = first; position < last; ++position)
+        {
+            sorted_faces[fill_position[position]++] = face_idx;
+        }
+    }
+
+    // Re-index from sorted order back to the original layer order.
+    std::vector<size_t> layer_offsets(layers.size() + 1, 0);
+    for (size_t position = 0; position < layer_order.size(); ++position)
+    {
+        layer_offsets[layer_order[position] + 1] = sorted_offsets[position + 1] - sorted_offsets[position];
+    }
+    for (size_t layer_idx = 0; layer_idx < layers.size(); ++layer_idx)
+    {
+        layer_offsets[layer_idx + 1] += layer_offsets[layer_idx];
+    }
+    std::vector<uint32_t> layer_faces(sorted_faces.size());
+    for (size_t position = 0; position < layer_order.size(); ++position)
+    {
+        std::copy(
+            sorted_faces.begin() + static_cast<ptrdiff_t>(sorted_offsets[position]),
+            sorted_faces.begin() + static_cast<ptrdiff_t>(sorted_offsets[position + 1]),
+            layer_faces.begin() + static_cast<ptrdiff_t>(layer_offsets[layer_order[position]]));
+    }
+
+    return { std::move(layer_offsets), std::move(layer_faces) };
+}
+
 void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers)
 {
+    buildSegments(mesh, buildFacesPerLayer(zbbox, layers), slicing_tolerance, layers);
+}
+
+void Slicer::buildSegments(const Mesh& mesh, const FacesPerLayer& faces_per_layer, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers)
+{
+    const std::vector<size_t>& layer_offsets = faces_per_layer.first;
+    const std::vector<uint32_t>& layer_faces = faces_per_layer.second;
+
     cura::parallel_for(
-        layers,
-        [&](auto layer_it)
+        size_t(0),
+        layers.size(),
+        [&](const size_t layer_idx)
         {
-            SlicerLayer& layer = *layer_it;
+            SlicerLayer& layer = layers[layer_idx];
             const int32_t& z = layer.z_;
-            layer.segments_.reserve(100);
+            layer.segments_.reserve(layer_offsets[layer_idx + 1] - layer_offsets[layer_idx]);
 
-            // loop over all mesh faces
-            for (unsigned int face_idx = 0; face_idx < mesh.faces_.size(); face_idx++)
+            // loop over the mesh faces that span this layer
+            for (size_t face_entry = layer_offsets[layer_idx]; face_entry < layer_offsets[layer_idx + 1]; ++face_entry)
             {
-                if ((z < zbbox[face_idx].first) || (z > zbbox[face_idx].second))
-                {
-                    continue;
-                }
+                const unsigned int face_idx = layer_faces[face_entry];
 
                 // get all vertices per face
                 const MeshFace& face = mesh.faces_[face_idx];
@@ -45,9 +45,9 @@ namespace cura
 
 bool AreaSupport::handleSupportModifierMesh(SliceDataStorage& storage, const Settings& mesh_settings, const Slicer* slicer)
 {
-    const bool is_anti_overhang_mesh = mesh_settings.get<bool>("anti_overhang_mesh");
-    const bool is_support_mesh = mesh_settings.get<bool>("support_mesh");
-    const bool is_force_support_overhang_mesh = mesh_settings.has("force_support_overhang_mesh") && mesh_settings.get<bool>("force_support_overhang_mesh");
+    const bool is_anti_overhang_mesh = mesh_settings.get<bool>("anti_overhang_mesh"_setting);
+    const bool is_support_mesh = mesh_settings.get<bool>("support_mesh"_setting);
+    const bool is_force_support_overhang_mesh = mesh_settings.has("force_support_overhang_mesh") && mesh_settings.get<bool>("force_support_overhang_mesh"_setting);
     if (! is_anti_overhang_mesh && ! is_support_mesh && ! is_force_support_overhang_mesh)
     {
         return false;
@@ -70,7 +70,7 @@ bool AreaSupport::handleSupportModifierMesh(SliceDataStorage& storage, const Set
     {
         modifier_type = ModifierType::FORCE_OVERHANG;
     }
-    else if (mesh_settings.get<bool>("support_mesh_drop_down"))
+    else if (mesh_settings.get<bool>("support_mesh_drop_down"_setting))
     {
         modifier_type = ModifierType::SUPPORT_DROP_DOWN;
     }
@@ -116,11 +116,11 @@ void AreaSupport::splitGlobalSupportAreasIntoSupportInfillParts(SliceDataStorage
 
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const ExtruderTrain& infill_extruder = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr");
-    const EFillMethod support_pattern = infill_extruder.settings_.get<EFillMethod>("support_pattern");
-    const coord_t support_line_width = infill_extruder.settings_.get<coord_t>("support_line_width");
+    const EFillMethod support_pattern = infill_extruder.settings_.get<EFillMethod>("support_pattern"_setting);
+    const coord_t support_line_width = infill_extruder.settings_.get<coord_t>("support_line_width"_setting);
 
     // The wall line count is used for calculating insets, and we generate support infill patterns within the insets
-    const auto wall_thickness = infill_extruder.settings_.get<coord_t>("support_wall_thickness");
+    const auto wall_thickness = infill_extruder.settings_.get<coord_t>("support_wall_thickness"_setting);
 
     // Generate separate support islands
     for (LayerIndex layer_nr = 0; layer_nr < total_layer_count - 1; ++layer_nr)
@@ -140,13 +140,13 @@ void AreaSupport::splitGlobalSupportAreasIntoSupportInfillParts(SliceDataStorage
         }
 
         coord_t support_line_width_here = support_line_width;
-        if (layer_nr == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") != EPlatformAdhesion::RAFT)
+        if (layer_nr == 0 && mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting) != EPlatformAdhesion::RAFT)
         {
-            support_line_width_here *= infill_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
+            support_line_width_here *= infill_extruder.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
         }
         // We don't generate insets and infill area for the parts yet because later the skirt/brim and prime
         // tower will remove themselves from the support, so the outlines of the parts can be changed.
-        const coord_t layer_height = infill_extruder.settings_.get<coord_t>("layer_height");
+        const coord_t layer_height = infill_extruder.settings_.get<coord_t>("layer_height"_setting);
         storage.support.supportLayers[layer_nr]
             .fillInfillParts(layer_nr, global_support_areas_per_layer, layer_height, storage.meshes, support_line_width_here, wall_thickness_this_layer);
     }
@@ -173,20 +173,20 @@ void AreaSupport::generateSupportBase(SliceDataStorage& storage)
     const Settings& global_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const Settings& settings = global_settings.get<ExtruderTrain&>("support_extruder_nr").settings_;
 
-    const auto layer_height = settings.get<coord_t>("layer_height");
-    const auto support_line_width = settings.get<coord_t>("support_line_width");
-    const auto support_xy_distance = settings.get<coord_t>("support_xy_distance");
-    const auto adhesion_type = settings.get<EPlatformAdhesion>("adhesion_type");
+    const auto layer_height = settings.get<coord_t>("layer_height"_setting);
+    const auto support_line_width = settings.get<coord_t>("support_line_width"_setting);
+    const auto support_xy_distance = settings.get<coord_t>("support_xy_distance"_setting);
+    const auto adhesion_type = settings.get<EPlatformAdhesion>("adhesion_type"_setting);
 
-    const auto support_outer_brim_enable = settings.get<bool>("support_outer_brim_enable");
-    const auto base_outside_width = settings.get<coord_t>("support_base_outside_width");
-    const auto base_outside_height = settings.get<coord_t>("support_outside_base_height");
-    const auto base_outside_curve_magnitude = settings.get<double>("support_outside_base_curve_magnitude");
+    const auto support_outer_brim_enable = settings.get<bool>("support_outer_brim_enable"_setting);
+    const auto base_outside_width = settings.get<coord_t>("support_base_outside_width"_setting);
+    const auto base_outside_height = settings.get<coord_t>("support_outside_base_height"_setting);
+    const auto base_outside_curve_magnitude = settings.get<double>("support_outside_base_curve_magnitude"_setting);
 
-    const auto support_inner_brim_enable = settings.get<bool>("support_brim_enable");
-    const auto base_inside_width = settings.get<coord_t>("support_base_inside_width");
-    const auto base_inside_height = settings.get<coord_t>("support_inside_base_height");
-    const auto base_inside_curve_magnitude = settings.get<double>("support_inside_base_curve_magnitude");
+    const auto support_inner_brim_enable = settings.get<bool>("support_brim_enable"_setting);
+    const auto base_inside_width = settings.get<coord_t>("support_base_inside_width"_setting);
+    const auto base_inside_height = settings.get<coord_t>("support_inside_base_height"_setting);
+    const auto base_inside_curve_magnitude = settings.get<double>("support_inside_base_curve_magnitude"_setting);
 
     const bool has_base_inside = support_inner_brim_enable && base_inside_width > 0 && base_inside_height >= layer_height;
     const LayerIndex max_inside_layer = has_base_inside ? base_inside_height / layer_height : 0;
@@ -359,17 +359,17 @@ void AreaSupport::generateGradualSupport(SliceDataStorage& storage)
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const size_t total_layer_count = storage.print_layer_count;
     const ExtruderTrain& infill_extruder = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr");
-    const coord_t gradual_support_step_height = infill_extruder.settings_.get<coord_t>("gradual_support_infill_step_height");
-    const size_t max_density_steps = infill_extruder.settings_.get<size_t>("gradual_support_infill_steps");
+    const coord_t gradual_support_step_height = infill_extruder.settings_.get<coord_t>("gradual_support_infill_step_height"_setting);
+    const size_t max_density_steps = infill_extruder.settings_.get<size_t>("gradual_support_infill_steps"_setting);
 
-    const coord_t wall_width = infill_extruder.settings_.get<coord_t>("support_line_width");
-    const bool is_connected = infill_extruder.settings_.get<bool>("zig_zaggify_infill") || infill_extruder.settings_.get<EFillMethod>("infill_pattern") == EFillMethod::ZIG_ZAG;
+    const coord_t wall_width = infill_extruder.settings_.get<coord_t>("support_line_width"_setting);
+    const bool is_connected = infill_extruder.settings_.get<bool>("zig_zaggify_infill"_setting) || infill_extruder.settings_.get<EFillMethod>("infill_pattern"_setting) == EFillMethod::ZIG_ZAG;
     const Simplify simplifier(infill_extruder.settings_);
 
     // no early-out for this function; it needs to initialize the [infill_area_per_combine_per_density]
     double layer_skip_count{ 8.0 }; // skip every so many layers as to ignore small gaps in the model making computation more easy
     size_t gradual_support_step_layer_count
-        = round_divide(gradual_support_step_height, mesh_group_settings.get<coord_t>("layer_height")); // The difference in layer count between consecutive density infill areas.
+        = round_divide(gradual_support_step_height, mesh_group_settings.get<coord_t>("layer_height"_setting)); // The difference in layer count between consecutive density infill areas.
 
     // make gradual_support_step_height divisable by layer_skip_count
     const auto n_skip_steps_per_gradual_step
@@ -500,11 +500,11 @@ void AreaSupport::combineSupportInfillLayers(SliceDataStorage& storage)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const unsigned int total_layer_count = storage.print_layer_count;
-    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height");
+    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height"_setting);
     // How many support infill layers to combine to obtain the requested sparse thickness.
     const ExtruderTrain& infill_extruder = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr");
     const size_t combine_layers_amount
-        = std::max(uint64_t(1), round_divide(infill_extruder.settings_.get<coord_t>("support_infill_sparse_thickness"), std::max(layer_height, coord_t(1))));
+        = std::max(uint64_t(1), round_divide(infill_extruder.settings_.get<coord_t>("support_infill_sparse_thickness"_setting), std::max(layer_height, coord_t(1))));
     if (combine_layers_amount <= 1)
     {
         return;
@@ -601,7 +601,7 @@ void AreaSupport::combineSupportInfillLayers(SliceDataStorage& storage)
 
 void AreaSupport::cleanup(SliceDataStorage& storage)
 {
-    const coord_t support_line_width = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("support_line_width");
+    const coord_t support_line_width = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("support_line_width"_setting);
     for (LayerIndex layer_nr = 0; layer_nr < storage.support.supportLayers.size(); layer_nr++)
     {
         SupportLayer& layer = storage.support.supportLayers[layer_nr];
@@ -647,8 +647,8 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
     Shape joined;
 
     const Settings& infill_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings_;
-    const AngleRadians conical_support_angle = infill_settings.get<AngleRadians>("support_conical_angle");
-    const coord_t layer_thickness = infill_settings.get<coord_t>("layer_height");
+    const AngleRadians conical_support_angle = infill_settings.get<AngleRadians>("support_conical_angle"_setting);
+    const coord_t layer_thickness = infill_settings.get<coord_t>("layer_height"_setting);
     coord_t conical_support_offset;
     if (conical_support_angle > 0)
     { // outward ==> wider base than overhang
@@ -658,13 +658,13 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
     { // inward ==> smaller base than overhang
         conical_support_offset = boundedTan(-conical_support_angle) * layer_thickness;
     }
-    const bool conical_support = infill_settings.get<bool>("support_conical_enabled") && conical_support_angle != 0;
+    const bool conical_support = infill_settings.get<bool>("support_conical_enabled"_setting) && conical_support_angle != 0;
     if (conical_support)
     {
         const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
         // Don't go outside the build volume.
         Shape machine_volume_border;
-        switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"))
+        switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"_setting))
         {
         case BuildPlateShape::ELLIPTIC:
         {
@@ -699,12 +699,12 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
                 continue;
             }
             const ExtruderTrain& other_extruder = Application::getInstance().current_slice_->scene.extruders[extruder_nr];
-            extra_skirt_line_width += other_extruder.settings_.get<coord_t>("skirt_brim_line_width") * other_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
+            extra_skirt_line_width += other_extruder.settings_.get<coord_t>("skirt_brim_line_width"_setting) * other_extruder.settings_.get<Ratio>("initial_layer_line_width_factor"_setting);
         }
         const std::vector<ExtruderTrain*> skirt_brim_extruders = mesh_group_settings.get<std::vector<ExtruderTrain*>>("skirt_brim_extruder_nr");
         auto adhesion_width_str{ "brim_width" };
         auto adhesion_line_count_str{ "brim_line_count" };
-        switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"))
+        switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"_setting))
         {
         case EPlatformAdhesion::SKIRT:
             adhesion_width_str = "skirt_gap";
@@ -718,17 +718,17 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
                     adhesion_size,
                     coord_t(
                         skirt_brim_extruder.settings_.get<coord_t>(adhesion_width_str)
-                        + skirt_brim_extruder.settings_.get<coord_t>("skirt_brim_line_width")
+                        + skirt_brim_extruder.settings_.get<coord_t>("skirt_brim_line_width"_setting)
                               * (skirt_brim_extruder.settings_.get<size_t>(adhesion_line_count_str) - 1) // - 1 because the line is also included in extra_skirt_line_width
-                              * skirt_brim_extruder.settings_.get<Ratio>("initial_layer_line_width_factor")
+                              * skirt_brim_extruder.settings_.get<Ratio>("initial_layer_line_width_factor"_setting)
                         + extra_skirt_line_width));
             }
             break;
         case EPlatformAdhesion::RAFT:
         {
-            adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings_.get<coord_t>("raft_base_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings_.get<coord_t>("raft_interface_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings_.get<coord_t>("raft_surface_margin") });
+            adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings_.get<coord_t>("raft_base_margin"_setting),
+                                       mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings_.get<coord_t>("raft_interface_margin"_setting),
+                                       mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings_.get<coord_t>("raft_surface_margin"_setting) });
             break;
         }
         case EPlatformAdhesion::NONE:
@@ -740,7 +740,7 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
         }
         machine_volume_border = machine_volume_border.offset(-adhesion_size);
 
-        const coord_t conical_smallest_breadth = infill_settings.get<coord_t>("support_conical_min_width");
+        const coord_t conical_smallest_breadth = infill_settings.get<coord_t>("support_conical_min_width"_setting);
         Shape insetted = supportLayer_up.offset(-conical_smallest_breadth / 2);
         Shape small_parts = supportLayer_up.difference(insetted.offset(conical_smallest_breadth / 2 + 20));
         joined = supportLayer_this.unionPolygons(supportLayer_up.offset(conical_support_offset)).unionPolygons(small_parts).intersection(machine_volume_border);
@@ -751,13 +751,13 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
     }
 
     // join different parts
-    const coord_t join_distance = infill_settings.get<coord_t>("support_join_distance");
+    const coord_t join_distance = infill_settings.get<coord_t>("support_join_distance"_setting);
     if (join_distance > 0)
     {
         // first offset the layer a little inwards; this way tiny area's will not be joined
         // (narrow areas; ergo small areas will be removed in a later step using this same offset)
         // this inwards offset is later reversed by increasing the outwards offset
-        const coord_t min_even_wall_line_width = infill_settings.get<coord_t>("min_even_wall_line_width");
+        const coord_t min_even_wall_line_width = infill_settings.get<coord_t>("min_even_wall_line_width"_setting);
         auto half_min_feature_width = min_even_wall_line_width + 10;
 
         joined = joined.offset(-half_min_feature_width)
@@ -830,10 +830,10 @@ void AreaSupport::generateSupportAreas(SliceDataStorage& storage)
         Settings* infill_settings = &storage.meshes[mesh_idx]->settings;
         Settings* roof_settings = &storage.meshes[mesh_idx]->settings;
         Settings* bottom_settings = &storage.meshes[mesh_idx]->settings;
-        if (mesh.settings.get<bool>("support_mesh"))
+        if (mesh.settings.get<bool>("support_mesh"_setting))
         {
-            if ((mesh.settings.get<bool>("support_mesh_drop_down") && support_meshes_drop_down_handled)
-                || (! mesh.settings.get<bool>("support_mesh_drop_down") && support_meshes_handled))
+            if ((mesh.settings.get<bool>("support_mesh_drop_down"_setting) && support_meshes_drop_down_handled)
+                || (! mesh.settings.get<bool>("support_mesh_drop_down"_setting) && support_meshes_handled))
             { // handle all support_mesh and support_mesh_drop_down areas only once
                 continue;
             }
@@ -843,7 +843,7 @@ void AreaSupport::generateSupportAreas(SliceDataStorage& storage)
             infill_settings = &mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings_;
             roof_settings = &mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr").settings_;
             bottom_settings = &mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr").settings_;
-            if (mesh.settings.get<bool>("support_mesh_drop_down"))
+            if (mesh.settings.get<bool>("support_mesh_drop_down"_setting))
             {
                 support_meshes_drop_down_handled = true;
             }
@@ -875,11 +875,11 @@ void AreaSupport::generateSupportAreas(SliceDataStorage& storage)
             continue;
         }
 
-        if (mesh->settings.get<bool>("support_roof_enable"))
+        if (mesh->settings.get<bool>("support_roof_enable"_setting))
         {
             generateSupportRoof(storage, *mesh, global_support_areas_per_layer);
         }
-        if (mesh->settings.get<bool>("support_bottom_enable"))
+        if (mesh->settings.get<bool>("support_bottom_enable"_setting))
         {
             generateSupportBottom(storage, *mesh, global_support_areas_per_layer);
         }
@@ -894,8 +894,8 @@ void AreaSupport::precomputeCrossInfillTree(SliceDataStorage& storage)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const ExtruderTrain& infill_extruder = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr");
-    const EFillMethod& support_pattern = infill_extruder.settings_.get<EFillMethod>("support_pattern");
-    if ((support_pattern == EFillMethod::CROSS || support_pattern == EFillMethod::CROSS_3D) && infill_extruder.settings_.get<coord_t>("support_line_distance") > 0)
+    const EFillMethod& support_pattern = infill_extruder.settings_.get<EFillMethod>("support_pattern"_setting);
+    if ((support_pattern == EFillMethod::CROSS || support_pattern == EFillMethod::CROSS_3D) && infill_extruder.settings_.get<coord_t>("support_line_distance"_setting) > 0)
     {
         AABB3D aabb;
         for (unsigned int mesh_idx = 0; mesh_idx < storage.meshes.size(); mesh_idx++)
@@ -906,28 +906,28 @@ void AreaSupport::precomputeCrossInfillTree(SliceDataStorage& storage)
                 continue;
             }
             Settings& infill_settings = storage.meshes[mesh_idx]->settings;
-            if (mesh.settings.get<bool>("support_mesh"))
+            if (mesh.settings.get<bool>("support_mesh"_setting))
             {
                 // use extruder train settings rather than the per-object settings of the first support mesh encountered.
                 // because all support meshes are processed at the same time it doesn't make sense to use the per-object settings of the first support mesh encountered.
                 // instead we must use the support extruder settings, which is the settings base common to all support meshes.
                 infill_settings = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings_;
             }
-            const coord_t aabb_expansion = infill_settings.get<coord_t>("support_offset");
+            const coord_t aabb_expansion = infill_settings.get<coord_t>("support_offset"_setting);
             AABB3D aabb_here(mesh.bounding_box);
             aabb_here.include(aabb_here.min_ - Point3LL(-aabb_expansion, -aabb_expansion, 0));
             aabb_here.include(aabb_here.max_ + Point3LL(-aabb_expansion, -aabb_expansion, 0));
             aabb.include(aabb_here);
         }
 
-        std::string cross_subdisivion_spec_image_file = infill_extruder.settings_.get<std::string>("cross_support_density_image");
+        std::string cross_subdisivion_spec_image_file = infill_extruder.settings_.get<std::string>("cross_support_density_image"_setting);
         std::ifstream cross_fs(cross_subdisivion_spec_image_file.c_str());
         if (cross_subdisivion_spec_image_file != "" && cross_fs.good())
         {
             storage.support.cross_fill_provider = std::make_shared<SierpinskiFillProvider>(
                 aabb,
-                infill_extruder.settings_.get<coord_t>("support_line_distance"),
-                infill_extruder.settings_.get<coord_t>("support_line_width"),
+                infill_extruder.settings_.get<coord_t>("support_line_distance"_setting),
+                infill_extruder.settings_.get<coord_t>("support_line_width"_setting),
                 cross_subdisivion_spec_image_file);
         }
         else
@@ -938,8 +938,8 @@ void AreaSupport::precomputeCrossInfillTree(SliceDataStorage& storage)
             }
             storage.support.cross_fill_provider = std::make_shared<SierpinskiFillProvider>(
                 aabb,
-                infill_extruder.settings_.get<coord_t>("support_line_distance"),
-                infill_extruder.settings_.get<coord_t>("support_line_width"));
+                infill_extruder.settings_.get<coord_t>("support_line_distance"_setting),
+                infill_extruder.settings_.get<coord_t>("support_line_width"_setting));
         }
     }
 }
@@ -947,7 +947,7 @@ void AreaSupport::precomputeCrossInfillTree(SliceDataStorage& storage)
 void AreaSupport::generateOverhangAreasForMesh(SliceDataStorage& storage, SliceMeshStorage& mesh)
 {
     const bool mesh_group_support_paint = Application::getInstance().current_slice_->scene.current_mesh_group->has_painted_support;
-    if (! (mesh.settings.get<bool>("support_enable") || mesh.settings.get<bool>("support_mesh") || mesh_group_support_paint))
+    if (! (mesh.settings.get<bool>("support_enable"_setting) || mesh.settings.get<bool>("support_mesh"_setting) || mesh_group_support_paint))
     {
         return;
     }
@@ -960,15 +960,15 @@ void AreaSupport::generateOverhangAreasForMesh(SliceDataStorage& storage, SliceM
     }
 
     // Don't generate overhang areas for support meshes. They are dropped down automatically if desired.
-    const bool is_support_modifier = mesh.settings.get<bool>("support_mesh");
+    const bool is_support_modifier = mesh.settings.get<bool>("support_mesh"_setting);
     if (is_support_modifier)
     {
         return;
     }
 
     // Don't generate overhang areas if the Z distance is higher than the objects we're generating support for.
-    const coord_t layer_height = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("layer_height");
-    const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance");
+    const coord_t layer_height = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("layer_height"_setting);
+    const coord_t z_distance_top = mesh.settings.get<coord_t>("support_top_distance"_setting);
     const size_t z_distance_top_layers = (z_distance_top / layer_height) + 1;
     if (z_distance_top_layers + 1 > storage.print_layer_count)
     {
@@ -976,8 +976,8 @@ void AreaSupport::generateOverhangAreasForMesh(SliceDataStorage& storage, SliceM
     }
 
     // Generate points and lines of overhang (for corners pointing downwards, since they don't have an area to support but still need supporting).
-    const coord_t max_supported_diameter = mesh.settings.get<coord_t>("support_tower_maximum_supported_diameter");
-    const bool use_towers = mesh.settings.get<bool>("support_use_towers") && max_supported_diameter > 0;
+    const coord_t max_supported_diameter = mesh.settings.get<coord_t>("support_tower_maximum_supported_diameter"_setting);
+    const bool use_towers = mesh.settings.get<bool>("support_use_towers"_setting) && max_supported_diameter > 0;
     if (use_towers)
     {
         AreaSupport::detectOverhangPoints(storage, mesh);
@@ -1001,11 +1001,11 @@ Shape AreaSupport::generateVaryingXYDisallowedArea(const SliceMeshStorage& stora
 {
     const auto& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const Simplify simplify{ mesh_group_settings };
-    const auto layer_thickness = mesh_group_settings.get<coord_t>("layer_height");
-    const auto support_distance_top = static_cast<double>(mesh_group_settings.get<coord_t>("support_top_distance"));
-    const auto support_distance_bot = static_cast<double>(mesh_group_settings.get<coord_t>("support_bottom_distance"));
-    const auto overhang_angle = mesh_group_settings.get<AngleRadians>("support_angle");
-    const auto xy_distance = static_cast<double>(mesh_group_settings.get<coord_t>("support_xy_distance"));
+    const auto layer_thickness = mesh_group_settings.get<coord_t>("layer_height"_setting);
+    const auto support_distance_top = static_cast<double>(mesh_group_settings.get<coord_t>("support_top_distance"_setting));
+    const auto support_distance_bot = static_cast<double>(mesh_group_settings.get<coord_t>("support_bottom_distance"_setting));
+    const auto overhang_angle = mesh_group_settings.get<AngleRadians>("support_angle"_setting);
+    const auto xy_distance = static_cast<double>(mesh_group_settings.get<coord_t>("support_xy_distance"_setting));
 
     constexpr auto close_dist = 20;
 
@@ -1173,31 +1173,31 @@ void AreaSupport::generateSupportAreasForMesh(
 {
     SliceMeshStorage& mesh = *storage.meshes[mesh_idx];
 
-    const ESupportStructure support_structure = mesh.settings.get<ESupportStructure>("support_structure");
+    const ESupportStructure support_structure = mesh.settings.get<ESupportStructure>("support_structure"_setting);
     const bool is_support_mesh_place_holder
-        = mesh.settings.get<bool>("support_mesh"); // whether this mesh has empty SliceMeshStorage and this function is now called to only generate support for all support meshes
+        = mesh.settings.get<bool>("support_mesh"_setting); // whether this mesh has empty SliceMeshStorage and this function is now called to only generate support for all support meshes
     const bool mesh_group_support_paint = Application::getInstance().current_slice_->scene.current_mesh_group->has_painted_support;
-    if ((! (mesh.settings.get<bool>("support_enable") || mesh_group_support_paint) || support_structure != ESupportStructure::NORMAL) && ! is_support_mesh_place_holder)
+    if ((! (mesh.settings.get<bool>("support_enable"_setting) || mesh_group_support_paint) || support_structure != ESupportStructure::NORMAL) && ! is_support_mesh_place_holder)
     {
         return;
     }
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    const ESupportType support_type = mesh_group_settings.get<ESupportType>("support_type");
+    const ESupportType support_type = mesh_group_settings.get<ESupportType>("support_type"_setting);
     if (support_type == ESupportType::NONE && ! is_support_mesh_place_holder)
     {
         return;
     }
 
     // early out
-    const coord_t layer_thickness = mesh_group_settings.get<coord_t>("layer_height");
-    const coord_t z_distance_top = ((mesh.settings.get<bool>("support_roof_enable")) ? roof_settings : infill_settings).get<coord_t>("support_top_distance");
+    const coord_t layer_thickness = mesh_group_settings.get<coord_t>("layer_height"_setting);
+    const coord_t z_distance_top = ((mesh.settings.get<bool>("support_roof_enable"_setting)) ? roof_settings : infill_settings).get<coord_t>("support_top_distance"_setting);
     const size_t layer_z_distance_top = (z_distance_top / layer_thickness) + 1;
     if (layer_z_distance_top + 1 > layer_count)
     {
         return;
     }
 
-    if ((! (mesh.settings.get<bool>("support_mesh") || mesh_group_support_paint))
+    if ((! (mesh.settings.get<bool>("support_mesh"_setting) || mesh_group_support_paint))
         && ranges::all_of(
             mesh.overhang_areas,
             [](const Shape& overhang_area)
@@ -1222,17 +1222,17 @@ void AreaSupport::generateSupportAreasForMesh(
     sloped_areas_per_layer.resize(layer_count);
     sloped_areas_per_layer[0] = Shape();
     // simplified processing for bottom layer - just ensure support clears part by XY distance
-    const coord_t xy_distance = infill_settings.get<coord_t>("support_xy_distance");
-    const coord_t xy_distance_overhang = infill_settings.get<coord_t>("support_xy_distance_overhang");
+    const coord_t xy_distance = infill_settings.get<coord_t>("support_xy_distance"_setting);
+    const coord_t xy_distance_overhang = infill_settings.get<coord_t>("support_xy_distance_overhang"_setting);
     const bool use_xy_distance_overhang
-        = infill_settings.get<SupportDistPriority>("support_xy_overrides_z") == SupportDistPriority::Z_OVERRIDES_XY; // whether to use a different xy distance at overhangs
+        = infill_settings.get<SupportDistPriority>("support_xy_overrides_z"_setting) == SupportDistPriority::Z_OVERRIDES_XY; // whether to use a different xy distance at overhangs
     constexpr bool no_support = false;
     constexpr bool no_prime_tower = false;
-    const coord_t support_line_width = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings_.get<coord_t>("support_line_width");
-    const double sloped_areas_angle = mesh.settings.get<AngleRadians>("support_bottom_stair_step_min_slope");
+    const coord_t support_line_width = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings_.get<coord_t>("support_line_width"_setting);
+    const double sloped_areas_angle = mesh.settings.get<AngleRadians>("support_bottom_stair_step_min_slope"_setting);
     const coord_t sloped_area_detection_width = 10 + static_cast<coord_t>(layer_thickness / std::tan(sloped_areas_angle)) / 2;
-    const double minimum_support_area = mesh.settings.get<double>("minimum_support_area");
-    const coord_t min_even_wall_line_width = mesh.settings.get<coord_t>("min_even_wall_line_width");
+    const double minimum_support_area = mesh.settings.get<double>("minimum_support_area"_setting);
+    const coord_t min_even_wall_line_width = mesh.settings.get<coord_t>("min_even_wall_line_width"_setting);
     xy_disallowed_per_layer[0] = storage.getLayerOutlines(0, no_support, no_prime_tower).offset(xy_distance);
 
     // The maximum width of an odd wall = 2 * minimum even wall width.
@@ -1289,18 +1289,18 @@ void AreaSupport::generateSupportAreasForMesh(
     std::vector<Shape> tower_roofs;
     Shape stair_removal; // polygons to subtract from support because of stair-stepping
 
-    const bool is_support_mesh_nondrop_place_holder = is_support_mesh_place_holder && ! mesh.settings.get<bool>("support_mesh_drop_down");
-    const bool is_support_mesh_drop_down_place_holder = is_support_mesh_place_holder && mesh.settings.get<bool>("support_mesh_drop_down");
+    const bool is_support_mesh_nondrop_place_holder = is_support_mesh_place_holder && ! mesh.settings.get<bool>("support_mesh_drop_down"_setting);
+    const bool is_support_mesh_drop_down_place_holder = is_support_mesh_place_holder && mesh.settings.get<bool>("support_mesh_drop_down"_setting);
 
-    const coord_t bottom_stair_step_width = std::max(static_cast<coord_t>(0), mesh.settings.get<coord_t>("support_bottom_stair_step_width"));
-    const coord_t extension_offset = infill_settings.get<coord_t>("support_offset");
+    const coord_t bottom_stair_step_width = std::max(static_cast<coord_t>(0), mesh.settings.get<coord_t>("support_bottom_stair_step_width"_setting));
+    const coord_t extension_offset = infill_settings.get<coord_t>("support_offset"_setting);
 
-    const coord_t max_tower_supported_diameter = infill_settings.get<coord_t>("support_tower_maximum_supported_diameter");
-    const bool use_towers = infill_settings.get<bool>("support_use_towers") && max_tower_supported_diameter > 0;
+    const coord_t max_tower_supported_diameter = infill_settings.get<coord_t>("support_tower_maximum_supported_diameter"_setting);
+    const bool use_towers = infill_settings.get<bool>("support_use_towers"_setting) && max_tower_supported_diameter > 0;
 
-    const coord_t z_distance_bottom = ((mesh.settings.get<bool>("support_bottom_enable")) ? bottom_settings : infill_settings).get<coord_t>("support_bottom_distance");
+    const coord_t z_distance_bottom = ((mesh.settings.get<bool>("support_bottom_enable"_setting)) ? bottom_settings : infill_settings).get<coord_t>("support_bottom_distance"_setting);
     const size_t bottom_empty_layer_count = round_up_divide(z_distance_bottom, layer_thickness); // number of empty layers between support and model
-    const coord_t bottom_stair_step_height = std::max(static_cast<coord_t>(0), mesh.settings.get<coord_t>("support_bottom_stair_step_height"));
+    const coord_t bottom_stair_step_height = std::max(static_cast<coord_t>(0), mesh.settings.get<coord_t>("support_bottom_stair_step_height"_setting));
     const size_t bottom_stair_step_layer_count
         = bottom_stair_step_height / layer_thickness + 1; // the difference in layers between two stair steps. One is normal support (not stair-like)
 
@@ -1442,7 +1442,7 @@ void AreaSupport::generateSupportAreasForMesh(
     if (support_type == ESupportType::PLATFORM_ONLY)
     {
         Shape touching_buildplate = support_areas[0]; // TODO: not working for conical support!
-        const AngleRadians conical_support_angle = infill_settings.get<AngleRadians>("support_conical_angle");
+        const AngleRadians conical_support_angle = infill_settings.get<AngleRadians>("support_conical_angle"_setting);
         coord_t conical_support_offset;
         if (conical_support_angle > 0)
         { // outward ==> wider base than overhang
@@ -1452,7 +1452,7 @@ void AreaSupport::generateSupportAreasForMesh(
         { // inward ==> smaller base than overhang
             conical_support_offset = boundedTan(-conical_support_angle) * layer_thickness;
         }
-        const bool conical_support = infill_settings.get<bool>("support_conical_enabled") && conical_support_angle != 0;
+        const bool conical_support = infill_settings.get<bool>("support_conical_enabled"_setting) && conical_support_angle != 0;
         for (LayerIndex layer_idx = 1; layer_idx < LayerIndex(storage.support.supportLayers.size()); layer_idx++)
         {
             const Shape& layer = support_areas[layer_idx];
@@ -1645,10 +1645,10 @@ std::pair<Shape, Shape> AreaSupport::computeBasicAndFullOverhang(const SliceData
     constexpr bool no_prime_tower = false;
 
     constexpr double smooth_height = 0.4; // mm
-    const LayerIndex layers_below{ static_cast<LayerIndex::value_type>(std::round(smooth_height / mesh.settings.get<double>("layer_height"))) };
+    const LayerIndex layers_below{ static_cast<LayerIndex::value_type>(std::round(smooth_height / mesh.settings.get<double>("layer_height"_setting))) };
 
-    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height");
-    const AngleRadians support_angle = mesh.settings.get<AngleRadians>("support_angle");
+    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height"_setting);
+    const AngleRadians support_angle = mesh.settings.get<AngleRadians>("support_angle"_setting);
     const double tan_angle = boundedTan(support_angle); // The X/Y component of the support angle
     // overhang areas protruding less then `max_dist_from_lower_layer` don't need support
     const coord_t max_dist_from_lower_layer = tan_angle * layer_height; // Maximum horizontal distance that can be bridged.
@@ -1663,7 +1663,7 @@ std::pair<Shape, Shape> AreaSupport::computeBasicAndFullOverhang(const SliceData
         outlines_below = outlines_below.unionPolygons(outlines_below_);
     }
 
-    Shape basic_overhang = mesh.settings.get<bool>("support_enable") ? outlines.difference(outlines_below) : Shape{};
+    Shape basic_overhang = mesh.settings.get<bool>("support_enable"_setting) ? outlines.difference(outlines_below) : Shape{};
 
     const SupportLayer& support_layer = storage.support.supportLayers[layer_idx];
     if (! support_layer.anti_overhang.empty())
@@ -1691,7 +1691,7 @@ std::pair<Shape, Shape> AreaSupport::computeBasicAndFullOverhang(const SliceData
 
 void AreaSupport::detectOverhangPoints(const SliceDataStorage& storage, SliceMeshStorage& mesh)
 {
-    const coord_t max_tower_supported_diameter = mesh.settings.get<coord_t>("support_tower_maximum_supported_diameter");
+    const coord_t max_tower_supported_diameter = mesh.settings.get<coord_t>("support_tower_maximum_supported_diameter"_setting);
     const coord_t max_tower_supported_area = max_tower_supported_diameter * max_tower_supported_diameter;
 
     mesh.overhang_points.resize(storage.print_layer_count);
@@ -1750,7 +1750,7 @@ void AreaSupport::handleTowers(
         // make sure we have the lowest point (make polys empty if they have small parts below)
         if (layer_overhang_point < static_cast<LayerIndex>(layer_count) && ! overhang_points[layer_overhang_point - 1].empty())
         {
-            const auto max_tower_supported_diameter = settings.get<coord_t>("support_tower_maximum_supported_diameter");
+            const auto max_tower_supported_diameter = settings.get<coord_t>("support_tower_maximum_supported_diameter"_setting);
             std::vector<Shape>& overhang_points_below = overhang_points[layer_overhang_point - 1];
             for (Shape& poly_here : overhang_points_here)
             {
@@ -1770,10 +1770,10 @@ void AreaSupport::handleTowers(
     }
 
     // make tower roofs
-    const coord_t layer_thickness = settings.get<coord_t>("layer_height");
-    const AngleRadians tower_roof_angle = settings.get<AngleRadians>("support_tower_roof_angle");
-    const coord_t tower_diameter = settings.get<coord_t>("support_tower_diameter");
-    const auto support_line_width = settings.get<coord_t>("support_line_width");
+    const coord_t layer_thickness = settings.get<coord_t>("layer_height"_setting);
+    const AngleRadians tower_roof_angle = settings.get<AngleRadians>("support_tower_roof_angle"_setting);
+    const coord_t tower_diameter = settings.get<coord_t>("support_tower_diameter"_setting);
+    const auto support_line_width = settings.get<coord_t>("support_line_width"_setting);
 
     coord_t tower_roof_expansion_distance;
     if (tower_roof_angle == 0)
@@ -1836,8 +1836,8 @@ void AreaSupport::handleTowers(
 
 void AreaSupport::handleWallStruts(const Settings& settings, Shape& supportLayer_this)
 {
-    const coord_t max_tower_supported_diameter = settings.get<coord_t>("support_tower_maximum_supported_diameter");
-    const coord_t tower_diameter = settings.get<coord_t>("support_tower_diameter");
+    const coord_t max_tower_supported_diameter = settings.get<coord_t>("support_tower_maximum_supported_diameter"_setting);
+    const coord_t tower_diameter = settings.get<coord_t>("support_tower_diameter"_setting);
     for (unsigned int p = 0; p < supportLayer_this.size(); p++)
     {
         const Polygon& poly = supportLayer_this[p];
@@ -1882,17 +1882,17 @@ void AreaSupport::handleWallStruts(const Settings& settings, Shape& supportLayer
 void AreaSupport::generateSupportBottom(SliceDataStorage& storage, const SliceMeshStorage& mesh, std::vector<Shape>& global_support_areas_per_layer)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height");
-    const size_t bottom_layer_count = round_divide(mesh.settings.get<coord_t>("support_bottom_height"), layer_height); // Number of layers in support bottom.
+    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height"_setting);
+    const size_t bottom_layer_count = round_divide(mesh.settings.get<coord_t>("support_bottom_height"_setting), layer_height); // Number of layers in support bottom.
     if (bottom_layer_count <= 0)
     {
         return;
     }
-    const coord_t z_distance_bottom = round_up_divide(mesh.settings.get<coord_t>("support_bottom_distance"), layer_height); // Number of layers between support bottom and model.
-    const coord_t bottom_line_width = mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr").settings_.get<coord_t>("support_bottom_line_width");
-    const coord_t bottom_outline_offset = mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr").settings_.get<coord_t>("support_bottom_offset");
+    const coord_t z_distance_bottom = round_up_divide(mesh.settings.get<coord_t>("support_bottom_distance"_setting), layer_height); // Number of layers between support bottom and model.
+    const coord_t bottom_line_width = mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr").settings_.get<coord_t>("support_bottom_line_width"_setting);
+    const coord_t bottom_outline_offset = mesh_group_settings.get<ExtruderTrain&>("support_bottom_extruder_nr").settings_.get<coord_t>("support_bottom_offset"_setting);
 
-    const double minimum_bottom_area = mesh.settings.get<double>("minimum_bottom_area");
+    const double minimum_bottom_area = mesh.settings.get<double>("minimum_bottom_area"_setting);
 
     std::vector<SupportLayer>& support_layers = storage.support.supportLayers;
     for (LayerIndex layer_idx = support_layers.size() - 1; layer_idx >= static_cast<int>(z_distance_bottom); --layer_idx)
@@ -1913,18 +1913,18 @@ void AreaSupport::generateSupportBottom(SliceDataStorage& storage, const SliceMe
 void AreaSupport::generateSupportRoof(SliceDataStorage& storage, const SliceMeshStorage& mesh, std::vector<Shape>& global_support_areas_per_layer)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height");
-    const size_t roof_layer_count = round_divide(mesh.settings.get<coord_t>("support_roof_height"), layer_height); // Number of layers in support roof.
+    const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height"_setting);
+    const size_t roof_layer_count = round_divide(mesh.settings.get<coord_t>("support_roof_height"_setting), layer_height); // Number of layers in support roof.
     if (roof_layer_count <= 0)
     {
         return;
     }
-    const coord_t support_top_distance = mesh.settings.get<coord_t>("support_top_distance");
+    const coord_t support_top_distance = mesh.settings.get<coord_t>("support_top_distance"_setting);
     const coord_t z_distance_top = round_up_divide(support_top_distance, layer_height); // Number of layers between support roof and model.
-    const coord_t roof_line_width = mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr").settings_.get<coord_t>("support_roof_line_width");
-    const coord_t roof_outline_offset = mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr").settings_.get<coord_t>("support_roof_offset");
+    const coord_t roof_line_width = mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr").settings_.get<coord_t>("support_roof_line_width"_setting);
+    const coord_t roof_outline_offset = mesh_group_settings.get<ExtruderTrain&>("support_roof_extruder_nr").settings_.get<coord_t>("support_roof_offset"_setting);
 
-    const double minimum_roof_area = mesh.settings.get<double>("minimum_roof_area");
+    const double minimum_roof_area = mesh.settings.get<double>("minimum_roof_area"_setting);
 
     std::vector<SupportLayer>& support_layers = storage.support.supportLayers;
     for (LayerIndex layer_idx = static_cast<int>(support_layers.size() - z_distance_top) - 1; layer_idx >= 0; --layer_idx)
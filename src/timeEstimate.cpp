@@ -4,9 +4,7 @@
 #include "timeEstimate.h"
 
 #include <algorithm>
-#include <math.h>
-#include <stdio.h>
-#include <string.h>
+#include <cmath>
 
 #include "settings/Settings.h"
 #include "utils/math.h"
@@ -18,6 +16,9 @@ namespace cura
 
 void TimeEstimateCalculator::setFirmwareDefaults(const Settings& settings)
 {
+    // The moves that are planned already are limited by the previous configuration.
+    prepareMoves();
+
     max_feedrate[X_AXIS] = settings.get<Velocity>("machine_max_feedrate_x");
     max_feedrate[Y_AXIS] = settings.get<Velocity>("machine_max_feedrate_y");
     max_feedrate[Z_AXIS] = settings.get<Velocity>("machine_max_feedrate_z");
@@ -57,7 +58,41 @@ void TimeEstimateCalculator::setMaxXyJerk(const Velocity& jerk)
 void TimeEstimateCalculator::reset()
 {
     extra_time = 0.0;
-    blocks.clear();
+    moves.clear();
+    prepared_moves = 0;
+    profile.clear();
+}
+
+void TimeEstimateCalculator::Moves::clear()
+{
+    for (std::vector<double>& axis_delta : delta)
+    {
+        axis_delta.clear();
+    }
+    feedrate.clear();
+    default_acceleration.clear();
+    max_xy_jerk.clear();
+    feature.clear();
+    distance.clear();
+    acceleration.clear();
+}
+
+void TimeEstimateCalculator::SpeedProfile::resize(const size_t size)
+{
+    nominal_feedrate.resize(size);
+    max_entry_speed.resize(size);
+    entry_speed.resize(size);
+    nominal_length_flag.resize(size);
+    recalculate_flag.resize(size);
+    accelerate_until.resize(size);
+    decelerate_after.resize(size);
+    initial_feedrate.resize(size);
+    final_feedrate.resize(size);
+}
+
+void TimeEstimateCalculator::SpeedProfile::clear()
+{
+    resize(0);
 }
 
 // Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
@@ -129,273 +164,339 @@ static inline double accelerationTimeFromDistance(const Velocity& initial_feedra
     return (-initial_feedrate + sqrt(discriminant)) / acceleration;
 }
 
-void TimeEstimateCalculator::calculateTrapezoidForBlock(Block* block, const Ratio entry_factor, const Ratio exit_factor)
+void TimeEstimateCalculator::calculateTrapezoidForBlock(SpeedProfile& speed_profile, const size_t block_idx, const Ratio entry_factor, const Ratio exit_factor) const
 {
-    const Velocity initial_feedrate = block->nominal_feedrate * entry_factor;
-    const Velocity final_feedrate = block->nominal_feedrate * exit_factor;
+    const double nominal_feedrate = speed_profile.nominal_feedrate[block_idx];
+    const double block_acceleration = moves.acceleration[block_idx];
+    const double distance = moves.distance[block_idx];
+    const Velocity initial_feedrate = nominal_feedrate * entry_factor;
+    const Velocity final_feedrate = nominal_feedrate * exit_factor;
 
-    double accelerate_distance = estimateAccelerationDistance(initial_feedrate, block->nominal_feedrate, block->acceleration);
-    const double decelerate_distance = estimateAccelerationDistance(block->nominal_feedrate, final_feedrate, -block->acceleration);
+    double accelerate_distance = estimateAccelerationDistance(initial_feedrate, nominal_feedrate, block_acceleration);
+    const double decelerate_distance = estimateAccelerationDistance(nominal_feedrate, final_feedrate, -block_acceleration);
 
     // Calculate the size of Plateau of Nominal Rate.
-    double plateau_distance = block->distance - accelerate_distance - decelerate_distance;
+    double plateau_distance = distance - accelerate_distance - decelerate_distance;
 
     // Is the Plateau of Nominal Rate smaller than nothing? That means no cruising, and we will
     // have to use intersection_distance() to calculate when to abort acceleration and start braking
     // in order to reach the final_rate exactly at the end of this block.
     if (plateau_distance < 0)
     {
-        accelerate_distance = intersectionDistance(initial_feedrate, final_feedrate, block->acceleration, block->distance);
+        accelerate_distance = intersectionDistance(initial_feedrate, final_feedrate, block_acceleration, distance);
         accelerate_distance = std::max(accelerate_distance, 0.0); // Check limits due to numerical round-off
-        accelerate_distance = std::min(accelerate_distance, block->distance); //(We can cast here to unsigned, because the above line ensures that we are above zero)
+        accelerate_distance = std::min(accelerate_distance, distance); //(We can cast here to unsigned, because the above line ensures that we are above zero)
         plateau_distance = 0;
     }
 
-    block->accelerate_until = accelerate_distance;
-    block->decelerate_after = accelerate_distance + plateau_distance;
-    block->initial_feedrate = initial_feedrate;
-    block->final_feedrate = final_feedrate;
+    speed_profile.accelerate_until[block_idx] = accelerate_distance;
+    speed_profile.decelerate_after[block_idx] = accelerate_distance + plateau_distance;
+    speed_profile.initial_feedrate[block_idx] = initial_feedrate;
+    speed_profile.final_feedrate[block_idx] = final_feedrate;
 }
 
 void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatureType feature)
 {
-    Block block;
-    memset(&block, 0, sizeof(block));
-
-    block.feature = feature;
-
-    // block.maxTravel = 0; //Done by memset.
+    // Only the movement is stored here. The rest is computed for all new moves at once, once the estimate is needed.
+    Position delta;
+    double max_travel = 0;
     for (size_t n = 0; n < NUM_AXIS; n++)
     {
-        block.delta[n] = newPos[n] - currentPosition[n];
-        block.absDelta[n] = std::abs(block.delta[n]);
-        block.maxTravel = std::max(block.maxTravel, block.absDelta[n]);
+        delta[n] = newPos[n] - currentPosition[n];
+        max_travel = std::max(max_travel, std::abs(delta[n]));
     }
-    if (block.maxTravel <= 0)
+    if (max_travel <= 0)
     {
         return;
     }
-    if (feedrate < minimumfeedrate)
+
+    for (size_t n = 0; n < NUM_AXIS; n++)
     {
-        feedrate = minimumfeedrate;
+        moves.delta[n].push_back(delta[n]);
     }
-    block.distance = sqrtf(square(block.absDelta[0]) + square(block.absDelta[1]) + square(block.absDelta[2]));
-    if (block.distance == 0.0)
+    moves.feedrate.push_back(feedrate);
+    moves.default_acceleration.push_back(acceleration);
+    moves.max_xy_jerk.push_back(max_xy_jerk);
+    moves.feature.push_back(feature);
+
+    currentPosition = newPos;
+}
+
+void TimeEstimateCalculator::prepareMoves()
+{
+    const size_t first = prepared_moves;
+    const size_t last = moves.size();
+    if (first == last)
     {
-        block.distance = block.absDelta[3];
+        return;
     }
-    block.nominal_feedrate = feedrate;
 
-    Position current_feedrate;
-    Position current_abs_feedrate;
-    Ratio feedrate_factor = 1.0;
-    for (size_t n = 0; n < NUM_AXIS; n++)
+    moves.distance.resize(last);
+    for (size_t move_idx = first; move_idx < last; ++move_idx)
     {
-        current_feedrate[n] = (block.delta[n] * feedrate) / block.distance;
-        current_abs_feedrate[n] = std::abs(current_feedrate[n]);
-        if (current_abs_feedrate[n] > max_feedrate[n])
-        {
-            feedrate_factor = std::min(feedrate_factor, Ratio(max_feedrate[n] / current_abs_feedrate[n]));
-        }
+        const double abs_delta_x = std::abs(moves.delta[X_AXIS][move_idx]);
+        const double abs_delta_y = std::abs(moves.delta[Y_AXIS][move_idx]);
+        const double abs_delta_z = std::abs(moves.delta[Z_AXIS][move_idx]);
+        const double distance = std::sqrt(static_cast<float>(square(abs_delta_x) + square(abs_delta_y) + square(abs_delta_z)));
+        moves.distance[move_idx] = (distance == 0.0) ? std::abs(moves.delta[E_AXIS][move_idx]) : distance;
     }
-    // TODO: XY_FREQUENCY_LIMIT
 
-    if (feedrate_factor < 1.0)
+    moves.acceleration.resize(last);
+    for (size_t move_idx = first; move_idx < last; ++move_idx)
     {
+        double move_acceleration = moves.default_acceleration[move_idx];
         for (size_t n = 0; n < NUM_AXIS; n++)
         {
-            current_feedrate[n] *= feedrate_factor;
-            current_abs_feedrate[n] *= feedrate_factor;
+            if (move_acceleration * (std::abs(moves.delta[n][move_idx]) / moves.distance[move_idx]) > max_acceleration[n])
+            {
+                move_acceleration = max_acceleration[n];
+            }
         }
-        block.nominal_feedrate *= feedrate_factor;
+        moves.acceleration[move_idx] = move_acceleration;
     }
 
-    block.acceleration = acceleration;
-    for (size_t n = 0; n < NUM_AXIS; n++)
-    {
-        if (block.acceleration * (block.absDelta[n] / block.distance) > max_acceleration[n])
-        {
-            block.acceleration = max_acceleration[n];
-        }
-    }
+    planSpeeds(first, 1.0_r, previous_feedrate, previous_nominal_feedrate, profile);
+    prepared_moves = last;
+}
 
-    Velocity vmax_junction{ max_xy_jerk / 2.0 };
-    Ratio vmax_junction_factor{ 1.0 };
-    if (current_abs_feedrate[Z_AXIS] > max_z_jerk / 2.0)
-    {
-        vmax_junction = std::min(vmax_junction, Velocity{ max_z_jerk / 2.0 });
-    }
-    if (current_abs_feedrate[E_AXIS] > max_e_jerk / 2.0)
+void TimeEstimateCalculator::planSpeeds(const size_t first, const Ratio& speed_factor, Position& last_feedrate, Velocity& last_nominal_feedrate, SpeedProfile& speed_profile) const
+{
+    const size_t last = moves.size();
+    const size_t count = last - first;
+    speed_profile.resize(last);
+
+    // The feedrate of every move, limited by the max feedrate of every axis.
+    std::array<std::vector<double>, NUM_AXIS> current_feedrate;
+    for (std::vector<double>& axis_feedrate : current_feedrate)
     {
-        vmax_junction = std::min(vmax_junction, Velocity{ max_e_jerk / 2.0 });
+        axis_feedrate.resize(count);
     }
-    vmax_junction = std::min(vmax_junction, block.nominal_feedrate);
-    const Velocity safe_speed = vmax_junction;
-
-    if ((blocks.size() > 0) && (previous_nominal_feedrate > 0.0001))
+    for (size_t move_idx = first; move_idx < last; ++move_idx)
     {
-        const Velocity xy_jerk = sqrt(square(current_feedrate[X_AXIS] - previous_feedrate[X_AXIS]) + square(current_feedrate[Y_AXIS] - previous_feedrate[Y_AXIS]));
-        vmax_junction = block.nominal_feedrate;
-        if (xy_jerk > max_xy_jerk)
+        const size_t idx = move_idx - first;
+        const PrintFeatureType feature = moves.feature[move_idx];
+        const bool is_travel = feature == PrintFeatureType::NoneType || feature == PrintFeatureType::MoveUnretracted || feature == PrintFeatureType::MoveRetracted
+                            || feature == PrintFeatureType::MoveWhileRetracting || feature == PrintFeatureType::MoveWhileUnretracting
+                            || feature == PrintFeatureType::StationaryRetractUnretract;
+        double feedrate = is_travel ? moves.feedrate[move_idx] : moves.feedrate[move_idx] * speed_factor;
+        if (feedrate < minimumfeedrate)
         {
-            vmax_junction_factor = Ratio(max_xy_jerk / xy_jerk);
+            feedrate = minimumfeedrate;
         }
-        const double z_jerk = std::abs(current_feedrate[Z_AXIS] - previous_feedrate[Z_AXIS]);
-        if (z_jerk > max_z_jerk)
+        double nominal_feedrate = feedrate;
+
+        Ratio feedrate_factor = 1.0;
+        for (size_t n = 0; n < NUM_AXIS; n++)
         {
-            vmax_junction_factor = std::min(vmax_junction_factor, Ratio(max_z_jerk / z_jerk));
+            current_feedrate[n][idx] = (moves.delta[n][move_idx] * feedrate) / moves.distance[move_idx];
+            const double current_abs_feedrate = std::abs(current_feedrate[n][idx]);
+            if (current_abs_feedrate > max_feedrate[n])
+            {
+                feedrate_factor = std::min(feedrate_factor, Ratio(max_feedrate[n] / current_abs_feedrate));
+            }
         }
-        const double e_jerk = std::abs(current_feedrate[E_AXIS] - previous_feedrate[E_AXIS]);
-        if (e_jerk > max_e_jerk)
+        // TODO: XY_FREQUENCY_LIMIT
+
+        if (feedrate_factor < 1.0)
         {
-            vmax_junction_factor = std::min(vmax_junction_factor, Ratio(max_e_jerk / e_jerk));
+            for (size_t n = 0; n < NUM_AXIS; n++)
+            {
+                current_feedrate[n][idx] *= feedrate_factor;
+            }
+            nominal_feedrate *= feedrate_factor;
         }
-        vmax_junction = std::min(previous_nominal_feedrate, Velocity{ vmax_junction * vmax_junction_factor }); // Limit speed to max previous speed
+        speed_profile.nominal_feedrate[move_idx] = nominal_feedrate;
     }
 
-    block.max_entry_speed = vmax_junction;
+    // The speed at every junction only depends on the feedrates of the moves on both sides of it.
+    for (size_t move_idx = first; move_idx < last; ++move_idx)
+    {
+        const size_t idx = move_idx - first;
+        const double nominal_feedrate = speed_profile.nominal_feedrate[move_idx];
 
-    const Velocity v_allowable = maxAllowableSpeed(-block.acceleration, MINIMUM_PLANNER_SPEED, block.distance);
-    block.entry_speed = std::min(vmax_junction, v_allowable);
-    block.nominal_length_flag = block.nominal_feedrate <= v_allowable;
-    block.recalculate_flag = true; // Always calculate trapezoid for new block
+        Velocity vmax_junction{ moves.max_xy_jerk[move_idx] / 2.0 };
+        Ratio vmax_junction_factor{ 1.0 };
+        if (std::abs(current_feedrate[Z_AXIS][idx]) > max_z_jerk / 2.0)
+        {
+            vmax_junction = std::min(vmax_junction, Velocity{ max_z_jerk / 2.0 });
+        }
+        if (std::abs(current_feedrate[E_AXIS][idx]) > max_e_jerk / 2.0)
+        {
+            vmax_junction = std::min(vmax_junction, Velocity{ max_e_jerk / 2.0 });
+        }
+        vmax_junction = std::min(vmax_junction, Velocity{ nominal_feedrate });
 
-    previous_feedrate = current_feedrate;
-    previous_nominal_feedrate = block.nominal_feedrate;
+        const double previous_nominal_feedrate = (idx == 0) ? static_cast<double>(last_nominal_feedrate) : speed_profile.nominal_feedrate[move_idx - 1];
+        if ((move_idx > 0) && (previous_nominal_feedrate > 0.0001))
+        {
+            const auto previous_feedrate = [&](const size_t axis)
+            {
+                return (idx == 0) ? last_feedrate[axis] : current_feedrate[axis][idx - 1];
+            };
+            const Velocity xy_jerk = sqrt(square(current_feedrate[X_AXIS][idx] - previous_feedrate(X_AXIS)) + square(current_feedrate[Y_AXIS][idx] - previous_feedrate(Y_AXIS)));
+            vmax_junction = nominal_feedrate;
+            if (xy_jerk > moves.max_xy_jerk[move_idx])
+            {
+                vmax_junction_factor = Ratio(moves.max_xy_jerk[move_idx] / xy_jerk);
+            }
+            const double z_jerk = std::abs(current_feedrate[Z_AXIS][idx] - previous_feedrate(Z_AXIS));
+            if (z_jerk > max_z_jerk)
+            {
+                vmax_junction_factor = std::min(vmax_junction_factor, Ratio(max_z_jerk / z_jerk));
+            }
+            const double e_jerk = std::abs(current_feedrate[E_AXIS][idx] - previous_feedrate(E_AXIS));
+            if (e_jerk > max_e_jerk)
+            {
+                vmax_junction_factor = std::min(vmax_junction_factor, Ratio(max_e_jerk / e_jerk));
+            }
+            vmax_junction = std::min(Velocity{ previous_nominal_feedrate }, Velocity{ vmax_junction * vmax_junction_factor }); // Limit speed to max previous speed
+        }
 
-    currentPosition = newPos;
+        speed_profile.max_entry_speed[move_idx] = vmax_junction;
 
-    calculateTrapezoidForBlock(&block, Ratio(block.entry_speed / block.nominal_feedrate), Ratio(safe_speed / block.nominal_feedrate));
+        const Velocity v_allowable = maxAllowableSpeed(-moves.acceleration[move_idx], MINIMUM_PLANNER_SPEED, moves.distance[move_idx]);
+        speed_profile.entry_speed[move_idx] = std::min(vmax_junction, v_allowable);
+        speed_profile.nominal_length_flag[move_idx] = nominal_feedrate <= v_allowable;
+        speed_profile.recalculate_flag[move_idx] = true; // Always calculate trapezoid for new block
+    }
 
-    blocks.push_back(block);
+    for (size_t n = 0; n < NUM_AXIS; n++)
+    {
+        last_feedrate[n] = current_feedrate[n][count - 1];
+    }
+    last_nominal_feedrate = speed_profile.nominal_feedrate[last - 1];
 }
 
 std::vector<Duration> TimeEstimateCalculator::calculate()
 {
-    reversePass();
-    forwardPass();
-    recalculateTrapezoids();
+    prepareMoves();
+    return sumDurations(profile);
+}
+
+std::vector<Duration> TimeEstimateCalculator::calculate(const Ratio& speed_factor)
+{
+    prepareMoves();
+    SpeedProfile speed_profile;
+    if (moves.size() > 0)
+    {
+        // The junction speed of the first move doesn't depend on what came before it.
+        Position last_feedrate;
+        Velocity last_nominal_feedrate = 0.0;
+        planSpeeds(0, speed_factor, last_feedrate, last_nominal_feedrate, speed_profile);
+    }
+    return sumDurations(speed_profile);
+}
+
+std::vector<Duration> TimeEstimateCalculator::sumDurations(SpeedProfile& speed_profile) const
+{
+    reversePass(speed_profile);
+    forwardPass(speed_profile);
+    recalculateTrapezoids(speed_profile);
 
     std::vector<Duration> totals(static_cast<unsigned char>(PrintFeatureType::NumPrintFeatureTypes), 0.0);
     totals[static_cast<unsigned char>(PrintFeatureType::NoneType)] = extra_time; // Extra time (pause for minimum layer time, etc) is marked as NoneType
-    for (unsigned int n = 0; n < blocks.size(); n++)
+    for (size_t n = 0; n < speed_profile.size(); n++)
     {
-        const Block& block = blocks[n];
-        const double plateau_distance = block.decelerate_after - block.accelerate_until;
+        const double plateau_distance = speed_profile.decelerate_after[n] - speed_profile.accelerate_until[n];
+        Duration& total = totals[static_cast<unsigned char>(moves.feature[n])];
 
-        totals[static_cast<unsigned char>(block.feature)] += accelerationTimeFromDistance(block.initial_feedrate, block.accelerate_until, block.acceleration);
-        totals[static_cast<unsigned char>(block.feature)] += plateau_distance / block.nominal_feedrate;
-        totals[static_cast<unsigned char>(block.feature)] += accelerationTimeFromDistance(block.final_feedrate, (block.distance - block.decelerate_after), block.acceleration);
+        total += accelerationTimeFromDistance(speed_profile.initial_feedrate[n], speed_profile.accelerate_until[n], moves.acceleration[n]);
+        total += plateau_distance / speed_profile.nominal_feedrate[n];
+        total += accelerationTimeFromDistance(speed_profile.final_feedrate[n], (moves.distance[n] - speed_profile.decelerate_after[n]), moves.acceleration[n]);
     }
     return totals;
 }
 
-void TimeEstimateCalculator::plannerReversePassKernel(Block* previous, Block* current, Block* next)
+// Scans the plan from last to first entry.
+void TimeEstimateCalculator::reversePass(SpeedProfile& speed_profile) const
 {
-    (void)previous;
-    if (! current || ! next)
+    // The first block is never changed, its entry speed is where the plan starts.
+    for (size_t next = speed_profile.size(); next-- > 2;)
     {
-        return;
-    }
+        const size_t current = next - 1;
 
-    // If entry speed is already at the maximum entry speed, no need to recheck. Block is cruising.
-    // If not, block in state of acceleration or deceleration. Reset entry speed to maximum and
-    // check for maximum allowable speed reductions to ensure maximum possible planned speed.
-    if (current->entry_speed != current->max_entry_speed)
-    {
-        // If nominal length true, max junction speed is guaranteed to be reached. Only compute
-        // for max allowable speed if block is decelerating and nominal length is false.
-        if ((! current->nominal_length_flag) && (current->max_entry_speed > next->entry_speed))
-        {
-            current->entry_speed = std::min(current->max_entry_speed, maxAllowableSpeed(-current->acceleration, next->entry_speed, current->distance));
-        }
-        else
+        // If entry speed is already at the maximum entry speed, no need to recheck. Block is cruising.
+        // If not, block in state of acceleration or deceleration. Reset entry speed to maximum and
+        // check for maximum allowable speed reductions to ensure maximum possible planned speed.
+        if (speed_profile.entry_speed[current] != speed_profile.max_entry_speed[current])
         {
-            current->entry_speed = current->max_entry_speed;
+            // If nominal length true, max junction speed is guaranteed to be reached. Only compute
+            // for max allowable speed if block is decelerating and nominal length is false.
+            if ((! speed_profile.nominal_length_flag[current]) && (speed_profile.max_entry_speed[current] > speed_profile.entry_speed[next]))
+            {
+                speed_profile.entry_speed[current] = std::min(
+                    speed_profile.max_entry_speed[current],
+                    static_cast<double>(maxAllowableSpeed(-moves.acceleration[current], speed_profile.entry_speed[next], moves.distance[current])));
+            }
+            else
+            {
+                speed_profile.entry_speed[current] = speed_profile.max_entry_speed[current];
+            }
+            speed_profile.recalculate_flag[current] = true;
         }
-        current->recalculate_flag = true;
-    }
-}
-
-void TimeEstimateCalculator::reversePass()
-{
-    Block* block[3] = { nullptr, nullptr, nullptr };
-    for (size_t n = blocks.size() - 1; int(n) >= 0; n--)
-    {
-        block[2] = block[1];
-        block[1] = block[0];
-        block[0] = &blocks[n];
-        plannerReversePassKernel(block[0], block[1], block[2]);
     }
 }
 
-void TimeEstimateCalculator::plannerForwardPassKernel(Block* previous, Block* current, Block* next)
+// Scans the plan from first to last entry.
+void TimeEstimateCalculator::forwardPass(SpeedProfile& speed_profile) const
 {
-    (void)next;
-    if (! previous)
+    for (size_t current = 1; current < speed_profile.size(); current++)
     {
-        return;
-    }
+        const size_t previous = current - 1;
 
-    // If the previous block is an acceleration block, but it is not long enough to complete the
-    // full speed change within the block, we need to adjust the entry speed accordingly. Entry
-    // speeds have already been reset, maximized, and reverse planned by reverse planner.
-    // If nominal length is true, max junction speed is guaranteed to be reached. No need to recheck.
-    if (! previous->nominal_length_flag)
-    {
-        if (previous->entry_speed < current->entry_speed)
+        // If the previous block is an acceleration block, but it is not long enough to complete the
+        // full speed change within the block, we need to adjust the entry speed accordingly. Entry
+        // speeds have already been reset, maximized, and reverse planned by reverse planner.
+        // If nominal length is true, max junction speed is guaranteed to be reached. No need to recheck.
+        if (! speed_profile.nominal_length_flag[previous])
         {
-            const Velocity entry_speed = std::min(current->entry_speed, maxAllowableSpeed(-previous->acceleration, previous->entry_speed, previous->distance));
-
-            // Check for junction speed change
-            if (current->entry_speed != entry_speed)
+            if (speed_profile.entry_speed[previous] < speed_profile.entry_speed[current])
             {
-                current->entry_speed = entry_speed;
-                current->recalculate_flag = true;
+                const double entry_speed = std::min(
+                    speed_profile.entry_speed[current],
+                    static_cast<double>(maxAllowableSpeed(-moves.acceleration[previous], speed_profile.entry_speed[previous], moves.distance[previous])));
+
+                // Check for junction speed change
+                if (speed_profile.entry_speed[current] != entry_speed)
+                {
+                    speed_profile.entry_speed[current] = entry_speed;
+                    speed_profile.recalculate_flag[current] = true;
+                }
             }
         }
     }
 }
 
-void TimeEstimateCalculator::forwardPass()
+void TimeEstimateCalculator::recalculateTrapezoids(SpeedProfile& speed_profile) const
 {
-    Block* block[3] = { nullptr, nullptr, nullptr };
-    for (size_t n = 0; n < blocks.size(); n++)
+    if (speed_profile.size() == 0)
     {
-        block[0] = block[1];
-        block[1] = block[2];
-        block[2] = &blocks[n];
-        plannerForwardPassKernel(block[0], block[1], block[2]);
+        return;
     }
-    plannerForwardPassKernel(block[1], block[2], nullptr);
-}
 
-void TimeEstimateCalculator::recalculateTrapezoids()
-{
-    Block* current;
-    Block* next = nullptr;
-
-    for (unsigned int n = 0; n < blocks.size(); n++)
+    for (size_t next = 1; next < speed_profile.size(); next++)
     {
-        current = next;
-        next = &blocks[n];
-        if (current)
+        const size_t current = next - 1;
+        // Recalculate if current block entry or exit junction speed has changed.
+        if (speed_profile.recalculate_flag[current] || speed_profile.recalculate_flag[next])
         {
-            // Recalculate if current block entry or exit junction speed has changed.
-            if (current->recalculate_flag || next->recalculate_flag)
-            {
-                // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-                calculateTrapezoidForBlock(current, Ratio(current->entry_speed / current->nominal_feedrate), Ratio(next->entry_speed / current->nominal_feedrate));
-                current->recalculate_flag = false; // Reset current only to ensure next trapezoid is computed
-            }
+            // NOTE: Entry and exit factors always > 0 by all previous logic operations.
+            calculateTrapezoidForBlock(
+                speed_profile,
+                current,
+                Ratio(speed_profile.entry_speed[current] / speed_profile.nominal_feedrate[current]),
+                Ratio(speed_profile.entry_speed[next] / speed_profile.nominal_feedrate[current]));
+            speed_profile.recalculate_flag[current] = false; // Reset current only to ensure next trapezoid is computed
         }
     }
     // Last/newest block in buffer. Exit speed is set with MINIMUM_PLANNER_SPEED. Always recalculated.
-    if (next != nullptr)
-    {
-        calculateTrapezoidForBlock(next, Ratio(next->entry_speed / next->nominal_feedrate), Ratio(MINIMUM_PLANNER_SPEED / next->nominal_feedrate));
-        next->recalculate_flag = false;
-    }
+    const size_t last = speed_profile.size() - 1;
+    calculateTrapezoidForBlock(
+        speed_profile,
+        last,
+        Ratio(speed_profile.entry_speed[last] / speed_profile.nominal_feedrate[last]),
+        Ratio(MINIMUM_PLANNER_SPEED / speed_profile.nominal_feedrate[last]));
+    speed_profile.recalculate_flag[last] = false;
 }
 
 } // namespace cura
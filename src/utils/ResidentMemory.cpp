@@ -0,0 +1,101 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/ResidentMemory.h"
+
+#if defined(__linux__)
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h> // sysconf
+#elif defined(__APPLE__) && defined(__MACH__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#elif defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h> // After windows.h, which it depends on.
+#endif
+
+namespace cura
+{
+
+size_t getCurrentResidentMemory()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (! (statm >> total_pages >> resident_pages))
+    {
+        return 0;
+    }
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif defined(__APPLE__) && defined(__MACH__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+    return info.resident_size;
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+#else
+    return 0;
+#endif
+}
+
+size_t getPeakResidentMemory()
+{
+#if defined(__linux__)
+    // Unlike getrusage(), the high water mark in /proc/self/status can be reset with /proc/self/clear_refs.
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        constexpr std::string_view key = "VmHWM:";
+        if (line.starts_with(key))
+        {
+            return std::stoull(line.substr(key.size())) * 1024; // In kB.
+        }
+    }
+    return 0;
+#elif defined(__APPLE__) && defined(__MACH__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(usage.ru_maxrss); // In bytes on macOS, unlike on Linux.
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    return 0;
+#endif
+}
+
+bool resetPeakResidentMemory()
+{
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5"; // Resets the peak resident set size to the current resident set size.
+    clear_refs.flush();
+    return clear_refs.good();
+#else
+    return false;
+#endif
+}
+
+} // namespace cura
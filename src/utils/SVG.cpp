@@ -489,7 +489,7 @@ void SVG::write(const STHalfEdge& edge, const STVisualAttributes& visual_attribu
 
     if (visual_attributes.junctions.isDisplayed() && edge.data_.hasExtrusionJunctions())
     {
-        std::shared_ptr<LineJunctions> junctions = edge.data_.getExtrusionJunctions();
+        const LineJunctions* junctions = edge.data_.getExtrusionJunctions();
         for (const ExtrusionJunction& junction : *junctions)
         {
             write(junction.p_, visual_attributes.junctions);
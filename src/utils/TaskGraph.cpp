@@ -0,0 +1,157 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/TaskGraph.h"
+
+#include <cassert>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace cura
+{
+
+namespace
+{
+
+/*! \brief Escape a string to put it between the quotes of a JSON string. */
+std::string escapeJson(const std::string_view text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char character : text)
+    {
+        switch (character)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                escaped += fmt::format("\\u{:04x}", static_cast<unsigned char>(character));
+            }
+            else
+            {
+                escaped += character;
+            }
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+TaskGraph::task_id_t TaskGraph::addTask(std::string name, std::function<void()> work)
+{
+    tasks_.push_back(Task{ .name_ = std::move(name), .work_ = std::move(work) });
+    return tasks_.size() - 1;
+}
+
+void TaskGraph::addDependency(const task_id_t before, const task_id_t after)
+{
+    assert(before < tasks_.size() && after < tasks_.size() && before != after);
+    tasks_[before].successors_.push_back(after);
+    tasks_[after].predecessor_count_++;
+}
+
+void TaskGraph::run(ThreadPool& thread_pool)
+{
+    if (tasks_.empty())
+    {
+        return;
+    }
+    thread_pool_ = &thread_pool;
+    run_start_ = std::chrono::steady_clock::now();
+    remaining_tasks_ = tasks_.size();
+    pending_predecessors_ = std::make_unique<std::atomic<size_t>[]>(tasks_.size());
+    pool_tasks_.clear();
+    pool_tasks_.reserve(tasks_.size());
+    for (task_id_t task_id = 0; task_id < tasks_.size(); task_id++)
+    {
+        pending_predecessors_[task_id] = tasks_[task_id].predecessor_count_;
+        pool_tasks_.emplace_back(
+            [this, task_id]()
+            {
+                runTask(task_id);
+            });
+    }
+
+    for (task_id_t task_id = 0; task_id < tasks_.size(); task_id++)
+    {
+        if (tasks_[task_id].predecessor_count_ == 0)
+        {
+            thread_pool.push(std::span(&pool_tasks_[task_id], 1));
+        }
+    }
+    thread_pool.work_until_done(remaining_tasks_);
+}
+
+void TaskGraph::runTask(const task_id_t task_id)
+{
+    Task& task = tasks_[task_id];
+    if (trace_)
+    {
+        task.thread_ = std::this_thread::get_id();
+        task.start_ = std::chrono::steady_clock::now();
+    }
+    task.work_();
+    if (trace_)
+    {
+        task.end_ = std::chrono::steady_clock::now();
+    }
+
+    for (const task_id_t successor_id : task.successors_)
+    {
+        if (pending_predecessors_[successor_id].fetch_sub(1) == 1)
+        { // Pushed to the deque of this thread, so that it runs next here unless another thread steals it
+            thread_pool_->push(std::span(&pool_tasks_[successor_id], 1));
+        }
+    }
+    // The graph may be destroyed as soon as run() sees that no tasks remain, so no member may be read after the decrement.
+    ThreadPool* const thread_pool = thread_pool_;
+    if (remaining_tasks_.fetch_sub(1) == 1)
+    {
+        thread_pool->notify_done();
+    }
+}
+
+void TaskGraph::writeTrace(const std::filesystem::path& path) const
+{
+    assert(trace_ && "The times of the tasks are only recorded when tracing.");
+    std::ofstream out(path);
+    if (! out.good())
+    {
+        spdlog::error("Could not write the task trace to {}.", path.string());
+        return;
+    }
+
+    std::unordered_map<std::thread::id, size_t> thread_numbers;
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const Task& task : tasks_)
+    {
+        const auto thread_number = thread_numbers.emplace(task.thread_, thread_numbers.size()).first->second;
+        const auto start = std::chrono::duration_cast<std::chrono::microseconds>(task.start_ - run_start_).count();
+        const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(task.end_ - task.start_).count();
+        out << (first ? "" : ",\n") << fmt::format(R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{},"dur":{}}})", escapeJson(task.name_), thread_number, start, duration);
+        first = false;
+    }
+    out << "\n]}\n";
+    spdlog::info("Wrote the timeline of {} tasks on {} threads to {}.", tasks_.size(), thread_numbers.size(), path.string());
+}
+
+} // namespace cura
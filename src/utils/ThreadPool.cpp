@@ -3,46 +3,257 @@
 
 #include "utils/ThreadPool.h"
 
+#include <functional> // std::hash
+
 namespace cura
 {
 
+namespace
+{
+
+//! The number of times that a thread looks for tasks again before it goes to sleep
+constexpr size_t idle_rounds_before_sleep = 64;
+
+std::atomic<uint64_t> next_pool_id{ 1 };
+
+//! The deque that the current thread owns, if any
+struct OwnedDeque
+{
+    uint64_t pool_id = 0;
+    size_t deque_idx = 0;
+};
+thread_local OwnedDeque owned_deque;
+
+//! Cheap random number to pick the first worker to steal from, so that thieves don't all start at the same deque
+size_t nextVictimOffset()
+{
+    thread_local uint32_t state = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+void ThreadPool::LockedQueue::push(std::span<Task> new_tasks)
+{
+    std::lock_guard lock(mutex);
+    for (Task& task : new_tasks)
+    {
+        tasks.push_back(&task);
+    }
+    size.store(tasks.size(), std::memory_order_release);
+}
+
+ThreadPool::Task* ThreadPool::LockedQueue::pop()
+{
+    if (size.load(std::memory_order_acquire) == 0)
+    {
+        return nullptr;
+    }
+    std::lock_guard lock(mutex);
+    if (tasks.empty())
+    {
+        return nullptr;
+    }
+    Task* task = tasks.front();
+    tasks.pop_front();
+    size.store(tasks.size(), std::memory_order_release);
+    return task;
+}
+
 ThreadPool::ThreadPool(size_t nthreads)
-  : wait_for_new_tasks(true)
+    : pool_id_(next_pool_id.fetch_add(1))
 {
-    for (size_t i = 0 ; i < nthreads; i++)
+    for (size_t i = 0; i < nthreads + 1; i++)
+    {
+        deques_.push_back(std::make_unique<WorkStealingDeque<Task*>>());
+    }
+    for (size_t i = 0; i < nthreads; i++)
     {
-        threads.emplace_back(&ThreadPool::worker, this);
+        threads_.emplace_back(&ThreadPool::worker, this, i);
     }
 }
 
-void ThreadPool::worker()
+void ThreadPool::push(std::span<Task> tasks)
 {
-    lock_t lock = get_lock();
-    work_while(lock, [this, &lock]()
+    if (tasks.empty())
+    {
+        return;
+    }
+    if (const std::optional<size_t> own_deque_idx = ownDequeIndex())
+    {
+        WorkStealingDeque<Task*>& deque = *deques_[*own_deque_idx];
+        for (Task& task : tasks)
         {
-            while(tasks.empty() && wait_for_new_tasks)
-            {  // Wait for a task. Signaled by ThreadPool::push() and ThreadPool::join()
-               condition.wait(lock);
-            }
-            // Returns false if the queue is empty and the pool is being disposed
-            return !tasks.empty() || wait_for_new_tasks;
-        });
+            deque.push(&task);
+        }
+    }
+    else
+    {
+        shared_tasks_.push(tasks);
+    }
+    notifyNewTasks(tasks.size());
 }
 
-void ThreadPool::join()
+void ThreadPool::push_long_running(std::span<Task> tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+    long_running_tasks_.push(tasks);
+    notifyNewTasks(tasks.size());
+}
+
+void ThreadPool::work_until_done(const std::atomic<size_t>& remaining)
+{
+    const std::optional<size_t> own_deque_idx = ownDequeIndex();
+    size_t idle_rounds = 0;
+    while (true)
+    {
+        const uint64_t done_epoch = done_epoch_.load();
+        if (remaining.load() == 0)
+        {
+            return;
+        }
+        if (Task* task = findTask(own_deque_idx, false))
+        { // Run anything while waiting, the tasks we wait for may be stuck behind it in our own deque
+            (*task)();
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < idle_rounds_before_sleep)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // All the tasks we wait for are being run by other threads, sleep until one of them is done
+        sleeping_waiters_.fetch_add(1);
+        done_epoch_.wait(done_epoch);
+        sleeping_waiters_.fetch_sub(1);
+        idle_rounds = 0;
+    }
+}
+
+void ThreadPool::notify_done()
+{
+    done_epoch_.fetch_add(1);
+    if (sleeping_waiters_.load() > 0)
+    {
+        done_epoch_.notify_all();
+    }
+}
+
+void ThreadPool::notifyNewTasks(const size_t task_count)
+{
+    new_tasks_epoch_.fetch_add(1);
+    if (sleeping_workers_.load() > 0)
+    {
+        if (task_count == 1)
+        {
+            new_tasks_epoch_.notify_one();
+        }
+        else
+        {
+            new_tasks_epoch_.notify_all();
+        }
+    }
+}
+
+std::optional<size_t> ThreadPool::ownDequeIndex()
+{
+    if (owned_deque.pool_id == pool_id_)
+    {
+        return owned_deque.deque_idx;
+    }
+    bool expected = false;
+    if (external_deque_claimed_.compare_exchange_strong(expected, true))
+    { // The first thread other than the workers to push tasks (normally the main thread) keeps the last deque for good
+        owned_deque = { .pool_id = pool_id_, .deque_idx = deques_.size() - 1 };
+        return owned_deque.deque_idx;
+    }
+    return std::nullopt;
+}
+
+ThreadPool::Task* ThreadPool::findTask(const std::optional<size_t> own_deque_idx, const bool include_long_running)
+{
+    if (own_deque_idx)
+    {
+        if (Task* task = deques_[*own_deque_idx]->pop())
+        {
+            return task;
+        }
+    }
+    if (include_long_running)
+    {
+        if (Task* task = long_running_tasks_.pop())
+        {
+            return task;
+        }
+    }
+    if (Task* task = shared_tasks_.pop())
+    {
+        return task;
+    }
+    const size_t deque_count = deques_.size();
+    const size_t offset = nextVictimOffset();
+    for (size_t i = 0; i < deque_count; i++)
+    {
+        const size_t victim_idx = (offset + i) % deque_count;
+        if (victim_idx == own_deque_idx)
+        {
+            continue;
+        }
+        if (Task* task = deques_[victim_idx]->steal())
+        {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::worker(const size_t deque_idx)
 {
-    { // Joinning thread becomes a worker while there is remaining tasks
-        lock_t lock = get_lock();
-        wait_for_new_tasks = false;
-        condition.notify_all();
-        work_while(lock, []{ return true; });
+    owned_deque = { .pool_id = pool_id_, .deque_idx = deque_idx };
+    size_t idle_rounds = 0;
+    while (true)
+    {
+        const uint64_t new_tasks_epoch = new_tasks_epoch_.load();
+        if (Task* task = findTask(deque_idx, true))
+        {
+            (*task)();
+            idle_rounds = 0;
+            continue;
+        }
+        if (stop_.load())
+        { // Nothing left to do and nothing will be pushed anymore
+            return;
+        }
+        if (++idle_rounds < idle_rounds_before_sleep)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // Sleep until new tasks are pushed. Signaled by ThreadPool::notifyNewTasks() and ThreadPool::join()
+        sleeping_workers_.fetch_add(1);
+        new_tasks_epoch_.wait(new_tasks_epoch);
+        sleeping_workers_.fetch_sub(1);
+        idle_rounds = 0;
     }
-    assert(tasks.empty());
-    for (auto& thread : threads)
+}
+
+void ThreadPool::join()
+{
+    stop_.store(true);
+    new_tasks_epoch_.fetch_add(1);
+    new_tasks_epoch_.notify_all();
+    for (auto& thread : threads_)
     {
         thread.join();
     }
-    threads.clear();
+    threads_.clear();
 }
 
 } //Cura namespace.
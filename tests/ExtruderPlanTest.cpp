@@ -7,6 +7,8 @@
 
 #include "LayerPlan.h" //Code under test.
 #include "pathPlanning/SpeedDerivatives.h"
+#include "settings/Settings.h" //To set firmware settings.
+#include "timeEstimate.h" //To estimate the layer time with acceleration.
 
 // NOLINTBEGIN(*-magic-numbers)
 namespace cura
@@ -482,5 +484,131 @@ TEST_F(ExtruderPlanTest, BackPressureCompensationEmptyPlan)
 
     EXPECT_TRUE(extruder_plan.paths_.empty()) << "The paths in the extruder plan should remain empty. Also it shouldn't crash.";
 }
+
+/*!
+ * A fixture to test the minimum layer time with a layer of many short lines, of
+ * which the time is underestimated a lot when acceleration is ignored.
+ */
+class ExtruderPlanMinimalLayerTimeTest : public testing::Test
+{
+public:
+    static constexpr double min_speed = 10.0;
+
+    ExtruderPlan extruder_plan;
+    GCodePathConfig extrusion_config;
+    GCodePathConfig travel_config;
+    Settings settings;
+
+    ExtruderPlanMinimalLayerTimeTest()
+        : extruder_plan(
+            /*extruder=*/0,
+            /*layer_nr=*/50,
+            /*is_initial_layer=*/false,
+            /*is_raft_layer=*/false,
+            /*layer_thickness=*/100,
+            fanSpeedLayerTimeSettings(),
+            RetractionConfig())
+        , extrusion_config(GCodePathConfig{ .type = PrintFeatureType::Infill,
+                                            .line_width = 400,
+                                            .layer_thickness = 100,
+                                            .flow = 1.0_r,
+                                            .speed_derivatives = SpeedDerivatives{ .speed = 50.0, .acceleration = 500.0, .jerk = 5.0 } })
+        , travel_config(GCodePathConfig{ .type = PrintFeatureType::MoveUnretracted,
+                                         .line_width = 0,
+                                         .layer_thickness = 100,
+                                         .flow = 0.0_r,
+                                         .speed_derivatives = SpeedDerivatives{ .speed = 120.0, .acceleration = 500.0, .jerk = 5.0 } })
+    {
+        settings.add("machine_max_feedrate_x", "300");
+        settings.add("machine_max_feedrate_y", "300");
+        settings.add("machine_max_feedrate_z", "40");
+        settings.add("machine_max_feedrate_e", "45");
+        settings.add("machine_max_acceleration_x", "9000");
+        settings.add("machine_max_acceleration_y", "9000");
+        settings.add("machine_max_acceleration_z", "100");
+        settings.add("machine_max_acceleration_e", "10000");
+        settings.add("machine_max_jerk_xy", "5");
+        settings.add("machine_max_jerk_z", "0.4");
+        settings.add("machine_max_jerk_e", "5");
+        settings.add("machine_minimum_feedrate", "0");
+        settings.add("machine_acceleration", "500");
+        settings.add("acceleration_enabled", "False");
+        settings.add("jerk_enabled", "False");
+        settings.add("material_diameter", "2.85");
+
+        // A zigzag of 1mm lines, too short to reach the speed of 50mm/s, after a travel move to its start.
+        GCodePath& travel = extruder_plan.paths_.emplace_back(GCodePath{ .config = travel_config, .space_fill_type = SpaceFillType::None, .flow = 0.0_r, .width_factor = 1.0_r });
+        travel.points = { Point3LL(1000, 1000, 0) };
+        GCodePath& zigzag = extruder_plan.paths_.emplace_back(GCodePath{ .config = extrusion_config, .space_fill_type = SpaceFillType::Lines, .flow = 1.0_r, .width_factor = 1.0_r });
+        for (coord_t x = 1000; x < 21000; x += 400)
+        {
+            zigzag.points.emplace_back(x, 2000, 0);
+            zigzag.points.emplace_back(x + 400, 2000, 0);
+            zigzag.points.emplace_back(x + 400, 1000, 0);
+        }
+        extruder_plan.computeNaiveTimeEstimates(Point2LL(0, 0));
+    }
+
+    static FanSpeedLayerTimeSettings fanSpeedLayerTimeSettings()
+    {
+        FanSpeedLayerTimeSettings fan_speed_layer_time_settings{};
+        fan_speed_layer_time_settings.cool_min_speed = min_speed;
+        fan_speed_layer_time_settings.cool_min_layer_time_estimate_acceleration = true;
+        return fan_speed_layer_time_settings;
+    }
+
+    double estimateLayerTime() const
+    {
+        std::vector<Duration> durations = extruder_plan.planTimeEstimate(settings).calculate();
+        return std::accumulate(durations.begin(), durations.end(), 0.0);
+    }
+};
+
+TEST_F(ExtruderPlanMinimalLayerTimeTest, NoSlowDownWhenAccelerationMakesLayerLongEnough)
+{
+    const double naive_time = extruder_plan.estimates_.getTotalTime();
+    const double estimated_time = estimateLayerTime();
+    ASSERT_GT(estimated_time, naive_time * 1.2) << "The layer must take much longer with acceleration, or this doesn't test much.";
+
+    const double min_time = (naive_time + estimated_time) / 2;
+    ExtruderPlan naive_plan = extruder_plan;
+    naive_plan.fan_speed_layer_time_settings_.cool_min_layer_time_estimate_acceleration = false;
+    EXPECT_TRUE(naive_plan.forceMinimalLayerTime(min_time, 0.0)) << "The naive estimate is shorter than the minimum layer time.";
+
+    TimeEstimateCalculator calculator = extruder_plan.planTimeEstimate(settings);
+    EXPECT_FALSE(extruder_plan.forceMinimalLayerTimeWithAcceleration(min_time, 0.0, calculator)) << "With acceleration, the layer takes long enough already.";
+    EXPECT_EQ(extruder_plan.paths_.back().speed_factor, 1.0_r);
+}
+
+TEST_F(ExtruderPlanMinimalLayerTimeTest, SlowsDownToMinimumLayerTime)
+{
+    const double min_time = estimateLayerTime() * 1.2;
+    TimeEstimateCalculator calculator = extruder_plan.planTimeEstimate(settings);
+    EXPECT_TRUE(extruder_plan.forceMinimalLayerTimeWithAcceleration(min_time, 0.0, calculator));
+
+    const GCodePath& zigzag = extruder_plan.paths_.back();
+    EXPECT_LT(zigzag.speed_factor, 1.0_r);
+    EXPECT_GT(zigzag.config.getSpeed() * zigzag.speed_factor, min_speed);
+    EXPECT_EQ(extruder_plan.paths_.front().speed_factor, 1.0_r) << "Travel moves must not be slowed down.";
+    EXPECT_DOUBLE_EQ(extruder_plan.extra_time_, 0.0);
+
+    // All extrusion paths are slowed down evenly, so planning the slowed down paths again gives the same estimate.
+    const double slowed_down_time = estimateLayerTime();
+    EXPECT_GE(slowed_down_time, min_time - 0.01);
+    EXPECT_NEAR(slowed_down_time, min_time, min_time * 0.01);
+}
+
+TEST_F(ExtruderPlanMinimalLayerTimeTest, WaitsWhenMinimumSpeedIsNotSlowEnough)
+{
+    const double min_time = 1000.0;
+    TimeEstimateCalculator calculator = extruder_plan.planTimeEstimate(settings);
+    EXPECT_TRUE(extruder_plan.forceMinimalLayerTimeWithAcceleration(min_time, 0.0, calculator));
+
+    const GCodePath& zigzag = extruder_plan.paths_.back();
+    EXPECT_NEAR(zigzag.config.getSpeed() * zigzag.speed_factor, min_speed, 0.000001);
+    EXPECT_DOUBLE_EQ(extruder_plan.temperature_factor_, 1.0);
+    EXPECT_GT(extruder_plan.extra_time_, 0.0);
+    EXPECT_NEAR(estimateLayerTime() + extruder_plan.extra_time_, min_time, 0.01);
+}
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
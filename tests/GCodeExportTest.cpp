@@ -6,11 +6,14 @@
 #include <gtest/gtest.h>
 
 #include "Application.h" // To set up a slice with settings.
+#include "PrintInformation.h" // To stream GCode.
 #include "RetractionConfig.h" // For extruder switch tests.
 #include "Slice.h" // To set up a slice with settings.
 #include "WipeScriptConfig.h" // For wipe script tests.
 #include "arcus/MockCommunication.h" // To prevent calls to any missing Communication class.
 #include "gcode_export/GCodePart.h"
+#include "gcode_export/GCodeSpool.h"
+#include "gcode_export/SpooledGCodePart.h"
 #include "utils/Coord_t.h"
 #include "utils/Date.h" // To check the Griffin header.
 
@@ -83,6 +86,10 @@ public:
             output_ << gcode_part->str();
         }
         gcode.gcode_parts_.clear();
+        gcode.streamed_parts_count_ = 0;
+        gcode.spooled_parts_count_ = 0;
+        gcode.examined_parts_count_ = 0;
+        gcode.unspooled_gcode_size_ = 0;
         gcode.prepareNewFixedGCodePart();
         return output_;
     }
@@ -310,6 +317,191 @@ INSTANTIATE_TEST_SUITE_P(GriffinHeaderTestInstantiation, GriffinHeaderTest, test
 /*
  * Test the default header generation.
  */
+TEST_F(GCodeExportTest, SpoolFinishedGCodeParts)
+{
+    gcode.gcode_spool_threshold_ = 0; // Spool everything that is finished.
+    gcode.writeComment("first layer");
+    gcode.setLayerNr(1);
+    gcode.writeComment("second layer");
+    gcode.setLayerNr(2);
+    gcode.writeComment("third layer");
+
+    size_t spooled_parts = 0;
+    for (const std::shared_ptr<GCodePart>& gcode_part : gcode.gcode_parts_)
+    {
+        spooled_parts += std::dynamic_pointer_cast<SpooledGCodePart>(gcode_part) != nullptr;
+    }
+    if (gcode.gcode_spool_ && gcode.gcode_spool_->isOpen())
+    {
+        EXPECT_EQ(size_t(2), spooled_parts) << "Both finished layers should be moved to the spool.";
+    }
+    EXPECT_EQ(std::string(";first layer\n;second layer\n;third layer\n"), output().str()) << "Spooling must not change the GCode.";
+}
+
+TEST_F(GCodeExportTest, WriteExtrusionWithFormattedXY)
+{
+    gcode.is_volumetric_ = true;
+    gcode.setFlowRateExtrusionSettings(0.0, 0.0);
+    gcode.extruder_attr_[0].nozzle_offset_ = Point2LL(1500, -250);
+    const std::vector<Point3LL> points = { Point3LL(1000, 2000, 0), Point3LL(-3005, 2000, 0), Point3LL(-3005, 2000, 0), Point3LL(123456, -7, 0) };
+    const Point3LL layer_z(0, 0, MM2INT(20));
+
+    for (const Point3LL& point : points)
+    {
+        gcode.writeExtrusion(point + layer_z, Velocity(50), 0.1, PrintFeatureType::OuterWall);
+    }
+    const std::string expected = output().str();
+
+    output_.str("");
+    gcode.current_position_ = layer_z;
+    gcode.current_e_value_ = 0;
+    gcode.current_speed_ = 1.0;
+    const std::string formatted_xy = gcode.formatExtrusionXY(points, 0);
+    std::string_view remaining_xy = formatted_xy;
+    for (const Point3LL& point : points)
+    {
+        gcode.writeExtrusion(point + layer_z, Velocity(50), 0.1, PrintFeatureType::OuterWall, false, GCodeExport::popFormattedXY(remaining_xy));
+    }
+    EXPECT_TRUE(remaining_xy.empty()) << "The formatted coordinates of all points should be used.";
+    EXPECT_EQ(output().str(), expected) << "Formatting the coordinates ahead of time must not change the g-code.";
+}
+
+TEST_F(GCodeExportTest, StreamFinishedGCodeParts)
+{
+    Application::getInstance().current_slice_->scene.current_mesh_group->settings.add("layer_height", "0.1"); // For the header.
+    gcode.stream_gcode_ = true;
+    EXPECT_CALL(*mock_communication, supportsGCodeStreaming()).WillRepeatedly(testing::Return(true));
+    std::vector<std::string> sent;
+    EXPECT_CALL(*mock_communication, sendGCodePart(testing::_))
+        .WillRepeatedly(
+            [&sent](const std::string& gcode_part)
+            {
+                sent.push_back(gcode_part);
+            });
+
+    gcode.writeComment("first layer");
+    gcode.writeResolvableGCode("M117 Printing");
+    gcode.setLayerNr(1);
+    gcode.writeComment("second layer");
+    gcode.writeResolvableGCode("M117 {print_time}");
+    gcode.writeComment("third layer");
+
+    PrintInformation print_info;
+    gcode.sendFinishedGCodeParts(print_info);
+    EXPECT_TRUE(sent.empty()) << "Nothing can be sent before the initial extruder is known.";
+
+    print_info.initial_extruder_nr = 0;
+    gcode.sendFinishedGCodeParts(print_info);
+    ASSERT_EQ(sent.size(), size_t(4)) << "The header and the finished GCode up to the part that refers to the print time should be sent.";
+    EXPECT_TRUE(sent[0].starts_with(";FLAVOR:Marlin\n")) << "The header should come first.";
+    EXPECT_EQ(sent[0].size(), gcode.streamed_header_size_.value()) << "The whole header region should be sent at once.";
+    EXPECT_EQ(sent[1], ";first layer\n");
+    EXPECT_EQ(sent[2], "M117 Printing\n") << "GCode that doesn't refer to the totals of the print can be resolved right away.";
+    EXPECT_EQ(sent[3], ";second layer\n");
+
+    gcode.setLayerNr(2);
+    gcode.sendFinishedGCodeParts(print_info);
+    EXPECT_EQ(sent.size(), size_t(4)) << "Nothing after the part that refers to the print time can be sent before the end.";
+}
+
+TEST_F(GCodeExportTest, NoStreamingWithoutSupport)
+{
+    Application::getInstance().current_slice_->scene.current_mesh_group->settings.add("layer_height", "0.1"); // For the header.
+    gcode.stream_gcode_ = true;
+    EXPECT_CALL(*mock_communication, supportsGCodeStreaming()).WillRepeatedly(testing::Return(false));
+    EXPECT_CALL(*mock_communication, sendGCodePart(testing::_)).Times(0);
+
+    gcode.writeComment("first layer");
+    gcode.setLayerNr(1);
+    PrintInformation print_info;
+    print_info.initial_extruder_nr = 0;
+    gcode.sendFinishedGCodeParts(print_info);
+
+    EXPECT_FALSE(gcode.stream_gcode_) << "The GCode should be sent at the end, when the header can be written with the totals of the print.";
+    EXPECT_FALSE(gcode.streamed_header_size_.has_value());
+}
+
+TEST_F(GCodeExportTest, StreamedHeaderIsOverwritten)
+{
+    Application::getInstance().startThreadPool(2);
+    Application::getInstance().current_slice_->scene.current_mesh_group->settings.add("layer_height", "0.1"); // For the header.
+    gcode.stream_gcode_ = true;
+    EXPECT_CALL(*mock_communication, supportsGCodeStreaming()).WillRepeatedly(testing::Return(true));
+    std::string streamed;
+    EXPECT_CALL(*mock_communication, sendGCodePart(testing::_))
+        .WillRepeatedly(
+            [&streamed](const std::string& gcode_part)
+            {
+                streamed += gcode_part;
+            });
+    EXPECT_CALL(*mock_communication, overwriteGCodePart(testing::_, testing::_))
+        .WillOnce(
+            [&streamed](const size_t offset, const std::string& gcode_part)
+            {
+                streamed.replace(offset, gcode_part.size(), gcode_part);
+                return true;
+            });
+
+    gcode.writeComment("first layer");
+    gcode.setLayerNr(1);
+    PrintInformation print_info;
+    print_info.initial_extruder_nr = 0;
+    gcode.sendFinishedGCodeParts(print_info);
+    const size_t header_size = gcode.streamed_header_size_.value();
+    gcode.writeComment("second layer");
+
+    const std::string final_header = ";FLAVOR:Marlin\n;TIME:123456\n";
+    gcode.finishStreamedGCode(final_header);
+
+    EXPECT_TRUE(streamed.starts_with(final_header)) << "The final header should be put in place of the streamed one.";
+    EXPECT_EQ(streamed.substr(header_size), ";first layer\n;second layer\n") << "The GCode after the header should be unchanged.";
+    const std::string padding = streamed.substr(final_header.size(), header_size - final_header.size());
+    EXPECT_TRUE(padding.starts_with(';') && padding.ends_with('\n')) << "The rest of the header region should be comment lines.";
+    EXPECT_EQ(padding.find_first_not_of("; \n"), std::string::npos) << "The rest of the header region should be comment lines.";
+    EXPECT_EQ(padding.find("\n "), std::string::npos) << "Each line of the rest of the header region should be a comment.";
+}
+
+TEST_F(GCodeExportTest, StreamedHeaderFallsBackToTrailingMetadata)
+{
+    Application::getInstance().startThreadPool(2);
+    Application::getInstance().current_slice_->scene.current_mesh_group->settings.add("layer_height", "0.1"); // For the header.
+    gcode.stream_gcode_ = true;
+    EXPECT_CALL(*mock_communication, supportsGCodeStreaming()).WillRepeatedly(testing::Return(true));
+    std::string streamed;
+    EXPECT_CALL(*mock_communication, sendGCodePart(testing::_))
+        .WillRepeatedly(
+            [&streamed](const std::string& gcode_part)
+            {
+                streamed += gcode_part;
+            });
+    EXPECT_CALL(*mock_communication, overwriteGCodePart(testing::_, testing::_)).WillRepeatedly(testing::Return(false));
+
+    gcode.writeComment("first layer");
+    gcode.setLayerNr(1);
+    PrintInformation print_info;
+    print_info.initial_extruder_nr = 0;
+    gcode.sendFinishedGCodeParts(print_info);
+
+    const std::string final_header = ";FLAVOR:Marlin\n;TIME:123456\n";
+    gcode.finishStreamedGCode(final_header);
+
+    EXPECT_TRUE(streamed.starts_with(";FLAVOR:Marlin\n;TIME:0\n")) << "The streamed header should stay when it can't be overwritten.";
+    EXPECT_TRUE(streamed.ends_with(";first layer\n;The header at the start was written before the end of the print, these are the actual values:\n" + final_header))
+        << "The final header should follow the GCode instead.";
+}
+
+TEST_F(GCodeExportTest, LongLayerKeepsAllGCode)
+{
+    std::string expected;
+    for (size_t comment_idx = 0; comment_idx < 10000; ++comment_idx)
+    {
+        const std::string comment = "comment " + std::to_string(comment_idx);
+        gcode.writeComment(comment);
+        expected += ";" + comment + "\n";
+    }
+    EXPECT_EQ(expected, output().str()) << "Growing the buffer of a layer must not lose or change any of its GCode.";
+}
+
 TEST_F(GCodeExportTest, HeaderUltiGCode)
 {
     gcode.flavor_ = EGCodeFlavor::ULTIGCODE;
@@ -0,0 +1,275 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "infill/GyroidInfill.h" // Unit under test.
+
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "geometry/OpenLinesSet.h"
+#include "geometry/OpenPolyline.h"
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "utils/AABB.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Compares the gyroid lines against the way they were computed before: every
+ * point evaluated on its own, over the whole bounding box.
+ */
+class GyroidInfillTest : public testing::Test
+{
+public:
+    using LineCoordinates = GyroidInfill::LineCoordinates;
+
+    struct DirectLineCoordinates
+    {
+        bool vertical;
+        std::vector<coord_t> odd_line_coords;
+        std::vector<coord_t> even_line_coords;
+    };
+
+    /*!
+     * The pitch and step that GyroidInfill uses for a line distance.
+     */
+    static std::pair<coord_t, coord_t> getPitchAndStep(const coord_t line_distance)
+    {
+        coord_t pitch = line_distance * 2.41;
+        coord_t num_steps = 4;
+        coord_t step = pitch / num_steps;
+        while (step > 500 && num_steps < 16)
+        {
+            num_steps *= 2;
+            step = pitch / num_steps;
+        }
+        return { step * num_steps, step };
+    }
+
+    static DirectLineCoordinates directLineCoordinates(const coord_t pitch, const coord_t step, const coord_t z)
+    {
+        const double z_rads = 2 * std::numbers::pi * z / pitch;
+        const double cos_z = std::cos(z_rads);
+        const double sin_z = std::sin(z_rads);
+        DirectLineCoordinates result;
+        result.vertical = std::abs(sin_z) <= std::abs(cos_z);
+        for (coord_t along = 0; along < pitch; along += step)
+        {
+            const double along_rads = 2 * std::numbers::pi * along / pitch;
+            if (result.vertical)
+            {
+                const double phase_offset = ((cos_z < 0) ? std::numbers::pi : 0) + std::numbers::pi;
+                const double a = cos_z;
+                const double b = std::sin(along_rads + phase_offset);
+                const double odd_c = sin_z * std::cos(along_rads + phase_offset);
+                const double even_c = sin_z * std::cos(along_rads + phase_offset + std::numbers::pi);
+                const double h = std::sqrt(a * a + b * b);
+                const double odd_x_rads = ((h != 0) ? std::asin(odd_c / h) + std::asin(b / h) : 0) - std::numbers::pi / 2;
+                const double even_x_rads = ((h != 0) ? std::asin(even_c / h) + std::asin(b / h) : 0) - std::numbers::pi / 2;
+                result.odd_line_coords.push_back(odd_x_rads / std::numbers::pi * pitch);
+                result.even_line_coords.push_back(even_x_rads / std::numbers::pi * pitch);
+            }
+            else
+            {
+                const double phase_offset = (sin_z < 0) ? std::numbers::pi : 0;
+                const double a = sin_z;
+                const double b = std::cos(along_rads + phase_offset);
+                const double odd_c = cos_z * std::sin(along_rads + phase_offset + std::numbers::pi);
+                const double even_c = cos_z * std::sin(along_rads + phase_offset);
+                const double h = std::sqrt(a * a + b * b);
+                const double odd_y_rads = ((h != 0) ? std::asin(odd_c / h) + std::asin(b / h) : 0) + std::numbers::pi / 2;
+                const double even_y_rads = ((h != 0) ? std::asin(even_c / h) + std::asin(b / h) : 0) + std::numbers::pi / 2;
+                result.odd_line_coords.push_back(odd_y_rads / std::numbers::pi * pitch);
+                result.even_line_coords.push_back(even_y_rads / std::numbers::pi * pitch);
+            }
+        }
+        return result;
+    }
+
+    /*!
+     * The lines over the whole bounding box, with every point computed on its own.
+     */
+    static OpenLinesSet directLines(const coord_t line_distance, const AABB& bounding_box, const coord_t z)
+    {
+        const auto [pitch, step] = getPitchAndStep(line_distance);
+        const DirectLineCoordinates coordinates = directLineCoordinates(pitch, step, z);
+        const size_t num_coords = coordinates.odd_line_coords.size();
+        OpenLinesSet result;
+        size_t num_lines = 0;
+        if (coordinates.vertical)
+        {
+            for (coord_t x = (std::floor(bounding_box.min_.X / pitch) - 2.25) * pitch; x <= bounding_box.max_.X + pitch / 2; x += pitch / 2)
+            {
+                OpenPolyline line;
+                for (coord_t y = (std::floor(bounding_box.min_.Y / pitch) - 1) * pitch; y <= bounding_box.max_.Y + pitch; y += pitch)
+                {
+                    for (size_t i = 0; i < num_coords; ++i)
+                    {
+                        const coord_t offset = ((num_lines & 1) ? coordinates.odd_line_coords[i] : coordinates.even_line_coords[i]) / 2;
+                        line.push_back(Point2LL(x + offset + pitch, y + static_cast<coord_t>(i) * step));
+                    }
+                }
+                result.push_back(line);
+                ++num_lines;
+            }
+        }
+        else
+        {
+            for (coord_t y = (std::floor(bounding_box.min_.Y / pitch) - 1) * pitch; y <= bounding_box.max_.Y + pitch / 2; y += pitch / 2)
+            {
+                OpenPolyline line;
+                for (coord_t x = (std::floor(bounding_box.min_.X / pitch) - 1) * pitch; x <= bounding_box.max_.X + pitch; x += pitch)
+                {
+                    for (size_t i = 0; i < num_coords; ++i)
+                    {
+                        const coord_t offset = ((num_lines & 1) ? coordinates.odd_line_coords[i] : coordinates.even_line_coords[i]) / 2;
+                        line.push_back(Point2LL(x + static_cast<coord_t>(i) * step, y + offset));
+                    }
+                }
+                result.push_back(line);
+                ++num_lines;
+            }
+        }
+        return result;
+    }
+
+    static LineCoordinates computeLineCoordinates(const coord_t pitch, const coord_t step, const coord_t z)
+    {
+        return GyroidInfill::computeLineCoordinates(pitch, step, z);
+    }
+
+    static OpenLinesSet generateParallelLines(const coord_t line_distance, const Shape& outline, const coord_t z)
+    {
+        return GyroidInfill().generateParallelLines(line_distance, outline, AABB(outline), z, 400);
+    }
+
+    static bool isClose(const Point2LL& a, const Point2LL& b)
+    {
+        // The shape of the lines is computed with slightly different floating point operations, which may round to a different micron.
+        return std::llabs(a.X - b.X) <= 1 && std::llabs(a.Y - b.Y) <= 1;
+    }
+};
+
+TEST_F(GyroidInfillTest, LineShapeMatchesDirectComputation)
+{
+    for (const coord_t line_distance : { 800, 2000, 6000 })
+    {
+        const auto [pitch, step] = getPitchAndStep(line_distance);
+        for (coord_t z = -pitch; z < 2 * pitch; z += 37)
+        {
+            const LineCoordinates coordinates = computeLineCoordinates(pitch, step, z);
+            const DirectLineCoordinates expected = directLineCoordinates(pitch, step, z);
+            ASSERT_EQ(coordinates.vertical, expected.vertical) << "line distance " << line_distance << ", z " << z;
+            ASSERT_EQ(coordinates.num_coords, expected.odd_line_coords.size()) << "line distance " << line_distance << ", z " << z;
+            for (size_t i = 0; i < coordinates.num_coords; ++i)
+            {
+                EXPECT_LE(std::llabs(coordinates.odd_line_coords[i] - expected.odd_line_coords[i]), 1) << "line distance " << line_distance << ", z " << z << ", step " << i;
+                EXPECT_LE(std::llabs(coordinates.even_line_coords[i] - expected.even_line_coords[i]), 1) << "line distance " << line_distance << ", z " << z << ", step " << i;
+            }
+        }
+    }
+}
+
+TEST_F(GyroidInfillTest, TrimmedLinesCoverOutline)
+{
+    constexpr coord_t line_distance = 2000;
+    const auto [pitch, step] = getPitchAndStep(line_distance);
+    // Vary where the rectangles end within a pitch, as the lines are trimmed to whole pitches.
+    for (coord_t shift = 0; shift < pitch; shift += step / 3 + 1)
+    {
+        // Two rectangles far apart in both directions, so that most lines only cross one of them and some lines cross neither.
+        const std::vector<AABB> rectangles{ AABB(Point2LL(-shift, shift), Point2LL(20000 + shift, 8000 + 2 * shift)),
+                                            AABB(Point2LL(45000 - 2 * shift, 30000 - shift), Point2LL(52000, 60000 + shift)) };
+        Shape outline;
+        for (const AABB& rectangle : rectangles)
+        {
+            outline.push_back(rectangle.toPolygon());
+        }
+        const AABB bounding_box(outline);
+
+        const auto touches_outline = [&rectangles](const Point2LL& start, const Point2LL& end)
+        {
+            AABB segment_box;
+            segment_box.include(start);
+            segment_box.include(end);
+            for (const AABB& rectangle : rectangles)
+            {
+                if (segment_box.hit(rectangle))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (coord_t z = 0; z < pitch; z += pitch / 7)
+        {
+            const OpenLinesSet trimmed_lines = generateParallelLines(line_distance, outline, z);
+            const OpenLinesSet direct_lines = directLines(line_distance, bounding_box, z);
+
+            std::vector<bool> direct_line_used(direct_lines.size(), false);
+            for (const OpenPolyline& trimmed_line : trimmed_lines)
+            {
+                ASSERT_FALSE(trimmed_line.empty());
+
+                // Every trimmed line is a consecutive part of one of the direct lines.
+                std::optional<size_t> direct_line_idx;
+                size_t first_point_idx = 0;
+                for (size_t line_idx = 0; line_idx < direct_lines.size() && ! direct_line_idx; ++line_idx)
+                {
+                    for (size_t point_idx = 0; point_idx < direct_lines[line_idx].size(); ++point_idx)
+                    {
+                        if (isClose(direct_lines[line_idx][point_idx], trimmed_line.front()))
+                        {
+                            direct_line_idx = line_idx;
+                            first_point_idx = point_idx;
+                            break;
+                        }
+                    }
+                }
+                ASSERT_TRUE(direct_line_idx.has_value()) << "shift " << shift << ", z " << z << ": a trimmed line starts at a point that isn't on any of the direct lines.";
+                EXPECT_FALSE(direct_line_used[*direct_line_idx]) << "shift " << shift << ", z " << z << ": two trimmed lines come from the same direct line.";
+                direct_line_used[*direct_line_idx] = true;
+
+                const OpenPolyline& direct_line = direct_lines[*direct_line_idx];
+                ASSERT_LE(first_point_idx + trimmed_line.size(), direct_line.size()) << "shift " << shift << ", z " << z << ": a trimmed line is longer than its direct line.";
+                for (size_t point_idx = 0; point_idx < trimmed_line.size(); ++point_idx)
+                {
+                    ASSERT_TRUE(isClose(trimmed_line[point_idx], direct_line[first_point_idx + point_idx])) << "shift " << shift << ", z " << z << ": a trimmed line deviates from its direct line.";
+                }
+
+                // The parts that were left out don't get near the outline, so the clipped result is the same.
+                for (size_t point_idx = 0; point_idx + 1 < direct_line.size(); ++point_idx)
+                {
+                    if (point_idx < first_point_idx || point_idx + 1 >= first_point_idx + trimmed_line.size())
+                    {
+                        EXPECT_FALSE(touches_outline(direct_line[point_idx], direct_line[point_idx + 1])) << "shift " << shift << ", z " << z << ": a segment near the outline was trimmed off.";
+                    }
+                }
+            }
+
+            // The direct lines that were left out entirely don't get near the outline either.
+            for (size_t line_idx = 0; line_idx < direct_lines.size(); ++line_idx)
+            {
+                if (direct_line_used[line_idx])
+                {
+                    continue;
+                }
+                for (size_t point_idx = 0; point_idx + 1 < direct_lines[line_idx].size(); ++point_idx)
+                {
+                    EXPECT_FALSE(touches_outline(direct_lines[line_idx][point_idx], direct_lines[line_idx][point_idx + 1])) << "shift " << shift << ", z " << z << ": a line near the outline was left out.";
+                }
+            }
+        }
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <scripta/logger.h>
@@ -297,5 +298,116 @@ TEST_P(InfillTest, TestInfillSanity)
         << "Infill (lines) should not be outside target polygon.";
 }
 
+
+/*!
+ * Tests the line segments and crossings that connectLines works with.
+ */
+class InfillCrossingsOnLineTest : public testing::Test
+{
+public:
+    using CrossingsOnLine = Infill::CrossingsOnLine;
+    using InfillLineSegment = Infill::InfillLineSegment;
+
+    /*!
+     * An outline of a square with a triangular hole, so with 4 + 3 segments.
+     */
+    Shape outline;
+
+    void SetUp() override
+    {
+        Polygon square;
+        square.emplace_back(0, 0);
+        square.emplace_back(10000, 0);
+        square.emplace_back(10000, 10000);
+        square.emplace_back(0, 10000);
+        outline.push_back(square);
+
+        Polygon triangle;
+        triangle.emplace_back(2000, 2000);
+        triangle.emplace_back(2000, 8000);
+        triangle.emplace_back(8000, 5000);
+        outline.push_back(triangle);
+    }
+};
+
+TEST_F(InfillCrossingsOnLineTest, SegmentsStayInPlace)
+{
+    CrossingsOnLine crossings_on_line;
+    std::vector<InfillLineSegment*> segments;
+    for (coord_t segment_nr = 0; segment_nr < 5000; segment_nr++) // Many blocks.
+    {
+        segments.push_back(crossings_on_line.createSegment(Point2LL(segment_nr, 0), 1, 0, Point2LL(segment_nr, 10000), 3, 0));
+    }
+
+    for (coord_t segment_nr = 0; segment_nr < 5000; segment_nr++)
+    {
+        // The line segments are linked to each other by pointer, so creating more of them must not move the earlier ones.
+        EXPECT_EQ(segments[segment_nr]->start_, Point2LL(segment_nr, 0));
+        EXPECT_EQ(segments[segment_nr]->end_, Point2LL(segment_nr, 10000));
+        EXPECT_EQ(segments[segment_nr]->previous_, nullptr);
+        EXPECT_EQ(segments[segment_nr]->next_, nullptr);
+    }
+}
+
+TEST_F(InfillCrossingsOnLineTest, GroupBySegment)
+{
+    CrossingsOnLine crossings_on_line;
+    std::vector<InfillLineSegment*> segments;
+    for (coord_t segment_nr = 0; segment_nr < 6; segment_nr++)
+    {
+        segments.push_back(crossings_on_line.createSegment(Point2LL(segment_nr * 1000, 0), 0, 0, Point2LL(segment_nr * 1000, 10000), 2, 0));
+    }
+
+    // Added out of the order of the outline, with some segments of the outline crossed more than once and others not at all.
+    crossings_on_line.addCrossing(1, 2, segments[0]);
+    crossings_on_line.addCrossing(0, 0, segments[1]);
+    crossings_on_line.addCrossing(0, 2, segments[2]);
+    crossings_on_line.addCrossing(1, 2, segments[3]);
+    crossings_on_line.addCrossing(0, 0, segments[4]);
+    crossings_on_line.addCrossing(0, 2, segments[5]);
+    crossings_on_line.addCrossing(1, 0, segments[1]);
+    crossings_on_line.groupBySegment(outline);
+
+    const auto expect_crossings = [&crossings_on_line](const size_t polygon_idx, const size_t vertex_idx, const std::vector<InfillLineSegment*>& expected)
+    {
+        const auto crossings = crossings_on_line.getCrossings(polygon_idx, vertex_idx);
+        EXPECT_EQ(std::vector<InfillLineSegment*>(crossings.begin(), crossings.end()), expected) << "Crossings of polygon " << polygon_idx << ", vertex " << vertex_idx << ".";
+    };
+    // Each segment of the outline keeps its crossings in the order in which they were added.
+    expect_crossings(0, 0, { segments[1], segments[4] });
+    expect_crossings(0, 1, {});
+    expect_crossings(0, 2, { segments[2], segments[5] });
+    expect_crossings(0, 3, {});
+    expect_crossings(1, 0, { segments[1] });
+    expect_crossings(1, 1, {});
+    expect_crossings(1, 2, { segments[0], segments[3] });
+
+    // All crossings, in the order of the outline.
+    const auto all_crossings = crossings_on_line.getAllCrossings();
+    const std::vector<InfillLineSegment*> expected_all{ segments[1], segments[4], segments[2], segments[5], segments[1], segments[0], segments[3] };
+    EXPECT_EQ(std::vector<InfillLineSegment*>(all_crossings.begin(), all_crossings.end()), expected_all);
+}
+
+TEST_F(InfillCrossingsOnLineTest, ReorderCrossingsOfSegment)
+{
+    CrossingsOnLine crossings_on_line;
+    InfillLineSegment* first = crossings_on_line.createSegment(Point2LL(1000, 0), 0, 0, Point2LL(1000, 10000), 2, 0);
+    InfillLineSegment* second = crossings_on_line.createSegment(Point2LL(2000, 0), 0, 0, Point2LL(2000, 10000), 2, 0);
+    InfillLineSegment* other = crossings_on_line.createSegment(Point2LL(0, 3000), 3, 0, Point2LL(10000, 3000), 1, 0);
+    crossings_on_line.addCrossing(0, 0, first);
+    crossings_on_line.addCrossing(0, 0, second);
+    crossings_on_line.addCrossing(0, 1, other);
+    crossings_on_line.groupBySegment(outline);
+
+    // connectLines sorts the crossings of each segment of the outline in place. That must not affect the other segments.
+    const auto crossings = crossings_on_line.getCrossings(0, 0);
+    std::swap(crossings[0], crossings[1]);
+
+    const auto reordered = crossings_on_line.getCrossings(0, 0);
+    EXPECT_EQ(std::vector<InfillLineSegment*>(reordered.begin(), reordered.end()), (std::vector<InfillLineSegment*>{ second, first }));
+    const auto unchanged = crossings_on_line.getCrossings(0, 1);
+    EXPECT_EQ(std::vector<InfillLineSegment*>(unchanged.begin(), unchanged.end()), (std::vector<InfillLineSegment*>{ other }));
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
@@ -0,0 +1,177 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "infill/LightningGenerator.h" // Unit under test.
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To set up a slice with settings and to choose the number of threads.
+#include "Slice.h" // To set up a scene with an extruder.
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "infill/LightningLayer.h"
+#include "mesh.h"
+#include "sliceDataStorage.h"
+#include "utils/AABB.h"
+#include "utils/ThreadPool.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * The trees are prepared and propagated in parallel. The result must not depend on the number of threads.
+ */
+class LightningGeneratorTest : public testing::Test
+{
+public:
+    using Branches = std::vector<std::pair<Point2LL, Point2LL>>;
+
+    static constexpr size_t layer_count = 40;
+
+    void SetUp() override
+    {
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        Scene& scene = Application::getInstance().current_slice_->scene;
+        scene.settings.add("extruder_nr", "0");
+        scene.settings.add("infill_extruder_nr", "0");
+        scene.settings.add("layer_height", "0.2");
+        scene.settings.add("infill_line_width", "0.4");
+        scene.settings.add("infill_line_distance", "3");
+        scene.settings.add("infill_wall_line_count", "0");
+        scene.settings.add("lightning_infill_overhang_angle", "40");
+        scene.settings.add("lightning_infill_prune_angle", "40");
+        scene.settings.add("lightning_infill_straightening_angle", "40");
+        scene.settings.add("cutting_mesh", "False");
+        scene.settings.add("anti_overhang_mesh", "False");
+        scene.settings.add("infill_mesh", "False");
+        scene.extruders.emplace_back(0, &scene.settings);
+
+        mesh_ = std::make_unique<Mesh>(scene.settings);
+        storage_ = std::make_unique<SliceMeshStorage>(mesh_.get(), layer_count);
+
+        // A block that narrows towards the top, with two pillars next to it that widen towards the top and end in a ledge. Every layer
+        // overhangs the one below it somewhere, so that new trees start on many layers and several trees are propagated at once.
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            // The pillars widen by more than the walls support, which is 0.2mm * tan(40°) per layer.
+            const coord_t step = static_cast<coord_t>(layer_nr) * 100;
+            const coord_t widen = static_cast<coord_t>(layer_nr) * 300;
+            Shape area;
+            area.push_back(AABB(Point2LL(-20000 + step, -20000 + step), Point2LL(20000 - step, 20000 - step)).toPolygon());
+            area.push_back(AABB(Point2LL(25000 - widen, -10000 - widen), Point2LL(30000 + widen, -5000 + widen)).toPolygon());
+            area.push_back(AABB(Point2LL(25000 - widen, 5000 - widen), Point2LL(30000 + widen, 10000 + widen)).toPolygon());
+            if (layer_nr >= layer_count - 5)
+            {
+                area.push_back(AABB(Point2LL(22000, -20000), Point2LL(45000, 20000)).toPolygon());
+            }
+            area = area.unionPolygons();
+
+            SliceLayerPart& part = storage_->layers[layer_nr].parts.emplace_back();
+            part.infill_area = area;
+        }
+    }
+
+    void TearDown() override
+    {
+        storage_.reset();
+        mesh_.reset();
+        Application::getInstance().current_slice_.reset();
+    }
+
+    /*!
+     * Generate the trees with \p thread_count threads and collect the branches of every tree, per layer.
+     */
+    std::vector<std::vector<Branches>> generate(const size_t thread_count) const
+    {
+        Application::getInstance().startThreadPool(static_cast<int>(thread_count));
+        const LightningGenerator generator(*storage_);
+
+        std::vector<std::vector<Branches>> branches_per_tree_per_layer(layer_count);
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            const LightningLayer& layer = generator.getTreesForLayer(layer_nr);
+            size_t tree_node_count = 0;
+            for (const LightningTreeNodeIdx root : layer.tree_roots)
+            {
+                layer.nodes.visitNodes(
+                    root,
+                    [&tree_node_count](const LightningTreeNodeIdx)
+                    {
+                        ++tree_node_count;
+                    });
+                Branches& branches = branches_per_tree_per_layer[layer_nr].emplace_back();
+                layer.nodes.visitBranches(
+                    root,
+                    [&branches](const Point2LL& from, const Point2LL& to)
+                    {
+                        branches.emplace_back(from, to);
+                    });
+            }
+            EXPECT_EQ(layer.nodes.size(), tree_node_count) << "Layer " << layer_nr << " keeps nodes that are no longer part of a tree.";
+        }
+        return branches_per_tree_per_layer;
+    }
+
+private:
+    std::unique_ptr<Mesh> mesh_;
+    std::unique_ptr<SliceMeshStorage> storage_;
+};
+
+TEST_F(LightningGeneratorTest, SameTreesWithAnyThreadCount)
+{
+    const std::vector<std::vector<Branches>> serial_trees = generate(1);
+    const std::vector<std::vector<Branches>> parallel_trees = generate(8);
+
+    ASSERT_GT(serial_trees.front().size(), 1) << "The bottom layer must get several trees, or this doesn't test the parallel propagation.";
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        ASSERT_EQ(serial_trees[layer_nr].size(), parallel_trees[layer_nr].size()) << "Layer " << layer_nr << " has a different number of trees.";
+        for (size_t tree_idx = 0; tree_idx < serial_trees[layer_nr].size(); ++tree_idx)
+        {
+            EXPECT_EQ(serial_trees[layer_nr][tree_idx], parallel_trees[layer_nr][tree_idx]) << "Tree " << tree_idx << " of layer " << layer_nr << " differs.";
+        }
+    }
+}
+
+TEST(LightningTreeNodePoolTest, CompactKeepsOnlyGivenTrees)
+{
+    LightningTreeNodePool nodes;
+    const LightningTreeNodeIdx dropped_root = nodes.create(Point2LL(0, 0));
+    nodes.addChild(nodes.addChild(dropped_root, Point2LL(0, 1000)), Point2LL(0, 2000));
+    const LightningTreeNodeIdx root = nodes.create(Point2LL(5000, 0), Point2LL(5000, -1000));
+    const LightningTreeNodeIdx junction = nodes.addChild(root, Point2LL(5000, 1000));
+    nodes.addChild(junction, Point2LL(4000, 2000));
+    nodes.addChild(junction, Point2LL(6000, 2000));
+    nodes.addChild(junction, Point2LL(5000, 3000));
+    nodes.addChild(dropped_root, Point2LL(1000, 0));
+
+    const auto get_branches = [&nodes](const LightningTreeNodeIdx tree_root)
+    {
+        LightningGeneratorTest::Branches branches;
+        nodes.visitBranches(
+            tree_root,
+            [&branches](const Point2LL& from, const Point2LL& to)
+            {
+                branches.emplace_back(from, to);
+            });
+        return branches;
+    };
+    const LightningGeneratorTest::Branches branches = get_branches(root);
+
+    std::vector<LightningTreeNodeIdx> roots{ root };
+    nodes.compact(roots);
+
+    EXPECT_EQ(nodes.size(), 5) << "Only the nodes of the kept tree may remain.";
+    EXPECT_EQ(get_branches(roots.front()), branches) << "The kept tree, and the order of its children, must not change.";
+    EXPECT_TRUE(nodes[roots.front()].isRoot());
+    EXPECT_EQ(nodes[roots.front()].getLastGroundingLocation(), std::make_optional(Point2LL(5000, -1000)));
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "BeadingStrategy/MemoizedBeadingStrategy.h" //Unit under test.
+
+#include <gtest/gtest.h>
+
+#include "BeadingStrategy/BeadingStrategyFactory.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * The strategy chain that WallToolPaths would make for a typical print with thin walls, before it memoizes it.
+ */
+BeadingStrategyPtr makeTypicalStrategy()
+{
+    return BeadingStrategyFactory::makeStrategy(MM2INT(0.4), MM2INT(0.45), MM2INT(0.4), std::numbers::pi / 4.0, true, MM2INT(0.2), MM2INT(0.1), 0.5_r, 0.5_r, 6, MM2INT(0.05));
+}
+
+void expectSameBeading(const BeadingStrategy::Beading& expected, const BeadingStrategy::Beading& actual)
+{
+    EXPECT_EQ(expected.total_thickness, actual.total_thickness);
+    EXPECT_EQ(expected.bead_widths, actual.bead_widths);
+    EXPECT_EQ(expected.toolpath_locations, actual.toolpath_locations);
+    EXPECT_EQ(expected.left_over, actual.left_over);
+}
+
+TEST(MemoizedBeadingStrategyTest, SameResultsAsParent)
+{
+    const BeadingStrategyPtr parent = makeTypicalStrategy();
+    constexpr size_t slot_count = 16; // Much fewer than the thicknesses below, so that results also get replaced.
+    const MemoizedBeadingStrategy memoized(makeTypicalStrategy(), slot_count);
+
+    for (size_t repeat = 0; repeat < 2; ++repeat)
+    {
+        for (coord_t thickness = 0; thickness < MM2INT(3); thickness += 37)
+        {
+            const coord_t bead_count = parent->getOptimalBeadCount(thickness);
+            ASSERT_EQ(bead_count, memoized.getOptimalBeadCount(thickness)) << "at thickness " << thickness;
+            expectSameBeading(parent->compute(thickness, bead_count), memoized.compute(thickness, bead_count));
+            expectSameBeading(parent->compute(thickness, bead_count + 1), memoized.compute(thickness, bead_count + 1));
+        }
+    }
+    EXPECT_EQ(parent->getTransitionThickness(2), memoized.getTransitionThickness(2));
+    EXPECT_EQ(parent->getTransitioningLength(2), memoized.getTransitioningLength(2));
+    EXPECT_EQ(parent->getTransitionAnchorPos(2), memoized.getTransitionAnchorPos(2));
+    EXPECT_EQ(parent->getNonlinearThicknesses(2), memoized.getNonlinearThicknesses(2));
+    EXPECT_EQ(parent->getOptimalWidth(), memoized.getOptimalWidth());
+}
+
+TEST(MemoizedBeadingStrategyTest, Statistics)
+{
+    const MemoizedBeadingStrategy memoized(makeTypicalStrategy());
+    EXPECT_EQ(memoized.getStatistics().hitRate(), 0.0);
+
+    constexpr size_t thickness_count = 100;
+    constexpr size_t repeats = 4;
+    for (size_t repeat = 0; repeat < repeats; ++repeat)
+    {
+        for (coord_t thickness = MM2INT(0.1); thickness < MM2INT(0.1) + static_cast<coord_t>(thickness_count); ++thickness)
+        {
+            memoized.compute(thickness, memoized.getOptimalBeadCount(thickness));
+        }
+    }
+
+    const MemoizedBeadingStrategy::Statistics& statistics = memoized.getStatistics();
+    EXPECT_EQ(statistics.compute_misses, thickness_count);
+    EXPECT_EQ(statistics.compute_hits, thickness_count * (repeats - 1));
+    EXPECT_EQ(statistics.bead_count_misses, thickness_count);
+    EXPECT_EQ(statistics.bead_count_hits, thickness_count * (repeats - 1));
+    EXPECT_DOUBLE_EQ(statistics.hitRate(), 0.75);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,189 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "mesh.h" // Unit under test.
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To start the thread pool.
+#include "MeshGroup.h" // To load STL files.
+#include "settings/Settings.h"
+#include "utils/Matrix4x3D.h"
+#include "utils/Point2F.h"
+#include "utils/Point3F.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Mesh::addFaces welds the corners of many faces at once, in parallel. It must give the same mesh as adding the faces one by one.
+ */
+class MeshTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+    }
+
+    /*!
+     * Corners of random faces on a coarse grid, so that many corners are shared. Some corners are moved by less than the distance at
+     * which vertices are welded, and some faces have two corners in the same place.
+     */
+    static std::vector<Point3LL> createCorners(const size_t face_count)
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<coord_t> grid(-6, 6);
+        std::uniform_int_distribution<coord_t> jitter(-5, 5);
+        std::vector<Point3LL> corners;
+        for (size_t corner_nr = 0; corner_nr < face_count * 3; ++corner_nr)
+        {
+            Point3LL corner(grid(generator) * 1000, grid(generator) * 1000, grid(generator) * 1000);
+            if (corner_nr % 7 == 0)
+            {
+                corner += Point3LL(jitter(generator), jitter(generator), jitter(generator));
+            }
+            if (corner_nr % 50 == 2)
+            {
+                corner = corners.back();
+            }
+            corners.push_back(corner);
+        }
+        return corners;
+    }
+
+    static void addFacesOneByOne(Mesh& mesh, const std::vector<Point3LL>& corners, const std::vector<std::optional<Point2F>>& uv_coordinates = {})
+    {
+        const auto uv = [&uv_coordinates](const size_t corner_idx) -> std::optional<Point2F>
+        {
+            return corner_idx < uv_coordinates.size() ? uv_coordinates[corner_idx] : std::nullopt;
+        };
+        for (size_t corner_idx = 0; corner_idx + 2 < corners.size(); corner_idx += 3)
+        {
+            mesh.addFace(corners[corner_idx], corners[corner_idx + 1], corners[corner_idx + 2], uv(corner_idx), uv(corner_idx + 1), uv(corner_idx + 2));
+        }
+    }
+
+    static void expectSameMesh(const Mesh& mesh, const Mesh& expected)
+    {
+        ASSERT_EQ(mesh.vertices_.size(), expected.vertices_.size());
+        for (size_t vertex_idx = 0; vertex_idx < expected.vertices_.size(); ++vertex_idx)
+        {
+            EXPECT_EQ(mesh.vertices_[vertex_idx].p_, expected.vertices_[vertex_idx].p_) << "Vertex " << vertex_idx << " differs.";
+            EXPECT_EQ(mesh.vertices_[vertex_idx].connected_faces_, expected.vertices_[vertex_idx].connected_faces_) << "Vertex " << vertex_idx << " differs.";
+        }
+        ASSERT_EQ(mesh.faces_.size(), expected.faces_.size());
+        for (size_t face_idx = 0; face_idx < expected.faces_.size(); ++face_idx)
+        {
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                EXPECT_EQ(mesh.faces_[face_idx].vertex_index_[corner], expected.faces_[face_idx].vertex_index_[corner]) << "Face " << face_idx << " differs.";
+                EXPECT_EQ(mesh.faces_[face_idx].connected_face_index_[corner], expected.faces_[face_idx].connected_face_index_[corner]) << "Face " << face_idx << " differs.";
+                EXPECT_EQ(mesh.faces_[face_idx].uv_coordinates_[corner].has_value(), expected.faces_[face_idx].uv_coordinates_[corner].has_value());
+                if (mesh.faces_[face_idx].uv_coordinates_[corner] && expected.faces_[face_idx].uv_coordinates_[corner])
+                {
+                    EXPECT_EQ(mesh.faces_[face_idx].uv_coordinates_[corner]->x_, expected.faces_[face_idx].uv_coordinates_[corner]->x_);
+                    EXPECT_EQ(mesh.faces_[face_idx].uv_coordinates_[corner]->y_, expected.faces_[face_idx].uv_coordinates_[corner]->y_);
+                }
+            }
+        }
+        EXPECT_EQ(mesh.min(), expected.min());
+        EXPECT_EQ(mesh.max(), expected.max());
+    }
+};
+
+TEST_F(MeshTest, AddFacesWeldsLikeAddFace)
+{
+    const std::vector<Point3LL> corners = createCorners(5000);
+    std::vector<std::optional<Point2F>> uv_coordinates;
+    for (size_t corner_idx = 0; corner_idx < 3000; ++corner_idx) // Only the first faces get UV coordinates.
+    {
+        uv_coordinates.emplace_back(Point2F(static_cast<float>(corner_idx) / 3000.0f, 0.5f));
+    }
+
+    Mesh expected;
+    addFacesOneByOne(expected, corners, uv_coordinates);
+    expected.finish();
+    Mesh mesh;
+    mesh.addFaces(corners, uv_coordinates);
+    mesh.finish();
+
+    ASSERT_LT(expected.vertices_.size(), corners.size() / 2) << "Many corners must be welded, or this doesn't test the welding.";
+    ASSERT_LT(expected.faces_.size(), corners.size() / 3) << "Some faces must be degenerate, or this doesn't test skipping them.";
+    expectSameMesh(mesh, expected);
+}
+
+TEST_F(MeshTest, AddFacesToExistingFaces)
+{
+    const std::vector<Point3LL> corners = createCorners(1000);
+    const std::vector<Point3LL> first_corners(corners.begin(), corners.begin() + 600);
+    const std::vector<Point3LL> last_corners(corners.begin() + 600, corners.end());
+
+    Mesh expected;
+    addFacesOneByOne(expected, corners);
+    expected.finish();
+    Mesh mesh;
+    mesh.addFaces(first_corners);
+    mesh.addFaces(last_corners);
+    mesh.finish();
+
+    expectSameMesh(mesh, expected);
+}
+
+TEST_F(MeshTest, LoadBinarySTL)
+{
+    // More faces than are read in one chunk, with one chunk that is not full.
+    constexpr size_t face_count = (1 << 16) + 1000;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> grid(-50, 50);
+    std::vector<float> face_corners;
+    for (size_t coordinate_nr = 0; coordinate_nr < face_count * 9; ++coordinate_nr)
+    {
+        face_corners.push_back(static_cast<float>(grid(generator)) * 0.5f);
+    }
+
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "MeshTest_LoadBinarySTL.stl";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        const std::vector<char> header(80, 0);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        const uint32_t reported_face_count = face_count;
+        file.write(reinterpret_cast<const char*>(&reported_face_count), sizeof(reported_face_count));
+        for (size_t face_idx = 0; face_idx < face_count; ++face_idx)
+        {
+            char face[50] = {}; // Normal, three corners and the attributes.
+            std::memcpy(face + 3 * sizeof(float), face_corners.data() + face_idx * 9, 9 * sizeof(float));
+            file.write(face, sizeof(face));
+        }
+    }
+
+    const Matrix4x3D transformation = Matrix4x3D::scale(1.5, Point3LL(1000, 0, 0));
+    std::vector<Point3LL> corners;
+    for (size_t coordinate_idx = 0; coordinate_idx < face_corners.size(); coordinate_idx += 3)
+    {
+        corners.push_back(transformation.apply(Point3F(face_corners[coordinate_idx], face_corners[coordinate_idx + 1], face_corners[coordinate_idx + 2]).toPoint3d()));
+    }
+    Mesh expected;
+    addFacesOneByOne(expected, corners);
+    expected.finish();
+
+    Settings settings;
+    MeshGroup mesh_group;
+    const bool loaded = loadMeshIntoMeshGroup(&mesh_group, filename, transformation, settings);
+    std::filesystem::remove(filename);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(mesh_group.meshes.size(), 1);
+    expectSameMesh(mesh_group.meshes.front(), expected);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
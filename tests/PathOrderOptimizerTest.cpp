@@ -3,8 +3,12 @@
 
 #include "PathOrderOptimizer.h" //The code under test.
 
+#include <unordered_set>
+
 #include <gtest/gtest.h> //To run the tests.
 
+#include "geometry/OpenPolyline.h"
+
 // NOLINTBEGIN(*-magic-numbers)
 namespace cura
 {
@@ -68,5 +72,47 @@ TEST_F(PathOrderOptimizerTest, ThreeTrianglesShortestOrder)
     EXPECT_EQ(optimizer.paths_[2].vertices_->front(), Point2LL(1000, 1000)) << "Far triangle last.";
 }
 
+/*!
+ * Tests ordering many lines that are too far apart to be found within the snap
+ * radius. Each next line must still be the closest of the remaining lines,
+ * starting from its closest end.
+ */
+TEST_F(PathOrderOptimizerTest, ScatteredLinesNearestFirst)
+{
+    std::vector<OpenPolyline> lines;
+    for (coord_t i = 0; i < 400; ++i)
+    {
+        // Deterministic, but scattered over the area. No two lines come within the snap radius of each other.
+        const Point2LL start((i * 7919) % 20000, (i * 104729) % 20000);
+        lines.push_back(OpenPolyline({ start, start + Point2LL(100 + (i % 3) * 50, (i % 5) * 40) }));
+    }
+
+    PathOrderOptimizer<const Polyline*> optimizer(Point2LL(0, 0));
+    for (const OpenPolyline& line : lines)
+    {
+        optimizer.addPolyline(&line);
+    }
+    optimizer.optimize();
+
+    ASSERT_EQ(optimizer.paths_.size(), lines.size());
+    std::unordered_set<const Polyline*> remaining;
+    for (const OpenPolyline& line : lines)
+    {
+        remaining.insert(&line);
+    }
+    Point2LL position(0, 0);
+    for (const auto& path : optimizer.paths_)
+    {
+        const Point2LL start = path.backwards_ ? path.vertices_->back() : path.vertices_->front();
+        const coord_t distance2 = vSize2(start - position);
+        for (const Polyline* other : remaining)
+        {
+            EXPECT_LE(distance2, std::min(vSize2(other->front() - position), vSize2(other->back() - position))) << "Each line must be the closest of the remaining lines.";
+        }
+        remaining.erase(path.vertices_);
+        position = path.backwards_ ? path.vertices_->front() : path.vertices_->back();
+    }
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
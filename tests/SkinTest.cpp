@@ -0,0 +1,235 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "skin.h" // Unit under test.
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To set up a slice with settings.
+#include "Slice.h" // To set up a scene with an extruder.
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "mesh.h"
+#include "sliceDataStorage.h"
+#include "utils/AABB.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Exposes the top and bottom skin computation of a single part.
+ */
+class SkinComputation : public SkinInfillAreaComputation
+{
+public:
+    using SkinInfillAreaComputation::calculateBottomSkin;
+    using SkinInfillAreaComputation::calculateTopSkin;
+    using SkinInfillAreaComputation::SkinInfillAreaComputation;
+};
+
+/*!
+ * The top and bottom skin must be the same whether the outlines of the layers around are intersected per layer or shared through
+ * OutlineWindowIntersections.
+ */
+class SkinTest : public testing::Test
+{
+public:
+    static constexpr size_t layer_count = 24;
+    static constexpr size_t skin_layers = 3;
+
+    std::unique_ptr<Mesh> mesh_;
+    std::unique_ptr<SliceMeshStorage> storage_;
+
+    void SetUp() override
+    {
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        Scene& scene = Application::getInstance().current_slice_->scene;
+        scene.settings.add("skin_line_width", "0.4");
+        scene.settings.add("initial_layer_line_width_factor", "100");
+        scene.settings.add("top_bottom_extruder_nr", "0");
+        scene.settings.add("top_layers", std::to_string(skin_layers));
+        scene.settings.add("bottom_layers", std::to_string(skin_layers));
+        scene.settings.add("initial_bottom_layers", std::to_string(skin_layers));
+        scene.settings.add("skin_no_small_gaps_heuristic", "False");
+        scene.settings.add("top_skin_preshrink", "0");
+        scene.settings.add("bottom_skin_preshrink", "0");
+        scene.settings.add("top_skin_expand_distance", "0");
+        scene.settings.add("bottom_skin_expand_distance", "0");
+        scene.settings.add("min_infill_area", "0");
+        scene.settings.add("cutting_mesh", "False");
+        scene.settings.add("anti_overhang_mesh", "False");
+        scene.settings.add("infill_mesh", "False");
+        scene.extruders.emplace_back(0, &scene.settings);
+
+        mesh_ = std::make_unique<Mesh>(scene.settings);
+        storage_ = std::make_unique<SliceMeshStorage>(mesh_.get(), layer_count);
+
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            const coord_t step = static_cast<coord_t>(layer_nr) * 300;
+
+            // A block that narrows towards the top, with a hole that widens. The outlines are nested, so their intersections only have
+            // vertices of the outlines, and can be shared.
+            Shape block;
+            block.push_back(AABB(Point2LL(step, step), Point2LL(30000 - step, 30000 - step)).toPolygon());
+            Polygon hole = AABB(Point2LL(12000 - step / 3, 12000 - step / 3), Point2LL(18000 + step / 3, 18000 + step / 3)).toPolygon();
+            hole.reverse();
+            block.push_back(hole);
+            addPart(layer_nr, std::move(block));
+
+            // On the upper layers, a bar that moves sideways, so that the outlines cross and Clipper creates vertices. Those windows have to
+            // be computed layer by layer.
+            if (layer_nr >= layer_count / 2)
+            {
+                Shape bar;
+                bar.push_back(AABB(Point2LL(35000 + step, 0), Point2LL(45000 + step, 10000 + step)).toPolygon());
+                addPart(layer_nr, std::move(bar));
+            }
+        }
+    }
+
+    void TearDown() override
+    {
+        storage_.reset();
+        mesh_.reset();
+        Application::getInstance().current_slice_.reset();
+    }
+
+    void addPart(const size_t layer_nr, Shape&& outline)
+    {
+        SliceLayerPart& part = storage_->layers[layer_nr].parts.emplace_back();
+        part.outline = SingleShape(std::move(outline));
+        part.inner_area = part.outline;
+        part.boundaryBox = AABB(part.outline);
+    }
+
+    /*!
+     * The polygons with their vertices starting at the lowest one, in order, so that shapes can be compared regardless of the order of
+     * their polygons.
+     */
+    static std::vector<std::vector<Point2LL>> normalized(const Shape& shape)
+    {
+        std::vector<std::vector<Point2LL>> polygons;
+        for (const Polygon& polygon : shape)
+        {
+            std::vector<Point2LL> points(polygon.begin(), polygon.end());
+            const auto lowest = std::min_element(
+                points.begin(),
+                points.end(),
+                [](const Point2LL& a, const Point2LL& b)
+                {
+                    return std::tie(a.X, a.Y) < std::tie(b.X, b.Y);
+                });
+            std::rotate(points.begin(), lowest, points.end());
+            polygons.push_back(std::move(points));
+        }
+        std::sort(
+            polygons.begin(),
+            polygons.end(),
+            [](const std::vector<Point2LL>& a, const std::vector<Point2LL>& b)
+            {
+                return std::lexicographical_compare(
+                    a.begin(),
+                    a.end(),
+                    b.begin(),
+                    b.end(),
+                    [](const Point2LL& p, const Point2LL& q)
+                    {
+                        return std::tie(p.X, p.Y) < std::tie(q.X, q.Y);
+                    });
+            });
+        return polygons;
+    }
+
+    /*!
+     * Check that all parts of all layers get the same top and bottom skin with the given windows as without.
+     */
+    void expectSameSkin(const OutlineWindowIntersections& top_windows, const OutlineWindowIntersections& bottom_windows)
+    {
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            SkinComputation per_layer(LayerIndex(layer_nr), *storage_, false);
+            SkinComputation shared(LayerIndex(layer_nr), *storage_, false, &top_windows, &bottom_windows);
+            for (const SliceLayerPart& part : storage_->layers[layer_nr].parts)
+            {
+                Shape expected_top = part.inner_area;
+                per_layer.calculateTopSkin(part, expected_top);
+                Shape top = part.inner_area;
+                shared.calculateTopSkin(part, top);
+                EXPECT_EQ(normalized(top), normalized(expected_top)) << "The top skin of layer " << layer_nr << " differs.";
+
+                Shape expected_bottom = part.inner_area;
+                per_layer.calculateBottomSkin(part, expected_bottom);
+                Shape bottom = part.inner_area;
+                shared.calculateBottomSkin(part, bottom);
+                EXPECT_EQ(normalized(bottom), normalized(expected_bottom)) << "The bottom skin of layer " << layer_nr << " differs.";
+            }
+        }
+    }
+
+    static void computeAllBlocks(OutlineWindowIntersections& windows)
+    {
+        for (size_t block_idx = 0; block_idx < windows.getBlockCount(); ++block_idx)
+        {
+            windows.computeBlock(block_idx);
+        }
+    }
+};
+
+TEST_F(SkinTest, SharedWindowsGiveSameSkin)
+{
+    OutlineWindowIntersections top_windows(*storage_, skin_layers);
+    OutlineWindowIntersections bottom_windows(*storage_, skin_layers);
+    computeAllBlocks(top_windows);
+    computeAllBlocks(bottom_windows);
+
+    size_t shared_count = 0;
+    size_t window_count = 0;
+    for (size_t layer_nr = 0; layer_nr + skin_layers < layer_count; ++layer_nr)
+    {
+        ++window_count;
+        shared_count += top_windows.getIntersection(LayerIndex(layer_nr + 1), LayerIndex(layer_nr + skin_layers)).has_value() ? 1 : 0;
+    }
+    ASSERT_GT(shared_count, 0) << "Some windows must be shared, or this doesn't test them.";
+    ASSERT_LT(shared_count, window_count) << "Some windows must be computed layer by layer, or this doesn't test the fallback.";
+
+    expectSameSkin(top_windows, bottom_windows);
+}
+
+TEST_F(SkinTest, WindowsBeyondTheBudgetAreNotShared)
+{
+    OutlineWindowIntersections top_windows(*storage_, skin_layers, 0);
+    OutlineWindowIntersections bottom_windows(*storage_, skin_layers, 0);
+    computeAllBlocks(top_windows);
+    computeAllBlocks(bottom_windows);
+
+    for (size_t layer_nr = 0; layer_nr + skin_layers < layer_count; ++layer_nr)
+    {
+        EXPECT_FALSE(top_windows.getIntersection(LayerIndex(layer_nr + 1), LayerIndex(layer_nr + skin_layers)).has_value());
+    }
+    expectSameSkin(top_windows, bottom_windows);
+}
+
+TEST_F(SkinTest, ReleasedWindowsAreNotShared)
+{
+    OutlineWindowIntersections windows(*storage_, skin_layers);
+    windows.computeBlock(0);
+    ASSERT_TRUE(windows.getIntersection(LayerIndex(0), LayerIndex(skin_layers - 1)).has_value());
+
+    windows.releaseBlock(0);
+    EXPECT_FALSE(windows.getIntersection(LayerIndex(0), LayerIndex(skin_layers - 1)).has_value());
+
+    OutlineWindowIntersections tight_windows(*storage_, skin_layers, 0);
+    tight_windows.computeBlock(0);
+    tight_windows.releaseBlock(0);
+    EXPECT_FALSE(tight_windows.getIntersection(LayerIndex(0), LayerIndex(skin_layers - 1)).has_value()) << "Releasing a block that didn't fit is harmless.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
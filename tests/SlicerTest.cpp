@@ -0,0 +1,126 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "slicer.h" // Unit under test.
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To start the thread pool.
+#include "mesh.h"
+#include "settings/EnumSettings.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * The slicer sweeps the faces over the layers once to find the faces that span each layer. That must create the same segments, in the
+ * same order, as testing every face against every layer.
+ */
+class SlicerTest : public testing::TestWithParam<SlicingTolerance>
+{
+public:
+    static constexpr coord_t layer_height = 100;
+    static constexpr size_t layer_count = 20;
+
+    Mesh mesh_;
+
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+
+        // A box with its bottom, top and corners exactly on layer heights. Its top and bottom are flat on a layer.
+        addBox(Point3LL(0, 0, 2 * layer_height), Point3LL(5000, 5000, 6 * layer_height));
+
+        // Loose triangles with their corners on a grid of half a layer, so that many corners are exactly on a layer height, and some faces
+        // lie flat on one.
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<coord_t> xy(-10000, 10000);
+        std::uniform_int_distribution<coord_t> half_layers(0, 2 * static_cast<coord_t>(layer_count));
+        for (size_t face_nr = 0; face_nr < 500; ++face_nr)
+        {
+            const coord_t z = half_layers(generator) * layer_height / 2;
+            const bool flat = face_nr % 10 == 0;
+            mesh_.addFace(
+                Point3LL(xy(generator), xy(generator), z),
+                Point3LL(xy(generator), xy(generator), flat ? z : half_layers(generator) * layer_height / 2),
+                Point3LL(xy(generator), xy(generator), flat ? z : half_layers(generator) * layer_height / 2));
+        }
+        mesh_.finish();
+    }
+
+    /*!
+     * Layers at every layer height, with one layer out of order in between, like adaptive layers could have.
+     */
+    static std::vector<SlicerLayer> createLayers()
+    {
+        std::vector<SlicerLayer> layers(layer_count + 1);
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            layers[layer_nr].z_ = static_cast<coord_t>(layer_nr) * layer_height;
+        }
+        layers.back().z_ = 7 * layer_height + layer_height / 2;
+        std::swap(layers[layer_count / 2], layers.back());
+        return layers;
+    }
+
+private:
+    void addBox(const Point3LL& min, const Point3LL& max)
+    {
+        const Point3LL v000(min.x_, min.y_, min.z_);
+        const Point3LL v100(max.x_, min.y_, min.z_);
+        const Point3LL v010(min.x_, max.y_, min.z_);
+        const Point3LL v110(max.x_, max.y_, min.z_);
+        const Point3LL v001(min.x_, min.y_, max.z_);
+        const Point3LL v101(max.x_, min.y_, max.z_);
+        const Point3LL v011(min.x_, max.y_, max.z_);
+        const Point3LL v111(max.x_, max.y_, max.z_);
+        // Two triangles per side, counter-clockwise when seen from outside.
+        mesh_.addFace(v000, v110, v100); // Bottom.
+        mesh_.addFace(v000, v010, v110);
+        mesh_.addFace(v001, v101, v111); // Top.
+        mesh_.addFace(v001, v111, v011);
+        mesh_.addFace(v000, v100, v101); // Front.
+        mesh_.addFace(v000, v101, v001);
+        mesh_.addFace(v010, v111, v110); // Back.
+        mesh_.addFace(v010, v011, v111);
+        mesh_.addFace(v000, v001, v011); // Left.
+        mesh_.addFace(v000, v011, v010);
+        mesh_.addFace(v100, v110, v111); // Right.
+        mesh_.addFace(v100, v111, v101);
+    }
+};
+
+TEST_P(SlicerTest, SweepGivesSameSegmentsAsFullScan)
+{
+    const SlicingTolerance slicing_tolerance = GetParam();
+    std::vector<SlicerLayer> full_scan_layers = createLayers();
+    Slicer::sliceSegments(mesh_, slicing_tolerance, true, full_scan_layers);
+    std::vector<SlicerLayer> sweep_layers = createLayers();
+    Slicer::sliceSegments(mesh_, slicing_tolerance, false, sweep_layers);
+
+    ASSERT_FALSE(full_scan_layers[2].segments_.empty()) << "The bottom of the box is on a layer, which must be sliced for this to test that edge case.";
+    for (size_t layer_idx = 0; layer_idx < full_scan_layers.size(); ++layer_idx)
+    {
+        const std::vector<SlicerSegment>& expected = full_scan_layers[layer_idx].segments_;
+        const std::vector<SlicerSegment>& segments = sweep_layers[layer_idx].segments_;
+        ASSERT_EQ(segments.size(), expected.size()) << "Layer " << layer_idx << " has a different number of segments.";
+        for (size_t segment_idx = 0; segment_idx < expected.size(); ++segment_idx)
+        {
+            EXPECT_EQ(segments[segment_idx].start, expected[segment_idx].start) << "Segment " << segment_idx << " of layer " << layer_idx << " differs.";
+            EXPECT_EQ(segments[segment_idx].end, expected[segment_idx].end) << "Segment " << segment_idx << " of layer " << layer_idx << " differs.";
+            EXPECT_EQ(segments[segment_idx].faceIndex, expected[segment_idx].faceIndex) << "Segment " << segment_idx << " of layer " << layer_idx << " differs.";
+            EXPECT_EQ(segments[segment_idx].endOtherFaceIdx, expected[segment_idx].endOtherFaceIdx) << "Segment " << segment_idx << " of layer " << layer_idx << " differs.";
+            EXPECT_EQ(segments[segment_idx].endVertex, expected[segment_idx].endVertex) << "Segment " << segment_idx << " of layer " << layer_idx << " differs.";
+        }
+        EXPECT_EQ(sweep_layers[layer_idx].face_idx_to_segment_idx_, full_scan_layers[layer_idx].face_idx_to_segment_idx_);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllTolerances, SlicerTest, testing::Values(SlicingTolerance::MIDDLE, SlicingTolerance::INCLUSIVE, SlicingTolerance::EXCLUSIVE));
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -430,4 +430,46 @@ TEST_F(TimeEstimateCalculatorTest, StraightAnglePartialJerk)
     EXPECT_NEAR(Duration(first_accelerate_t + first_cruise_distance / 50.0 + first_decelerate_t + second_accelerate_t + second_cruise_distance / 50.0 + second_decelerate_t), result[static_cast<size_t>(PrintFeatureType::Infill)], EPSILON);
 }
 
+TEST_F(TimeEstimateCalculatorTest, SpeedFactorOne)
+{
+    calculator.plan(TimeEstimateCalculator::Position(100, 0, 0, 1), 50.0, PrintFeatureType::Infill);
+    calculator.plan(TimeEstimateCalculator::Position(100, 50, 0, 1), 150.0, PrintFeatureType::MoveRetracted);
+    calculator.plan(TimeEstimateCalculator::Position(0, 70, 0, 2), 30.0, PrintFeatureType::OuterWall);
+
+    const std::vector<Duration> factor_result = calculator.calculate(1.0_r);
+    const std::vector<Duration> result = calculator.calculate();
+    ASSERT_EQ(result.size(), factor_result.size());
+    for (size_t feature = 0; feature < result.size(); ++feature)
+    {
+        EXPECT_NEAR(result[feature], factor_result[feature], EPSILON) << "A speed factor of 1 must not change the estimate.";
+    }
+}
+
+TEST_F(TimeEstimateCalculatorTest, SpeedFactorSlowsDownExtrusions)
+{
+    calculator.setFirmwareDefaults(always_50);
+
+    calculator.plan(TimeEstimateCalculator::Position(1000, 0, 0, 0), 50.0, PrintFeatureType::Infill);
+    calculator.plan(TimeEstimateCalculator::Position(1000, 1000, 0, 0), 50.0, PrintFeatureType::MoveRetracted);
+
+    /*
+     * The first line is printed at 25mm/s instead of 50mm/s. The travel move
+     * after it keeps its feedrate of 50mm/s, but it starts at the 25mm/s of the
+     * line before it, so it accelerates from 25 to 50mm/s in half a second.
+     * At its end it decelerates to the minimum planner speed.
+     */
+    const double accelerate_t = (50.0 - 25.0) / 50.0;
+    const double accelerate_distance = 0.5 * 50.0 * accelerate_t * accelerate_t + 25.0 * accelerate_t;
+    const double decelerate_t = (50.0 - MINIMUM_PLANNER_SPEED) / 50.0;
+    const double decelerate_distance = 0.5 * 50.0 * decelerate_t * decelerate_t + MINIMUM_PLANNER_SPEED * decelerate_t;
+    const double cruise_distance = 1000.0 - accelerate_distance - decelerate_distance;
+
+    const std::vector<Duration> result = calculator.calculate(0.5_r);
+    EXPECT_NEAR(Duration(1000.0 / 25.0), result[static_cast<size_t>(PrintFeatureType::Infill)], EPSILON);
+    EXPECT_NEAR(Duration(accelerate_t + cruise_distance / 50.0 + decelerate_t), result[static_cast<size_t>(PrintFeatureType::MoveRetracted)], EPSILON);
+
+    const std::vector<Duration> original_result = calculator.calculate();
+    EXPECT_NEAR(Duration(1000.0 / 50.0), original_result[static_cast<size_t>(PrintFeatureType::Infill)], EPSILON) << "The original estimate must not be affected.";
+}
+
 } // namespace cura
\ No newline at end of file
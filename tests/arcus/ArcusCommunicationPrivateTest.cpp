@@ -34,6 +34,7 @@ public:
     {
         instance = new ArcusCommunication::Private();
         instance->socket = new MockSocket();
+        Application::getInstance().startThreadPool(); // Meshes are loaded in parallel.
         Application::getInstance().current_slice_ = std::make_shared<Slice>(GK_TEST_NUM_MESH_GROUPS);
     }
 
@@ -1,18 +1,24 @@
 // Copyright (c) 2024 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <google/protobuf/message.h>
 #include <memory>
 #include <numbers>
+#include <thread>
 
 #include <gtest/gtest.h>
 
 #include "FffProcessor.h"
 #include "MockSocket.h" //To mock out the communication with the front-end.
+#include "PrintFeature.h"
 #include "communication/ArcusCommunicationPrivate.h" //To access the private fields of this communication class.
 #include "geometry/Polygon.h" //Create test shapes to send over the socket.
 #include "geometry/Shape.h"
 #include "settings/types/LayerIndex.h"
+#include "settings/types/Velocity.h"
 #include "utils/Coord_t.h"
 #include "utils/string.h"
 
@@ -133,6 +139,120 @@ TEST_F(ArcusCommunicationTest, SendLayerComplete)
     EXPECT_EQ(static_cast<float>(layer_thickness), message->thickness());
 }
 
+TEST_F(ArcusCommunicationTest, StreamCompletedLayers)
+{
+    ac->private_data->object_count = 1;
+    constexpr LayerIndex::value_type layer_count = 100;
+    constexpr size_t lines_per_layer = 10;
+    constexpr coord_t layer_thickness = 200;
+
+    // Record how many layers the communication kept in memory, every time it sent something.
+    size_t peak_stored_layers = 0;
+    socket->on_send_message = [this, &peak_stored_layers](const Arcus::MessagePtr&)
+    {
+        peak_stored_layers = std::max(peak_stored_layers, ac->private_data->optimized_layers.slice_data.size());
+    };
+
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const coord_t z = (layer_nr + 1) * layer_thickness;
+        ac->setLayerForSend(layer_nr);
+        ac->sendCurrentPosition(Point3LL(0, 0, z));
+        for (size_t line_idx = 1; line_idx <= lines_per_layer; ++line_idx)
+        {
+            ac->sendLineTo(PrintFeatureType::Infill, Point3LL(line_idx * 1000, (line_idx % 2) * 1000, z), 400, layer_thickness, Velocity(50));
+        }
+        ac->sendLayerComplete(layer_nr, z, layer_thickness);
+
+        // Each completed layer must be sent as soon as the next layer starts.
+        EXPECT_EQ(socket->sent_messages.size(), static_cast<size_t>(layer_nr)) << "All layers before layer " << layer_nr << " must have been sent.";
+    }
+    ac->sendOptimizedLayerData();
+
+    ASSERT_EQ(socket->sent_messages.size(), static_cast<size_t>(layer_count));
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const auto* message = dynamic_cast<proto::LayerOptimized*>(socket->sent_messages[layer_nr].get());
+        ASSERT_NE(message, nullptr);
+        EXPECT_EQ(message->id(), layer_nr) << "The layers must be sent in order.";
+        EXPECT_EQ(message->height(), static_cast<float>((layer_nr + 1) * layer_thickness));
+        ASSERT_EQ(message->path_segment_size(), 1);
+        EXPECT_EQ(message->path_segment(0).line_type().size(), lines_per_layer * sizeof(PrintFeatureType));
+    }
+    EXPECT_LE(peak_stored_layers, size_t(2)) << "Only the completed layer and the one being written may be kept in memory.";
+    EXPECT_TRUE(ac->private_data->optimized_layers.slice_data.empty());
+}
+
+TEST_F(ArcusCommunicationTest, LayersInFlightAreLimited)
+{
+    ac->private_data->object_count = 1;
+    ac->private_data->max_layers_in_flight = 4;
+    constexpr LayerIndex::value_type layer_count = 50;
+    constexpr coord_t layer_thickness = 200;
+
+    // A slow front-end, that reads a layer every few milliseconds.
+    socket->hold_messages = true;
+    std::atomic<bool> slicing_done = false;
+    std::thread front_end(
+        [this, &slicing_done]()
+        {
+            while (socket->deliverHeldMessage() || ! slicing_done)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+
+    // Record how many layers were waiting to be written, every time a layer is sent, this one included.
+    size_t peak_layers_in_flight = 0;
+    socket->on_send_message = [this, &peak_layers_in_flight](const Arcus::MessagePtr&)
+    {
+        peak_layers_in_flight = std::max(peak_layers_in_flight, socket->heldMessageCount() + 1);
+    };
+
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const coord_t z = (layer_nr + 1) * layer_thickness;
+        ac->setLayerForSend(layer_nr);
+        ac->sendCurrentPosition(Point3LL(0, 0, z));
+        ac->sendLineTo(PrintFeatureType::Infill, Point3LL(1000, 0, z), 400, layer_thickness, Velocity(50));
+        ac->sendLayerComplete(layer_nr, z, layer_thickness);
+    }
+    ac->sendOptimizedLayerData();
+    slicing_done = true;
+    front_end.join();
+
+    EXPECT_EQ(peak_layers_in_flight, ac->private_data->max_layers_in_flight) << "Slicing is faster than this front-end, so it must be held back at the limit.";
+    ASSERT_EQ(socket->sent_messages.size(), static_cast<size_t>(layer_count));
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const auto* message = dynamic_cast<proto::LayerOptimized*>(socket->sent_messages[layer_nr].get());
+        ASSERT_NE(message, nullptr);
+        EXPECT_EQ(message->id(), layer_nr) << "The layers must be sent in order.";
+    }
+}
+
+TEST_F(ArcusCommunicationTest, MovesAfterLastLayerComplete)
+{
+    ac->private_data->object_count = 1;
+    constexpr coord_t z = 200;
+
+    ac->setLayerForSend(0);
+    ac->sendCurrentPosition(Point3LL(0, 0, z));
+    ac->sendLineTo(PrintFeatureType::Infill, Point3LL(1000, 0, z), 400, z, Velocity(50));
+    ac->sendLayerComplete(0, z, z);
+    // Like the final travel move, which is written after the last layer is complete.
+    ac->sendLineTo(PrintFeatureType::MoveUnretracted, Point3LL(1000, 1000, z + 5000), 100, z, Velocity(100));
+    EXPECT_TRUE(socket->sent_messages.empty()) << "The last layer can only be sent once there are no more moves for it.";
+
+    ac->sendOptimizedLayerData();
+    ASSERT_EQ(socket->sent_messages.size(), size_t(1));
+    const auto* message = dynamic_cast<proto::LayerOptimized*>(socket->sent_messages.front().get());
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(message->id(), 0);
+    ASSERT_EQ(message->path_segment_size(), 1);
+    EXPECT_EQ(message->path_segment(0).line_type().size(), 2 * sizeof(PrintFeatureType)) << "The travel move must be part of the last layer.";
+}
+
 TEST_F(ArcusCommunicationTest, SendProgress)
 {
     ac->private_data->object_count = 2; // If there are two objects, all progress should get halved.
@@ -35,6 +35,8 @@ public:
     MOCK_METHOD0(sliceNext, void());
     MOCK_CONST_METHOD2(sendPrintInformation, void(const std::vector<cura::Duration>& time_estimates, const PrintInformation& print_information));
     MOCK_METHOD1(sendGCodePart, void(const std::string&));
+    MOCK_METHOD2(overwriteGCodePart, bool(const size_t offset, const std::string&));
+    MOCK_CONST_METHOD0(supportsGCodeStreaming, bool());
 };
 
 } // namespace cura
@@ -23,7 +23,35 @@ void MockSocket::reset()
 
 bool MockSocket::sendMessage(Arcus::MessagePtr message)
 {
-    sent_messages.push_back(message);
+    if (on_send_message)
+    {
+        on_send_message(message);
+    }
+    Arcus::MessagePtr copy(message->New());
+    copy->CopyFrom(*message);
+    sent_messages.push_back(copy);
+    if (hold_messages)
+    {
+        std::lock_guard<std::mutex> lock(held_messages_mutex);
+        held_messages.push_back(std::move(message));
+    }
+    return true;
+}
+
+size_t MockSocket::heldMessageCount()
+{
+    std::lock_guard<std::mutex> lock(held_messages_mutex);
+    return held_messages.size();
+}
+
+bool MockSocket::deliverHeldMessage()
+{
+    std::lock_guard<std::mutex> lock(held_messages_mutex);
+    if (held_messages.empty())
+    {
+        return false;
+    }
+    held_messages.pop_front();
     return true;
 }
 
@@ -5,6 +5,8 @@
 #define MOCKSOCKET_H
 
 #include <deque> //History of sent and received messages.
+#include <functional> //To inspect the sender when a message is sent.
+#include <mutex> //To deliver held messages from another thread.
 
 #include <Arcus/Socket.h> //Inheriting from this to be able to swap this socket in the tested class.
 
@@ -36,6 +38,19 @@ public:
     Arcus::MessagePtr popMessageFromSendQueue();
     std::deque<Arcus::MessagePtr> sent_messages;
     std::deque<Arcus::MessagePtr> received_messages;
+
+    // Called for every message that is sent, so that tests can inspect the state of the sender at that moment.
+    std::function<void(const Arcus::MessagePtr&)> on_send_message;
+
+    // Like Arcus, the socket releases a message once it is written. sent_messages has copies. To act like a slow front-end, sent messages
+    // can be held until a test delivers them, possibly from another thread.
+    bool hold_messages = false;
+    size_t heldMessageCount();
+    bool deliverHeldMessage();
+
+private:
+    std::mutex held_messages_mutex;
+    std::deque<Arcus::MessagePtr> held_messages;
 };
 // NOLINTEND(misc-non-private-member-variables-in-classes)
 } // namespace cura
@@ -0,0 +1,142 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Application.h" // To set up a slice with settings.
+#include "FffProcessor.h" // To start each slice with a fresh g-code writer.
+#include "MeshGroup.h" // To load the model.
+#include "Slice.h" // To set up a scene to slice.
+#include "arcus/MockCommunication.h" // To collect the g-code.
+#include "communication/CommandLineServer.h" // Decides when the g-code can be written again without slicing.
+#include "utils/Matrix4x3D.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*
+ * Integration test on writing the g-code of a kept slice again, like the serve command does when only the start and end g-code change. The
+ * result must be the same g-code as slicing again with the new settings.
+ */
+class GCodeRewriteTest : public testing::Test
+{
+public:
+    std::string gcode_;
+
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+        auto communication = std::make_shared<testing::NiceMock<MockCommunication>>();
+        ON_CALL(*communication, sendGCodePart(testing::_))
+            .WillByDefault(
+                [this](const std::string& gcode_part)
+                {
+                    gcode_ += gcode_part;
+                });
+        Application::getInstance().communication_ = communication;
+    }
+
+    void TearDown() override
+    {
+        Application::getInstance().current_slice_.reset();
+        Application::getInstance().communication_.reset();
+    }
+
+    /*!
+     * Create a slice of a cube with the default test settings and the given start and end g-code.
+     */
+    static std::shared_ptr<Slice> createSlice(const std::string& start_gcode, const std::string& end_gcode)
+    {
+        auto slice = std::make_shared<Slice>(1);
+        Scene& scene = slice->scene;
+        const std::filesystem::path tests_path = std::filesystem::path(__FILE__).parent_path().parent_path();
+        std::ifstream file(tests_path / "test_default_settings.txt");
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const size_t pos = line.find('=');
+            scene.settings.add(line.substr(0, pos), line.substr(pos + 1));
+        }
+        scene.settings.add("machine_start_gcode", start_gcode);
+        scene.settings.add("machine_end_gcode", end_gcode);
+        scene.extruders.emplace_back(0, &scene.settings);
+
+        MeshGroup& mesh_group = scene.mesh_groups.back();
+        const Matrix4x3D transformation;
+        EXPECT_TRUE(loadMeshIntoMeshGroup(&mesh_group, tests_path / "integration" / "resources" / "cube.stl", transformation, scene.settings));
+        mesh_group.finalize();
+        return slice;
+    }
+
+    /*!
+     * Slice, or write the g-code of a kept slice again, and return the g-code.
+     */
+    std::string computeGCode(const std::shared_ptr<Slice>& slice, const bool rewrite_gcode)
+    {
+        gcode_.clear();
+        FffProcessor::getInstance()->resetGcodeWriter();
+        Application::getInstance().current_slice_ = slice;
+        if (rewrite_gcode)
+        {
+            slice->rewriteGCode();
+        }
+        else
+        {
+            slice->compute();
+        }
+        return gcode_;
+    }
+};
+
+TEST_F(GCodeRewriteTest, SameGCodeAsNewSlice)
+{
+    const std::shared_ptr<Slice> kept_slice = createSlice(";first start", ";first end");
+    kept_slice->scene.keep_slice_data = true;
+    const std::string first_gcode = computeGCode(kept_slice, false);
+    ASSERT_NE(first_gcode.find(";first start"), std::string::npos);
+
+    const std::shared_ptr<Slice> next_slice = createSlice(";second start", ";second end");
+    ASSERT_TRUE(CommandLineServer::takeGCodeSettings(*kept_slice, *next_slice)) << "Only the start and end g-code changed.";
+    const std::string rewritten_gcode = computeGCode(kept_slice, true);
+
+    const std::string new_gcode = computeGCode(createSlice(";second start", ";second end"), false);
+    ASSERT_NE(new_gcode.find(";second start"), std::string::npos);
+    ASSERT_NE(new_gcode.find(";second end"), std::string::npos);
+
+    std::istringstream new_lines(new_gcode);
+    std::istringstream rewritten_lines(rewritten_gcode);
+    std::string new_line;
+    std::string rewritten_line;
+    for (size_t line_nr = 1; std::getline(new_lines, new_line); ++line_nr)
+    {
+        ASSERT_TRUE(std::getline(rewritten_lines, rewritten_line)) << "The rewritten g-code ends early, at line " << line_nr << ".";
+        ASSERT_EQ(new_line, rewritten_line) << "The rewritten g-code differs at line " << line_nr << ".";
+    }
+    EXPECT_FALSE(std::getline(rewritten_lines, rewritten_line)) << "The rewritten g-code is longer.";
+    EXPECT_EQ(new_gcode, rewritten_gcode) << "The g-code must be the same, byte for byte.";
+
+    // Writing it again with the settings back to the first ones must give the first g-code, so the kept slice data is left unchanged.
+    ASSERT_TRUE(CommandLineServer::takeGCodeSettings(*kept_slice, *createSlice(";first start", ";first end")));
+    EXPECT_EQ(computeGCode(kept_slice, true), first_gcode);
+}
+
+TEST_F(GCodeRewriteTest, SlicingSettingsNeedNewSlice)
+{
+    const std::shared_ptr<Slice> kept_slice = createSlice(";start", ";end");
+    const std::shared_ptr<Slice> next_slice = createSlice(";other start", ";end");
+    next_slice->scene.settings.add("layer_height", "0.15");
+
+    EXPECT_FALSE(CommandLineServer::takeGCodeSettings(*kept_slice, *next_slice));
+    EXPECT_EQ(kept_slice->scene.settings.get<std::string>("machine_start_gcode"), ";start") << "The kept slice must be left unchanged.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
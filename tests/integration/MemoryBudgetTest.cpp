@@ -0,0 +1,154 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Application.h" // To set up a slice with settings.
+#include "FffProcessor.h" // To start each slice with a fresh g-code writer.
+#include "Slice.h" // To set up a scene to slice.
+#include "arcus/MockCommunication.h" // To collect the g-code.
+#include "mesh.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*
+ * Integration test on CURAENGINE_MEMORY_BUDGET_MB. Freeing the slice data of the layers that are done must not change the g-code, not
+ * even when the budget is 0 and every layer is freed as soon as it may be.
+ */
+class MemoryBudgetTest : public testing::Test
+{
+public:
+    void TearDown() override
+    {
+        setMemoryBudget(std::nullopt);
+    }
+
+    /*!
+     * Slice a model with a bridge, support and flooring, and return the g-code.
+     *
+     * Two pillars carry a slab. The slab bridges the gap between them and sticks out at the front, where it needs support. The bottom of
+     * the slab is printed as flooring.
+     */
+    std::string slice()
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        FffProcessor::getInstance()->resetGcodeWriter();
+
+        std::string gcode;
+        auto communication = std::make_shared<testing::NiceMock<MockCommunication>>();
+        ON_CALL(*communication, sendGCodePart(testing::_))
+            .WillByDefault(
+                [&gcode](const std::string& gcode_part)
+                {
+                    gcode += gcode_part;
+                });
+        Application::getInstance().communication_ = communication;
+
+        Scene& scene = Application::getInstance().current_slice_->scene;
+        const auto path = std::filesystem::path(__FILE__).parent_path().parent_path().append("test_default_settings.txt").string();
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const size_t pos = line.find('=');
+            scene.settings.add(line.substr(0, pos), line.substr(pos + 1));
+        }
+        scene.settings.add("support_enable", "True");
+        scene.settings.add("support_type", "everywhere");
+        scene.settings.add("support_angle", "45");
+        scene.settings.add("bridge_settings_enabled", "True");
+        scene.settings.add("flooring_layer_count", "1");
+        scene.settings.add("roofing_layer_count", "1");
+        scene.extruders.emplace_back(0, &scene.settings);
+
+        MeshGroup& mesh_group = scene.mesh_groups.back();
+        addBox(mesh_group, Point3LL(MM2INT(0), MM2INT(0), MM2INT(0)), Point3LL(MM2INT(10), MM2INT(10), MM2INT(10)));
+        addBox(mesh_group, Point3LL(MM2INT(30), MM2INT(0), MM2INT(0)), Point3LL(MM2INT(40), MM2INT(10), MM2INT(10)));
+        addBox(mesh_group, Point3LL(MM2INT(0), MM2INT(0), MM2INT(10)), Point3LL(MM2INT(40), MM2INT(25), MM2INT(12)));
+        mesh_group.finalize();
+
+        Application::getInstance().current_slice_->compute();
+        return gcode;
+    }
+
+    static void setMemoryBudget(const std::optional<std::string>& budget_mib)
+    {
+#ifdef _WIN32
+        _putenv_s("CURAENGINE_MEMORY_BUDGET_MB", budget_mib.value_or("").c_str());
+#else
+        if (budget_mib)
+        {
+            setenv("CURAENGINE_MEMORY_BUDGET_MB", budget_mib->c_str(), 1);
+        }
+        else
+        {
+            unsetenv("CURAENGINE_MEMORY_BUDGET_MB");
+        }
+#endif
+    }
+
+private:
+    static void addBox(MeshGroup& mesh_group, const Point3LL& min, const Point3LL& max)
+    {
+        Mesh mesh(mesh_group.settings);
+        const Point3LL v000(min.x_, min.y_, min.z_);
+        const Point3LL v100(max.x_, min.y_, min.z_);
+        const Point3LL v010(min.x_, max.y_, min.z_);
+        const Point3LL v110(max.x_, max.y_, min.z_);
+        const Point3LL v001(min.x_, min.y_, max.z_);
+        const Point3LL v101(max.x_, min.y_, max.z_);
+        const Point3LL v011(min.x_, max.y_, max.z_);
+        const Point3LL v111(max.x_, max.y_, max.z_);
+        // Two triangles per side, counter-clockwise when seen from outside.
+        mesh.addFace(v000, v110, v100); // Bottom.
+        mesh.addFace(v000, v010, v110);
+        mesh.addFace(v001, v101, v111); // Top.
+        mesh.addFace(v001, v111, v011);
+        mesh.addFace(v000, v100, v101); // Front.
+        mesh.addFace(v000, v101, v001);
+        mesh.addFace(v010, v111, v110); // Back.
+        mesh.addFace(v010, v011, v111);
+        mesh.addFace(v000, v001, v011); // Left.
+        mesh.addFace(v000, v011, v010);
+        mesh.addFace(v100, v110, v111); // Right.
+        mesh.addFace(v100, v111, v101);
+        mesh.finish();
+        mesh.mesh_name_ = "box_" + std::to_string(mesh_group.meshes.size());
+        mesh_group.meshes.push_back(mesh);
+    }
+};
+
+TEST_F(MemoryBudgetTest, ZeroBudgetGivesSameGCode)
+{
+    setMemoryBudget(std::nullopt);
+    const std::string unlimited_gcode = slice();
+    setMemoryBudget("0");
+    const std::string budget_gcode = slice();
+
+    ASSERT_NE(unlimited_gcode.find(";TYPE:SUPPORT"), std::string::npos) << "The model must need support, or this doesn't test much.";
+
+    std::istringstream unlimited_lines(unlimited_gcode);
+    std::istringstream budget_lines(budget_gcode);
+    std::string unlimited_line;
+    std::string budget_line;
+    for (size_t line_nr = 1; std::getline(unlimited_lines, unlimited_line); ++line_nr)
+    {
+        ASSERT_TRUE(std::getline(budget_lines, budget_line)) << "The g-code with a memory budget ends early, at line " << line_nr << ".";
+        ASSERT_EQ(unlimited_line, budget_line) << "The g-code with a memory budget differs at line " << line_nr << ".";
+    }
+    EXPECT_FALSE(std::getline(budget_lines, budget_line)) << "The g-code with a memory budget is longer.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
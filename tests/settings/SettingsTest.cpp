@@ -3,6 +3,7 @@
 
 #include "settings/Settings.h" //The class under test.
 
+#include <algorithm>
 #include <cmath>
 #include <memory> //For shared_ptr.
 #include <numbers>
@@ -14,6 +15,7 @@
 #include "Slice.h"
 #include "settings/EnumSettings.h"
 #include "settings/FlowTempGraph.h"
+#include "settings/SettingKey.h"
 #include "settings/types/Angle.h"
 #include "settings/types/Duration.h"
 #include "settings/types/LayerIndex.h"
@@ -237,6 +239,121 @@ TEST_F(SettingsTest, Inheritance)
     EXPECT_EQ(override_value, settings.get<std::string>("test_setting")) << "The new value overrides the one from the parent.";
 }
 
+TEST_F(SettingsTest, ResolvedValuesFollowParentChanges)
+{
+    std::shared_ptr<Slice> current_slice = std::make_shared<Slice>(0);
+    Application::getInstance().current_slice_ = current_slice;
+
+    Settings parent;
+    parent.add("test_setting", "12.5");
+    settings.setParent(&parent);
+    EXPECT_DOUBLE_EQ(12.5, settings.get<double>("test_setting"));
+    EXPECT_DOUBLE_EQ(12.5, settings.get<double>("test_setting")) << "Reading the resolved value again must give the same result.";
+
+    parent.add("test_setting", "3");
+    EXPECT_DOUBLE_EQ(3.0, settings.get<double>("test_setting")) << "Changing the parent must not leave an outdated value behind.";
+    EXPECT_EQ(3, settings.get<int>("test_setting"));
+
+    Settings other_parent;
+    other_parent.add("test_setting", "7");
+    settings.setParent(&other_parent);
+    EXPECT_EQ(7, settings.get<int>("test_setting")) << "Changing the parent must resolve the value again.";
+
+    parent.remove("test_setting");
+    settings.add("test_setting", "0");
+    EXPECT_EQ(false, settings.get<bool>("test_setting"));
+}
+
+TEST_F(SettingsTest, ResolvedValuesOfCopy)
+{
+    settings.add("test_setting", "0.4");
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting"));
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting")) << "The second lookup must give the same value as the first.";
+
+    Settings copy = settings;
+    EXPECT_EQ(coord_t(400), copy.get<coord_t>("test_setting")) << "A copy must resolve the same value.";
+    copy.add("test_setting", "0.5");
+    EXPECT_EQ(coord_t(500), copy.get<coord_t>("test_setting"));
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting")) << "Changing a copy must not change the original.";
+}
+
+TEST_F(SettingsTest, ResolvedValuesAfterAssigningParent)
+{
+    std::shared_ptr<Slice> current_slice = std::make_shared<Slice>(0);
+    Application::getInstance().current_slice_ = current_slice;
+
+    Settings parent;
+    parent.add("test_setting", "12.5");
+    settings.setParent(&parent);
+    EXPECT_DOUBLE_EQ(12.5, settings.get<double>("test_setting"));
+
+    Settings replacement;
+    replacement.add("test_setting", "3");
+    parent = replacement;
+    EXPECT_DOUBLE_EQ(3.0, settings.get<double>("test_setting")) << "Copy-assigning the parent must not leave an outdated value in the child.";
+
+    Settings moved;
+    moved.add("test_setting", "7");
+    parent = std::move(moved);
+    EXPECT_DOUBLE_EQ(7.0, settings.get<double>("test_setting")) << "Move-assigning the parent must not leave an outdated value in the child.";
+}
+
+TEST_F(SettingsTest, InternedKeys)
+{
+    settings.add("test_setting", "0.4");
+    settings.add("other_setting", "0.5");
+
+    EXPECT_EQ(SettingKey("test_setting").id(), SettingKey("test_setting").id()) << "The same name must always get the same id.";
+    EXPECT_NE(SettingKey("test_setting").id(), SettingKey("other_setting").id());
+    EXPECT_EQ("test_setting"_setting.id(), SettingKey("test_setting").id()) << "The literal must intern the same way.";
+    EXPECT_EQ("test_setting"_setting.name(), "test_setting");
+
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting"_setting));
+    EXPECT_EQ(coord_t(500), settings.get<coord_t>("other_setting"_setting));
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting")) << "Looking up by name must find the value resolved by the interned key.";
+}
+
+TEST_F(SettingsTest, CountSavedParses)
+{
+    settings.add("test_setting", "0.4");
+    EXPECT_EQ(coord_t(400), settings.get<coord_t>("test_setting")); // Resolves and parses the value.
+
+    Settings::startCountingSavedParses();
+    settings.get<coord_t>("test_setting");
+    settings.get<double>("test_setting");
+    settings.get<std::string>("test_setting"); // Strings are not parsed, so this saves nothing.
+    EXPECT_EQ(2, Settings::stopCountingSavedParses());
+
+    settings.get<coord_t>("test_setting");
+    Settings::startCountingSavedParses();
+    EXPECT_EQ(0, Settings::stopCountingSavedParses()) << "Lookups while not counting must not be counted.";
+
+    Settings::startCountingSavedParses();
+    settings.add("test_setting", "0.5");
+    settings.get<coord_t>("test_setting");
+    EXPECT_EQ(0, Settings::stopCountingSavedParses()) << "Resolving the value again after a change doesn't save a parse.";
+}
+
+TEST_F(SettingsTest, DifferingKeys)
+{
+    Settings parent;
+    parent.add("inherited_setting", "Only the parent has this one.");
+    settings.setParent(&parent);
+    settings.add("same_setting", "42");
+    settings.add("changed_setting", "1");
+    settings.add("removed_setting", "1");
+
+    Settings other;
+    other.add("same_setting", "42");
+    other.add("changed_setting", "2");
+    other.add("added_setting", "1");
+
+    std::vector<std::string> differing_keys = settings.getDifferingKeys(other);
+    std::sort(differing_keys.begin(), differing_keys.end());
+    EXPECT_EQ(differing_keys, (std::vector<std::string>{ "added_setting", "changed_setting", "removed_setting" })) << "Inherited values are not compared.";
+    EXPECT_TRUE(settings.getDifferingKeys(settings).empty());
+}
+
 TEST_F(SettingsTest, LimitToExtruder)
 {
     std::shared_ptr<Slice> current_slice = std::make_shared<Slice>(0);
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/ChunkedList.h" // The class under test.
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+template<typename List>
+std::vector<std::string> contents(const List& list)
+{
+    return std::vector<std::string>(list.begin(), list.end());
+}
+
+TEST(ChunkedListTest, OrderLikeStdList)
+{
+    ChunkedList<std::string, 4> chunked;
+    std::list<std::string> reference;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const std::string value = std::to_string(i);
+        if (i % 3 == 0)
+        {
+            chunked.emplace_front(value);
+            reference.emplace_front(value);
+        }
+        else
+        {
+            chunked.emplace_back(value);
+            reference.emplace_back(value);
+        }
+    }
+    EXPECT_EQ(contents(reference), contents(chunked)) << "Elements must be visited in the order in which they were linked into the list.";
+    EXPECT_EQ(reference.size(), chunked.size());
+    EXPECT_EQ(reference.front(), chunked.front());
+    EXPECT_EQ(reference.back(), chunked.back());
+}
+
+TEST(ChunkedListTest, EraseKeepsOtherElements)
+{
+    ChunkedList<std::string, 4> chunked;
+    std::list<std::string> reference;
+    std::vector<std::string*> addresses;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        addresses.push_back(&chunked.emplace_back(std::to_string(i)));
+        reference.emplace_back(std::to_string(i));
+    }
+
+    // Erase every other element, found back from its address.
+    for (size_t i = 0; i < addresses.size(); i += 2)
+    {
+        chunked.erase(chunked.iterator_to(*addresses[i]));
+        reference.remove(std::to_string(i));
+    }
+    EXPECT_EQ(contents(reference), contents(chunked));
+    for (size_t i = 1; i < addresses.size(); i += 2)
+    {
+        EXPECT_EQ(std::to_string(i), *addresses[i]) << "Erasing must not move the other elements.";
+    }
+
+    // Erasing while iterating.
+    for (auto it = chunked.begin(); it != chunked.end();)
+    {
+        it = (*it == "5" || *it == "19") ? chunked.erase(it) : std::next(it);
+    }
+    reference.remove("5");
+    reference.remove("19");
+    EXPECT_EQ(contents(reference), contents(chunked));
+
+    // The holes are filled again.
+    chunked.emplace_back("new");
+    reference.emplace_back("new");
+    EXPECT_EQ(contents(reference), contents(chunked));
+}
+
+TEST(ChunkedListTest, ClearAndMove)
+{
+    ChunkedList<std::string, 4> chunked;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        chunked.emplace_back(std::to_string(i));
+    }
+    chunked.clear();
+    EXPECT_TRUE(chunked.empty());
+    EXPECT_EQ(chunked.begin(), chunked.end());
+
+    chunked.emplace_back("a");
+    chunked.emplace_back("b");
+    ChunkedList<std::string, 4> moved(std::move(chunked));
+    EXPECT_TRUE(chunked.empty());
+    EXPECT_EQ(std::vector<std::string>({ "a", "b" }), contents(moved));
+
+    chunked = std::move(moved);
+    chunked.emplace_front("c");
+    EXPECT_EQ(std::vector<std::string>({ "c", "a", "b" }), contents(chunked));
+    EXPECT_EQ("b", *std::prev(chunked.end())) << "The moved list must link its last element back to its own end.";
+}
+
+TEST(ChunkedListTest, ClearToCapacity)
+{
+    ChunkedList<std::string, 4> chunked;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        chunked.emplace_back(std::to_string(i));
+    }
+    EXPECT_EQ(12U, chunked.capacity());
+
+    chunked.clear(100);
+    EXPECT_TRUE(chunked.empty());
+    EXPECT_EQ(12U, chunked.capacity()) << "There is room for the capacity, so all chunks are kept.";
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        chunked.emplace_back(std::to_string(i));
+    }
+    chunked.erase(chunked.begin());
+    chunked.clear(5);
+    EXPECT_EQ(4U, chunked.capacity()) << "The capacity is rounded down to whole chunks.";
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        chunked.emplace_back(std::to_string(i));
+    }
+    EXPECT_EQ(std::vector<std::string>({ "0", "1", "2", "3", "4", "5" }), contents(chunked));
+    EXPECT_EQ(8U, chunked.capacity());
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
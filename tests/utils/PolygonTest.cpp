@@ -4,16 +4,20 @@
 #include "geometry/Polygon.h" // The class under test.
 
 #include <numbers>
+#include <utility>
+#include <vector>
 
 #include <range/v3/view/sliding.hpp>
 #include <spdlog/spdlog.h>
 
 #include <gtest/gtest.h>
 
+#include "Application.h"
 #include "geometry/OpenPolyline.h"
 #include "geometry/SingleShape.h"
 #include "utils/Coord_t.h"
 #include "utils/SVG.h" // helper functions
+#include "utils/ThreadPool.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygonUtils.h" // helper functions
 
@@ -626,5 +630,83 @@ TEST_F(PolygonTest, openCloseLines)
     EXPECT_FALSE(closed_polyline.shorterThan(3500));
 }
 
+/*
+ * Runs the tests with a thread pool of their own, and gives the previous one back afterwards, so that the tests after them are not affected.
+ */
+class PolygonParallelTest : public PolygonTest
+{
+public:
+    ThreadPool* previous_thread_pool_ = nullptr;
+#ifndef __EMSCRIPTEN__
+    tbb::global_control* previous_tbb_controller_ = nullptr;
+#endif
+
+    void SetUp() override
+    {
+        PolygonTest::SetUp();
+        Application& application = Application::getInstance();
+        previous_thread_pool_ = std::exchange(application.thread_pool_, nullptr);
+#ifndef __EMSCRIPTEN__
+        previous_tbb_controller_ = std::exchange(application.tbb_controller_, nullptr);
+#endif
+        application.startThreadPool(4);
+    }
+
+    void TearDown() override
+    {
+        Application& application = Application::getInstance();
+        delete std::exchange(application.thread_pool_, previous_thread_pool_);
+#ifndef __EMSCRIPTEN__
+        delete std::exchange(application.tbb_controller_, previous_tbb_controller_);
+#endif
+    }
+};
+
+/*
+ * Test that unioning and intersecting many shapes at once, in parallel, gives the same area as accumulating them one by one.
+ */
+TEST_F(PolygonParallelTest, unionAndIntersectionOfManyShapes)
+{
+    // A staircase of overlapping squares, with a few disjoint ones and an empty one in between.
+    std::vector<Shape> shapes;
+    for (coord_t i = 0; i < 100; ++i)
+    {
+        const coord_t x = i % 10 == 9 ? 100000 + i * 1000 : i * 50;
+        Polygon square;
+        square.emplace_back(x, x);
+        square.emplace_back(x + 500, x);
+        square.emplace_back(x + 500, x + 500);
+        square.emplace_back(x, x + 500);
+        shapes.emplace_back(square);
+        if (i == 50)
+        {
+            shapes.emplace_back();
+        }
+    }
+
+    Shape accumulated_union;
+    for (const Shape& shape : shapes)
+    {
+        accumulated_union = accumulated_union.unionPolygons(shape);
+    }
+    const Shape batch_union = Shape::unionShapes(std::vector<Shape>(shapes));
+    EXPECT_EQ(batch_union.area(), accumulated_union.area());
+    EXPECT_EQ(batch_union.size(), accumulated_union.size());
+
+    EXPECT_TRUE(Shape::intersectionShapes(std::vector<Shape>(shapes)).empty()) << "The empty shape has nothing in common with the others.";
+    Polygon shifted_square;
+    shifted_square.emplace_back(50, 30);
+    shifted_square.emplace_back(150, 30);
+    shifted_square.emplace_back(150, 130);
+    shifted_square.emplace_back(50, 130);
+    std::vector<Shape> overlapping{ Shape(test_square), Shape(test_square).offset(50), Shape(shifted_square), Shape(test_square).offset(-10) };
+    const Shape accumulated_intersection = overlapping[0].intersection(overlapping[1]).intersection(overlapping[2]).intersection(overlapping[3]);
+    const Shape batch_intersection = Shape::intersectionShapes(std::move(overlapping));
+    EXPECT_EQ(batch_intersection.area(), accumulated_intersection.area());
+
+    EXPECT_TRUE(Shape::unionShapes({}).empty());
+    EXPECT_TRUE(Shape::intersectionShapes({}).empty());
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
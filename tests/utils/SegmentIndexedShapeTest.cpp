@@ -0,0 +1,125 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "geometry/SegmentIndexedShape.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "utils/AABB.h"
+#include "utils/polygonUtils.h"
+
+namespace cura
+{
+// NOLINTBEGIN(*-magic-numbers)
+class SegmentIndexedShapeTest : public testing::Test
+{
+public:
+    Shape shape;
+
+    void SetUp() override
+    {
+        // A square with a square hole, next to a jagged polygon, so that the grid cells contain many segments with shared rows and columns.
+        Polygon outer;
+        outer.emplace_back(0, 0);
+        outer.emplace_back(10000, 0);
+        outer.emplace_back(10000, 10000);
+        outer.emplace_back(0, 10000);
+        shape.push_back(outer);
+        Polygon hole;
+        hole.emplace_back(2000, 2000);
+        hole.emplace_back(2000, 8000);
+        hole.emplace_back(8000, 8000);
+        hole.emplace_back(8000, 2000);
+        shape.push_back(hole);
+        Polygon jagged;
+        for (coord_t x = 12000; x <= 30000; x += 1000)
+        {
+            jagged.emplace_back(x, (x / 1000) % 2 == 0 ? 0 : 3000);
+        }
+        jagged.emplace_back(30000, 10000);
+        jagged.emplace_back(12000, 10000);
+        shape.push_back(jagged);
+    }
+};
+
+TEST_F(SegmentIndexedShapeTest, Empty)
+{
+    const SegmentIndexedShape indexed;
+    EXPECT_TRUE(indexed.empty());
+    EXPECT_FALSE(indexed.inside(Point2LL(0, 0), true));
+    EXPECT_TRUE(indexed.intersectionsWithSegment(Point2LL(0, 0), Point2LL(100, 100)).empty());
+    EXPECT_FALSE(indexed.collidesWithLineSegment(Point2LL(0, 0), Point2LL(100, 100)));
+}
+
+TEST_F(SegmentIndexedShapeTest, InsideBorder)
+{
+    const SegmentIndexedShape indexed(shape);
+    EXPECT_TRUE(indexed.inside(Point2LL(1000, 1000)));
+    EXPECT_FALSE(indexed.inside(Point2LL(5000, 5000))) << "The point is in the hole.";
+    EXPECT_FALSE(indexed.inside(Point2LL(0, 5000), false));
+    EXPECT_TRUE(indexed.inside(Point2LL(0, 5000), true));
+    EXPECT_TRUE(indexed.inside(Point2LL(2000, 2000), true)) << "The point is a vertex of the hole.";
+    EXPECT_FALSE(indexed.inside(Point2LL(-1, 5000), true));
+}
+
+TEST_F(SegmentIndexedShapeTest, SameAsShape)
+{
+    const SegmentIndexedShape indexed(shape);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<coord_t> coordinate(-2000, 32000);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        // Snap to a coarse grid for some points, so that many of them end up exactly on vertices and segments.
+        const coord_t snap = i % 2 == 0 ? 1000 : 1;
+        const Point2LL p(coordinate(generator) / snap * snap, coordinate(generator) / snap * snap);
+        const Point2LL q(coordinate(generator) / snap * snap, coordinate(generator) / snap * snap);
+
+        EXPECT_EQ(indexed.inside(p, false), shape.inside(p, false)) << "Point " << p;
+        EXPECT_EQ(indexed.inside(p, true), shape.inside(p, true)) << "Point " << p;
+        EXPECT_EQ(indexed.intersectionsWithSegment(p, q), shape.intersectionsWithSegment(p, q)) << "Segment " << p << " - " << q;
+        EXPECT_EQ(indexed.collidesWithLineSegment(p, q), PolygonUtils::polygonCollidesWithLineSegment(shape, p, q)) << "Segment " << p << " - " << q;
+    }
+}
+TEST(SegmentIndexedShapeFalseHitTest, SkipsDistantAlmostCollinearSegments)
+{
+    // The query ends about 1mm before the first segment of the wedge starts, almost in line with it. The float computation of
+    // Shape::intersectionsWithSegment reports a hit at t=1 for these two segments, while they are far apart. The squares make the cells of
+    // the grid small enough that the wedge isn't near the query.
+    const Point2LL query_start(20946, 39449);
+    const Point2LL query_end(63777, 15076);
+    Shape shape;
+    Polygon wedge;
+    wedge.emplace_back(64798, 14495);
+    wedge.emplace_back(81438, 5026);
+    wedge.emplace_back(81438, 14495);
+    shape.push_back(wedge);
+    for (coord_t x = 0; x < 82000; x += 700)
+    {
+        for (coord_t y = 60000; y < 100000; y += 700)
+        {
+            Polygon square;
+            square.emplace_back(x, y);
+            square.emplace_back(x + 100, y);
+            square.emplace_back(x + 100, y + 100);
+            square.emplace_back(x, y + 100);
+            shape.push_back(square);
+        }
+    }
+    const SegmentIndexedShape indexed(shape);
+
+    AABB query_box;
+    query_box.include(query_start);
+    query_box.include(query_end);
+    for (const Polygon& polygon : shape)
+    {
+        ASSERT_FALSE(query_box.hit(AABB(polygon))) << "The query should not touch the shape at all.";
+    }
+    EXPECT_TRUE(indexed.intersectionsWithSegment(query_start, query_end).empty());
+    EXPECT_FALSE(indexed.collidesWithLineSegment(query_start, query_end));
+}
+// NOLINTEND(*-magic-numbers)
+} // namespace cura
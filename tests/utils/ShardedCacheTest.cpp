@@ -0,0 +1,116 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/ShardedCache.h" // The class under test.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(ShardedCacheTest, HitAndMiss)
+{
+    ShardedCache<int, std::string> cache(true);
+    cache.insert(1, "one");
+
+    const auto hit = cache.find(1);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->get(), "one");
+    EXPECT_FALSE(cache.find(2).has_value());
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+
+    const ShardedCache<int, std::string>::Statistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.hits, 1);
+    EXPECT_EQ(statistics.misses, 1) << "contains() is not counted as a lookup.";
+    EXPECT_EQ(statistics.size, 1);
+}
+
+TEST(ShardedCacheTest, InsertKeepsExistingValue)
+{
+    ShardedCache<int, std::string> cache;
+    cache.insert(1, "first");
+    const std::string& value = cache.find(1)->get();
+
+    cache.insert(1, "second");
+    const std::vector<std::pair<int, std::string>> entries = { { 1, "third" }, { 2, "two" } };
+    cache.insert(entries.begin(), entries.end());
+
+    EXPECT_EQ(cache.find(1)->get(), "first") << "Inserting an existing key must keep the value that was there.";
+    EXPECT_EQ(&cache.find(1)->get(), &value) << "References to values must stay valid.";
+    EXPECT_EQ(cache.find(2)->get(), "two");
+    EXPECT_EQ(cache.getStatistics().size, 2);
+}
+
+TEST(ShardedCacheTest, NoStatisticsUnlessAsked)
+{
+    ShardedCache<int, int> cache(false);
+    cache.insert(1, 1);
+    cache.find(1);
+    cache.find(2);
+
+    const ShardedCache<int, int>::Statistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.hits, 0);
+    EXPECT_EQ(statistics.misses, 0);
+    EXPECT_EQ(statistics.contended, 0);
+    EXPECT_EQ(statistics.size, 1) << "The size is always known.";
+}
+
+TEST(ShardedCacheTest, ConcurrentReadersAndWriters)
+{
+    constexpr int key_count = 2000;
+    constexpr size_t thread_count = 8;
+    ShardedCache<int, int> cache(true);
+    for (int key = 0; key < key_count; key += 2)
+    {
+        cache.insert(key, key * 10);
+    }
+
+    // Half the threads read all keys, the other half insert the odd keys, each with their own value. Only the first insert of a key counts.
+    std::atomic<size_t> wrong_values = 0;
+    std::vector<std::thread> threads;
+    for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx)
+    {
+        threads.emplace_back(
+            [&cache, &wrong_values, thread_idx]()
+            {
+                for (int key = 0; key < key_count; ++key)
+                {
+                    if (thread_idx % 2 == 1 && key % 2 == 1)
+                    {
+                        cache.insert(key, key * 10 + static_cast<int>(thread_idx));
+                    }
+                    const auto value = cache.find(key);
+                    if (value.has_value() && value->get() / 10 != key)
+                    {
+                        ++wrong_values;
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(wrong_values.load(), 0);
+    const ShardedCache<int, int>::Statistics statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.size, key_count);
+    EXPECT_EQ(statistics.hits + statistics.misses, thread_count * key_count) << "Every lookup must be counted once.";
+    for (int key = 1; key < key_count; key += 2)
+    {
+        const int value = cache.find(key)->get();
+        EXPECT_EQ(value / 10, key);
+        EXPECT_EQ(value % 10 % 2, 1) << "The value must come from one of the inserting threads.";
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "utils/Coord_t.h"
+#include "utils/SparseAABBGrid.h"
 #include "utils/SparsePointGridInclusive.h"
 
 namespace cura
@@ -300,4 +301,45 @@ TEST_F(GetNearestTest, Equal)
         << ")."; // FIXME: simplify once fmt or we use C++20 is added as a dependency
 }
 
+TEST(SparseAABBGridTest, FindsAllHitsAfterInsertAndErase)
+{
+    // A row of boxes of different sizes, some spanning several cells and one of them empty.
+    std::vector<AABB> boxes;
+    for (coord_t i = 0; i < 50; ++i)
+    {
+        boxes.emplace_back(Point2LL(i * 37, (i % 7) * 23), Point2LL(i * 37 + (i % 5) * 40, (i % 7) * 23 + 30));
+    }
+    boxes.emplace_back();
+
+    constexpr coord_t grid_size = 50;
+    SparseAABBGrid<size_t> grid(grid_size);
+    for (size_t box_idx = 0; box_idx < boxes.size(); ++box_idx)
+    {
+        grid.insert(box_idx, boxes[box_idx]);
+    }
+    for (size_t box_idx = 0; box_idx < boxes.size(); box_idx += 3)
+    {
+        grid.erase(box_idx, boxes[box_idx]);
+    }
+
+    for (const AABB& query : { AABB(Point2LL(100, 0), Point2LL(300, 60)), AABB(Point2LL(-50, -50), Point2LL(0, 0)), AABB(Point2LL(1000, 100), Point2LL(1000, 100)), AABB() })
+    {
+        const std::vector<size_t> nearby = grid.getNearby(query);
+        EXPECT_TRUE(std::is_sorted(nearby.begin(), nearby.end()));
+        EXPECT_EQ(std::adjacent_find(nearby.begin(), nearby.end()), nearby.end()) << "Every element must only be reported once.";
+        for (size_t box_idx = 0; box_idx < boxes.size(); ++box_idx)
+        {
+            const bool is_nearby = std::binary_search(nearby.begin(), nearby.end(), box_idx);
+            if (box_idx % 3 == 0)
+            {
+                EXPECT_FALSE(is_nearby) << "Box " << box_idx << " was erased.";
+            }
+            else if (boxes[box_idx].hit(query))
+            {
+                EXPECT_TRUE(is_nearby) << "Box " << box_idx << " hits the query box, but was not found.";
+            }
+        }
+    }
+}
+
 } // namespace cura
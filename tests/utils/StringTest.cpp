@@ -4,6 +4,8 @@
 #include "utils/string.h" // The file under test.
 #include "geometry/Point2LL.h"
 #include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
 
 // NOLINTBEGIN(*-magic-numbers)
 namespace cura
@@ -40,6 +42,33 @@ INSTANTIATE_TEST_SUITE_P(
     WriteInt2mmTest,
     testing::Values(-10000, -1000, -100, -10, -1, 0, 1, 10, 100, 1000, 10000, 123456789, std::numeric_limits<int32_t>::max() / 1001)); // For max integer test, divide by 1000 since MM2INT multiplies by 1000 which would cause an overflow.
 
+/*
+ * The exact text must not change, since the GCode is compared byte for byte.
+ */
+TEST(StringTest, WriteInt2mmExactText)
+{
+    const std::vector<std::pair<int32_t, std::string>> cases = {
+        { 0, "0" },
+        { 1, "0.001" },
+        { -1, "-0.001" },
+        { 10, "0.01" },
+        { 120, "0.12" },
+        { 1000, "1" },
+        { -500, "-.5" },
+        { -1500, "-1.5" },
+        { 100100, "100.1" },
+        { 2000000, "2000" },
+        { 123456789, "123456.789" },
+        { std::numeric_limits<int32_t>::min(), "-2147483.648" },
+    };
+    for (const auto& [in, expected] : cases)
+    {
+        std::ostringstream ss;
+        writeInt2mm(in, ss);
+        EXPECT_EQ(expected, ss.str()) << "The integer " << in << " was not printed as expected.";
+    }
+}
+
 /*
  * Fixture to allow parameterized tests for writeDoubleToStream.
  */
@@ -86,5 +115,27 @@ INSTANTIATE_TEST_SUITE_P(WriteDoubleToStreamTestInstantiation,
                                          std::numeric_limits<double>::lowest(),
                                          -std::numeric_limits<double>::lowest()));
 
+TEST(StringTest, WriteDoubleToStreamExactText)
+{
+    const std::vector<std::tuple<uint8_t, double, std::string>> cases = {
+        { 5, 0.0, "0" },
+        { 5, 1.5, "1.5" },
+        { 5, 0.000004, "0" },
+        { 5, -0.000004, "-0" },
+        { 5, 12.345678, "12.34568" },
+        { 1, 1800.0, "1800" },
+        { 1, 1234.56, "1234.6" },
+        { 0, 99.5, "100" },
+        { 2, -0.1, "-0.1" },
+        { 3, 100.0, "100" },
+    };
+    for (const auto& [precision, in, expected] : cases)
+    {
+        std::ostringstream ss;
+        writeDoubleToStream(precision, in, ss);
+        EXPECT_EQ(expected, ss.str()) << "The double " << in << " with precision " << int(precision) << " was not printed as expected.";
+    }
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
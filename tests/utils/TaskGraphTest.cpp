@@ -0,0 +1,179 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/TaskGraph.h" // The class under test.
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class TaskGraphTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool(8);
+    }
+};
+
+TEST_F(TaskGraphTest, RunsEveryTaskOnceAfterItsDependencies)
+{
+    // Like the walls and skins of the layers: a skin depends on the walls of the layers around it.
+    constexpr size_t layer_count = 200;
+    constexpr size_t window = 3;
+    std::vector<std::atomic<size_t>> walls_runs(layer_count);
+    std::vector<std::atomic<size_t>> skin_runs(layer_count);
+    std::atomic<size_t> violations = 0;
+
+    TaskGraph graph;
+    std::vector<TaskGraph::task_id_t> walls;
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        walls.push_back(graph.addTask(
+            "walls",
+            [&, layer_nr]()
+            {
+                walls_runs[layer_nr]++;
+            }));
+    }
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const size_t first = layer_nr >= window ? layer_nr - window : 0;
+        const size_t last = std::min(layer_nr + window, layer_count - 1);
+        const TaskGraph::task_id_t skin = graph.addTask(
+            "skin",
+            [&, layer_nr, first, last]()
+            {
+                for (size_t other = first; other <= last; ++other)
+                {
+                    if (walls_runs[other] != 1)
+                    {
+                        violations++;
+                    }
+                }
+                skin_runs[layer_nr]++;
+            });
+        for (size_t other = first; other <= last; ++other)
+        {
+            graph.addDependency(walls[other], skin);
+        }
+    }
+    EXPECT_EQ(graph.size(), 2 * layer_count);
+
+    graph.run(*Application::getInstance().thread_pool_);
+
+    EXPECT_EQ(violations.load(), 0);
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        EXPECT_EQ(walls_runs[layer_nr].load(), 1) << "walls of layer " << layer_nr;
+        EXPECT_EQ(skin_runs[layer_nr].load(), 1) << "skin of layer " << layer_nr;
+    }
+}
+
+TEST_F(TaskGraphTest, TasksMayUseParallelFor)
+{
+    constexpr size_t task_count = 32;
+    constexpr size_t item_count = 1000;
+    std::vector<size_t> sums(task_count, 0);
+
+    TaskGraph graph;
+    TaskGraph::task_id_t previous = 0;
+    for (size_t task_idx = 0; task_idx < task_count; ++task_idx)
+    {
+        const TaskGraph::task_id_t task = graph.addTask(
+            "sum",
+            [&, task_idx]()
+            {
+                std::atomic<size_t> sum = 0;
+                parallel_for(
+                    size_t(0),
+                    item_count,
+                    [&](const size_t item)
+                    {
+                        sum += item;
+                    });
+                sums[task_idx] = sum + (task_idx > 0 ? sums[task_idx - 1] : 0);
+            });
+        if (task_idx > 0)
+        { // A chain, so that each task reads the result of the previous one.
+            graph.addDependency(previous, task);
+        }
+        previous = task;
+    }
+    graph.run(*Application::getInstance().thread_pool_);
+
+    for (size_t task_idx = 0; task_idx < task_count; ++task_idx)
+    {
+        EXPECT_EQ(sums[task_idx], (task_idx + 1) * item_count * (item_count - 1) / 2);
+    }
+}
+
+TEST_F(TaskGraphTest, EmptyGraph)
+{
+    TaskGraph graph;
+    graph.run(*Application::getInstance().thread_pool_);
+    EXPECT_EQ(graph.size(), 0);
+}
+
+TEST_F(TaskGraphTest, ManyShortLivedGraphs)
+{
+    // Like the graphs that are local to a function: each one is destroyed right after run() returns, possibly while the thread that ran its
+    // last task is still finishing up. Under a sanitizer this catches tasks that touch the graph after the last one is counted.
+    constexpr size_t graph_count = 5000;
+    constexpr size_t task_count = 4;
+    std::atomic<size_t> runs = 0;
+    for (size_t graph_idx = 0; graph_idx < graph_count; ++graph_idx)
+    {
+        TaskGraph graph;
+        for (size_t task_idx = 0; task_idx < task_count; ++task_idx)
+        {
+            graph.addTask(
+                "task",
+                [&runs]()
+                {
+                    runs++;
+                });
+        }
+        graph.run(*Application::getInstance().thread_pool_);
+    }
+    EXPECT_EQ(runs.load(), graph_count * task_count);
+}
+
+TEST_F(TaskGraphTest, NamesOnlyWhenTracing)
+{
+    const TaskGraph untraced;
+    EXPECT_EQ(untraced.traceName("walls mesh {} layer {}", 1, 2), "") << "Names are not built if they're not traced.";
+    const TaskGraph traced(true);
+    EXPECT_EQ(traced.traceName("walls mesh {} layer {}", 1, 2), "walls mesh 1 layer 2");
+}
+
+TEST_F(TaskGraphTest, TraceEscapesNames)
+{
+    TaskGraph graph(true);
+    graph.addTask("a \"quoted\" \\ name\n", []() {});
+    graph.run(*Application::getInstance().thread_pool_);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TaskGraphTest_TraceEscapesNames.json";
+    graph.writeTrace(path);
+    std::ifstream in(path);
+    std::stringstream trace;
+    trace << in.rdbuf();
+    in.close();
+    std::filesystem::remove(path);
+
+    EXPECT_NE(trace.str().find(R"("name":"a \"quoted\" \\ name\n")"), std::string::npos) << "The name must be a valid JSON string.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,208 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/ThreadPool.h" // The class under test.
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+#include "utils/WorkStealingDeque.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class ThreadPoolTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool(8);
+    }
+};
+
+TEST_F(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    constexpr size_t item_count = 10000;
+    std::vector<std::atomic<size_t>> visits(item_count);
+    parallel_for(
+        size_t(0),
+        item_count,
+        [&](const size_t idx)
+        {
+            visits[idx]++;
+        });
+    for (size_t idx = 0; idx < item_count; ++idx)
+    {
+        EXPECT_EQ(visits[idx].load(), 1) << "at index " << idx;
+    }
+}
+
+TEST_F(ThreadPoolTest, NestedParallelFor)
+{
+    constexpr size_t outer_count = 64;
+    constexpr size_t inner_count = 1000;
+    std::vector<size_t> sums(outer_count, 0);
+    parallel_for(
+        size_t(0),
+        outer_count,
+        [&](const size_t outer_idx)
+        {
+            std::atomic<size_t> sum = 0;
+            parallel_for(
+                size_t(0),
+                inner_count,
+                [&](const size_t inner_idx)
+                {
+                    sum += inner_idx;
+                });
+            sums[outer_idx] = sum;
+        });
+    EXPECT_TRUE(std::ranges::all_of(
+        sums,
+        [](const size_t sum)
+        {
+            return sum == inner_count * (inner_count - 1) / 2;
+        }));
+}
+
+TEST_F(ThreadPoolTest, OrderedConsumer)
+{
+    constexpr ptrdiff_t item_count = 500;
+    std::vector<ptrdiff_t> consumed;
+    run_multiple_producers_ordered_consumer(
+        0,
+        item_count,
+        [](const ptrdiff_t idx)
+        {
+            // Nested parallelism in the producers, like the layers of the g-code export.
+            std::atomic<ptrdiff_t> sum = 0;
+            parallel_for(
+                ptrdiff_t(0),
+                ptrdiff_t(100),
+                [&](const ptrdiff_t i)
+                {
+                    sum += i;
+                });
+            return std::optional<ptrdiff_t>(idx + sum - 4950);
+        },
+        [&consumed](std::optional<ptrdiff_t> item)
+        {
+            consumed.push_back(*item);
+        });
+
+    ASSERT_EQ(consumed.size(), item_count);
+    for (ptrdiff_t idx = 0; idx < item_count; ++idx)
+    {
+        EXPECT_EQ(consumed[idx], idx);
+    }
+}
+
+TEST_F(ThreadPoolTest, ManyShortParallelFors)
+{
+    // The chunks of a short loop end while the calling thread is still waiting, and it returns as soon as the last one is counted.
+    // Under a sanitizer this catches chunks that still touch their closure or the state of the loop after that.
+    constexpr size_t loop_count = 20000;
+    constexpr size_t item_count = 16;
+    size_t wrong_sums = 0;
+    for (size_t loop = 0; loop < loop_count; ++loop)
+    {
+        std::atomic<size_t> sum = 0;
+        parallel_for(
+            size_t(0),
+            item_count,
+            [&sum](const size_t idx)
+            {
+                sum += idx;
+            });
+        if (sum != item_count * (item_count - 1) / 2)
+        {
+            wrong_sums++;
+        }
+    }
+    EXPECT_EQ(wrong_sums, 0);
+}
+
+TEST(WorkStealingDequeTest, OwnerIsLastInFirstOutThievesFirstInFirstOut)
+{
+    WorkStealingDeque<int*> deque(2); // Small enough to grow.
+    std::vector<int> items{ 0, 1, 2, 3, 4 };
+    for (int& item : items)
+    {
+        deque.push(&item);
+    }
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.pop(), &items[4]);
+    EXPECT_EQ(deque.steal(), &items[1]);
+    EXPECT_EQ(deque.pop(), &items[3]);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, EveryItemTakenOnce)
+{
+    constexpr size_t item_count = 100000;
+    constexpr size_t thief_count = 3;
+    std::vector<std::atomic<size_t>> taken(item_count);
+    std::vector<size_t> items(item_count);
+    WorkStealingDeque<size_t*> deque(16);
+    std::atomic<bool> done = false;
+
+    std::vector<std::thread> thieves;
+    for (size_t thief = 0; thief < thief_count; ++thief)
+    {
+        thieves.emplace_back(
+            [&]()
+            {
+                while (! done)
+                {
+                    if (size_t* item = deque.steal())
+                    {
+                        taken[*item]++;
+                    }
+                }
+            });
+    }
+
+    for (size_t idx = 0; idx < item_count; ++idx)
+    {
+        items[idx] = idx;
+        deque.push(&items[idx]);
+        if (idx % 3 == 0)
+        {
+            if (size_t* item = deque.pop())
+            {
+                taken[*item]++;
+            }
+        }
+    }
+    while (size_t* item = deque.pop())
+    {
+        taken[*item]++;
+    }
+    while (! deque.empty())
+    { // The thieves are still taking the last items.
+        std::this_thread::yield();
+    }
+    done = true;
+    for (std::thread& thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (size_t idx = 0; idx < item_count; ++idx)
+    {
+        EXPECT_EQ(taken[idx].load(), 1) << "item " << idx;
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)